@@ -95,6 +95,9 @@
 static int system_has_forkfd(void);
 static int system_forkfd(int flags, pid_t *ppid, int *system);
 static int system_forkfd_wait(int ffd, struct forkfd_info *info, struct rusage *rusage);
+static int system_vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token, int *system);
+static int system_vforkfd_wait(int ffd, struct forkfd_info *info, struct rusage *rusage, int *system);
+static int system_vforkfd_close(int ffd, int *system);
 
 #define CHILDREN_IN_SMALL_ARRAY     16
 #define CHILDREN_IN_BIG_ARRAY       256
@@ -276,8 +279,11 @@ static void notifyAndFreeInfo(Header *header, ProcessInfo *entry,
                               const struct pipe_payload *payload)
 {
     ssize_t ret;
-    EINTR_LOOP(ret, write(entry->deathPipe, payload, sizeof(*payload)));
-    EINTR_LOOP(ret, close(entry->deathPipe));
+    /* children handed over by forkfd_close() have no one to notify */
+    if (entry->deathPipe != -1) {
+        EINTR_LOOP(ret, write(entry->deathPipe, payload, sizeof(*payload)));
+        EINTR_LOOP(ret, close(entry->deathPipe));
+    }
 
     freeInfo(header, entry);
 }
@@ -725,6 +731,37 @@ err_free:
     freeInfo(header, info);
     return -1;
 }
+
+/**
+ * @brief vforkfd returns a file descriptor representing a child process
+ * @return a file descriptor, or -1 in case of failure
+ *
+ * vforkfd() works like forkfd(), except that it does not return in the
+ * child process: the child calls @a childFn with @a token as argument, and
+ * exits with the value it returns. @a childFn is expected to call execve(2)
+ * or one of its variants, and to return only if that failed.
+ *
+ * Where the system supports it, the child shares the memory of the parent
+ * until it calls execve(2) or exits, and the calling thread is suspended
+ * until then, like with vfork(2). This avoids copying the page tables of a
+ * large parent process. @a childFn must therefore restrict itself to
+ * async-signal-safe functions and must not modify memory that the parent
+ * uses. On other systems, vforkfd() falls back to forkfd().
+ *
+ * The returned file descriptor is used like one returned by forkfd().
+ */
+int vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token)
+{
+    int ret;
+    int fd = system_vforkfd(flags, ppid, childFn, token, &ret);
+    if (ret)
+        return fd;
+
+    fd = forkfd(flags, ppid);
+    if (fd == FFD_CHILD_PROCESS)
+        _exit(childFn(token));
+    return fd;
+}
 #endif // FORKFD_NO_FORKFD
 
 #if _POSIX_SPAWN > 0 && !defined(FORKFD_NO_SPAWNFD)
@@ -797,10 +834,15 @@ int forkfd_wait(int ffd, struct forkfd_info *info, struct rusage *rusage)
 {
     struct pipe_payload payload;
     int ret;
+    int system;
 
     if (system_has_forkfd())
         return system_forkfd_wait(ffd, info, rusage);
 
+    ret = system_vforkfd_wait(ffd, info, rusage, &system);
+    if (system)
+        return ret;
+
     ret = read(ffd, &payload, sizeof(payload));
     if (ret == -1)
         return ret;     /* pass errno, probably EINTR, EBADF or EWOULDBLOCK */
@@ -817,6 +859,13 @@ int forkfd_wait(int ffd, struct forkfd_info *info, struct rusage *rusage)
 
 int forkfd_close(int ffd)
 {
+    int ret;
+    int system;
+
+    ret = system_vforkfd_close(ffd, &system);
+    if (system)
+        return ret;
+
     return close(ffd);
 }
 
@@ -844,3 +893,33 @@ int system_forkfd_wait(int ffd, struct forkfd_info *info, struct rusage *rusage)
     return -1;
 }
 #endif
+
+#if defined(__linux__) && !defined(__ia64__) && !defined(__hppa__)
+#  include "forkfd_linux.c"
+#else
+int system_vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token, int *system)
+{
+    (void)flags;
+    (void)ppid;
+    (void)childFn;
+    (void)token;
+    *system = 0;
+    return -1;
+}
+
+int system_vforkfd_wait(int ffd, struct forkfd_info *info, struct rusage *rusage, int *system)
+{
+    (void)ffd;
+    (void)info;
+    (void)rusage;
+    *system = 0;
+    return -1;
+}
+
+int system_vforkfd_close(int ffd, int *system)
+{
+    (void)ffd;
+    *system = 0;
+    return -1;
+}
+#endif
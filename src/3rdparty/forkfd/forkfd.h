@@ -49,6 +49,7 @@ struct forkfd_info {
 };
 
 int forkfd(int flags, pid_t *ppid);
+int vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token);
 int forkfd_wait(int ffd, struct forkfd_info *info, struct rusage *rusage);
 int forkfd_close(int ffd);
 
@@ -0,0 +1,272 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+** THE SOFTWARE.
+**
+****************************************************************************/
+
+#include "forkfd.h"
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "forkfd_atomic.h"
+
+#ifndef CLONE_PIDFD
+#  define CLONE_PIDFD   0x00001000
+#endif
+#ifndef P_PIDFD
+#  define P_PIDFD       3
+#endif
+
+/* 0: not checked yet; 1: clone(CLONE_PIDFD) and waitid(P_PIDFD) work; -1: they don't */
+static ffd_atomic_int system_pidfd_state = FFD_ATOMIC_INIT(0);
+
+struct vfork_child_args
+{
+    int (*childFn)(void *);
+    void *token;
+    sigset_t oldmask;
+};
+
+static int sys_waitid(int which, int pid_or_pidfd, siginfo_t *infop, int options, struct rusage *ru)
+{
+    /* the libc wrapper has no rusage argument */
+    return syscall(__NR_waitid, which, pid_or_pidfd, infop, options, ru);
+}
+
+static int system_has_pidfd()
+{
+    int state = ffd_atomic_load(&system_pidfd_state, FFD_ATOMIC_RELAXED);
+    if (state == 0) {
+        /* P_PIDFD (Linux 5.4) implies CLONE_PIDFD (Linux 5.2). Kernels that
+         * know P_PIDFD reject the invalid descriptor with EBADF, older ones
+         * reject the ID type with EINVAL. */
+        int saved_errno = errno;
+        sys_waitid(P_PIDFD, INT_MAX, NULL, WEXITED | WNOHANG, NULL);
+        state = errno == EBADF ? 1 : -1;
+        errno = saved_errno;
+        ffd_atomic_store(&system_pidfd_state, state, FFD_ATOMIC_RELAXED);
+    }
+    return state > 0;
+}
+
+static int vfork_child(void *arg)
+{
+    struct vfork_child_args *args = (struct vfork_child_args *)arg;
+    struct sigaction sa;
+    int sig;
+
+    /* We share the parent's memory until execve(), so none of its signal
+     * handlers may run here: reset them before unblocking the signals. */
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = SIG_DFL;
+    for (sig = 1; sig < _NSIG; ++sig) {
+        struct sigaction old;
+        if (sigaction(sig, NULL, &old) == 0 && old.sa_handler != SIG_IGN && old.sa_handler != SIG_DFL)
+            sigaction(sig, &sa, NULL);
+    }
+    sigprocmask(SIG_SETMASK, &args->oldmask, NULL);
+
+    return args->childFn(args->token);
+}
+
+static size_t vfork_stack_size()
+{
+    /* childFn may do arbitrary work before calling execve(), so give it
+     * the stack a new thread would get */
+    pthread_attr_t attr;
+    size_t size = 0;
+    if (pthread_attr_init(&attr) == 0) {
+        pthread_attr_getstacksize(&attr, &size);
+        pthread_attr_destroy(&attr);
+    }
+    if (size < (size_t)PTHREAD_STACK_MIN)
+        size = PTHREAD_STACK_MIN;
+    return size;
+}
+
+int system_vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token, int *system)
+{
+    struct vfork_child_args args;
+    sigset_t allsignals;
+    size_t pageSize;
+    size_t stackSize;
+    char *stack;
+    pid_t pid;
+    int pidfd = -1;
+    int saved_errno;
+
+    *system = 0;
+    if (!system_has_pidfd())
+        return -1;
+    *system = 1;
+
+    /* CLONE_VFORK suspends us until the child has called execve() or exited,
+     * so the stack can be released as soon as clone() returns. Pages are
+     * only committed when the child touches them, and the guard page at the
+     * bottom makes an overflow crash the child instead of corrupting memory
+     * it shares with us. */
+    pageSize = sysconf(_SC_PAGESIZE);
+    stackSize = (vfork_stack_size() + pageSize - 1) & ~(pageSize - 1);
+    stack = (char *)mmap(NULL, stackSize + pageSize, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+    if (stack == MAP_FAILED)
+        return -1;
+    mprotect(stack, pageSize, PROT_NONE);
+
+    args.childFn = childFn;
+    args.token = token;
+    sigfillset(&allsignals);
+    pthread_sigmask(SIG_SETMASK, &allsignals, &args.oldmask);
+
+    pid = clone(vfork_child, stack + pageSize + stackSize,
+                CLONE_VM | CLONE_VFORK | CLONE_PIDFD | SIGCHLD, &args, &pidfd);
+
+    saved_errno = errno;
+    pthread_sigmask(SIG_SETMASK, &args.oldmask, NULL);
+    munmap(stack, stackSize + pageSize);
+    if (pid == -1) {
+        errno = saved_errno;
+        return -1;
+    }
+
+    /* pidfds are always created with FD_CLOEXEC set */
+    if ((flags & FFD_CLOEXEC) == 0)
+        fcntl(pidfd, F_SETFD, 0);
+    if (flags & FFD_NONBLOCK)
+        fcntl(pidfd, F_SETFL, fcntl(pidfd, F_GETFL) | O_NONBLOCK);
+    if (ppid)
+        *ppid = pid;
+    return pidfd;
+}
+
+int system_vforkfd_wait(int ffd, struct forkfd_info *info, struct rusage *rusage, int *system)
+{
+    struct stat st;
+    siginfo_t si;
+    int options = WEXITED;
+    int ret;
+
+    /* the death pipes of forkfd() are FIFOs, pidfds are anonymous inodes */
+    *system = 0;
+    if (!system_has_pidfd() || fstat(ffd, &st) == -1 || S_ISFIFO(st.st_mode))
+        return -1;
+    *system = 1;
+
+    ret = fcntl(ffd, F_GETFL);
+    if (ret == -1)
+        return ret;
+    options |= (ret & O_NONBLOCK) ? WNOHANG : 0;
+
+    memset(&si, 0, sizeof(si));
+    ret = sys_waitid(P_PIDFD, ffd, &si, options, rusage);
+    if (ret == -1)
+        return ret;
+    if (si.si_pid == 0) {
+        /* WNOHANG and the child is still running */
+        errno = EWOULDBLOCK;
+        return -1;
+    }
+
+    if (info) {
+        info->code = si.si_code;
+        info->status = si.si_status;
+    }
+    return 0;
+}
+
+static pid_t pidfd_to_pid(int pidfd)
+{
+    /* the kernel has no call for this before Linux 6.13, but it lists the
+     * PID in the descriptor's fdinfo */
+    char buf[512];
+    const char *line;
+    ssize_t len;
+    int fd;
+
+    snprintf(buf, sizeof(buf), "/proc/self/fdinfo/%d", pidfd);
+    EINTR_LOOP(fd, open(buf, O_RDONLY | O_CLOEXEC));
+    if (fd == -1)
+        return -1;
+    EINTR_LOOP(len, read(fd, buf, sizeof(buf) - 1));
+    close(fd);
+    if (len <= 0)
+        return -1;
+
+    buf[len] = '\0';
+    line = strstr(buf, "\nPid:");
+    return line ? (pid_t)strtol(line + strlen("\nPid:"), NULL, 10) : -1;
+}
+
+static void reap_child_later(pid_t pid)
+{
+    /* Hand the child over to the SIGCHLD handler, like a child of forkfd()
+     * whose descriptor was closed. There is no death pipe to notify. */
+    Header *header;
+    ProcessInfo *info;
+    struct pipe_payload payload;
+
+    (void) pthread_once(&forkfd_initialization, forkfd_initialize);
+
+    info = allocateInfo(&header);
+    if (info == NULL)
+        return;
+    info->deathPipe = -1;
+    ffd_atomic_store(&info->pid, pid, FFD_ATOMIC_RELEASE);
+
+    /* check if the child exited before the handler knew about it */
+    if (tryReaping(pid, &payload))
+        freeInfo(header, info);
+}
+
+int system_vforkfd_close(int ffd, int *system)
+{
+    struct stat st;
+    siginfo_t si;
+
+    *system = 0;
+    if (!system_has_pidfd() || fstat(ffd, &st) == -1 || S_ISFIFO(st.st_mode))
+        return -1;
+    *system = 1;
+
+    /* Closing a pidfd does not reap the child. If no one waited for it,
+     * reap it now or, if it is still running, once it exits. */
+    memset(&si, 0, sizeof(si));
+    if (sys_waitid(P_PIDFD, ffd, &si, WEXITED | WNOHANG, NULL) == 0 && si.si_pid == 0) {
+        pid_t pid = pidfd_to_pid(ffd);
+        if (pid > 0)
+            reap_child_later(pid);
+    }
+
+    return close(ffd);
+}
@@ -120,3 +120,14 @@ d = german.toDouble(u"1234.56", &ok);  // ok == false
 
 d = german.toDouble(u"1.234", &ok);    // ok == true, d == 1234.0
 //! [3-qstringview]
+
+//! [4]
+QLocale locale(QLocale::C);
+locale.setNumberOptions(QLocale::OmitGroupSeparator);
+
+QString csv;
+for (const QVector<double> &row : rows) {
+    locale.appendNumbers(csv, row.constData(), row.size(), u",", 'g', QLocale::FloatingPointShortest);
+    csv += QLatin1Char('\n');
+}
+//! [4]
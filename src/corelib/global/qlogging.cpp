@@ -56,6 +56,9 @@
 #include "qdatetime.h"
 #include "qcoreapplication.h"
 #include "qthread.h"
+#include "qwaitcondition.h"
+#include "qhash.h"
+#include "qendian.h"
 #include "private/qloggingregistry_p.h"
 #include "private/qcoreapplication_p.h"
 #include "private/qsimd_p.h"
@@ -164,7 +167,9 @@ static QT_PREPEND_NAMESPACE(qint64) qt_gettid()
 #include <memory>
 #include <vector>
 
+#include <errno.h>
 #include <stdio.h>
+#include <string.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -174,6 +179,7 @@ Q_NORETURN
 static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, const QString &message);
 static void qt_message_print(QtMsgType, const QMessageLogContext &context, const QString &message);
 static void qt_message_print(const QString &message);
+static bool qt_message_deferred(QtMsgType, const QMessageLogContext &context, const char *msg, va_list ap);
 
 static int checked_var_value(const char *varname)
 {
@@ -374,6 +380,8 @@ static inline void convert_to_wchar_t_elided(wchar_t *d, size_t space, const cha
 Q_NEVER_INLINE
 static QString qt_message(QtMsgType msgType, const QMessageLogContext &context, const char *msg, va_list ap)
 {
+    if (qt_message_deferred(msgType, context, msg, ap))
+        return QString();
     QString buf = QString::vasprintf(msg, ap);
     qt_message_print(msgType, context, buf);
     return buf;
@@ -1358,6 +1366,9 @@ static QString formatBacktraceForLogMessage(const QMessagePattern::BacktracePara
 
 Q_GLOBAL_STATIC(QMessagePattern, qMessagePattern)
 
+static QString formatLogMessage(QtMsgType type, const QMessageLogContext &context, const QString &str,
+                                const QtPrivate::LogMessageOrigin *origin);
+
 /*!
     \relates <QtGlobal>
     \since 5.4
@@ -1374,6 +1385,34 @@ Q_GLOBAL_STATIC(QMessagePattern, qMessagePattern)
  */
 QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, const QString &str)
 {
+    return formatLogMessage(type, context, str, nullptr);
+}
+
+/*!
+    \internal
+
+    Formats a message that was recorded by the binary log sink, see
+    QBinaryLogReader.
+*/
+QString QtPrivate::formatRecordedLogMessage(QtMsgType type, const QMessageLogContext &context,
+                                            const QString &message,
+                                            const LogMessageOrigin &origin)
+{
+    return formatLogMessage(type, context, message, &origin);
+}
+
+/*
+    Formats a message like qFormatLogMessage(). If \a origin is set, the
+    placeholders that describe the process, the thread and the time print
+    the values recorded in \a origin instead of the current ones, and
+    %{backtrace} is left empty.
+*/
+static QString formatLogMessage(QtMsgType type, const QMessageLogContext &context, const QString &str,
+                                const QtPrivate::LogMessageOrigin *origin)
+{
+#ifdef QT_BOOTSTRAPPED
+    Q_UNUSED(origin);
+#endif
     QString message;
 
     const auto locker = qt_scoped_lock(QMessagePattern::mutex);
@@ -1436,39 +1475,50 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
                 message.append(QLatin1String("unknown"));
 #ifndef QT_BOOTSTRAPPED
         } else if (token == pidTokenC) {
-            message.append(QString::number(QCoreApplication::applicationPid()));
+            message.append(QString::number(origin ? origin->pid : QCoreApplication::applicationPid()));
         } else if (token == appnameTokenC) {
-            message.append(QCoreApplication::applicationName());
+            message.append(origin ? origin->applicationName : QCoreApplication::applicationName());
         } else if (token == threadidTokenC) {
             // print the TID as decimal
-            message.append(QString::number(qt_gettid()));
+            message.append(QString::number(origin ? origin->threadId : qint64(qt_gettid())));
         } else if (token == qthreadptrTokenC) {
             message.append(QLatin1String("0x"));
-            message.append(QString::number(qlonglong(QThread::currentThread()->currentThread()), 16));
+            const quintptr thread = origin ? origin->threadPointer
+                                           : quintptr(QThread::currentThread()->currentThread());
+            message.append(QString::number(qlonglong(thread), 16));
 #ifdef QLOGGING_HAVE_BACKTRACE
         } else if (token == backtraceTokenC) {
             QMessagePattern::BacktraceParams backtraceParams = pattern->backtraceArgs.at(backtraceArgsIdx);
             backtraceArgsIdx++;
-            message.append(formatBacktraceForLogMessage(backtraceParams, context.function));
+            if (!origin)
+                message.append(formatBacktraceForLogMessage(backtraceParams, context.function));
 #endif
         } else if (token == timeTokenC) {
             QString timeFormat = pattern->timeArgs.at(timeArgsIdx);
             timeArgsIdx++;
             if (timeFormat == QLatin1String("process")) {
-                    quint64 ms = pattern->timer.elapsed();
+                    quint64 ms = origin ? origin->processMSecs : pattern->timer.elapsed();
                     message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
             } else if (timeFormat ==  QLatin1String("boot")) {
                 // just print the milliseconds since the elapsed timer reference
                 // like the Linux kernel does
-                QElapsedTimer now;
-                now.start();
-                uint ms = now.msecsSinceReference();
+                uint ms;
+                if (origin) {
+                    ms = uint(origin->bootMSecs);
+                } else {
+                    QElapsedTimer now;
+                    now.start();
+                    ms = now.msecsSinceReference();
+                }
                 message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
 #if QT_CONFIG(datestring)
-            } else if (timeFormat.isEmpty()) {
-                    message.append(QDateTime::currentDateTime().toString(Qt::ISODate));
             } else {
-                message.append(QDateTime::currentDateTime().toString(timeFormat));
+                const QDateTime time = origin ? QDateTime::fromMSecsSinceEpoch(origin->msecsSinceEpoch)
+                                              : QDateTime::currentDateTime();
+                if (timeFormat.isEmpty())
+                    message.append(time.toString(Qt::ISODate));
+                else
+                    message.append(time.toString(timeFormat));
 #endif // QT_CONFIG(datestring)
             }
 #endif // !QT_BOOTSTRAPPED
@@ -1715,6 +1765,1217 @@ static bool wasm_default_message_handler(QtMsgType type,
 
 #endif // Bootstrap check
 
+// ------------------------ Asynchronous stderr output ----------------------
+
+#if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(thread) && defined(Q_COMPILER_THREAD_LOCAL)
+#define QLOGGING_HAVE_ASYNC_OUTPUT
+
+namespace {
+/*
+    Single producer, single consumer ring buffer of formatted messages. Each
+    message is stored as its length followed by its bytes; head and tail are
+    free-running byte counters.
+*/
+class AsyncMessageRing
+{
+public:
+    enum { Capacity = 64 * 1024 };      // must be a power of two
+
+    // producer side
+    bool tryPush(const char *data, quint32 size)
+    {
+        const quint32 h = head.loadRelaxed();
+        const quint32 needed = quint32(sizeof(size)) + size;
+        if (Capacity - (h - tail.loadAcquire()) < needed)
+            return false;
+        copyIn(h, &size, sizeof(size));
+        copyIn(h + sizeof(size), data, size);
+        head.storeRelease(h + needed);
+        return true;
+    }
+
+    // consumer side
+    bool isEmpty() const
+    {
+        return head.loadAcquire() == tail.loadRelaxed();
+    }
+
+    void drain(QByteArray &out)
+    {
+        quint32 t = tail.loadRelaxed();
+        const quint32 h = head.loadAcquire();
+        while (t != h) {
+            quint32 size;
+            copyOut(t, &size, sizeof(size));
+            const int oldSize = out.size();
+            out.resize(oldSize + int(size));
+            copyOut(t + sizeof(size), out.data() + oldSize, size);
+            t += quint32(sizeof(size)) + size;
+        }
+        tail.storeRelease(t);
+    }
+
+    QAtomicInt orphaned = 0;            // set when the producing thread exits
+
+private:
+    void copyIn(quint32 pos, const void *src, quint32 size)
+    {
+        const quint32 offset = pos & (Capacity - 1);
+        const quint32 first = qMin<quint32>(size, Capacity - offset);
+        memcpy(buffer + offset, src, first);
+        memcpy(buffer, static_cast<const char *>(src) + first, size - first);
+    }
+
+    void copyOut(quint32 pos, void *dst, quint32 size) const
+    {
+        const quint32 offset = pos & (Capacity - 1);
+        const quint32 first = qMin<quint32>(size, Capacity - offset);
+        memcpy(dst, buffer + offset, first);
+        memcpy(static_cast<char *>(dst) + first, buffer, size - first);
+    }
+
+    QAtomicInteger<quint32> head = 0;
+    QAtomicInteger<quint32> tail = 0;
+    char buffer[Capacity];
+};
+
+// Trivially destructible, so that they can still be read by the destructors
+// of other thread_local objects that log after the ring is released.
+thread_local AsyncMessageRing *threadRing = nullptr;
+thread_local bool threadRingGone = false;
+
+/*
+    Writes the default stderr output from a background thread, so that
+    threads logging heavily don't wait for the terminal or the pipe on the
+    other end. Enabled by setting QT_LOGGING_ASYNC to "block" (or 1), which
+    makes a thread whose ring is full wait for the writer, or to "drop",
+    which discards the message and reports the number of dropped messages
+    later.
+
+    A thread only takes a lock the first time it logs, to register its ring.
+    Messages from one thread stay in order; messages from different threads
+    are written in batches and may interleave differently than they were
+    logged. Threads that log while their thread_local objects are being
+    destroyed, or after the writer has stopped, write synchronously.
+*/
+class AsyncMessageOutput
+{
+public:
+    enum OverflowPolicy { Block, Drop };
+
+    AsyncMessageOutput();
+    ~AsyncMessageOutput();
+
+    void write(const QByteArray &message);
+    void flush();
+
+    static int policyFromEnvironment();
+
+private:
+    class WriterThread : public QThread
+    {
+    public:
+        explicit WriterThread(AsyncMessageOutput *output) : output(output) {}
+        void run() override { output->runWriter(); }
+        AsyncMessageOutput *output;
+    };
+
+    struct RingHolder
+    {
+        ~RingHolder()
+        {
+            // the writer deletes the ring once it has drained it
+            if (AsyncMessageRing *ring = qExchange(threadRing, nullptr))
+                ring->orphaned.storeRelease(1);
+            threadRingGone = true;
+        }
+    };
+
+    void writeSynchronously(const QByteArray &message);
+    void runWriter();
+    bool drainAndWrite();
+    bool hasPendingMessages();
+    void wakeWriter();
+
+    const OverflowPolicy policy;
+    QAtomicInt dropped = 0;
+
+    QMutex ringsMutex;                  // protects rings
+    QList<AsyncMessageRing *> rings;
+
+    QMutex drainMutex;                  // held by whoever consumes the rings
+    QByteArray batch;
+
+    QMutex wakeMutex;
+    QWaitCondition writerWakeUp;
+    QWaitCondition spaceAvailable;
+    QWaitCondition producersDone;
+    QAtomicInt writerSleeping = 0;
+    QAtomicInt quit = 0;
+    int blockedProducers = 0;           // protected by wakeMutex
+
+    WriterThread writer;
+};
+
+int AsyncMessageOutput::policyFromEnvironment()
+{
+    const QByteArray value = qgetenv("QT_LOGGING_ASYNC");
+    if (value.isEmpty() || value == "0")
+        return -1;
+    return value == "drop" ? Drop : Block;
+}
+
+AsyncMessageOutput::AsyncMessageOutput()
+    : policy(OverflowPolicy(policyFromEnvironment())),
+      writer(this)
+{
+    writer.start();
+}
+
+AsyncMessageOutput::~AsyncMessageOutput()
+{
+    {
+        const auto locker = qt_scoped_lock(wakeMutex);
+        quit.storeRelease(1);
+        writerWakeUp.wakeAll();
+        spaceAvailable.wakeAll();
+    }
+    writer.wait();
+    {
+        // threads waiting for space write synchronously now
+        auto locker = qt_unique_lock(wakeMutex);
+        while (blockedProducers)
+            producersDone.wait(&wakeMutex);
+    }
+    flush();
+    // The rings are not deleted: threads that are still running at exit
+    // may still refer to theirs. They log synchronously from now on.
+}
+
+void AsyncMessageOutput::write(const QByteArray &message)
+{
+    if (!threadRing && !threadRingGone) {
+        static thread_local RingHolder holder;
+        Q_UNUSED(holder);
+        threadRing = new AsyncMessageRing;
+        const auto locker = qt_scoped_lock(ringsMutex);
+        rings.append(threadRing);
+    }
+
+    // Messages too large for any ring are written in the calling thread too.
+    if (!threadRing || quit.loadAcquire()
+            || message.size() + sizeof(quint32) > AsyncMessageRing::Capacity) {
+        writeSynchronously(message);
+        return;
+    }
+
+    if (!threadRing->tryPush(message.constData(), quint32(message.size()))) {
+        if (policy == Drop) {
+            dropped.ref();
+            return;
+        }
+
+        bool pushed = false;
+        {
+            auto locker = qt_unique_lock(wakeMutex);
+            ++blockedProducers;
+            while (!quit.loadRelaxed()) {
+                pushed = threadRing->tryPush(message.constData(), quint32(message.size()));
+                if (pushed)
+                    break;
+                writerWakeUp.wakeAll();
+                spaceAvailable.wait(&wakeMutex, 10);
+            }
+        }
+        if (!pushed)
+            writeSynchronously(message);
+
+        const auto locker = qt_scoped_lock(wakeMutex);
+        if (--blockedProducers == 0 && quit.loadRelaxed())
+            producersDone.wakeAll();
+        return;
+    }
+
+    if (writerSleeping.loadAcquire())
+        wakeWriter();
+}
+
+// Writes everything queued so far, then this message, in the calling thread.
+void AsyncMessageOutput::writeSynchronously(const QByteArray &message)
+{
+    const auto locker = qt_scoped_lock(drainMutex);
+    drainAndWrite();
+    fwrite(message.constData(), 1, message.size(), stderr);
+    fflush(stderr);
+}
+
+void AsyncMessageOutput::flush()
+{
+    const auto locker = qt_scoped_lock(drainMutex);
+    drainAndWrite();
+}
+
+void AsyncMessageOutput::wakeWriter()
+{
+    const auto locker = qt_scoped_lock(wakeMutex);
+    writerWakeUp.wakeAll();
+}
+
+bool AsyncMessageOutput::hasPendingMessages()
+{
+    const auto locker = qt_scoped_lock(ringsMutex);
+    return std::any_of(rings.cbegin(), rings.cend(),
+                       [](const AsyncMessageRing *ring) { return !ring->isEmpty(); });
+}
+
+// Must be called with drainMutex held.
+bool AsyncMessageOutput::drainAndWrite()
+{
+    batch.resize(0);
+    {
+        const auto locker = qt_scoped_lock(ringsMutex);
+        for (auto it = rings.begin(); it != rings.end(); ) {
+            AsyncMessageRing *ring = *it;
+            const bool orphaned = ring->orphaned.loadAcquire();
+            ring->drain(batch);
+            if (orphaned) {
+                delete ring;
+                it = rings.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    if (const int count = dropped.fetchAndStoreRelaxed(0))
+        batch += "QT_LOGGING_ASYNC: " + QByteArray::number(count) + " messages dropped\n";
+
+    if (batch.isEmpty())
+        return false;
+    fwrite(batch.constData(), 1, batch.size(), stderr);
+    fflush(stderr);
+    return true;
+}
+
+void AsyncMessageOutput::runWriter()
+{
+    for (;;) {
+        bool wrote;
+        {
+            const auto locker = qt_scoped_lock(drainMutex);
+            wrote = drainAndWrite();
+        }
+
+        const auto locker = qt_unique_lock(wakeMutex);
+        if (wrote) {
+            spaceAvailable.wakeAll();
+            continue;
+        }
+        if (quit.loadRelaxed())
+            return;
+
+        // A producer that pushes between hasPendingMessages() and the wait
+        // sees writerSleeping and wakes us up; the timeout is only a safety
+        // net against missed wake-ups.
+        writerSleeping.storeRelease(1);
+        if (!hasPendingMessages())
+            writerWakeUp.wait(&wakeMutex, 100);
+        writerSleeping.storeRelease(0);
+    }
+}
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(AsyncMessageOutput, asyncMessageOutput)
+
+static AsyncMessageOutput *asyncStderrOutput()
+{
+    static const bool enabled = AsyncMessageOutput::policyFromEnvironment() >= 0;
+    return enabled ? asyncMessageOutput() : nullptr;
+}
+
+static void flushAsyncStderrOutput()
+{
+    if (asyncMessageOutput.exists() && !asyncMessageOutput.isDestroyed())
+        asyncMessageOutput()->flush();
+}
+#endif // !QT_BOOTSTRAPPED && QT_CONFIG(thread) && Q_COMPILER_THREAD_LOCAL
+
+// ------------------------ Binary log output -------------------------------
+
+#if !defined(QT_BOOTSTRAPPED)
+template <typename Buffer>
+static void appendVarint(Buffer &out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(char(value | 0x80));
+        value >>= 7;
+    }
+    out.append(char(value));
+}
+
+template <typename Buffer>
+static void appendString(Buffer &out, const char *str, qsizetype size)
+{
+    appendVarint(out, quint64(size));
+    out.append(str, size);
+}
+
+template <typename Buffer>
+static void appendString(Buffer &out, const char *str)
+{
+    appendString(out, str, str ? qsizetype(strlen(str)) : 0);
+}
+
+namespace {
+// One conversion in a printf-style format, as QString::vasprintf() parses it
+struct LogFormatSpec
+{
+    enum Length { None, hh, h, l, ll, L, j, z, t };
+
+    const char *flags = nullptr;
+    qsizetype flagsSize = 0;
+    const char *width = nullptr;        // the digits, unless widthStar
+    qsizetype widthSize = 0;
+    const char *precision = nullptr;    // the digits, unless precisionStar
+    qsizetype precisionSize = 0;
+    bool widthStar = false;
+    bool hasPrecision = false;
+    bool precisionStar = false;
+    Length length = None;
+    char conversion = 0;
+};
+} // unnamed namespace
+
+/*
+    Walks the printf-style \a format the same way QString::vasprintf() does,
+    passing the literal text to \a text and each conversion to \a conversion.
+    Returns false if the format has a conversion whose argument cannot be
+    recorded (%n, %ls, unknown or incomplete conversions), or if
+    \a conversion does.
+*/
+template <typename TextFunction, typename ConversionFunction>
+static bool walkLogFormat(const char *c, TextFunction text, ConversionFunction conversion)
+{
+    const auto isDigit = [](char ch) { return ch >= '0' && ch <= '9'; };
+    for (;;) {
+        const char *begin = c;
+        while (*c != '\0' && *c != '%')
+            ++c;
+        if (c != begin)
+            text(begin, qsizetype(c - begin));
+        if (*c == '\0')
+            return true;
+
+        ++c;
+        if (*c == '\0' || *c == '%') {
+            // %% and a % at the end of the format are printed as is
+            text("%", 1);
+            if (*c != '\0')
+                ++c;
+            continue;
+        }
+
+        LogFormatSpec spec;
+        spec.flags = c;
+        while (*c != '\0' && strchr("#0- +'", *c))
+            ++c;
+        spec.flagsSize = qsizetype(c - spec.flags);
+
+        if (*c == '*') {
+            spec.widthStar = true;
+            ++c;
+        } else {
+            spec.width = c;
+            while (isDigit(*c))
+                ++c;
+            spec.widthSize = qsizetype(c - spec.width);
+        }
+
+        if (*c == '.') {
+            spec.hasPrecision = true;
+            ++c;
+            if (*c == '*') {
+                spec.precisionStar = true;
+                ++c;
+            } else {
+                spec.precision = c;
+                while (isDigit(*c))
+                    ++c;
+                spec.precisionSize = qsizetype(c - spec.precision);
+            }
+        }
+
+        switch (*c) {
+        case 'h':
+            spec.length = *++c == 'h' ? (++c, LogFormatSpec::hh) : LogFormatSpec::h;
+            break;
+        case 'l':
+            spec.length = *++c == 'l' ? (++c, LogFormatSpec::ll) : LogFormatSpec::l;
+            break;
+        case 'L': spec.length = LogFormatSpec::L; ++c; break;
+        case 'j': spec.length = LogFormatSpec::j; ++c; break;
+        case 'z':
+        case 'Z': spec.length = LogFormatSpec::z; ++c; break;
+        case 't': spec.length = LogFormatSpec::t; ++c; break;
+        }
+
+        spec.conversion = *c;
+        switch (*c) {
+        case 'd': case 'i':
+        case 'o': case 'u': case 'x': case 'X':
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+        case 'c': case 'p':
+            break;
+        case 's':
+            if (spec.length == LogFormatSpec::l)
+                return false;
+            break;
+        default:
+            return false;
+        }
+        ++c;
+
+        if (!conversion(spec))
+            return false;
+    }
+}
+
+template <typename Buffer>
+static void appendIntArgument(Buffer &out, qint64 value)
+{
+    out.append(char(QBinaryLog::IntArgument));
+    appendVarint(out, (quint64(value) << 1) ^ quint64(value >> 63));
+}
+
+template <typename Buffer>
+static void appendUIntArgument(Buffer &out, quint64 value)
+{
+    out.append(char(QBinaryLog::UIntArgument));
+    appendVarint(out, value);
+}
+
+template <typename Buffer>
+static void appendDoubleArgument(Buffer &out, double value)
+{
+    quint64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bits = qToLittleEndian(bits);
+    out.append(char(QBinaryLog::DoubleArgument));
+    out.append(reinterpret_cast<const char *>(&bits), qsizetype(sizeof(bits)));
+}
+
+/*
+    Records the arguments that QString::vasprintf() would take from \a ap for
+    \a format, which must have been accepted by walkLogFormat(), reading each
+    with the same type.
+*/
+template <typename Buffer>
+static void appendFormatArguments(Buffer &out, const char *format, va_list ap)
+{
+    walkLogFormat(format, [](const char *, qsizetype) {}, [&](const LogFormatSpec &spec) {
+        if (spec.widthStar)
+            appendIntArgument(out, va_arg(ap, int));
+        if (spec.precisionStar)
+            appendIntArgument(out, va_arg(ap, int));
+
+        switch (spec.conversion) {
+        case 'd':
+        case 'i': {
+            qint64 i = 0;       // QString::vasprintf() doesn't read an argument for L
+            switch (spec.length) {
+            case LogFormatSpec::None:
+            case LogFormatSpec::hh:
+            case LogFormatSpec::h:
+            case LogFormatSpec::t: i = va_arg(ap, int); break;
+            case LogFormatSpec::l:
+            case LogFormatSpec::j: i = va_arg(ap, long int); break;
+            case LogFormatSpec::ll: i = va_arg(ap, qint64); break;
+            case LogFormatSpec::z: i = qint64(va_arg(ap, size_t)); break;
+            case LogFormatSpec::L: break;
+            }
+            appendIntArgument(out, i);
+            break;
+        }
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X': {
+            quint64 u = 0;      // nor for L, j and t
+            switch (spec.length) {
+            case LogFormatSpec::None:
+            case LogFormatSpec::hh:
+            case LogFormatSpec::h: u = va_arg(ap, uint); break;
+            case LogFormatSpec::l: u = va_arg(ap, ulong); break;
+            case LogFormatSpec::ll: u = va_arg(ap, quint64); break;
+            case LogFormatSpec::z: u = va_arg(ap, size_t); break;
+            default: break;
+            }
+            appendUIntArgument(out, u);
+            break;
+        }
+        case 'c':
+            appendIntArgument(out, va_arg(ap, int));
+            break;
+        case 's':
+            if (const char *s = va_arg(ap, const char *)) {
+                out.append(char(QBinaryLog::StringArgument));
+                appendString(out, s);
+            } else {
+                out.append(char(QBinaryLog::NullStringArgument));
+            }
+            break;
+        case 'p':
+            appendUIntArgument(out, quintptr(va_arg(ap, void *)));
+            break;
+        default:
+            if (spec.length == LogFormatSpec::L)
+                appendDoubleArgument(out, double(va_arg(ap, long double)));
+            else
+                appendDoubleArgument(out, va_arg(ap, double));
+            break;
+        }
+        return true;
+    });
+}
+
+namespace {
+struct BinaryLogLocation
+{
+    QByteArray category;
+    QByteArray file;
+    QByteArray function;
+    int line;
+    quint32 id;
+};
+
+struct BinaryLogFormat
+{
+    QByteArray text;
+    quint32 id;
+    bool deferrable;
+};
+
+#ifdef Q_COMPILER_THREAD_LOCAL
+/*
+    Each thread remembers where the strings of recently used call sites were
+    found, so that logging from the same place again needs neither the lock
+    nor a hash lookup. The strings are compared again on a hit, as they need
+    not outlive the message.
+*/
+enum { BinaryLogCacheSize = 64 };       // must be a power of two
+
+struct BinaryLogLocationSlot
+{
+    const char *category;
+    const char *file;
+    const char *function;
+    int line;
+    const BinaryLogLocation *location;
+};
+
+struct BinaryLogFormatSlot
+{
+    const char *format;
+    const BinaryLogFormat *entry;
+};
+
+thread_local BinaryLogLocationSlot binaryLogLocationCache[BinaryLogCacheSize];
+thread_local BinaryLogFormatSlot binaryLogFormatCache[BinaryLogCacheSize];
+#endif
+
+/*
+    Writes the messages to the file named by QT_LOGGING_BINARY, in the format
+    described in qlogging_p.h, instead of formatting them: the message pattern
+    is applied when the file is decoded, and so are the printf-style formats
+    of the messages passed to writeDeferred(). Each distinct location and
+    format is written once and referred to by its number afterwards.
+
+    Every record is written with a single fwrite(), so records from different
+    threads don't interleave. The lock is only taken to add a location or a
+    format. The file is flushed shortly after a message is written, so that
+    little is lost if the application crashes, and immediately after critical
+    and fatal messages.
+*/
+class BinaryLogOutput
+{
+public:
+    BinaryLogOutput();
+    ~BinaryLogOutput();
+
+    bool isOpen() const { return file != nullptr; }
+    void write(QtMsgType type, const QMessageLogContext &context, const QString &message);
+    bool writeDeferred(QtMsgType type, const QMessageLogContext &context, const char *format,
+                       va_list ap);
+
+private:
+    enum {
+        MaxFormats = 1024,              // don't record ever new formats built at run-time
+        FlushInterval = 100             // ms
+    };
+
+    const BinaryLogLocation *location(const QMessageLogContext &context);
+    const BinaryLogFormat *format(const char *text);
+    template <typename Buffer>
+    void appendMessageHeader(Buffer &record, QtMsgType type);
+    void writeRecord(const char *data, qsizetype size, QtMsgType type);
+
+    QMutex mutex;                       // protects the tables below
+    QHash<QByteArray, BinaryLogLocation *> locations;
+    QHash<QByteArray, BinaryLogFormat *> formats;
+    quint32 formatCount = 0;            // formats written to the file
+    FILE *file = nullptr;
+    QElapsedTimer timer;
+
+#if QT_CONFIG(thread)
+    class FlusherThread : public QThread
+    {
+    public:
+        explicit FlusherThread(BinaryLogOutput *output) : output(output) {}
+        void run() override { output->runFlusher(); }
+        BinaryLogOutput *output;
+    };
+
+    void runFlusher();
+
+    QAtomicInt dirty = 0;               // written to since the last flush
+    QMutex flushMutex;
+    QWaitCondition flushWanted;
+    bool quit = false;
+    FlusherThread flusher;
+#endif
+};
+
+BinaryLogOutput::BinaryLogOutput()
+#if QT_CONFIG(thread)
+    : flusher(this)
+#endif
+{
+    const QByteArray fileName = qgetenv("QT_LOGGING_BINARY");
+    file = fopen(fileName.constData(), "wb");
+    if (!file) {
+        fprintf(stderr, "QT_LOGGING_BINARY: cannot open %s: %s\n",
+                fileName.constData(), strerror(errno));
+        return;
+    }
+    setvbuf(file, nullptr, _IOFBF, 64 * 1024);
+    timer.start();
+
+    QElapsedTimer now;
+    now.start();
+    qint64 processMSecs = 0;
+    {
+        const auto locker = qt_scoped_lock(QMessagePattern::mutex);
+        if (QMessagePattern *pattern = qMessagePattern())
+            processMSecs = pattern->timer.elapsed();
+    }
+
+    QByteArray header(QBinaryLog::magic(), QBinaryLog::MagicSize);
+    header.append(char(QBinaryLog::Version));
+    appendVarint(header, quint64(QCoreApplication::applicationPid()));
+    const QByteArray applicationName = QCoreApplication::applicationName().toUtf8();
+    appendString(header, applicationName.constData(), applicationName.size());
+    appendVarint(header, quint64(QDateTime::currentMSecsSinceEpoch()));
+    appendVarint(header, quint64(now.msecsSinceReference()));
+    appendVarint(header, quint64(processMSecs));
+    fwrite(header.constData(), 1, size_t(header.size()), file);
+
+#if QT_CONFIG(thread)
+    flusher.start();
+#endif
+}
+
+BinaryLogOutput::~BinaryLogOutput()
+{
+#if QT_CONFIG(thread)
+    if (flusher.isRunning()) {
+        {
+            const auto locker = qt_scoped_lock(flushMutex);
+            quit = true;
+            flushWanted.wakeOne();
+        }
+        flusher.wait();
+    }
+#endif
+    if (file)
+        fclose(file);
+    qDeleteAll(locations);
+    qDeleteAll(formats);
+}
+
+static bool sameLogString(const QByteArray &stored, const char *str)
+{
+    return str ? stored == str : stored.isEmpty();
+}
+
+const BinaryLogLocation *BinaryLogOutput::location(const QMessageLogContext &context)
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    const quintptr hash = (quintptr(context.function) >> 4) ^ quintptr(context.file)
+            ^ quintptr(uint(context.line) * 31);
+    BinaryLogLocationSlot &slot = binaryLogLocationCache[hash & (BinaryLogCacheSize - 1)];
+    if (slot.location && slot.line == context.line && slot.file == context.file
+            && slot.function == context.function && slot.category == context.category
+            && sameLogString(slot.location->file, context.file)
+            && sameLogString(slot.location->function, context.function)
+            && sameLogString(slot.location->category, context.category)) {
+        return slot.location;
+    }
+#endif
+
+    QByteArray key;
+    appendVarint(key, quint64(qMax(context.line, 0)));
+    appendString(key, context.category);
+    appendString(key, context.file);
+    appendString(key, context.function);
+
+    const BinaryLogLocation *result;
+    {
+        const auto locker = qt_scoped_lock(mutex);
+        auto it = locations.constFind(key);
+        if (it == locations.constEnd()) {
+            // written while holding the lock, so that no message can refer
+            // to the location before it is in the file
+            const QByteArray record = char(QBinaryLog::LocationRecord) + key;
+            fwrite(record.constData(), 1, size_t(record.size()), file);
+            it = locations.insert(key, new BinaryLogLocation{
+                    context.category, context.file, context.function, context.line,
+                    quint32(locations.size()) });
+        }
+        result = *it;
+    }
+
+#ifdef Q_COMPILER_THREAD_LOCAL
+    slot = { context.category, context.file, context.function, context.line, result };
+#endif
+    return result;
+}
+
+// Returns nullptr if there are too many formats to record another one.
+const BinaryLogFormat *BinaryLogOutput::format(const char *text)
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    BinaryLogFormatSlot &slot =
+            binaryLogFormatCache[(quintptr(text) >> 3) & (BinaryLogCacheSize - 1)];
+    if (slot.entry && slot.format == text && slot.entry->text == text)
+        return slot.entry;
+#endif
+
+    const QByteArray key(text);
+    const BinaryLogFormat *result;
+    {
+        const auto locker = qt_scoped_lock(mutex);
+        auto it = formats.constFind(key);
+        if (it == formats.constEnd()) {
+            if (formats.size() >= MaxFormats)
+                return nullptr;
+            const auto accept = [](const LogFormatSpec &) { return true; };
+            const bool deferrable = walkLogFormat(text, [](const char *, qsizetype) {}, accept);
+            quint32 id = 0;
+            if (deferrable) {
+                QByteArray record(1, char(QBinaryLog::FormatRecord));
+                appendString(record, key.constData(), key.size());
+                fwrite(record.constData(), 1, size_t(record.size()), file);
+                id = formatCount++;
+            }
+            it = formats.insert(key, new BinaryLogFormat{ key, id, deferrable });
+        }
+        result = *it;
+    }
+
+#ifdef Q_COMPILER_THREAD_LOCAL
+    slot = { text, result };
+#endif
+    return result;
+}
+
+template <typename Buffer>
+void BinaryLogOutput::appendMessageHeader(Buffer &record, QtMsgType type)
+{
+    record.append(char(type));
+    appendVarint(record, quint64(timer.elapsed()));
+    appendVarint(record, quint64(qt_gettid()));
+    appendVarint(record, quint64(quintptr(QThread::currentThread())));
+}
+
+void BinaryLogOutput::writeRecord(const char *data, qsizetype size, QtMsgType type)
+{
+    fwrite(data, 1, size_t(size), file);
+
+    // make sure the reason for a crash or an abort reaches the file
+    if (type == QtCriticalMsg || type == QtFatalMsg) {
+        fflush(file);
+        return;
+    }
+
+#if QT_CONFIG(thread)
+    if (!dirty.loadRelaxed() && dirty.testAndSetRelaxed(0, 1)) {
+        const auto locker = qt_scoped_lock(flushMutex);
+        flushWanted.wakeOne();
+    }
+#else
+    fflush(file);
+#endif
+}
+
+#if QT_CONFIG(thread)
+void BinaryLogOutput::runFlusher()
+{
+    auto locker = qt_unique_lock(flushMutex);
+    while (!quit) {
+        if (!dirty.loadRelaxed()) {
+            flushWanted.wait(&flushMutex);
+            continue;
+        }
+
+        // let more messages arrive before flushing, unless we're quitting
+        flushWanted.wait(&flushMutex, FlushInterval);
+        dirty.storeRelaxed(0);
+        locker.unlock();
+        fflush(file);
+        locker.lock();
+    }
+}
+#endif
+
+void BinaryLogOutput::write(QtMsgType type, const QMessageLogContext &context,
+                            const QString &message)
+{
+    const BinaryLogLocation *loc = location(context);
+    const QByteArray text = message.toUtf8();
+
+    QVarLengthArray<char, 256> record;
+    record.append(char(QBinaryLog::MessageRecord));
+    appendVarint(record, loc->id);
+    appendMessageHeader(record, type);
+    appendString(record, text.constData(), text.size());
+    writeRecord(record.constData(), record.size(), type);
+}
+
+/*
+    Records a message logged with a printf-style \a format and its arguments
+    \a ap, leaving the formatting to the reader. Returns false, without
+    reading any arguments, if the format cannot be recorded.
+*/
+bool BinaryLogOutput::writeDeferred(QtMsgType type, const QMessageLogContext &context,
+                                    const char *format, va_list ap)
+{
+    const BinaryLogFormat *fmt = this->format(format);
+    if (!fmt || !fmt->deferrable)
+        return false;
+    const BinaryLogLocation *loc = location(context);
+
+    QVarLengthArray<char, 256> record;
+    record.append(char(QBinaryLog::DeferredMessageRecord));
+    appendVarint(record, loc->id);
+    appendVarint(record, fmt->id);
+    appendMessageHeader(record, type);
+    va_list args;
+    va_copy(args, ap);
+    appendFormatArguments(record, format, args);
+    va_end(args);
+    writeRecord(record.constData(), record.size(), type);
+    return true;
+}
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(BinaryLogOutput, binaryLogOutput)
+
+static bool binaryLogEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIsSet("QT_LOGGING_BINARY");
+    return enabled;
+}
+
+static bool binary_message_handler(QtMsgType type, const QMessageLogContext &context,
+                                   const QString &message)
+{
+    if (!binaryLogEnabled())
+        return false;
+
+    BinaryLogOutput *output = binaryLogOutput();
+    if (!output || !output->isOpen())
+        return false;   // destroyed already, or could not open the file
+
+    output->write(type, context, message);
+    return true; // the binary log replaces the other sinks, including stderr
+}
+
+QBinaryLogReader::QBinaryLogReader(const QByteArray &data)
+    : data(data), pos(this->data.constData()), end(pos + this->data.size())
+{
+    if (end - pos < QBinaryLog::MagicSize + 1
+            || memcmp(pos, QBinaryLog::magic(), QBinaryLog::MagicSize) != 0
+            || pos[QBinaryLog::MagicSize] != char(QBinaryLog::Version))
+        return;
+    pos += QBinaryLog::MagicSize + 1;
+
+    quint64 pid, msecsSinceEpoch, bootMSecs, processMSecs;
+    QByteArray applicationName;
+    if (!readVarint(&pid) || !readString(&applicationName) || !readVarint(&msecsSinceEpoch)
+            || !readVarint(&bootMSecs) || !readVarint(&processMSecs))
+        return;
+
+    org.pid = qint64(pid);
+    org.applicationName = QString::fromUtf8(applicationName);
+    startMSecsSinceEpoch = qint64(msecsSinceEpoch);
+    startBootMSecs = qint64(bootMSecs);
+    startProcessMSecs = qint64(processMSecs);
+    valid = true;
+}
+
+bool QBinaryLogReader::readVarint(quint64 *value)
+{
+    quint64 result = 0;
+    for (int shift = 0; pos != end && shift < 64; shift += 7) {
+        const uchar c = uchar(*pos++);
+        result |= quint64(c & 0x7f) << shift;
+        if (!(c & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool QBinaryLogReader::readString(QByteArray *value)
+{
+    quint64 size;
+    if (!readVarint(&size) || size > quint64(end - pos))
+        return false;
+    *value = QByteArray(pos, qsizetype(size));
+    pos += size;
+    return true;
+}
+
+bool QBinaryLogReader::readLocation()
+{
+    Location location;
+    quint64 line;
+    if (!readVarint(&line) || !readString(&location.category) || !readString(&location.file)
+            || !readString(&location.function))
+        return false;
+    location.line = int(line);
+    locations.append(location);
+    return true;
+}
+
+bool QBinaryLogReader::readTag(quint8 tag)
+{
+    if (pos == end || uchar(*pos) != tag)
+        return false;
+    ++pos;
+    return true;
+}
+
+bool QBinaryLogReader::readIntArgument(qint64 *value)
+{
+    quint64 zigzag;
+    if (!readTag(QBinaryLog::IntArgument) || !readVarint(&zigzag))
+        return false;
+    *value = qint64(zigzag >> 1) ^ -qint64(zigzag & 1);
+    return true;
+}
+
+bool QBinaryLogReader::readUIntArgument(quint64 *value)
+{
+    return readTag(QBinaryLog::UIntArgument) && readVarint(value);
+}
+
+bool QBinaryLogReader::readDoubleArgument(double *value)
+{
+    quint64 bits;
+    if (!readTag(QBinaryLog::DoubleArgument) || end - pos < qsizetype(sizeof(bits)))
+        return false;
+    memcpy(&bits, pos, sizeof(bits));
+    pos += sizeof(bits);
+    bits = qFromLittleEndian(bits);
+    memcpy(value, &bits, sizeof(bits));
+    return true;
+}
+
+bool QBinaryLogReader::readStringArgument(QByteArray *value, bool *isNull)
+{
+    *isNull = readTag(QBinaryLog::NullStringArgument);
+    return *isNull || (readTag(QBinaryLog::StringArgument) && readString(value));
+}
+
+/*
+    Reads the arguments of a deferred message and formats them with \a format
+    into \a message, converting each one with QString::asprintf() as
+    QString::vasprintf() would have when the message was logged. The
+    recorded values of '*' widths and precisions are put into the conversion,
+    and the length modifier is replaced with one for the recorded type.
+*/
+bool QBinaryLogReader::readDeferredMessage(const QByteArray &format, QString *message)
+{
+    message->clear();
+    const auto appendText = [message](const char *text, qsizetype size) {
+        message->append(QString::fromUtf8(text, int(size)));
+    };
+    return walkLogFormat(format.constData(), appendText, [&](const LogFormatSpec &spec) {
+        QByteArray conversion = '%' + QByteArray(spec.flags, int(spec.flagsSize));
+        if (spec.widthStar) {
+            qint64 width;
+            if (!readIntArgument(&width))
+                return false;
+            if (width > 0)  // negative means unspecified, like 0
+                conversion += QByteArray::number(width);
+        } else {
+            conversion.append(spec.width, int(spec.widthSize));
+        }
+        if (spec.hasPrecision) {
+            conversion += '.';
+            if (spec.precisionStar) {
+                qint64 precision;
+                if (!readIntArgument(&precision))
+                    return false;
+                if (precision >= 0)
+                    conversion += QByteArray::number(precision);
+            } else {
+                conversion.append(spec.precision, int(spec.precisionSize));
+            }
+        }
+
+        switch (spec.conversion) {
+        case 'd':
+        case 'i': {
+            qint64 i;
+            if (!readIntArgument(&i))
+                return false;
+            conversion += "ll";
+            conversion += spec.conversion;
+            message->append(QString::asprintf(conversion.constData(), i));
+            break;
+        }
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X': {
+            quint64 u;
+            if (!readUIntArgument(&u))
+                return false;
+            conversion += "ll";
+            conversion += spec.conversion;
+            message->append(QString::asprintf(conversion.constData(), u));
+            break;
+        }
+        case 'c': {
+            qint64 c;
+            if (!readIntArgument(&c))
+                return false;
+            conversion += spec.length == LogFormatSpec::l ? "lc" : "c";
+            message->append(QString::asprintf(conversion.constData(), int(c)));
+            break;
+        }
+        case 's': {
+            QByteArray s;
+            bool isNull;
+            if (!readStringArgument(&s, &isNull))
+                return false;
+            conversion += 's';
+            message->append(QString::asprintf(conversion.constData(),
+                                              isNull ? nullptr : s.constData()));
+            break;
+        }
+        case 'p': {
+            quint64 p;
+            if (!readUIntArgument(&p))
+                return false;
+            conversion += 'p';
+            message->append(QString::asprintf(conversion.constData(),
+                                              reinterpret_cast<void *>(quintptr(p))));
+            break;
+        }
+        default: {
+            double d;
+            if (!readDoubleArgument(&d))
+                return false;
+            conversion += spec.conversion;
+            message->append(QString::asprintf(conversion.constData(), d));
+            break;
+        }
+        }
+        return true;
+    });
+}
+
+/*
+    Reads the next message, after any locations and formats that precede it.
+    Returns false at the end of the data, including when the last record was
+    cut short because the writing process was killed.
+*/
+bool QBinaryLogReader::readNext()
+{
+    if (!valid)
+        return false;
+
+    while (pos != end) {
+        const char kind = *pos++;
+        if (kind == char(QBinaryLog::LocationRecord)) {
+            if (!readLocation())
+                break;
+            continue;
+        }
+        if (kind == char(QBinaryLog::FormatRecord)) {
+            QByteArray format;
+            if (!readString(&format))
+                break;
+            formats.append(format);
+            continue;
+        }
+        if (kind != char(QBinaryLog::MessageRecord)
+                && kind != char(QBinaryLog::DeferredMessageRecord))
+            break;
+
+        const bool deferred = kind == char(QBinaryLog::DeferredMessageRecord);
+        quint64 index, formatIndex = 0, msecs, threadId, thread;
+        if (!readVarint(&index) || index >= quint64(locations.size()))
+            break;
+        if (deferred && (!readVarint(&formatIndex) || formatIndex >= quint64(formats.size())))
+            break;
+        if (pos == end)
+            break;
+        const QtMsgType type = QtMsgType(uchar(*pos++));
+        if (!readVarint(&msecs) || !readVarint(&threadId) || !readVarint(&thread))
+            break;
+        if (deferred) {
+            if (!readDeferredMessage(formats.at(qsizetype(formatIndex)), &msg))
+                break;
+        } else {
+            QByteArray text;
+            if (!readString(&text))
+                break;
+            msg = QString::fromUtf8(text);
+        }
+
+        const Location &location = locations.at(qsizetype(index));
+        ctx.line = location.line;
+        ctx.category = location.category.isEmpty() ? nullptr : location.category.constData();
+        ctx.file = location.file.isEmpty() ? nullptr : location.file.constData();
+        ctx.function = location.function.isEmpty() ? nullptr : location.function.constData();
+        msgType = type;
+        org.threadId = qint64(threadId);
+        org.threadPointer = quintptr(thread);
+        org.msecsSinceEpoch = startMSecsSinceEpoch + qint64(msecs);
+        org.bootMSecs = startBootMSecs + qint64(msecs);
+        org.processMSecs = startProcessMSecs + qint64(msecs);
+        return true;
+    }
+
+    pos = end;
+    return false;
+}
+
+/*
+    Returns the current message formatted with the message pattern, as the
+    default message handler would have printed it.
+*/
+QString QBinaryLogReader::formattedMessage() const
+{
+    return QtPrivate::formatRecordedLogMessage(msgType, ctx, msg, org);
+}
+#endif // !QT_BOOTSTRAPPED
+
 // --------------------------------------------------------------------------
 
 static void stderr_message_handler(QtMsgType type, const QMessageLogContext &context, const QString &message)
@@ -1726,6 +2987,15 @@ static void stderr_message_handler(QtMsgType type, const QMessageLogContext &con
     if (formattedMessage.isNull())
         return;
 
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    if (AsyncMessageOutput *output = asyncStderrOutput()) {
+        QByteArray line = formattedMessage.toLocal8Bit();
+        line += '\n';
+        output->write(line);
+        return;
+    }
+#endif
+
     fprintf(stderr, "%s\n", formattedMessage.toLocal8Bit().constData());
     fflush(stderr);
 }
@@ -1745,6 +3015,9 @@ static void qDefaultMessageHandler(QtMsgType type, const QMessageLogContext &con
     // a list of sinks.
 
 #if !defined(QT_BOOTSTRAPPED)
+    if (binary_message_handler(type, context, message))
+        return;
+
 # if defined(Q_OS_WIN)
     handledStderr |= win_message_handler(type, context, message);
 # elif QT_CONFIG(slog2)
@@ -1798,6 +3071,44 @@ static bool grabMessageHandler() { return true; }
 static void ungrabMessageHandler() { }
 #endif // (Q_COMPILER_THREAD_LOCAL)
 
+/*
+    Writes a debug or info message to the binary log without formatting it,
+    if nothing else needs to see the formatted text: the binary log is the
+    default message handler's only output and no handler is installed.
+    Returns true if the message was dealt with.
+*/
+static bool qt_message_deferred(QtMsgType msgType, const QMessageLogContext &context,
+                                const char *msg, va_list ap)
+{
+#ifndef QT_BOOTSTRAPPED
+    if (msgType != QtDebugMsg && msgType != QtInfoMsg)
+        return false;
+    if (Q_TRACE_ENABLED(qt_message_print) || !binaryLogEnabled())
+        return false;
+    if (msgHandler.loadAcquire() || messageHandler.loadAcquire())
+        return false;
+
+    if (isDefaultCategory(context.category)) {
+        if (QLoggingCategory *defaultCategory = QLoggingCategory::defaultCategory()) {
+            if (!defaultCategory->isEnabled(msgType))
+                return true;
+        }
+    }
+
+    if (!grabMessageHandler())
+        return false;
+    const auto ungrab = qScopeGuard([]{ ungrabMessageHandler(); });
+    BinaryLogOutput *output = binaryLogOutput();
+    return output && output->isOpen() && output->writeDeferred(msgType, context, msg, ap);
+#else
+    Q_UNUSED(msgType);
+    Q_UNUSED(context);
+    Q_UNUSED(msg);
+    Q_UNUSED(ap);
+    return false;
+#endif
+}
+
 static void qt_message_print(QtMsgType msgType, const QMessageLogContext &context, const QString &message)
 {
 #ifndef QT_BOOTSTRAPPED
@@ -1868,6 +3179,11 @@ static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, const
     Q_UNUSED(message);
 #endif
 
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    // the fatal message itself may still be queued
+    flushAsyncStderrOutput();
+#endif
+
 #ifdef Q_OS_WIN
     // std::abort() in the MSVC runtime will call _exit(3) if the abort
     // behavior is _WRITE_ABORT_MSG - see also _set_abort_behavior(). This is
@@ -1984,6 +3300,26 @@ void qErrnoWarning(int code, const char *msg, ...)
     output under X11 or to the debugger under Windows. If it is a
     fatal message, the application aborts immediately.
 
+    If the \c QT_LOGGING_ASYNC environment variable is set to \c block
+    or \c drop, the default message handler formats messages in the
+    calling thread but writes them to \c stderr from a background thread.
+    When a thread logs faster than the output can be written, \c block
+    makes it wait, while \c drop discards its messages and reports how
+    many were lost. Pending messages are written before a fatal message
+    aborts the application, and when the application exits.
+
+    If the \c QT_LOGGING_BINARY environment variable names a file, the
+    default handler writes the messages to that file in a compact binary
+    form instead of formatting them, and prints nothing to \c stderr. The
+    type, category, location, thread and time of each message are recorded,
+    so that the \c qlogdecode tool can later print the messages with any
+    message pattern. Debug and info messages logged with a printf-style
+    format, such as \c{qDebug("%d", value)}, are not even formatted: their
+    arguments are recorded and formatted when the file is decoded. This
+    doesn't apply when a message handler is installed, or to messages
+    streamed with \c{qDebug() <<}. Messages are flushed to the file shortly
+    after they are logged, and critical and fatal messages immediately.
+
     Only one message handler can be defined, since this is usually
     done on an application-wide basis to control debug output.
 
@@ -51,14 +51,140 @@
 // We mean it.
 //
 
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+
 QT_BEGIN_NAMESPACE
 
 namespace QtPrivate {
 
 Q_CORE_EXPORT bool shouldLogToStderr();
 
+// What %{pid}, %{appname}, %{threadid}, %{qthreadptr} and %{time} print for
+// a message that was recorded earlier, possibly by another process.
+struct LogMessageOrigin
+{
+    qint64 pid = 0;
+    QString applicationName;
+    qint64 threadId = 0;
+    quintptr threadPointer = 0;
+    qint64 processMSecs = 0;            // since the logging process started
+    qint64 bootMSecs = 0;               // since the QElapsedTimer reference
+    qint64 msecsSinceEpoch = 0;
+};
+
+Q_CORE_EXPORT QString formatRecordedLogMessage(QtMsgType type, const QMessageLogContext &context,
+                                               const QString &message,
+                                               const LogMessageOrigin &origin);
+
+}
+
+#ifndef QT_BOOTSTRAPPED
+/*
+    The files written when QT_LOGGING_BINARY is set start with a header
+
+        "QtLogBin" | u8 version | pid | string applicationName
+                   | msecsSinceEpoch | bootMSecs | processMSecs
+
+    where the times are taken when the file is created. It is followed by
+    records, each starting with a u8 record kind:
+
+        LocationRecord: line | string category | string file | string function
+        FormatRecord:   string format
+        MessageRecord:  location | u8 type | msecs | threadId | threadPointer
+                        | string message
+        DeferredMessageRecord:
+                        location | format | u8 type | msecs | threadId
+                        | threadPointer | arguments
+
+    Locations and formats are numbered from 0 in the order they appear. msecs
+    counts from the time in the header. Unmarked integers are unsigned LEB128
+    varints and strings are a varint length followed by that many bytes of
+    UTF-8; null strings are stored as empty ones.
+
+    A deferred message was logged with a printf-style format, see qDebug(),
+    and is formatted by the reader. Its arguments follow in the order the
+    format consumes them, including the values of '*' widths and precisions.
+    Each starts with a u8 tag:
+
+        IntArgument:        zigzag-encoded varint
+        UIntArgument:       varint
+        DoubleArgument:     8 bytes, little-endian IEEE 754
+        StringArgument:     string
+        NullStringArgument: nothing
+*/
+namespace QBinaryLog {
+enum : quint8 {
+    Version = 2,
+    LocationRecord = 1,
+    MessageRecord = 2,
+    FormatRecord = 3,
+    DeferredMessageRecord = 4
+};
+enum : quint8 {
+    IntArgument = 1,
+    UIntArgument = 2,
+    DoubleArgument = 3,
+    StringArgument = 4,
+    NullStringArgument = 5
+};
+inline const char *magic() { return "QtLogBin"; }
+enum { MagicSize = 8 };
 }
 
+class Q_CORE_EXPORT QBinaryLogReader
+{
+public:
+    explicit QBinaryLogReader(const QByteArray &data);
+
+    bool isValid() const { return valid; }
+    bool readNext();
+
+    QtMsgType type() const { return msgType; }
+    const QMessageLogContext &context() const { return ctx; }
+    QString message() const { return msg; }
+    const QtPrivate::LogMessageOrigin &origin() const { return org; }
+    QString formattedMessage() const;
+
+private:
+    struct Location
+    {
+        int line;
+        QByteArray category;
+        QByteArray file;
+        QByteArray function;
+    };
+
+    bool readVarint(quint64 *value);
+    bool readString(QByteArray *value);
+    bool readLocation();
+    bool readTag(quint8 tag);
+    bool readIntArgument(qint64 *value);
+    bool readUIntArgument(quint64 *value);
+    bool readDoubleArgument(double *value);
+    bool readStringArgument(QByteArray *value, bool *isNull);
+    bool readDeferredMessage(const QByteArray &format, QString *message);
+
+    QByteArray data;
+    const char *pos = nullptr;
+    const char *end = nullptr;
+    QList<Location> locations;
+    QList<QByteArray> formats;
+    qint64 startMSecsSinceEpoch = 0;
+    qint64 startBootMSecs = 0;
+    qint64 startProcessMSecs = 0;
+    QtMsgType msgType = QtDebugMsg;
+    QMessageLogContext ctx;
+    QString msg;
+    QtPrivate::LogMessageOrigin org;
+    bool valid = false;
+
+    Q_DISABLE_COPY(QBinaryLogReader)
+};
+#endif // !QT_BOOTSTRAPPED
+
 QT_END_NAMESPACE
 
 #endif // QLOGGING_P_H
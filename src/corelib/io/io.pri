@@ -3,6 +3,9 @@
 HEADERS +=  \
         io/qabstractfileengine_p.h \
         io/qbuffer.h \
+        io/qcompressingdevice.h \
+        io/qcompression.h \
+        io/qcompression_p.h \
         io/qdataurl_p.h \
         io/qdebug.h \
         io/qdebug_p.h \
@@ -48,6 +51,8 @@ HEADERS +=  \
 SOURCES += \
         io/qabstractfileengine.cpp \
         io/qbuffer.cpp \
+        io/qcompressingdevice.cpp \
+        io/qcompression.cpp \
         io/qdataurl.cpp \
         io/qtldurl.cpp \
         io/qdebug.cpp \
@@ -80,6 +85,7 @@ SOURCES += \
         io/qloggingregistry.cpp
 
 qtConfig(zstd): QMAKE_USE_PRIVATE += zstd
+qtConfig(lz4): QMAKE_USE_PRIVATE += lz4
 
 qtConfig(filesystemwatcher) {
     HEADERS += \
@@ -118,11 +124,25 @@ qtConfig(processenvironment) {
         SOURCES += io/qprocess_win.cpp
     else: unix: \
         SOURCES += io/qprocess_unix.cpp
+
+    qtConfig(process):qtConfig(thread) {
+        SOURCES += \
+            io/qprocesspool.cpp
+        HEADERS += \
+            io/qprocesspool.h \
+            io/qprocesspool_p.h
+
+        win32:!winrt: \
+            SOURCES += io/qprocesspool_win.cpp
+        else: unix: \
+            SOURCES += io/qprocesspool_unix.cpp
+    }
 }
 
 qtConfig(settings) {
     SOURCES += \
-        io/qsettings.cpp
+        io/qsettings.cpp \
+        io/qsettings_indexed.cpp
     HEADERS += \
         io/qsettings.h \
         io/qsettings_p.h
@@ -0,0 +1,545 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qcompressingdevice.h"
+#include "private/qcompression_p.h"
+#include "private/qiodevice_p.h"
+
+#ifndef QT_NO_COMPRESS
+
+QT_BEGIN_NAMESPACE
+
+class QCompressingDevicePrivate : public QIODevicePrivate
+{
+    Q_DECLARE_PUBLIC(QCompressingDevice)
+
+public:
+    bool compress(const char *data, qint64 len, QCompressor::Mode mode);
+
+    QIODevice *device = nullptr;
+    QCompression::Algorithm algorithm = QCompression::Zlib;
+    int level = -1;
+    QByteArray dictionary;
+    std::unique_ptr<QCompressor> compressor;
+};
+
+bool QCompressingDevicePrivate::compress(const char *data, qint64 len, QCompressor::Mode mode)
+{
+    Q_Q(QCompressingDevice);
+    QByteArray output;
+    if (!compressor->compress(data, qsizetype(len), &output, mode)) {
+        q->setErrorString(compressor->errorString());
+        return false;
+    }
+    if (!output.isEmpty() && device->write(output) != output.size()) {
+        q->setErrorString(device->errorString());
+        return false;
+    }
+    return true;
+}
+
+/*!
+    \class QCompressingDevice
+    \inmodule QtCore
+    \since 6.0
+    \brief The QCompressingDevice class compresses data written to it into
+    another QIODevice.
+
+    \ingroup io
+    \reentrant
+
+    QCompressingDevice wraps a device that is open for writing. Everything
+    written to the QCompressingDevice is compressed with the selected
+    QCompression::Algorithm and written to the underlying device, so data of
+    any size can be compressed without holding it in memory:
+
+    \snippet code/src_corelib_io_qcompressingdevice.cpp 0
+
+    The compressed stream is only complete once close() has been called. Use
+    flush() to make everything written so far decodable by the reader
+    without ending the stream, for example before waiting for a reply on a
+    network connection.
+
+    The stream can be read back with QDecompressingDevice or with
+    QCompression::decompress().
+
+    \sa QDecompressingDevice, QCompression
+*/
+
+/*!
+    Constructs a QCompressingDevice that compresses into \a device with
+    \a algorithm. The \a device must outlive the QCompressingDevice and be
+    open for writing when open() is called.
+
+    The \a parent is passed to the QIODevice constructor.
+*/
+QCompressingDevice::QCompressingDevice(QIODevice *device, QCompression::Algorithm algorithm,
+                                       QObject *parent)
+    : QIODevice(*new QCompressingDevicePrivate, parent)
+{
+    Q_D(QCompressingDevice);
+    d->device = device;
+    d->algorithm = algorithm;
+}
+
+/*!
+    Destroys the QCompressingDevice, calling close() first if necessary.
+*/
+QCompressingDevice::~QCompressingDevice()
+{
+    close();
+}
+
+/*!
+    Returns the device the compressed data is written to.
+*/
+QIODevice *QCompressingDevice::device() const
+{
+    Q_D(const QCompressingDevice);
+    return d->device;
+}
+
+/*!
+    Returns the compression algorithm.
+*/
+QCompression::Algorithm QCompressingDevice::algorithm() const
+{
+    Q_D(const QCompressingDevice);
+    return d->algorithm;
+}
+
+/*!
+    Returns the compression level. The default is -1, which selects the
+    default level of the algorithm.
+
+    \sa setCompressionLevel(), QCompression::compress()
+*/
+int QCompressingDevice::compressionLevel() const
+{
+    Q_D(const QCompressingDevice);
+    return d->level;
+}
+
+/*!
+    Sets the compression level to \a level. The change takes effect the next
+    time the device is opened.
+
+    \sa compressionLevel()
+*/
+void QCompressingDevice::setCompressionLevel(int level)
+{
+    Q_D(QCompressingDevice);
+    d->level = level;
+}
+
+/*!
+    Returns the preset dictionary, or an empty QByteArray if none is used.
+
+    \sa setDictionary()
+*/
+QByteArray QCompressingDevice::dictionary() const
+{
+    Q_D(const QCompressingDevice);
+    return d->dictionary;
+}
+
+/*!
+    Primes the compressor with \a dictionary. The same dictionary must be set
+    on the QDecompressingDevice that reads the data back. The change takes
+    effect the next time the device is opened.
+
+    \sa dictionary(), QCompression::compress()
+*/
+void QCompressingDevice::setDictionary(const QByteArray &dictionary)
+{
+    Q_D(QCompressingDevice);
+    d->dictionary = dictionary;
+}
+
+/*!
+    \reimp
+
+    Starts a new compressed stream. The only supported \a mode is
+    QIODevice::WriteOnly, optionally combined with QIODevice::Text.
+    Returns \c false if the algorithm is not available, in which case
+    errorString() says why, or if the underlying device is not writable.
+*/
+bool QCompressingDevice::open(OpenMode mode)
+{
+    Q_D(QCompressingDevice);
+    if (isOpen()) {
+        qWarning("QCompressingDevice::open: Device already open");
+        return false;
+    }
+    if ((mode & ~(Text | Unbuffered)) != WriteOnly) {
+        qWarning("QCompressingDevice::open: Only WriteOnly is supported");
+        return false;
+    }
+    if (!d->device || !d->device->isWritable()) {
+        qWarning("QCompressingDevice::open: The underlying device is not open for writing");
+        return false;
+    }
+
+    QString errorString;
+    d->compressor = QCompressor::create(d->algorithm, d->level, d->dictionary, &errorString);
+    if (!d->compressor) {
+        setErrorString(errorString);
+        return false;
+    }
+    return QIODevice::open(mode | Unbuffered);
+}
+
+/*!
+    \reimp
+
+    Ends the compressed stream, writes what remains of it to the underlying
+    device and closes this device. The underlying device is not closed.
+*/
+void QCompressingDevice::close()
+{
+    Q_D(QCompressingDevice);
+    if (!isOpen())
+        return;
+    if (d->compressor) {
+        d->compress(nullptr, 0, QCompressor::Finish);
+        d->compressor.reset();
+    }
+    QIODevice::close();
+}
+
+/*!
+    \reimp
+
+    Always returns \c true.
+*/
+bool QCompressingDevice::isSequential() const
+{
+    return true;
+}
+
+/*!
+    Writes out everything compressed so far, so that a reader can decompress
+    all data written up to this point, without ending the stream. Flushing
+    often degrades the compression ratio.
+
+    Returns \c true on success.
+*/
+bool QCompressingDevice::flush()
+{
+    Q_D(QCompressingDevice);
+    return d->compressor && d->compress(nullptr, 0, QCompressor::Flush);
+}
+
+/*!
+    \reimp
+*/
+qint64 QCompressingDevice::readData(char *data, qint64 maxlen)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxlen);
+    return -1;
+}
+
+/*!
+    \reimp
+*/
+qint64 QCompressingDevice::writeData(const char *data, qint64 len)
+{
+    Q_D(QCompressingDevice);
+    if (!d->compressor || !d->compress(data, len, QCompressor::Continue))
+        return -1;
+    return len;
+}
+
+class QDecompressingDevicePrivate : public QIODevicePrivate
+{
+    Q_DECLARE_PUBLIC(QDecompressingDevice)
+
+public:
+    QIODevice *device = nullptr;
+    QCompression::Algorithm algorithm = QCompression::Zlib;
+    QByteArray dictionary;
+    std::unique_ptr<QDecompressor> decompressor;
+    QByteArray input;
+    qsizetype inputPos = 0;
+    bool failed = false;
+};
+
+/*!
+    \class QDecompressingDevice
+    \inmodule QtCore
+    \since 6.0
+    \brief The QDecompressingDevice class decompresses data read from
+    another QIODevice.
+
+    \ingroup io
+    \reentrant
+
+    QDecompressingDevice wraps a device that is open for reading and
+    contains data compressed with the selected QCompression::Algorithm, for
+    example by QCompressingDevice. Reading from the QDecompressingDevice
+    returns the decompressed data, which is produced on demand:
+
+    \snippet code/src_corelib_io_qcompressingdevice.cpp 1
+
+    atEnd() returns \c true once the end of the compressed stream has been
+    reached, or after an error. If the underlying device is random-access,
+    it is then left positioned right after the compressed stream.
+
+    If the underlying device is sequential, such as a socket, the
+    QDecompressingDevice emits readyRead() whenever the underlying device
+    does, and read() returns only what can be decompressed from the data
+    that has arrived so far.
+
+    \sa QCompressingDevice, QCompression
+*/
+
+/*!
+    Constructs a QDecompressingDevice that decompresses data read from
+    \a device with \a algorithm. The \a device must outlive the
+    QDecompressingDevice and be open for reading when open() is called.
+
+    The \a parent is passed to the QIODevice constructor.
+*/
+QDecompressingDevice::QDecompressingDevice(QIODevice *device, QCompression::Algorithm algorithm,
+                                           QObject *parent)
+    : QIODevice(*new QDecompressingDevicePrivate, parent)
+{
+    Q_D(QDecompressingDevice);
+    d->device = device;
+    d->algorithm = algorithm;
+}
+
+/*!
+    Destroys the QDecompressingDevice.
+*/
+QDecompressingDevice::~QDecompressingDevice()
+{
+    close();
+}
+
+/*!
+    Returns the device the compressed data is read from.
+*/
+QIODevice *QDecompressingDevice::device() const
+{
+    Q_D(const QDecompressingDevice);
+    return d->device;
+}
+
+/*!
+    Returns the compression algorithm.
+*/
+QCompression::Algorithm QDecompressingDevice::algorithm() const
+{
+    Q_D(const QDecompressingDevice);
+    return d->algorithm;
+}
+
+/*!
+    Returns the preset dictionary, or an empty QByteArray if none is used.
+
+    \sa setDictionary()
+*/
+QByteArray QDecompressingDevice::dictionary() const
+{
+    Q_D(const QDecompressingDevice);
+    return d->dictionary;
+}
+
+/*!
+    Sets the preset \a dictionary the data was compressed with. The change
+    takes effect the next time the device is opened.
+
+    \sa dictionary(), QCompressingDevice::setDictionary()
+*/
+void QDecompressingDevice::setDictionary(const QByteArray &dictionary)
+{
+    Q_D(QDecompressingDevice);
+    d->dictionary = dictionary;
+}
+
+/*!
+    \reimp
+
+    Starts decompressing a new stream. The only supported \a mode is
+    QIODevice::ReadOnly, optionally combined with QIODevice::Text and
+    QIODevice::Unbuffered. Returns \c false if the algorithm is not
+    available, in which case errorString() says why, or if the underlying
+    device is not readable.
+*/
+bool QDecompressingDevice::open(OpenMode mode)
+{
+    Q_D(QDecompressingDevice);
+    if (isOpen()) {
+        qWarning("QDecompressingDevice::open: Device already open");
+        return false;
+    }
+    if ((mode & ~(Text | Unbuffered)) != ReadOnly) {
+        qWarning("QDecompressingDevice::open: Only ReadOnly is supported");
+        return false;
+    }
+    if (!d->device || !d->device->isReadable()) {
+        qWarning("QDecompressingDevice::open: The underlying device is not open for reading");
+        return false;
+    }
+
+    QString errorString;
+    d->decompressor = QDecompressor::create(d->algorithm, d->dictionary, &errorString);
+    if (!d->decompressor) {
+        setErrorString(errorString);
+        return false;
+    }
+    d->input.clear();
+    d->inputPos = 0;
+    d->failed = false;
+    connect(d->device, &QIODevice::readyRead, this, &QIODevice::readyRead);
+    return QIODevice::open(mode);
+}
+
+/*!
+    \reimp
+
+    Closes this device. The underlying device is not closed.
+*/
+void QDecompressingDevice::close()
+{
+    Q_D(QDecompressingDevice);
+    if (!isOpen())
+        return;
+    disconnect(d->device, &QIODevice::readyRead, this, &QIODevice::readyRead);
+    d->decompressor.reset();
+    d->input.clear();
+    QIODevice::close();
+}
+
+/*!
+    \reimp
+
+    Always returns \c true.
+*/
+bool QDecompressingDevice::isSequential() const
+{
+    return true;
+}
+
+/*!
+    \reimp
+
+    Returns \c true if all data of the compressed stream has been read, or if
+    an error occurred.
+*/
+bool QDecompressingDevice::atEnd() const
+{
+    Q_D(const QDecompressingDevice);
+    return QIODevice::atEnd()
+            && (d->failed || !d->decompressor || d->decompressor->isFinished());
+}
+
+/*!
+    \reimp
+*/
+qint64 QDecompressingDevice::readData(char *data, qint64 maxlen)
+{
+    Q_D(QDecompressingDevice);
+    if (d->failed || !d->decompressor)
+        return -1;
+
+    qint64 produced = 0;
+    while (produced < maxlen && !d->decompressor->isFinished()) {
+        if (d->inputPos == d->input.size()) {
+            d->input.resize(QIODEVICE_BUFFERSIZE);
+            d->inputPos = 0;
+            const qint64 read = d->device->read(d->input.data(), d->input.size());
+            d->input.resize(int(qMax<qint64>(read, 0)));
+            if (read < 0 || (read == 0 && !d->device->isSequential() && d->device->atEnd())) {
+                if (produced)
+                    break;      // report the error on the next call
+                d->failed = true;
+                setErrorString(tr("Unexpected end of compressed data"));
+                return -1;
+            }
+            if (read == 0)
+                break;          // wait for more data to arrive
+        }
+
+        const char *input = d->input.constData() + d->inputPos;
+        qsizetype inputSize = d->input.size() - d->inputPos;
+        const qsizetype n = d->decompressor->decompress(&input, &inputSize, data + produced,
+                                                        qsizetype(maxlen - produced));
+        if (n < 0) {
+            d->failed = true;
+            setErrorString(d->decompressor->errorString());
+            return -1;
+        }
+        if (n == 0 && inputSize == d->input.size() - d->inputPos && inputSize) {
+            d->failed = true;
+            setErrorString(tr("Input data is corrupted"));
+            return -1;
+        }
+        d->inputPos = d->input.size() - inputSize;
+        produced += n;
+    }
+
+    if (d->decompressor->isFinished() && d->inputPos < d->input.size()) {
+        // hand back what we read past the end of the stream
+        if (!d->device->isSequential())
+            d->device->seek(d->device->pos() - (d->input.size() - d->inputPos));
+        d->input.clear();
+        d->inputPos = 0;
+    }
+    return produced;
+}
+
+/*!
+    \reimp
+*/
+qint64 QDecompressingDevice::writeData(const char *data, qint64 len)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(len);
+    return -1;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qcompressingdevice.cpp"
+
+#endif // QT_NO_COMPRESS
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QCOMPRESSINGDEVICE_H
+#define QCOMPRESSINGDEVICE_H
+
+#include <QtCore/qiodevice.h>
+#include <QtCore/qcompression.h>
+
+QT_BEGIN_NAMESPACE
+
+
+#ifndef QT_NO_COMPRESS
+class QCompressingDevicePrivate;
+class QDecompressingDevicePrivate;
+
+class Q_CORE_EXPORT QCompressingDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    explicit QCompressingDevice(QIODevice *device,
+                                QCompression::Algorithm algorithm = QCompression::Zlib,
+                                QObject *parent = nullptr);
+    ~QCompressingDevice();
+
+    QIODevice *device() const;
+    QCompression::Algorithm algorithm() const;
+
+    int compressionLevel() const;
+    void setCompressionLevel(int level);
+
+    QByteArray dictionary() const;
+    void setDictionary(const QByteArray &dictionary);
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override;
+
+    bool flush();
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+    qint64 writeData(const char *data, qint64 len) override;
+
+private:
+    Q_DECLARE_PRIVATE(QCompressingDevice)
+    Q_DISABLE_COPY(QCompressingDevice)
+};
+
+class Q_CORE_EXPORT QDecompressingDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    explicit QDecompressingDevice(QIODevice *device,
+                                  QCompression::Algorithm algorithm = QCompression::Zlib,
+                                  QObject *parent = nullptr);
+    ~QDecompressingDevice();
+
+    QIODevice *device() const;
+    QCompression::Algorithm algorithm() const;
+
+    QByteArray dictionary() const;
+    void setDictionary(const QByteArray &dictionary);
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override;
+    bool atEnd() const override;
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+    qint64 writeData(const char *data, qint64 len) override;
+
+private:
+    Q_DECLARE_PRIVATE(QDecompressingDevice)
+    Q_DISABLE_COPY(QDecompressingDevice)
+};
+#endif // QT_NO_COMPRESS
+
+QT_END_NAMESPACE
+
+#endif // QCOMPRESSINGDEVICE_H
@@ -0,0 +1,690 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qcompression.h"
+#include "qcompression_p.h"
+
+#ifndef QT_NO_COMPRESS
+#include "private/qbytearray_p.h"
+
+#include <zlib.h>
+// with Z_PREFIX, zlib renames its compress() with a macro
+#undef compress
+
+#if QT_CONFIG(zstd)
+#  include <zstd.h>
+// ZSTD_compressStream2() and the dictionary loading functions became stable in 1.4.0
+#  if ZSTD_VERSION_NUMBER >= 10400
+#    define QT_COMPRESSION_ZSTD
+#  endif
+#endif
+
+#if QT_CONFIG(lz4)
+#  include <lz4.h>
+#  include <lz4frame.h>
+#  define QT_COMPRESSION_LZ4
+// LZ4F_compressBegin_usingDict() and LZ4F_decompress_usingDict() became stable in 1.10.0
+#  if LZ4_VERSION_NUMBER >= 11000
+#    define QT_COMPRESSION_LZ4_DICTIONARY
+#  endif
+#endif
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QCompression
+    \inmodule QtCore
+    \since 6.0
+    \brief The QCompression class compresses and decompresses data with a
+    selectable algorithm.
+
+    \ingroup io
+
+    QCompression offers the same service as qCompress() and qUncompress(),
+    but lets the caller choose between the algorithms Qt was built with and
+    supply a preset dictionary. Use isAvailable() to find out whether an
+    algorithm can be used at run time.
+
+    The output is the standard framing of each algorithm, so data can be
+    exchanged with other implementations: a zlib stream (RFC 1950) for
+    \l Zlib, a Zstandard frame for \l Zstd and an LZ4 frame for \l Lz4. Note
+    that this means the \l Zlib format is not the one produced by
+    qCompress(), which prefixes the stream with the uncompressed size.
+
+    A dictionary is a sample of data that is typical for the inputs. Priming
+    the compressor with it greatly improves the ratio for small messages, as
+    long as the decompressing side uses the very same dictionary.
+
+    To compress or decompress data as a stream instead of as a whole, use
+    QCompressingDevice and QDecompressingDevice.
+
+    \sa qCompress(), qUncompress()
+*/
+
+/*!
+    \enum QCompression::Algorithm
+
+    This enum describes the compression algorithms.
+
+    \value Zlib     The deflate algorithm in the zlib format. Always
+                    available. Levels range from 0 (store only) to 9.
+    \value Zstd     Zstandard. Available if Qt was built with Zstandard
+                    support. Levels range from 1 to 22; negative levels
+                    trade ratio for even more speed.
+    \value Lz4      LZ4. Available if Qt was built with LZ4 support. Level
+                    0 selects the fast compressor, 3 to 12 the high
+                    compression one.
+*/
+
+namespace {
+enum {
+    // zlib counts in uInt
+    ZlibMaxChunk = std::numeric_limits<int>::max(),
+    OutputChunkSize = 16 * 1024,
+    Lz4InputChunkSize = 64 * 1024
+};
+
+class QZlibCompressor final : public QCompressor
+{
+public:
+    ~QZlibCompressor()
+    {
+        if (initialized)
+            deflateEnd(&stream);
+    }
+
+    bool init(int level, const QByteArray &dictionary)
+    {
+        if (level < -1 || level > 9)
+            level = Z_DEFAULT_COMPRESSION;
+        if (deflateInit(&stream, level) != Z_OK)
+            return setError();
+        initialized = true;
+        if (!dictionary.isEmpty()
+            && deflateSetDictionary(&stream, reinterpret_cast<const Bytef *>(dictionary.constData()),
+                                    uInt(dictionary.size())) != Z_OK) {
+            return setError();
+        }
+        return true;
+    }
+
+    bool compress(const char *data, qsizetype size, QByteArray *out, Mode mode) override
+    {
+        const int flush = mode == Finish ? Z_FINISH : mode == Flush ? Z_SYNC_FLUSH : Z_NO_FLUSH;
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        do {
+            const qsizetype chunk = qMin<qsizetype>(size, ZlibMaxChunk);
+            size -= chunk;
+            stream.avail_in = uInt(chunk);
+            do {
+                const int oldSize = out->size();
+                out->resize(oldSize + OutputChunkSize);
+                stream.next_out = reinterpret_cast<Bytef *>(out->data() + oldSize);
+                stream.avail_out = OutputChunkSize;
+                const int ret = deflate(&stream, size ? Z_NO_FLUSH : flush);
+                out->resize(out->size() - int(stream.avail_out));
+                if (ret == Z_STREAM_ERROR)
+                    return setError();
+            } while (stream.avail_out == 0);
+        } while (size);
+        return true;
+    }
+
+private:
+    bool setError()
+    {
+        error = stream.msg ? QString::fromLatin1(stream.msg) : tr("Could not initialize the compressor");
+        return false;
+    }
+
+    z_stream stream = {};
+    bool initialized = false;
+};
+
+class QZlibDecompressor final : public QDecompressor
+{
+public:
+    ~QZlibDecompressor()
+    {
+        if (initialized)
+            inflateEnd(&stream);
+    }
+
+    bool init(const QByteArray &dict)
+    {
+        if (inflateInit(&stream) != Z_OK) {
+            error = tr("Could not initialize the decompressor");
+            return false;
+        }
+        initialized = true;
+        dictionary = dict;
+        return true;
+    }
+
+    qsizetype decompress(const char **data, qsizetype *size, char *out, qsizetype outSize) override
+    {
+        qsizetype produced = 0;
+        while (!finished && produced < outSize) {
+            const uInt availIn = uInt(qMin<qsizetype>(*size, ZlibMaxChunk));
+            const uInt availOut = uInt(qMin<qsizetype>(outSize - produced, ZlibMaxChunk));
+            stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(*data));
+            stream.avail_in = availIn;
+            stream.next_out = reinterpret_cast<Bytef *>(out + produced);
+            stream.avail_out = availOut;
+
+            int ret = inflate(&stream, Z_NO_FLUSH);
+            if (ret == Z_NEED_DICT) {
+                if (dictionary.isEmpty()) {
+                    error = tr("A dictionary is required to decompress the data");
+                    return -1;
+                }
+                ret = inflateSetDictionary(&stream,
+                                           reinterpret_cast<const Bytef *>(dictionary.constData()),
+                                           uInt(dictionary.size()));
+                if (ret != Z_OK) {
+                    error = tr("The data was compressed with a different dictionary");
+                    return -1;
+                }
+            }
+
+            const qsizetype consumed = availIn - stream.avail_in;
+            *data += consumed;
+            *size -= consumed;
+            produced += availOut - stream.avail_out;
+
+            if (ret == Z_STREAM_END) {
+                finished = true;
+            } else if (ret == Z_BUF_ERROR) {
+                break;      // needs more input
+            } else if (ret != Z_OK) {
+                error = stream.msg ? QString::fromLatin1(stream.msg) : tr("Input data is corrupted");
+                return -1;
+            }
+        }
+        return produced;
+    }
+
+private:
+    z_stream stream = {};
+    QByteArray dictionary;
+    bool initialized = false;
+};
+
+#ifdef QT_COMPRESSION_ZSTD
+class QZstdCompressor final : public QCompressor
+{
+public:
+    ~QZstdCompressor() { ZSTD_freeCCtx(context); }
+
+    bool init(int level, const QByteArray &dictionary)
+    {
+        if (!context) {
+            error = tr("Could not initialize the compressor");
+            return false;
+        }
+        level = level == -1 ? ZSTD_CLEVEL_DEFAULT
+                            : qBound(ZSTD_minCLevel(), level, ZSTD_maxCLevel());
+        return check(ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, level))
+                && (dictionary.isEmpty()
+                    || check(ZSTD_CCtx_loadDictionary(context, dictionary.constData(),
+                                                      size_t(dictionary.size()))));
+    }
+
+    bool compress(const char *data, qsizetype size, QByteArray *out, Mode mode) override
+    {
+        const ZSTD_EndDirective directive = mode == Finish ? ZSTD_e_end
+                                          : mode == Flush ? ZSTD_e_flush : ZSTD_e_continue;
+        ZSTD_inBuffer input = { data, size_t(size), 0 };
+        size_t remaining;
+        do {
+            const int oldSize = out->size();
+            out->resize(oldSize + OutputChunkSize);
+            ZSTD_outBuffer output = { out->data() + oldSize, OutputChunkSize, 0 };
+            remaining = ZSTD_compressStream2(context, &output, &input, directive);
+            out->resize(oldSize + int(output.pos));
+            if (!check(remaining))
+                return false;
+        } while (directive == ZSTD_e_continue ? input.pos < input.size : remaining != 0);
+        return true;
+    }
+
+private:
+    bool check(size_t code)
+    {
+        if (!ZSTD_isError(code))
+            return true;
+        error = QString::fromLatin1(ZSTD_getErrorName(code));
+        return false;
+    }
+
+    ZSTD_CCtx *context = ZSTD_createCCtx();
+};
+
+class QZstdDecompressor final : public QDecompressor
+{
+public:
+    ~QZstdDecompressor() { ZSTD_freeDCtx(context); }
+
+    bool init(const QByteArray &dictionary)
+    {
+        if (!context) {
+            error = tr("Could not initialize the decompressor");
+            return false;
+        }
+        return dictionary.isEmpty()
+                || check(ZSTD_DCtx_loadDictionary(context, dictionary.constData(),
+                                                  size_t(dictionary.size())));
+    }
+
+    qsizetype decompress(const char **data, qsizetype *size, char *out, qsizetype outSize) override
+    {
+        ZSTD_inBuffer input = { *data, size_t(*size), 0 };
+        ZSTD_outBuffer output = { out, size_t(outSize), 0 };
+        while (!finished && output.pos < output.size) {
+            const size_t inputBefore = input.pos;
+            const size_t outputBefore = output.pos;
+            const size_t ret = ZSTD_decompressStream(context, &output, &input);
+            if (!check(ret))
+                return -1;
+            if (ret == 0)
+                finished = true;
+            else if (input.pos == inputBefore && output.pos == outputBefore)
+                break;      // needs more input
+        }
+        *data += input.pos;
+        *size -= qsizetype(input.pos);
+        return qsizetype(output.pos);
+    }
+
+private:
+    bool check(size_t code)
+    {
+        if (!ZSTD_isError(code))
+            return true;
+        error = QString::fromLatin1(ZSTD_getErrorName(code));
+        return false;
+    }
+
+    ZSTD_DCtx *context = ZSTD_createDCtx();
+};
+#endif // QT_COMPRESSION_ZSTD
+
+#ifdef QT_COMPRESSION_LZ4
+class QLz4Compressor final : public QCompressor
+{
+public:
+    ~QLz4Compressor() { LZ4F_freeCompressionContext(context); }
+
+    bool init(int level, const QByteArray &dict)
+    {
+        if (!check(LZ4F_createCompressionContext(&context, LZ4F_VERSION)))
+            return false;
+#ifndef QT_COMPRESSION_LZ4_DICTIONARY
+        if (!dict.isEmpty()) {
+            error = tr("This version of LZ4 does not support dictionaries");
+            return false;
+        }
+#endif
+        preferences.compressionLevel = level < 0 ? 0 : qMin(level, 12); // LZ4HC_CLEVEL_MAX
+        preferences.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+        dictionary = dict;
+        return true;
+    }
+
+    bool compress(const char *data, qsizetype size, QByteArray *out, Mode mode) override
+    {
+        if (!started) {
+            const int oldSize = out->size();
+            out->resize(oldSize + LZ4F_HEADER_SIZE_MAX);
+#ifdef QT_COMPRESSION_LZ4_DICTIONARY
+            const size_t written = dictionary.isEmpty()
+                    ? LZ4F_compressBegin(context, out->data() + oldSize, LZ4F_HEADER_SIZE_MAX,
+                                         &preferences)
+                    : LZ4F_compressBegin_usingDict(context, out->data() + oldSize,
+                                                   LZ4F_HEADER_SIZE_MAX, dictionary.constData(),
+                                                   size_t(dictionary.size()), &preferences);
+#else
+            const size_t written = LZ4F_compressBegin(context, out->data() + oldSize,
+                                                      LZ4F_HEADER_SIZE_MAX, &preferences);
+#endif
+            if (!check(written))
+                return false;
+            out->resize(oldSize + int(written));
+            started = true;
+        }
+
+        // LZ4F wants room for the worst case up front, so feed it in bounded chunks
+        while (size > 0) {
+            const qsizetype chunk = qMin<qsizetype>(size, Lz4InputChunkSize);
+            const int oldSize = out->size();
+            const size_t bound = LZ4F_compressBound(size_t(chunk), &preferences);
+            out->resize(oldSize + int(bound));
+            const size_t written = LZ4F_compressUpdate(context, out->data() + oldSize, bound,
+                                                       data, size_t(chunk), nullptr);
+            if (!check(written))
+                return false;
+            out->resize(oldSize + int(written));
+            data += chunk;
+            size -= chunk;
+        }
+
+        if (mode != Continue) {
+            const int oldSize = out->size();
+            const size_t bound = LZ4F_compressBound(0, &preferences);
+            out->resize(oldSize + int(bound));
+            const size_t written = mode == Finish
+                    ? LZ4F_compressEnd(context, out->data() + oldSize, bound, nullptr)
+                    : LZ4F_flush(context, out->data() + oldSize, bound, nullptr);
+            if (!check(written))
+                return false;
+            out->resize(oldSize + int(written));
+        }
+        return true;
+    }
+
+private:
+    bool check(size_t code)
+    {
+        if (!LZ4F_isError(code))
+            return true;
+        error = QString::fromLatin1(LZ4F_getErrorName(code));
+        return false;
+    }
+
+    LZ4F_cctx *context = nullptr;
+    LZ4F_preferences_t preferences = {};
+    QByteArray dictionary;
+    bool started = false;
+};
+
+class QLz4Decompressor final : public QDecompressor
+{
+public:
+    ~QLz4Decompressor() { LZ4F_freeDecompressionContext(context); }
+
+    bool init(const QByteArray &dict)
+    {
+        if (!check(LZ4F_createDecompressionContext(&context, LZ4F_VERSION)))
+            return false;
+#ifndef QT_COMPRESSION_LZ4_DICTIONARY
+        if (!dict.isEmpty()) {
+            error = tr("This version of LZ4 does not support dictionaries");
+            return false;
+        }
+#endif
+        dictionary = dict;
+        return true;
+    }
+
+    qsizetype decompress(const char **data, qsizetype *size, char *out, qsizetype outSize) override
+    {
+        qsizetype produced = 0;
+        while (!finished && produced < outSize) {
+            size_t consumed = size_t(*size);
+            size_t written = size_t(outSize - produced);
+#ifdef QT_COMPRESSION_LZ4_DICTIONARY
+            const size_t ret = dictionary.isEmpty()
+                    ? LZ4F_decompress(context, out + produced, &written, *data, &consumed, nullptr)
+                    : LZ4F_decompress_usingDict(context, out + produced, &written, *data, &consumed,
+                                                dictionary.constData(), size_t(dictionary.size()),
+                                                nullptr);
+#else
+            const size_t ret = LZ4F_decompress(context, out + produced, &written, *data, &consumed,
+                                               nullptr);
+#endif
+            if (!check(ret))
+                return -1;
+            *data += consumed;
+            *size -= qsizetype(consumed);
+            produced += qsizetype(written);
+            if (ret == 0)
+                finished = true;
+            else if (consumed == 0 && written == 0)
+                break;      // needs more input
+        }
+        return produced;
+    }
+
+private:
+    bool check(size_t code)
+    {
+        if (!LZ4F_isError(code))
+            return true;
+        error = QString::fromLatin1(LZ4F_getErrorName(code));
+        return false;
+    }
+
+    LZ4F_dctx *context = nullptr;
+    QByteArray dictionary;
+};
+#endif // QT_COMPRESSION_LZ4
+
+template <typename T, typename... Args>
+std::unique_ptr<T> createCodec(QString *errorString, Args &&... args)
+{
+    std::unique_ptr<T> codec(new T);
+    if (!codec->init(std::forward<Args>(args)...)) {
+        *errorString = codec->errorString();
+        codec.reset();
+    }
+    return codec;
+}
+
+QString unavailableAlgorithmError()
+{
+    return QCompressor::tr("The compression algorithm is not available");
+}
+} // unnamed namespace
+
+std::unique_ptr<QCompressor> QCompressor::create(QCompression::Algorithm algorithm, int level,
+                                                 const QByteArray &dictionary,
+                                                 QString *errorString)
+{
+    switch (algorithm) {
+    case QCompression::Zlib:
+        return createCodec<QZlibCompressor>(errorString, level, dictionary);
+    case QCompression::Zstd:
+#ifdef QT_COMPRESSION_ZSTD
+        return createCodec<QZstdCompressor>(errorString, level, dictionary);
+#else
+        break;
+#endif
+    case QCompression::Lz4:
+#ifdef QT_COMPRESSION_LZ4
+        return createCodec<QLz4Compressor>(errorString, level, dictionary);
+#else
+        break;
+#endif
+    }
+    *errorString = unavailableAlgorithmError();
+    return nullptr;
+}
+
+std::unique_ptr<QDecompressor> QDecompressor::create(QCompression::Algorithm algorithm,
+                                                     const QByteArray &dictionary,
+                                                     QString *errorString)
+{
+    switch (algorithm) {
+    case QCompression::Zlib:
+        return createCodec<QZlibDecompressor>(errorString, dictionary);
+    case QCompression::Zstd:
+#ifdef QT_COMPRESSION_ZSTD
+        return createCodec<QZstdDecompressor>(errorString, dictionary);
+#else
+        break;
+#endif
+    case QCompression::Lz4:
+#ifdef QT_COMPRESSION_LZ4
+        return createCodec<QLz4Decompressor>(errorString, dictionary);
+#else
+        break;
+#endif
+    }
+    *errorString = unavailableAlgorithmError();
+    return nullptr;
+}
+
+/*!
+    Returns \c true if \a algorithm can be used in this build of Qt.
+*/
+bool QCompression::isAvailable(Algorithm algorithm) noexcept
+{
+    switch (algorithm) {
+    case Zlib:
+        return true;
+    case Zstd:
+#ifdef QT_COMPRESSION_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    case Lz4:
+#ifdef QT_COMPRESSION_LZ4
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+/*!
+    Compresses \a data with \a algorithm and returns the compressed data.
+
+    The \a level selects the trade-off between speed and ratio; its range
+    depends on the algorithm. The default value of -1 selects the default
+    level of the algorithm.
+
+    If \a dictionary is not empty, the compressor is primed with it and the
+    same dictionary must be passed to decompress().
+
+    Returns an empty QByteArray and prints a warning if \a algorithm is not
+    available or an error occurs. If \a ok is not \nullptr, it is set to
+    \c false in that case and to \c true otherwise.
+
+    \sa decompress(), isAvailable(), QCompressingDevice
+*/
+QByteArray QCompression::compress(const QByteArray &data, Algorithm algorithm, int level,
+                                  const QByteArray &dictionary, bool *ok)
+{
+    QString errorString;
+    const auto compressor = QCompressor::create(algorithm, level, dictionary, &errorString);
+    QByteArray result;
+    if (compressor) {
+        result.reserve(data.size() / 2 + 64);
+        if (compressor->compress(data.constData(), data.size(), &result, QCompressor::Finish)) {
+            if (ok)
+                *ok = true;
+            return result;
+        }
+        errorString = compressor->errorString();
+    }
+    qWarning("QCompression::compress: %ls", qUtf16Printable(errorString));
+    if (ok)
+        *ok = false;
+    return QByteArray();
+}
+
+/*!
+    Decompresses \a data, which must have been compressed with \a algorithm,
+    and returns the decompressed data. If the data was compressed with a
+    dictionary, the same \a dictionary must be passed.
+
+    Decompression stops at the end of the first compressed stream; anything
+    following it in \a data is ignored.
+
+    Returns an empty QByteArray and prints a warning if \a algorithm is not
+    available or the input data is corrupt or truncated. If \a ok is not
+    \nullptr, it is set to \c false in that case and to \c true otherwise,
+    which tells a failure apart from data that decompresses to nothing.
+
+    \sa compress(), isAvailable(), QDecompressingDevice
+*/
+QByteArray QCompression::decompress(const QByteArray &data, Algorithm algorithm,
+                                    const QByteArray &dictionary, bool *ok)
+{
+    QString errorString;
+    const auto decompressor = QDecompressor::create(algorithm, dictionary, &errorString);
+    if (decompressor) {
+        const int maxSize = int(MaxByteArraySize) - 1;
+        const char *input = data.constData();
+        qsizetype inputSize = data.size();
+        QByteArray result;
+        result.resize(int(qBound<qsizetype>(OutputChunkSize, inputSize * 4, maxSize)));
+        int produced = 0;
+        forever {
+            const qsizetype n = decompressor->decompress(&input, &inputSize,
+                                                         result.data() + produced,
+                                                         result.size() - produced);
+            if (n < 0) {
+                errorString = decompressor->errorString();
+                break;
+            }
+            produced += int(n);
+            if (decompressor->isFinished()) {
+                result.resize(produced);
+                if (ok)
+                    *ok = true;
+                return result;
+            }
+            if (produced < result.size()) {
+                // the decompressor ran out of input before the end of the stream
+                errorString = QCompressor::tr("Input data is truncated");
+                break;
+            }
+            if (result.size() == maxSize) {
+                // QByteArray does not support that huge size anyway.
+                errorString = QCompressor::tr("Decompressed data is too large");
+                break;
+            }
+            result.resize(result.size() > maxSize / 2 ? maxSize : result.size() * 2);
+        }
+    }
+    qWarning("QCompression::decompress: %ls", qUtf16Printable(errorString));
+    if (ok)
+        *ok = false;
+    return QByteArray();
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_COMPRESS
@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QCOMPRESSION_P_H
+#define QCOMPRESSION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qcompression.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qstring.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+#ifndef QT_NO_COMPRESS
+class QCompressor
+{
+    Q_DECLARE_TR_FUNCTIONS(QCompression)
+public:
+    enum Mode {
+        Continue,   // buffer as much as the algorithm likes
+        Flush,      // make everything so far decodable by the peer
+        Finish      // terminate the stream
+    };
+
+    static std::unique_ptr<QCompressor> create(QCompression::Algorithm algorithm, int level,
+                                               const QByteArray &dictionary, QString *errorString);
+    virtual ~QCompressor() = default;
+
+    // Appends the compressed form of \a data to \a out. Returns false on
+    // error, in which case errorString() says why.
+    virtual bool compress(const char *data, qsizetype size, QByteArray *out, Mode mode) = 0;
+
+    QString errorString() const { return error; }
+
+protected:
+    QString error;
+};
+
+class QDecompressor
+{
+    Q_DECLARE_TR_FUNCTIONS(QCompression)
+public:
+    static std::unique_ptr<QDecompressor> create(QCompression::Algorithm algorithm,
+                                                 const QByteArray &dictionary, QString *errorString);
+    virtual ~QDecompressor() = default;
+
+    // Decodes input from *data (advancing it and decrementing *size by the
+    // amount consumed) into at most outSize bytes at out. Returns the number
+    // of bytes produced, or -1 on error. A return value smaller than outSize
+    // with isFinished() still false means more input is needed.
+    virtual qsizetype decompress(const char **data, qsizetype *size, char *out, qsizetype outSize) = 0;
+
+    bool isFinished() const { return finished; }
+    QString errorString() const { return error; }
+
+protected:
+    QString error;
+    bool finished = false;
+};
+#endif // QT_NO_COMPRESS
+
+QT_END_NAMESPACE
+
+#endif // QCOMPRESSION_P_H
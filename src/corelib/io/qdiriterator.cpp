@@ -107,6 +107,13 @@
 #include <QtCore/private/qfilesystemengine_p.h>
 #include <QtCore/private/qfileinfo_p.h>
 
+#if QT_CONFIG(thread)
+#include <QtCore/qmutex.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#endif
+
 #include <memory>
 
 QT_BEGIN_NAMESPACE
@@ -121,13 +128,17 @@ public:
     }
 };
 
+class QDirWalk;
+
 class QDirIteratorPrivate
 {
 public:
     QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
-                        QDir::Filters filters, QDirIterator::IteratorFlags flags, bool resolveEngine = true);
+                        QDir::Filters filters, QDirIterator::IteratorFlags flags, bool resolveEngine = true,
+                        QDirWalk *walk = nullptr);
 
     void advance();
+    bool hasIterators() const;
 
     bool entryMatches(const QString & fileName, const QFileInfo &fileInfo);
     void pushDirectory(const QFileInfo &fileInfo);
@@ -158,17 +169,99 @@ public:
 
     // Loop protection
     QSet<QString> visitedLinks;
+
+    // Set when this iterator is one task of a parallel walk (see QDirIterator::forEachEntry)
+    QDirWalk *walk;
 };
 
+#if QT_CONFIG(thread)
+/*!
+    \internal
+
+    Shared state of a parallel directory walk. Every directory of the tree is
+    listed by its own QDirWalkTask; subdirectories found while listing are
+    handed back to the thread pool instead of being descended into.
+*/
+class QDirWalk
+{
+public:
+    QDirWalk(const QStringList &nameFilters, QDir::Filters filters,
+             QDirIterator::IteratorFlags flags,
+             const std::function<void(const QFileInfo &)> &function)
+        : nameFilters(nameFilters), filters(filters), flags(flags), function(function)
+    {
+        // The work is I/O bound, so allow for more threads than there are cores
+        pool.setMaxThreadCount(qMax(4, 2 * QThread::idealThreadCount()));
+    }
+
+    void schedule(const QFileInfo &dir);
+
+    const QStringList nameFilters;
+    const QDir::Filters filters;
+    const QDirIterator::IteratorFlags flags;
+    const std::function<void(const QFileInfo &)> &function;
+
+    QThreadPool pool;
+
+    // Loop protection across all tasks when following symlinks
+    QMutex mutex;
+    QSet<QString> visitedLinks;
+};
+
+class QDirWalkTask : public QRunnable
+{
+public:
+    QDirWalkTask(QDirWalk *walk, const QString &path)
+        : walk(walk), path(path)
+    { }
+
+    void run() override
+    {
+        QDirIteratorPrivate d(QFileSystemEntry(path), walk->nameFilters, walk->filters,
+                              walk->flags, true, walk);
+        while (d.hasIterators()) {
+            d.advance();
+            walk->function(d.currentFileInfo);
+        }
+    }
+
+private:
+    QDirWalk *walk;
+    QString path;
+};
+
+void QDirWalk::schedule(const QFileInfo &dir)
+{
+    QString path = dir.filePath();
+
+#ifdef Q_OS_WIN
+    if (dir.isSymLink())
+        path = dir.canonicalFilePath();
+#endif
+
+    if (flags & QDirIterator::FollowSymlinks) {
+        const QString canonicalPath = dir.canonicalFilePath();
+        QMutexLocker locker(&mutex);
+        if (visitedLinks.contains(canonicalPath))
+            return;
+        visitedLinks.insert(canonicalPath);
+    }
+
+    pool.start(new QDirWalkTask(this, path));
+}
+#endif // QT_CONFIG(thread)
+
 /*!
     \internal
 */
 QDirIteratorPrivate::QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
-                                         QDir::Filters filters, QDirIterator::IteratorFlags flags, bool resolveEngine)
+                                         QDir::Filters filters, QDirIterator::IteratorFlags flags, bool resolveEngine,
+                                         QDirWalk *walk)
     : dirEntry(entry)
       , nameFilters(nameFilters.contains(QLatin1String("*")) ? QStringList() : nameFilters)
       , filters(QDir::NoFilter == filters ? QDir::AllEntries : filters)
       , iteratorFlags(flags)
+      , walk(walk)
 {
 #if defined(QT_BOOTSTRAPPED)
     nameRegExps.reserve(nameFilters.size());
@@ -201,6 +294,14 @@ QDirIteratorPrivate::QDirIteratorPrivate(const QFileSystemEntry &entry, const QS
 */
 void QDirIteratorPrivate::pushDirectory(const QFileInfo &fileInfo)
 {
+#if QT_CONFIG(thread)
+    // In a parallel walk, only the task's own directory is listed here
+    if (walk && hasIterators()) {
+        walk->schedule(fileInfo);
+        return;
+    }
+#endif
+
     QString path = fileInfo.filePath();
 
 #ifdef Q_OS_WIN
@@ -290,6 +391,21 @@ void QDirIteratorPrivate::advance()
     nextFileInfo = QFileInfo();
 }
 
+/*!
+    \internal
+*/
+bool QDirIteratorPrivate::hasIterators() const
+{
+    if (engine)
+        return !fileEngineIterators.isEmpty();
+    else
+#ifndef QT_NO_FILESYSTEMITERATOR
+        return !nativeIterators.isEmpty();
+#else
+        return false;
+#endif
+}
+
 /*!
     \internal
  */
@@ -525,14 +641,7 @@ QString QDirIterator::next()
 */
 bool QDirIterator::hasNext() const
 {
-    if (d->engine)
-        return !d->fileEngineIterators.isEmpty();
-    else
-#ifndef QT_NO_FILESYSTEMITERATOR
-        return !d->nativeIterators.isEmpty();
-#else
-        return false;
-#endif
+    return d->hasIterators();
 }
 
 /*!
@@ -578,4 +687,46 @@ QString QDirIterator::path() const
     return d->dirEntry.filePath();
 }
 
+#if QT_CONFIG(thread)
+/*!
+    \since 6.0
+
+    Walks the tree below \a path using \a nameFilters, \a filters and \a flags
+    like a QDirIterator constructed with the same arguments would, and calls
+    \a function with a QFileInfo for every matching entry.
+
+    Unlike QDirIterator, the directories of the tree are listed in parallel
+    by a pool of threads, which can speed up the traversal of large trees
+    considerably. \a function is therefore called concurrently from several
+    threads, and must be thread-safe. No guarantee is made about the order
+    of the entries, not even within one directory.
+
+    The QFileInfo objects passed to \a function carry the file type reported
+    by the directory listing where the platform provides it, so calling
+    QFileInfo::isDir() or QFileInfo::isFile() on them does not need to query
+    the file system again.
+
+    This function returns once the whole tree has been walked.
+
+    \sa QThreadPool
+*/
+void QDirIterator::forEachEntry(const QString &path, const QStringList &nameFilters,
+                                QDir::Filters filters, IteratorFlags flags,
+                                const std::function<void(const QFileInfo &)> &function)
+{
+    if (!(flags & Subdirectories)) {
+        QDirIterator it(path, nameFilters, filters, flags);
+        while (it.hasNext()) {
+            it.next();
+            function(it.fileInfo());
+        }
+        return;
+    }
+
+    QDirWalk walk(nameFilters, filters, flags, function);
+    walk.schedule(QFileInfo(path));
+    walk.pool.waitForDone();
+}
+#endif // QT_CONFIG(thread)
+
 QT_END_NAMESPACE
@@ -42,6 +42,8 @@
 
 #include <QtCore/qdir.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -76,6 +78,12 @@ public:
     QFileInfo fileInfo() const;
     QString path() const;
 
+#if QT_CONFIG(thread)
+    static void forEachEntry(const QString &path, const QStringList &nameFilters,
+                             QDir::Filters filters, IteratorFlags flags,
+                             const std::function<void(const QFileInfo &)> &function);
+#endif
+
 private:
     Q_DISABLE_COPY(QDirIterator)
 
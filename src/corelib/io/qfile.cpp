@@ -47,6 +47,7 @@
 #include "qlist.h"
 #include "qfileinfo.h"
 #include "private/qiodevice_p.h"
+#include "private/qbytearray_p.h"
 #include "private/qfile_p.h"
 #include "private/qfilesystemengine_p.h"
 #include "private/qsystemerror_p.h"
@@ -54,6 +55,11 @@
 #if defined(QT_BUILD_CORE_LIB)
 # include "qcoreapplication.h"
 #endif
+#if QT_CONFIG(future)
+# include "qfuture.h"
+# include "qrunnable.h"
+# include "qthreadpool.h"
+#endif
 
 #include <private/qmemory_p.h>
 
@@ -826,26 +832,30 @@ QFile::copy(const QString &newName)
                     d->setError(QFile::CopyError, tr("Cannot open for output: %1").arg(out.errorString()));
                 } else {
                     if (!d->engine()->cloneTo(out.d_func()->engine())) {
-                        char block[4096];
-                        qint64 totalRead = 0;
-                        while (!atEnd()) {
-                            qint64 in = read(block, sizeof(block));
-                            if (in <= 0)
+                        // large enough that reads bypass our own buffer and
+                        // the number of system calls stays low
+                        const qint64 BlockSize = 64 * 1024;
+                        const QScopedArrayPointer<char> block(new char[BlockSize]);
+                        // Read until read() reports the end rather than
+                        // stopping at size(): files synthesized by the
+                        // kernel, like those in /proc, report a size of zero.
+                        forever {
+                            qint64 in = read(block.data(), BlockSize);
+                            if (in < 0) {
+                                // Unable to read from the source. The error
+                                // string is already set from read().
+                                error = true;
+                                break;
+                            }
+                            if (in == 0)
                                 break;
-                            totalRead += in;
-                            if (in != out.write(block, in)) {
+                            if (in != out.write(block.data(), in)) {
                                 close();
                                 d->setError(QFile::CopyError, tr("Failure to write block"));
                                 error = true;
                                 break;
                             }
                         }
-
-                        if (totalRead != size()) {
-                            // Unable to read from the source. The error string is
-                            // already set from read().
-                            error = true;
-                        }
                     }
 
                     if (!error) {
@@ -1093,6 +1103,177 @@ QFile::resize(const QString &fileName, qint64 sz)
     return QFile(fileName).resize(sz);
 }
 
+#if QT_CONFIG(future)
+namespace {
+// Blocking file I/O must not tie up QThreadPool::globalInstance(), which
+// is meant for CPU-bound work.
+Q_GLOBAL_STATIC(QThreadPool, fileIOThreadPool)
+
+class QFileAsyncRead : public QRunnable
+{
+public:
+    QFileAsyncRead(const QString &fileName, qint64 offset, qint64 maxSize)
+        : fileName(fileName), offset(offset), maxSize(maxSize)
+    {}
+
+    void run() override
+    {
+        if (!promise.isCanceled())
+            promise.reportResult(read());
+        promise.reportFinished();
+    }
+
+    QFutureInterface<QByteArray> promise;
+
+private:
+    // Returns a null QByteArray if the file cannot be read
+    QByteArray read() const
+    {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered) || !file.seek(offset))
+            return QByteArray();
+
+        // Don't ask for more than the file can provide, or than a QByteArray
+        // can hold. Files that report no size, like those in /proc, are read
+        // until their end.
+        const qint64 BlockSize = 64 * 1024;
+        const qint64 size = file.size();
+        qint64 remaining = qBound<qint64>(0, maxSize, MaxByteArraySize - 1);
+        if (size > 0)
+            remaining = qBound<qint64>(0, size - offset, remaining);
+
+        QByteArray data("", 0);     // empty, but not null
+        if (size > 0)
+            data.reserve(int(remaining));
+        while (remaining > 0) {
+            const qint64 chunk = qMin(remaining, BlockSize);
+            const int oldSize = data.size();
+            data.resize(oldSize + int(chunk));
+            const qint64 n = file.read(data.data() + oldSize, chunk);
+            if (n < 0)
+                return QByteArray();
+            data.resize(oldSize + int(n));
+            if (n == 0)
+                break;
+            remaining -= n;
+        }
+        return data;
+    }
+
+    const QString fileName;
+    const qint64 offset;
+    const qint64 maxSize;
+};
+
+class QFileAsyncWrite : public QRunnable
+{
+public:
+    QFileAsyncWrite(const QString &fileName, qint64 offset, const QByteArray &data)
+        : fileName(fileName), data(data), offset(offset)
+    {}
+
+    void run() override
+    {
+        if (!promise.isCanceled()) {
+            qint64 written = -1;
+            QFile file(fileName);
+            if (file.open(QIODevice::ReadWrite | QIODevice::Unbuffered) && file.seek(offset))
+                written = file.write(data);
+            promise.reportResult(written);
+        }
+        promise.reportFinished();
+    }
+
+    QFutureInterface<qint64> promise;
+
+private:
+    const QString fileName;
+    const QByteArray data;
+    const qint64 offset;
+};
+
+template <typename Task>
+auto startFileIO(Task *task) -> decltype(task->promise.future())
+{
+    task->promise.reportStarted();
+    auto future = task->promise.future();
+    fileIOThreadPool()->start(task);
+    return future;
+}
+} // unnamed namespace
+
+/*!
+    \since 6.0
+
+    Reads at most \a maxSize bytes starting at \a offset from the file
+    whose name was passed in the constructor or set with setFileName(),
+    without blocking the calling thread.
+
+    The read is carried out in a background thread on a separate handle
+    to the file, so it does not depend on whether this QFile is open and
+    does not change its position. Use QFutureWatcher to be notified in the
+    event loop when the data is available.
+
+    The result is the data read, which is empty if \a offset is at or past
+    the end of the file. It is a null QByteArray if the file could not be
+    opened, positioned or read; use QByteArray::isNull() to tell this apart
+    from an empty read.
+
+    A QByteArray cannot hold more than about 2 GB. If more than that is
+    requested and available, the result holds as much of it as fits.
+
+    \sa writeAsync(), read()
+*/
+QFuture<QByteArray> QFile::readAsync(qint64 offset, qint64 maxSize) const
+{
+    return readAsync(fileName(), offset, maxSize);
+}
+
+/*!
+    \since 6.0
+    \overload
+
+    Reads at most \a maxSize bytes starting at \a offset from the file
+    \a fileName, without blocking the calling thread.
+*/
+QFuture<QByteArray> QFile::readAsync(const QString &fileName, qint64 offset, qint64 maxSize)
+{
+    return startFileIO(new QFileAsyncRead(fileName, offset, maxSize));
+}
+
+/*!
+    \since 6.0
+
+    Writes \a data at \a offset to the file whose name was passed in the
+    constructor or set with setFileName(), without blocking the calling
+    thread. The file is created if it does not exist; it is never
+    truncated.
+
+    The write is carried out in a background thread on a separate handle
+    to the file, so it does not depend on whether this QFile is open and
+    does not change its position. The result is the number of bytes
+    written, or -1 if an error occurred.
+
+    \sa readAsync(), write()
+*/
+QFuture<qint64> QFile::writeAsync(qint64 offset, const QByteArray &data)
+{
+    return writeAsync(fileName(), offset, data);
+}
+
+/*!
+    \since 6.0
+    \overload
+
+    Writes \a data at \a offset to the file \a fileName, without blocking
+    the calling thread.
+*/
+QFuture<qint64> QFile::writeAsync(const QString &fileName, qint64 offset, const QByteArray &data)
+{
+    return startFileIO(new QFileAsyncWrite(fileName, offset, data));
+}
+#endif // QT_CONFIG(future)
+
 /*!
     \reimp
 */
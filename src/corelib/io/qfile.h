@@ -53,6 +53,9 @@ QT_BEGIN_NAMESPACE
 
 class QTemporaryFile;
 class QFilePrivate;
+#if QT_CONFIG(future)
+template <typename T> class QFuture;
+#endif
 
 class Q_CORE_EXPORT QFile : public QFileDevice
 {
@@ -142,6 +145,13 @@ public:
     bool setPermissions(Permissions permissionSpec) override;
     static bool setPermissions(const QString &filename, Permissions permissionSpec);
 
+#if QT_CONFIG(future)
+    QFuture<QByteArray> readAsync(qint64 offset, qint64 maxSize) const;
+    static QFuture<QByteArray> readAsync(const QString &fileName, qint64 offset, qint64 maxSize);
+    QFuture<qint64> writeAsync(qint64 offset, const QByteArray &data);
+    static QFuture<qint64> writeAsync(const QString &fileName, qint64 offset, const QByteArray &data);
+#endif
+
 protected:
 #ifdef QT_NO_QOBJECT
     QFile(QFilePrivate &dd);
@@ -87,6 +87,7 @@ extern "C" NSString *NSTemporaryDirectory();
 #if defined(Q_OS_LINUX)
 #  include <sys/ioctl.h>
 #  include <sys/sendfile.h>
+#  include <sys/syscall.h>
 #  include <linux/fs.h>
 
 // in case linux/fs.h is too old and doesn't define it:
@@ -1072,13 +1073,43 @@ bool QFileSystemEngine::cloneFile(int srcfd, int dstfd, const QFileSystemMetaDat
     if (::ioctl(dstfd, FICLONE, srcfd) == 0)
         return true;
 
-    // Second, try sendfile (it can send to some special types too).
-    // sendfile(2) is limited in the kernel to 2G - 4k
+    // copy_file_range(2) and sendfile(2) are limited in the kernel to 2G - 4k
     const size_t SendfileSize = 0x7ffff000;
+    ssize_t n;
+
+#  ifdef SYS_copy_file_range
+    // Second, try copy_file_range. It copies inside the kernel like sendfile,
+    // but lets the filesystem do server-side copies or share extents.
+    // Call it through syscall() so we don't depend on the glibc wrapper.
+    const auto copyFileRange = [=]() {
+        return ssize_t(::syscall(SYS_copy_file_range, srcfd, nullptr, dstfd, nullptr,
+                                 SendfileSize, 0U));
+    };
+    n = copyFileRange();
+    if (n > 0) {
+        while (n > 0)
+            n = copyFileRange();
+        if (n == 0)
+            return true;
+
+        // a real error after partial success, see below
+        n = ftruncate(dstfd, 0);
+        n = lseek(srcfd, 0, SEEK_SET);
+        n = lseek(dstfd, 0, SEEK_SET);
+        return false;
+    }
+    // Otherwise, either the kernel or the filesystems don't support it (for
+    // instance across filesystems before Linux 5.3), or the source reported
+    // no data, which happens for files synthesized by the kernel like those
+    // in /proc. Fall back to sendfile.
+#  endif
 
-    ssize_t n = ::sendfile(dstfd, srcfd, NULL, SendfileSize);
-    if (n == -1) {
-        // if we got an error here, give up and try at an upper layer
+    // Third, try sendfile (it can send to some special types too).
+    n = ::sendfile(dstfd, srcfd, NULL, SendfileSize);
+    if (n <= 0) {
+        // if we got an error here, give up and try at an upper layer; do the
+        // same if nothing was copied: the file is either empty or one that
+        // in-kernel copies can't read, like those in /proc
         return false;
     }
 
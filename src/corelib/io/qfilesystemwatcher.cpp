@@ -42,6 +42,7 @@
 
 #include <qdatetime.h>
 #include <qdir.h>
+#include <qdiriterator.h>
 #include <qfileinfo.h>
 #include <qloggingcategory.h>
 #include <qset.h>
@@ -88,7 +89,7 @@ QFileSystemWatcherEngine *QFileSystemWatcherPrivate::createNativeEngine(QObject
 }
 
 QFileSystemWatcherPrivate::QFileSystemWatcherPrivate()
-    : native(0), poller(0)
+    : native(0), poller(0), coalescingInterval(0), coalescingTimer(nullptr)
 {
 }
 
@@ -105,6 +106,12 @@ void QFileSystemWatcherPrivate::init()
                          SIGNAL(directoryChanged(QString,bool)),
                          q,
                          SLOT(_q_directoryChanged(QString,bool)));
+        QObject::connect(native, &QFileSystemWatcherEngine::treeFileChanged,
+                         q, [this] (const QString &p) { _q_treeFileChanged(p); });
+        QObject::connect(native, &QFileSystemWatcherEngine::subdirectoriesChanged,
+                         q, [this] (const QString &p) { _q_subdirectoriesChanged(p); });
+        QObject::connect(native, &QFileSystemWatcherEngine::eventsLost,
+                         q, [this] () { _q_eventsLost(); });
 #if defined(Q_OS_WIN) && !defined(Q_OS_WINRT)
         QObject::connect(static_cast<QWindowsFileSystemWatcherEngine *>(native),
                          &QWindowsFileSystemWatcherEngine::driveLockForRemoval,
@@ -136,9 +143,37 @@ void QFileSystemWatcherPrivate::initPollerEngine()
                      SLOT(_q_directoryChanged(QString,bool)));
 }
 
-void QFileSystemWatcherPrivate::_q_fileChanged(const QString &path, bool removed)
+QFileSystemWatcherEngine *QFileSystemWatcherPrivate::selectEngine()
 {
+#ifdef QT_BUILD_INTERNAL
     Q_Q(QFileSystemWatcher);
+    const QString on = q->objectName();
+
+    if (Q_UNLIKELY(on.startsWith(QLatin1String("_qt_autotest_force_engine_")))) {
+        // Autotest override case - use the explicitly selected engine only
+        const QStringRef forceName = on.midRef(26);
+        if (forceName == QLatin1String("poller")) {
+            qCDebug(lcWatcher, "QFileSystemWatcher: skipping native engine, using only polling engine");
+            initPollerEngine();
+            return poller;
+        } else if (forceName == QLatin1String("native")) {
+            qCDebug(lcWatcher, "QFileSystemWatcher: skipping polling engine, using only native engine");
+            return native;
+        }
+        return nullptr;
+    }
+#endif
+    // Normal runtime case - search intelligently for best engine
+    if (native) {
+        return native;
+    } else {
+        initPollerEngine();
+        return poller;
+    }
+}
+
+void QFileSystemWatcherPrivate::_q_fileChanged(const QString &path, bool removed)
+{
     qCDebug(lcWatcher) << "file changed" << path << "removed?" << removed << "watching?" << files.contains(path);
     if (!files.contains(path)) {
         // the path was removed after a change was detected, but before we delivered the signal
@@ -146,20 +181,264 @@ void QFileSystemWatcherPrivate::_q_fileChanged(const QString &path, bool removed
     }
     if (removed)
         files.removeAll(path);
-    emit q->fileChanged(path, QFileSystemWatcher::QPrivateSignal());
+    notifyFileChanged(path);
 }
 
 void QFileSystemWatcherPrivate::_q_directoryChanged(const QString &path, bool removed)
 {
-    Q_Q(QFileSystemWatcher);
-    qCDebug(lcWatcher) << "directory changed" << path << "removed?" << removed << "watching?" << directories.contains(path);
-    if (!directories.contains(path)) {
+    // engines that report subdirectory changes separately say when to relist
+    const auto tree = treeDirectories.constFind(path);
+    const bool relist = tree != treeDirectories.cend() && !tree.value()->reportsSubdirectoryChanges();
+    handleDirectoryChange(path, removed, relist);
+}
+
+void QFileSystemWatcherPrivate::handleDirectoryChange(const QString &path, bool removed,
+                                                      bool subdirectoriesChanged)
+{
+    const bool inTree = treeDirectories.contains(path);
+    qCDebug(lcWatcher) << "directory changed" << path << "removed?" << removed << "watching?" << (inTree || directories.contains(path));
+    if (!inTree && !directories.contains(path)) {
         // perhaps the path was removed after a change was detected, but before we delivered the signal
         return;
     }
     if (removed)
         directories.removeAll(path);
-    emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
+    if (inTree) {
+        if (removed) {
+            unwatchTreeDirectories(path);
+            directoryTrees.removeAll(path);
+        } else if (subdirectoriesChanged) {
+            syncTreeDirectory(path);
+        }
+    }
+    notifyDirectoryChanged(path);
+}
+
+void QFileSystemWatcherPrivate::_q_treeFileChanged(const QString &path)
+{
+    const int slash = path.lastIndexOf(QLatin1Char('/'));
+    const QString directory = slash > 0 ? path.left(slash) : QStringLiteral("/");
+    qCDebug(lcWatcher) << "file in tree changed" << path << "watching?" << treeDirectories.contains(directory);
+    if (treeDirectories.contains(directory))
+        notifyFileChanged(path);
+}
+
+void QFileSystemWatcherPrivate::_q_subdirectoriesChanged(const QString &path)
+{
+    qCDebug(lcWatcher) << "subdirectories changed" << path << "watching?" << treeDirectories.contains(path);
+    if (treeDirectories.contains(path))
+        syncTreeDirectory(path);
+}
+
+void QFileSystemWatcherPrivate::_q_eventsLost()
+{
+    // We cannot tell what changed, so report everything we watch, which
+    // also brings the watched directory trees up to date.
+    qCDebug(lcWatcher) << "change notifications were lost, rescanning";
+    const QStringList lostFiles = files;
+    QStringList lostDirectories = directories;
+    lostDirectories.reserve(lostDirectories.size() + treeDirectories.size());
+    for (auto it = treeDirectories.cbegin(), end = treeDirectories.cend(); it != end; ++it)
+        lostDirectories.append(it.key());
+
+    QStringList removedPaths;
+    for (const QString &path : lostFiles) {
+        const bool removed = !QFileInfo::exists(path);
+        if (removed)
+            removedPaths.append(path);
+        _q_fileChanged(path, removed);
+    }
+    for (const QString &path : qAsConst(lostDirectories)) {
+        const bool removed = !QFileInfo::exists(path);
+        if (removed && !treeDirectories.contains(path))
+            removedPaths.append(path);
+        handleDirectoryChange(path, removed, true);
+    }
+
+    // The engine may still hold watches for paths that are gone
+    if (!removedPaths.isEmpty() && native) {
+        QStringList unusedFiles, unusedDirectories;
+        native->removePaths(removedPaths, &unusedFiles, &unusedDirectories);
+    }
+}
+
+// the prefix of the paths below the directory \a path
+static QString childPrefix(const QString &path)
+{
+    return path.endsWith(QLatin1Char('/')) ? path : path + QLatin1Char('/');
+}
+
+/*!
+    \internal
+
+    Watches \a root and all directories below it as part of a directory tree.
+    Returns the directories that could not be watched.
+*/
+QStringList QFileSystemWatcherPrivate::watchTree(const QString &root)
+{
+    QFileSystemWatcherEngine *engine = selectEngine();
+    if (!engine)
+        return QStringList(root);
+
+    QStringList paths(root);
+    QDirIterator it(root, QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden | QDir::NoSymLinks,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext())
+        paths.append(it.next());
+
+    // A directory added with addPath() gets the tree's watch instead of its
+    // own, so that there is only one; unwatchTreeDirectories() gives it back.
+    if (!directories.isEmpty()) {
+        const QSet<QString> added(directories.cbegin(), directories.cend());
+        QStringList shared;
+        for (const QString &path : qAsConst(paths)) {
+            if (added.contains(path))
+                shared.append(path);
+        }
+        if (!shared.isEmpty())
+            unwatchAddedDirectories(shared);
+    }
+
+    // The engines look paths up in the lists they are given; keep those
+    // short, treeDirectories is what tracks the whole tree.
+    QStringList watchedDirectories;
+    const QStringList unhandled = engine->addTreeDirectories(paths, &watchedDirectories);
+    for (const QString &path : qAsConst(watchedDirectories))
+        treeDirectories.insert(path, engine);
+    return unhandled;
+}
+
+/*!
+    \internal
+
+    Removes the engine watches of the directories \a paths, which were
+    added with addPath(), without removing them from directories.
+*/
+void QFileSystemWatcherPrivate::unwatchAddedDirectories(const QStringList &paths)
+{
+    QStringList files, unwatched = paths;
+    if (native)
+        native->removePaths(paths, &files, &unwatched);
+    if (poller)
+        poller->removePaths(paths, &files, &unwatched);
+}
+
+/*!
+    \internal
+
+    Brings the direct subdirectories of the tree directory \a path up to
+    date after \a path changed: new subdirectories are watched with
+    everything below them, vanished ones are unwatched.
+*/
+void QFileSystemWatcherPrivate::syncTreeDirectory(const QString &path)
+{
+    QSet<QString> present;
+    QDirIterator it(path, QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden | QDir::NoSymLinks);
+    while (it.hasNext())
+        present.insert(it.next());
+
+    const QString prefix = childPrefix(path);
+    QStringList vanished;
+    auto child = treeDirectories.lowerBound(prefix);
+    while (child != treeDirectories.end() && child.key().startsWith(prefix)) {
+        const QString &childPath = child.key();
+        const int slash = childPath.indexOf(QLatin1Char('/'), prefix.size());
+        if (slash < 0) {
+            if (!present.remove(childPath))
+                vanished.append(childPath);
+            ++child;
+        } else {
+            // skip the rest of this subtree: '0' sorts right after '/'
+            child = treeDirectories.lowerBound(childPath.left(slash) + QLatin1Char('0'));
+        }
+    }
+
+    for (const QString &childPath : qAsConst(vanished))
+        unwatchTreeDirectories(childPath);
+    for (const QString &childPath : qAsConst(present))
+        watchTree(childPath);
+}
+
+/*!
+    \internal
+
+    Unwatches the tree directory \a path and all tree directories below it.
+*/
+void QFileSystemWatcherPrivate::unwatchTreeDirectories(const QString &path)
+{
+    QHash<QFileSystemWatcherEngine *, QStringList> pathsPerEngine;
+    const QString prefix = childPrefix(path);
+    auto it = treeDirectories.find(path);
+    if (it != treeDirectories.end()) {
+        pathsPerEngine[it.value()].append(it.key());
+        it = treeDirectories.erase(it);
+    }
+    it = treeDirectories.lowerBound(prefix);
+    while (it != treeDirectories.end() && it.key().startsWith(prefix)) {
+        pathsPerEngine[it.value()].append(it.key());
+        it = treeDirectories.erase(it);
+    }
+
+    QStringList stillAdded;
+    for (auto engine = pathsPerEngine.cbegin(), end = pathsPerEngine.cend(); engine != end; ++engine) {
+        QStringList unusedFiles, unusedDirectories;
+        engine.key()->removePaths(engine.value(), &unusedFiles, &unusedDirectories);
+        for (const QString &treePath : engine.value()) {
+            if (directories.contains(treePath))
+                stillAdded.append(treePath);
+        }
+    }
+
+    // directories that were also added with addPath() get their own watch back
+    if (stillAdded.isEmpty())
+        return;
+    QStringList files, watched;
+    QStringList unwatched = stillAdded;
+    if (QFileSystemWatcherEngine *engine = selectEngine())
+        unwatched = engine->addPaths(stillAdded, &files, &watched);
+    for (const QString &lost : qAsConst(unwatched))
+        directories.removeAll(lost);
+}
+
+void QFileSystemWatcherPrivate::notifyFileChanged(const QString &path)
+{
+    Q_Q(QFileSystemWatcher);
+    if (coalescingInterval <= 0) {
+        emit q->fileChanged(path, QFileSystemWatcher::QPrivateSignal());
+        return;
+    }
+    changedFiles.insert(path);
+    if (!coalescingTimer->isActive())
+        coalescingTimer->start(coalescingInterval);
+}
+
+void QFileSystemWatcherPrivate::notifyDirectoryChanged(const QString &path)
+{
+    Q_Q(QFileSystemWatcher);
+    if (coalescingInterval <= 0) {
+        emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
+        return;
+    }
+    changedDirectories.insert(path);
+    if (!coalescingTimer->isActive())
+        coalescingTimer->start(coalescingInterval);
+}
+
+void QFileSystemWatcherPrivate::flushChanges()
+{
+    Q_Q(QFileSystemWatcher);
+    if (coalescingTimer)
+        coalescingTimer->stop();
+    if (changedFiles.isEmpty() && changedDirectories.isEmpty())
+        return;
+
+    QStringList changedFileList = changedFiles.values();
+    QStringList changedDirectoryList = changedDirectories.values();
+    changedFiles.clear();
+    changedDirectories.clear();
+    changedFileList.sort();
+    changedDirectoryList.sort();
+    emit q->pathsChanged(changedFileList, changedDirectoryList, QFileSystemWatcher::QPrivateSignal());
 }
 
 #if defined(Q_OS_WIN) && !defined(Q_OS_WINRT)
@@ -360,34 +639,22 @@ QStringList QFileSystemWatcher::addPaths(const QStringList &paths)
         return p;
     }
     qCDebug(lcWatcher) << "adding" << paths;
-    const auto selectEngine = [this, d]() -> QFileSystemWatcherEngine* {
-#ifdef QT_BUILD_INTERNAL
-        const QString on = objectName();
-
-        if (Q_UNLIKELY(on.startsWith(QLatin1String("_qt_autotest_force_engine_")))) {
-            // Autotest override case - use the explicitly selected engine only
-            const QStringRef forceName = on.midRef(26);
-            if (forceName == QLatin1String("poller")) {
-                qCDebug(lcWatcher, "QFileSystemWatcher: skipping native engine, using only polling engine");
-                d_func()->initPollerEngine();
-                return d->poller;
-            } else if (forceName == QLatin1String("native")) {
-                qCDebug(lcWatcher, "QFileSystemWatcher: skipping polling engine, using only native engine");
-                return d->native;
-            }
-            return nullptr;
-        }
-#endif
-        // Normal runtime case - search intelligently for best engine
-        if(d->native) {
-            return d->native;
-        } else {
-            d_func()->initPollerEngine();
-            return d->poller;
-        }
-    };
 
-    if (auto engine = selectEngine())
+    // directories of a directory tree are watched already
+    if (!d->treeDirectories.isEmpty()) {
+        const auto inTree = [d](const QString &path) {
+            if (!d->treeDirectories.contains(path))
+                return false;
+            if (!d->directories.contains(path))
+                d->directories.append(path);
+            return true;
+        };
+        p.erase(std::remove_if(p.begin(), p.end(), inTree), p.end());
+        if (p.isEmpty())
+            return p;
+    }
+
+    if (auto engine = d->selectEngine())
         p = engine->addPaths(p, &d->files, &d->directories);
 
     return p;
@@ -437,6 +704,19 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     }
     qCDebug(lcWatcher) << "removing" << paths;
 
+    // directories of a directory tree keep the tree's watch
+    if (!d->treeDirectories.isEmpty()) {
+        const auto inTree = [d](const QString &path) {
+            if (!d->treeDirectories.contains(path) || !d->directories.contains(path))
+                return false;
+            d->directories.removeAll(path);
+            return true;
+        };
+        p.erase(std::remove_if(p.begin(), p.end(), inTree), p.end());
+        if (p.isEmpty())
+            return p;
+    }
+
     if (d->native)
         p = d->native->removePaths(p, &d->files, &d->directories);
     if (d->poller)
@@ -445,6 +725,142 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     return p;
 }
 
+/*!
+    \since 6.0
+
+    Adds the directory \a path and every directory below it to the file
+    system watcher. Returns \c true if the whole tree could be watched;
+    otherwise returns \c false.
+
+    Unlike addPath(), the watcher keeps the set of watched directories up
+    to date: directories that are created in or moved into the tree are
+    watched automatically, and directories that are removed from it are
+    unwatched. The directoryChanged() signal is emitted for every directory
+    in the tree whose contents change. Symbolic links to directories are
+    not followed.
+
+    On Linux, the fileChanged() signal is also emitted for files in the tree
+    that are written to, and coalesced changes list them among the files.
+    Other platforms only report the directories of such files when their
+    entries change.
+
+    The directories of the tree are not listed by directories(), unless they
+    were also added with addPath(); use directoryTrees() to get the paths
+    passed to this function.
+
+    \note Watching a large tree needs one system watch per directory on
+    most platforms. Consider raising the system limit, such as
+    \c{/proc/sys/fs/inotify/max_user_watches} on Linux, and using
+    setCoalescingInterval() to receive changes in batches.
+
+    \sa removeDirectoryTree(), addPath()
+*/
+bool QFileSystemWatcher::addDirectoryTree(const QString &path)
+{
+    Q_D(QFileSystemWatcher);
+
+    if (path.isEmpty()) {
+        qWarning("QFileSystemWatcher::addDirectoryTree: path is empty");
+        return true;
+    }
+
+    const QString root = QDir::cleanPath(path);
+    if (d->treeDirectories.contains(root) || !QFileInfo(root).isDir())
+        return false;
+
+    qCDebug(lcWatcher) << "adding directory tree" << root;
+    const QStringList unhandled = d->watchTree(root);
+    if (!d->treeDirectories.contains(root))
+        return false;
+
+    d->directoryTrees.append(root);
+    if (!unhandled.isEmpty())
+        qCDebug(lcWatcher) << "could not watch" << unhandled.size() << "directories of" << root;
+    return unhandled.isEmpty();
+}
+
+/*!
+    \since 6.0
+
+    Stops watching the directory tree at \a path, which must have been
+    added with addDirectoryTree(). Returns \c true on success.
+
+    \sa addDirectoryTree()
+*/
+bool QFileSystemWatcher::removeDirectoryTree(const QString &path)
+{
+    Q_D(QFileSystemWatcher);
+
+    const QString root = QDir::cleanPath(path);
+    if (!d->directoryTrees.removeOne(root))
+        return false;
+
+    qCDebug(lcWatcher) << "removing directory tree" << root;
+    d->unwatchTreeDirectories(root);
+    return true;
+}
+
+/*!
+    \since 6.0
+
+    Returns the paths of the directory trees that are being watched.
+
+    \sa addDirectoryTree()
+*/
+QStringList QFileSystemWatcher::directoryTrees() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->directoryTrees;
+}
+
+/*!
+    \since 6.0
+
+    Sets the coalescing interval to \a msecs milliseconds.
+
+    With a positive interval, changes are collected for up to \a msecs
+    milliseconds after the first one, and then reported together by a single
+    pathsChanged() signal, in which every changed path appears once. The
+    fileChanged() and directoryChanged() signals are not emitted in this
+    mode. This keeps the event loop responsive during bulk changes, such as
+    a build or a checkout in a watched directory tree.
+
+    The default interval of 0 reports every change individually. Setting
+    the interval to 0 delivers the changes collected so far immediately.
+
+    \sa coalescingInterval(), pathsChanged()
+*/
+void QFileSystemWatcher::setCoalescingInterval(int msecs)
+{
+    Q_D(QFileSystemWatcher);
+
+    msecs = qMax(0, msecs);
+    if (d->coalescingInterval == msecs)
+        return;
+
+    d->coalescingInterval = msecs;
+    if (msecs == 0) {
+        d->flushChanges();
+    } else if (!d->coalescingTimer) {
+        d->coalescingTimer = new QTimer(this);
+        d->coalescingTimer->setSingleShot(true);
+        connect(d->coalescingTimer, &QTimer::timeout, this, [d] () { d->flushChanges(); });
+    }
+}
+
+/*!
+    \since 6.0
+
+    Returns the coalescing interval in milliseconds.
+
+    \sa setCoalescingInterval()
+*/
+int QFileSystemWatcher::coalescingInterval() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->coalescingInterval;
+}
+
 /*!
     \fn void QFileSystemWatcher::fileChanged(const QString &path)
 
@@ -473,6 +889,22 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     \sa fileChanged()
 */
 
+/*!
+    \fn void QFileSystemWatcher::pathsChanged(const QStringList &files, const QStringList &directories)
+    \since 6.0
+
+    This signal is emitted instead of fileChanged() and directoryChanged()
+    when a coalescing interval is set. \a files and \a directories hold the
+    paths of the watched files and directories that were modified or removed
+    during the interval, each path once.
+
+    If the system dropped change notifications, for example because too
+    many changes happened at once, every watched path is reported as
+    changed, and watched directory trees are rescanned.
+
+    \sa setCoalescingInterval()
+*/
+
 /*!
     \fn QStringList QFileSystemWatcher::directories() const
 
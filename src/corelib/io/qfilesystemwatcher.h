@@ -67,9 +67,17 @@ public:
     QStringList files() const;
     QStringList directories() const;
 
+    bool addDirectoryTree(const QString &path);
+    bool removeDirectoryTree(const QString &path);
+    QStringList directoryTrees() const;
+
+    void setCoalescingInterval(int msecs);
+    int coalescingInterval() const;
+
 Q_SIGNALS:
     void fileChanged(const QString &path, QPrivateSignal);
     void directoryChanged(const QString &path, QPrivateSignal);
+    void pathsChanged(const QStringList &files, const QStringList &directories, QPrivateSignal);
 
 private:
     Q_PRIVATE_SLOT(d_func(), void _q_fileChanged(const QString &path, bool removed))
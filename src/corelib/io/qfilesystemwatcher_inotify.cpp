@@ -208,6 +208,7 @@ struct inotify_event {
 #define IN_UNMOUNT              0x00002000
 #define IN_Q_OVERFLOW           0x00004000
 #define IN_IGNORED              0x00008000
+#define IN_ISDIR                0x40000000
 
 #define IN_CLOSE                (IN_CLOSE_WRITE | IN_CLOSE_NOWRITE)
 #define IN_MOVE                 (IN_MOVED_FROM | IN_MOVED_TO)
@@ -268,13 +269,32 @@ QInotifyFileSystemWatcherEngine::~QInotifyFileSystemWatcherEngine()
 QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
                                                       QStringList *files,
                                                       QStringList *directories)
+{
+    return addWatches(paths, files, directories, false);
+}
+
+QStringList QInotifyFileSystemWatcherEngine::addTreeDirectories(const QStringList &paths,
+                                                                QStringList *directories)
+{
+    QStringList files;
+    return addWatches(paths, &files, directories, true);
+}
+
+QStringList QInotifyFileSystemWatcherEngine::addWatches(const QStringList &paths,
+                                                        QStringList *files,
+                                                        QStringList *directories,
+                                                        bool tree)
 {
     QStringList unhandled;
     for (const QString &path : paths) {
         QFileInfo fi(path);
         bool isDir = fi.isDir();
         auto sg = qScopeGuard([&]{ unhandled.push_back(path); });
-        if (isDir) {
+        // the paths of a tree come from a directory walk and are unique
+        if (tree) {
+            if (!isDir)
+                continue;
+        } else if (isDir) {
             if (directories->contains(path))
                 continue;
         } else {
@@ -291,6 +311,8 @@ QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
                                        | IN_CREATE
                                        | IN_DELETE
                                        | IN_DELETE_SELF
+                                       // tree directories also report their files' contents
+                                       | (tree ? IN_MODIFY | IN_CLOSE_WRITE : 0)
                                        )
                                     : (0
                                        | IN_ATTRIB
@@ -306,6 +328,8 @@ QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
         }
 
         sg.dismiss();
+        if (tree)
+            treeWatches.insert(wd);
 
         int id = isDir ? -wd : wd;
         if (id < 0) {
@@ -347,6 +371,7 @@ QStringList QInotifyFileSystemWatcherEngine::removePaths(const QStringList &path
         if (num_elements == 1) {
             int wd = id < 0 ? -id : id;
             inotify_rm_watch(inotifyFd, wd);
+            treeWatches.remove(wd);
         }
 
         sg.dismiss();
@@ -373,9 +398,34 @@ void QInotifyFileSystemWatcherEngine::readFromInotify()
     char * const end = at + buffSize;
 
     QHash<int, inotify_event *> eventForId;
+    QSet<int> subdirectoriesChangedIds;
+    QSet<QPair<int, QString>> treeFileChanges;
+    bool overflowed = false;
     while (at < end) {
         inotify_event *event = reinterpret_cast<inotify_event *>(at);
 
+        if (event->mask & IN_Q_OVERFLOW) {
+            // the kernel dropped events; the watcher has to rescan
+            overflowed = true;
+            at += sizeof(inotify_event) + event->len;
+            continue;
+        }
+
+        if (treeWatches.contains(event->wd)) {
+            const uint contentChange = IN_MODIFY | IN_CLOSE_WRITE;
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVE | IN_DELETE))
+                    subdirectoriesChangedIds.insert(event->wd);
+            } else if (event->len && (event->mask & contentChange)) {
+                treeFileChanges.insert(qMakePair(event->wd, QFile::decodeName(event->name)));
+            }
+            // the directory itself only changes when its entries do
+            if (!(event->mask & ~(contentChange | IN_ISDIR))) {
+                at += sizeof(inotify_event) + event->len;
+                continue;
+            }
+        }
+
         if (eventForId.contains(event->wd))
             eventForId[event->wd]->mask |= event->mask;
         else
@@ -406,8 +456,10 @@ void QInotifyFileSystemWatcherEngine::readFromInotify()
         if ((event.mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT)) != 0) {
             pathToID.remove(path);
             idToPath.remove(id, getPathFromID(id));
-            if (!idToPath.contains(id))
+            if (!idToPath.contains(id)) {
                 inotify_rm_watch(inotifyFd, event.wd);
+                treeWatches.remove(event.wd);
+            }
 
             if (id < 0)
                 emit directoryChanged(path, true);
@@ -420,6 +472,24 @@ void QInotifyFileSystemWatcherEngine::readFromInotify()
                 emit fileChanged(path, false);
         }
     }
+
+    // the slots may have removed the watches, so look the paths up again
+    for (int wd : qAsConst(subdirectoriesChangedIds)) {
+        const QString path = getPathFromID(-wd);
+        if (!path.isEmpty())
+            emit subdirectoriesChanged(path);
+    }
+    for (const QPair<int, QString> &change : qAsConst(treeFileChanges)) {
+        QString path = getPathFromID(-change.first);
+        if (path.isEmpty())
+            continue;
+        if (!path.endsWith(QLatin1Char('/')))
+            path += QLatin1Char('/');
+        emit treeFileChanged(path + change.second);
+    }
+
+    if (overflowed)
+        emit eventsLost();
 }
 
 template <typename Hash, typename Key>
@@ -57,6 +57,7 @@ QT_REQUIRE_CONFIG(filesystemwatcher);
 
 #include <QtCore/qhash.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
 #include <QtCore/qsocketnotifier.h>
 
 QT_BEGIN_NAMESPACE
@@ -72,11 +73,15 @@ public:
 
     QStringList addPaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
     QStringList removePaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
+    QStringList addTreeDirectories(const QStringList &paths, QStringList *directories) override;
+    bool reportsSubdirectoryChanges() const override { return true; }
 
 private Q_SLOTS:
     void readFromInotify();
 
 private:
+    QStringList addWatches(const QStringList &paths, QStringList *files,
+                           QStringList *directories, bool tree);
     QString getPathFromID(int id) const;
 
 private:
@@ -84,6 +89,7 @@ private:
     int inotifyFd;
     QHash<QString, int> pathToID;
     QMultiHash<int, QString> idToPath;
+    QSet<int> treeWatches; // watch descriptors of tree directories
     QSocketNotifier notifier;
 };
 
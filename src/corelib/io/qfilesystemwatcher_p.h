@@ -59,6 +59,8 @@ QT_REQUIRE_CONFIG(filesystemwatcher);
 
 #include <QtCore/qstringlist.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qset.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -85,11 +87,36 @@ public:
                                     QStringList *files,
                                     QStringList *directories) = 0;
 
+    // like addPaths(), for the directories of a directory tree. Engines
+    // that override it also report writes to the files in them with
+    // treeFileChanged() and new, moved and removed subdirectories with
+    // subdirectoriesChanged(), and don't emit directoryChanged() when only
+    // file contents changed
+    virtual QStringList addTreeDirectories(const QStringList &paths, QStringList *directories)
+    {
+        // addPaths() searches the lists it is given, so give it short ones
+        QStringList files, unhandled;
+        for (const QString &path : paths) {
+            QStringList added;
+            unhandled += addPaths(QStringList(path), &files, &added);
+            *directories += added;
+        }
+        return unhandled;
+    }
+    virtual bool reportsSubdirectoryChanges() const { return false; }
+
 Q_SIGNALS:
     void fileChanged(const QString &path, bool removed);
     void directoryChanged(const QString &path, bool removed);
+    void treeFileChanged(const QString &path);
+    void subdirectoriesChanged(const QString &path);
+    // emitted when the engine dropped change notifications, e.g. because
+    // its event queue overflowed
+    void eventsLost();
 };
 
+class QTimer;
+
 class QFileSystemWatcherPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QFileSystemWatcher)
@@ -100,13 +127,38 @@ public:
     QFileSystemWatcherPrivate();
     void init();
     void initPollerEngine();
+    QFileSystemWatcherEngine *selectEngine();
 
     QFileSystemWatcherEngine *native, *poller;
     QStringList files, directories;
 
+    // directory trees, see QFileSystemWatcher::addDirectoryTree()
+    QStringList watchTree(const QString &root);
+    void syncTreeDirectory(const QString &path);
+    void unwatchTreeDirectories(const QString &path);
+    void unwatchAddedDirectories(const QStringList &paths);
+    void handleDirectoryChange(const QString &path, bool removed, bool subdirectoriesChanged);
+
+    QStringList directoryTrees;
+    // every directory watched on behalf of a tree, with the engine watching
+    // it. A directory that is also in directories has only the tree watch.
+    QMap<QString, QFileSystemWatcherEngine *> treeDirectories;
+
+    // change coalescing, see QFileSystemWatcher::setCoalescingInterval()
+    void notifyFileChanged(const QString &path);
+    void notifyDirectoryChanged(const QString &path);
+    void flushChanges();
+
+    int coalescingInterval;
+    QTimer *coalescingTimer;
+    QSet<QString> changedFiles, changedDirectories;
+
     // private slots
     void _q_fileChanged(const QString &path, bool removed);
     void _q_directoryChanged(const QString &path, bool removed);
+    void _q_treeFileChanged(const QString &path);
+    void _q_subdirectoriesChanged(const QString &path);
+    void _q_eventsLost();
 
 #if defined(Q_OS_WIN) && !defined(Q_OS_WINRT)
     void _q_winDriveLockForRemoval(const QString &);
@@ -157,6 +157,9 @@ static void setBoolLane(QBasicAtomicInt *atomic, bool enable, int shift)
 
     \snippet code/src_corelib_io_qloggingcategory.cpp 2
 
+    Once a QCoreApplication has been created, changes to the file named by
+    \c QT_LOGGING_CONF are picked up while the application is running.
+
     Logging rules can also be specified in a \c QT_LOGGING_RULES environment variable;
     multiple rules can also be separated by semicolons:
 
@@ -40,12 +40,20 @@
 #include "qloggingregistry_p.h"
 
 #include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/private/qlocking_p.h>
 #include <QtCore/qstandardpaths.h>
 #include <QtCore/qtextstream.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qcoreapplication.h>
+#if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(filesystemwatcher)
+#include <QtCore/qdatetime.h>
+#include <QtCore/qfilesystemwatcher.h>
+#endif
+
+#include <algorithm>
+#include <memory>
 
 #if QT_CONFIG(settings)
 #include <QtCore/qsettings.h>
@@ -113,7 +121,7 @@ int QLoggingRule::pass(const QString &cat, QtMsgType msgType) const
                 return (enabled ? 1 : -1);
         } else if (flags == RightFilter) {
             // matches right
-            if (idx == (cat.count() - category.count()))
+            if (cat.endsWith(category))
                 return (enabled ? 1 : -1);
         }
     }
@@ -172,6 +180,138 @@ void QLoggingRule::parse(const QStringRef &pattern)
     category = p.toString();
 }
 
+static bool operator==(const QLoggingRule &lhs, const QLoggingRule &rhs)
+{
+    return lhs.category == rhs.category && lhs.messageType == rhs.messageType
+            && lhs.flags == rhs.flags && lhs.enabled == rhs.enabled;
+}
+
+/*!
+    \class QLoggingRuleMatcher
+    \internal
+
+    Applies a list of rules to category names without trying each rule in
+    turn: full text rules are looked up by name, and the prefixes of left
+    filters and the reversed suffixes of right filters are kept in tries that
+    are walked once along the name. Only rules matching somewhere in the
+    middle of a name are tried one by one.
+*/
+
+/*!
+    \internal
+    Removes all rules.
+*/
+void QLoggingRuleMatcher::clear()
+{
+    actions.clear();
+    fullTextRules.clear();
+    leftFilterRules = Trie();
+    rightFilterRules = Trie();
+    midFilterRules.clear();
+}
+
+/*!
+    \internal
+    Adds \a rules, which override the rules added before.
+*/
+void QLoggingRuleMatcher::addRules(const QVector<QLoggingRule> &rules)
+{
+    for (const QLoggingRule &rule : rules) {
+        const int index = actions.size();
+        switch (rule.flags) {
+        case QLoggingRule::FullText:
+            fullTextRules[rule.category].append(index);
+            break;
+        case QLoggingRule::LeftFilter:
+            leftFilterRules.insert(rule.category, false, index);
+            break;
+        case QLoggingRule::RightFilter:
+            rightFilterRules.insert(rule.category, true, index);
+            break;
+        case QLoggingRule::MidFilter:
+            midFilterRules.append(qMakePair(rule.category, index));
+            break;
+        default:
+            continue;   // invalid pattern
+        }
+        actions.append({ qint8(rule.messageType), rule.enabled });
+    }
+}
+
+void QLoggingRuleMatcher::Trie::insert(QStringView key, bool reversed, int rule)
+{
+    int node = 0;
+    const qsizetype size = key.size();
+    for (qsizetype i = 0; i < size; ++i) {
+        const QChar c = key[reversed ? size - 1 - i : i];
+        const quint64 edge = (quint64(node) << 16) | c.unicode();
+        auto it = edges.constFind(edge);
+        if (it == edges.constEnd()) {
+            rules.append(QVector<int>());
+            it = edges.insert(edge, rules.size() - 1);
+        }
+        node = *it;
+    }
+    rules[node].append(rule);
+}
+
+template <typename Container>
+void QLoggingRuleMatcher::Trie::collect(QStringView name, bool reversed, Container *matches) const
+{
+    int node = 0;
+    const qsizetype size = name.size();
+    for (qsizetype i = 0; ; ++i) {
+        for (int rule : rules.at(node))
+            matches->append(rule);
+        if (i == size)
+            break;
+        const QChar c = name[reversed ? size - 1 - i : i];
+        const auto it = edges.constFind((quint64(node) << 16) | c.unicode());
+        if (it == edges.constEnd())
+            break;
+        node = *it;
+    }
+}
+
+/*!
+    \internal
+    Returns what the rules decide for the category \a categoryName. This
+    gives the same result as calling QLoggingRule::pass() for every rule in
+    order.
+*/
+QLoggingRuleMatcher::Verdict QLoggingRuleMatcher::match(const QString &categoryName) const
+{
+    QVarLengthArray<int, 16> matches;
+
+    const auto it = fullTextRules.constFind(categoryName);
+    if (it != fullTextRules.constEnd()) {
+        for (int rule : *it)
+            matches.append(rule);
+    }
+    leftFilterRules.collect(categoryName, false, &matches);
+    rightFilterRules.collect(categoryName, true, &matches);
+    for (const auto &rule : midFilterRules) {
+        if (categoryName.contains(rule.first))
+            matches.append(rule.second);
+    }
+
+    std::sort(matches.begin(), matches.end());
+
+    constexpr quint8 allTypes = (1 << QtDebugMsg) | (1 << QtInfoMsg) | (1 << QtWarningMsg)
+                                | (1 << QtCriticalMsg);
+    Verdict verdict;
+    for (int rule : matches) {
+        const Action action = actions.at(rule);
+        const quint8 types = action.messageType < 0 ? allTypes : quint8(1 << action.messageType);
+        verdict.decided |= types;
+        if (action.enabled)
+            verdict.enabled |= types;
+        else
+            verdict.enabled &= ~types;
+    }
+    return verdict;
+}
+
 /*!
     \class QLoggingSettingsParser
     \since 5.3
@@ -302,18 +442,12 @@ static QVector<QLoggingRule> loadRulesFromFile(const QString &filePath)
     return QVector<QLoggingRule>();
 }
 
-/*!
-    \internal
-    Initializes the rules database by loading
-    $QT_LOGGING_CONF, $QT_LOGGING_RULES, and .config/QtProject/qtlogging.ini.
- */
-void QLoggingRegistry::initializeRules()
+static QVector<QLoggingRule> loadRulesFromEnvironment()
 {
-    QVector<QLoggingRule> er, qr, cr;
-    // get rules from environment
+    QVector<QLoggingRule> rules;
     const QByteArray rulesFilePath = qgetenv("QT_LOGGING_CONF");
     if (!rulesFilePath.isEmpty())
-        er = loadRulesFromFile(QFile::decodeName(rulesFilePath));
+        rules = loadRulesFromFile(QFile::decodeName(rulesFilePath));
 
     const QByteArray rulesSrc = qgetenv("QT_LOGGING_RULES").replace(';', '\n');
     if (!rulesSrc.isEmpty()) {
@@ -321,8 +455,21 @@ void QLoggingRegistry::initializeRules()
          QLoggingSettingsParser parser;
          parser.setImplicitRulesSection(true);
          parser.setContent(stream);
-         er += parser.rules();
+         rules += parser.rules();
     }
+    return rules;
+}
+
+/*!
+    \internal
+    Initializes the rules database by loading
+    $QT_LOGGING_CONF, $QT_LOGGING_RULES, and .config/QtProject/qtlogging.ini.
+ */
+void QLoggingRegistry::initializeRules()
+{
+    QVector<QLoggingRule> er, qr, cr;
+    // get rules from environment
+    er = loadRulesFromEnvironment();
 
     const QString configFileName = QStringLiteral("qtlogging.ini");
 
@@ -355,12 +502,23 @@ void QLoggingRegistry::initializeRules()
 
     This method might be called concurrently for the same category object.
 */
+static QByteArray categoryNameKey(const QLoggingCategory *cat)
+{
+    return QByteArray::fromRawData(cat->categoryName(), qstrlen(cat->categoryName()));
+}
+
 void QLoggingRegistry::registerCategory(QLoggingCategory *cat, QtMsgType enableForLevel)
 {
     const auto locker = qt_scoped_lock(registryMutex);
 
     if (!categories.contains(cat)) {
         categories.insert(cat, enableForLevel);
+        // the key refers to the name of the first category in the group
+        const QByteArray name = categoryNameKey(cat);
+        auto it = categoriesByName.find(name);
+        if (it == categoriesByName.end())
+            it = categoriesByName.insert(name, NamedCategories());
+        it->categories.append(cat);
         (*categoryFilter)(cat);
     }
 }
@@ -372,7 +530,23 @@ void QLoggingRegistry::registerCategory(QLoggingCategory *cat, QtMsgType enableF
 void QLoggingRegistry::unregisterCategory(QLoggingCategory *cat)
 {
     const auto locker = qt_scoped_lock(registryMutex);
-    categories.remove(cat);
+    if (!categories.remove(cat))
+        return;
+
+    const auto it = categoriesByName.find(categoryNameKey(cat));
+    if (it == categoriesByName.end())
+        return;
+    NamedCategories &named = *it;
+    const bool ownsKey = named.categories.first() == cat;
+    named.categories.erase(std::find(named.categories.begin(), named.categories.end(), cat));
+    if (named.categories.isEmpty()) {
+        categoriesByName.erase(it);
+    } else if (ownsKey) {
+        // the name the key refers to is going away with cat
+        NamedCategories rest = std::move(named);
+        categoriesByName.erase(it);
+        categoriesByName.insert(categoryNameKey(rest.categories.first()), std::move(rest));
+    }
 }
 
 /*!
@@ -395,6 +569,108 @@ void QLoggingRegistry::setApiRules(const QString &content)
     updateRules();
 }
 
+/*!
+    \internal
+    Reloads the rules from $QT_LOGGING_CONF and $QT_LOGGING_RULES. Only the
+    categories that the added or removed rules match are filtered again.
+*/
+void QLoggingRegistry::reloadConfigurationFile()
+{
+    QVector<QLoggingRule> er = loadRulesFromEnvironment();
+
+    const QMutexLocker locker(&registryMutex);
+
+    // The rules before the first and after the last difference still
+    // override the same rules as before, so they cannot change the outcome
+    // for a category that none of the rules in between match.
+    QVector<QLoggingRule> &current = ruleSets[EnvironmentRules];
+    int first = 0;
+    while (first < current.size() && first < er.size() && current.at(first) == er.at(first))
+        ++first;
+    if (first == current.size() && first == er.size())
+        return;
+    int last = 0;
+    while (last < current.size() - first && last < er.size() - first
+           && current.at(current.size() - 1 - last) == er.at(er.size() - 1 - last))
+        ++last;
+
+    const QVector<QLoggingRule> changedRules = current.mid(first, current.size() - first - last)
+            + er.mid(first, er.size() - first - last);
+    current = std::move(er);
+
+    if (qtLoggingDebug())
+        debugMsg("Reloaded logging rules, %d changed", int(changedRules.size()));
+
+    updateRules(changedRules);
+}
+
+#if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(filesystemwatcher)
+namespace {
+struct ConfigurationFileState
+{
+    explicit ConfigurationFileState(const QString &filePath)
+    {
+        const QFileInfo info(filePath);
+        exists = info.exists();
+        if (exists) {
+            size = info.size();
+            lastModified = info.lastModified();
+            metadataChanged = info.metadataChangeTime();
+        }
+    }
+
+    bool operator==(const ConfigurationFileState &other) const
+    {
+        return exists == other.exists && size == other.size
+                && lastModified == other.lastModified
+                && metadataChanged == other.metadataChanged;
+    }
+    bool operator!=(const ConfigurationFileState &other) const { return !(*this == other); }
+
+    bool exists = false;
+    qint64 size = 0;
+    QDateTime lastModified;
+    QDateTime metadataChanged;
+};
+} // unnamed namespace
+
+/*!
+    \internal
+    Reloads the rules whenever the file named by $QT_LOGGING_CONF changes.
+    The watcher belongs to the application object.
+*/
+void QLoggingRegistry::watchConfigurationFile()
+{
+    const QByteArray rulesFilePath = qgetenv("QT_LOGGING_CONF");
+    if (rulesFilePath.isEmpty() || !QCoreApplication::instance())
+        return;
+
+    const QFileInfo fileInfo(QFile::decodeName(rulesFilePath));
+    const QString filePath = fileInfo.absoluteFilePath();
+    QFileSystemWatcher *watcher = new QFileSystemWatcher(QCoreApplication::instance());
+    // Editors often save by replacing the file, which ends the watch on it;
+    // watching the directory as well tells when it is back.
+    if (fileInfo.exists())
+        watcher->addPath(filePath);
+    watcher->addPath(fileInfo.absolutePath());
+
+    // The directory also changes whenever any other file in it does, which
+    // must not reload the rules; only look at the file then.
+    auto state = std::make_shared<ConfigurationFileState>(filePath);
+    const auto reload = [watcher, filePath, state]() {
+        *state = ConfigurationFileState(filePath);
+        if (!watcher->files().contains(filePath) && state->exists)
+            watcher->addPath(filePath);
+        QLoggingRegistry::instance()->reloadConfigurationFile();
+    };
+    QObject::connect(watcher, &QFileSystemWatcher::fileChanged, reload);
+    QObject::connect(watcher, &QFileSystemWatcher::directoryChanged, [filePath, state, reload]() {
+        if (ConfigurationFileState(filePath) != *state)
+            reload();
+    });
+}
+#endif
+
 /*!
     \internal
     Activates a new set of logging rules for the default filter.
@@ -403,8 +679,81 @@ void QLoggingRegistry::setApiRules(const QString &content)
 */
 void QLoggingRegistry::updateRules()
 {
-    for (auto it = categories.keyBegin(), end = categories.keyEnd(); it != end; ++it)
-        (*categoryFilter)(*it);
+    ruleMatcher.clear();
+    for (const auto &ruleSet : ruleSets)
+        ruleMatcher.addRules(ruleSet);
+
+    for (NamedCategories &named : categoriesByName) {
+        named.hasVerdict = false;
+        for (QLoggingCategory *cat : qAsConst(named.categories))
+            (*categoryFilter)(cat);
+    }
+}
+
+/*!
+    \internal
+    Activates a new set of logging rules that differs from the previous one
+    by \a changedRules, filtering only the categories these match again.
+
+    (The caller must lock registryMutex to make sure the API is thread safe.)
+*/
+void QLoggingRegistry::updateRules(const QVector<QLoggingRule> &changedRules)
+{
+    ruleMatcher.clear();
+    for (const auto &ruleSet : ruleSets)
+        ruleMatcher.addRules(ruleSet);
+
+    QVector<NamedCategories *> affected;
+    const bool onlyFullText = std::all_of(changedRules.cbegin(), changedRules.cend(),
+                                          [](const QLoggingRule &rule) {
+        return rule.flags == QLoggingRule::FullText;
+    });
+    if (onlyFullText) {
+        for (const QLoggingRule &rule : changedRules) {
+            const auto it = categoriesByName.find(rule.category.toLatin1());
+            if (it != categoriesByName.end())
+                affected.append(&*it);
+        }
+        std::sort(affected.begin(), affected.end());
+        affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+    } else {
+        // each name is matched once against the changed rules only
+        QLoggingRuleMatcher changed;
+        changed.addRules(changedRules);
+        for (auto it = categoriesByName.begin(), end = categoriesByName.end(); it != end; ++it) {
+            if (changed.match(QString::fromLatin1(it.key())).decided)
+                affected.append(&*it);
+        }
+    }
+
+    for (NamedCategories *named : qAsConst(affected)) {
+        named->hasVerdict = false;
+        for (QLoggingCategory *cat : qAsConst(named->categories))
+            (*categoryFilter)(cat);
+    }
+}
+
+/*!
+    \internal
+    Returns what the rules decide for categories called \a categoryName,
+    remembering it for the next category of the same name.
+
+    (The caller must lock registryMutex.)
+*/
+QLoggingRuleMatcher::Verdict QLoggingRegistry::ruleVerdict(const char *categoryName)
+{
+    if (ruleMatcher.isEmpty())
+        return QLoggingRuleMatcher::Verdict();
+
+    const auto it = categoriesByName.find(QByteArray::fromRawData(categoryName,
+                                                                  qstrlen(categoryName)));
+    if (it == categoriesByName.end())
+        return ruleMatcher.match(QLatin1String(categoryName));
+    if (!it->hasVerdict) {
+        it->verdict = ruleMatcher.match(QLatin1String(categoryName));
+        it->hasVerdict = true;
+    }
+    return it->verdict;
 }
 
 /*!
@@ -440,7 +789,7 @@ QLoggingRegistry *QLoggingRegistry::instance()
 */
 void QLoggingRegistry::defaultCategoryFilter(QLoggingCategory *cat)
 {
-    const QLoggingRegistry *reg = QLoggingRegistry::instance();
+    QLoggingRegistry *reg = QLoggingRegistry::instance();
     Q_ASSERT(reg->categories.contains(cat));
     QtMsgType enableForLevel = reg->categories.value(cat);
 
@@ -460,24 +809,15 @@ void QLoggingRegistry::defaultCategoryFilter(QLoggingCategory *cat)
             debug = false;
     }
 
-    QString categoryName = QLatin1String(cat->categoryName());
-
-    for (const auto &ruleSet : reg->ruleSets) {
-        for (const auto &rule : ruleSet) {
-            int filterpass = rule.pass(categoryName, QtDebugMsg);
-            if (filterpass != 0)
-                debug = (filterpass > 0);
-            filterpass = rule.pass(categoryName, QtInfoMsg);
-            if (filterpass != 0)
-                info = (filterpass > 0);
-            filterpass = rule.pass(categoryName, QtWarningMsg);
-            if (filterpass != 0)
-                warning = (filterpass > 0);
-            filterpass = rule.pass(categoryName, QtCriticalMsg);
-            if (filterpass != 0)
-                critical = (filterpass > 0);
-        }
-    }
+    const QLoggingRuleMatcher::Verdict verdict = reg->ruleVerdict(cat->categoryName());
+    if (verdict.isDecided(QtDebugMsg))
+        debug = verdict.isEnabled(QtDebugMsg);
+    if (verdict.isDecided(QtInfoMsg))
+        info = verdict.isEnabled(QtInfoMsg);
+    if (verdict.isDecided(QtWarningMsg))
+        warning = verdict.isEnabled(QtWarningMsg);
+    if (verdict.isDecided(QtCriticalMsg))
+        critical = verdict.isEnabled(QtCriticalMsg);
 
     cat->setEnabled(QtDebugMsg, debug);
     cat->setEnabled(QtInfoMsg, info);
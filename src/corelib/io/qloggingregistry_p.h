@@ -52,11 +52,15 @@
 //
 
 #include <QtCore/private/qglobal_p.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qloggingcategory.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qpair.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qstringview.h>
 #include <QtCore/qtextstream.h>
+#include <QtCore/qvarlengtharray.h>
 #include <QtCore/qvector.h>
 
 class tst_QLoggingRegistry;
@@ -90,6 +94,53 @@ private:
 Q_DECLARE_OPERATORS_FOR_FLAGS(QLoggingRule::PatternFlags)
 Q_DECLARE_TYPEINFO(QLoggingRule, Q_MOVABLE_TYPE);
 
+class Q_AUTOTEST_EXPORT QLoggingRuleMatcher
+{
+public:
+    // bit (1 << type) is set in decided if a rule applies to messages of
+    // that type, and then in enabled if the last such rule enables them
+    struct Verdict
+    {
+        quint8 decided = 0;
+        quint8 enabled = 0;
+
+        bool isDecided(QtMsgType type) const { return decided & (1 << type); }
+        bool isEnabled(QtMsgType type) const { return enabled & (1 << type); }
+    };
+
+    void clear();
+    void addRules(const QVector<QLoggingRule> &rules);
+    Verdict match(const QString &categoryName) const;
+    bool isEmpty() const { return actions.isEmpty(); }
+
+private:
+    // rules are numbered in the order they were added, which is the order
+    // in which they override each other
+    struct Action
+    {
+        qint8 messageType;
+        bool enabled;
+    };
+
+    // prefixes (or reversed suffixes) sharing their first characters share
+    // nodes; node 0 is the root
+    struct Trie
+    {
+        QHash<quint64, int> edges;              // (node << 16) | character -> node
+        QVector<QVector<int>> rules = QVector<QVector<int>>(1);
+
+        void insert(QStringView key, bool reversed, int rule);
+        template <typename Container>
+        void collect(QStringView name, bool reversed, Container *matches) const;
+    };
+
+    QVector<Action> actions;
+    QHash<QString, QVector<int>> fullTextRules;
+    Trie leftFilterRules;
+    Trie rightFilterRules;
+    QVector<QPair<QString, int>> midFilterRules;
+};
+
 class Q_AUTOTEST_EXPORT QLoggingSettingsParser
 {
 public:
@@ -119,6 +170,10 @@ public:
     void unregisterCategory(QLoggingCategory *category);
 
     void setApiRules(const QString &content);
+    void reloadConfigurationFile();
+#if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(filesystemwatcher)
+    void watchConfigurationFile();
+#endif
 
     QLoggingCategory::CategoryFilter
     installFilter(QLoggingCategory::CategoryFilter filter);
@@ -127,6 +182,8 @@ public:
 
 private:
     void updateRules();
+    void updateRules(const QVector<QLoggingRule> &changedRules);
+    QLoggingRuleMatcher::Verdict ruleVerdict(const char *categoryName);
 
     static void defaultCategoryFilter(QLoggingCategory *category);
 
@@ -147,6 +204,17 @@ private:
     QHash<QLoggingCategory*,QtMsgType> categories;
     QLoggingCategory::CategoryFilter categoryFilter;
 
+    // the rule sets compiled, and the registered categories grouped by name
+    // with the verdict of the rules on that name once it has been asked for
+    struct NamedCategories
+    {
+        QVarLengthArray<QLoggingCategory *, 1> categories;
+        QLoggingRuleMatcher::Verdict verdict;
+        bool hasVerdict = false;
+    };
+    QLoggingRuleMatcher ruleMatcher;
+    QHash<QByteArray, NamedCategories> categoriesByName;
+
     friend class ::tst_QLoggingRegistry;
 };
 
@@ -322,6 +322,9 @@ public:
 #if defined(Q_OS_WIN)
     QString nativeArguments;
     QProcess::CreateProcessArgumentModifier modifyCreateProcessArgs;
+#endif
+#if defined(Q_OS_UNIX)
+    std::function<void(void)> childProcessModifier;
 #endif
     QProcessEnvironment environment;
 
@@ -359,6 +359,24 @@ static char **_q_dupEnvironment(const QProcessEnvironmentPrivate::Map &environme
     return envp;
 }
 
+namespace {
+struct ChildProcessArguments
+{
+    QProcessPrivate *d;
+    const char *workingDirectory;
+    char **argv;
+    char **envp;
+};
+}
+
+// Runs in the child process, possibly sharing our memory (see vforkfd())
+static int execChildTrampoline(void *token)
+{
+    auto args = static_cast<ChildProcessArguments *>(token);
+    args->d->execChild(args->workingDirectory, args->argv, args->envp);
+    return -1;
+}
+
 void QProcessPrivate::startProcess()
 {
     Q_Q(QProcess);
@@ -451,8 +469,17 @@ void QProcessPrivate::startProcess()
     }
 
     // Start the process manager, and fork off the child process.
+    // Unless there is a modifier to run in the child, it only sets up its
+    // file descriptors and calls execve(), so it doesn't need its own copy
+    // of our address space; copying the page tables of a large parent is
+    // the most expensive part of fork().
     pid_t childPid;
-    forkfd = ::forkfd(FFD_CLOEXEC, &childPid);
+    if (childProcessModifier) {
+        forkfd = ::forkfd(FFD_CLOEXEC, &childPid);
+    } else {
+        ChildProcessArguments childArguments = { this, workingDirPtr, argv, envp };
+        forkfd = ::vforkfd(FFD_CLOEXEC, &childPid, execChildTrampoline, &childArguments);
+    }
     int lastForkErrno = errno;
     if (forkfd != FFD_CHILD_PROCESS) {
         // Parent process.
@@ -534,7 +561,6 @@ void QProcessPrivate::execChild(const char *workingDir, char **argv, char **envp
 {
     ::signal(SIGPIPE, SIG_DFL);         // reset the signal that we ignored
 
-    Q_Q(QProcess);
     ChildError error = { 0, {} };       // force zeroing of function[8]
 
     // copy the stdin socket if asked to (without closing on exec)
@@ -564,8 +590,8 @@ void QProcessPrivate::execChild(const char *workingDir, char **argv, char **envp
         goto report_errno;
     }
 
-    // this is a virtual call, and it base behavior is to do nothing.
-    q->setupChildProcess();
+    if (childProcessModifier)
+        childProcessModifier();
 
     // execute the process
     if (!envp) {
@@ -583,9 +609,9 @@ void QProcessPrivate::execChild(const char *workingDir, char **argv, char **envp
     // don't use strerror or any other routines that may allocate memory, since
     // some buggy libc versions can deadlock on locked mutexes.
 report_errno:
+    // Don't touch any member: the child may be sharing the parent's memory.
     error.code = errno;
     qt_safe_write(childStartedPipe[1], &error, sizeof(error));
-    childStartedPipe[1] = -1;
 }
 
 bool QProcessPrivate::processStarted(QString *errorMessage)
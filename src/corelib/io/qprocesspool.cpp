@@ -0,0 +1,456 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qprocesspool.h"
+#include "qprocesspool_p.h"
+
+#include <private/qlocking_p.h>
+
+#include <qthread.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QProcessPool
+    \inmodule QtCore
+    \brief The QProcessPool class runs a batch of external programs with a
+    limit on how many run at the same time.
+    \ingroup io
+    \since 6.0
+    \reentrant
+
+    QProcessPool is meant for starting many short-lived programs, such as
+    compilers or converters, and collecting their results. Each call to
+    addProcess() queues a program and returns its index in the pool; the
+    pool starts queued programs in order, and never runs more than
+    maximumConcurrency() of them at once.
+
+    Unlike a set of QProcess objects, the pool does not create socket
+    notifiers for each child. On Unix, the pipes and exit notifications of
+    all children are multiplexed in a single poll set on a helper thread,
+    so that running hundreds of children does not load the event loop of
+    the calling thread.
+
+    The input passed to addProcess() is written to the child's standard
+    input, which is then closed. Depending on processChannelMode(), the
+    standard output and standard error of the child are captured into
+    buffers, which can be retrieved with standardOutput() and
+    standardError() once the child has finished. If the size of the output
+    is known in advance, setOutputBufferSize() avoids reallocating the
+    buffers while they fill.
+
+    The processFinished() signal is emitted once for every program, followed
+    by progress(). When all programs added so far have finished, finished()
+    is emitted. Like QProcess, QProcessPool also provides
+    waitForFinished(), which emits these signals without an event loop.
+
+    \sa QProcess
+*/
+
+/*!
+    \fn void QProcessPool::processFinished(int index)
+
+    This signal is emitted when the program at \a index has finished, or
+    failed to start. Its results are available from exitCode(),
+    exitStatus(), error(), standardOutput() and standardError().
+*/
+
+/*!
+    \fn void QProcessPool::progress(int finishedCount, int totalCount)
+
+    This signal is emitted after processFinished(). \a finishedCount is the
+    number of programs that have finished and \a totalCount the number of
+    programs added to the pool.
+*/
+
+/*!
+    \fn void QProcessPool::finished()
+
+    This signal is emitted when every program added to the pool has
+    finished.
+*/
+
+QProcessPoolPrivate::QProcessPoolPrivate()
+    : maximumConcurrency(qMax(1, QThread::idealThreadCount()))
+{
+}
+
+QProcessPoolPrivate::~QProcessPoolPrivate()
+{
+}
+
+// Called on the worker side; hands the result over to the thread of the
+// pool and wakes up anybody waiting in waitForFinished().
+void QProcessPoolPrivate::postResult(Result &&result)
+{
+    Q_Q(QProcessPool);
+    const auto locker = qt_scoped_lock(mutex);
+    results.append(std::move(result));
+    resultsReady.wakeAll();
+    if (!collectPosted) {
+        collectPosted = true;
+        QMetaObject::invokeMethod(q, "_q_collectResults", Qt::QueuedConnection);
+    }
+}
+
+void QProcessPoolPrivate::_q_collectResults()
+{
+    Q_Q(QProcessPool);
+    QList<Result> collected;
+    {
+        const auto locker = qt_scoped_lock(mutex);
+        collected.swap(results);
+        collectPosted = false;
+    }
+
+    for (Result &result : collected) {
+        const int index = result.index;
+        Job &job = jobs[index];
+        job.result = std::move(result);
+        job.finished = true;
+        ++finished;
+        emit q->processFinished(index);
+        emit q->progress(finished, jobs.size());
+        if (finished == jobs.size())
+            emit q->finished();
+    }
+}
+
+/*!
+    Constructs a QProcessPool with the given \a parent.
+*/
+QProcessPool::QProcessPool(QObject *parent)
+    : QObject(*new QProcessPoolPrivate, parent)
+{
+}
+
+/*!
+    Destroys the pool. Programs that are still running are killed, and
+    programs that have not been started yet are discarded.
+*/
+QProcessPool::~QProcessPool()
+{
+    Q_D(QProcessPool);
+    d->shutdown();
+}
+
+/*!
+    Returns the maximum number of programs the pool runs at the same time.
+    The default is QThread::idealThreadCount().
+
+    \sa setMaximumConcurrency()
+*/
+int QProcessPool::maximumConcurrency() const
+{
+    Q_D(const QProcessPool);
+    const auto locker = qt_scoped_lock(const_cast<QMutex &>(d->mutex));
+    return d->maximumConcurrency;
+}
+
+/*!
+    Sets the maximum number of programs the pool runs at the same time to
+    \a count. Raising the limit starts queued programs right away; lowering
+    it does not stop programs that are already running.
+*/
+void QProcessPool::setMaximumConcurrency(int count)
+{
+    Q_D(QProcessPool);
+    {
+        const auto locker = qt_scoped_lock(d->mutex);
+        d->maximumConcurrency = qMax(1, count);
+    }
+    d->concurrencyChanged();
+}
+
+/*!
+    Returns the channel mode used for programs added to the pool. The
+    default is QProcess::SeparateChannels.
+
+    \sa setProcessChannelMode()
+*/
+QProcess::ProcessChannelMode QProcessPool::processChannelMode() const
+{
+    Q_D(const QProcessPool);
+    return d->channelMode;
+}
+
+/*!
+    Sets the channel mode used for programs added to the pool from now on
+    to \a mode. Channels that are forwarded are not captured, and the
+    corresponding standardOutput() or standardError() stays empty.
+
+    \sa QProcess::setProcessChannelMode()
+*/
+void QProcessPool::setProcessChannelMode(QProcess::ProcessChannelMode mode)
+{
+    Q_D(QProcessPool);
+    d->channelMode = mode;
+}
+
+/*!
+    Returns the number of bytes reserved for each captured output channel
+    when a program starts. The default is 0.
+
+    \sa setOutputBufferSize()
+*/
+qint64 QProcessPool::outputBufferSize() const
+{
+    Q_D(const QProcessPool);
+    return d->bufferSize;
+}
+
+/*!
+    Reserves \a size bytes for each captured output channel of the programs
+    added from now on. This is only a hint: output larger than \a size is
+    still captured completely.
+*/
+void QProcessPool::setOutputBufferSize(qint64 size)
+{
+    Q_D(QProcessPool);
+    d->bufferSize = qMax<qint64>(0, size);
+}
+
+/*!
+    Returns the working directory of the programs added to the pool.
+
+    \sa setWorkingDirectory()
+*/
+QString QProcessPool::workingDirectory() const
+{
+    Q_D(const QProcessPool);
+    return d->workingDirectory;
+}
+
+/*!
+    Sets the working directory of the programs added from now on to \a dir.
+    If \a dir is empty, they run in the working directory of the calling
+    process.
+*/
+void QProcessPool::setWorkingDirectory(const QString &dir)
+{
+    Q_D(QProcessPool);
+    d->workingDirectory = dir;
+}
+
+/*!
+    Returns the environment of the programs added to the pool.
+
+    \sa setProcessEnvironment()
+*/
+QProcessEnvironment QProcessPool::processEnvironment() const
+{
+    Q_D(const QProcessPool);
+    return d->environment;
+}
+
+/*!
+    Sets the environment of the programs added from now on to
+    \a environment. If \a environment is empty, they inherit the
+    environment of the calling process.
+*/
+void QProcessPool::setProcessEnvironment(const QProcessEnvironment &environment)
+{
+    Q_D(QProcessPool);
+    d->environment = environment;
+}
+
+/*!
+    Queues \a program to be started with \a arguments, and returns its index
+    in the pool. The program is started as soon as fewer than
+    maximumConcurrency() programs are running. \a input is written to its
+    standard input, which is closed afterwards.
+
+    Programs are looked up in the same way as by QProcess::start().
+*/
+int QProcessPool::addProcess(const QString &program, const QStringList &arguments,
+                             const QByteArray &input)
+{
+    Q_D(QProcessPool);
+    const int index = d->jobs.size();
+    d->jobs.append(QProcessPoolPrivate::Job());
+
+    QProcessPoolPrivate::Launch launch = {
+        index, program, arguments, input, d->workingDirectory,
+        d->environment.isEmpty() ? QStringList() : d->environment.toStringList(),
+        d->channelMode, d->bufferSize
+    };
+    d->launch(std::move(launch));
+    return index;
+}
+
+/*!
+    Returns the number of programs added to the pool.
+*/
+int QProcessPool::count() const
+{
+    Q_D(const QProcessPool);
+    return d->jobs.size();
+}
+
+/*!
+    Returns the number of programs that have finished, as reported by
+    processFinished().
+*/
+int QProcessPool::finishedCount() const
+{
+    Q_D(const QProcessPool);
+    return d->finished;
+}
+
+/*!
+    Returns \c true if every program added to the pool has finished.
+*/
+bool QProcessPool::isFinished() const
+{
+    Q_D(const QProcessPool);
+    return d->finished == d->jobs.size();
+}
+
+/*!
+    Returns \c true if the program at \a index has finished. The results of
+    a program are only available once it has finished.
+*/
+bool QProcessPool::isProcessFinished(int index) const
+{
+    Q_D(const QProcessPool);
+    return d->jobs.value(index).finished;
+}
+
+/*!
+    Returns the exit code of the program at \a index.
+
+    \sa QProcess::exitCode()
+*/
+int QProcessPool::exitCode(int index) const
+{
+    Q_D(const QProcessPool);
+    return d->jobs.value(index).result.exitCode;
+}
+
+/*!
+    Returns the exit status of the program at \a index.
+
+    \sa QProcess::exitStatus()
+*/
+QProcess::ExitStatus QProcessPool::exitStatus(int index) const
+{
+    Q_D(const QProcessPool);
+    return d->jobs.value(index).result.exitStatus;
+}
+
+/*!
+    Returns the error that occurred running the program at \a index, or
+    QProcess::UnknownError if there was none. Programs that were discarded
+    by kill() before they started report QProcess::FailedToStart.
+
+    \sa QProcess::error()
+*/
+QProcess::ProcessError QProcessPool::error(int index) const
+{
+    Q_D(const QProcessPool);
+    return d->jobs.value(index).result.error;
+}
+
+/*!
+    Returns a human-readable description of error(\a index).
+*/
+QString QProcessPool::errorString(int index) const
+{
+    Q_D(const QProcessPool);
+    return d->jobs.value(index).result.errorString;
+}
+
+/*!
+    Returns the captured standard output of the program at \a index. With
+    QProcess::MergedChannels, this includes its standard error.
+*/
+QByteArray QProcessPool::standardOutput(int index) const
+{
+    Q_D(const QProcessPool);
+    return d->jobs.value(index).result.standardOutput;
+}
+
+/*!
+    Returns the captured standard error of the program at \a index.
+*/
+QByteArray QProcessPool::standardError(int index) const
+{
+    Q_D(const QProcessPool);
+    return d->jobs.value(index).result.standardError;
+}
+
+/*!
+    Blocks until every program added to the pool has finished, or until
+    \a msecs milliseconds have passed. If \a msecs is -1, this function
+    does not time out. The processFinished(), progress() and finished()
+    signals are emitted from within this function.
+
+    Returns \c true if all programs have finished.
+
+    \sa QProcess::waitForFinished()
+*/
+bool QProcessPool::waitForFinished(int msecs)
+{
+    Q_D(QProcessPool);
+    QDeadlineTimer deadline(msecs);
+    for (;;) {
+        d->_q_collectResults();
+        if (isFinished())
+            return true;
+        if (!d->waitForResults(deadline))
+            return false;
+    }
+}
+
+/*!
+    Kills the programs that are running and discards the ones that have not
+    been started yet. processFinished() is still emitted for all of them.
+
+    \sa QProcess::kill()
+*/
+void QProcessPool::kill()
+{
+    Q_D(QProcessPool);
+    d->killAll();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qprocesspool.cpp"
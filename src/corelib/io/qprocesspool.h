@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QPROCESSPOOL_H
+#define QPROCESSPOOL_H
+
+#include <QtCore/qobject.h>
+#include <QtCore/qprocess.h>
+
+QT_REQUIRE_CONFIG(process);
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+
+class QProcessPoolPrivate;
+
+class Q_CORE_EXPORT QProcessPool : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QProcessPool)
+
+public:
+    explicit QProcessPool(QObject *parent = nullptr);
+    ~QProcessPool();
+
+    int maximumConcurrency() const;
+    void setMaximumConcurrency(int count);
+
+    QProcess::ProcessChannelMode processChannelMode() const;
+    void setProcessChannelMode(QProcess::ProcessChannelMode mode);
+
+    qint64 outputBufferSize() const;
+    void setOutputBufferSize(qint64 size);
+
+    QString workingDirectory() const;
+    void setWorkingDirectory(const QString &dir);
+
+    QProcessEnvironment processEnvironment() const;
+    void setProcessEnvironment(const QProcessEnvironment &environment);
+
+    int addProcess(const QString &program, const QStringList &arguments = QStringList(),
+                   const QByteArray &input = QByteArray());
+
+    int count() const;
+    int finishedCount() const;
+    bool isFinished() const;
+
+    bool isProcessFinished(int index) const;
+    int exitCode(int index) const;
+    QProcess::ExitStatus exitStatus(int index) const;
+    QProcess::ProcessError error(int index) const;
+    QString errorString(int index) const;
+    QByteArray standardOutput(int index) const;
+    QByteArray standardError(int index) const;
+
+    bool waitForFinished(int msecs = 30000);
+
+public Q_SLOTS:
+    void kill();
+
+Q_SIGNALS:
+    void processFinished(int index);
+    void progress(int finishedCount, int totalCount);
+    void finished();
+
+private:
+    Q_DISABLE_COPY(QProcessPool)
+    Q_PRIVATE_SLOT(d_func(), void _q_collectResults())
+};
+
+QT_END_NAMESPACE
+
+#endif // QPROCESSPOOL_H
@@ -0,0 +1,155 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QPROCESSPOOL_P_H
+#define QPROCESSPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qprocesspool.h"
+
+QT_REQUIRE_CONFIG(process);
+QT_REQUIRE_CONFIG(thread);
+
+#include <private/qobject_p.h>
+
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qwaitcondition.h>
+
+QT_BEGIN_NAMESPACE
+
+class QThread;
+
+class QProcessPoolPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QProcessPool)
+
+public:
+    // Everything a launch needs, captured when the process is added so that
+    // later changes to the pool's settings only affect later processes.
+    struct Launch
+    {
+        int index;
+        QString program;
+        QStringList arguments;
+        QByteArray input;
+        QString workingDirectory;
+        QStringList environment;        // empty: inherit ours
+        QProcess::ProcessChannelMode channelMode;
+        qint64 bufferSize;
+    };
+
+    struct Result
+    {
+        int index = -1;
+        int exitCode = 0;
+        QProcess::ExitStatus exitStatus = QProcess::NormalExit;
+        QProcess::ProcessError error = QProcess::UnknownError;
+        QString errorString;
+        QByteArray standardOutput;
+        QByteArray standardError;
+    };
+
+    struct Job
+    {
+        Result result;
+        bool finished = false;
+    };
+
+    QProcessPoolPrivate();
+    ~QProcessPoolPrivate();
+
+    // platform dependent
+    void launch(Launch &&launch);
+    void killAll();
+    bool waitForResults(QDeadlineTimer deadline);
+    void concurrencyChanged();
+    void shutdown();
+
+    void postResult(Result &&result);
+    void _q_collectResults();
+
+    QList<Job> jobs;
+    int finished = 0;
+
+    QString workingDirectory;
+    QProcessEnvironment environment;
+    qint64 bufferSize = 0;
+    QProcess::ProcessChannelMode channelMode = QProcess::SeparateChannels;
+
+    // shared with the worker, guarded by mutex
+    QMutex mutex;
+    QWaitCondition resultsReady;
+    QList<Result> results;
+    QList<Launch> pending;
+    int maximumConcurrency;
+    bool collectPosted = false;
+
+#ifdef Q_OS_UNIX
+    void run();
+
+    QThread *worker = nullptr;
+    bool killRequested = false;
+    bool quitRequested = false;
+    int wakeUpPipe[2] = { -1, -1 };
+#else
+    void startPending();
+    void processFinished(QProcess *process);
+
+    QHash<QProcess *, int> running;
+#endif
+};
+
+QT_END_NAMESPACE
+
+#endif // QPROCESSPOOL_P_H
@@ -0,0 +1,516 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qplatformdefs.h"
+
+#include "qprocesspool.h"
+#include "qprocesspool_p.h"
+
+#include <private/qcore_unix_p.h>
+#include <private/qlocking_p.h>
+
+#include <qfile.h>
+#include <qstandardpaths.h>
+#include <qthread.h>
+
+#include <forkfd.h>
+
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+class QProcessPoolThread : public QThread
+{
+public:
+    explicit QProcessPoolThread(QProcessPoolPrivate *d)
+        : d(d)
+    {
+        setObjectName(QStringLiteral("QProcessPool"));
+    }
+
+protected:
+    void run() override { d->run(); }
+
+private:
+    QProcessPoolPrivate *d;
+};
+
+struct ChildError
+{
+    int code;
+    char function[8];
+};
+
+struct ChildArguments
+{
+    int stdinFd;
+    int stdoutFd;                       // -1: forwarded
+    int stderrFd;                       // -1: forwarded or merged
+    bool mergeChannels;
+    int startedPipe;
+    const char *workingDirectory;
+    char **argv;
+    char **envp;
+};
+
+struct Child
+{
+    int index;
+    pid_t pid = -1;
+    int forkfd = -1;
+    int stdinFd = -1;
+    int stdoutFd = -1;
+    int stderrFd = -1;
+    QByteArray input;
+    qint64 written = 0;
+    QByteArray standardOutput;
+    QByteArray standardError;
+};
+} // unnamed namespace
+
+// Runs in the child process, possibly sharing our memory (see vforkfd()),
+// so it must not allocate nor modify anything but its own stack.
+static int execChild(void *token)
+{
+    const auto args = static_cast<const ChildArguments *>(token);
+    ChildError error = { 0, {} };       // force zeroing of function[8]
+
+    ::signal(SIGPIPE, SIG_DFL);         // reset the signal that we ignored
+
+    qt_safe_dup2(args->stdinFd, STDIN_FILENO, 0);
+    if (args->stdoutFd != -1)
+        qt_safe_dup2(args->stdoutFd, STDOUT_FILENO, 0);
+    if (args->mergeChannels)
+        qt_safe_dup2(STDOUT_FILENO, STDERR_FILENO, 0);
+    else if (args->stderrFd != -1)
+        qt_safe_dup2(args->stderrFd, STDERR_FILENO, 0);
+
+    if (args->workingDirectory && QT_CHDIR(args->workingDirectory) == -1) {
+        strcpy(error.function, "chdir");
+    } else if (args->envp) {
+        qt_safe_execve(args->argv[0], args->argv, args->envp);
+        strcpy(error.function, "execve");
+    } else {
+        qt_safe_execv(args->argv[0], args->argv);
+        strcpy(error.function, "execvp");
+    }
+
+    error.code = errno;
+    qt_safe_write(args->startedPipe, &error, sizeof(error));
+    return -1;
+}
+
+static void closeFd(int &fd)
+{
+    if (fd != -1) {
+        qt_safe_close(fd);
+        fd = -1;
+    }
+}
+
+static void setNonBlocking(int fd)
+{
+    if (fd != -1)
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+static bool pollfdCheck(const pollfd &pfd, short revents)
+{
+    return pfd.fd >= 0 && (pfd.revents & (revents | POLLHUP | POLLERR | POLLNVAL)) != 0;
+}
+
+static bool startChild(const QProcessPoolPrivate::Launch &launch, Child *child,
+                       QString *errorString)
+{
+    QByteArray program = QFile::encodeName(launch.program);
+    if (!launch.program.contains(QLatin1Char('/'))) {
+        const QString exeFilePath = QStandardPaths::findExecutable(launch.program);
+        if (!exeFilePath.isEmpty())
+            program = QFile::encodeName(exeFilePath);
+    }
+
+    // Encode everything up front: the child may not allocate.
+    QByteArrayList encodedArguments;
+    encodedArguments.reserve(launch.arguments.size());
+    std::vector<char *> argv;
+    argv.reserve(launch.arguments.size() + 2);
+    argv.push_back(program.data());
+    for (const QString &argument : launch.arguments) {
+        encodedArguments.append(QFile::encodeName(argument));
+        argv.push_back(encodedArguments.last().data());
+    }
+    argv.push_back(nullptr);
+
+    QByteArrayList encodedEnvironment;
+    std::vector<char *> envp;
+    if (!launch.environment.isEmpty()) {
+        encodedEnvironment.reserve(launch.environment.size());
+        envp.reserve(launch.environment.size() + 1);
+        for (const QString &variable : launch.environment) {
+            encodedEnvironment.append(variable.toLocal8Bit());
+            envp.push_back(encodedEnvironment.last().data());
+        }
+        envp.push_back(nullptr);
+    }
+
+    const QByteArray workingDirectory = QFile::encodeName(launch.workingDirectory);
+
+    const QProcess::ProcessChannelMode mode = launch.channelMode;
+    const bool captureOutput = mode != QProcess::ForwardedChannels
+            && mode != QProcess::ForwardedOutputChannel;
+    const bool captureError = mode == QProcess::SeparateChannels
+            || mode == QProcess::ForwardedOutputChannel;
+
+    int stdinPipe[2] = { -1, -1 };
+    int stdoutPipe[2] = { -1, -1 };
+    int stderrPipe[2] = { -1, -1 };
+    int startedPipe[2] = { -1, -1 };
+    const auto closePipes = [&]() {
+        for (int *pipe : { stdinPipe, stdoutPipe, stderrPipe, startedPipe }) {
+            closeFd(pipe[0]);
+            closeFd(pipe[1]);
+        }
+    };
+
+    if (qt_safe_pipe(stdinPipe) != 0
+            || (captureOutput && qt_safe_pipe(stdoutPipe) != 0)
+            || (captureError && qt_safe_pipe(stderrPipe) != 0)
+            || qt_safe_pipe(startedPipe) != 0) {
+        *errorString = qt_error_string(errno);
+        closePipes();
+        return false;
+    }
+
+    ChildArguments arguments = {
+        stdinPipe[0], stdoutPipe[1], stderrPipe[1], mode == QProcess::MergedChannels,
+        startedPipe[1], workingDirectory.isEmpty() ? nullptr : workingDirectory.constData(),
+        argv.data(), envp.empty() ? nullptr : envp.data()
+    };
+    pid_t pid;
+    const int ffd = ::vforkfd(FFD_CLOEXEC, &pid, execChild, &arguments);
+    const int forkErrno = errno;
+
+    closeFd(stdinPipe[0]);
+    closeFd(stdoutPipe[1]);
+    closeFd(stderrPipe[1]);
+    closeFd(startedPipe[1]);
+
+    if (ffd == -1) {
+        *errorString = QProcessPool::tr("Resource error (fork failure): %1")
+                .arg(qt_error_string(forkErrno));
+        closePipes();
+        return false;
+    }
+
+    // Blocks until the child has called execve(), or failed to. With vfork
+    // semantics, it already has.
+    ChildError error;
+    const qint64 ret = qt_safe_read(startedPipe[0], &error, sizeof(error));
+    closeFd(startedPipe[0]);
+    if (ret > 0) {
+        *errorString = QLatin1String(error.function) + QLatin1String(": ")
+                + qt_error_string(error.code);
+        closePipes();
+        forkfd_info info;
+        int result;
+        EINTR_LOOP(result, forkfd_wait(ffd, &info, nullptr));
+        EINTR_LOOP(result, forkfd_close(ffd));
+        return false;
+    }
+
+    child->pid = pid;
+    child->forkfd = ffd;
+    child->stdinFd = stdinPipe[1];
+    child->stdoutFd = stdoutPipe[0];
+    child->stderrFd = stderrPipe[0];
+    child->input = launch.input;
+    if (child->input.isEmpty())
+        closeFd(child->stdinFd);
+
+    const int reserved = int(qMin<qint64>(launch.bufferSize, std::numeric_limits<int>::max() - 1));
+    if (captureOutput)
+        child->standardOutput.reserve(reserved);
+    if (captureError)
+        child->standardError.reserve(reserved);
+
+    setNonBlocking(child->stdinFd);
+    setNonBlocking(child->stdoutFd);
+    setNonBlocking(child->stderrFd);
+    return true;
+}
+
+// Reads from \a fd straight into the spare capacity of \a buffer, so that a
+// buffer reserved with QProcessPool::setOutputBufferSize() never needs an
+// intermediate copy. Unless \a drain is set, stops after a short read to
+// give the other children a turn.
+static void readChannel(int &fd, QByteArray &buffer, bool drain)
+{
+    while (fd != -1) {
+        const int size = buffer.size();
+        const int chunk = qMax(buffer.capacity() - size, 16384);
+        buffer.resize(size + chunk);
+        const qint64 ret = qt_safe_read(fd, buffer.data() + size, chunk);
+        buffer.resize(size + int(qMax<qint64>(ret, 0)));
+        if (ret == 0 || (ret < 0 && errno != EAGAIN))
+            closeFd(fd);
+        if (ret <= 0 || (ret < chunk && !drain))
+            return;
+    }
+}
+
+static void writeInput(Child &child)
+{
+    const qint64 ret = qt_safe_write_nosignal(child.stdinFd,
+                                              child.input.constData() + child.written,
+                                              child.input.size() - child.written);
+    if (ret < 0 && errno == EAGAIN)
+        return;
+    if (ret > 0)
+        child.written += ret;
+    if (ret < 0 || child.written == child.input.size()) {
+        closeFd(child.stdinFd);
+        child.input.clear();
+    }
+}
+
+static void wakeUp(int fd)
+{
+    const char c = 0;
+    qt_safe_write(fd, &c, 1);
+}
+
+/*
+    The worker thread: starts the queued programs, and multiplexes the
+    standard input, standard output, standard error and forkfd of every
+    running child in a single poll() call.
+*/
+void QProcessPoolPrivate::run()
+{
+    std::vector<Child> children;
+    std::vector<pollfd> pfds;
+    enum { WakeUp = 0, FirstChild = 1, FdsPerChild = 4 };
+
+    for (;;) {
+        QList<Launch> starting;
+        QList<Launch> cancelled;
+        bool kill;
+        bool quit;
+        {
+            const auto locker = qt_scoped_lock(mutex);
+            kill = std::exchange(killRequested, false);
+            quit = quitRequested;
+            if (kill)
+                cancelled.swap(pending);
+            while (!pending.isEmpty()
+                   && int(children.size()) + starting.size() < maximumConcurrency) {
+                starting.append(pending.takeFirst());
+            }
+        }
+
+        for (const Launch &launch : qAsConst(cancelled)) {
+            Result result;
+            result.index = launch.index;
+            result.error = QProcess::FailedToStart;
+            result.errorString = QProcessPool::tr("Process was killed before it started");
+            if (!quit)
+                postResult(std::move(result));
+        }
+
+        if (kill) {
+            for (const Child &child : children)
+                ::kill(child.pid, SIGKILL);
+        }
+
+        for (const Launch &launch : qAsConst(starting)) {
+            Child child;
+            child.index = launch.index;
+            Result result;
+            if (startChild(launch, &child, &result.errorString)) {
+                children.push_back(std::move(child));
+            } else {
+                result.index = launch.index;
+                result.error = QProcess::FailedToStart;
+                postResult(std::move(result));
+            }
+        }
+
+        if (quit && children.empty())
+            return;
+
+        pfds.clear();
+        pfds.push_back(qt_make_pollfd(wakeUpPipe[0], POLLIN));
+        for (const Child &child : children) {
+            pfds.push_back(qt_make_pollfd(child.stdinFd, POLLOUT));
+            pfds.push_back(qt_make_pollfd(child.stdoutFd, POLLIN));
+            pfds.push_back(qt_make_pollfd(child.stderrFd, POLLIN));
+            pfds.push_back(qt_make_pollfd(child.forkfd, POLLIN));
+        }
+
+        if (qt_poll_msecs(pfds.data(), nfds_t(pfds.size()), -1) < 0) {
+            qErrnoWarning("QProcessPool: poll() failed");
+            return;
+        }
+
+        if (pfds[WakeUp].revents) {
+            char buffer[64];
+            while (qt_safe_read(wakeUpPipe[0], buffer, sizeof(buffer)) > 0)
+                ;
+        }
+
+        auto pfd = pfds.cbegin() + FirstChild;
+        auto dead = std::remove_if(children.begin(), children.end(), [&](Child &child) {
+            const pollfd *fds = &*pfd;
+            pfd += FdsPerChild;
+
+            if (pollfdCheck(fds[0], POLLOUT))
+                writeInput(child);
+            if (pollfdCheck(fds[1], POLLIN))
+                readChannel(child.stdoutFd, child.standardOutput, false);
+            if (pollfdCheck(fds[2], POLLIN))
+                readChannel(child.stderrFd, child.standardError, false);
+            if (!pollfdCheck(fds[3], POLLIN))
+                return false;
+
+            // The child has exited: whatever it wrote is in the pipes now.
+            // Don't wait for end of file, its own children may keep them open.
+            readChannel(child.stdoutFd, child.standardOutput, true);
+            readChannel(child.stderrFd, child.standardError, true);
+            closeFd(child.stdoutFd);
+            closeFd(child.stderrFd);
+            closeFd(child.stdinFd);
+
+            forkfd_info info;
+            int ret;
+            EINTR_LOOP(ret, forkfd_wait(child.forkfd, &info, nullptr));
+            EINTR_LOOP(ret, forkfd_close(child.forkfd));
+
+            Result result;
+            result.index = child.index;
+            result.exitCode = info.status;
+            if (info.code != CLD_EXITED) {
+                result.exitStatus = QProcess::CrashExit;
+                result.error = QProcess::Crashed;
+                result.errorString = QProcessPool::tr("Process crashed");
+            }
+            result.standardOutput = std::move(child.standardOutput);
+            result.standardError = std::move(child.standardError);
+            if (!quit)
+                postResult(std::move(result));
+            return true;
+        });
+        children.erase(dead, children.end());
+    }
+}
+
+void QProcessPoolPrivate::launch(Launch &&launch)
+{
+    if (!worker) {
+        if (qt_safe_pipe(wakeUpPipe, O_NONBLOCK) != 0) {
+            Result result;
+            result.index = launch.index;
+            result.error = QProcess::FailedToStart;
+            result.errorString = qt_error_string(errno);
+            postResult(std::move(result));
+            return;
+        }
+        worker = new QProcessPoolThread(this);
+        worker->start();
+    }
+
+    {
+        const auto locker = qt_scoped_lock(mutex);
+        pending.append(std::move(launch));
+    }
+    wakeUp(wakeUpPipe[1]);
+}
+
+void QProcessPoolPrivate::killAll()
+{
+    if (!worker)
+        return;
+    {
+        const auto locker = qt_scoped_lock(mutex);
+        killRequested = true;
+    }
+    wakeUp(wakeUpPipe[1]);
+}
+
+void QProcessPoolPrivate::concurrencyChanged()
+{
+    if (worker)
+        wakeUp(wakeUpPipe[1]);
+}
+
+bool QProcessPoolPrivate::waitForResults(QDeadlineTimer deadline)
+{
+    const auto locker = qt_scoped_lock(mutex);
+    while (results.isEmpty()) {
+        if (!resultsReady.wait(&mutex, deadline))
+            return false;
+    }
+    return true;
+}
+
+void QProcessPoolPrivate::shutdown()
+{
+    if (!worker)
+        return;
+    {
+        const auto locker = qt_scoped_lock(mutex);
+        killRequested = true;
+        quitRequested = true;
+    }
+    wakeUp(wakeUpPipe[1]);
+    worker->wait();
+    delete worker;
+    worker = nullptr;
+    closeFd(wakeUpPipe[0]);
+    closeFd(wakeUpPipe[1]);
+}
+
+QT_END_NAMESPACE
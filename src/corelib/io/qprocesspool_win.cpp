@@ -0,0 +1,165 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qprocesspool.h"
+#include "qprocesspool_p.h"
+
+#include <private/qlocking_p.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Windows has no poll() on pipes; QProcess already multiplexes its pipes
+    with overlapped I/O and wait objects, so the pool just runs up to
+    maximumConcurrency QProcess objects at a time.
+*/
+
+void QProcessPoolPrivate::startPending()
+{
+    Q_Q(QProcessPool);
+    while (!pending.isEmpty() && running.size() < maximumConcurrency) {
+        const Launch launch = pending.takeFirst();
+
+        QProcess *process = new QProcess(q);
+        process->setProcessChannelMode(launch.channelMode);
+        if (!launch.workingDirectory.isEmpty())
+            process->setWorkingDirectory(launch.workingDirectory);
+        if (!launch.environment.isEmpty())
+            process->setEnvironment(launch.environment);
+        QObject::connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), q, [this, process]() {
+            processFinished(process);
+        });
+        QObject::connect(process, &QProcess::errorOccurred, q, [this, process](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart)
+                processFinished(process);
+        });
+        running.insert(process, launch.index);
+
+        process->start(launch.program, launch.arguments);
+        if (running.contains(process) && process->waitForStarted(-1)) {
+            if (!launch.input.isEmpty())
+                process->write(launch.input);
+            process->closeWriteChannel();
+        }
+    }
+}
+
+void QProcessPoolPrivate::processFinished(QProcess *process)
+{
+    const auto it = running.constFind(process);
+    if (it == running.cend())
+        return;
+
+    Result result;
+    result.index = it.value();
+    running.erase(it);
+    result.exitCode = process->exitCode();
+    result.exitStatus = process->exitStatus();
+    result.error = process->error();
+    if (result.error != QProcess::UnknownError)
+        result.errorString = process->errorString();
+    result.standardOutput = process->readAllStandardOutput();
+    result.standardError = process->readAllStandardError();
+    process->disconnect();
+    process->deleteLater();
+
+    postResult(std::move(result));
+    startPending();
+}
+
+void QProcessPoolPrivate::launch(Launch &&launch)
+{
+    pending.append(std::move(launch));
+    startPending();
+}
+
+void QProcessPoolPrivate::killAll()
+{
+    const QList<Launch> cancelled = std::exchange(pending, QList<Launch>());
+    for (const Launch &launch : cancelled) {
+        Result result;
+        result.index = launch.index;
+        result.error = QProcess::FailedToStart;
+        result.errorString = QProcessPool::tr("Process was killed before it started");
+        postResult(std::move(result));
+    }
+    const QList<QProcess *> processes = running.keys();
+    for (QProcess *process : processes)
+        process->kill();
+}
+
+void QProcessPoolPrivate::concurrencyChanged()
+{
+    startPending();
+}
+
+bool QProcessPoolPrivate::waitForResults(QDeadlineTimer deadline)
+{
+    for (;;) {
+        {
+            const auto locker = qt_scoped_lock(mutex);
+            if (!results.isEmpty())
+                return true;
+        }
+        if (running.isEmpty() || deadline.hasExpired())
+            return false;
+        // Finishing any process posts a result.
+        QProcess *process = running.firstKey();
+        const qint64 remaining = deadline.remainingTime();
+        process->waitForFinished(remaining < 0 ? -1 : int(qMin<qint64>(remaining, std::numeric_limits<int>::max())));
+    }
+}
+
+void QProcessPoolPrivate::shutdown()
+{
+    pending.clear();
+    const QList<QProcess *> processes = running.keys();
+    running.clear();
+    for (QProcess *process : processes) {
+        process->disconnect();
+        process->kill();
+        process->waitForFinished(-1);
+        delete process;
+    }
+}
+
+QT_END_NAMESPACE
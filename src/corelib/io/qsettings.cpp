@@ -939,7 +939,14 @@ void QConfFileSettingsPrivate::initFormat()
     caseSensitivity = IniCaseSensitivity;
 #endif
 
-    if (format > QSettings::IniFormat) {
+#ifndef QT_BOOTSTRAPPED
+    if (format == QSettings::IndexedFormat) {
+        extension = QLatin1String(".qsi");
+        caseSensitivity = Qt::CaseSensitive;
+    }
+#endif
+
+    if (format > QSettings::IniFormat && format != QSettings::IndexedFormat) {
         const auto locker = qt_scoped_lock(settingsGlobalMutex);
         const CustomFormatVector *customFormatVector = customFormatVectorFunc();
 
@@ -957,7 +964,7 @@ void QConfFileSettingsPrivate::initFormat()
 void QConfFileSettingsPrivate::initAccess()
 {
     if (!confFiles.isEmpty()) {
-        if (format > QSettings::IniFormat) {
+        if (format > QSettings::IniFormat && format != QSettings::IndexedFormat) {
             if (!readFunc)
                 setStatus(QSettings::AccessError);
         }
@@ -1261,6 +1268,16 @@ void QConfFileSettingsPrivate::remove(const QString &key)
     }
     if (confFile->originalKeys.contains(theKey))
         confFile->removedKeys.insert(theKey, QVariant());
+
+#ifndef QT_BOOTSTRAPPED
+    if (confFile->indexed) {
+        const QStringList keys = confFile->indexed->keys(prefix);
+        for (const QString &k : keys)
+            confFile->removedKeys.insert(QSettingsKey(k, caseSensitivity), QVariant());
+        if (confFile->indexed->contains(theKey))
+            confFile->removedKeys.insert(theKey, QVariant());
+    }
+#endif
 }
 
 void QConfFileSettingsPrivate::set(const QString &key, const QVariant &value)
@@ -1290,6 +1307,14 @@ bool QConfFileSettingsPrivate::get(const QString &key, QVariant *value) const
             j = confFile->addedKeys.constFind(theKey);
             found = (j != confFile->addedKeys.constEnd());
         }
+#ifndef QT_BOOTSTRAPPED
+        if (!found && confFile->indexed) {
+            if (!confFile->removedKeys.contains(theKey)
+                    && confFile->indexed->value(theKey, value)) {
+                return true;
+            }
+        } else
+#endif
         if (!found) {
             ensureSectionParsed(confFile, theKey);
             j = confFile->originalKeys.constFind(theKey);
@@ -1332,6 +1357,16 @@ QStringList QConfFileSettingsPrivate::children(const QString &prefix, ChildSpec
             ++j;
         }
 
+#ifndef QT_BOOTSTRAPPED
+        if (confFile->indexed) {
+            const QStringList keys = confFile->indexed->keys(thePrefix);
+            for (const QString &k : keys) {
+                if (!confFile->removedKeys.contains(QSettingsKey(k, caseSensitivity)))
+                    processChild(k.midRef(startPos), spec, result);
+            }
+        }
+#endif
+
         j = const_cast<const ParsedSettingsMap *>(
                 &confFile->addedKeys)->lowerBound(thePrefix);
         while (j != confFile->addedKeys.constEnd() && j.key().startsWith(thePrefix)) {
@@ -1360,6 +1395,14 @@ void QConfFileSettingsPrivate::clear()
     ensureAllSectionsParsed(confFile);
     confFile->addedKeys.clear();
     confFile->removedKeys = confFile->originalKeys;
+
+#ifndef QT_BOOTSTRAPPED
+    if (confFile->indexed) {
+        const QStringList keys = confFile->indexed->keys(QString());
+        for (const QString &k : keys)
+            confFile->removedKeys.insert(QSettingsKey(k, caseSensitivity), QVariant());
+    }
+#endif
 }
 
 void QConfFileSettingsPrivate::sync()
@@ -1389,7 +1432,7 @@ QString QConfFileSettingsPrivate::fileName() const
 
 bool QConfFileSettingsPrivate::isWritable() const
 {
-    if (format > QSettings::IniFormat && !writeFunc)
+    if (format > QSettings::IniFormat && format != QSettings::IndexedFormat && !writeFunc)
         return false;
 
     if (confFiles.isEmpty())
@@ -1400,6 +1443,18 @@ bool QConfFileSettingsPrivate::isWritable() const
 
 void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 {
+#ifndef QT_BOOTSTRAPPED
+    if (format == QSettings::IndexedFormat) {
+        syncIndexedFile(confFile);
+        return;
+    }
+    if (confFile->indexed) {
+        // the file was last used with IndexedFormat, so read it again
+        confFile->indexed.reset();
+        confFile->size = 0;
+    }
+#endif
+
     bool readOnly = confFile->addedKeys.isEmpty() && confFile->removedKeys.isEmpty();
 
     /*
@@ -1564,6 +1619,71 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
     }
 }
 
+#ifndef QT_BOOTSTRAPPED
+/*
+    IndexedFormat files are never parsed as a whole. Syncing reads only the
+    records other processes appended since the last sync (or maps the file
+    again if one of them compacted it), and then appends our own changes.
+*/
+void QConfFileSettingsPrivate::syncIndexedFile(QConfFile *confFile)
+{
+    bool readOnly = confFile->addedKeys.isEmpty() && confFile->removedKeys.isEmpty();
+
+    if (!confFile->indexed) {
+        // the file may have been read in another format before
+        confFile->unparsedIniSections.clear();
+        confFile->originalKeys.clear();
+        confFile->indexed.reset(new QIndexedSettingsFile);
+    } else if (readOnly && confFile->size > 0) {
+        QFileInfo fileInfo(confFile->name);
+        if (confFile->size == fileInfo.size() && confFile->timeStamp == fileInfo.lastModified())
+            return;
+    }
+
+    if (!readOnly && !confFile->isWritable()) {
+        setStatus(QSettings::AccessError);
+        return;
+    }
+
+    QLockFile lockFile(confFile->name + QLatin1String(".lock"));
+    if (!readOnly && !lockFile.lock() && atomicSyncOnly) {
+        setStatus(QSettings::AccessError);
+        return;
+    }
+
+    QFileInfo fileInfo(confFile->name);
+    const bool createFile = !fileInfo.exists();
+    if (!createFile && !fileInfo.isReadable()) {
+        setStatus(QSettings::AccessError);
+        return;
+    }
+
+    if (!confFile->indexed->refresh(confFile->name))
+        setStatus(QSettings::FormatError);
+
+    if (!readOnly) {
+        if (!confFile->indexed->write(confFile->name, confFile->addedKeys,
+                                      confFile->removedKeys)) {
+            setStatus(QSettings::AccessError);
+            return;
+        }
+        confFile->addedKeys.clear();
+        confFile->removedKeys.clear();
+
+        fileInfo.refresh();
+        if (createFile) {
+            QFile::Permissions perms = fileInfo.permissions() | QFile::ReadOwner | QFile::WriteOwner;
+            if (!confFile->userPerms)
+                perms |= QFile::ReadGroup | QFile::ReadOther;
+            QFile(confFile->name).setPermissions(perms);
+        }
+    }
+
+    confFile->size = fileInfo.size();
+    confFile->timeStamp = fileInfo.lastModified();
+}
+#endif // QT_BOOTSTRAPPED
+
 enum { Space = 0x1, Special = 0x2 };
 
 static const char charTraits[256] =
@@ -2459,6 +2579,10 @@ void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
     \value IniFormat        Store the settings in INI files. Note that type information
                             is not preserved when reading settings from INI files;
                             all values will be returned as QString.
+    \value IndexedFormat    Store the settings in a binary file with the
+                            \c .qsi extension that is indexed by key. Type
+                            information is preserved. This enum value was
+                            added in Qt 6.0.
 
     \value InvalidFormat    Special value returned by registerFormat().
     \omitvalue CustomFormat1
@@ -2524,6 +2648,14 @@ void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
         potentially less compatible), call setIniCodec().
     \endlist
 
+    IndexedFormat is meant for large settings files shared by many
+    processes. The file is memory mapped and keys are looked up with a
+    binary search, so opening it doesn't parse it. sync() appends the
+    changed keys to the end of the file instead of rewriting it, and
+    rewrites it in sorted form only once the appended part has grown
+    large. Other processes notice the change on their next sync() and read
+    only the appended part. Keys are case sensitive on all platforms.
+
     \sa registerFormat(), setPath()
 */
 
@@ -0,0 +1,433 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsettings.h"
+
+#include "qsettings_p.h"
+#include "qdatastream.h"
+#include "qendian.h"
+#include "qfile.h"
+#include "qrandom.h"
+#if QT_CONFIG(temporaryfile)
+#include "qsavefile.h"
+#endif
+
+#include <limits>
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Layout of an IndexedFormat file, all integers little endian:
+
+    header:  char magic[8] "QtSetIdx", quint32 version, quint32 entryCount,
+             quint64 generation, quint64 logStart
+    entries: entryCount x { quint32 keyOffset, quint32 keySize,
+                            quint32 valueOffset, quint32 valueSize },
+             sorted by the UTF-8 bytes of the key
+    blob:    the keys and the QDataStream serialized values
+    log:     from logStart to the end of the file, records of
+             { quint8 type, quint32 keySize, quint32 valueSize, key, value }
+
+    The generation is picked at random whenever the file is rewritten, which
+    is how a reader tells a compacted file from one that was appended to.
+*/
+
+static const char indexedMagic[8] = { 'Q', 't', 'S', 'e', 't', 'I', 'd', 'x' };
+
+enum : quint32 { IndexedVersion = 1 };
+enum : qint64 {
+    HeaderSize = 32,
+    EntrySize = 16,
+    RecordHeaderSize = 9,
+    MinCompactionLogSize = 64 * 1024
+};
+enum RecordType : uchar { SetRecord = 1, RemoveRecord = 2 };
+
+static inline QByteArray serializedValue(const QVariant &value)
+{
+    QByteArray result;
+    QDataStream out(&result, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_15);
+    out << value;
+    return result;
+}
+
+static inline void appendRecord(QByteArray &records, RecordType type, const QString &key,
+                                const QByteArray &value)
+{
+    const QByteArray utf8 = key.toUtf8();
+    uchar header[RecordHeaderSize];
+    header[0] = type;
+    qToLittleEndian<quint32>(utf8.size(), header + 1);
+    qToLittleEndian<quint32>(value.size(), header + 5);
+    records.append(reinterpret_cast<const char *>(header), RecordHeaderSize);
+    records.append(utf8);
+    records.append(value);
+}
+
+QIndexedSettingsFile::QIndexedSettingsFile()
+    : data(nullptr), dataSize(0), fileGeneration(0), logStart(0), logEnd(0)
+{
+}
+
+QIndexedSettingsFile::~QIndexedSettingsFile()
+{
+}
+
+void QIndexedSettingsFile::reset()
+{
+    log.clear();
+    file.reset();
+    buffer.clear();
+    data = nullptr;
+    dataSize = 0;
+    fileGeneration = 0;
+    logStart = 0;
+    logEnd = 0;
+}
+
+/*
+    Brings the view up to date with \a fileName. Returns \c false if the
+    file exists but isn't an IndexedFormat file; it's then treated as empty.
+*/
+bool QIndexedSettingsFile::refresh(const QString &fileName)
+{
+    QScopedPointer<QFile> newFile(new QFile(fileName));
+    if (!newFile->open(QIODevice::ReadOnly)) {
+        reset();
+        return !newFile->exists();
+    }
+
+    const qint64 size = newFile->size();
+    if (size == 0) {
+        reset();
+        return true;
+    }
+
+    uchar header[HeaderSize];
+    if (newFile->read(reinterpret_cast<char *>(header), HeaderSize) != HeaderSize) {
+        reset();
+        return false;
+    }
+
+    const quint64 generation = qFromLittleEndian<quint64>(header + 16);
+    if (!data || generation != fileGeneration || size < logEnd)
+        return load(newFile.take(), size);
+
+    // Same file as before, so the table is unchanged. Only read what other
+    // processes appended to the log since.
+    if (size > logEnd && newFile->seek(logEnd)) {
+        const QByteArray tail = newFile->read(size - logEnd);
+        logEnd += parseLog(tail.constData(), tail.size());
+    }
+    return true;
+}
+
+bool QIndexedSettingsFile::load(QFile *newFile, qint64 size)
+{
+    reset();
+    file.reset(newFile);
+
+#ifndef Q_OS_WIN
+    // Windows can't replace a file that is mapped, which compaction needs
+    data = file->map(0, size);
+#endif
+    if (data) {
+        dataSize = size;
+    } else {
+        if (file->seek(0))
+            buffer = file->read(size);
+        file.reset();
+        data = reinterpret_cast<const uchar *>(buffer.constData());
+        dataSize = buffer.size();
+    }
+
+    if (dataSize < HeaderSize || memcmp(data, indexedMagic, sizeof(indexedMagic)) != 0
+            || qFromLittleEndian<quint32>(data + 8) != IndexedVersion) {
+        reset();
+        return false;
+    }
+
+    const qint64 count = qFromLittleEndian<quint32>(data + 12);
+    fileGeneration = qFromLittleEndian<quint64>(data + 16);
+    logStart = qint64(qFromLittleEndian<quint64>(data + 24));
+    if (logStart < HeaderSize + count * EntrySize || logStart > dataSize) {
+        reset();
+        return false;
+    }
+
+    logEnd = logStart + parseLog(reinterpret_cast<const char *>(data) + logStart,
+                                 dataSize - logStart);
+    return true;
+}
+
+/*
+    Applies the complete records in \a records to the log and returns the
+    number of bytes they take. A torn record at the end, left by a writer
+    that is still appending or that died doing so, is not consumed.
+*/
+qint64 QIndexedSettingsFile::parseLog(const char *records, qint64 size)
+{
+    qint64 pos = 0;
+    while (size - pos >= RecordHeaderSize) {
+        const uchar *header = reinterpret_cast<const uchar *>(records + pos);
+        const qint64 keySize = qFromLittleEndian<quint32>(header + 1);
+        const qint64 valueSize = qFromLittleEndian<quint32>(header + 5);
+        if (size - pos - RecordHeaderSize < keySize + valueSize)
+            break;
+
+        const char *key = records + pos + RecordHeaderSize;
+        if (header[0] == SetRecord)
+            log.insert(QString::fromUtf8(key, keySize), QByteArray(key + keySize, valueSize));
+        else if (header[0] == RemoveRecord)
+            log.insert(QString::fromUtf8(key, keySize), QByteArray());
+        else
+            break;
+        pos += RecordHeaderSize + keySize + valueSize;
+    }
+    return pos;
+}
+
+/*
+    Writes the changes to \a fileName. Must be called with the file locked,
+    right after refresh().
+*/
+bool QIndexedSettingsFile::write(const QString &fileName, const ParsedSettingsMap &addedKeys,
+                                 const ParsedSettingsMap &removedKeys)
+{
+    QByteArray records;
+    for (auto it = removedKeys.cbegin(), end = removedKeys.cend(); it != end; ++it) {
+        if (contains(it.key()))
+            appendRecord(records, RemoveRecord, it.key(), QByteArray());
+    }
+    for (auto it = addedKeys.cbegin(), end = addedKeys.cend(); it != end; ++it)
+        appendRecord(records, SetRecord, it.key(), serializedValue(it.value()));
+
+    if (records.isEmpty())
+        return true;
+
+    if (data && logSize() + records.size() <= qMax<qint64>(MinCompactionLogSize, logStart / 2))
+        return append(fileName, records);
+
+    parseLog(records.constData(), records.size());
+    return compact(fileName);
+}
+
+bool QIndexedSettingsFile::append(const QString &fileName, const QByteArray &records)
+{
+    QFile f(fileName);
+    if (!f.open(QIODevice::ReadWrite))
+        return false;
+
+    // Drop a torn record left by a writer that died while appending
+    if (f.size() != logEnd && !f.resize(logEnd))
+        return false;
+    if (!f.seek(logEnd) || f.write(records) != records.size() || !f.flush())
+        return false;
+
+    logEnd += parseLog(records.constData(), records.size());
+    return true;
+}
+
+bool QIndexedSettingsFile::compact(const QString &fileName)
+{
+    QByteArray contents;
+    {
+        QMap<QByteArray, QByteArray> entries;
+        for (int i = 0, n = entryCount(); i < n; ++i)
+            entries.insert(entryKey(i), entryValue(i));
+        for (auto it = log.cbegin(), end = log.cend(); it != end; ++it) {
+            if (it->isNull())
+                entries.remove(it.key().toUtf8());
+            else
+                entries.insert(it.key().toUtf8(), *it);
+        }
+
+        qint64 totalSize = HeaderSize + entries.size() * EntrySize;
+        for (auto it = entries.cbegin(), end = entries.cend(); it != end; ++it)
+            totalSize += it.key().size() + it->size();
+        if (totalSize > std::numeric_limits<quint32>::max())
+            return false;
+
+        quint64 generation;
+        do {
+            generation = QRandomGenerator::global()->generate64();
+        } while (generation == 0 || generation == fileGeneration);
+
+        contents.resize(int(totalSize));
+        uchar *out = reinterpret_cast<uchar *>(contents.data());
+        memcpy(out, indexedMagic, sizeof(indexedMagic));
+        qToLittleEndian<quint32>(IndexedVersion, out + 8);
+        qToLittleEndian<quint32>(entries.size(), out + 12);
+        qToLittleEndian<quint64>(generation, out + 16);
+        qToLittleEndian<quint64>(totalSize, out + 24);
+
+        uchar *entry = out + HeaderSize;
+        quint32 offset = HeaderSize + entries.size() * EntrySize;
+        for (auto it = entries.cbegin(), end = entries.cend(); it != end; ++it) {
+            qToLittleEndian<quint32>(offset, entry);
+            qToLittleEndian<quint32>(it.key().size(), entry + 4);
+            memcpy(out + offset, it.key().constData(), it.key().size());
+            offset += it.key().size();
+            qToLittleEndian<quint32>(offset, entry + 8);
+            qToLittleEndian<quint32>(it->size(), entry + 12);
+            memcpy(out + offset, it->constData(), it->size());
+            offset += it->size();
+            entry += EntrySize;
+        }
+    }
+
+    // Other processes may have the file mapped, so it must be replaced, never
+    // truncated and rewritten in place.
+#if QT_CONFIG(temporaryfile)
+    QSaveFile sf(fileName);
+    sf.setDirectWriteFallback(false);
+    bool ok = sf.open(QIODevice::WriteOnly) && sf.write(contents) == contents.size()
+              && sf.commit();
+#else
+    QFile sf(fileName);
+    bool ok = sf.open(QIODevice::WriteOnly) && sf.write(contents) == contents.size();
+    sf.close();
+#endif
+    if (!ok) {
+        reset();
+        return false;
+    }
+    return refresh(fileName);
+}
+
+int QIndexedSettingsFile::entryCount() const
+{
+    return data ? int(qFromLittleEndian<quint32>(data + 12)) : 0;
+}
+
+QByteArray QIndexedSettingsFile::entryKey(int i) const
+{
+    const uchar *entry = data + HeaderSize + qint64(i) * EntrySize;
+    const qint64 offset = qFromLittleEndian<quint32>(entry);
+    const qint64 size = qFromLittleEndian<quint32>(entry + 4);
+    if (offset + size > logStart)
+        return QByteArray();
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(data) + offset, int(size));
+}
+
+QByteArray QIndexedSettingsFile::entryValue(int i) const
+{
+    const uchar *entry = data + HeaderSize + qint64(i) * EntrySize;
+    const qint64 offset = qFromLittleEndian<quint32>(entry + 8);
+    const qint64 size = qFromLittleEndian<quint32>(entry + 12);
+    if (offset + size > logStart)
+        return QByteArray();
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(data) + offset, int(size));
+}
+
+int QIndexedSettingsFile::lowerBound(const QByteArray &key) const
+{
+    int first = 0;
+    int count = entryCount();
+    while (count > 0) {
+        const int step = count / 2;
+        if (entryKey(first + step) < key) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
+}
+
+bool QIndexedSettingsFile::findEntry(const QString &key, QByteArray *value) const
+{
+    const auto it = log.constFind(key);
+    if (it != log.constEnd()) {
+        *value = *it;
+        return !it->isNull();
+    }
+
+    const QByteArray utf8 = key.toUtf8();
+    const int i = lowerBound(utf8);
+    if (i == entryCount() || entryKey(i) != utf8)
+        return false;
+    *value = entryValue(i);
+    return true;
+}
+
+bool QIndexedSettingsFile::contains(const QString &key) const
+{
+    QByteArray bytes;
+    return findEntry(key, &bytes);
+}
+
+bool QIndexedSettingsFile::value(const QString &key, QVariant *value) const
+{
+    QByteArray bytes;
+    if (!findEntry(key, &bytes))
+        return false;
+    if (value) {
+        QDataStream in(bytes);
+        in.setVersion(QDataStream::Qt_5_15);
+        in >> *value;
+    }
+    return true;
+}
+
+QStringList QIndexedSettingsFile::keys(const QString &prefix) const
+{
+    QStringList result;
+    const QByteArray utf8 = prefix.toUtf8();
+    for (int i = lowerBound(utf8), n = entryCount(); i < n; ++i) {
+        const QByteArray key = entryKey(i);
+        if (!key.startsWith(utf8))
+            break;
+        QString name = QString::fromUtf8(key);
+        if (!log.contains(name))
+            result.append(std::move(name));
+    }
+
+    for (auto it = log.lowerBound(prefix), end = log.cend();
+         it != end && it.key().startsWith(prefix); ++it) {
+        if (!it->isNull())
+            result.append(it.key());
+    }
+    return result;
+}
+
+QT_END_NAMESPACE
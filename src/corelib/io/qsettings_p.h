@@ -148,6 +148,59 @@ inline QString QSettingsGroup::toString() const
     return result;
 }
 
+#ifndef QT_BOOTSTRAPPED
+class QFile;
+
+/*
+    The storage behind QSettings::IndexedFormat. A file starts with a table
+    of entries sorted by their UTF-8 key, which is memory mapped and searched
+    in place, and is followed by a log of set and remove records appended by
+    later syncs. Only the log is ever parsed; once it grows too large the
+    whole file is rewritten as a new table.
+*/
+class Q_AUTOTEST_EXPORT QIndexedSettingsFile
+{
+public:
+    QIndexedSettingsFile();
+    ~QIndexedSettingsFile();
+
+    bool refresh(const QString &fileName);
+    bool write(const QString &fileName, const ParsedSettingsMap &addedKeys,
+               const ParsedSettingsMap &removedKeys);
+
+    bool contains(const QString &key) const;
+    bool value(const QString &key, QVariant *value) const;
+    QStringList keys(const QString &prefix) const;
+
+    quint64 generation() const { return fileGeneration; }
+    qint64 logSize() const { return logEnd - logStart; }
+
+private:
+    void reset();
+    bool load(QFile *newFile, qint64 size);
+    qint64 parseLog(const char *records, qint64 size);
+    bool append(const QString &fileName, const QByteArray &records);
+    bool compact(const QString &fileName);
+
+    int entryCount() const;
+    QByteArray entryKey(int i) const;
+    QByteArray entryValue(int i) const;
+    int lowerBound(const QByteArray &key) const;
+    bool findEntry(const QString &key, QByteArray *value) const;
+
+    QScopedPointer<QFile> file;
+    QByteArray buffer;
+    const uchar *data;
+    qint64 dataSize;
+    quint64 fileGeneration;
+    qint64 logStart;
+    qint64 logEnd;
+    QMap<QString, QByteArray> log;  // a null value marks a removed key
+
+    Q_DISABLE_COPY(QIndexedSettingsFile)
+};
+#endif // QT_BOOTSTRAPPED
+
 class Q_AUTOTEST_EXPORT QConfFile
 {
 public:
@@ -166,6 +219,9 @@ public:
     ParsedSettingsMap originalKeys;
     ParsedSettingsMap addedKeys;
     ParsedSettingsMap removedKeys;
+#ifndef QT_BOOTSTRAPPED
+    QScopedPointer<QIndexedSettingsFile> indexed;
+#endif
     QAtomicInt ref;
     QMutex mutex;
     bool userPerms;
@@ -283,6 +339,9 @@ private:
     void initFormat();
     void initAccess();
     void syncConfFile(QConfFile *confFile);
+#ifndef QT_BOOTSTRAPPED
+    void syncIndexedFile(QConfFile *confFile);
+#endif
     bool writeIniFile(QIODevice &device, const ParsedSettingsMap &map);
 #ifdef Q_OS_MAC
     bool readPlistFile(const QByteArray &data, ParsedSettingsMap *map) const;
@@ -1391,30 +1391,19 @@ inline void QUrlPrivate::parse(const QString &url, QUrl::ParsingMode parsingMode
     flags = 0;
     clearError();
 
-    // find the important delimiters
-    int colon = -1;
-    int question = -1;
-    int hash = -1;
+    // find the important delimiters: the first '#', the first '?' before it
+    // and the first ':' before that
     const int len = url.length();
     const QChar *const begin = url.constData();
     const ushort *const data = reinterpret_cast<const ushort *>(begin);
+    const auto find = [data](int end, ushort ch) {
+        const ushort *found = QtPrivate::qustrchr(QStringView(data, end), ch);
+        return found == data + end ? -1 : int(found - data);
+    };
 
-    for (int i = 0; i < len; ++i) {
-        uint uc = data[i];
-        if (uc == '#' && hash == -1) {
-            hash = i;
-
-            // nothing more to be found
-            break;
-        }
-
-        if (question == -1) {
-            if (uc == ':' && colon == -1)
-                colon = i;
-            else if (uc == '?')
-                question = i;
-        }
-    }
+    const int hash = find(len, '#');
+    const int question = find(hash == -1 ? len : hash, '?');
+    const int colon = find(question != -1 ? question : hash != -1 ? hash : len, ':');
 
     // check if we have a scheme
     int hierStart;
@@ -1429,41 +1418,54 @@ inline void QUrlPrivate::parse(const QString &url, QUrl::ParsingMode parsingMode
 
     int pathStart;
     int hierEnd = qMin<uint>(qMin<uint>(question, hash), len);
-    if (hierEnd - hierStart >= 2 && data[hierStart] == '/' && data[hierStart + 1] == '/') {
+    const bool hasAuthority = hierEnd - hierStart >= 2 && data[hierStart] == '/' && data[hierStart + 1] == '/';
+    if (hasAuthority) {
         // we have an authority, it ends at the first slash after these
-        int authorityEnd = hierEnd;
-        for (int i = hierStart + 2; i < authorityEnd ; ++i) {
-            if (data[i] == '/') {
-                authorityEnd = i;
-                break;
-            }
-        }
+        const ushort *slash = QtPrivate::qustrchr(QStringView(data + hierStart + 2, data + hierEnd), '/');
+        int authorityEnd = int(slash - data);
 
         setAuthority(url, hierStart + 2, authorityEnd, parsingMode);
 
         // even if we failed to set the authority properly, let's try to recover
         pathStart = authorityEnd;
-        setPath(url, pathStart, hierEnd);
     } else {
         userName.clear();
         password.clear();
         host.clear();
         port = -1;
         pathStart = hierStart;
+    }
 
-        if (hierStart < hierEnd)
-            setPath(url, hierStart, hierEnd);
+    // Most URLs have nothing to recode or to reject after the authority. If
+    // so, store the components as they are and skip the strict-mode checks.
+    const bool plain = qt_urlFindNonPlainCharacter(begin + pathStart, begin + len) == begin + len;
+    if (plain) {
+        if (hasAuthority || pathStart < hierEnd)
+            path = url.mid(pathStart, hierEnd - pathStart);
+        else
+            path.clear();
+        if (uint(question) < uint(hash)) {
+            sectionIsPresent |= Query;
+            query = url.mid(question + 1, qMin<uint>(hash, len) - question - 1);
+        }
+        if (hash != -1) {
+            sectionIsPresent |= Fragment;
+            fragment = url.mid(hash + 1);
+        }
+    } else {
+        if (hasAuthority || pathStart < hierEnd)
+            setPath(url, pathStart, hierEnd);
         else
             path.clear();
-    }
 
-    if (uint(question) < uint(hash))
-        setQuery(url, question + 1, qMin<uint>(hash, len));
+        if (uint(question) < uint(hash))
+            setQuery(url, question + 1, qMin<uint>(hash, len));
 
-    if (hash != -1)
-        setFragment(url, hash + 1, len);
+        if (hash != -1)
+            setFragment(url, hash + 1, len);
+    }
 
-    if (error || parsingMode == QUrl::TolerantMode)
+    if (plain || error || parsingMode == QUrl::TolerantMode)
         return;
 
     // The parsing so far was partially tolerant of errors, except for the
@@ -3468,6 +3470,34 @@ QUrl QUrl::fromEncoded(const QByteArray &input, ParsingMode mode)
     return QUrl(QString::fromUtf8(input.constData(), input.size()), mode);
 }
 
+/*!
+    \since 6.0
+
+    Returns a string representation of the URL in UTF-8. The output can be
+    customized by passing flags with \a options; it is the same text as
+    toString() returns.
+
+    \sa fromUtf8String(), toString(), toEncoded()
+*/
+QUtf8String QUrl::toUtf8String(FormattingOptions options) const
+{
+    return QUtf8String(toString(options));
+}
+
+/*!
+    \since 6.0
+
+    Parses the UTF-8 string \a url using \a mode and returns the
+    corresponding QUrl. Unlike fromEncoded(), \a url may contain non-ASCII
+    characters, as in the URLs found in UTF-8 documents and protocols.
+
+    \sa toUtf8String(), setUrl()
+*/
+QUrl QUrl::fromUtf8String(const QUtf8String &url, ParsingMode mode)
+{
+    return QUrl(url.toString(), mode);
+}
+
 /*!
     Returns a decoded copy of \a input. \a input is first decoded from
     percent encoding, then converted from UTF-8 to unicode.
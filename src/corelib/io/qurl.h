@@ -44,6 +44,7 @@
 #include <QtCore/qbytearray.h>
 #include <QtCore/qobjectdefs.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qutf8string.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qpair.h>
 #include <QtCore/qglobal.h>
@@ -198,6 +199,8 @@ public:
 
     QByteArray toEncoded(FormattingOptions options = FullyEncoded) const;
     static QUrl fromEncoded(const QByteArray &url, ParsingMode mode = TolerantMode);
+    QUtf8String toUtf8String(FormattingOptions options = FormattingOptions(PrettyDecoded)) const;
+    static QUrl fromUtf8String(const QUtf8String &url, ParsingMode mode = TolerantMode);
 
     enum UserInputResolutionOption {
         DefaultResolution,
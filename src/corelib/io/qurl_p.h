@@ -60,6 +60,7 @@ QT_BEGIN_NAMESPACE
 // in qurlrecode.cpp
 extern Q_AUTOTEST_EXPORT int qt_urlRecode(QString &appendTo, const QChar *begin, const QChar *end,
                                           QUrl::ComponentFormattingOptions encoding, const ushort *tableModifications = nullptr);
+extern Q_AUTOTEST_EXPORT const QChar *qt_urlFindNonPlainCharacter(const QChar *begin, const QChar *end) noexcept;
 
 // in qurlidna.cpp
 enum AceLeadingDot { AllowLeadingDot, ForbidLeadingDot };
@@ -691,6 +691,78 @@ qt_urlRecode(QString &appendTo, const QChar *begin, const QChar *end,
                   encoding, actionTable, false);
 }
 
+static inline bool isPlainCharacter(ushort c)
+{
+    if (c <= 0x20U || c == 0x7fU)
+        return false;
+    switch (c) {
+    case '"':
+    case '%':
+    case '<':
+    case '>':
+    case '\\':
+    case '^':
+    case '`':
+    case '{':
+    case '|':
+    case '}':
+        return false;
+    }
+    return true;
+}
+
+/*!
+    \internal
+    \since 6.0
+
+    Returns a pointer to the first character between \a begin and \a end that
+    qt_urlRecode() may have to transform when it recodes a path, query or
+    fragment for storage, or that QUrl's strict mode rejects in them. Those
+    are the control characters, the space, the percent sign and the
+    characters that must always appear encoded. Returns \a end if there is no
+    such character, in which case the range can be stored unchanged.
+*/
+Q_AUTOTEST_EXPORT const QChar *
+qt_urlFindNonPlainCharacter(const QChar *begin, const QChar *end) noexcept
+{
+    const ushort *input = reinterpret_cast<const ushort *>(begin);
+    const ushort *const e = reinterpret_cast<const ushort *>(end);
+
+#ifdef __SSE2__
+    const __m128i spaces = _mm_set1_epi16(' ');
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; e - input >= 8; input += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+
+        // control characters and the space: the saturated subtraction gives zero
+        __m128i found = _mm_cmpeq_epi16(_mm_subs_epu16(data, spaces), zero);
+
+        // '<' and '>', '\\' and '^' only differ from each other in bit 1
+        const __m128i bit1 = _mm_or_si128(data, _mm_set1_epi16(2));
+        found = _mm_or_si128(found, _mm_cmpeq_epi16(bit1, _mm_set1_epi16('>')));
+        found = _mm_or_si128(found, _mm_cmpeq_epi16(bit1, _mm_set1_epi16('^')));
+
+        found = _mm_or_si128(found, _mm_cmpeq_epi16(data, _mm_set1_epi16('"')));
+        found = _mm_or_si128(found, _mm_cmpeq_epi16(data, _mm_set1_epi16('%')));
+        found = _mm_or_si128(found, _mm_cmpeq_epi16(data, _mm_set1_epi16('`')));
+        found = _mm_or_si128(found, _mm_cmpeq_epi16(data, _mm_set1_epi16('{')));
+        found = _mm_or_si128(found, _mm_cmpeq_epi16(data, _mm_set1_epi16('|')));
+        found = _mm_or_si128(found, _mm_cmpeq_epi16(data, _mm_set1_epi16('}')));
+        found = _mm_or_si128(found, _mm_cmpeq_epi16(data, _mm_set1_epi16(0x7f)));
+
+        const uint mask = _mm_movemask_epi8(found);
+        if (mask)
+            return reinterpret_cast<const QChar *>(input + qCountTrailingZeroBits(mask) / 2);
+    }
+#endif
+
+    for ( ; input != e; ++input) {
+        if (!isPlainCharacter(*input))
+            break;
+    }
+    return reinterpret_cast<const QChar *>(input);
+}
+
 // qstring.cpp
 bool qt_is_ascii(const char *&ptr, const char *end) noexcept;
 
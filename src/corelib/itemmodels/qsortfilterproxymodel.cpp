@@ -44,6 +44,7 @@
 #include <qdatetime.h>
 #include <qpair.h>
 #include <qstringlist.h>
+#include <qscopeguard.h>
 #include <private/qabstractitemmodel_p.h>
 #include <private/qabstractproxymodel_p.h>
 
@@ -67,18 +68,45 @@ static inline QSet<int> qVectorToSet(const QVector<int> &vector)
     return {vector.begin(), vector.end()};
 }
 
+// in qstring.cpp
+extern bool qt_localeAwareSortKey(QStringView string, QByteArray *key);
+
+/*
+    Locale-aware sort keys of the rows being sorted by sort_source_rows(), so
+    that each row's data is fetched and collated only once per sort rather
+    than in each of the O(n log n) comparisons. The comparison functors record
+    the pair of indexes they pass to lessThan(), which only uses the cached
+    keys when asked to compare exactly that pair; an overriding lessThan() that
+    compares other indexes always gets the uncached behavior.
+*/
+struct QSortFilterProxyModelSortKeyCache
+{
+    enum State : uchar { Unknown, Cached, NotCached };
+
+    QVector<QByteArray> keys; // indexed by source row
+    QVector<uchar> states;
+    QModelIndex left;
+    QModelIndex right;
+};
+
 class QSortFilterProxyModelLessThan
 {
 public:
     inline QSortFilterProxyModelLessThan(int column, const QModelIndex &parent,
                                        const QAbstractItemModel *source,
-                                       const QSortFilterProxyModel *proxy)
-        : sort_column(column), source_parent(parent), source_model(source), proxy_model(proxy) {}
+                                       const QSortFilterProxyModel *proxy,
+                                       QSortFilterProxyModelSortKeyCache *cache = nullptr)
+        : sort_column(column), source_parent(parent), source_model(source), proxy_model(proxy),
+          sort_key_cache(cache) {}
 
     inline bool operator()(int r1, int r2) const
     {
         QModelIndex i1 = source_model->index(r1, sort_column, source_parent);
         QModelIndex i2 = source_model->index(r2, sort_column, source_parent);
+        if (sort_key_cache) {
+            sort_key_cache->left = i1;
+            sort_key_cache->right = i2;
+        }
         return proxy_model->lessThan(i1, i2);
     }
 
@@ -87,6 +115,7 @@ private:
     QModelIndex source_parent;
     const QAbstractItemModel *source_model;
     const QSortFilterProxyModel *proxy_model;
+    QSortFilterProxyModelSortKeyCache *sort_key_cache;
 };
 
 class QSortFilterProxyModelGreaterThan
@@ -94,14 +123,19 @@ class QSortFilterProxyModelGreaterThan
 public:
     inline QSortFilterProxyModelGreaterThan(int column, const QModelIndex &parent,
                                           const QAbstractItemModel *source,
-                                          const QSortFilterProxyModel *proxy)
+                                          const QSortFilterProxyModel *proxy,
+                                          QSortFilterProxyModelSortKeyCache *cache = nullptr)
         : sort_column(column), source_parent(parent),
-          source_model(source), proxy_model(proxy) {}
+          source_model(source), proxy_model(proxy), sort_key_cache(cache) {}
 
     inline bool operator()(int r1, int r2) const
     {
         QModelIndex i1 = source_model->index(r1, sort_column, source_parent);
         QModelIndex i2 = source_model->index(r2, sort_column, source_parent);
+        if (sort_key_cache) {
+            sort_key_cache->left = i2;
+            sort_key_cache->right = i1;
+        }
         return proxy_model->lessThan(i2, i1);
     }
 
@@ -110,6 +144,7 @@ private:
     QModelIndex source_parent;
     const QAbstractItemModel *source_model;
     const QSortFilterProxyModel *proxy_model;
+    QSortFilterProxyModelSortKeyCache *sort_key_cache;
 };
 
 
@@ -291,6 +326,7 @@ public:
     Qt::CaseSensitivity sort_casesensitivity;
     int sort_role;
     bool sort_localeaware;
+    mutable QSortFilterProxyModelSortKeyCache *sort_key_cache = nullptr;
 
     int filter_column;
     int filter_role;
@@ -380,6 +416,7 @@ public:
     int find_source_sort_column() const;
     void sort_source_rows(QVector<int> &source_rows,
                           const QModelIndex &source_parent) const;
+    const QByteArray *cached_sort_key(const QModelIndex &source_index) const;
     QVector<QPair<int, QVector<int > > > proxy_intervals_for_source_items_to_add(
         const QVector<int> &proxy_to_source, const QVector<int> &source_items,
         const QModelIndex &source_parent, Qt::Orientation orient) const;
@@ -674,11 +711,30 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
 {
     Q_Q(const QSortFilterProxyModel);
     if (source_sort_column >= 0) {
+        // Cache the sort keys when sorting enough of the rows that a
+        // vector indexed by source row doesn't waste too much space
+        QSortFilterProxyModelSortKeyCache cache;
+        QSortFilterProxyModelSortKeyCache *cachePtr = nullptr;
+        QByteArray emptyKey; // also tells whether the platform can make keys at all
+        if (sort_localeaware && source_rows.size() > 2
+                && qt_localeAwareSortKey(QStringView(), &emptyKey)) {
+            const int rowCount = *std::max_element(source_rows.cbegin(), source_rows.cend()) + 1;
+            if (rowCount <= 4 * source_rows.size()) {
+                cache.keys.resize(rowCount);
+                cache.states.fill(QSortFilterProxyModelSortKeyCache::Unknown, rowCount);
+                cachePtr = &cache;
+            }
+        }
+        QSortFilterProxyModelSortKeyCache *const previousCache = sort_key_cache;
+        sort_key_cache = cachePtr;
+        const auto restoreCache = qScopeGuard([&] { sort_key_cache = previousCache; });
+
         if (sort_order == Qt::AscendingOrder) {
-            QSortFilterProxyModelLessThan lt(source_sort_column, source_parent, model, q);
+            QSortFilterProxyModelLessThan lt(source_sort_column, source_parent, model, q, cachePtr);
             std::stable_sort(source_rows.begin(), source_rows.end(), lt);
         } else {
-            QSortFilterProxyModelGreaterThan gt(source_sort_column, source_parent, model, q);
+            QSortFilterProxyModelGreaterThan gt(source_sort_column, source_parent, model, q,
+                                                cachePtr);
             std::stable_sort(source_rows.begin(), source_rows.end(), gt);
         }
     } else { // restore the source model order
@@ -686,6 +742,46 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
     }
 }
 
+/*!
+  \internal
+
+  Returns the locale-aware sort key of the data of \a source_index from the
+  cache of the running sort, computing it on first use, or \nullptr if the
+  data does not sort as a string.
+*/
+const QByteArray *QSortFilterProxyModelPrivate::cached_sort_key(
+    const QModelIndex &source_index) const
+{
+    Q_ASSERT(sort_key_cache);
+    const int row = source_index.row();
+    uchar &state = sort_key_cache->states[row];
+    if (state == QSortFilterProxyModelSortKeyCache::Unknown) {
+        state = QSortFilterProxyModelSortKeyCache::NotCached;
+        const QVariant value = model->data(source_index, sort_role);
+        // the types that QAbstractItemModelPrivate::isVariantLessThan() compares as strings
+        switch (value.userType()) {
+        case QVariant::Invalid:
+        case QVariant::Int:
+        case QVariant::UInt:
+        case QVariant::LongLong:
+        case QVariant::ULongLong:
+        case QMetaType::Float:
+        case QVariant::Double:
+        case QVariant::Char:
+        case QVariant::Date:
+        case QVariant::Time:
+        case QVariant::DateTime:
+            break;
+        default:
+            if (qt_localeAwareSortKey(value.toString(), &sort_key_cache->keys[row]))
+                state = QSortFilterProxyModelSortKeyCache::Cached;
+            break;
+        }
+    }
+    return state == QSortFilterProxyModelSortKeyCache::Cached
+            ? &sort_key_cache->keys.at(row) : nullptr;
+}
+
 /*!
   \internal
 
@@ -2992,6 +3088,12 @@ void QSortFilterProxyModel::invalidateFilter()
     be changed using the \l {QSortFilterProxyModel::sortCaseSensitivity}
     {sortCaseSensitivity} property.
 
+    If \l {QSortFilterProxyModel::isSortLocaleAware}{isSortLocaleAware} is
+    set, strings are compared with QString::localeAwareCompare(). While
+    sorting, the proxy then fetches each item's data and computes its
+    collation sort key only once, and compares the keys, as long as this
+    function is called with the indexes it is being asked to compare.
+
     By default, the Qt::DisplayRole associated with the
     \l{QModelIndex}es is used for comparisons. This can be changed by
     setting the \l {QSortFilterProxyModel::sortRole} {sortRole} property.
@@ -3003,6 +3105,13 @@ void QSortFilterProxyModel::invalidateFilter()
 bool QSortFilterProxyModel::lessThan(const QModelIndex &source_left, const QModelIndex &source_right) const
 {
     Q_D(const QSortFilterProxyModel);
+    if (d->sort_key_cache && source_left == d->sort_key_cache->left
+            && source_right == d->sort_key_cache->right) {
+        const QByteArray *l = d->cached_sort_key(source_left);
+        const QByteArray *r = l ? d->cached_sort_key(source_right) : nullptr;
+        if (r)
+            return qstrcmp(*l, *r) < 0;
+    }
     QVariant l = (source_left.model() ? source_left.model()->data(source_left, d->sort_role) : QVariant());
     QVariant r = (source_right.model() ? source_right.model()->data(source_right, d->sort_role) : QVariant());
     return QAbstractItemModelPrivate::isVariantLessThan(l, r, d->sort_casesensitivity, d->sort_localeaware);
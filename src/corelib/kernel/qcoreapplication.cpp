@@ -874,6 +874,11 @@ void QCoreApplicationPrivate::init()
     eventDispatcherReady();
 #endif
 
+#if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(filesystemwatcher)
+    // Pick up changes to the file named by QT_LOGGING_CONF while running.
+    QLoggingRegistry::instance()->watchConfigurationFile();
+#endif
+
     processCommandLineArguments();
 
     qt_call_pre_routines();
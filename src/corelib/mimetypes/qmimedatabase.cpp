@@ -53,6 +53,10 @@
 #include <QtCore/QBuffer>
 #include <QtCore/QUrl>
 #include <QtCore/QDebug>
+#if QT_CONFIG(thread)
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
+#endif
 
 #include <algorithm>
 #include <functional>
@@ -344,32 +348,50 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFileNameAndData(const QString &fileNa
     // evaluated and the match with the highest value (either a magic priority or
     // a glob pattern weight) is selected. Matching starts from max level (most
     // specific) in both cases, even when there is already a suffix matching candidate.
+    QMimeGlobMatchResult candidatesByName;
+    const QMimeType mime = mimeTypeForUniqueFileName(fileName, &candidatesByName, accuracyPtr);
+    if (mime.isValid())
+        return mime;
+
+    if (device->isOpen()) {
+        // Read 16K in one go (QIODEVICE_BUFFERSIZE in qiodevice_p.h).
+        // This is much faster than seeking back and forth into QIODevice.
+        const QByteArray data = device->peek(16384);
+        return mimeTypeForCandidatesAndData(candidatesByName, &data, accuracyPtr);
+    }
+    return mimeTypeForCandidatesAndData(candidatesByName, nullptr, accuracyPtr);
+}
+
+// Pass 1 of mimeTypeForFileNameAndData: try to match on the file name. Returns
+// an invalid type and the candidates if the contents must be looked at.
+QMimeType QMimeDatabasePrivate::mimeTypeForUniqueFileName(const QString &fileName,
+                                                          QMimeGlobMatchResult *candidatesByName,
+                                                          int *accuracyPtr)
+{
     *accuracyPtr = 0;
 
-    // Pass 1) Try to match on the file name
-    QMimeGlobMatchResult candidatesByName;
     if (fileName.endsWith(QLatin1Char('/')))
-        candidatesByName.addMatch(QLatin1String("inode/directory"), 100, QString());
+        candidatesByName->addMatch(QLatin1String("inode/directory"), 100, QString());
     else
-        candidatesByName = findByFileName(QFileInfo(fileName).fileName());
-    if (candidatesByName.m_allMatchingMimeTypes.count() == 1) {
+        *candidatesByName = findByFileName(QFileInfo(fileName).fileName());
+    if (candidatesByName->m_allMatchingMimeTypes.count() == 1) {
         *accuracyPtr = 100;
-        const QMimeType mime = mimeTypeForName(candidatesByName.m_matchingMimeTypes.at(0));
+        const QMimeType mime = mimeTypeForName(candidatesByName->m_matchingMimeTypes.at(0));
         if (mime.isValid())
             return mime;
-        candidatesByName = {};
+        *candidatesByName = {};
     }
+    return QMimeType();
+}
 
-    // Extension is unknown, or matches multiple mimetypes.
-    // Pass 2) Match on content, if we can read the data
-    if (device->isOpen()) {
-
-        // Read 16K in one go (QIODEVICE_BUFFERSIZE in qiodevice_p.h).
-        // This is much faster than seeking back and forth into QIODevice.
-        const QByteArray data = device->peek(16384);
-
+// Pass 2 of mimeTypeForFileNameAndData: the extension is unknown, or matches
+// multiple mimetypes. Match on content, if we could read the \a data.
+QMimeType QMimeDatabasePrivate::mimeTypeForCandidatesAndData(const QMimeGlobMatchResult &candidatesByName,
+                                                             const QByteArray *data, int *accuracyPtr)
+{
+    if (data) {
         int magicAccuracy = 0;
-        QMimeType candidateByData(findByData(data, &magicAccuracy));
+        QMimeType candidateByData(findByData(*data, &magicAccuracy));
 
         // Disambiguate conflicting extensions (if magic matching found something)
         if (candidateByData.isValid() && magicAccuracy > 0) {
@@ -392,9 +414,10 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFileNameAndData(const QString &fileNa
     }
 
     if (candidatesByName.m_allMatchingMimeTypes.count() > 1) {
-        candidatesByName.m_matchingMimeTypes.sort(); // make it deterministic
+        QStringList matchingMimeTypes = candidatesByName.m_matchingMimeTypes;
+        matchingMimeTypes.sort(); // make it deterministic
         *accuracyPtr = 20;
-        const QMimeType mime = mimeTypeForName(candidatesByName.m_matchingMimeTypes.at(0));
+        const QMimeType mime = mimeTypeForName(matchingMimeTypes.at(0));
         if (mime.isValid())
             return mime;
     }
@@ -402,6 +425,72 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFileNameAndData(const QString &fileNa
     return mimeTypeForName(defaultMimeType());
 }
 
+QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName, const QFileInfo *fileInfo,
+                                                QMimeDatabase::MatchMode mode)
+{
+    if (mode == QMimeDatabase::MatchExtension) {
+        QMutexLocker locker(&mutex);
+        const QStringList matches = mimeTypeForFileName(fileInfo ? fileInfo->absoluteFilePath() : fileName);
+        if (matches.isEmpty())
+            return mimeTypeForName(defaultMimeType());
+        // If there are several, we have to pick one.
+        return mimeTypeForName(matches.first());
+    }
+
+    const QFileInfo info = fileInfo ? *fileInfo : QFileInfo(fileName);
+    if (info.isDir()) {
+        QMutexLocker locker(&mutex);
+        return mimeTypeForName(QLatin1String("inode/directory"));
+    }
+
+    QFile file(info.absoluteFilePath());
+
+#ifdef Q_OS_UNIX
+    // Cannot access statBuf.st_mode from the filesystem engine, so we have to stat again.
+    // In addition we want to follow symlinks.
+    const QByteArray nativeFilePath = QFile::encodeName(file.fileName());
+    QT_STATBUF statBuffer;
+    if (QT_STAT(nativeFilePath.constData(), &statBuffer) == 0) {
+        const char *special = nullptr;
+        if (S_ISCHR(statBuffer.st_mode))
+            special = "inode/chardevice";
+        else if (S_ISBLK(statBuffer.st_mode))
+            special = "inode/blockdevice";
+        else if (S_ISFIFO(statBuffer.st_mode))
+            special = "inode/fifo";
+        else if (S_ISSOCK(statBuffer.st_mode))
+            special = "inode/socket";
+        if (special) {
+            QMutexLocker locker(&mutex);
+            return mimeTypeForName(QLatin1String(special));
+        }
+    }
+#endif
+
+    int accuracy = 0;
+    QMimeGlobMatchResult candidatesByName;
+    if (mode == QMimeDatabase::MatchDefault) {
+        QMutexLocker locker(&mutex);
+        const QMimeType mime = mimeTypeForUniqueFileName(info.absoluteFilePath(), &candidatesByName,
+                                                         &accuracy);
+        if (mime.isValid())
+            return mime;
+    }
+
+    // The file is read without holding the mutex, so that other threads can
+    // use the database while this one waits for the disk.
+    // Read 16K in one go (QIODEVICE_BUFFERSIZE in qiodevice_p.h).
+    const bool readable = file.open(QIODevice::ReadOnly);
+    const QByteArray data = readable ? file.read(16384) : QByteArray();
+
+    QMutexLocker locker(&mutex);
+    if (mode == QMimeDatabase::MatchDefault)
+        return mimeTypeForCandidatesAndData(candidatesByName, readable ? &data : nullptr, &accuracy);
+    if (!readable)
+        return mimeTypeForName(defaultMimeType());
+    return findByData(data, &accuracy);
+}
+
 QList<QMimeType> QMimeDatabasePrivate::allMimeTypes()
 {
     QList<QMimeType> result;
@@ -531,75 +620,107 @@ QMimeType QMimeDatabase::mimeTypeForName(const QString &nameOrAlias) const
 */
 QMimeType QMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mode) const
 {
-    QMutexLocker locker(&d->mutex);
+    return d->mimeTypeForFile(fileInfo.filePath(), &fileInfo, mode);
+}
 
-    if (fileInfo.isDir())
-        return d->mimeTypeForName(QLatin1String("inode/directory"));
+/*!
+    Returns a MIME type for the file named \a fileName using \a mode.
 
-    QFile file(fileInfo.absoluteFilePath());
+    \overload
+*/
+QMimeType QMimeDatabase::mimeTypeForFile(const QString &fileName, MatchMode mode) const
+{
+    return d->mimeTypeForFile(fileName, nullptr, mode);
+}
 
-#ifdef Q_OS_UNIX
-    // Cannot access statBuf.st_mode from the filesystem engine, so we have to stat again.
-    // In addition we want to follow symlinks.
-    const QByteArray nativeFilePath = QFile::encodeName(file.fileName());
-    QT_STATBUF statBuffer;
-    if (QT_STAT(nativeFilePath.constData(), &statBuffer) == 0) {
-        if (S_ISCHR(statBuffer.st_mode))
-            return d->mimeTypeForName(QLatin1String("inode/chardevice"));
-        if (S_ISBLK(statBuffer.st_mode))
-            return d->mimeTypeForName(QLatin1String("inode/blockdevice"));
-        if (S_ISFIFO(statBuffer.st_mode))
-            return d->mimeTypeForName(QLatin1String("inode/fifo"));
-        if (S_ISSOCK(statBuffer.st_mode))
-            return d->mimeTypeForName(QLatin1String("inode/socket"));
+namespace {
+struct FileBatch
+{
+    enum { ChunkSize = 16 };
+
+    FileBatch(QMimeDatabasePrivate *d, const QStringList &fileNames, QMimeDatabase::MatchMode mode)
+        : d(d), fileNames(fileNames), results(fileNames.size()), mode(mode)
+    {
     }
-#endif
 
-    int priority = 0;
-    switch (mode) {
-    case MatchDefault:
-        file.open(QIODevice::ReadOnly); // isOpen() will be tested by method below
-        return d->mimeTypeForFileNameAndData(fileInfo.absoluteFilePath(), &file, &priority);
-    case MatchExtension:
-        locker.unlock();
-        return mimeTypeForFile(fileInfo.absoluteFilePath(), mode);
-    case MatchContent:
-        if (file.open(QIODevice::ReadOnly)) {
-            locker.unlock();
-            return mimeTypeForData(&file);
-        } else {
-            return d->mimeTypeForName(d->defaultMimeType());
+    void run()
+    {
+        const int count = fileNames.size();
+        QMimeType *result = results.data();
+        for (int first = nextFile.fetchAndAddRelaxed(ChunkSize); first < count;
+             first = nextFile.fetchAndAddRelaxed(ChunkSize)) {
+            const int last = qMin(first + int(ChunkSize), count);
+            for (int i = first; i < last; ++i)
+                result[i] = d->mimeTypeForFile(fileNames.at(i), nullptr, mode);
         }
-    default:
-        Q_ASSERT(false);
     }
-    return d->mimeTypeForName(d->defaultMimeType());
-}
+
+    QMimeDatabasePrivate *d;
+    const QStringList &fileNames;
+    QVector<QMimeType> results;
+    QMimeDatabase::MatchMode mode;
+    QAtomicInt nextFile;
+#if QT_CONFIG(thread)
+    QSemaphore helpersDone;
+#endif
+};
+
+#if QT_CONFIG(thread)
+class FileBatchHelper : public QRunnable
+{
+public:
+    explicit FileBatchHelper(FileBatch *batch) : batch(batch) {}
+
+    void run() override
+    {
+        batch->run();
+        batch->helpersDone.release();
+    }
+
+private:
+    FileBatch *batch;
+};
+#endif
+} // unnamed namespace
 
 /*!
-    Returns a MIME type for the file named \a fileName using \a mode.
+    \since 6.0
 
-    \overload
+    Returns the MIME types for the files \a fileNames using \a mode, in the
+    same order. Each one is the type mimeTypeForFile() returns for the file.
+
+    Files are classified on the calling thread and on the idle threads of
+    QThreadPool::globalInstance(), so that the file contents are read in
+    parallel. The function doesn't return until all files are classified.
+
+    \sa mimeTypeForFile()
 */
-QMimeType QMimeDatabase::mimeTypeForFile(const QString &fileName, MatchMode mode) const
-{
-    if (mode == MatchExtension) {
-        QMutexLocker locker(&d->mutex);
-        const QStringList matches = d->mimeTypeForFileName(fileName);
-        const int matchCount = matches.count();
-        if (matchCount == 0) {
-            return d->mimeTypeForName(d->defaultMimeType());
-        } else if (matchCount == 1) {
-            return d->mimeTypeForName(matches.first());
-        } else {
-            // We have to pick one.
-            return d->mimeTypeForName(matches.first());
+QList<QMimeType> QMimeDatabase::mimeTypesForFiles(const QStringList &fileNames, MatchMode mode) const
+{
+    FileBatch batch(d, fileNames, mode);
+
+#if QT_CONFIG(thread)
+    // Only idle threads are used, so this never waits for a busy pool, not
+    // even when called from one of its threads.
+    int helpers = 0;
+    const int chunks = (fileNames.size() + FileBatch::ChunkSize - 1) / FileBatch::ChunkSize;
+    QThreadPool *pool = QThreadPool::globalInstance();
+    while (helpers < chunks - 1) {
+        FileBatchHelper *helper = new FileBatchHelper(&batch);
+        if (!pool->tryStart(helper)) {
+            delete helper;
+            break;
         }
-    } else {
-        // Implemented as a wrapper around mimeTypeForFile(QFileInfo), so no mutex.
-        QFileInfo fileInfo(fileName);
-        return mimeTypeForFile(fileInfo, mode);
+        ++helpers;
     }
+#endif
+
+    batch.run();
+
+#if QT_CONFIG(thread)
+    batch.helpersDone.acquire(helpers);
+#endif
+    return batch.results.toList();
 }
 
 /*!
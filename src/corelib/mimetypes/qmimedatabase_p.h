@@ -52,6 +52,7 @@
 // We mean it.
 //
 
+#include "qmimedatabase.h"
 #include "qmimetype.h"
 
 QT_REQUIRE_CONFIG(mimetype);
@@ -68,8 +69,8 @@ QT_REQUIRE_CONFIG(mimetype);
 
 QT_BEGIN_NAMESPACE
 
+class QFileInfo;
 class QIODevice;
-class QMimeDatabase;
 class QMimeProviderBase;
 
 class QMimeDatabasePrivate
@@ -92,10 +93,18 @@ public:
     QStringList parents(const QString &mimeName);
     QMimeType mimeTypeForName(const QString &nameOrAlias);
     QMimeType mimeTypeForFileNameAndData(const QString &fileName, QIODevice *device, int *priorityPtr);
+    QMimeType mimeTypeForUniqueFileName(const QString &fileName, QMimeGlobMatchResult *candidatesByName,
+                                        int *accuracyPtr);
+    QMimeType mimeTypeForCandidatesAndData(const QMimeGlobMatchResult &candidatesByName,
+                                           const QByteArray *data, int *accuracyPtr);
     QMimeType findByData(const QByteArray &data, int *priorityPtr);
     QStringList mimeTypeForFileName(const QString &fileName);
     QMimeGlobMatchResult findByFileName(const QString &fileName);
 
+    // Takes care of locking the mutex, but doesn't hold it while reading the file.
+    QMimeType mimeTypeForFile(const QString &fileName, const QFileInfo *fileInfo,
+                              QMimeDatabase::MatchMode mode);
+
     // API for QMimeType. Takes care of locking the mutex.
     void loadMimeTypePrivate(QMimeTypePrivate &mimePrivate);
     void loadGenericIcon(QMimeTypePrivate &mimePrivate);
@@ -337,6 +337,58 @@ QByteArray QMimeMagicRule::mask() const
     return result;
 }
 
+template <typename T>
+static inline uchar firstByteOf(quint32 number)
+{
+    uchar bytes[sizeof(T)];
+    qToUnaligned<T>(T(number), bytes);
+    return bytes[0];
+}
+
+/*!
+    \internal
+
+    Returns \c true if the rule can only match data that has \a *byte at
+    \a *offset, which is the case for rules with a single offset and an
+    unmasked first byte. Sub-rules are not taken into account.
+*/
+bool QMimeMagicRule::requiredByte(int *offset, uchar *byte) const
+{
+    if (!m_matchFunction || m_startPos != m_endPos || m_startPos < 0)
+        return false;
+
+    switch (m_type) {
+    case String:
+        if (m_pattern.isEmpty() || uchar(m_mask.at(0)) != 0xff)
+            return false;
+        *byte = uchar(m_pattern.at(0));
+        break;
+    case Byte:
+        if (quint8(m_numberMask) != 0xff)
+            return false;
+        *byte = quint8(m_number);
+        break;
+    case Host16:
+    case Big16:
+    case Little16:
+        if (firstByteOf<quint16>(m_numberMask) != 0xff)
+            return false;
+        *byte = firstByteOf<quint16>(m_number);
+        break;
+    case Host32:
+    case Big32:
+    case Little32:
+        if (firstByteOf<quint32>(m_numberMask) != 0xff)
+            return false;
+        *byte = firstByteOf<quint32>(m_number);
+        break;
+    default:
+        return false;
+    }
+    *offset = m_startPos;
+    return true;
+}
+
 bool QMimeMagicRule::matches(const QByteArray &data) const
 {
     const bool ok = m_matchFunction && (this->*m_matchFunction)(data);
@@ -93,6 +93,7 @@ public:
     bool isValid() const { return m_matchFunction != nullptr; }
 
     bool matches(const QByteArray &data) const;
+    bool requiredByte(int *offset, uchar *byte) const;
 
     QList<QMimeMagicRule> m_subMatches;
 
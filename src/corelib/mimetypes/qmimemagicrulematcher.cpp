@@ -43,6 +43,8 @@
 
 #include "qmimetype_p.h"
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -103,4 +105,116 @@ unsigned QMimeMagicRuleMatcher::priority() const
     return m_priority;
 }
 
+/*!
+    \internal
+    \class QMimeMagicRuleIndex
+    \inmodule QtCore
+
+    \brief The QMimeMagicRuleIndex class finds the best matching magic rule
+    matcher without evaluating every rule.
+
+    The top-level rules of all matchers are merged into one list. Rules that
+    require a given byte at a single offset are sorted by offset and byte, so
+    that for each offset only the rules expecting the byte found in the data
+    are evaluated. Within a byte, and among the remaining rules, higher
+    priorities come first, so that evaluation stops as soon as no rule can
+    beat the current best match.
+*/
+
+void QMimeMagicRuleIndex::clear()
+{
+    m_anchoredRules.clear();
+    m_offsetGroups.clear();
+    m_otherRules.clear();
+}
+
+void QMimeMagicRuleIndex::build(const QList<QMimeMagicRuleMatcher> &matchers)
+{
+    clear();
+
+    for (int i = 0; i < matchers.size(); ++i) {
+        const QMimeMagicRuleMatcher &matcher = matchers.at(i);
+        const QList<QMimeMagicRule> rules = matcher.magicRules();
+        for (const QMimeMagicRule &rule : rules) {
+            if (!rule.isValid())
+                continue;
+            Rule entry = { rule, i, matcher.priority(), -1, 0 };
+            if (rule.requiredByte(&entry.offset, &entry.byte))
+                m_anchoredRules.append(entry);
+            else
+                m_otherRules.append(entry);
+        }
+    }
+
+    const auto byPriority = [](const Rule &lhs, const Rule &rhs) {
+        if (lhs.priority != rhs.priority)
+            return lhs.priority > rhs.priority;
+        return lhs.matcher < rhs.matcher;
+    };
+    std::stable_sort(m_anchoredRules.begin(), m_anchoredRules.end(),
+                     [&byPriority](const Rule &lhs, const Rule &rhs) {
+        if (lhs.offset != rhs.offset)
+            return lhs.offset < rhs.offset;
+        if (lhs.byte != rhs.byte)
+            return lhs.byte < rhs.byte;
+        return byPriority(lhs, rhs);
+    });
+    std::stable_sort(m_otherRules.begin(), m_otherRules.end(), byPriority);
+
+    for (int i = 0; i < m_anchoredRules.size(); ++i) {
+        if (m_offsetGroups.isEmpty() || m_offsetGroups.last().offset != m_anchoredRules.at(i).offset)
+            m_offsetGroups.append({ m_anchoredRules.at(i).offset, i, i });
+        m_offsetGroups.last().end = i + 1;
+    }
+}
+
+/*!
+    \internal
+
+    Returns the index of the matcher that QMimeXMLProvider would pick for
+    \a data: the first one in the list with the highest priority among those
+    that match and have a priority above \a minimumPriority. Returns -1 if
+    there is none.
+*/
+int QMimeMagicRuleIndex::bestMatch(const QByteArray &data, unsigned minimumPriority) const
+{
+    int best = -1;
+    unsigned bestPriority = minimumPriority;
+
+    // Returns false once neither \a rule nor any rule sorted after it can win
+    const auto check = [&](const Rule &rule) {
+        if (best < 0 ? rule.priority <= bestPriority : rule.priority < bestPriority)
+            return false;
+        if (best >= 0 && rule.priority == bestPriority && rule.matcher >= best)
+            return false;
+        if (rule.rule.matches(data)) {
+            best = rule.matcher;
+            bestPriority = rule.priority;
+        }
+        return true;
+    };
+
+    const uchar *bytes = reinterpret_cast<const uchar *>(data.constData());
+    for (const OffsetGroup &group : m_offsetGroups) {
+        if (group.offset >= data.size())
+            break;
+        const uchar byte = bytes[group.offset];
+        const auto first = m_anchoredRules.cbegin() + group.begin;
+        const auto last = m_anchoredRules.cbegin() + group.end;
+        auto it = std::lower_bound(first, last, byte, [](const Rule &rule, uchar value) {
+            return rule.byte < value;
+        });
+        for (; it != last && it->byte == byte; ++it) {
+            if (!check(*it))
+                break;
+        }
+    }
+
+    for (const Rule &rule : m_otherRules) {
+        if (!check(rule))
+            break;
+    }
+    return best;
+}
+
 QT_END_NAMESPACE
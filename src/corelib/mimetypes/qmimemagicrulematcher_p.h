@@ -58,6 +58,7 @@ QT_REQUIRE_CONFIG(mimetype);
 #include <QtCore/qbytearray.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -92,6 +93,35 @@ private:
 };
 Q_DECLARE_SHARED(QMimeMagicRuleMatcher)
 
+class QMimeMagicRuleIndex
+{
+public:
+    void clear();
+    void build(const QList<QMimeMagicRuleMatcher> &matchers);
+
+    int bestMatch(const QByteArray &data, unsigned minimumPriority) const;
+
+private:
+    struct Rule
+    {
+        QMimeMagicRule rule;
+        int matcher;
+        unsigned priority;
+        int offset;
+        uchar byte;
+    };
+    struct OffsetGroup
+    {
+        int offset;
+        int begin;
+        int end;
+    };
+
+    QVector<Rule> m_anchoredRules;
+    QVector<OffsetGroup> m_offsetGroups;
+    QVector<Rule> m_otherRules;
+};
+
 QT_END_NAMESPACE
 
 #endif // QMIMEMAGICRULEMATCHER_P_H
@@ -627,20 +627,17 @@ void QMimeXMLProvider::addFileNameMatches(const QString &fileName, QMimeGlobMatc
 
 void QMimeXMLProvider::findByMagic(const QByteArray &data, int *accuracyPtr, QMimeType &candidate)
 {
-    QString candidateName;
-    bool foundOne = false;
-    for (const QMimeMagicRuleMatcher &matcher : qAsConst(m_magicMatchers)) {
-        if (matcher.matches(data)) {
-            const int priority = matcher.priority();
-            if (priority > *accuracyPtr) {
-                *accuracyPtr = priority;
-                candidateName = matcher.mimetype();
-                foundOne = true;
-            }
-        }
+    if (m_magicIndexDirty) {
+        m_magicIndex.build(m_magicMatchers);
+        m_magicIndexDirty = false;
+    }
+
+    const int best = m_magicIndex.bestMatch(data, *accuracyPtr);
+    if (best >= 0) {
+        const QMimeMagicRuleMatcher &matcher = m_magicMatchers.at(best);
+        *accuracyPtr = matcher.priority();
+        candidate = mimeTypeForName(matcher.mimetype());
     }
-    if (foundOne)
-        candidate = mimeTypeForName(candidateName);
 }
 
 void QMimeXMLProvider::ensureLoaded()
@@ -662,6 +659,8 @@ void QMimeXMLProvider::ensureLoaded()
     m_parents.clear();
     m_mimeTypeGlobs.clear();
     m_magicMatchers.clear();
+    m_magicIndex.clear();
+    m_magicIndexDirty = true;
 
     //qDebug() << "Loading" << m_allFiles;
 
@@ -755,6 +754,7 @@ void QMimeXMLProvider::addAllMimeTypes(QList<QMimeType> &result)
 void QMimeXMLProvider::addMagicMatcher(const QMimeMagicRuleMatcher &matcher)
 {
     m_magicMatchers.append(matcher);
+    m_magicIndexDirty = true;
 }
 
 QT_END_NAMESPACE
@@ -57,13 +57,12 @@
 QT_REQUIRE_CONFIG(mimetype);
 
 #include "qmimeglobpattern_p.h"
+#include "qmimemagicrulematcher_p.h"
 #include <QtCore/qdatetime.h>
 #include <QtCore/qset.h>
 
 QT_BEGIN_NAMESPACE
 
-class QMimeMagicRuleMatcher;
-
 class QMimeProviderBase
 {
 public:
@@ -168,6 +167,8 @@ private:
     QMimeAllGlobPatterns m_mimeTypeGlobs;
 
     QList<QMimeMagicRuleMatcher> m_magicMatchers;
+    QMimeMagicRuleIndex m_magicIndex;
+    bool m_magicIndexDirty = true;
     QStringList m_allFiles;
 };
 
@@ -935,6 +935,18 @@ Q_NEVER_INLINE void QCborContainerPrivate::appendAsciiString(QStringView s)
     qt_to_latin1_unchecked(l, uc, len);
 }
 
+void QCborContainerPrivate::appendUtf8String(const char *str, qsizetype len)
+{
+    // Strings stored without StringIsUtf16 must be valid UTF-8 (the JSON
+    // writer copies them as they are), so only well-formed data is kept as is
+    const QUtf8::ValidUtf8Result r = QUtf8::isValidUtf8(str, len);
+    if (Q_UNLIKELY(!r.isValidUtf8))
+        return append(QString::fromUtf8(str, int(len)));
+
+    appendByteData(str, len, QCborValue::String,
+                   r.isValidAscii ? Element::StringIsAscii : Element::ValueFlags{});
+}
+
 QCborValue QCborContainerPrivate::extractAt_complex(Element e)
 {
     // create a new container for the returned value, containing the byte data
@@ -246,6 +246,7 @@ public:
                        QtCbor::Element::StringIsAscii);
     }
     void appendAsciiString(QStringView s);
+    void appendUtf8String(const char *str, qsizetype len);
 
 #if QT_STRINGVIEW_LEVEL < 2
     void append(const QString &s)
@@ -288,6 +289,17 @@ public:
         return data->toUtf8String();
     }
 
+    QByteArray utf8StringAt(qsizetype idx) const
+    {
+        const auto &e = elements.at(idx);
+        const auto data = byteData(e);
+        if (!data)
+            return QByteArray();
+        if (e.flags & QtCbor::Element::StringIsUtf16)
+            return data->asStringView().toUtf8();
+        return data->toByteArray();
+    }
+
     static void resetValue(QCborValue &v)
     {
         v.container = nullptr;
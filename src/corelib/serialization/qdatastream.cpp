@@ -1397,6 +1397,114 @@ int QDataStream::skipRawData(int len)
     return skipResult;
 }
 
+namespace QtPrivate {
+
+static bool needsByteSwap(const QDataStream &s)
+{
+    return (s.byteOrder() == QDataStream::BigEndian) != (QSysInfo::ByteOrder == QSysInfo::BigEndian);
+}
+
+static void byteSwapArray(const void *source, quint32 count, int elementSize, void *dest)
+{
+    switch (elementSize) {
+    case 2:
+        qbswap<2>(source, count, dest);
+        break;
+    case 4:
+        qbswap<4>(source, count, dest);
+        break;
+    case 8:
+        qbswap<8>(source, count, dest);
+        break;
+    default:
+        Q_UNREACHABLE();
+    }
+}
+
+/*!
+    \internal
+
+    Reads \a count integers of \a elementSize bytes each into \a data, as
+    if each had been read with the corresponding operator>>(), and returns
+    \c true on success. The bytes are read from the device in one go and
+    then converted to host byte order in place, using the vectorized
+    qbswap() where available.
+*/
+bool readPrimitiveArray(QDataStream &s, void *data, quint32 count, int elementSize)
+{
+    if (elementSize == 8 && s.version() < 6) {
+        // 64-bit integers were streamed as two 32-bit halves
+        qint64 *values = static_cast<qint64 *>(data);
+        for (quint32 i = 0; i < count; ++i) {
+            s >> values[i];
+            if (s.status() != QDataStream::Ok)
+                return false;
+        }
+        return true;
+    }
+
+    char *bytes = static_cast<char *>(data);
+    qint64 remaining = qint64(count) * elementSize;
+    while (remaining > 0) {
+        const int blockSize = int(qMin<qint64>(remaining, 1 << 30));
+        if (s.readRawData(bytes, blockSize) != blockSize)
+            return false;
+        bytes += blockSize;
+        remaining -= blockSize;
+    }
+
+    if (elementSize > 1 && needsByteSwap(s))
+        byteSwapArray(data, count, elementSize, data);
+    return s.status() == QDataStream::Ok;
+}
+
+/*!
+    \internal
+
+    Writes \a count integers of \a elementSize bytes each from \a data, as
+    if each had been written with the corresponding operator<<(). If no
+    byte swapping is needed, the array is handed to the device in one
+    call; otherwise it is swapped in chunks through a fixed-size buffer
+    so that only one device write per chunk is needed.
+*/
+void writePrimitiveArray(QDataStream &s, const void *data, quint32 count, int elementSize)
+{
+    if (elementSize == 8 && s.version() < 6) {
+        // 64-bit integers were streamed as two 32-bit halves
+        const qint64 *values = static_cast<const qint64 *>(data);
+        for (quint32 i = 0; i < count; ++i)
+            s << values[i];
+        return;
+    }
+
+    const char *bytes = static_cast<const char *>(data);
+    if (elementSize == 1 || !needsByteSwap(s)) {
+        qint64 remaining = qint64(count) * elementSize;
+        while (remaining > 0) {
+            const int blockSize = int(qMin<qint64>(remaining, 1 << 30));
+            if (s.writeRawData(bytes, blockSize) != blockSize)
+                return;
+            bytes += blockSize;
+            remaining -= blockSize;
+        }
+        return;
+    }
+
+    quint64 buffer[1024];
+    const quint32 step = sizeof(buffer) / elementSize;
+    while (count > 0) {
+        const quint32 n = qMin(step, count);
+        byteSwapArray(bytes, n, elementSize, buffer);
+        const int blockSize = int(n * elementSize);
+        if (s.writeRawData(reinterpret_cast<const char *>(buffer), blockSize) != blockSize)
+            return;
+        bytes += blockSize;
+        count -= n;
+    }
+}
+
+} // namespace QtPrivate
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_DATASTREAM
@@ -237,8 +237,46 @@ private:
     QDataStream::Status oldStatus;
 };
 
+// Types whose QDataStream representation is their value in the stream's byte order,
+// so that arrays of them can be transferred in bulk.
+template <typename T>
+using IsDataStreamPrimitive = std::integral_constant<bool,
+    std::is_same<T, qint8>::value || std::is_same<T, quint8>::value
+    || std::is_same<T, qint16>::value || std::is_same<T, quint16>::value
+    || std::is_same<T, qint32>::value || std::is_same<T, quint32>::value
+    || std::is_same<T, qint64>::value || std::is_same<T, quint64>::value>;
+
+Q_CORE_EXPORT bool readPrimitiveArray(QDataStream &s, void *data, quint32 count, int elementSize);
+Q_CORE_EXPORT void writePrimitiveArray(QDataStream &s, const void *data, quint32 count, int elementSize);
+
 template <typename Container>
-QDataStream &readArrayBasedContainer(QDataStream &s, Container &c)
+QDataStream &readArrayBasedContainer(QDataStream &s, Container &c, std::true_type)
+{
+    using T = typename Container::value_type;
+    StreamStateSaver stateSaver(&s);
+
+    c.clear();
+    quint32 n;
+    s >> n;
+
+    // grow in steps, so that a corrupt size doesn't cause a huge allocation up front
+    const quint32 Step = 1024 * 1024 / sizeof(T);
+    quint32 allocated = 0;
+    while (allocated < n) {
+        const quint32 blockSize = qMin(Step, n - allocated);
+        c.resize(allocated + blockSize);
+        if (!readPrimitiveArray(s, c.data() + allocated, blockSize, sizeof(T))) {
+            c.clear();
+            break;
+        }
+        allocated += blockSize;
+    }
+
+    return s;
+}
+
+template <typename Container>
+QDataStream &readArrayBasedContainer(QDataStream &s, Container &c, std::false_type)
 {
     StreamStateSaver stateSaver(&s);
 
@@ -259,6 +297,13 @@ QDataStream &readArrayBasedContainer(QDataStream &s, Container &c)
     return s;
 }
 
+template <typename Container>
+QDataStream &readArrayBasedContainer(QDataStream &s, Container &c)
+{
+    return readArrayBasedContainer(s, c,
+                                   IsDataStreamPrimitive<typename Container::value_type>{});
+}
+
 template <typename Container>
 QDataStream &readListBasedContainer(QDataStream &s, Container &c)
 {
@@ -312,6 +357,28 @@ QDataStream &writeSequentialContainer(QDataStream &s, const Container &c)
     return s;
 }
 
+template <typename Container>
+QDataStream &writeArrayBasedContainer(QDataStream &s, const Container &c, std::true_type)
+{
+    s << quint32(c.size());
+    writePrimitiveArray(s, c.constData(), quint32(c.size()), sizeof(typename Container::value_type));
+
+    return s;
+}
+
+template <typename Container>
+QDataStream &writeArrayBasedContainer(QDataStream &s, const Container &c, std::false_type)
+{
+    return writeSequentialContainer(s, c);
+}
+
+template <typename Container>
+QDataStream &writeArrayBasedContainer(QDataStream &s, const Container &c)
+{
+    return writeArrayBasedContainer(s, c,
+                                    IsDataStreamPrimitive<typename Container::value_type>{});
+}
+
 template <typename Container>
 QDataStream &writeAssociativeContainer(QDataStream &s, const Container &c)
 {
@@ -398,7 +465,7 @@ inline QDataStream &operator>>(QDataStream &s, QVector<T> &v)
 template<typename T>
 inline QDataStream &operator<<(QDataStream &s, const QVector<T> &v)
 {
-    return QtPrivate::writeSequentialContainer(s, v);
+    return QtPrivate::writeArrayBasedContainer(s, v);
 }
 
 template <typename T>
@@ -204,6 +204,7 @@ class Value
 {
 public:
     static QCborContainerPrivate *container(const QCborValue &v) { return v.container; }
+    static qint64 valueHelper(const QCborValue &v) { return v.n; }
 
     static QJsonValue fromTrustedCbor(const QCborValue &v)
     {
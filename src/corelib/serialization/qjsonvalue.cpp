@@ -216,6 +216,21 @@ QJsonValue::QJsonValue(QLatin1String s)
 {
 }
 
+/*!
+    \since 6.0
+
+    Creates a value of type String, with value \a s.
+
+    The UTF-8 data is stored as it is, without converting it to UTF-16, and
+    toUtf8String() and QJsonDocument::toJson() return it the same way.
+    Invalid UTF-8 sequences are replaced, as by QString::fromUtf8().
+ */
+QJsonValue::QJsonValue(const QUtf8String &s)
+    : n(0), d(new QCborContainerPrivate), t(QCborValue::String)
+{
+    d->appendUtf8String(s.constData(), s.size());
+}
+
 /*!
     Creates a value of type Array, with value \a a.
  */
@@ -669,6 +684,22 @@ QString QJsonValue::toString() const
     return (t == QCborValue::String && d) ? d->stringAt(n) : QString();
 }
 
+/*!
+    \since 6.0
+
+    Converts the value to a QUtf8String and returns it.
+
+    If type() is not String, a null QUtf8String will be returned. Strings
+    parsed from JSON text or created from a QUtf8String are held as UTF-8
+    and are returned without any conversion.
+
+    \sa toString()
+ */
+QUtf8String QJsonValue::toUtf8String() const
+{
+    return (t == QCborValue::String && d) ? QUtf8String(d->utf8StringAt(n)) : QUtf8String();
+}
+
 /*!
     Converts the value to an array and returns it.
 
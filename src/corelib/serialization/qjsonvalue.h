@@ -44,6 +44,7 @@
 #include <QtCore/qstring.h>
 #include <QtCore/qshareddata.h>
 #include <QtCore/qcborvalue.h>
+#include <QtCore/qutf8string.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -76,9 +77,10 @@ public:
     QJsonValue(qint64 v);
     QJsonValue(const QString &s);
     QJsonValue(QLatin1String s);
+    QJsonValue(const QUtf8String &s);
 #ifndef QT_NO_CAST_FROM_ASCII
     inline QT_ASCII_CAST_WARN QJsonValue(const char *s)
-        : QJsonValue(QString::fromUtf8(s)) {}
+        : QJsonValue(QUtf8String(s)) {}
 #endif
     QJsonValue(const QJsonArray &a);
     QJsonValue(const QJsonObject &o);
@@ -115,6 +117,7 @@ public:
     double toDouble(double defaultValue = 0) const;
     QString toString() const;
     QString toString(const QString &defaultValue) const;
+    QUtf8String toUtf8String() const;
     QJsonArray toArray() const;
     QJsonArray toArray(const QJsonArray &defaultValue) const;
     QJsonObject toObject() const;
@@ -127,6 +127,65 @@ static QByteArray escapedString(const QString &s)
     return ba;
 }
 
+static void escapedUtf8String(const char *s, qsizetype len, QByteArray &json)
+{
+    const char *const end = s + len;
+    while (s != end) {
+        // copy everything that needs no escaping in one go, including the
+        // multi-byte UTF-8 sequences
+        const char *const start = s;
+        while (s != end && uchar(*s) >= 0x20 && *s != '"' && *s != '\\')
+            ++s;
+        json.append(start, int(s - start));
+        if (s == end)
+            break;
+
+        const uchar u = uchar(*s++);
+        json += '\\';
+        switch (u) {
+        case 0x22:
+            json += '"';
+            break;
+        case 0x5c:
+            json += '\\';
+            break;
+        case 0x8:
+            json += 'b';
+            break;
+        case 0xc:
+            json += 'f';
+            break;
+        case 0xa:
+            json += 'n';
+            break;
+        case 0xd:
+            json += 'r';
+            break;
+        case 0x9:
+            json += 't';
+            break;
+        default:
+            json += "u00";
+            json += char(hexdig(u >> 4));
+            json += char(hexdig(u & 0xf));
+        }
+    }
+}
+
+static void stringToJson(const QCborContainerPrivate *d, qsizetype idx, QByteArray &json)
+{
+    json += '"';
+    const QtCbor::Element &e = d->elements.at(idx);
+    const QtCbor::ByteData *b = d->byteData(e);
+    if (b && e.type == QCborValue::String) {
+        if (e.flags & QtCbor::Element::StringIsUtf16)
+            json += escapedString(b->asQStringRaw());
+        else    // US-ASCII or UTF-8, written as it is stored
+            escapedUtf8String(b->byte(), b->len, json);
+    }
+    json += '"';
+}
+
 static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool compact)
 {
     QCborValue::Type type = v.type();
@@ -150,9 +209,13 @@ static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool
         break;
     }
     case QCborValue::String:
-        json += '"';
-        json += escapedString(v.toString());
-        json += '"';
+        if (const QCborContainerPrivate *d = QJsonPrivate::Value::container(v)) {
+            stringToJson(d, QJsonPrivate::Value::valueHelper(v), json);
+        } else {
+            json += '"';
+            json += escapedString(v.toString());
+            json += '"';
+        }
         break;
     case QCborValue::Array:
         json += compact ? "[" : "[\n";
@@ -206,11 +269,9 @@ static void objectContentToJson(const QCborContainerPrivate *o, QByteArray &json
 
     qsizetype i = 0;
     while (true) {
-        QCborValue e = o->valueAt(i);
         json += indentString;
-        json += '"';
-        json += escapedString(o->valueAt(i).toString());
-        json += compact ? "\":" : "\": ";
+        stringToJson(o, i, json);
+        json += compact ? ":" : ": ";
         valueToJson(o->valueAt(i + 1), json, indent, compact);
 
         if ((i += 2) == o->elements.size()) {
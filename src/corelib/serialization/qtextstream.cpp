@@ -230,6 +230,7 @@ static const int QTEXTSTREAM_BUFFERSIZE = 16384;
 #include "qfile.h"
 #include "qnumeric.h"
 #include "qvarlengtharray.h"
+#include "qutf8string.h"
 
 #include <locale.h>
 #include "private/qlocale_p.h"
@@ -555,7 +556,7 @@ void QTextStreamPrivate::flushWriteBuffer()
     if (status != QTextStream::Ok)
         return;
 
-    if (writeBuffer.isEmpty())
+    if (writeBuffer.isEmpty() && encodedWriteBuffer.isEmpty())
         return;
 
 #if defined (Q_OS_WIN)
@@ -574,16 +575,23 @@ void QTextStreamPrivate::flushWriteBuffer()
     qDebug("QTextStreamPrivate::flushWriteBuffer(), using %s codec (%s generating BOM)",
            codec ? codec->name().constData() : "no",
            !codec || (writeConverterState.flags & QTextCodec::IgnoreHeader) ? "not" : "");
+#endif
 #endif
 
-    // convert from unicode to raw data
-    // codec might be null if we're already inside global destructors (QTestCodec::codecForLocale returned null)
-    QByteArray data = Q_LIKELY(codec) ? codec->fromUnicode(writeBuffer.data(), writeBuffer.size(), &writeConverterState)
-                                      : writeBuffer.toLatin1();
+    // bytes queued by putUtf8String() come before the text in writeBuffer
+    QByteArray data;
+    data.swap(encodedWriteBuffer);
+    if (!writeBuffer.isEmpty()) {
+#if QT_CONFIG(textcodec)
+        // convert from unicode to raw data
+        // codec might be null if we're already inside global destructors (QTestCodec::codecForLocale returned null)
+        data += Q_LIKELY(codec) ? codec->fromUnicode(writeBuffer.data(), writeBuffer.size(), &writeConverterState)
+                                : writeBuffer.toLatin1();
 #else
-    QByteArray data = writeBuffer.toLatin1();
+        data += writeBuffer.toLatin1();
 #endif
-    writeBuffer.clear();
+        writeBuffer.clear();
+    }
 
     // write raw data to the device
     qint64 bytesWritten = device->write(data);
@@ -865,6 +873,41 @@ void QTextStreamPrivate::write(QLatin1String data)
     }
 }
 
+/*!
+    \internal
+
+    Writes \a data, which is UTF-8, without converting it to UTF-16 when the
+    stream writes UTF-8 to a device and no padding is needed. The bytes are
+    queued in encodedWriteBuffer, after the encoded contents of writeBuffer.
+*/
+void QTextStreamPrivate::putUtf8String(const QUtf8String &data)
+{
+#if QT_CONFIG(textcodec)
+    if (device && !string && params.fieldWidth <= 0 && status == QTextStream::Ok
+        && codec && codec->mibEnum() == 106 // UTF-8
+        && (writeConverterState.flags & QTextCodec::IgnoreHeader) // no BOM pending
+#if defined (Q_OS_WIN)
+        && !device->isTextModeEnabled()
+#endif
+        && data.isValidUtf8()) {
+        if (!writeBuffer.isEmpty()) {
+            encodedWriteBuffer += codec->fromUnicode(writeBuffer.data(), writeBuffer.size(),
+                                                     &writeConverterState);
+            writeBuffer.clear();
+        }
+        // a high surrogate at the end of writeBuffer is still held by the
+        // converter; the text has to follow it through the codec
+        if (writeConverterState.remainingChars == 0) {
+            encodedWriteBuffer += data.toByteArray();
+            if (encodedWriteBuffer.size() > QTEXTSTREAM_BUFFERSIZE)
+                flushWriteBuffer();
+            return;
+        }
+    }
+#endif
+    putString(data.toString());
+}
+
 /*!
     \internal
 */
@@ -1159,7 +1202,7 @@ QTextStream::~QTextStream()
 #if defined (QTEXTSTREAM_DEBUG)
     qDebug("QTextStream::~QTextStream()");
 #endif
-    if (!d->writeBuffer.isEmpty())
+    if (!d->writeBuffer.isEmpty() || !d->encodedWriteBuffer.isEmpty())
         d->flushWriteBuffer();
 }
 
@@ -2290,6 +2333,20 @@ QTextStream &QTextStream::operator>>(QByteArray &array)
     return *this;
 }
 
+/*!
+    \overload
+    \since 6.0
+
+    Converts the word to UTF-8, then stores it in \a s.
+*/
+QTextStream &QTextStream::operator>>(QUtf8String &s)
+{
+    QString word;
+    *this >> word;
+    s = QUtf8String(word);
+    return *this;
+}
+
 /*!
     \overload
 
@@ -2648,6 +2705,28 @@ QTextStream &QTextStream::operator<<(const QByteArray &array)
     return *this;
 }
 
+/*!
+    \overload
+    \since 6.0
+
+    Writes \a string to the stream, and returns a reference to the
+    QTextStream.
+
+    If the stream operates on a device with the UTF-8 codec, the bytes of
+    \a string are written as they are, without a round trip through UTF-16,
+    unless a field width is set. Otherwise \a string is converted as if it
+    had been passed as a QString.
+
+    \sa setCodec()
+*/
+QTextStream &QTextStream::operator<<(const QUtf8String &string)
+{
+    Q_D(QTextStream);
+    CHECK_VALID_STREAM(*this);
+    d->putUtf8String(string);
+    return *this;
+}
+
 /*!
     \overload
 
@@ -3165,7 +3244,7 @@ bool QTextStream::autoDetectUnicode() const
 void QTextStream::setGenerateByteOrderMark(bool generate)
 {
     Q_D(QTextStream);
-    if (d->writeBuffer.isEmpty()) {
+    if (d->writeBuffer.isEmpty() && d->encodedWriteBuffer.isEmpty()) {
         d->writeConverterState.flags.setFlag(QTextCodec::IgnoreHeader, !generate);
     }
 }
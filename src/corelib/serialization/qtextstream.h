@@ -169,6 +169,7 @@ public:
     QTextStream &operator>>(double &f);
     QTextStream &operator>>(QString &s);
     QTextStream &operator>>(QByteArray &array);
+    QTextStream &operator>>(QUtf8String &s);
     QTextStream &operator>>(char *c);
 
     QTextStream &operator<<(QChar ch);
@@ -188,6 +189,7 @@ public:
     QTextStream &operator<<(QLatin1String s);
     QTextStream &operator<<(const QStringRef &s);
     QTextStream &operator<<(const QByteArray &array);
+    QTextStream &operator<<(const QUtf8String &s);
     QTextStream &operator<<(const char *c);
     QTextStream &operator<<(const void *ptr);
 
@@ -127,6 +127,7 @@ public:
 #endif
 
     QString writeBuffer;
+    QByteArray encodedWriteBuffer; // device bytes that precede writeBuffer
     QString readBuffer;
     int readBufferOffset;
     int readConverterSavedStateOffset; //the offset between readBufferStartDevicePos and that start of the buffer
@@ -181,6 +182,7 @@ public:
     inline void putString(const QString &ch, bool number = false) { putString(ch.constData(), ch.length(), number); }
     void putString(const QChar *data, int len, bool number = false);
     void putString(QLatin1String data, bool number = false);
+    void putUtf8String(const QUtf8String &data);
     inline void putChar(QChar ch);
     void putNumber(qulonglong number, bool negative);
 
@@ -42,6 +42,7 @@
 #ifndef QT_NO_XMLSTREAM
 
 #include "qxmlutils_p.h"
+#include <private/qsimd_p.h>
 #include <qdebug.h>
 #include <qfile.h>
 #include <stdio.h>
@@ -1143,6 +1144,85 @@ bool QXmlStreamReaderPrivate::scanAttType()
     return false;
 }
 
+/*!
+  \internal
+
+  Returns a pointer to the first character in [\a ptr, \a end) that the
+  fastScan functions need to look at individually: control characters
+  (including line breaks, which are counted), the non-characters U+FFFE and
+  U+FFFF, and the delimiters \a c1, \a c2, \a c3 and \a c4. Returns
+  \a end if there is no such character.
+ */
+static const ushort *findSpecialXmlChar(const ushort *ptr, const ushort *end,
+                                        ushort c1, ushort c2, ushort c3, ushort c4)
+{
+#ifdef __SSE2__
+    const __m128i controlLimit = _mm_set1_epi16(0x1f);
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i allOnes = _mm_set1_epi16(-1);
+    const __m128i zeroes = _mm_setzero_si128();
+    const __m128i delim1 = _mm_set1_epi16(short(c1));
+    const __m128i delim2 = _mm_set1_epi16(short(c2));
+    const __m128i delim3 = _mm_set1_epi16(short(c3));
+    const __m128i delim4 = _mm_set1_epi16(short(c4));
+    for ( ; ptr + 8 <= end; ptr += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        // c <= 0x1f  <=>  saturate(c - 0x1f) == 0
+        __m128i special = _mm_cmpeq_epi16(_mm_subs_epu16(data, controlLimit), zeroes);
+        // c >= 0xfffe  <=>  saturate(c + 1) == 0xffff
+        special = _mm_or_si128(special, _mm_cmpeq_epi16(_mm_adds_epu16(data, one), allOnes));
+        special = _mm_or_si128(special, _mm_cmpeq_epi16(data, delim1));
+        special = _mm_or_si128(special, _mm_cmpeq_epi16(data, delim2));
+        special = _mm_or_si128(special, _mm_cmpeq_epi16(data, delim3));
+        special = _mm_or_si128(special, _mm_cmpeq_epi16(data, delim4));
+        const uint mask = _mm_movemask_epi8(special);
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask) / 2;
+    }
+#endif
+    for ( ; ptr != end; ++ptr) {
+        const ushort c = *ptr;
+        if (c < 0x20 || c >= 0xfffe || c == c1 || c == c2 || c == c3 || c == c4)
+            return ptr;
+    }
+    return end;
+}
+
+/*!
+  \internal
+
+  Appends the longest run of characters at the current position of the
+  read buffer that the fastScan functions would copy unmodified into
+  textBuffer in one go, and returns its length. If \a inLiteral is true,
+  the run is part of an attribute value, otherwise of character content.
+ */
+inline int QXmlStreamReaderPrivate::fastScanPlainText(bool inLiteral)
+{
+    if (putStack.size())
+        return 0;
+
+    const ushort *begin = reinterpret_cast<const ushort *>(readBuffer.constData()) + readBufferPos;
+    const ushort *end = reinterpret_cast<const ushort *>(readBuffer.constData()) + readBuffer.size();
+    const ushort *stop = inLiteral
+            ? findSpecialXmlChar(begin, end, '&', '<', '\"', '\'')
+            : findSpecialXmlChar(begin, end, '&', '<', ']', ']');
+    const int n = int(stop - begin);
+    if (!n)
+        return 0;
+
+    if (!inLiteral && isWhitespace) {
+        for (const ushort *ptr = begin; ptr != stop; ++ptr) {
+            if (*ptr != ' ') {
+                isWhitespace = false;
+                break;
+            }
+        }
+    }
+    textBuffer.append(reinterpret_cast<const QChar *>(begin), n);
+    readBufferPos += n;
+    return n;
+}
+
 /*!
  \internal
 
@@ -1159,7 +1239,10 @@ inline int QXmlStreamReaderPrivate::fastScanLiteralContent()
 {
     int n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    for (;;) {
+        n += fastScanPlainText(true);
+        if ((c = getChar()) == StreamEOF)
+            break;
         switch (ushort(c)) {
         case 0xfffe:
         case 0xffff:
@@ -1242,7 +1325,10 @@ inline int QXmlStreamReaderPrivate::fastScanContentCharList()
 {
     int n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    for (;;) {
+        n += fastScanPlainText(false);
+        if ((c = getChar()) == StreamEOF)
+            break;
         switch (ushort(c)) {
         case 0xfffe:
         case 0xffff:
@@ -508,6 +508,7 @@ public:
     int fastScanContentCharList();
     int fastScanName(int *prefix = nullptr);
     inline int fastScanNMTOKEN();
+    inline int fastScanPlainText(bool inLiteral);
 
 
     bool parse();
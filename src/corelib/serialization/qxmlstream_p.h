@@ -997,6 +997,7 @@ public:
     int fastScanContentCharList();
     int fastScanName(int *prefix = nullptr);
     inline int fastScanNMTOKEN();
+    inline int fastScanPlainText(bool inLiteral);
 
 
     bool parse();
@@ -0,0 +1,159 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qahocorasick_p.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+
+    Removes all patterns, so that new ones can be added.
+*/
+void QAhoCorasick::clear()
+{
+    *this = QAhoCorasick();
+}
+
+/*!
+    \internal
+
+    Adds \a pattern, which must not be empty, to the needles. Occurrences of
+    it are reported with \a id. Several patterns may share the same id, and
+    the same pattern may be added with several ids.
+*/
+void QAhoCorasick::addPattern(QStringView pattern, int id)
+{
+    Q_ASSERT(!isBuilt);
+    Q_ASSERT(!pattern.isEmpty());
+
+    if (pendingOutputs.isEmpty())
+        pendingOutputs.resize(1); // the root
+
+    int state = 0;
+    for (QChar c : pattern) {
+        const quint64 key = quint64(state) << 16 | c.unicode();
+        auto it = trie.find(key);
+        if (it == trie.end()) {
+            it = trie.insert(key, pendingOutputs.size());
+            pendingOutputs.append(QVector<int>());
+        }
+        state = *it;
+    }
+    pendingOutputs[state].append(id);
+    ++patternCount;
+}
+
+/*!
+    \internal
+
+    Turns the trie of the added patterns into the automaton: lays out the
+    transitions of each node contiguously, sorted by character, and computes
+    the failure and output links breadth-first.
+*/
+void QAhoCorasick::build()
+{
+    Q_ASSERT(!isBuilt);
+
+    if (pendingOutputs.isEmpty())
+        pendingOutputs.resize(1);
+
+    const int count = pendingOutputs.size();
+    nodes.resize(count);
+
+    // sorting the (node << 16 | ch) keys groups the edges by node and orders
+    // them by character
+    QVector<quint64> keys;
+    keys.reserve(trie.size());
+    for (auto it = trie.cbegin(), end = trie.cend(); it != end; ++it)
+        keys.append(it.key());
+    std::sort(keys.begin(), keys.end());
+
+    edges.reserve(keys.size());
+    for (quint64 key : qAsConst(keys)) {
+        const int node = int(key >> 16);
+        if (nodes[node].edgeBegin == nodes[node].edgeEnd)
+            nodes[node].edgeBegin = edges.size();
+        edges.append({ ushort(key & 0xffff), trie.value(key) });
+        nodes[node].edgeEnd = edges.size();
+    }
+
+    for (int i = 0; i < count; ++i) {
+        nodes[i].outputBegin = outputIds.size();
+        outputIds += pendingOutputs.at(i);
+        nodes[i].outputEnd = outputIds.size();
+    }
+
+    QVector<int> queue;
+    queue.reserve(count);
+    for (int e = nodes[0].edgeBegin; e < nodes[0].edgeEnd; ++e)
+        queue.append(edges[e].target);  // failure and output links are the root
+
+    for (int i = 0; i < queue.size(); ++i) {
+        const int parent = queue.at(i);
+        for (int e = nodes[parent].edgeBegin; e < nodes[parent].edgeEnd; ++e) {
+            const ushort ch = edges[e].ch;
+            const int child = edges[e].target;
+
+            int fail = nodes[parent].fail;
+            int target;
+            while ((target = findEdge(fail, ch)) < 0 && fail)
+                fail = nodes[fail].fail;
+            Node &node = nodes[child];
+            node.fail = qMax(target, 0);
+
+            const Node &failNode = nodes[node.fail];
+            node.outputLink = failNode.outputBegin < failNode.outputEnd ? node.fail
+                                                                       : failNode.outputLink;
+            queue.append(child);
+        }
+    }
+
+    for (int ch = 0; ch < RootTableSize; ++ch)
+        rootTable[ch] = qMax(findEdge(0, ushort(ch)), 0);
+
+    trie.clear();
+    pendingOutputs.clear();
+    isBuilt = true;
+}
+
+QT_END_NAMESPACE
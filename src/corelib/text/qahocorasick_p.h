@@ -0,0 +1,177 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QAHOCORASICK_P_H
+#define QAHOCORASICK_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qstringview.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    An Aho-Corasick automaton over UTF-16 code units: finds all occurrences of
+    any number of needles in a single pass over the haystack.
+
+    Needles are added with addPattern(), then build() computes the failure
+    links; the automaton must not be modified after that, and can then be
+    searched from several threads at once.
+*/
+class Q_AUTOTEST_EXPORT QAhoCorasick
+{
+public:
+    void clear();
+    void addPattern(QStringView pattern, int id);
+    void build();
+
+    bool isEmpty() const { return patternCount == 0; }
+
+    // Calls callback(id, end) for every occurrence of a needle ending at
+    // haystack[end - 1], in order of end. Stops early if callback returns false.
+    template <typename Callback>
+    void search(QStringView haystack, Callback callback) const
+    {
+        int state = 0;
+        for (qsizetype i = 0; i < haystack.size(); ++i) {
+            state = nextState(state, haystack[i].unicode());
+            if (!reportMatches(state, i + 1, callback))
+                return;
+        }
+    }
+
+    // For searching input that is not a QStringView: feed the code units one
+    // by one to nextState(), starting with state 0, and call reportMatches()
+    // after each of them.
+    int nextState(int state, ushort ch) const
+    {
+        Q_ASSERT(isBuilt);
+        while (state) {
+            const int target = findEdge(state, ch);
+            if (target >= 0)
+                return target;
+            state = nodes[state].fail;
+        }
+        if (ch < RootTableSize)
+            return rootTable[ch];
+        const int target = findEdge(0, ch);
+        return target < 0 ? 0 : target;
+    }
+
+    template <typename Callback>
+    bool reportMatches(int state, qsizetype end, Callback callback) const
+    {
+        for (int s = nodes[state].outputBegin < nodes[state].outputEnd ? state : nodes[state].outputLink;
+             s > 0; s = nodes[s].outputLink) {
+            const Node &node = nodes[s];
+            for (int o = node.outputBegin; o < node.outputEnd; ++o) {
+                if (!callback(outputIds[o], end))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct Node
+    {
+        int edgeBegin = 0;
+        int edgeEnd = 0;
+        int fail = 0;
+        int outputBegin = 0;
+        int outputEnd = 0;
+        int outputLink = 0;     // nearest node with output on the failure chain, 0 if none
+    };
+    struct Edge
+    {
+        ushort ch;
+        int target;
+    };
+
+    int findEdge(int state, ushort ch) const
+    {
+        const Edge *begin = edges.constData() + nodes[state].edgeBegin;
+        const Edge *end = edges.constData() + nodes[state].edgeEnd;
+        // edges are sorted by character; most nodes have very few of them
+        while (end - begin > 8) {
+            const Edge *mid = begin + (end - begin) / 2;
+            if (mid->ch < ch)
+                begin = mid + 1;
+            else if (ch < mid->ch)
+                end = mid;
+            else
+                return mid->target;
+        }
+        for (; begin != end; ++begin) {
+            if (begin->ch == ch)
+                return begin->target;
+        }
+        return -1;
+    }
+
+    enum { RootTableSize = 256 };
+
+    // while adding patterns: (node << 16 | ch) -> child, and the ids per node
+    QHash<quint64, int> trie;
+    QVector<QVector<int>> pendingOutputs;
+
+    QVector<Node> nodes;
+    QVector<Edge> edges;
+    QVector<int> outputIds;
+    int rootTable[RootTableSize] = {};
+    int patternCount = 0;
+    bool isBuilt = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QAHOCORASICK_P_H
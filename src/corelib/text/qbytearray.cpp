@@ -2700,11 +2700,8 @@ int QByteArray::indexOf(char ch, int from) const
     if (from < 0)
         from = qMax(from + d->size, 0);
     if (from < d->size) {
-        const char *n = d->data() + from - 1;
-        const char *e = d->data() + d->size;
-        while (++n != e)
-        if (*n == ch)
-            return  n - d->data();
+        if (const void *n = memchr(d->data() + from, ch, d->size - from))
+            return static_cast<const char *>(n) - d->data();
     }
     return -1;
 }
@@ -39,7 +39,10 @@
 
 #include "qbytearraymatcher.h"
 
+#include <private/qsimd_p.h>
+
 #include <limits.h>
+#include <string.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -87,6 +90,113 @@ static inline int bm_find(const uchar *cc, int l, int index, const uchar *puc, u
     return -1; // not found
 }
 
+static int findChar(const char *str, int len, char ch, int from)
+{
+    const uchar *s = (const uchar *)str;
+    uchar c = (uchar)ch;
+    if (from < 0)
+        from = qMax(from + len, 0);
+    if (from < len) {
+        // memchr() is vectorized in all the C libraries we care about
+        if (const void *n = memchr(s + from, c, len - from))
+            return static_cast<const uchar *>(n) - s;
+    }
+    return -1;
+}
+
+/*
+    Returns the position of the first occurrence of \a needle (of length
+    \a pl, at least 2) in \a cc (of length \a l) at or after \a index, or -1.
+
+    A match at position i requires cc[i] to be the first byte of the needle
+    and cc[i + pl - 1] to be the last one. We test that for many positions at
+    once and only compare the positions that pass in full. For the needle
+    lengths commonly used, this is a lot faster than the Boyer-Moore skip loop
+    or a rolling hash.
+*/
+static int qt_find_filtered(const uchar *cc, int l, int index, const uchar *puc, int pl)
+{
+    Q_ASSERT(pl >= 2);
+    if (index < 0)
+        index = 0;
+    if (l - index < pl)
+        return -1;
+
+    const uchar *haystack = cc + index;
+    const qsizetype count = l - index - pl + 1;
+    const uchar firstByte = puc[0];
+    const uchar lastByte = puc[pl - 1];
+    const uchar *first = haystack;
+    const uchar *last = haystack + pl - 1;
+    // the first and last bytes are checked by the filter
+    auto verify = [=](qsizetype i) {
+        return memcmp(haystack + i + 1, puc + 1, pl - 2) == 0;
+    };
+    auto found = [=](qsizetype i) { return int(index + i); };
+
+    qsizetype i = 0;
+#if defined(__SSE2__)
+    // Using the PMOVMSKB instruction, we get one bit for each position
+    auto checkCandidates = [&](uint mask) -> qsizetype {
+        while (mask) {
+            const uint idx = qCountTrailingZeroBits(mask);
+            if (verify(i + idx))
+                return i + idx;
+            mask &= mask - 1;
+        }
+        return -1;
+    };
+
+#  if defined(__AVX2__) && !defined(__OPTIMIZE_SIZE__)
+    // we're going to read first[i..i+31] and last[i..i+31]
+    const __m256i first256 = _mm256_set1_epi8(char(firstByte));
+    const __m256i last256 = _mm256_set1_epi8(char(lastByte));
+    for ( ; i + 32 <= count; i += 32) {
+        const __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(last + i));
+        const __m256i result = _mm256_and_si256(_mm256_cmpeq_epi8(f, first256),
+                                                _mm256_cmpeq_epi8(b, last256));
+        const qsizetype idx = checkCandidates(uint(_mm256_movemask_epi8(result)));
+        if (idx >= 0)
+            return found(idx);
+    }
+#  endif
+
+    // we're going to read first[i..i+15] and last[i..i+15]
+    const __m128i first128 = _mm_set1_epi8(char(firstByte));
+    const __m128i last128 = _mm_set1_epi8(char(lastByte));
+    for ( ; i + 16 <= count; i += 16) {
+        const __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(last + i));
+        const __m128i result = _mm_and_si128(_mm_cmpeq_epi8(f, first128),
+                                             _mm_cmpeq_epi8(b, last128));
+        const qsizetype idx = checkCandidates(uint(_mm_movemask_epi8(result)));
+        if (idx >= 0)
+            return found(idx);
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) // vmaxv is only available on Aarch64
+    const uint8x16_t first128 = vdupq_n_u8(firstByte);
+    const uint8x16_t last128 = vdupq_n_u8(lastByte);
+    for ( ; i + 16 <= count; i += 16) {
+        const uint8x16_t result = vandq_u8(vceqq_u8(vld1q_u8(first + i), first128),
+                                           vceqq_u8(vld1q_u8(last + i), last128));
+        if (vmaxvq_u8(result)) {
+            // rare enough that the scalar check below is good enough
+            for (qsizetype j = i; j < i + 16; ++j) {
+                if (first[j] == firstByte && last[j] == lastByte && verify(j))
+                    return found(j);
+            }
+        }
+    }
+#endif
+
+    for ( ; i < count; ++i) {
+        if (first[i] == firstByte && last[i] == lastByte && verify(i))
+            return found(i);
+    }
+    return -1;
+}
+
 /*! \class QByteArrayMatcher
     \inmodule QtCore
     \brief The QByteArrayMatcher class holds a sequence of bytes that
@@ -200,6 +310,11 @@ int QByteArrayMatcher::indexIn(const QByteArray &ba, int from) const
 {
     if (from < 0)
         from = 0;
+    if (p.l == 1)
+        return findChar(ba.constData(), ba.size(), char(*p.p), from);
+    if (p.l >= 2)
+        return qt_find_filtered(reinterpret_cast<const uchar *>(ba.constData()), ba.size(), from,
+                                p.p, p.l);
     return bm_find(reinterpret_cast<const uchar *>(ba.constData()), ba.size(), from,
                    p.p, p.l, p.q_skiptable);
 }
@@ -215,6 +330,10 @@ int QByteArrayMatcher::indexIn(const char *str, int len, int from) const
 {
     if (from < 0)
         from = 0;
+    if (p.l == 1)
+        return findChar(str, len, char(*p.p), from);
+    if (p.l >= 2)
+        return qt_find_filtered(reinterpret_cast<const uchar *>(str), len, from, p.p, p.l);
     return bm_find(reinterpret_cast<const uchar *>(str), len, from,
                    p.p, p.l, p.q_skiptable);
 }
@@ -229,42 +348,6 @@ int QByteArrayMatcher::indexIn(const char *str, int len, int from) const
 */
 
 
-static int findChar(const char *str, int len, char ch, int from)
-{
-    const uchar *s = (const uchar *)str;
-    uchar c = (uchar)ch;
-    if (from < 0)
-        from = qMax(from + len, 0);
-    if (from < len) {
-        const uchar *n = s + from - 1;
-        const uchar *e = s + len;
-        while (++n != e)
-            if (*n == c)
-                return  n - s;
-    }
-    return -1;
-}
-
-/*!
-    \internal
- */
-static int qFindByteArrayBoyerMoore(
-    const char *haystack, int haystackLen, int haystackOffset,
-    const char *needle, int needleLen)
-{
-    uchar skiptable[256];
-    bm_init_skiptable((const uchar *)needle, needleLen, skiptable);
-    if (haystackOffset < 0)
-        haystackOffset = 0;
-    return bm_find((const uchar *)haystack, haystackLen, haystackOffset,
-                   (const uchar *)needle, needleLen, skiptable);
-}
-
-#define REHASH(a) \
-    if (sl_minus_1 < sizeof(uint) * CHAR_BIT) \
-        hashHaystack -= uint(a) << sl_minus_1; \
-    hashHaystack <<= 1
-
 /*!
     \internal
  */
@@ -286,41 +369,8 @@ int qFindByteArray(
     if (sl == 1)
         return findChar(haystack0, haystackLen, needle[0], from);
 
-    /*
-      We use the Boyer-Moore algorithm in cases where the overhead
-      for the skip table should pay off, otherwise we use a simple
-      hash function.
-    */
-    if (l > 500 && sl > 5)
-        return qFindByteArrayBoyerMoore(haystack0, haystackLen, from,
-                                        needle, needleLen);
-
-    /*
-      We use some hashing for efficiency's sake. Instead of
-      comparing strings, we compare the hash value of str with that
-      of a part of this QString. Only if that matches, we call memcmp().
-    */
-    const char *haystack = haystack0 + from;
-    const char *end = haystack0 + (l - sl);
-    const uint sl_minus_1 = sl - 1;
-    uint hashNeedle = 0, hashHaystack = 0;
-    int idx;
-    for (idx = 0; idx < sl; ++idx) {
-        hashNeedle = ((hashNeedle<<1) + needle[idx]);
-        hashHaystack = ((hashHaystack<<1) + haystack[idx]);
-    }
-    hashHaystack -= *(haystack + sl_minus_1);
-
-    while (haystack <= end) {
-        hashHaystack += *(haystack + sl_minus_1);
-        if (hashHaystack == hashNeedle && *needle == *haystack
-             && memcmp(needle, haystack, sl) == 0)
-            return haystack - haystack0;
-
-        REHASH(*haystack);
-        ++haystack;
-    }
-    return -1;
+    return qt_find_filtered(reinterpret_cast<const uchar *>(haystack0), haystackLen, from,
+                            reinterpret_cast<const uchar *>(needle), needleLen);
 }
 
 /*!
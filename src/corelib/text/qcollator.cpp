@@ -43,6 +43,7 @@
 #include "qstring.h"
 
 #include "qdebug.h"
+#include "qendian.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -354,9 +355,23 @@ int QCollator::compare(const QChar *s1, int len1, const QChar *s2, int len2) con
 }
 #endif // QT_STRINGVIEW_LEVEL < 2
 
-/*!
-    \fn QCollatorSortKey QCollator::sortKey(const QString &string) const
+/*
+    Keys for the C locale, whose comparison, s1.compare(s2, caseSensitivity), is
+    done on (case folded) UTF-16 code units; stored big-endian, their bytes
+    compare the same way.
+*/
+QByteArray QCollatorPrivate::cSortKey(QStringView string) const
+{
+    const QString folded = caseSensitivity == Qt::CaseInsensitive
+            ? string.toString().toCaseFolded() : QString();
+    if (!folded.isNull())
+        string = folded;
+    QByteArray key(int(string.size()) * 2, Qt::Uninitialized);
+    qToBigEndian<ushort>(string.data(), string.size(), key.data());
+    return key;
+}
 
+/*!
     Returns a sortKey for \a string.
 
     Creating the sort key is usually somewhat slower, than using the compare()
@@ -365,7 +380,39 @@ int QCollator::compare(const QChar *s1, int len1, const QChar *s2, int len2) con
     keys for each string and then sort using the keys.
 
     \note Not supported with the C (a.k.a. POSIX) locale on Darwin.
+
+    \sa sortKeys()
  */
+QCollatorSortKey QCollator::sortKey(const QString &string) const
+{
+    if (d->dirty)
+        d->init();
+    return QCollatorSortKey(new QCollatorSortKeyPrivate(d->sortKey(string)));
+}
+
+/*!
+    \since 6.0
+
+    Returns the sort keys for all of \a strings, in the same order.
+
+    This is equivalent to calling sortKey() for each of the strings, but
+    prepares the collator only once for the whole batch.
+
+    \snippet code/src_corelib_text_qcollator.cpp 0
+
+    \sa sortKey()
+ */
+QVector<QCollatorSortKey> QCollator::sortKeys(const QStringList &strings) const
+{
+    if (d->dirty)
+        d->init();
+
+    QVector<QCollatorSortKey> keys;
+    keys.reserve(strings.size());
+    for (const QString &string : strings)
+        keys.append(QCollatorSortKey(new QCollatorSortKeyPrivate(d->sortKey(string))));
+    return keys;
+}
 
 /*!
     \class QCollatorSortKey
@@ -377,6 +424,12 @@ int QCollator::compare(const QChar *s1, int len1, const QChar *s2, int len2) con
     The QCollatorSortKey class is always created by QCollator::sortKey() and is
     used for fast strings collation, for example when collating many strings.
 
+    Since Qt 6.0 a sort key is a plain sequence of bytes, on all platforms:
+    two keys made by the same collator compare, byte by byte with memcmp(),
+    the same way their strings do. toByteArray() gives access to those bytes,
+    so that they can be stored compactly or handed to code that only knows
+    how to compare binary data, such as a database index.
+
     \reentrant
     \ingroup i18n
     \ingroup string-processing
@@ -442,8 +495,6 @@ QCollatorSortKey& QCollatorSortKey::operator=(const QCollatorSortKey &other)
 */
 
 /*!
-    \fn int QCollatorSortKey::compare(const QCollatorSortKey &otherKey) const
-
     Compares this key to \a otherKey.
 
     Returns a negative value if the key is less than \a otherKey, 0 if the key
@@ -452,5 +503,22 @@ QCollatorSortKey& QCollatorSortKey::operator=(const QCollatorSortKey &other)
 
     \sa operator<()
  */
+int QCollatorSortKey::compare(const QCollatorSortKey &otherKey) const
+{
+    return qstrcmp(d->m_key, otherKey.d->m_key);
+}
+
+/*!
+    \since 6.0
+
+    Returns the bytes of this key. Comparing the byte arrays of two keys made
+    by the same collator, with memcmp() on their common length and the shorter
+    one ordered first on a tie (as qstrcmp() does), gives the same result as
+    compare().
+ */
+QByteArray QCollatorSortKey::toByteArray() const
+{
+    return d->m_key;
+}
 
 QT_END_NAMESPACE
@@ -63,6 +63,7 @@ public:
     { d.swap(other.d); }
 
     int compare(const QCollatorSortKey &key) const;
+    QByteArray toByteArray() const;
 
 protected:
     QCollatorSortKey(QCollatorSortKeyPrivate*);
@@ -120,6 +121,7 @@ public:
     { return compare(s1, s2) < 0; }
 
     QCollatorSortKey sortKey(const QString &string) const;
+    QVector<QCollatorSortKey> sortKeys(const QStringList &strings) const;
 
 private:
     QCollatorPrivate *d;
@@ -123,32 +123,26 @@ int QCollator::compare(QStringView s1, QStringView s2) const
                                    d->caseSensitivity);
 }
 
-QCollatorSortKey QCollator::sortKey(const QString &string) const
+QByteArray QCollatorPrivate::sortKey(QStringView string)
 {
-    if (d->dirty)
-        d->init();
-    if (d->isC())
-        return QCollatorSortKey(new QCollatorSortKeyPrivate(string.toUtf8()));
+    if (isC())
+        return cSortKey(string);
 
-    if (d->collator) {
+    if (collator) {
         QByteArray result(16 + string.size() + (string.size() >> 2), Qt::Uninitialized);
-        int size = ucol_getSortKey(d->collator, (const UChar *)string.constData(),
+        int size = ucol_getSortKey(collator, (const UChar *)string.data(),
                                    string.size(), (uint8_t *)result.data(), result.size());
         if (size > result.size()) {
             result.resize(size);
-            size = ucol_getSortKey(d->collator, (const UChar *)string.constData(),
+            size = ucol_getSortKey(collator, (const UChar *)string.data(),
                                    string.size(), (uint8_t *)result.data(), result.size());
         }
-        result.truncate(size);
-        return QCollatorSortKey(new QCollatorSortKeyPrivate(std::move(result)));
+        // drop the terminating '\0', which never occurs inside a key
+        result.truncate(size - 1);
+        return result;
     }
 
-    return QCollatorSortKey(new QCollatorSortKeyPrivate(QByteArray()));
-}
-
-int QCollatorSortKey::compare(const QCollatorSortKey &otherKey) const
-{
-    return qstrcmp(d->m_key, otherKey.d->m_key);
+    return QByteArray();
 }
 
 QT_END_NAMESPACE
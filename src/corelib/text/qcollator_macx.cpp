@@ -49,6 +49,7 @@
 
 #include <cstring>
 #include <QDebug>
+#include <QtCore/qendian.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -111,42 +112,31 @@ int QCollator::compare(QStringView s1, QStringView s2) const
     return result < 0 ? -1 : 1;
 }
 
-QCollatorSortKey QCollator::sortKey(const QString &string) const
+QByteArray QCollatorPrivate::sortKey(QStringView string)
 {
-    if (d->dirty)
-        d->init();
-    if (!d->collator) {
+    if (!collator) {
         // What should (or even *can*) we do here ? (See init()'s comment.)
         qWarning("QCollator doesn't support sort keys for the C locale on Darwin");
-        return QCollatorSortKey(nullptr);
+        return QByteArray();
     }
 
     //Documentation recommends having it 5 times as big as the input
-    QVector<UCCollationValue> ret(string.size() * 5);
+    QVarLengthArray<UCCollationValue> key(string.size() * 5);
     ItemCount actualSize;
-    int status = UCGetCollationKey(d->collator,
-                                   reinterpret_cast<const UniChar *>(string.constData()),
-                                   string.count(), ret.size(), &actualSize, ret.data());
+    int status = UCGetCollationKey(collator,
+                                   reinterpret_cast<const UniChar *>(string.data()),
+                                   string.size(), key.size(), &actualSize, key.data());
 
-    ret.resize(actualSize + 1);
     if (status == kUCOutputBufferTooSmall) {
-        UCGetCollationKey(d->collator, reinterpret_cast<const UniChar *>(string.constData()),
-                          string.count(), ret.size(), &actualSize, ret.data());
+        key.resize(actualSize);
+        UCGetCollationKey(collator, reinterpret_cast<const UniChar *>(string.data()),
+                          string.size(), key.size(), &actualSize, key.data());
     }
-    ret[actualSize] = 0;
-    return QCollatorSortKey(new QCollatorSortKeyPrivate(std::move(ret)));
-}
-
-int QCollatorSortKey::compare(const QCollatorSortKey &key) const
-{
-    if (!d.data())
-        return 0;
 
-    SInt32 order;
-    UCCompareCollationKeys(d->m_key.data(), d->m_key.size(),
-                           key.d->m_key.data(), key.d->m_key.size(),
-                           0, &order);
-    return order;
+    // Collation values compare in sequence; stored big-endian, their bytes do too
+    QByteArray ret(int(actualSize * sizeof(UCCollationValue)), Qt::Uninitialized);
+    qToBigEndian<UCCollationValue>(key.constData(), actualSize, ret.data());
+    return ret;
 }
 
 QT_END_NAMESPACE
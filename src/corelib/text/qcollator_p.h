@@ -67,16 +67,13 @@ QT_BEGIN_NAMESPACE
 
 #if QT_CONFIG(icu)
 typedef UCollator *CollatorType;
-typedef QByteArray CollatorKeyType;
 const CollatorType NoCollator = nullptr;
 
 #elif defined(Q_OS_OSX)
 typedef CollatorRef CollatorType;
-typedef QVector<UCCollationValue> CollatorKeyType;
 const CollatorType NoCollator = 0;
 
 #elif defined(Q_OS_WIN)
-typedef QString CollatorKeyType;
 typedef int CollatorType;
 const CollatorType NoCollator = 0;
 #  ifdef Q_OS_WINRT
@@ -84,7 +81,6 @@ const CollatorType NoCollator = 0;
 #  endif
 
 #else // posix - ignores CollatorType collator, only handles system locale
-typedef QVector<wchar_t> CollatorKeyType;
 typedef bool CollatorType;
 const CollatorType NoCollator = false;
 #endif
@@ -120,6 +116,10 @@ public:
     // Implemented by each back-end, in its own way:
     void init();
     void cleanup();
+    // Returns a key whose bytes compare, with memcmp(), as the string collates
+    QByteArray sortKey(QStringView string);
+    // The same, for the C locale's code unit order; shared by the back-ends
+    QByteArray cSortKey(QStringView string) const;
 
 private:
     Q_DISABLE_COPY_MOVE(QCollatorPrivate)
@@ -136,7 +136,7 @@ public:
     {
     }
 
-    CollatorKeyType m_key;
+    QByteArray m_key;
 
 private:
     Q_DISABLE_COPY_MOVE(QCollatorSortKeyPrivate)
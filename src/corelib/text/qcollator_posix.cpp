@@ -86,31 +86,55 @@ int QCollator::compare(QStringView s1, QStringView s2) const
     return std::wcscoll(array1.constData(), array2.constData());
 }
 
-QCollatorSortKey QCollator::sortKey(const QString &string) const
+/*
+    Encodes the wchar_t values of a key such that memcmp() orders the bytes as
+    wcscmp() orders the values. Like in UTF-8 the first byte determines the
+    length of a value's encoding, and longer encodings stand for larger values,
+    so that the common small values take a single byte rather than
+    sizeof(wchar_t).
+*/
+static QByteArray toOrderedBytes(const wchar_t *key, qsizetype size)
 {
-    if (d->dirty)
-        d->init();
-
-    QVarLengthArray<wchar_t> original;
-    stringToWCharArray(original, string);
-    QVector<wchar_t> result(original.size());
-    if (d->isC()) {
-        std::copy(original.cbegin(), original.cend(), result.begin());
-    } else {
-        size_t size = std::wcsxfrm(result.data(), original.constData(), string.size());
-        if (size > uint(result.size())) {
-            result.resize(size+1);
-            size = std::wcsxfrm(result.data(), original.constData(), string.size());
+    QByteArray result;
+    result.reserve(size + size / 2);
+    for (qsizetype i = 0; i < size; ++i) {
+        uint v = uint(key[i]);
+        if (v < 0x80) {
+            result.append(char(v));
+        } else if ((v -= 0x80) < 0x4000) {
+            result.append(char(0x80 | (v >> 8)));
+            result.append(char(v));
+        } else if ((v -= 0x4000) < 0x200000) {
+            result.append(char(0xc0 | (v >> 16)));
+            result.append(char(v >> 8));
+            result.append(char(v));
+        } else {
+            v = uint(key[i]);
+            result.append(char(0xe0));
+            result.append(char(v >> 24));
+            result.append(char(v >> 16));
+            result.append(char(v >> 8));
+            result.append(char(v));
         }
-        result.resize(size+1);
-        result[size] = 0;
     }
-    return QCollatorSortKey(new QCollatorSortKeyPrivate(std::move(result)));
+    return result;
 }
 
-int QCollatorSortKey::compare(const QCollatorSortKey &otherKey) const
+QByteArray QCollatorPrivate::sortKey(QStringView string)
 {
-    return std::wcscmp(d->m_key.constData(), otherKey.d->m_key.constData());
+    if (isC())
+        return cSortKey(string);
+
+    QVarLengthArray<wchar_t> original;
+    stringToWCharArray(original, string);
+
+    QVarLengthArray<wchar_t> result(original.size());
+    size_t size = std::wcsxfrm(result.data(), original.constData(), result.size());
+    if (size >= size_t(result.size())) {
+        result.resize(int(size) + 1);
+        size = std::wcsxfrm(result.data(), original.constData(), result.size());
+    }
+    return toOrderedBytes(result.constData(), qsizetype(size));
 }
 
 QT_END_NAMESPACE
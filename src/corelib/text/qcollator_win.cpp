@@ -132,30 +132,29 @@ int QCollator::compare(QStringView s1, QStringView s2) const
     return 0;
 }
 
-QCollatorSortKey QCollator::sortKey(const QString &string) const
+QByteArray QCollatorPrivate::sortKey(QStringView string)
 {
-    if (d->dirty)
-        d->init();
-    if (d->isC())
-        return QCollatorSortKey(new QCollatorSortKeyPrivate(string));
+    if (isC())
+        return cSortKey(string);
 
+    // With LCMAP_SORTKEY the destination is a byte array and sizes are in bytes
 #ifndef USE_COMPARESTRINGEX
-    int size = LCMapStringW(d->localeID, LCMAP_SORTKEY | d->collator,
-                           reinterpret_cast<const wchar_t*>(string.constData()), string.size(),
+    int size = LCMapStringW(localeID, LCMAP_SORTKEY | collator,
+                           reinterpret_cast<const wchar_t*>(string.data()), string.size(),
                            0, 0);
 #else
-    int size = LCMapStringEx(LPCWSTR(d->localeName.utf16()), LCMAP_SORTKEY | d->collator,
-                           reinterpret_cast<LPCWSTR>(string.constData()), string.size(),
+    int size = LCMapStringEx(LPCWSTR(localeName.utf16()), LCMAP_SORTKEY | collator,
+                           reinterpret_cast<LPCWSTR>(string.data()), string.size(),
                            0, 0, NULL, NULL, 0);
 #endif
-    QString ret(size, Qt::Uninitialized);
+    QByteArray ret(size, Qt::Uninitialized);
 #ifndef USE_COMPARESTRINGEX
-    int finalSize = LCMapStringW(d->localeID, LCMAP_SORTKEY | d->collator,
-                           reinterpret_cast<const wchar_t*>(string.constData()), string.size(),
+    int finalSize = LCMapStringW(localeID, LCMAP_SORTKEY | collator,
+                           reinterpret_cast<const wchar_t*>(string.data()), string.size(),
                            reinterpret_cast<wchar_t*>(ret.data()), ret.size());
 #else
-    int finalSize = LCMapStringEx(LPCWSTR(d->localeName.utf16()), LCMAP_SORTKEY | d->collator,
-                           reinterpret_cast<LPCWSTR>(string.constData()), string.size(),
+    int finalSize = LCMapStringEx(LPCWSTR(localeName.utf16()), LCMAP_SORTKEY | collator,
+                           reinterpret_cast<LPCWSTR>(string.data()), string.size(),
                            reinterpret_cast<LPWSTR>(ret.data()), ret.size(),
                            NULL, NULL, 0);
 #endif
@@ -164,12 +163,9 @@ QCollatorSortKey QCollator::sortKey(const QString &string) const
             << "there were problems when generating the ::sortKey by LCMapStringW with error:"
             << GetLastError();
     }
-    return QCollatorSortKey(new QCollatorSortKeyPrivate(std::move(ret)));
-}
-
-int QCollatorSortKey::compare(const QCollatorSortKey &otherKey) const
-{
-    return d->m_key.compare(otherKey.d->m_key);
+    // drop the terminating '\0', which never occurs inside a key
+    ret.truncate(qMax(finalSize - 1, 0));
+    return ret;
 }
 
 QT_END_NAMESPACE
@@ -2602,21 +2602,20 @@ static char qToLower(char c)
         return c;
 }
 
-/*!
-    \overload
-
-    \a f and \a prec have the same meaning as in QString::number(double, char, int).
-
-    \sa toDouble()
-*/
+typedef QVarLengthArray<QChar, 64> NumberBuffer;
+static QStringView formatDouble(NumberBuffer &buffer, const QChar zero, const QChar plus,
+                                const QChar minus, const QChar exponential, const QChar group,
+                                const QChar decimal, double d, int precision,
+                                QLocaleData::DoubleForm form, int width, unsigned flags);
 
-QString QLocale::toString(double i, char f, int prec) const
+static QLocaleData::DoubleForm doubleFormAndFlags(char f, QLocale::NumberOptions options,
+                                                  uint *flags)
 {
     QLocaleData::DoubleForm form = QLocaleData::DFDecimal;
-    uint flags = 0;
+    *flags = 0;
 
     if (qIsUpper(f))
-        flags = QLocaleData::CapitalEorX;
+        *flags = QLocaleData::CapitalEorX;
     f = qToLower(f);
 
     switch (f) {
@@ -2633,15 +2632,102 @@ QString QLocale::toString(double i, char f, int prec) const
             break;
     }
 
-    if (!(d->m_numberOptions & OmitGroupSeparator))
-        flags |= QLocaleData::ThousandsGroup;
-    if (!(d->m_numberOptions & OmitLeadingZeroInExponent))
-        flags |= QLocaleData::ZeroPadExponent;
-    if (d->m_numberOptions & IncludeTrailingZeroesAfterDot)
-        flags |= QLocaleData::AddTrailingZeroes;
+    if (!(options & QLocale::OmitGroupSeparator))
+        *flags |= QLocaleData::ThousandsGroup;
+    if (!(options & QLocale::OmitLeadingZeroInExponent))
+        *flags |= QLocaleData::ZeroPadExponent;
+    if (options & QLocale::IncludeTrailingZeroesAfterDot)
+        *flags |= QLocaleData::AddTrailingZeroes;
+    return form;
+}
+
+/*!
+    \overload
+
+    \a f and \a prec have the same meaning as in QString::number(double, char, int).
+
+    \sa toDouble()
+*/
+
+QString QLocale::toString(double i, char f, int prec) const
+{
+    uint flags;
+    const QLocaleData::DoubleForm form = doubleFormAndFlags(f, d->m_numberOptions, &flags);
     return d->m_data->doubleToString(i, prec, form, -1, flags);
 }
 
+/*!
+    \since 6.0
+
+    Appends localized string representations of the \a count integers
+    starting at \a values to \a str, with \a separator between each two of
+    them, and returns a reference to \a str.
+
+    The result is the same as appending toString() of each value in turn,
+    but the numbers are formatted straight into \a str, without creating a
+    temporary string for each of them. This makes the function suitable for
+    producing large amounts of numeric output, such as CSV exports:
+
+    \snippet code/src_corelib_tools_qlocale.cpp 4
+
+    \sa toString()
+*/
+QString &QLocale::appendNumbers(QString &str, const qlonglong *values, qsizetype count,
+                                QStringView separator) const
+{
+    const QLocaleData *data = d->m_data;
+    const bool grouped = !(d->m_numberOptions & OmitGroupSeparator);
+    QChar buff[28]; // sign, 20 digits and 6 group separators
+    QChar *const end = buff + sizeof(buff) / sizeof(buff[0]);
+
+    for (qsizetype i = 0; i < count; ++i) {
+        if (i)
+            str.append(separator.data(), int(separator.size()));
+        const qlonglong l = values[i];
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_MSVC(4146)
+        QChar *p = qulltoaDecimal(end, l < 0 ? -qulonglong(l) : qulonglong(l),
+                                  data->m_zero, data->m_group, grouped);
+QT_WARNING_POP
+        if (l < 0)
+            *--p = data->m_minus;
+        str.append(p, int(end - p));
+    }
+    return str;
+}
+
+/*!
+    \since 6.0
+    \overload
+
+    Appends localized string representations of the \a count doubles
+    starting at \a values to \a str, with \a separator between each two of
+    them, and returns a reference to \a str. \a f and \a prec have the same
+    meaning as in toString(double, char, int).
+
+    Only one scratch buffer is used for all the numbers, and each result is
+    written straight into \a str.
+*/
+QString &QLocale::appendNumbers(QString &str, const double *values, qsizetype count,
+                                QStringView separator, char f, int prec) const
+{
+    const QLocaleData *data = d->m_data;
+    uint flags;
+    const QLocaleData::DoubleForm form = doubleFormAndFlags(f, d->m_numberOptions, &flags);
+    NumberBuffer buffer;
+
+    for (qsizetype i = 0; i < count; ++i) {
+        if (i)
+            str.append(separator.data(), int(separator.size()));
+        const QStringView number =
+                formatDouble(buffer, data->m_zero, data->m_plus, data->m_minus,
+                             data->m_exponential, data->m_group, data->m_decimal,
+                             values[i], prec, form, -1, flags);
+        str.append(number.data(), int(number.size()));
+    }
+    return str;
+}
+
 /*!
     \fn QLocale QLocale::c()
 
@@ -3466,17 +3552,16 @@ QString QCalendarBackend::dateTimeToString(QStringView format, const QDateTime &
 
 // End of QCalendar intrustions
 
-QString QLocaleData::doubleToString(double d, int precision, DoubleForm form,
-                                    int width, unsigned flags) const
-{
-    return doubleToString(m_zero, m_plus, m_minus, m_exponential, m_group, m_decimal,
-                          d, precision, form, width, flags);
-}
-
-QString QLocaleData::doubleToString(const QChar _zero, const QChar plus, const QChar minus,
-                                    const QChar exponential, const QChar group, const QChar decimal,
-                                    double d, int precision, DoubleForm form, int width,
-                                    unsigned flags)
+/*
+    Formats \a d into \a buffer and returns the part of it holding the result.
+    All the pieces are written straight into the one buffer, so that formatting
+    many numbers in a row (see QLocale::appendNumbers()) needs no allocation
+    beyond the first.
+*/
+static QStringView formatDouble(NumberBuffer &buffer, const QChar zero, const QChar plus,
+                         const QChar minus, const QChar exponential, const QChar group,
+                         const QChar decimal, double d, int precision,
+                         QLocaleData::DoubleForm form, int width, unsigned flags)
 {
     if (precision != QLocale::FloatingPointShortest && precision < 0)
         precision = 6;
@@ -3484,14 +3569,12 @@ QString QLocaleData::doubleToString(const QChar _zero, const QChar plus, const Q
         width = 0;
 
     bool negative = false;
-    QString num_str;
-
     int decpt;
     int bufSize = 1;
     if (precision == QLocale::FloatingPointShortest)
-        bufSize += DoubleMaxSignificant;
-    else if (form == DFDecimal) // optimize for numbers between -512k and 512k
-        bufSize += ((d > (1 << 19) || d < -(1 << 19)) ? DoubleMaxDigitsBeforeDecimal : 6) +
+        bufSize += QLocaleData::DoubleMaxSignificant;
+    else if (form == QLocaleData::DFDecimal) // optimize for numbers between -512k and 512k
+        bufSize += ((d > (1 << 19) || d < -(1 << 19)) ? QLocaleData::DoubleMaxDigitsBeforeDecimal : 6) +
                 precision;
     else // Add extra digit due to different interpretations of precision. Also, "nan" has to fit.
         bufSize += qMax(2, precision) + 1;
@@ -3501,56 +3584,55 @@ QString QLocaleData::doubleToString(const QChar _zero, const QChar plus, const Q
 
     qt_doubleToAscii(d, form, precision, buf.data(), bufSize, negative, length, decpt);
 
+    // sign, leading zero, decimal point, exponent, digits with group separators and padding
+    const int maxDigits = qMax(length, qAbs(decpt)) + length + qMax(precision, 0) + 1;
+    buffer.resize(8 + maxDigits + maxDigits / 3 + width);
+    QChar *const begin = buffer.data();
+    QChar *out = begin + 1; // leave room for the sign
+
     if (qstrncmp(buf.data(), "inf", 3) == 0 || qstrncmp(buf.data(), "nan", 3) == 0) {
-        num_str = QString::fromLatin1(buf.data(), length);
+        for (int i = 0; i < length; ++i)
+            *out++ = QLatin1Char(buf[i]);
     } else { // Handle normal numbers
-        QString digits = QString::fromLatin1(buf.data(), length);
-
-        if (_zero.unicode() != '0') {
-            ushort z = _zero.unicode() - '0';
-            for (int i = 0; i < digits.length(); ++i)
-                reinterpret_cast<ushort *>(digits.data())[i] += z;
-        }
-
-        bool always_show_decpt = (flags & ForcePoint);
+        bool always_show_decpt = (flags & QLocaleData::ForcePoint);
         switch (form) {
-            case DFExponent: {
-                num_str = exponentForm(_zero, decimal, exponential, group, plus, minus,
-                                       digits, decpt, precision, PMDecimalDigits,
-                                       always_show_decpt, flags & ZeroPadExponent);
+            case QLocaleData::DFExponent: {
+                out = exponentForm(out, zero, decimal, exponential, plus, minus,
+                                   buf.data(), length, decpt, precision, PMDecimalDigits,
+                                   always_show_decpt, flags & QLocaleData::ZeroPadExponent);
                 break;
             }
-            case DFDecimal: {
-                num_str = decimalForm(_zero, decimal, group,
-                                      digits, decpt, precision, PMDecimalDigits,
-                                      always_show_decpt, flags & ThousandsGroup);
+            case QLocaleData::DFDecimal: {
+                out = decimalForm(out, zero, decimal, group,
+                                  buf.data(), length, decpt, precision, PMDecimalDigits,
+                                  always_show_decpt, flags & QLocaleData::ThousandsGroup);
                 break;
             }
-            case DFSignificantDigits: {
-                PrecisionMode mode = (flags & AddTrailingZeroes) ?
+            case QLocaleData::DFSignificantDigits: {
+                PrecisionMode mode = (flags & QLocaleData::AddTrailingZeroes) ?
                             PMSignificantDigits : PMChopTrailingZeros;
 
                 int cutoff = precision < 0 ? 6 : precision;
                 // Find out which representation is shorter
                 if (precision == QLocale::FloatingPointShortest && decpt > 0) {
-                    cutoff = digits.length() + 4; // 'e', '+'/'-', one digit exponent
+                    cutoff = length + 4; // 'e', '+'/'-', one digit exponent
                     if (decpt <= 10) {
                         ++cutoff;
                     } else {
                         cutoff += decpt > 100 ? 2 : 1;
                     }
-                    if (!always_show_decpt && digits.length() > decpt)
+                    if (!always_show_decpt && length > decpt)
                         ++cutoff; // decpt shown in exponent form, but not in decimal form
                 }
 
-                if (decpt != digits.length() && (decpt <= -4 || decpt > cutoff))
-                    num_str = exponentForm(_zero, decimal, exponential, group, plus, minus,
-                                           digits, decpt, precision, mode,
-                                           always_show_decpt, flags & ZeroPadExponent);
+                if (decpt != length && (decpt <= -4 || decpt > cutoff))
+                    out = exponentForm(out, zero, decimal, exponential, plus, minus,
+                                       buf.data(), length, decpt, precision, mode,
+                                       always_show_decpt, flags & QLocaleData::ZeroPadExponent);
                 else
-                    num_str = decimalForm(_zero, decimal, group,
-                                          digits, decpt, precision, mode,
-                                          always_show_decpt, flags & ThousandsGroup);
+                    out = decimalForm(out, zero, decimal, group,
+                                      buf.data(), length, decpt, precision, mode,
+                                      always_show_decpt, flags & QLocaleData::ThousandsGroup);
                 break;
             }
         }
@@ -3561,30 +3643,55 @@ QString QLocaleData::doubleToString(const QChar _zero, const QChar plus, const Q
         // pad with zeros. LeftAdjusted overrides this flag). Also, we don't
         // pad special numbers
         if (flags & QLocaleData::ZeroPadded && !(flags & QLocaleData::LeftAdjusted)) {
-            int num_pad_chars = width - num_str.length();
+            int num_pad_chars = width - int(out - begin - 1);
             // leave space for the sign
             if (negative
                     || flags & QLocaleData::AlwaysShowSign
                     || flags & QLocaleData::BlankBeforePositive)
                 --num_pad_chars;
 
-            for (int i = 0; i < num_pad_chars; ++i)
-                num_str.prepend(_zero);
+            if (num_pad_chars > 0) {
+                memmove(begin + 1 + num_pad_chars, begin + 1, (out - begin - 1) * sizeof(QChar));
+                std::fill_n(begin + 1, num_pad_chars, zero);
+                out += num_pad_chars;
+            }
         }
     }
 
+    if (flags & QLocaleData::CapitalEorX) {
+        for (QChar *p = begin + 1; p != out; ++p)
+            *p = p->toUpper();
+    }
+
     // add sign
+    QChar *start = begin;
     if (negative)
-        num_str.prepend(minus);
+        *start = minus;
     else if (flags & QLocaleData::AlwaysShowSign)
-        num_str.prepend(plus);
+        *start = plus;
     else if (flags & QLocaleData::BlankBeforePositive)
-        num_str.prepend(QLatin1Char(' '));
+        *start = QLatin1Char(' ');
+    else
+        ++start;
 
-    if (flags & QLocaleData::CapitalEorX)
-        num_str = std::move(num_str).toUpper();
+    return QStringView(start, out - start);
+}
 
-    return num_str;
+QString QLocaleData::doubleToString(double d, int precision, DoubleForm form,
+                                    int width, unsigned flags) const
+{
+    return doubleToString(m_zero, m_plus, m_minus, m_exponential, m_group, m_decimal,
+                          d, precision, form, width, flags);
+}
+
+QString QLocaleData::doubleToString(const QChar _zero, const QChar plus, const QChar minus,
+                                    const QChar exponential, const QChar group, const QChar decimal,
+                                    double d, int precision, DoubleForm form, int width,
+                                    unsigned flags)
+{
+    NumberBuffer buffer;
+    return formatDouble(buffer, _zero, plus, minus, exponential, group, decimal,
+                        d, precision, form, width, flags).toString();
 }
 
 QString QLocaleData::longLongToString(qlonglong l, int precision,
@@ -3601,6 +3708,20 @@ QString QLocaleData::longLongToString(const QChar zero, const QChar group,
                                          int base, int width,
                                          unsigned flags)
 {
+    if (base == 10 && precision == -1 && (flags & ~ThousandsGroup) == 0) {
+        // fast-path: plain, possibly grouped, decimal; written straight into one buffer
+        QChar buff[28]; // sign, 20 digits and 6 group separators
+        QChar *const end = buff + sizeof(buff) / sizeof(buff[0]);
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_MSVC(4146)
+        QChar *p = qulltoaDecimal(end, l < 0 ? -qulonglong(l) : qulonglong(l),
+                                  zero, group, flags & ThousandsGroup);
+QT_WARNING_POP
+        if (l < 0)
+            *--p = minus;
+        return QString(p, end - p);
+    }
+
     bool precision_not_specified = false;
     if (precision == -1) {
         precision_not_specified = true;
@@ -3700,6 +3821,14 @@ QString QLocaleData::unsLongLongToString(const QChar zero, const QChar group,
                                             int base, int width,
                                             unsigned flags)
 {
+    if (base == 10 && precision == -1 && (flags & ~ThousandsGroup) == 0) {
+        // fast-path: plain, possibly grouped, decimal; written straight into one buffer
+        QChar buff[27]; // 20 digits and 6 group separators
+        QChar *const end = buff + sizeof(buff) / sizeof(buff[0]);
+        QChar *p = qulltoaDecimal(end, l, zero, group, flags & ThousandsGroup);
+        return QString(p, end - p);
+    }
+
     const QChar resultZero = base == 10 ? zero : QChar(QLatin1Char('0'));
     QString num_str = l ? qulltoa(l, base, zero) : QString(resultZero);
 
@@ -3878,6 +4007,15 @@ bool QLocaleData::numberToCLocale(QStringView s, QLocale::NumberOptions number_o
 
         result->append(out);
 
+        if (out >= '0' && out <= '9') {
+            // The checks above only care about the first digit of a run; copy the
+            // rest of the run straight away.
+            while (idx + 1 < l && ushort(uc[idx + 1].unicode() - m_zero) < 10) {
+                ++idx;
+                result->append(char('0' + uc[idx].unicode() - m_zero));
+            }
+        }
+
         ++idx;
     }
 
@@ -1005,6 +1005,11 @@ public:
     QString toString(double i, char f = 'g', int prec = 6) const;
     inline QString toString(float i, char f = 'g', int prec = 6) const;
 
+    QString &appendNumbers(QString &str, const qlonglong *values, qsizetype count,
+                           QStringView separator) const;
+    QString &appendNumbers(QString &str, const double *values, qsizetype count,
+                           QStringView separator, char f = 'g', int prec = 6) const;
+
 #if QT_STRINGVIEW_LEVEL < 2
     QString toString(const QDate &date, const QString &formatStr) const;
     QString toString(const QTime &time, const QString &formatStr) const;
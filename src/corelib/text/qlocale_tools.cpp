@@ -288,29 +288,32 @@ double qt_asciiToDouble(const char *num, int numLen, bool &ok, int &processed,
 
     ok = true;
 
-    // We have to catch NaN before because we need NaN as marker for "garbage" in the
-    // libdouble-conversion case and, in contrast to libdouble-conversion or sscanf, we don't allow
-    // "-nan" or "+nan"
-    if (qstrcmp(num, "nan") == 0) {
-        processed = 3;
-        return qt_qnan();
-    } else if ((num[0] == '-' || num[0] == '+') && qstrcmp(num + 1, "nan") == 0) {
-        processed = 0;
-        ok = false;
-        return 0.0;
-    }
+    // A plain number starts with a digit and can be neither NaN nor infinity
+    if (*num < '0' || *num > '9') {
+        // We have to catch NaN before because we need NaN as marker for "garbage" in the
+        // libdouble-conversion case and, in contrast to libdouble-conversion or sscanf, we don't
+        // allow "-nan" or "+nan"
+        if (qstrcmp(num, "nan") == 0) {
+            processed = 3;
+            return qt_qnan();
+        } else if ((num[0] == '-' || num[0] == '+') && qstrcmp(num + 1, "nan") == 0) {
+            processed = 0;
+            ok = false;
+            return 0.0;
+        }
 
-    // Infinity values are implementation defined in the sscanf case. In the libdouble-conversion
-    // case we need infinity as overflow marker.
-    if (qstrcmp(num, "+inf") == 0) {
-        processed = 4;
-        return qt_inf();
-    } else if (qstrcmp(num, "inf") == 0) {
-        processed = 3;
-        return qt_inf();
-    } else if (qstrcmp(num, "-inf") == 0) {
-        processed = 4;
-        return -qt_inf();
+        // Infinity values are implementation defined in the sscanf case. In the
+        // libdouble-conversion case we need infinity as overflow marker.
+        if (qstrcmp(num, "+inf") == 0) {
+            processed = 4;
+            return qt_inf();
+        } else if (qstrcmp(num, "inf") == 0) {
+            processed = 3;
+            return qt_inf();
+        } else if (qstrcmp(num, "-inf") == 0) {
+            processed = 4;
+            return -qt_inf();
+        }
     }
 
     double d = 0.0;
@@ -460,76 +463,107 @@ QString qulltoa(qulonglong l, int base, const QChar _zero)
     return QString(reinterpret_cast<QChar *>(p), 65 - (p - buff));
 }
 
-QString &decimalForm(QChar zero, QChar decimal, QChar group,
-                     QString &digits, int decpt, int precision,
-                     PrecisionMode pm,
-                     bool always_show_decpt,
-                     bool thousands_group)
+/*!
+  \internal
+
+  Writes the decimal representation of \a l, using \a zero as the zero digit
+  and inserting \a group between thousands if \a thousands_group is true,
+  backwards into the buffer ending at \a end. Returns the start of the
+  written text. The buffer must hold at least 27 characters.
+ */
+QChar *qulltoaDecimal(QChar *end, qulonglong l, QChar zero, QChar group, bool thousands_group)
+{
+    const ushort z = zero.unicode();
+    QChar *p = end;
+    int count = 0;
+    do {
+        if (thousands_group && count && count % 3 == 0)
+            *--p = group;
+        *--p = QChar(ushort(z + l % 10));
+        l /= 10;
+        ++count;
+    } while (l != 0);
+    return p;
+}
+
+static inline QChar digitAt(const char *digits, int length, int i, ushort zero)
+{
+    return QChar(ushort(zero + (i >= 0 && i < length ? digits[i] - '0' : 0)));
+}
+
+QChar *decimalForm(QChar *out, QChar zero, QChar decimal, QChar group,
+                   const char *digits, int length, int decpt, int precision,
+                   PrecisionMode pm,
+                   bool always_show_decpt,
+                   bool thousands_group)
 {
+    // leading zeros count as digits, so they're included in total
+    int lead = 0;
     if (decpt < 0) {
-        for (int i = 0; i < -decpt; ++i)
-            digits.prepend(zero);
+        lead = -decpt;
         decpt = 0;
     }
-    else if (decpt > digits.length()) {
-        for (int i = digits.length(); i < decpt; ++i)
-            digits.append(zero);
-    }
+    int total = qMax(lead + length, decpt);
 
-    if (pm == PMDecimalDigits) {
-        uint decimal_digits = digits.length() - decpt;
-        for (int i = decimal_digits; i < precision; ++i)
-            digits.append(zero);
-    }
-    else if (pm == PMSignificantDigits) {
-        for (int i = digits.length(); i < precision; ++i)
-            digits.append(zero);
-    }
-    else { // pm == PMChopTrailingZeros
-    }
+    if (pm == PMDecimalDigits)
+        total = qMax(total, decpt + precision);
+    else if (pm == PMSignificantDigits)
+        total = qMax(total, precision);
+    // else pm == PMChopTrailingZeros
 
-    if (always_show_decpt || decpt < digits.length())
-        digits.insert(decpt, decimal);
+    const ushort z = zero.unicode();
+    if (decpt == 0)
+        *out++ = zero;
 
-    if (thousands_group) {
-        for (int i = decpt - 3; i > 0; i -= 3)
-            digits.insert(i, group);
+    for (int i = 0; i < decpt; ++i) {
+        if (thousands_group && i > 0 && (decpt - i) % 3 == 0)
+            *out++ = group;
+        *out++ = digitAt(digits, length, i - lead, z);
     }
 
-    if (decpt == 0)
-        digits.prepend(zero);
+    if (always_show_decpt || decpt < total)
+        *out++ = decimal;
 
-    return digits;
+    for (int i = decpt; i < total; ++i)
+        *out++ = digitAt(digits, length, i - lead, z);
+
+    return out;
 }
 
-QString &exponentForm(QChar zero, QChar decimal, QChar exponential,
-                      QChar group, QChar plus, QChar minus,
-                      QString &digits, int decpt, int precision,
-                      PrecisionMode pm,
-                      bool always_show_decpt,
-                      bool leading_zero_in_exponent)
+QChar *exponentForm(QChar *out, QChar zero, QChar decimal, QChar exponential,
+                    QChar plus, QChar minus,
+                    const char *digits, int length, int decpt, int precision,
+                    PrecisionMode pm,
+                    bool always_show_decpt,
+                    bool leading_zero_in_exponent)
 {
     int exp = decpt - 1;
-
-    if (pm == PMDecimalDigits) {
-        for (int i = digits.length(); i < precision + 1; ++i)
-            digits.append(zero);
-    }
-    else if (pm == PMSignificantDigits) {
-        for (int i = digits.length(); i < precision; ++i)
-            digits.append(zero);
-    }
-    else { // pm == PMChopTrailingZeros
-    }
-
-    if (always_show_decpt || digits.length() > 1)
-        digits.insert(1, decimal);
-
-    digits.append(exponential);
-    digits.append(QLocaleData::longLongToString(zero, group, plus, minus,
-                   exp, leading_zero_in_exponent ? 2 : 1, 10, -1, QLocaleData::AlwaysShowSign));
-
-    return digits;
+    int total = length;
+
+    if (pm == PMDecimalDigits)
+        total = qMax(total, precision + 1);
+    else if (pm == PMSignificantDigits)
+        total = qMax(total, precision);
+    // else pm == PMChopTrailingZeros
+
+    const ushort z = zero.unicode();
+    *out++ = digitAt(digits, length, 0, z);
+    if (always_show_decpt || total > 1)
+        *out++ = decimal;
+    for (int i = 1; i < total; ++i)
+        *out++ = digitAt(digits, length, i, z);
+
+    *out++ = exponential;
+    *out++ = exp < 0 ? minus : plus;
+    if (exp < 0)
+        exp = -exp;
+    if (exp >= 100)
+        *out++ = QChar(ushort(z + exp / 100));
+    if (exp >= 10 || leading_zero_in_exponent)
+        *out++ = QChar(ushort(z + exp / 10 % 10));
+    *out++ = QChar(ushort(z + exp % 10));
+
+    return out;
 }
 
 double qstrtod(const char *s00, const char **se, bool *ok)
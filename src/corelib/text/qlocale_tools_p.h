@@ -68,6 +68,7 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, cha
                       bool &sign, int &length, int &decpt);
 
 QString qulltoa(qulonglong l, int base, const QChar _zero);
+QChar *qulltoaDecimal(QChar *end, qulonglong l, QChar zero, QChar group, bool thousands_group);
 Q_CORE_EXPORT QString qdtoa(qreal d, int *decpt, int *sign);
 
 enum PrecisionMode {
@@ -76,17 +77,18 @@ enum PrecisionMode {
     PMChopTrailingZeros =   0x03
 };
 
-QString &decimalForm(QChar zero, QChar decimal, QChar group,
-                     QString &digits, int decpt, int precision,
-                     PrecisionMode pm,
-                     bool always_show_decpt,
-                     bool thousands_group);
-QString &exponentForm(QChar zero, QChar decimal, QChar exponential,
-                      QChar group, QChar plus, QChar minus,
-                      QString &digits, int decpt, int precision,
-                      PrecisionMode pm,
-                      bool always_show_decpt,
-                      bool leading_zero_in_exponent);
+// Both write into out, which must be large enough, and return the new end
+QChar *decimalForm(QChar *out, QChar zero, QChar decimal, QChar group,
+                   const char *digits, int length, int decpt, int precision,
+                   PrecisionMode pm,
+                   bool always_show_decpt,
+                   bool thousands_group);
+QChar *exponentForm(QChar *out, QChar zero, QChar decimal, QChar exponential,
+                    QChar plus, QChar minus,
+                    const char *digits, int length, int decpt, int precision,
+                    PrecisionMode pm,
+                    bool always_show_decpt,
+                    bool leading_zero_in_exponent);
 
 inline bool isZero(double d)
 {
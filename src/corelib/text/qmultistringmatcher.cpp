@@ -0,0 +1,558 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qmultistringmatcher.h"
+
+#include "qahocorasick_p.h"
+#include <private/qutfcodec_p.h>
+
+#include <QtCore/qmath.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \reentrant
+    \since 6.0
+
+    \brief The QMultiStringMatcher class finds occurrences of any of a list
+    of strings in a single pass.
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    Looking for a number of keywords in a text by calling
+    QString::indexOf() for each of them scans the text once per keyword.
+    QMultiStringMatcher builds an automaton (using the Aho-Corasick
+    algorithm) from all the needles when they are set, and then finds all
+    of them with a single scan of the text, whose cost does not depend on
+    the number of needles.
+
+    \snippet code/src_corelib_text_qmultistringmatcher.cpp 0
+
+    The needles can be searched for case-insensitively, and with the
+    WholeWordsOption, only occurrences that are not part of a longer word
+    are reported. This makes QMultiStringMatcher suitable for keyword
+    highlighting, for instance in a QSyntaxHighlighter subclass:
+
+    \snippet code/src_corelib_text_qmultistringmatcher.cpp 1
+
+    Besides QStringView, the matcher can search UTF-8 encoded byte arrays
+    directly. The positions and lengths of the matches are then given in
+    bytes.
+
+    \sa QStringMatcher, QRegularExpressionSet
+*/
+
+/*!
+    \enum QMultiStringMatcher::MatchOption
+
+    \value NoMatchOption No options are set.
+    \value WholeWordsOption Only report occurrences that are neither
+           preceded nor followed by a word character: a letter, a number,
+           a mark or an underscore.
+*/
+
+/*!
+    \class QMultiStringMatcher::Match
+    \inmodule QtCore
+    \since 6.0
+
+    \brief The QMultiStringMatcher::Match struct describes an occurrence of
+    a needle found by QMultiStringMatcher.
+
+    \sa QMultiStringMatcher::matches()
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::position
+
+    The position in the haystack at which the occurrence starts.
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::length
+
+    The length of the occurrence. When searching strings, this is the length
+    of the needle; when searching UTF-8 byte arrays, it is the number of
+    bytes the occurrence takes in the haystack.
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::needleIndex
+
+    The index of the needle in QMultiStringMatcher::needles().
+*/
+
+class QMultiStringMatcherPrivate : public QSharedData
+{
+public:
+    void rebuild();
+
+    template <typename Callback>
+    void scan(QStringView haystack, qsizetype from, const qsizetype &stopAt, Callback callback) const;
+    template <typename Callback>
+    void scan(const QByteArray &haystack, qsizetype from, const qsizetype &stopAt, Callback callback) const;
+
+    template <typename Haystack>
+    qsizetype indexIn(const Haystack &haystack, qsizetype from, int *needleIndex,
+                      qsizetype unitsPerCodeUnit) const;
+    template <typename Haystack>
+    QVector<QMultiStringMatcher::Match> matches(const Haystack &haystack) const;
+
+    QStringList needles;
+    QVector<qsizetype> lengths;     // in UTF-16 code units, also after case folding
+    QAhoCorasick automaton;
+    qsizetype maximumLength = 0;
+    Qt::CaseSensitivity cs = Qt::CaseSensitive;
+    QMultiStringMatcher::MatchOptions options;
+};
+
+void QMultiStringMatcherPrivate::rebuild()
+{
+    automaton.clear();
+    lengths.clear();
+    lengths.reserve(needles.size());
+    maximumLength = 0;
+    for (int i = 0; i < needles.size(); ++i) {
+        // simple case folding maps the BMP and the other planes to
+        // themselves, so it doesn't change the length of the needle
+        const QString needle = cs == Qt::CaseSensitive ? needles.at(i) : needles.at(i).toCaseFolded();
+        lengths.append(needle.size());
+        if (needle.isEmpty())
+            continue;
+        automaton.addPattern(needle, i);
+        maximumLength = qMax(maximumLength, qsizetype(needle.size()));
+    }
+    automaton.build();
+}
+
+static bool isWordCharacter(uint ucs4) noexcept
+{
+    return ucs4 == '_' || QChar::isLetterOrNumber(ucs4) || QChar::isMark(ucs4);
+}
+
+static bool isWordCharacterBefore(QStringView s, qsizetype pos) noexcept
+{
+    if (pos <= 0)
+        return false;
+    uint ucs4 = s.at(pos - 1).unicode();
+    if (QChar::isLowSurrogate(ucs4) && pos >= 2 && s.at(pos - 2).isHighSurrogate())
+        ucs4 = QChar::surrogateToUcs4(s.at(pos - 2), s.at(pos - 1));
+    return isWordCharacter(ucs4);
+}
+
+static bool isWordCharacterAt(QStringView s, qsizetype pos) noexcept
+{
+    if (pos >= s.size())
+        return false;
+    uint ucs4 = s.at(pos).unicode();
+    if (QChar::isHighSurrogate(ucs4) && pos + 1 < s.size() && s.at(pos + 1).isLowSurrogate())
+        ucs4 = QChar::surrogateToUcs4(s.at(pos), s.at(pos + 1));
+    return isWordCharacter(ucs4);
+}
+
+// Decodes the UTF-8 sequence at \a src; invalid bytes decode to U+FFFD one by one.
+static uint decodeUtf8(const uchar *src, const uchar *end, qsizetype *length) noexcept
+{
+    ushort buffer[2];
+    ushort *dst = buffer;
+    const uchar b = *src++;
+    const int n = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, src, end);
+    if (n < 0) {
+        *length = 1;
+        return QChar::ReplacementCharacter;
+    }
+    *length = n;
+    return dst - buffer == 2 ? QChar::surrogateToUcs4(buffer[0], buffer[1]) : buffer[0];
+}
+
+static bool isWordCharacterBefore(const QByteArray &s, qsizetype pos) noexcept
+{
+    if (pos <= 0)
+        return false;
+    const uchar *data = reinterpret_cast<const uchar *>(s.constData());
+    qsizetype start = pos - 1;
+    while (start > 0 && pos - start < 4 && (data[start] & 0xc0) == 0x80)
+        --start;
+    qsizetype length;
+    const uint ucs4 = decodeUtf8(data + start, data + pos, &length);
+    return start + length == pos && isWordCharacter(ucs4);
+}
+
+static bool isWordCharacterAt(const QByteArray &s, qsizetype pos) noexcept
+{
+    if (pos >= s.size())
+        return false;
+    const uchar *data = reinterpret_cast<const uchar *>(s.constData());
+    qsizetype length;
+    return isWordCharacter(decodeUtf8(data + pos, data + s.size(), &length));
+}
+
+/*
+    Calls callback(needleIndex, start, end) for every occurrence of a needle
+    in \a haystack that starts at or after \a from, in order of end, until it
+    returns false or the scan passes \a stopAt.
+*/
+template <typename Callback>
+void QMultiStringMatcherPrivate::scan(QStringView haystack, qsizetype from, const qsizetype &stopAt,
+                                      Callback callback) const
+{
+    const bool wholeWords = options & QMultiStringMatcher::WholeWordsOption;
+    int state = 0;
+    auto report = [&](qsizetype position) {
+        return automaton.reportMatches(state, position, [&](int id, qsizetype end) {
+            const qsizetype start = end - lengths.at(id);
+            if (wholeWords && (isWordCharacterBefore(haystack, start) || isWordCharacterAt(haystack, end)))
+                return true;
+            return callback(id, start, end);
+        });
+    };
+
+    const ushort *s = reinterpret_cast<const ushort *>(haystack.data());
+    const qsizetype size = haystack.size();
+    for (qsizetype i = from; i < size && i < stopAt; ++i) {
+        ushort u = s[i];
+        if (cs == Qt::CaseInsensitive) {
+            if (QChar::isHighSurrogate(u) && i + 1 < size && QChar::isLowSurrogate(s[i + 1])) {
+                const uint folded = QChar::toCaseFolded(QChar::surrogateToUcs4(u, s[i + 1]));
+                state = automaton.nextState(state, QChar::highSurrogate(folded));
+                if (!report(i + 1))
+                    return;
+                u = QChar::lowSurrogate(folded);
+                ++i;
+            } else {
+                u = ushort(QChar::toCaseFolded(uint(u)));
+            }
+        }
+        state = automaton.nextState(state, u);
+        if (!report(i + 1))
+            return;
+    }
+}
+
+template <typename Callback>
+void QMultiStringMatcherPrivate::scan(const QByteArray &haystack, qsizetype from, const qsizetype &stopAt,
+                                      Callback callback) const
+{
+    const bool wholeWords = options & QMultiStringMatcher::WholeWordsOption;
+
+    // The automaton works on UTF-16 code units, so we decode the haystack
+    // and remember where the last few code units started in it
+    const qsizetype ringSize = qNextPowerOfTwo(quint64(maximumLength));
+    const qsizetype ringMask = ringSize - 1;
+    QVarLengthArray<qsizetype, 256> offsets(ringSize);
+    qsizetype units = 0;
+
+    int state = 0;
+    auto feed = [&](ushort u, qsizetype byteStart, qsizetype byteEnd) {
+        offsets[units & ringMask] = byteStart;
+        ++units;
+        state = automaton.nextState(state, u);
+        return automaton.reportMatches(state, units, [&](int id, qsizetype unitEnd) {
+            const qsizetype start = offsets[(unitEnd - lengths.at(id)) & ringMask];
+            if (wholeWords && (isWordCharacterBefore(haystack, start) || isWordCharacterAt(haystack, byteEnd)))
+                return true;
+            return callback(id, start, byteEnd);
+        });
+    };
+
+    const uchar *data = reinterpret_cast<const uchar *>(haystack.constData());
+    const uchar *end = data + haystack.size();
+    qsizetype pos = from;
+    while (pos < haystack.size() && pos < stopAt) {
+        uint ucs4 = data[pos];
+        qsizetype length = 1;
+        if (ucs4 >= 0x80)
+            ucs4 = decodeUtf8(data + pos, end, &length);
+        if (cs == Qt::CaseInsensitive)
+            ucs4 = QChar::toCaseFolded(ucs4);
+        if (QChar::requiresSurrogates(ucs4)) {
+            if (!feed(QChar::highSurrogate(ucs4), pos, pos + length)
+                || !feed(QChar::lowSurrogate(ucs4), pos, pos + length)) {
+                return;
+            }
+        } else if (!feed(ushort(ucs4), pos, pos + length)) {
+            return;
+        }
+        pos += length;
+    }
+}
+
+/*
+    Finds the occurrence that starts first, and of those, the one of the
+    needle with the lowest index. Once we have one, the scan can stop as soon
+    as no needle that ends further on could start before it; a needle takes
+    at most \a unitsPerCodeUnit haystack units per UTF-16 code unit.
+*/
+template <typename Haystack>
+qsizetype QMultiStringMatcherPrivate::indexIn(const Haystack &haystack, qsizetype from, int *needleIndex,
+                                              qsizetype unitsPerCodeUnit) const
+{
+    if (from < 0)
+        from = 0;
+    qsizetype best = -1;
+    int bestIndex = -1;
+    qsizetype stopAt = std::numeric_limits<qsizetype>::max();
+    if (maximumLength) {
+        scan(haystack, from, stopAt, [&](int id, qsizetype start, qsizetype) {
+            if (best < 0 || start < best || (start == best && id < bestIndex)) {
+                best = start;
+                bestIndex = id;
+                stopAt = start + maximumLength * unitsPerCodeUnit;
+            }
+            return true;
+        });
+    }
+    if (needleIndex)
+        *needleIndex = bestIndex;
+    return best;
+}
+
+template <typename Haystack>
+QVector<QMultiStringMatcher::Match> QMultiStringMatcherPrivate::matches(const Haystack &haystack) const
+{
+    QVector<QMultiStringMatcher::Match> result;
+    if (!maximumLength)
+        return result;
+    const qsizetype stopAt = std::numeric_limits<qsizetype>::max();
+    scan(haystack, 0, stopAt, [&result](int id, qsizetype start, qsizetype end) {
+        result.append({ start, end - start, id });
+        return true;
+    });
+    std::sort(result.begin(), result.end(),
+              [](const QMultiStringMatcher::Match &lhs, const QMultiStringMatcher::Match &rhs) {
+        return lhs.position < rhs.position
+                || (lhs.position == rhs.position && lhs.needleIndex < rhs.needleIndex);
+    });
+    return result;
+}
+
+/*!
+    Constructs a matcher without needles, which won't match anything.
+*/
+QMultiStringMatcher::QMultiStringMatcher()
+    : d(new QMultiStringMatcherPrivate)
+{
+    d->rebuild();
+}
+
+/*!
+    Constructs a matcher that searches for \a needles with case sensitivity
+    \a cs and the given match \a options.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &needles, Qt::CaseSensitivity cs,
+                                         MatchOptions options)
+    : d(new QMultiStringMatcherPrivate)
+{
+    d->needles = needles;
+    d->cs = cs;
+    d->options = options;
+    d->rebuild();
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher()
+{
+}
+
+/*!
+    Assigns \a other to this matcher and returns a reference to this matcher.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this matcher and returns a reference to this
+    matcher.
+*/
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+
+    Swaps this matcher with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Sets the strings to search for to \a needles. The index of a needle in
+    \a needles is reported with its occurrences. Empty needles never match.
+
+    The automaton is built by this function, so it takes time proportional
+    to the total length of the needles.
+
+    \sa needles()
+*/
+void QMultiStringMatcher::setNeedles(const QStringList &needles)
+{
+    d.detach();
+    d->needles = needles;
+    d->rebuild();
+}
+
+/*!
+    Returns the strings this matcher searches for.
+
+    \sa setNeedles()
+*/
+QStringList QMultiStringMatcher::needles() const
+{
+    return d->needles;
+}
+
+/*!
+    Sets the case sensitivity of this matcher to \a cs.
+
+    Case-insensitive matching compares the case-folded forms of the
+    needles and the haystack, like QString::compare() does.
+
+    \sa caseSensitivity()
+*/
+void QMultiStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs == d->cs)
+        return;
+    d.detach();
+    d->cs = cs;
+    d->rebuild();
+}
+
+/*!
+    Returns the case sensitivity of this matcher.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Sets the match options of this matcher to \a options.
+
+    \sa matchOptions()
+*/
+void QMultiStringMatcher::setMatchOptions(MatchOptions options)
+{
+    d.detach();
+    d->options = options;
+}
+
+/*!
+    Returns the match options of this matcher.
+
+    \sa setMatchOptions()
+*/
+QMultiStringMatcher::MatchOptions QMultiStringMatcher::matchOptions() const
+{
+    return d->options;
+}
+
+/*!
+    Searches \a haystack from position \a from for the first occurrence of
+    any of the needles, and returns its position, or -1 if there is none.
+    If several needles occur at that position, the one with the lowest index
+    is reported. If \a needleIndex is not \nullptr, it is set to the index of
+    that needle, or -1.
+
+    \sa matches()
+*/
+qsizetype QMultiStringMatcher::indexIn(QStringView haystack, qsizetype from, int *needleIndex) const
+{
+    return d->indexIn(haystack, from, needleIndex, 1);
+}
+
+/*!
+    \overload
+
+    Searches the UTF-8 encoded \a utf8 from byte position \a from. The
+    returned position is in bytes.
+*/
+qsizetype QMultiStringMatcher::indexIn(const QByteArray &utf8, qsizetype from, int *needleIndex) const
+{
+    // a BMP character takes up to three bytes; others take two code units and four bytes
+    return d->indexIn(utf8, from, needleIndex, 3);
+}
+
+/*!
+    Returns all occurrences of all needles in \a haystack, ordered by their
+    position, and occurrences at the same position by needle index.
+    Occurrences may overlap.
+
+    \sa indexIn()
+*/
+QVector<QMultiStringMatcher::Match> QMultiStringMatcher::matches(QStringView haystack) const
+{
+    return d->matches(haystack);
+}
+
+/*!
+    \overload
+
+    Returns all occurrences of all needles in the UTF-8 encoded \a utf8. The
+    positions and lengths of the matches are in bytes.
+*/
+QVector<QMultiStringMatcher::Match> QMultiStringMatcher::matches(const QByteArray &utf8) const
+{
+    return d->matches(utf8);
+}
+
+QT_END_NAMESPACE
@@ -41,6 +41,7 @@
 
 #include "qregularexpression.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qmutex.h>
@@ -808,6 +809,23 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+/*
+    A pattern compiled by PCRE2, together with the information we extract from
+    it. Once created it is never modified, so it can be shared by all the
+    QRegularExpressionPrivate objects using the same pattern and pattern
+    options (see QRegularExpressionCache below), even across threads.
+*/
+struct QRegularExpressionCompiledPattern : QSharedData
+{
+    ~QRegularExpressionCompiledPattern() { pcre2_code_free_16(code); }
+
+    pcre2_code_16 *code = nullptr;
+    int errorCode = 0;
+    int errorOffset = -1;
+    int capturingCount = 0;
+    bool usingCrLfNewlines = false;
+};
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -816,8 +834,6 @@ struct QRegularExpressionPrivate : QSharedData
 
     void cleanCompiledPattern();
     void compilePattern();
-    void getPatternInfo();
-    void optimizePattern();
 
     enum CheckSubjectStringOption {
         CheckSubjectString,
@@ -844,9 +860,10 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The PCRE code is owned by the (shared) compiled pattern; compiledPattern
+    // is a shortcut to compiled->code. When the private is copied (i.e. a
+    // detach happened) both are reset
+    QExplicitlySharedDataPointer<const QRegularExpressionCompiledPattern> compiled;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     int errorOffset;
@@ -960,7 +977,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    compiled.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -968,71 +985,6 @@ void QRegularExpressionPrivate::cleanCompiledPattern()
     usingCrLfNewlines = false;
 }
 
-/*!
-    \internal
-*/
-void QRegularExpressionPrivate::compilePattern()
-{
-    const QMutexLocker lock(&mutex);
-
-    if (!isDirty)
-        return;
-
-    isDirty = false;
-    cleanCompiledPattern();
-
-    int options = convertToPcreOptions(patternOptions);
-    options |= PCRE2_UTF;
-
-    PCRE2_SIZE patternErrorOffset;
-    compiledPattern = pcre2_compile_16(pattern.utf16(),
-                                       pattern.length(),
-                                       options,
-                                       &errorCode,
-                                       &patternErrorOffset,
-                                       NULL);
-
-    if (!compiledPattern) {
-        errorOffset = static_cast<int>(patternErrorOffset);
-        return;
-    } else {
-        // ignore whatever PCRE2 wrote into errorCode -- leave it to 0 to mean "no error"
-        errorCode = 0;
-    }
-
-    optimizePattern();
-    getPatternInfo();
-}
-
-/*!
-    \internal
-*/
-void QRegularExpressionPrivate::getPatternInfo()
-{
-    Q_ASSERT(compiledPattern);
-
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
-
-    // detect the settings for the newline
-    unsigned int patternNewlineSetting;
-    if (pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
-        // no option was specified in the regexp, grab PCRE build defaults
-        pcre2_config_16(PCRE2_CONFIG_NEWLINE, &patternNewlineSetting);
-    }
-
-    usingCrLfNewlines = (patternNewlineSetting == PCRE2_NEWLINE_CRLF) ||
-            (patternNewlineSetting == PCRE2_NEWLINE_ANY) ||
-            (patternNewlineSetting == PCRE2_NEWLINE_ANYCRLF);
-
-    unsigned int hasJOptionChanged;
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
-    if (Q_UNLIKELY(hasJOptionChanged)) {
-        qWarning("QRegularExpressionPrivate::getPatternInfo(): the pattern '%ls'\n    is using the (?J) option; duplicate capturing group names are not supported by Qt",
-                 qUtf16Printable(pattern));
-    }
-}
-
-
 /*
     Simple "smartpointer" wrapper around a pcre2_jit_stack_16, to be used with
     QThreadStorage.
@@ -1101,19 +1053,178 @@ static bool isJitEnabled()
     The purpose of the function is to call pcre2_jit_compile_16, which
     JIT-compiles the pattern.
 
-    It gets called when a pattern is recompiled by us (in compilePattern()),
-    under mutex protection.
+    It gets called once for every pattern we compile (in compilePattern()),
+    before the result is published in the cache.
 */
-void QRegularExpressionPrivate::optimizePattern()
+static void optimizePattern(pcre2_code_16 *code)
 {
-    Q_ASSERT(compiledPattern);
+    Q_ASSERT(code);
 
     static const bool enableJit = isJitEnabled();
 
     if (!enableJit)
         return;
 
-    pcre2_jit_compile_16(compiledPattern, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+    pcre2_jit_compile_16(code, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+}
+
+/*!
+    \internal
+*/
+static void getPatternInfo(QRegularExpressionCompiledPattern *compiled, const QString &pattern)
+{
+    pcre2_code_16 *code = compiled->code;
+    Q_ASSERT(code);
+
+    pcre2_pattern_info_16(code, PCRE2_INFO_CAPTURECOUNT, &compiled->capturingCount);
+
+    // detect the settings for the newline
+    unsigned int patternNewlineSetting;
+    if (pcre2_pattern_info_16(code, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
+        // no option was specified in the regexp, grab PCRE build defaults
+        pcre2_config_16(PCRE2_CONFIG_NEWLINE, &patternNewlineSetting);
+    }
+
+    compiled->usingCrLfNewlines = (patternNewlineSetting == PCRE2_NEWLINE_CRLF) ||
+            (patternNewlineSetting == PCRE2_NEWLINE_ANY) ||
+            (patternNewlineSetting == PCRE2_NEWLINE_ANYCRLF);
+
+    unsigned int hasJOptionChanged;
+    pcre2_pattern_info_16(code, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
+    if (Q_UNLIKELY(hasJOptionChanged)) {
+        qWarning("QRegularExpressionPrivate::getPatternInfo(): the pattern '%ls'\n    is using the (?J) option; duplicate capturing group names are not supported by Qt",
+                 qUtf16Printable(pattern));
+    }
+}
+
+/*!
+    \internal
+
+    Compiles \a pattern with \a patternOptions, bypassing the cache.
+*/
+static QRegularExpressionCompiledPattern *compilePatternUncached(const QString &pattern,
+                                                                 QRegularExpression::PatternOptions patternOptions)
+{
+    QRegularExpressionCompiledPattern *compiled = new QRegularExpressionCompiledPattern;
+
+    int options = convertToPcreOptions(patternOptions);
+    options |= PCRE2_UTF;
+
+    PCRE2_SIZE patternErrorOffset;
+    compiled->code = pcre2_compile_16(pattern.utf16(),
+                                      pattern.length(),
+                                      options,
+                                      &compiled->errorCode,
+                                      &patternErrorOffset,
+                                      NULL);
+
+    if (!compiled->code) {
+        compiled->errorOffset = static_cast<int>(patternErrorOffset);
+        return compiled;
+    }
+
+    // ignore whatever PCRE2 wrote into errorCode -- leave it to 0 to mean "no error"
+    compiled->errorCode = 0;
+
+    optimizePattern(compiled->code);
+    getPatternInfo(compiled, pattern);
+    return compiled;
+}
+
+/*
+    Process-wide LRU cache of compiled patterns, keyed by pattern and pattern
+    options. Copies of the same QRegularExpression (which detach and lose
+    their compiled pattern), as well as unrelated objects built from the same
+    pattern, thus compile and JIT-compile it only once.
+
+    The cost of an entry is the memory used by the compiled code; entries
+    still referenced by a QRegularExpression stay alive after eviction.
+*/
+class QRegularExpressionCache
+{
+public:
+    typedef QExplicitlySharedDataPointer<const QRegularExpressionCompiledPattern> CompiledPatternPointer;
+
+    CompiledPatternPointer compiledPattern(const QString &pattern,
+                                           QRegularExpression::PatternOptions options);
+
+private:
+    struct Key
+    {
+        QString pattern;
+        QRegularExpression::PatternOptions options;
+
+        bool operator==(const Key &other) const
+        { return options == other.options && pattern == other.pattern; }
+    };
+    friend uint qHash(const Key &key, uint seed) noexcept
+    {
+        QtPrivate::QHashCombine hash;
+        seed = hash(seed, key.pattern);
+        seed = hash(seed, key.options);
+        return seed;
+    }
+
+    enum { MaxCost = 16 * 1024 * 1024 };
+
+    QMutex mutex;
+    QCache<Key, CompiledPatternPointer> cache { MaxCost };
+};
+
+QRegularExpressionCache::CompiledPatternPointer
+QRegularExpressionCache::compiledPattern(const QString &pattern,
+                                         QRegularExpression::PatternOptions options)
+{
+    const Key key = { pattern, options };
+    {
+        const QMutexLocker lock(&mutex);
+        if (const CompiledPatternPointer *cached = cache.object(key))
+            return *cached;
+    }
+
+    // compile without holding the lock; if another thread compiled the same
+    // pattern in the meantime, we simply replace its entry
+    const CompiledPatternPointer compiled(compilePatternUncached(pattern, options));
+
+    size_t cost = size_t(pattern.size()) * sizeof(QChar);
+    if (compiled->code) {
+        size_t size = 0;
+        if (pcre2_pattern_info_16(compiled->code, PCRE2_INFO_SIZE, &size) == 0)
+            cost += size;
+        if (pcre2_pattern_info_16(compiled->code, PCRE2_INFO_JITSIZE, &size) == 0)
+            cost += size;
+    }
+
+    const QMutexLocker lock(&mutex);
+    cache.insert(key, new CompiledPatternPointer(compiled), int(qMin<size_t>(cost, MaxCost + 1)));
+    return compiled;
+}
+
+Q_GLOBAL_STATIC(QRegularExpressionCache, regularExpressionCache)
+
+/*!
+    \internal
+*/
+void QRegularExpressionPrivate::compilePattern()
+{
+    const QMutexLocker lock(&mutex);
+
+    if (!isDirty)
+        return;
+
+    isDirty = false;
+    cleanCompiledPattern();
+
+    if (QRegularExpressionCache *cache = regularExpressionCache())
+        compiled = cache->compiledPattern(pattern, patternOptions);
+    else // during application shutdown
+        compiled = QRegularExpressionCache::CompiledPatternPointer(compilePatternUncached(pattern, patternOptions));
+
+    compiledPattern = compiled->code;
+    errorCode = compiled->errorCode;
+    errorOffset = compiled->errorOffset;
+    capturingCount = compiled->capturingCount;
+    usingCrLfNewlines = compiled->usingCrLfNewlines;
 }
 
 /*!
@@ -1746,6 +1857,11 @@ QRegularExpressionMatchIterator QRegularExpression::globalMatch(const QStringRef
     Compiles the pattern immediately, including JIT compiling it (if
     the JIT is enabled) for optimization.
 
+    Compiled patterns are kept in a process-wide cache, keyed by the pattern
+    and the pattern options, so that other QRegularExpression objects with
+    the same pattern and options reuse the compiled code instead of
+    compiling it again.
+
     \sa isValid(), {Debugging Code that Uses QRegularExpression}
 */
 void QRegularExpression::optimize() const
@@ -0,0 +1,653 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qregularexpressionset.h"
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include "qahocorasick_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QRegularExpressionSet
+    \inmodule QtCore
+    \reentrant
+    \since 6.0
+
+    \brief The QRegularExpressionSet class matches a string against many
+    regular expressions at once.
+
+    \ingroup tools
+    \ingroup shared
+
+    Checking a string against a large number of regular expressions one by
+    one is slow, even though for most strings only a handful of them can
+    possibly match. QRegularExpressionSet speeds this up with a prefilter:
+    for every expression it determines a literal substring that any match
+    must contain, and scans the subject for all of these substrings in a
+    single pass. Only the expressions whose literal was found, and those for
+    which no such literal could be determined, are then matched with the
+    regular expression engine.
+
+    \snippet code/src_corelib_text_qregularexpressionset.cpp 0
+
+    The result is always the same as calling QRegularExpression::match()
+    with each expression in turn; the prefilter only avoids running
+    expressions that cannot match. Expressions whose pattern consists of
+    alternatives at the top level (such as \c{foo|bar}), or that use the
+    QRegularExpression::ExtendedPatternSyntaxOption, are always matched.
+
+    The prefilter is built the first time the set is used after it was
+    modified, or when calling optimize().
+
+    \sa QRegularExpression
+*/
+
+struct QRegularExpressionSetPrivate : QSharedData
+{
+    QRegularExpressionSetPrivate() = default;
+    QRegularExpressionSetPrivate(const QRegularExpressionSetPrivate &other)
+        : QSharedData(other), expressions(other.expressions)
+    {
+    }
+
+    void prepare() const;
+
+    template <typename Callback>
+    void forEachCandidate(const QString &subject, Callback callback) const;
+
+    QVector<QRegularExpression> expressions;
+
+    // All of the following members are managed while holding this mutex,
+    // except for isDirty which is set by the non-const QRegularExpressionSet
+    // functions (right after a detach happened).
+    mutable QMutex mutex;
+    mutable QAhoCorasick caseSensitiveLiterals;
+    mutable QAhoCorasick caseInsensitiveLiterals;
+    // expressions without a literal, which always need to be matched
+    mutable QVector<int> unfiltered;
+    mutable bool isDirty = true;
+};
+
+namespace {
+class RequiredLiteralFinder
+{
+public:
+    RequiredLiteralFinder(const QString &pattern)
+        : p(pattern.constData()), end(pattern.constData() + pattern.size())
+    {
+    }
+
+    bool caseInsensitive = false;
+
+    // Returns the longest substring that every match of the pattern must
+    // contain, or an empty string if we cannot tell.
+    QString find()
+    {
+        if (startsWith("(?i)")) {
+            caseInsensitive = true;
+            p += 4;
+        }
+
+        while (p < end) {
+            const QChar c = *p++;
+            switch (c.unicode()) {
+            case '\\':
+                if (p == end)
+                    return QString();
+                if (*p == QLatin1Char('Q')) {
+                    ++p;
+                    while (p < end && !startsWith("\\E"))
+                        append(*p++);
+                    p = qMin(p + 2, end);
+                } else if (isAsciiAlphanumeric(*p)) {
+                    skipEscapeSequence();
+                    endRun();
+                } else {
+                    // a backslash followed by any other character stands for that character
+                    append(*p++);
+                }
+                break;
+
+            case '.':
+            case '^':
+            case '$':
+                endRun();
+                break;
+
+            case '[':
+                if (!skipCharacterClass())
+                    return QString();
+                endRun();
+                break;
+
+            case '(':
+                // inline option settings change the meaning of what follows,
+                // and backtracking control verbs like (*ACCEPT) can end a
+                // match early
+                if (p < end && *p == QLatin1Char('*'))
+                    return QString();
+                if (p < end && *p == QLatin1Char('?') && p + 1 < end
+                    && QStringView(u"imnsxJU-^)").contains(p[1])) {
+                    return QString();
+                }
+                if (!skipGroup())
+                    return QString();
+                endRun();
+                break;
+
+            case ')':
+            case '|':
+                // alternatives at the top level: nothing is required
+                return QString();
+
+            case '*':
+            case '?':
+                dropLastAtom();
+                endRun();
+                skipQuantifierSuffix();
+                break;
+
+            case '+':
+                endRun();
+                skipQuantifierSuffix();
+                break;
+
+            case '{':
+                if (const int minimum = quantifierMinimum(); minimum >= 0) {
+                    if (minimum == 0)
+                        dropLastAtom();
+                    endRun();
+                    skipQuantifierSuffix();
+                } else {
+                    append(c);  // not a quantifier, so a literal brace
+                }
+                break;
+
+            default:
+                append(c);
+                break;
+            }
+        }
+        endRun();
+        return longest;
+    }
+
+private:
+    static bool isAsciiAlphanumeric(QChar c)
+    {
+        const ushort u = c.unicode();
+        return (u >= '0' && u <= '9') || (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z');
+    }
+
+    bool startsWith(const char *s) const
+    {
+        const QChar *q = p;
+        for (; *s; ++s, ++q) {
+            if (q == end || *q != QLatin1Char(*s))
+                return false;
+        }
+        return true;
+    }
+
+    void append(QChar c)
+    {
+        current += c;
+        lastAtomIsLiteral = true;
+    }
+
+    void endRun()
+    {
+        if (current.size() > longest.size())
+            longest = current;
+        current.clear();
+        lastAtomIsLiteral = false;
+    }
+
+    // The last atom is optional: remove it (a whole surrogate pair, if need be)
+    void dropLastAtom()
+    {
+        if (!lastAtomIsLiteral || current.isEmpty())
+            return;
+        int n = 1;
+        if (current.size() >= 2 && current.at(current.size() - 1).isLowSurrogate()
+            && current.at(current.size() - 2).isHighSurrogate()) {
+            n = 2;
+        }
+        current.chop(n);
+    }
+
+    void skipQuantifierSuffix()
+    {
+        // lazy or possessive quantifiers
+        if (p < end && (*p == QLatin1Char('?') || *p == QLatin1Char('+')))
+            ++p;
+    }
+
+    // If a {n}, {n,} or {n,m} quantifier starts at p (after the brace),
+    // consumes it and returns n; otherwise returns -1. A missing minimum, as
+    // in {,m}, counts as zero.
+    int quantifierMinimum()
+    {
+        const QChar *q = p;
+        int minimum = 0;
+        bool hasDigits = false;
+        while (q < end && q->isDigit() && q->unicode() < 128) {
+            minimum = qMin(minimum * 10 + (q->unicode() - '0'), 0xffff);
+            hasDigits = true;
+            ++q;
+        }
+        if (q < end && *q == QLatin1Char(',')) {
+            ++q;
+            while (q < end && q->unicode() >= '0' && q->unicode() <= '9') {
+                hasDigits = true;
+                ++q;
+            }
+        }
+        if (!hasDigits || q == end || *q != QLatin1Char('}'))
+            return -1;
+        p = q + 1;
+        return minimum;
+    }
+
+    // p points to the character after the backslash. Escapes with arguments
+    // (\x{...}, \p{...}, \k<...>, \cX, ...) are skipped conservatively: any
+    // alphanumerics directly following them are skipped too.
+    void skipEscapeSequence()
+    {
+        const QChar escape = *p++;
+        if (escape == QLatin1Char('c')) {
+            if (p < end)
+                ++p;
+            return;
+        }
+        if (p < end) {
+            QChar close;
+            if (*p == QLatin1Char('{'))
+                close = QLatin1Char('}');
+            else if (*p == QLatin1Char('<'))
+                close = QLatin1Char('>');
+            else if (*p == QLatin1Char('\''))
+                close = QLatin1Char('\'');
+            if (!close.isNull()) {
+                const QChar *q = p + 1;
+                while (q < end && *q != close)
+                    ++q;
+                if (q < end)
+                    p = q + 1;
+            }
+        }
+        while (p < end && isAsciiAlphanumeric(*p))
+            ++p;
+    }
+
+    // p points to the character after '['; leaves p after the closing ']'
+    bool skipCharacterClass()
+    {
+        if (p < end && *p == QLatin1Char('^'))
+            ++p;
+        if (p < end && *p == QLatin1Char(']'))
+            ++p;    // a literal ']' at the start
+        while (p < end) {
+            const QChar c = *p++;
+            if (c == QLatin1Char(']'))
+                return true;
+            if (c == QLatin1Char('\\')) {
+                if (p < end && *p == QLatin1Char('Q')) {
+                    while (p < end && !startsWith("\\E"))
+                        ++p;
+                    p = qMin(p + 2, end);
+                } else if (p < end) {
+                    ++p;
+                }
+            } else if (c == QLatin1Char('[') && p < end && *p == QLatin1Char(':')) {
+                // POSIX class like [:alpha:]
+                while (p < end && !startsWith(":]"))
+                    ++p;
+                p = qMin(p + 2, end);
+            }
+        }
+        return false;
+    }
+
+    // p points to the character after '('; leaves p after the matching ')'
+    bool skipGroup()
+    {
+        if (startsWith("?#")) {
+            while (p < end && *p != QLatin1Char(')'))
+                ++p;
+            return p++ < end;
+        }
+        int depth = 1;
+        while (p < end) {
+            const QChar c = *p++;
+            switch (c.unicode()) {
+            case '\\':
+                if (p < end && *p == QLatin1Char('Q')) {
+                    while (p < end && !startsWith("\\E"))
+                        ++p;
+                    p = qMin(p + 2, end);
+                } else if (p < end) {
+                    ++p;
+                }
+                break;
+            case '[':
+                if (!skipCharacterClass())
+                    return false;
+                break;
+            case '(':
+                if (p < end && *p == QLatin1Char('*'))
+                    return false;   // see above
+                ++depth;
+                break;
+            case ')':
+                if (--depth == 0)
+                    return true;
+                break;
+            }
+        }
+        return false;
+    }
+
+    const QChar *p;
+    const QChar *const end;
+    QString current;
+    QString longest;
+    bool lastAtomIsLiteral = false;
+};
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Builds the prefilter. The expressions are left alone; the caller compiles
+    them when matching.
+*/
+void QRegularExpressionSetPrivate::prepare() const
+{
+    const QMutexLocker lock(&mutex);
+    if (!isDirty)
+        return;
+
+    caseSensitiveLiterals.clear();
+    caseInsensitiveLiterals.clear();
+    unfiltered.clear();
+
+    for (int i = 0; i < expressions.size(); ++i) {
+        const QRegularExpression &re = expressions.at(i);
+        const QRegularExpression::PatternOptions options = re.patternOptions();
+        QString literal;
+        bool caseInsensitive = options & QRegularExpression::CaseInsensitiveOption;
+        if (!(options & QRegularExpression::ExtendedPatternSyntaxOption)) {
+            RequiredLiteralFinder finder(re.pattern());
+            literal = finder.find();
+            caseInsensitive |= finder.caseInsensitive;
+        }
+
+        if (literal.isEmpty())
+            unfiltered.append(i);
+        else if (caseInsensitive)
+            caseInsensitiveLiterals.addPattern(literal.toCaseFolded(), i);
+        else
+            caseSensitiveLiterals.addPattern(literal, i);
+    }
+
+    caseSensitiveLiterals.build();
+    caseInsensitiveLiterals.build();
+    isDirty = false;
+}
+
+/*!
+    \internal
+
+    Calls \a callback with the index of every expression that may match
+    \a subject, in increasing order, until \a callback returns \c false.
+*/
+template <typename Callback>
+void QRegularExpressionSetPrivate::forEachCandidate(const QString &subject, Callback callback) const
+{
+    prepare();
+
+    QVarLengthArray<bool, 1024> candidates(expressions.size());
+    std::fill(candidates.begin(), candidates.end(), false);
+    for (int i : unfiltered)
+        candidates[i] = true;
+
+    const auto mark = [&candidates](int id, qsizetype) {
+        candidates[id] = true;
+        return true;
+    };
+    if (!caseSensitiveLiterals.isEmpty())
+        caseSensitiveLiterals.search(subject, mark);
+    if (!caseInsensitiveLiterals.isEmpty())
+        caseInsensitiveLiterals.search(subject.toCaseFolded(), mark);
+
+    for (int i = 0; i < candidates.size(); ++i) {
+        if (candidates[i] && !callback(i))
+            return;
+    }
+}
+
+static bool matches(const QRegularExpression &re, const QString &subject)
+{
+    // checked first, so that invalid expressions do not warn on every match
+    return re.isValid() && re.match(subject).hasMatch();
+}
+
+/*!
+    Constructs an empty set.
+*/
+QRegularExpressionSet::QRegularExpressionSet()
+    : d(new QRegularExpressionSetPrivate)
+{
+}
+
+/*!
+    Constructs a set containing \a expressions. The index of each expression
+    in the set is its index in \a expressions.
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QVector<QRegularExpression> &expressions)
+    : d(new QRegularExpressionSetPrivate)
+{
+    d->expressions = expressions;
+}
+
+/*!
+    Constructs a set that is a copy of \a other.
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QRegularExpressionSet &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Destroys the set.
+*/
+QRegularExpressionSet::~QRegularExpressionSet()
+{
+}
+
+/*!
+    Assigns \a other to this set and returns a reference to this set.
+*/
+QRegularExpressionSet &QRegularExpressionSet::operator=(const QRegularExpressionSet &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QRegularExpressionSet &QRegularExpressionSet::operator=(QRegularExpressionSet &&other)
+
+    Move-assigns \a other to this set and returns a reference to this set.
+*/
+
+/*!
+    \fn void QRegularExpressionSet::swap(QRegularExpressionSet &other)
+
+    Swaps this set with \a other. This operation is very fast and never fails.
+*/
+
+/*!
+    Appends \a expression to the set and returns its index.
+*/
+int QRegularExpressionSet::add(const QRegularExpression &expression)
+{
+    d.detach();
+    d->isDirty = true;
+    d->expressions.append(expression);
+    return d->expressions.size() - 1;
+}
+
+/*!
+    Removes all expressions from the set.
+*/
+void QRegularExpressionSet::clear()
+{
+    d.detach();
+    d->isDirty = true;
+    d->expressions.clear();
+}
+
+/*!
+    Returns the number of expressions in the set.
+*/
+int QRegularExpressionSet::size() const
+{
+    return d->expressions.size();
+}
+
+/*!
+    \fn bool QRegularExpressionSet::isEmpty() const
+
+    Returns \c true if the set contains no expressions.
+*/
+
+/*!
+    Returns the expression at index \a i, which must be valid.
+*/
+QRegularExpression QRegularExpressionSet::at(int i) const
+{
+    return d->expressions.at(i);
+}
+
+/*!
+    Returns all the expressions in the set, in the order of their indexes.
+*/
+QVector<QRegularExpression> QRegularExpressionSet::expressions() const
+{
+    return d->expressions;
+}
+
+/*!
+    Returns \c true if all the expressions in the set are valid. Invalid
+    expressions never match.
+
+    \sa QRegularExpression::isValid()
+*/
+bool QRegularExpressionSet::isValid() const
+{
+    for (const QRegularExpression &re : d->expressions) {
+        if (!re.isValid())
+            return false;
+    }
+    return true;
+}
+
+/*!
+    Builds the prefilter and compiles all the expressions immediately, instead
+    of on first use.
+
+    \sa QRegularExpression::optimize()
+*/
+void QRegularExpressionSet::optimize() const
+{
+    d->prepare();
+    for (const QRegularExpression &re : d->expressions)
+        re.optimize();
+}
+
+/*!
+    Returns the indexes, in increasing order, of all the expressions in the
+    set that match \a subject.
+
+    \sa firstMatchingIndex(), hasMatch()
+*/
+QVector<int> QRegularExpressionSet::matchingIndexes(const QString &subject) const
+{
+    QVector<int> result;
+    d->forEachCandidate(subject, [&](int i) {
+        if (matches(d->expressions.at(i), subject))
+            result.append(i);
+        return true;
+    });
+    return result;
+}
+
+/*!
+    Returns the lowest index of an expression in the set that matches
+    \a subject, or -1 if none does. Expressions with higher indexes are not
+    evaluated.
+
+    \sa matchingIndexes(), hasMatch()
+*/
+int QRegularExpressionSet::firstMatchingIndex(const QString &subject) const
+{
+    int result = -1;
+    d->forEachCandidate(subject, [&](int i) {
+        if (!matches(d->expressions.at(i), subject))
+            return true;
+        result = i;
+        return false;
+    });
+    return result;
+}
+
+/*!
+    \fn bool QRegularExpressionSet::hasMatch(const QString &subject) const
+
+    Returns \c true if any of the expressions in the set matches \a subject.
+
+    \sa firstMatchingIndex()
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QREGULAREXPRESSIONSET_H
+#define QREGULAREXPRESSIONSET_H
+
+#include <QtCore/qregularexpression.h>
+#include <QtCore/qvector.h>
+
+QT_REQUIRE_CONFIG(regularexpression);
+
+QT_BEGIN_NAMESPACE
+
+struct QRegularExpressionSetPrivate;
+
+class Q_CORE_EXPORT QRegularExpressionSet
+{
+public:
+    QRegularExpressionSet();
+    explicit QRegularExpressionSet(const QVector<QRegularExpression> &expressions);
+    QRegularExpressionSet(const QRegularExpressionSet &other);
+    ~QRegularExpressionSet();
+    QRegularExpressionSet &operator=(const QRegularExpressionSet &other);
+    QRegularExpressionSet &operator=(QRegularExpressionSet &&other) noexcept
+    { d.swap(other.d); return *this; }
+
+    void swap(QRegularExpressionSet &other) noexcept { d.swap(other.d); }
+
+    int add(const QRegularExpression &expression);
+    void clear();
+
+    int size() const;
+    bool isEmpty() const { return size() == 0; }
+    QRegularExpression at(int i) const;
+    QVector<QRegularExpression> expressions() const;
+
+    bool isValid() const;
+    void optimize() const;
+
+    QVector<int> matchingIndexes(const QString &subject) const;
+    int firstMatchingIndex(const QString &subject) const;
+    bool hasMatch(const QString &subject) const { return firstMatchingIndex(subject) >= 0; }
+
+private:
+    QExplicitlySharedDataPointer<QRegularExpressionSetPrivate> d;
+};
+
+Q_DECLARE_SHARED(QRegularExpressionSet)
+
+QT_END_NAMESPACE
+
+#endif // QREGULAREXPRESSIONSET_H
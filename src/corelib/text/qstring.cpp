@@ -554,31 +554,12 @@ bool QtPrivate::isLatin1(QStringView s) noexcept
     const QChar *ptr = s.begin();
     const QChar *end = s.end();
 
-#if defined(__SSE4_1__)
+#ifdef __SSE2__
     const char *ptr8 = reinterpret_cast<const char *>(ptr);
     const char *end8 = reinterpret_cast<const char *>(end);
     if (!simdTestMask(ptr8, end8, 0xff00ff00))
         return false;
     ptr = reinterpret_cast<const QChar *>(ptr8);
-#elif defined(__SSE2__)
-    // Testing if every other byte is non-zero can be done efficiently by
-    // using PUNPCKHBW (unpack high order bytes) and comparing that to zero.
-    while (ptr + 32 < end) {
-        __m128i data1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
-        __m128i data2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + 16));
-        __m128i high = _mm_unpackhi_epi8(data1, data2);
-        __m128i comparison = _mm_cmpeq_epi16(high, _mm_setzero_si128());
-        if (_mm_movemask_epi8(comparison))
-            return false;
-        ptr += 16;
-    }
-    if (ptr + 16 < end) {
-        __m128i data1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
-        __m128i high = _mm_unpackhi_epi8(data1, data1);
-        __m128i comparison = _mm_cmpeq_epi16(high, _mm_setzero_si128());
-        if (_mm_movemask_epi8(comparison))
-            return false;
-    }
 #endif
 
     while (ptr != end) {
@@ -6479,6 +6460,63 @@ int QString::localeAwareCompare_helper(const QChar *data1, int length1,
 #endif // !QT_CONFIG(icu)
 }
 
+/*!
+    \internal
+
+    Sets \a key to a sequence of bytes such that comparing the keys of two
+    strings with qstrcmp() gives the same order as
+    QString::localeAwareCompare() gives for the strings. Returns \c false,
+    for any string, on platforms that cannot provide such keys.
+*/
+bool qt_localeAwareSortKey(QStringView string, QByteArray *key)
+{
+    key->clear();
+#if !QT_CONFIG(icu) && defined(Q_OS_DARWIN)
+    // CFStringCompare() has no sort key counterpart
+    Q_UNUSED(string);
+    return false;
+#else
+    // Empty strings sort first, see localeAwareCompare_helper(); every other
+    // string gets a non-empty key
+    if (string.isEmpty())
+        return true;
+    key->append('\1');
+
+#  if QT_CONFIG(icu)
+    if (!defaultCollator()->hasLocalData())
+        defaultCollator()->setLocalData(QCollator());
+    key->append(defaultCollator()->localData().sortKey(string.toString()).toByteArray());
+#  else
+    const QString normalized = string.toString().normalized(QString::NormalizationForm_C);
+#    if defined(Q_OS_WIN)
+    const int size = LCMapStringEx(LOCALE_NAME_USER_DEFAULT, LCMAP_SORTKEY,
+                                   reinterpret_cast<LPCWSTR>(normalized.constData()),
+                                   normalized.length(), nullptr, 0, nullptr, nullptr, 0);
+    key->resize(1 + size);
+    const int written = LCMapStringEx(LOCALE_NAME_USER_DEFAULT, LCMAP_SORTKEY,
+                                      reinterpret_cast<LPCWSTR>(normalized.constData()),
+                                      normalized.length(),
+                                      reinterpret_cast<LPWSTR>(key->data() + 1), size,
+                                      nullptr, nullptr, 0);
+    // drop the terminating '\0'
+    key->truncate(qMax(written, 1));
+#    elif defined(Q_OS_UNIX)
+    // strcoll() orders as strcmp() orders the results of strxfrm(); ties are
+    // broken by comparing the UTF-16 code units, stored big-endian after the
+    // '\0' that terminates strxfrm()'s output
+    const QByteArray local = normalized.toLocal8Bit();
+    const int size = int(strxfrm(nullptr, local.constData(), 0));
+    key->resize(1 + size + 1 + 2 * normalized.size());
+    strxfrm(key->data() + 1, local.constData(), size + 1);
+    qToBigEndian<ushort>(normalized.constData(), normalized.size(), key->data() + 1 + size + 1);
+#    else
+#      error "This case shouldn't happen"
+#    endif
+#  endif // !QT_CONFIG(icu)
+    return true;
+#endif
+}
+
 
 /*!
     \fn const QChar *QString::unicode() const
@@ -8843,9 +8881,12 @@ struct Part
         : tag{QtPrivate::ArgBase::U16}, number{num}, data{s.utf16()}, size{s.size()} {}
     Q_DECL_CONSTEXPR Part(QLatin1String s, int num = -1)
         : tag{QtPrivate::ArgBase::L1}, number{num}, data{s.data()}, size{s.size()} {}
+    Q_DECL_CONSTEXPR Part(const QtPrivate::QUtf8StringArg &s, int num = -1)
+        : tag{QtPrivate::ArgBase::U8}, number{num}, data{s.data}, size{s.size} {}
 
     void reset(QStringView s) noexcept { *this = {s, number}; }
     void reset(QLatin1String s) noexcept { *this = {s, number}; }
+    void reset(const QtPrivate::QUtf8StringArg &s) noexcept { *this = {s, number}; }
 
     QtPrivate::ArgBase::Tag tag;
     int number;
@@ -8925,7 +8966,8 @@ static qsizetype resolveStringRefsAndReturnTotalSize(ParseResult &parts, const A
                     part.reset(static_cast<const QLatin1StringArg&>(arg).string);
                     break;
                 case ArgBase::U8:
-                    Q_UNREACHABLE(); // waiting for QUtf8String...
+                    // size is in bytes, an upper bound for the UTF-16 length
+                    part.reset(static_cast<const QUtf8StringArg&>(arg));
                     break;
                 case ArgBase::U16:
                     part.reset(static_cast<const QStringViewArg&>(arg).string);
@@ -8987,18 +9029,23 @@ static QString argToQStringImpl(StringView pattern, size_t numArgs, const QtPriv
                 qt_from_latin1(reinterpret_cast<ushort*>(out),
                                reinterpret_cast<const char*>(part.data), part.size);
             }
+            out += part.size;
             break;
         case QtPrivate::ArgBase::U8:
-            Q_UNREACHABLE(); // waiting for QUtf8String
+            if (part.size)
+                out = QUtf8::convertToUnicode(out, static_cast<const char *>(part.data), int(part.size));
             break;
         case QtPrivate::ArgBase::U16:
             if (part.size)
                 memcpy(out, part.data, part.size * sizeof(QChar));
+            out += part.size;
             break;
         }
-        out += part.size;
     }
 
+    if (out != result.constEnd()) // UTF-8 arguments decoded to fewer code units
+        result.truncate(int(out - result.constData()));
+
     return result;
 }
 
@@ -11903,6 +11950,9 @@ static inline qsizetype qFindChar(QStringView str, QChar ch, qsizetype from, Qt:
             if (n != e)
                 return n - s;
         } else {
+            const qsizetype filtered = qt_find_string_filtered(str, from, QStringView(&ch, 1), cs);
+            if (filtered != -2)
+                return filtered;
             c = foldCase(c);
             --n;
             while (++n != e)
@@ -11929,10 +11979,15 @@ qsizetype QtPrivate::findString(QStringView haystack0, qsizetype from, QStringVi
     if (sl == 1)
         return qFindChar(haystack0, needle0[0], from, cs);
 
+    const qsizetype filtered = qt_find_string_filtered(haystack0, from, needle0, cs);
+    if (filtered != -2)
+        return filtered;
+
     /*
-        We use the Boyer-Moore algorithm in cases where the overhead
-        for the skip table should pay off, otherwise we use a simple
-        hash function.
+        The filter above handles all case-sensitive searches and most
+        case-insensitive ones. For the rest, we use the Boyer-Moore algorithm
+        in cases where the overhead for the skip table should pay off,
+        otherwise we use a simple hash function.
     */
     if (l > 500 && sl > 5)
         return qFindStringBoyerMoore(haystack0, from, needle0, cs);
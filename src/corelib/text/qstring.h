@@ -78,6 +78,7 @@ class QString;
 class QStringList;
 class QTextCodec;
 class QStringRef;
+class QUtf8String;
 template <typename T> class QVector;
 
 namespace QtPrivate {
@@ -354,7 +355,8 @@ private:
         : std::integral_constant<bool,
             std::is_convertible<T, QString>::value ||
             std::is_convertible<T, QStringView>::value ||
-            std::is_convertible<T, QLatin1String>::value> {};
+            std::is_convertible<T, QLatin1String>::value ||
+            std::is_same<T, QUtf8String>::value> {};
     template <typename T>
     struct is_convertible_to_view_or_qstring
         : is_convertible_to_view_or_qstring_helper<typename std::decay<T>::type> {};
@@ -2042,6 +2044,13 @@ struct QLatin1StringArg : ArgBase {
     Q_DECL_CONSTEXPR explicit QLatin1StringArg(QLatin1String v) noexcept : ArgBase{L1}, string{v} {}
 };
 
+struct QUtf8StringArg : ArgBase {
+    const char *data;
+    qsizetype size;
+    QUtf8StringArg() = default;
+    Q_DECL_CONSTEXPR explicit QUtf8StringArg(const char *d, qsizetype n) noexcept : ArgBase{U8}, data{d}, size{n} {}
+};
+
 Q_REQUIRED_RESULT Q_CORE_EXPORT QString argToQString(QStringView pattern, size_t n, const ArgBase **args);
 Q_REQUIRED_RESULT Q_CORE_EXPORT QString argToQString(QLatin1String pattern, size_t n, const ArgBase **args);
 
@@ -2056,6 +2065,8 @@ Q_REQUIRED_RESULT Q_ALWAYS_INLINE QString argToQStringDispatch(StringView patter
 Q_DECL_CONSTEXPR inline QStringViewArg   qStringLikeToArg(QStringView s) noexcept { return QStringViewArg{s}; }
                  inline QStringViewArg   qStringLikeToArg(const QChar &c) noexcept { return QStringViewArg{QStringView{&c, 1}}; }
 Q_DECL_CONSTEXPR inline QLatin1StringArg qStringLikeToArg(QLatin1String s) noexcept { return QLatin1StringArg{s}; }
+                 inline QUtf8StringArg   qStringLikeToArg(const QUtf8String &s) noexcept; // in qutf8string.h
+                 inline QUtf8StringArg   qStringLikeToArg(const char *s) noexcept { return QUtf8StringArg{s, qsizetype(qstrlen(s))}; }
 
 } // namespace QtPrivate
 
@@ -40,6 +40,8 @@
 
 #include "qstringmatcher.h"
 
+#include <private/qsimd_p.h>
+
 QT_BEGIN_NAMESPACE
 
 static void bm_init_skiptable(const ushort *uc, qsizetype len, uchar *skiptable, Qt::CaseSensitivity cs)
@@ -121,6 +123,212 @@ static inline qsizetype bm_find(const ushort *uc, qsizetype l, qsizetype index,
     return -1; // not found
 }
 
+namespace {
+/*
+    A match at position i requires haystack[i + firstOffset] to be one of the
+    two forms of the needle's character at firstOffset, and likewise for
+    lastOffset. We test that for many positions at once and only compare the
+    positions that pass in full. This is a lot cheaper than the Boyer-Moore
+    skip loop or a rolling hash for the needle lengths commonly used.
+*/
+struct StringSearchFilter
+{
+    qsizetype firstOffset;
+    qsizetype lastOffset;
+    ushort first[2];
+    ushort last[2];
+
+    bool matches(const ushort *candidate) const noexcept
+    {
+        const ushort f = candidate[firstOffset];
+        const ushort l = candidate[lastOffset];
+        return (f == first[0] || f == first[1]) && (l == last[0] || l == last[1]);
+    }
+};
+} // unnamed namespace
+
+/*
+    Sets \a forms to the UTF-16 code units that compare equal to \a c under
+    \a cs, if there are at most two of them. We only know that for Latin-1.
+*/
+static bool qt_search_filter_forms(ushort c, Qt::CaseSensitivity cs, ushort *forms) noexcept
+{
+    forms[0] = forms[1] = c;
+    if (cs == Qt::CaseSensitive)
+        return true;
+    if (c >= 0x100)
+        return false;
+
+    const ushort folded = foldCase(c);
+    forms[0] = forms[1] = folded;
+    switch (folded) {
+    case 'k':       // U+212A KELVIN SIGN
+    case 's':       // U+017F LATIN SMALL LETTER LONG S
+    case 0xe5:      // U+212B ANGSTROM SIGN
+        return false;
+    case 0xdf:
+        forms[1] = 0x1e9e;  // LATIN CAPITAL LETTER SHARP S
+        return true;
+    case 0xff:
+        forms[1] = 0x178;   // LATIN CAPITAL LETTER Y WITH DIAERESIS
+        return true;
+    }
+    if (folded >= 0x100)    // U+00B5 MICRO SIGN folds to Greek
+        return false;
+    if ((folded >= 'a' && folded <= 'z') || (folded >= 0xe0 && folded <= 0xfe && folded != 0xf7))
+        forms[1] = folded - 0x20;
+    return true;
+}
+
+/*
+    Picks the characters of \a needle to filter candidate positions on: the
+    first and the last one, or for case-insensitive searches, the outermost
+    ones whose case forms we know. Returns false if there are none.
+*/
+static bool qt_init_search_filter(StringSearchFilter *filter, QStringView needle, Qt::CaseSensitivity cs) noexcept
+{
+    const ushort *n = reinterpret_cast<const ushort *>(needle.data());
+    const qsizetype sl = needle.size();
+    qsizetype first = 0;
+    while (first < sl && !qt_search_filter_forms(n[first], cs, filter->first))
+        ++first;
+    if (first == sl)
+        return false;
+    qsizetype last = sl - 1;
+    while (!qt_search_filter_forms(n[last], cs, filter->last))
+        --last;
+    filter->firstOffset = first;
+    filter->lastOffset = last;
+    return true;
+}
+
+/*
+    Returns the first of the \a count positions in \a haystack that passes
+    \a filter and for which \a verify returns true, or -1.
+*/
+template <typename Verify>
+static qsizetype qt_find_filtered(const ushort *haystack, qsizetype count,
+                                  const StringSearchFilter &filter, Verify verify)
+{
+    qsizetype i = 0;
+#if defined(__SSE2__)
+    const ushort *first = haystack + filter.firstOffset;
+    const ushort *last = haystack + filter.lastOffset;
+
+    // Using the PMOVMSKB instruction, we get two bits for each position
+    auto checkCandidates = [&](uint mask) -> qsizetype {
+        while (mask) {
+            const uint idx = qCountTrailingZeroBits(mask) / 2;
+            if (verify(i + idx))
+                return i + idx;
+            mask &= ~(3U << (2 * idx));
+        }
+        return -1;
+    };
+
+#  if defined(__AVX2__) && !defined(__OPTIMIZE_SIZE__)
+    // we're going to read first[i..i+15] and last[i..i+15] (32 bytes each)
+    const __m256i first0 = _mm256_set1_epi16(short(filter.first[0]));
+    const __m256i first1 = _mm256_set1_epi16(short(filter.first[1]));
+    const __m256i last0 = _mm256_set1_epi16(short(filter.last[0]));
+    const __m256i last1 = _mm256_set1_epi16(short(filter.last[1]));
+    for ( ; i + 16 <= count; i += 16) {
+        const __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + i));
+        const __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(last + i));
+        const __m256i result = _mm256_and_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi16(f, first0), _mm256_cmpeq_epi16(f, first1)),
+                    _mm256_or_si256(_mm256_cmpeq_epi16(l, last0), _mm256_cmpeq_epi16(l, last1)));
+        const qsizetype found = checkCandidates(uint(_mm256_movemask_epi8(result)));
+        if (found >= 0)
+            return found;
+    }
+#  endif
+
+    // we're going to read first[i..i+7] and last[i..i+7] (16 bytes each)
+    const __m128i mfirst0 = _mm_set1_epi16(short(filter.first[0]));
+    const __m128i mfirst1 = _mm_set1_epi16(short(filter.first[1]));
+    const __m128i mlast0 = _mm_set1_epi16(short(filter.last[0]));
+    const __m128i mlast1 = _mm_set1_epi16(short(filter.last[1]));
+    for ( ; i + 8 <= count; i += 8) {
+        const __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + i));
+        const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(last + i));
+        const __m128i result = _mm_and_si128(
+                    _mm_or_si128(_mm_cmpeq_epi16(f, mfirst0), _mm_cmpeq_epi16(f, mfirst1)),
+                    _mm_or_si128(_mm_cmpeq_epi16(l, mlast0), _mm_cmpeq_epi16(l, mlast1)));
+        const qsizetype found = checkCandidates(uint(_mm_movemask_epi8(result)));
+        if (found >= 0)
+            return found;
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) // vmaxv is only available on Aarch64
+    const ushort *first = haystack + filter.firstOffset;
+    const ushort *last = haystack + filter.lastOffset;
+    const uint16x8_t first0 = vdupq_n_u16(filter.first[0]);
+    const uint16x8_t first1 = vdupq_n_u16(filter.first[1]);
+    const uint16x8_t last0 = vdupq_n_u16(filter.last[0]);
+    const uint16x8_t last1 = vdupq_n_u16(filter.last[1]);
+    for ( ; i + 8 <= count; i += 8) {
+        const uint16x8_t f = vld1q_u16(first + i);
+        const uint16x8_t l = vld1q_u16(last + i);
+        const uint16x8_t result = vandq_u16(vorrq_u16(vceqq_u16(f, first0), vceqq_u16(f, first1)),
+                                            vorrq_u16(vceqq_u16(l, last0), vceqq_u16(l, last1)));
+        if (vmaxvq_u16(result)) {
+            // rare enough that the scalar check below is good enough
+            for (qsizetype j = i; j < i + 8; ++j) {
+                if (filter.matches(haystack + j) && verify(j))
+                    return j;
+            }
+        }
+    }
+#endif
+
+    for ( ; i < count; ++i) {
+        if (filter.matches(haystack + i) && verify(i))
+            return i;
+    }
+    return -1;
+}
+
+static bool qt_matches_at(const ushort *candidate, QStringView needle, Qt::CaseSensitivity cs) noexcept
+{
+    const ushort *n = reinterpret_cast<const ushort *>(needle.data());
+    if (cs == Qt::CaseSensitive)
+        return memcmp(candidate, n, needle.size() * sizeof(ushort)) == 0;
+    for (qsizetype k = 0; k < needle.size(); ++k) {
+        if (foldCase(candidate + k, candidate) != foldCase(n + k, n))
+            return false;
+    }
+    return true;
+}
+
+/*
+    Searches \a haystack for \a needle from position \a from using the first
+    and last character filter. Returns -2 if the filter can't be used for
+    this needle, or if the Boyer-Moore algorithm is expected to be faster:
+    with long needles, its skip loop moves ahead further per step than the
+    filter does (unless it needs to fold the case of every character).
+*/
+static qsizetype qt_find_string_filtered(QStringView haystack, qsizetype from,
+                                         QStringView needle, Qt::CaseSensitivity cs) noexcept
+{
+    if (cs == Qt::CaseSensitive && needle.size() >= 64 && haystack.size() > 500)
+        return -2;
+
+    StringSearchFilter filter;
+    if (!qt_init_search_filter(&filter, needle, cs))
+        return -2;
+    if (from < 0)
+        from = 0;
+    const qsizetype count = haystack.size() - needle.size() - from + 1;
+    if (count <= 0)
+        return -1;
+
+    const ushort *start = reinterpret_cast<const ushort *>(haystack.data()) + from;
+    const qsizetype idx = qt_find_filtered(start, count, filter, [=](qsizetype i) {
+        return qt_matches_at(start + i, needle, cs);
+    });
+    return idx < 0 ? -1 : from + idx;
+}
+
 /*!
     \class QStringMatcher
     \inmodule QtCore
@@ -316,6 +524,9 @@ qsizetype QStringMatcher::indexIn(QStringView str, qsizetype from) const
 {
     if (from < 0)
         from = 0;
+    const qsizetype result = qt_find_string_filtered(str, from, QStringView(p.uc, p.len), q_cs);
+    if (result != -2)
+        return result;
     return bm_find((const ushort *)str.data(), str.size(), from,
                    (const ushort *)p.uc, p.len,
                    p.q_skiptable, q_cs);
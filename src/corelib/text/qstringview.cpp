@@ -541,7 +541,8 @@ QT_BEGIN_NAMESPACE
     \c Args can consist of anything that implicitly converts to QString,
     QStringView or QLatin1String.
 
-    In addition, the following types are also supported: QChar, QLatin1Char.
+    In addition, the following types are also supported: QChar, QLatin1Char,
+    and (since 6.0) QUtf8String, which is decoded directly into the result.
 
     \sa QString::arg()
 */
@@ -40,7 +40,9 @@
 #include "qunicodetools_p.h"
 
 #include "qunicodetables_p.h"
+#include "qstringview.h"
 #include "qvarlengtharray.h"
+#include "private/qsimd_p.h"
 
 #include "qharfbuzz_p.h"
 
@@ -153,6 +155,41 @@ static void getGraphemeBreaks(const ushort *string, quint32 len, QCharAttributes
     attributes[len].graphemeBoundary = true; // GB2
 }
 
+// Latin-1 has no extending, joining or prepended characters, so the only
+// grapheme cluster made of more than one character is CR LF (GB3).
+static void getLatin1GraphemeBreaks(const ushort *string, quint32 len, QCharAttributes *attributes)
+{
+    attributes[0].graphemeBoundary = true; // GB1
+    quint32 i = 1;
+#ifdef __SSE2__
+    Q_STATIC_ASSERT(sizeof(QCharAttributes) == 1);
+    QCharAttributes boundary = {};
+    boundary.graphemeBoundary = true;
+    uchar boundaryBit;
+    memcpy(&boundaryBit, &boundary, 1);
+
+    const __m128i cr = _mm_set1_epi16('\r');
+    const __m128i lf = _mm_set1_epi16('\n');
+    const __m128i bits = _mm_set1_epi8(boundaryBit);
+    uchar *bytes = reinterpret_cast<uchar *>(attributes);
+    for ( ; i + 8 <= len; i += 8) {
+        const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i *>(string + i));
+        const __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i *>(string + i - 1));
+        const __m128i crlf = _mm_and_si128(_mm_cmpeq_epi16(current, lf), _mm_cmpeq_epi16(previous, cr));
+        // one byte per character: 0xff at CR LF, 0 elsewhere
+        const __m128i mask = _mm_packs_epi16(crlf, crlf);
+        const __m128i old = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(bytes + i));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(bytes + i),
+                         _mm_or_si128(old, _mm_andnot_si128(mask, bits)));
+    }
+#endif
+    for ( ; i != len; ++i) {
+        if (string[i] != '\n' || string[i - 1] != '\r')
+            attributes[i].graphemeBoundary = true;
+    }
+    attributes[len].graphemeBoundary = true; // GB2
+}
+
 
 namespace WB {
 
@@ -601,6 +638,12 @@ static void getLineBreaks(const ushort *string, quint32 len, QCharAttributes *at
             // LB4: BK!, LB5: (CRxLF|CR|LF|NL)!
             if (lcls > QUnicodeTables::LineBreak_CR || ncls != QUnicodeTables::LineBreak_LF)
                 attributes[pos].lineBreak = attributes[pos].mandatoryBreak = true;
+            // LB25: a number sequence ends at the line break, like it does at the end of text
+            if (Q_UNLIKELY(LB::NS::actionTable[nelast][LB::NS::XX] == LB::NS::Break)) {
+                for (quint32 j = nestart + 1; j < pos; ++j)
+                    attributes[j].lineBreak = false;
+            }
+            nelast = LB::NS::XX;
             if (Q_UNLIKELY(ncls == QUnicodeTables::LineBreak_CM || ncls == QUnicodeTables::LineBreak_ZWJ)) {
                 cls = QUnicodeTables::LineBreak_AL;
                 goto next_no_cls_update;
@@ -709,17 +752,9 @@ static void getLineBreaks(const ushort *string, quint32 len, QCharAttributes *at
 
 static void getWhiteSpaces(const ushort *string, quint32 len, QCharAttributes *attributes)
 {
+    // all white space characters are in the BMP, so surrogate pairs need no decoding
     for (quint32 i = 0; i != len; ++i) {
-        uint ucs4 = string[i];
-        if (QChar::isHighSurrogate(ucs4) && i + 1 != len) {
-            ushort low = string[i + 1];
-            if (QChar::isLowSurrogate(low)) {
-                ucs4 = QChar::surrogateToUcs4(ucs4, low);
-                ++i;
-            }
-        }
-
-        if (Q_UNLIKELY(QChar::isSpace(ucs4)))
+        if (Q_UNLIKELY(QChar::isSpace(string[i])))
             attributes[i].whiteSpace = true;
     }
 }
@@ -735,8 +770,12 @@ Q_CORE_EXPORT void initCharAttributes(const ushort *string, int length,
     if (!(options & DontClearAttributes))
         ::memset(attributes, 0, (length + 1) * sizeof(QCharAttributes));
 
-    if (options & GraphemeBreaks)
-        getGraphemeBreaks(string, length, attributes);
+    if (options & GraphemeBreaks) {
+        if (QtPrivate::isLatin1(QStringView(reinterpret_cast<const QChar *>(string), length)))
+            getLatin1GraphemeBreaks(string, length, attributes);
+        else
+            getGraphemeBreaks(string, length, attributes);
+    }
     if (options & WordBreaks)
         getWordBreaks(string, length, attributes);
     if (options & SentenceBreaks)
@@ -785,6 +824,75 @@ Q_CORE_EXPORT void initCharAttributes(const ushort *string, int length,
     }
 }
 
+// Returns true if the character before pos ends a paragraph. All the boundary
+// algorithms above break there unconditionally and restart from their initial state,
+// so the attributes of a paragraph don't depend on the text around it.
+static inline bool isParagraphStart(const ushort *string, int length, int pos)
+{
+    switch (string[pos - 1]) {
+    case '\r':
+        return pos == length || string[pos] != '\n';
+    case '\n':
+    case 0x0085: // NEXT LINE
+    case QChar::LineSeparator:
+    case QChar::ParagraphSeparator:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Q_CORE_EXPORT void updateCharAttributes(const ushort *string, int length, int position,
+                                        int charsRemoved, int charsAdded,
+                                        const ScriptItem *items, int numItems,
+                                        QCharAttributes *attributes, CharAttributeOptions options)
+{
+    const int oldLength = length - charsAdded + charsRemoved;
+    Q_ASSERT(position >= 0 && charsRemoved >= 0 && charsAdded >= 0);
+    Q_ASSERT(position + charsRemoved <= oldLength && position + charsAdded <= length);
+
+    // keep the attributes of the unchanged text after the edit, including the end of text
+    if (charsAdded != charsRemoved) {
+        ::memmove(attributes + position + charsAdded, attributes + position + charsRemoved,
+                  (oldLength - position - charsRemoved + 1) * sizeof(QCharAttributes));
+    }
+    if (length <= 0)
+        return;
+
+    // Recompute the paragraphs touched by the edit. A paragraph following the edit
+    // can be kept as is only if the separator in front of it wasn't edited either.
+    int from = qMin(position, length - 1);
+    while (from > 0 && !isParagraphStart(string, length, from))
+        --from;
+    int to = position + charsAdded + 1;
+    while (to < length && !isParagraphStart(string, length, to))
+        ++to;
+    if (to > length)
+        to = length;
+
+    QVarLengthArray<ScriptItem, 64> clippedItems;
+    if (items && numItems > 0) {
+        int first = 0;
+        while (first + 1 < numItems && items[first + 1].position <= from)
+            ++first;
+        for (int i = first; i < numItems && items[i].position < to; ++i) {
+            ScriptItem item = items[i];
+            item.position = qMax(item.position, from) - from;
+            clippedItems.append(item);
+        }
+    }
+
+    const QCharAttributes next = attributes[to];
+    initCharAttributes(string + from, to - from, clippedItems.constData(), clippedItems.size(),
+                       attributes + from, options & ~DontClearAttributes);
+    if (to != length)
+        attributes[to] = next;
+    if (from != 0 && (options & LineBreaks)) {
+        // LB2 applies to the start of the text only
+        attributes[from].lineBreak = attributes[from].mandatoryBreak = true;
+    }
+}
+
 
 // ----------------------------------------------------------------------------
 //
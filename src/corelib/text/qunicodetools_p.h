@@ -100,6 +100,15 @@ Q_CORE_EXPORT void initCharAttributes(const ushort *string, int length,
                                       const ScriptItem *items, int numItems,
                                       QCharAttributes *attributes, CharAttributeOptions options = DefaultOptionsCompat);
 
+// updates the attributes computed by initCharAttributes() for the text before \a charsRemoved
+// characters at \a position were replaced by \a charsAdded ones; only the paragraphs touched
+// by the edit are recomputed. \a options must be the same as for the original computation,
+// and the attributes buffer has to have a length of the longer of the two string lengths + 1
+Q_CORE_EXPORT void updateCharAttributes(const ushort *string, int length, int position,
+                                        int charsRemoved, int charsAdded,
+                                        const ScriptItem *items, int numItems,
+                                        QCharAttributes *attributes, CharAttributeOptions options = DefaultOptionsCompat);
+
 
 Q_CORE_EXPORT void initScripts(const ushort *string, int length, uchar *scripts);
 
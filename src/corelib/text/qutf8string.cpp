@@ -0,0 +1,881 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+
+#include "qutf8string.h"
+
+#include <private/qutfcodec_p.h>
+
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdebug.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QUtf8String
+    \inmodule QtCore
+    \reentrant
+    \since 6.0
+
+    \brief The QUtf8String class provides an implicitly shared string stored
+    as UTF-8.
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    QUtf8String holds text in UTF-8, the encoding used by most files, network
+    protocols and JSON documents. Data read in that encoding can be kept,
+    searched, split and written out again without being converted to UTF-16
+    and back, which is what happens when it passes through QString.
+
+    The string is backed by an implicitly shared QByteArray: constructing a
+    QUtf8String from a QByteArray, and toByteArray(), do not copy the data.
+    Conversions to and from QString happen only when asked for, with the
+    explicit QUtf8String(QStringView) constructor and toString().
+
+    \snippet code/src_corelib_text_qutf8string.cpp 0
+
+    All sizes, positions and lengths are in bytes (UTF-8 code units), just as
+    QString counts UTF-16 code units. When both a string and the text being
+    searched for are valid UTF-8, every match starts and ends on a character
+    boundary, so the results of indexOf(), split() and replace() are valid
+    UTF-8 too. The contents are not validated on construction; use
+    isValidUtf8() to check data from untrusted sources. Invalid sequences
+    become U+FFFD when converted to QString.
+
+    Strings compare by bytes, which for UTF-8 is the same as comparing by
+    Unicode code point. Note that this can differ from QString's ordering,
+    which compares UTF-16 code units. Comparisons with QStringView decode
+    the UTF-8 on the fly and need no temporary QString.
+
+    Several classes accept QUtf8String without converting it: QJsonValue
+    keeps the UTF-8 data as it is, QJsonDocument::toJson() writes it
+    directly, QTextStream writes it straight to a UTF-8 device, and
+    QString::arg() decodes it directly into the result.
+
+    \sa QString, QByteArray, QStringView
+*/
+
+/*!
+    \fn QUtf8String::QUtf8String()
+
+    Constructs a null string.
+
+    \sa isNull()
+*/
+
+/*!
+    \fn QUtf8String::QUtf8String(const char *utf8)
+
+    Constructs a string from the '\\0'-terminated UTF-8 data \a utf8. The
+    data is copied.
+*/
+
+/*!
+    \fn QUtf8String::QUtf8String(const char *utf8, qsizetype size)
+
+    Constructs a string from the first \a size bytes of the UTF-8 data
+    \a utf8. If \a size is negative, \a utf8 is assumed to be
+    '\\0'-terminated. The data is copied.
+*/
+
+/*!
+    \fn QUtf8String::QUtf8String(const QByteArray &utf8)
+    \fn QUtf8String::QUtf8String(QByteArray &&utf8)
+
+    Constructs a string that shares the UTF-8 data held by \a utf8.
+*/
+
+/*!
+    \fn QUtf8String::QUtf8String(QStringView str)
+
+    Constructs a string by converting \a str to UTF-8. A null view
+    results in a null string.
+*/
+
+/*!
+    Constructs a string by converting the Latin-1 string \a str to UTF-8.
+    US-ASCII data, which is already valid UTF-8, is copied as is.
+*/
+QUtf8String::QUtf8String(QLatin1String str)
+    : d(QtPrivate::isAscii(str) ? QByteArray(str.data(), str.size()) : QString(str).toUtf8())
+{
+}
+
+/*!
+    \fn QUtf8String QUtf8String::fromRawData(const char *utf8, qsizetype size)
+
+    Constructs a string that uses the first \a size bytes of \a utf8 without
+    copying them. The data must stay valid and unmodified for as long as
+    the string, or any copy of it, exists.
+
+    \sa QByteArray::fromRawData()
+*/
+
+/*!
+    \fn void QUtf8String::swap(QUtf8String &other)
+
+    Swaps this string with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    \fn qsizetype QUtf8String::size() const
+    \fn qsizetype QUtf8String::length() const
+
+    Returns the number of bytes in this string.
+*/
+
+/*!
+    \fn bool QUtf8String::isEmpty() const
+
+    Returns \c true if the string has no bytes; otherwise returns \c false.
+*/
+
+/*!
+    \fn bool QUtf8String::isNull() const
+
+    Returns \c true if this string is null; otherwise returns \c false.
+*/
+
+/*!
+    Returns \c true if this string holds well-formed UTF-8; otherwise
+    returns \c false.
+*/
+bool QUtf8String::isValidUtf8() const noexcept
+{
+    return QUtf8::isValidUtf8(d.constData(), d.size()).isValidUtf8;
+}
+
+/*!
+    \fn const char *QUtf8String::constData() const
+    \fn const char *QUtf8String::data() const
+
+    Returns a pointer to the '\\0'-terminated UTF-8 data of this string.
+*/
+
+/*!
+    \fn char QUtf8String::at(qsizetype i) const
+    \fn char QUtf8String::operator[](qsizetype i) const
+
+    Returns the byte at index position \a i, which must be a valid index
+    position in the string.
+*/
+
+/*!
+    \fn QUtf8String::const_iterator QUtf8String::begin() const
+    \fn QUtf8String::const_iterator QUtf8String::cbegin() const
+
+    Returns an iterator pointing to the first byte of the string.
+*/
+
+/*!
+    \fn QUtf8String::const_iterator QUtf8String::end() const
+    \fn QUtf8String::const_iterator QUtf8String::cend() const
+
+    Returns an iterator pointing just after the last byte of the string.
+*/
+
+/*!
+    \fn qsizetype QUtf8String::capacity() const
+    \fn void QUtf8String::reserve(qsizetype size)
+    \fn void QUtf8String::squeeze()
+
+    These functions manage the allocated storage, in bytes, the same way as
+    the QByteArray functions of the same name.
+*/
+
+/*!
+    \fn void QUtf8String::clear()
+
+    Clears the contents of the string and makes it null.
+*/
+
+/*!
+    \fn void QUtf8String::truncate(qsizetype pos)
+
+    Truncates the string at byte position \a pos.
+*/
+
+/*!
+    \fn void QUtf8String::chop(qsizetype n)
+
+    Removes \a n bytes from the end of the string.
+*/
+
+/*!
+    \fn QUtf8String QUtf8String::left(qsizetype n) const
+    \fn QUtf8String QUtf8String::right(qsizetype n) const
+    \fn QUtf8String QUtf8String::mid(qsizetype pos, qsizetype n) const
+    \fn QUtf8String QUtf8String::chopped(qsizetype n) const
+
+    Return substrings of this string, with positions and lengths in bytes,
+    like the QByteArray functions of the same name.
+*/
+
+static inline bool isContinuationByte(uchar b)
+{
+    return (b & 0xc0) == 0x80;
+}
+
+// Decodes the character starting at p into *uc; returns the number of bytes
+// it occupies, or a negative value if the data is not valid UTF-8.
+static int decodeCharacter(const uchar *p, const uchar *end, uint *uc)
+{
+    const uchar *src = p + 1;
+    return QUtf8Functions::fromUtf8<QUtf8BaseTraits>(*p, uc, src, end);
+}
+
+static qsizetype characterCount(const QByteArray &utf8)
+{
+    return std::count_if(utf8.cbegin(), utf8.cend(),
+                         [](char c) { return !isContinuationByte(uchar(c)); });
+}
+
+/*!
+    Returns a string with the white space removed from the start and the
+    end. White space means any character for which QChar::isSpace() returns
+    \c true, including the ones encoded with more than one byte.
+
+    \sa QString::trimmed()
+*/
+QUtf8String QUtf8String::trimmed() const
+{
+    const uchar *const begin = reinterpret_cast<const uchar *>(d.constData());
+    const uchar *const end = begin + d.size();
+    const uchar *b = begin;
+    const uchar *e = end;
+    uint uc = 0;
+
+    while (b < e) {
+        const int len = decodeCharacter(b, e, &uc);
+        if (len < 0 || !QChar::isSpace(uc))
+            break;
+        b += len;
+    }
+    while (e > b) {
+        const uchar *p = e - 1;
+        while (p > b && isContinuationByte(*p))
+            --p;
+        if (decodeCharacter(p, e, &uc) != e - p || !QChar::isSpace(uc))
+            break;
+        e = p;
+    }
+
+    if (b == begin && e == end)
+        return *this;
+    return QUtf8String(reinterpret_cast<const char *>(b), e - b);
+}
+
+/*!
+    \fn qsizetype QUtf8String::indexOf(const QUtf8String &str, qsizetype from) const
+    \fn qsizetype QUtf8String::indexOf(char ch, qsizetype from) const
+
+    Returns the byte position of the first occurrence of \a str (or the
+    US-ASCII character \a ch) in this string, searching forward from byte
+    position \a from. Returns -1 if there is no match.
+*/
+
+/*!
+    \fn qsizetype QUtf8String::lastIndexOf(const QUtf8String &str, qsizetype from) const
+    \fn qsizetype QUtf8String::lastIndexOf(char ch, qsizetype from) const
+
+    Returns the byte position of the last occurrence of \a str (or the
+    US-ASCII character \a ch) in this string, searching backward from byte
+    position \a from. If \a from is -1, the search starts at the last byte.
+    Returns -1 if there is no match.
+*/
+
+/*!
+    \fn bool QUtf8String::contains(const QUtf8String &str) const
+    \fn bool QUtf8String::contains(char ch) const
+
+    Returns \c true if this string contains \a str (or \a ch); otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool QUtf8String::startsWith(const QUtf8String &str) const
+    \fn bool QUtf8String::startsWith(char ch) const
+    \fn bool QUtf8String::endsWith(const QUtf8String &str) const
+    \fn bool QUtf8String::endsWith(char ch) const
+
+    Returns \c true if this string starts (or ends) with \a str (or \a ch);
+    otherwise returns \c false.
+*/
+
+/*!
+    Splits the string into substrings wherever \a sep occurs, and returns
+    the list of those strings. If \a sep does not match anywhere in the
+    string, the list contains this string only.
+
+    If \a behavior is Qt::SkipEmptyParts, empty entries don't appear in the
+    result. An empty \a sep splits the string into its characters, each of
+    which can span several bytes, in the same way as QString::split().
+*/
+QList<QUtf8String> QUtf8String::split(const QUtf8String &sep, Qt::SplitBehavior behavior) const
+{
+    QList<QUtf8String> list;
+    const qsizetype sepSize = sep.size();
+    const qsizetype len = size();
+    qsizetype start = 0;
+    qsizetype extra = 0;
+    qsizetype end;
+    while (true) {
+        if (sepSize) {
+            end = indexOf(sep, start);
+        } else {
+            // an empty separator matches between characters, not between bytes
+            end = start + extra;
+            while (end < len && isContinuationByte(uchar(d.at(int(end)))))
+                ++end;
+            if (end > len)
+                end = -1;
+        }
+        if (end == -1)
+            break;
+        if (start != end || behavior == Qt::KeepEmptyParts)
+            list.append(mid(start, end - start));
+        start = end + sepSize;
+        extra = (sepSize == 0 ? 1 : 0);
+    }
+    if (start != len || behavior == Qt::KeepEmptyParts)
+        list.append(mid(start));
+    return list;
+}
+
+/*!
+    \overload
+
+    Splits the string wherever the US-ASCII character \a sep occurs.
+*/
+QList<QUtf8String> QUtf8String::split(char sep, Qt::SplitBehavior behavior) const
+{
+    return split(fromRawData(&sep, 1), behavior);
+}
+
+/*!
+    \fn QUtf8String &QUtf8String::append(const QUtf8String &str)
+    \fn QUtf8String &QUtf8String::append(const char *str)
+    \fn QUtf8String &QUtf8String::append(char ch)
+    \fn QUtf8String &QUtf8String::operator+=(const QUtf8String &str)
+    \fn QUtf8String &QUtf8String::operator+=(const char *str)
+    \fn QUtf8String &QUtf8String::operator+=(char ch)
+
+    Appends \a str (or \a ch) to the end of this string and returns a
+    reference to this string.
+*/
+
+/*!
+    \fn QUtf8String &QUtf8String::prepend(const QUtf8String &str)
+
+    Prepends \a str to the beginning of this string and returns a reference
+    to this string.
+*/
+
+/*!
+    \fn QUtf8String &QUtf8String::replace(const QUtf8String &before, const QUtf8String &after)
+
+    Replaces every occurrence of \a before with \a after and returns a
+    reference to this string.
+*/
+
+namespace {
+struct ArgEscapeData
+{
+    int min_escape;            // lowest escape sequence number
+    int occurrences;           // number of occurrences of the lowest escape sequence number
+    int locale_occurrences;    // number of occurrences of the lowest escape sequence number that
+                               // contain 'L'
+};
+} // unnamed namespace
+
+static inline int digitValue(const char *c, const char *end)
+{
+    return c != end && uint(*c - '0') < 10 ? *c - '0' : -1;
+}
+
+// Same rules as QString's findArgEscapes(): %1 to %99, optionally %L1
+static ArgEscapeData findArgEscapes(const QByteArray &s)
+{
+    const char *c = s.cbegin();
+    const char *const end = s.cend();
+
+    ArgEscapeData d;
+    d.min_escape = INT_MAX;
+    d.occurrences = 0;
+    d.locale_occurrences = 0;
+
+    while (c != end) {
+        c = std::find(c, end, '%');
+        if (c == end || ++c == end)
+            break;
+
+        bool locale_arg = false;
+        if (*c == 'L') {
+            locale_arg = true;
+            if (++c == end)
+                break;
+        }
+
+        int escape = digitValue(c, end);
+        if (escape == -1)
+            continue;
+        ++c;
+        const int next_escape = digitValue(c, end);
+        if (next_escape != -1) {
+            escape = (10 * escape) + next_escape;
+            ++c;
+        }
+
+        if (escape > d.min_escape)
+            continue;
+        if (escape < d.min_escape) {
+            d.min_escape = escape;
+            d.occurrences = 0;
+            d.locale_occurrences = 0;
+        }
+        ++d.occurrences;
+        if (locale_arg)
+            ++d.locale_occurrences;
+    }
+    return d;
+}
+
+static QByteArray replaceArgEscapes(const QByteArray &s, const ArgEscapeData &d, int fieldWidth,
+                                    const QByteArray &arg, const QByteArray &larg, QChar fillChar)
+{
+    // the field width counts characters, like QString's counts UTF-16 code units
+    const qsizetype absFieldWidth = qAbs(fieldWidth);
+    const QByteArray fill = absFieldWidth ? QUtf8::convertFromUnicode(&fillChar, 1) : QByteArray();
+    const auto padding = [&](const QByteArray &a) {
+        return absFieldWidth ? qMax(absFieldWidth - characterCount(a), qsizetype(0)) : 0;
+    };
+    const qsizetype argPadding = d.occurrences > d.locale_occurrences ? padding(arg) : 0;
+    const qsizetype largPadding = d.locale_occurrences ? padding(larg) : 0;
+
+    QByteArray result;
+    result.reserve(int(s.size() + (d.occurrences - d.locale_occurrences) * (arg.size() + argPadding * fill.size())
+                   + d.locale_occurrences * (larg.size() + largPadding * fill.size())));
+
+    const char *c = s.cbegin();
+    const char *const end = s.cend();
+    int replaced = 0;
+    while (replaced < d.occurrences) {
+        const char *const text_start = c;
+        c = std::find(c, end, '%');
+        const char *const escape_start = c++;
+
+        bool locale_arg = false;
+        if (c != end && *c == 'L') {
+            locale_arg = true;
+            ++c;
+        }
+
+        int escape = digitValue(c, end);
+        if (escape != -1) {
+            ++c;
+            const int next_escape = digitValue(c, end);
+            if (next_escape != -1) {
+                escape = (10 * escape) + next_escape;
+                ++c;
+            }
+        }
+
+        if (escape != d.min_escape) {
+            result.append(text_start, int(c - text_start));
+            continue;
+        }
+
+        result.append(text_start, int(escape_start - text_start));
+        const qsizetype pad = locale_arg ? largPadding : argPadding;
+        if (fieldWidth > 0) { // left padded
+            for (qsizetype i = 0; i < pad; ++i)
+                result += fill;
+        }
+        result += locale_arg ? larg : arg;
+        if (fieldWidth < 0) { // right padded
+            for (qsizetype i = 0; i < pad; ++i)
+                result += fill;
+        }
+        ++replaced;
+    }
+    result.append(c, int(end - c));
+    return result;
+}
+
+/*!
+    Returns a copy of this string with the lowest numbered place marker
+    (\c{%1}, \c{%2}, ..., \c{%99}) replaced by the string \a a. Place
+    markers written as \c{%L1} are replaced too.
+
+    \a fieldWidth specifies the minimum number of characters that \a a
+    occupies; the remainder is filled with \a fillChar. A positive value
+    produces right-aligned text and a negative value left-aligned text.
+
+    This works like QString::arg(), on UTF-8 data and without converting
+    to UTF-16.
+*/
+QUtf8String QUtf8String::arg(const QUtf8String &a, int fieldWidth, QChar fillChar) const
+{
+    const ArgEscapeData e = findArgEscapes(d);
+    if (e.occurrences == 0) {
+        qWarning("QUtf8String::arg: Argument missing: %s, %s", d.constData(), a.d.constData());
+        return *this;
+    }
+    return QUtf8String(replaceArgEscapes(d, e, fieldWidth, a.d, a.d, fillChar));
+}
+
+// Numbers are formatted by QString, which owns the C and system locale
+// rules (including %L); the results are short and almost always US-ASCII.
+template <typename Number, typename...Options>
+static QUtf8String numberArg(const QUtf8String &s, const QByteArray &d, Number a, Options...options)
+{
+    const ArgEscapeData e = findArgEscapes(d);
+    if (e.occurrences == 0) {
+        qWarning() << "QUtf8String::arg: Argument missing:" << s << ',' << a;
+        return s;
+    }
+
+    QByteArray arg;
+    if (e.occurrences > e.locale_occurrences)
+        arg = QStringLiteral("%1").arg(a, options...).toUtf8();
+    QByteArray locale_arg;
+    if (e.locale_occurrences > 0)
+        locale_arg = QStringLiteral("%L1").arg(a, options...).toUtf8();
+
+    // the field width was already applied while formatting
+    return QUtf8String(replaceArgEscapes(d, e, 0, arg, locale_arg, QChar()));
+}
+
+/*!
+    \overload
+
+    Replaces the lowest numbered place marker with the integer \a a, using
+    \a base, \a fieldWidth and \a fillChar as QString::arg() does. \c{%L1}
+    place markers get the localized representation of \a a.
+*/
+QUtf8String QUtf8String::arg(qlonglong a, int fieldWidth, int base, QChar fillChar) const
+{
+    return numberArg(*this, d, a, fieldWidth, base, fillChar);
+}
+
+/*!
+    \overload
+*/
+QUtf8String QUtf8String::arg(qulonglong a, int fieldWidth, int base, QChar fillChar) const
+{
+    return numberArg(*this, d, a, fieldWidth, base, fillChar);
+}
+
+/*!
+    \fn QUtf8String QUtf8String::arg(long a, int fieldWidth, int base, QChar fillChar) const
+    \fn QUtf8String QUtf8String::arg(ulong a, int fieldWidth, int base, QChar fillChar) const
+    \fn QUtf8String QUtf8String::arg(int a, int fieldWidth, int base, QChar fillChar) const
+    \fn QUtf8String QUtf8String::arg(uint a, int fieldWidth, int base, QChar fillChar) const
+    \fn QUtf8String QUtf8String::arg(short a, int fieldWidth, int base, QChar fillChar) const
+    \fn QUtf8String QUtf8String::arg(ushort a, int fieldWidth, int base, QChar fillChar) const
+    \overload
+*/
+
+/*!
+    \overload
+
+    Replaces the lowest numbered place marker with the floating point
+    number \a a, formatted with \a fmt and \a prec as QString::arg() does.
+*/
+QUtf8String QUtf8String::arg(double a, int fieldWidth, char fmt, int prec, QChar fillChar) const
+{
+    return numberArg(*this, d, a, fieldWidth, fmt, prec, fillChar);
+}
+
+/*!
+    \fn template <typename Arg1, typename Arg2, typename...Args> QUtf8String QUtf8String::arg(Arg1 &&a1, Arg2 &&a2, Args &&...args) const
+
+    Replaces occurrences of \c{%N} in this string with the corresponding
+    argument. The arguments are not positional: \a a1 replaces the
+    \c{%N} with the lowest \c{N} (all of them), \a a2 the \c{%N} with the
+    next-lowest \c{N}, and so on for \a args. Unlike chained calls to
+    arg(), this is done in a single pass and replacement text is never
+    searched for place markers.
+
+    The arguments can be anything that implicitly converts to QUtf8String.
+
+    \sa QString::arg()
+*/
+
+// Same rules as getEscape() for QString's multi-arg
+static int getEscape(const char *uc, qsizetype *pos, qsizetype len)
+{
+    qsizetype i = *pos + 1;
+    if (i < len && uc[i] == 'L')
+        ++i;
+    if (i < len) {
+        int escape = uc[i] - '0';
+        if (uint(escape) >= 10U)
+            return -1;
+        ++i;
+        while (i < len) {
+            const int digit = uc[i] - '0';
+            if (uint(digit) >= 10U)
+                break;
+            escape = (escape * 10) + digit;
+            ++i;
+        }
+        if (escape <= 999) {
+            *pos = i;
+            return escape;
+        }
+    }
+    return -1;
+}
+
+QUtf8String QUtf8String::multiArg(qsizetype numArgs, const QUtf8String *args) const
+{
+    struct Part
+    {
+        qsizetype pos;
+        qsizetype size;
+        int number;
+    };
+    QVarLengthArray<Part, 32> parts;
+
+    const char *const uc = d.constData();
+    const qsizetype len = d.size();
+    qsizetype i = 0;
+    qsizetype last = 0;
+    while (i < len - 1) {
+        if (uc[i] == '%') {
+            const qsizetype percent = i;
+            const int number = getEscape(uc, &i, len);
+            if (number != -1) {
+                if (last != percent)
+                    parts.push_back({last, percent - last, -1}); // literal text
+                parts.push_back({percent, i - percent, number}); // placeholder
+                last = i;
+                continue;
+            }
+        }
+        ++i;
+    }
+    if (last < len)
+        parts.push_back({last, len - last, -1});
+
+    // the n-th lowest placeholder number is replaced by the n-th argument
+    QVarLengthArray<int, 16> numbers;
+    for (const Part &part : parts) {
+        if (part.number >= 0)
+            numbers.push_back(part.number);
+    }
+    std::sort(numbers.begin(), numbers.end());
+    numbers.erase(std::unique(numbers.begin(), numbers.end()), numbers.end());
+
+    if (numbers.size() > numArgs)
+        numbers.resize(int(numArgs));
+    else if (Q_UNLIKELY(numbers.size() < numArgs))
+        qWarning("QUtf8String::arg: %d argument(s) missing in %s",
+                 int(numArgs - numbers.size()), d.constData());
+
+    QByteArray result;
+    result.reserve(int(len));
+    for (const Part &part : parts) {
+        const auto it = part.number >= 0 ? std::find(numbers.cbegin(), numbers.cend(), part.number)
+                                         : numbers.cend();
+        if (it != numbers.cend())
+            result += args[it - numbers.cbegin()].d;
+        else
+            result.append(uc + part.pos, int(part.size));
+    }
+    return QUtf8String(std::move(result));
+}
+
+/*!
+    \fn short QUtf8String::toShort(bool *ok, int base) const
+    \fn ushort QUtf8String::toUShort(bool *ok, int base) const
+    \fn int QUtf8String::toInt(bool *ok, int base) const
+    \fn uint QUtf8String::toUInt(bool *ok, int base) const
+    \fn long QUtf8String::toLong(bool *ok, int base) const
+    \fn ulong QUtf8String::toULong(bool *ok, int base) const
+    \fn qlonglong QUtf8String::toLongLong(bool *ok, int base) const
+    \fn qulonglong QUtf8String::toULongLong(bool *ok, int base) const
+
+    Returns the string converted to an integer using base \a base, which is
+    10 by default. These functions parse the UTF-8 data directly, with the
+    same rules as the QByteArray functions of the same name. If \a ok is not
+    \nullptr, failure is reported by setting *\a{ok} to \c false, and
+    success by setting *\a{ok} to \c true.
+*/
+
+/*!
+    \fn float QUtf8String::toFloat(bool *ok) const
+    \fn double QUtf8String::toDouble(bool *ok) const
+
+    Returns the string converted to a floating point number, using the C
+    locale. If \a ok is not \nullptr, it is set to indicate success.
+*/
+
+/*!
+    \fn QUtf8String QUtf8String::number(int n, int base)
+    \fn QUtf8String QUtf8String::number(uint n, int base)
+    \fn QUtf8String QUtf8String::number(qlonglong n, int base)
+    \fn QUtf8String QUtf8String::number(qulonglong n, int base)
+
+    Returns a string representing the integer \a n in base \a base.
+*/
+
+/*!
+    \fn QUtf8String QUtf8String::number(double n, char format, int precision)
+
+    Returns a string representing the floating point number \a n, formatted
+    according to \a format and \a precision as QByteArray::number() does.
+*/
+
+/*!
+    \fn QString QUtf8String::toString() const
+
+    Returns this string converted to a QString.
+*/
+
+/*!
+    \fn QByteArray QUtf8String::toByteArray() const
+
+    Returns the UTF-8 data of this string. The data is shared, not copied.
+*/
+
+/*!
+    Compares this string with \a other and returns a negative integer if
+    this string is less than \a other, a positive integer if it is greater,
+    and zero if they are equal. The comparison is by Unicode code point.
+*/
+int QUtf8String::compare(const QUtf8String &other) const noexcept
+{
+    return qstrcmp(d, other.d);
+}
+
+/*!
+    \overload
+
+    Compares this string with the UTF-16 string \a other, decoding this
+    string on the fly.
+*/
+int QUtf8String::compare(QStringView other) const noexcept
+{
+    return QUtf8::compareUtf8(d.constData(), d.size(), other.data(), int(other.size()));
+}
+
+/*!
+    \fn bool QUtf8String::operator==(const QUtf8String &lhs, const QUtf8String &rhs)
+    \fn bool QUtf8String::operator!=(const QUtf8String &lhs, const QUtf8String &rhs)
+    \fn bool QUtf8String::operator<(const QUtf8String &lhs, const QUtf8String &rhs)
+    \fn bool QUtf8String::operator<=(const QUtf8String &lhs, const QUtf8String &rhs)
+    \fn bool QUtf8String::operator>(const QUtf8String &lhs, const QUtf8String &rhs)
+    \fn bool QUtf8String::operator>=(const QUtf8String &lhs, const QUtf8String &rhs)
+    \fn bool QUtf8String::operator==(const QUtf8String &lhs, const char *rhs)
+    \fn bool QUtf8String::operator!=(const QUtf8String &lhs, const char *rhs)
+    \fn bool QUtf8String::operator==(const char *lhs, const QUtf8String &rhs)
+    \fn bool QUtf8String::operator!=(const char *lhs, const QUtf8String &rhs)
+    \fn bool QUtf8String::operator==(const QUtf8String &lhs, QStringView rhs)
+    \fn bool QUtf8String::operator!=(const QUtf8String &lhs, QStringView rhs)
+    \fn bool QUtf8String::operator==(QStringView lhs, const QUtf8String &rhs)
+    \fn bool QUtf8String::operator!=(QStringView lhs, const QUtf8String &rhs)
+
+    Compare \a lhs and \a rhs.
+
+    \sa compare()
+*/
+
+/*!
+    \fn const QUtf8String QUtf8String::operator+(const QUtf8String &lhs, const QUtf8String &rhs)
+    \fn const QUtf8String QUtf8String::operator+(const QUtf8String &lhs, const char *rhs)
+    \fn const QUtf8String QUtf8String::operator+(const char *lhs, const QUtf8String &rhs)
+
+    Returns the concatenation of \a lhs and \a rhs.
+*/
+
+/*!
+    \relates QUtf8String
+
+    Returns the hash value for \a key, using \a seed to seed the
+    calculation. It is the same as the hash of the QByteArray holding the
+    UTF-8 data.
+*/
+uint qHash(const QUtf8String &key, uint seed) noexcept
+{
+    return qHash(key.toByteArray(), seed);
+}
+
+#if !defined(QT_NO_DATASTREAM)
+/*!
+    \relates QUtf8String
+
+    Writes the string \a str to the stream \a out, in the same format as a
+    QByteArray holding its UTF-8 data.
+*/
+QDataStream &operator<<(QDataStream &out, const QUtf8String &str)
+{
+    return out << str.toByteArray();
+}
+
+/*!
+    \relates QUtf8String
+
+    Reads a string from the stream \a in into \a str.
+*/
+QDataStream &operator>>(QDataStream &in, QUtf8String &str)
+{
+    QByteArray utf8;
+    in >> utf8;
+    str = QUtf8String(std::move(utf8));
+    return in;
+}
+#endif
+
+#ifndef QT_NO_DEBUG_STREAM
+QDebug operator<<(QDebug debug, const QUtf8String &str)
+{
+    return debug << str.toString();
+}
+#endif
+
+QT_END_NAMESPACE
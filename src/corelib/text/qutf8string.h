@@ -0,0 +1,269 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QUTF8STRING_H
+#define QUTF8STRING_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringview.h>
+
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+class QDataStream;
+class QDebug;
+
+class Q_CORE_EXPORT QUtf8String
+{
+    template <typename T>
+    using if_convertible_to_utf8_string =
+        typename std::enable_if<std::is_convertible<T, QUtf8String>::value, bool>::type;
+
+public:
+    typedef qsizetype size_type;
+    typedef char value_type;
+    typedef const char *const_iterator;
+    typedef const_iterator iterator;
+
+    QUtf8String() noexcept {}
+    QUtf8String(const char *utf8) : d(utf8) {}
+    QUtf8String(const char *utf8, qsizetype size) : d(utf8, int(size)) {}
+    explicit QUtf8String(const QByteArray &utf8) noexcept : d(utf8) {}
+    explicit QUtf8String(QByteArray &&utf8) noexcept : d(std::move(utf8)) {}
+    explicit QUtf8String(QStringView str) : d(str.toUtf8()) {}
+    explicit QUtf8String(QLatin1String str);
+
+    Q_REQUIRED_RESULT static QUtf8String fromRawData(const char *utf8, qsizetype size)
+    { return QUtf8String(QByteArray::fromRawData(utf8, int(size))); }
+
+    void swap(QUtf8String &other) noexcept { d.swap(other.d); }
+
+    qsizetype size() const noexcept { return d.size(); }
+    qsizetype length() const noexcept { return d.size(); }
+    bool isEmpty() const noexcept { return d.isEmpty(); }
+    bool isNull() const noexcept { return d.isNull(); }
+    bool isValidUtf8() const noexcept;
+
+    const char *constData() const noexcept { return d.constData(); }
+    const char *data() const noexcept { return d.constData(); }
+    char at(qsizetype i) const { return d.at(int(i)); }
+    char operator[](qsizetype i) const { return d.at(int(i)); }
+
+    const_iterator begin() const noexcept { return d.constBegin(); }
+    const_iterator cbegin() const noexcept { return d.constBegin(); }
+    const_iterator end() const noexcept { return d.constEnd(); }
+    const_iterator cend() const noexcept { return d.constEnd(); }
+
+    qsizetype capacity() const { return d.capacity(); }
+    void reserve(qsizetype size) { d.reserve(int(size)); }
+    void squeeze() { d.squeeze(); }
+    void clear() { d.clear(); }
+    void truncate(qsizetype pos) { d.truncate(int(pos)); }
+    void chop(qsizetype n) { d.chop(int(n)); }
+
+    Q_REQUIRED_RESULT QUtf8String left(qsizetype n) const { return QUtf8String(d.left(int(n))); }
+    Q_REQUIRED_RESULT QUtf8String right(qsizetype n) const { return QUtf8String(d.right(int(n))); }
+    Q_REQUIRED_RESULT QUtf8String mid(qsizetype pos, qsizetype n = -1) const
+    { return QUtf8String(d.mid(int(pos), int(n))); }
+    Q_REQUIRED_RESULT QUtf8String chopped(qsizetype n) const { return QUtf8String(d.chopped(int(n))); }
+    Q_REQUIRED_RESULT QUtf8String trimmed() const;
+
+    qsizetype indexOf(const QUtf8String &str, qsizetype from = 0) const
+    { return d.indexOf(str.d, int(from)); }
+    qsizetype indexOf(char ch, qsizetype from = 0) const { return d.indexOf(ch, int(from)); }
+    qsizetype lastIndexOf(const QUtf8String &str, qsizetype from = -1) const
+    { return d.lastIndexOf(str.d, int(from)); }
+    qsizetype lastIndexOf(char ch, qsizetype from = -1) const { return d.lastIndexOf(ch, int(from)); }
+    bool contains(const QUtf8String &str) const { return indexOf(str) != -1; }
+    bool contains(char ch) const { return indexOf(ch) != -1; }
+    bool startsWith(const QUtf8String &str) const { return d.startsWith(str.d); }
+    bool startsWith(char ch) const { return d.startsWith(ch); }
+    bool endsWith(const QUtf8String &str) const { return d.endsWith(str.d); }
+    bool endsWith(char ch) const { return d.endsWith(ch); }
+
+    Q_REQUIRED_RESULT QList<QUtf8String> split(const QUtf8String &sep,
+                                               Qt::SplitBehavior behavior = Qt::KeepEmptyParts) const;
+    Q_REQUIRED_RESULT QList<QUtf8String> split(char sep,
+                                               Qt::SplitBehavior behavior = Qt::KeepEmptyParts) const;
+
+    QUtf8String &append(const QUtf8String &str) { d.append(str.d); return *this; }
+    QUtf8String &append(const char *str) { d.append(str); return *this; }
+    QUtf8String &append(char ch) { d.append(ch); return *this; }
+    QUtf8String &prepend(const QUtf8String &str) { d.prepend(str.d); return *this; }
+    QUtf8String &replace(const QUtf8String &before, const QUtf8String &after)
+    { d.replace(before.d, after.d); return *this; }
+    QUtf8String &operator+=(const QUtf8String &str) { return append(str); }
+    QUtf8String &operator+=(const char *str) { return append(str); }
+    QUtf8String &operator+=(char ch) { return append(ch); }
+
+    Q_REQUIRED_RESULT QUtf8String arg(qlonglong a, int fieldWidth = 0, int base = 10,
+                                      QChar fillChar = QLatin1Char(' ')) const;
+    Q_REQUIRED_RESULT QUtf8String arg(qulonglong a, int fieldWidth = 0, int base = 10,
+                                      QChar fillChar = QLatin1Char(' ')) const;
+    Q_REQUIRED_RESULT QUtf8String arg(long a, int fieldWidth = 0, int base = 10,
+                                      QChar fillChar = QLatin1Char(' ')) const
+    { return arg(qlonglong(a), fieldWidth, base, fillChar); }
+    Q_REQUIRED_RESULT QUtf8String arg(ulong a, int fieldWidth = 0, int base = 10,
+                                      QChar fillChar = QLatin1Char(' ')) const
+    { return arg(qulonglong(a), fieldWidth, base, fillChar); }
+    Q_REQUIRED_RESULT QUtf8String arg(int a, int fieldWidth = 0, int base = 10,
+                                      QChar fillChar = QLatin1Char(' ')) const
+    { return arg(qlonglong(a), fieldWidth, base, fillChar); }
+    Q_REQUIRED_RESULT QUtf8String arg(uint a, int fieldWidth = 0, int base = 10,
+                                      QChar fillChar = QLatin1Char(' ')) const
+    { return arg(qulonglong(a), fieldWidth, base, fillChar); }
+    Q_REQUIRED_RESULT QUtf8String arg(short a, int fieldWidth = 0, int base = 10,
+                                      QChar fillChar = QLatin1Char(' ')) const
+    { return arg(qlonglong(a), fieldWidth, base, fillChar); }
+    Q_REQUIRED_RESULT QUtf8String arg(ushort a, int fieldWidth = 0, int base = 10,
+                                      QChar fillChar = QLatin1Char(' ')) const
+    { return arg(qulonglong(a), fieldWidth, base, fillChar); }
+    Q_REQUIRED_RESULT QUtf8String arg(double a, int fieldWidth = 0, char fmt = 'g', int prec = -1,
+                                      QChar fillChar = QLatin1Char(' ')) const;
+    Q_REQUIRED_RESULT QUtf8String arg(const QUtf8String &a, int fieldWidth = 0,
+                                      QChar fillChar = QLatin1Char(' ')) const;
+
+    template <typename Arg1, typename Arg2, typename...Args,
+              if_convertible_to_utf8_string<Arg1> = true,
+              if_convertible_to_utf8_string<Arg2> = true>
+    Q_REQUIRED_RESULT QUtf8String arg(Arg1 &&a1, Arg2 &&a2, Args &&...args) const
+    {
+        const QUtf8String argv[] = { QUtf8String(std::forward<Arg1>(a1)),
+                                     QUtf8String(std::forward<Arg2>(a2)),
+                                     QUtf8String(std::forward<Args>(args))... };
+        return multiArg(2 + sizeof...(Args), argv);
+    }
+
+    short toShort(bool *ok = nullptr, int base = 10) const { return d.toShort(ok, base); }
+    ushort toUShort(bool *ok = nullptr, int base = 10) const { return d.toUShort(ok, base); }
+    int toInt(bool *ok = nullptr, int base = 10) const { return d.toInt(ok, base); }
+    uint toUInt(bool *ok = nullptr, int base = 10) const { return d.toUInt(ok, base); }
+    long toLong(bool *ok = nullptr, int base = 10) const { return d.toLong(ok, base); }
+    ulong toULong(bool *ok = nullptr, int base = 10) const { return d.toULong(ok, base); }
+    qlonglong toLongLong(bool *ok = nullptr, int base = 10) const { return d.toLongLong(ok, base); }
+    qulonglong toULongLong(bool *ok = nullptr, int base = 10) const { return d.toULongLong(ok, base); }
+    float toFloat(bool *ok = nullptr) const { return d.toFloat(ok); }
+    double toDouble(bool *ok = nullptr) const { return d.toDouble(ok); }
+
+    Q_REQUIRED_RESULT static QUtf8String number(int n, int base = 10)
+    { return QUtf8String(QByteArray::number(n, base)); }
+    Q_REQUIRED_RESULT static QUtf8String number(uint n, int base = 10)
+    { return QUtf8String(QByteArray::number(n, base)); }
+    Q_REQUIRED_RESULT static QUtf8String number(qlonglong n, int base = 10)
+    { return QUtf8String(QByteArray::number(n, base)); }
+    Q_REQUIRED_RESULT static QUtf8String number(qulonglong n, int base = 10)
+    { return QUtf8String(QByteArray::number(n, base)); }
+    Q_REQUIRED_RESULT static QUtf8String number(double n, char format = 'g', int precision = 6)
+    { return QUtf8String(QByteArray::number(n, format, precision)); }
+
+    Q_REQUIRED_RESULT QString toString() const { return QString::fromUtf8(d); }
+    Q_REQUIRED_RESULT QByteArray toByteArray() const noexcept { return d; }
+
+    int compare(const QUtf8String &other) const noexcept;
+    int compare(QStringView other) const noexcept;
+
+    friend bool operator==(const QUtf8String &lhs, const QUtf8String &rhs) noexcept
+    { return lhs.d == rhs.d; }
+    friend bool operator!=(const QUtf8String &lhs, const QUtf8String &rhs) noexcept
+    { return lhs.d != rhs.d; }
+    friend bool operator<(const QUtf8String &lhs, const QUtf8String &rhs) noexcept
+    { return lhs.compare(rhs) < 0; }
+    friend bool operator<=(const QUtf8String &lhs, const QUtf8String &rhs) noexcept
+    { return lhs.compare(rhs) <= 0; }
+    friend bool operator>(const QUtf8String &lhs, const QUtf8String &rhs) noexcept
+    { return lhs.compare(rhs) > 0; }
+    friend bool operator>=(const QUtf8String &lhs, const QUtf8String &rhs) noexcept
+    { return lhs.compare(rhs) >= 0; }
+
+    friend bool operator==(const QUtf8String &lhs, const char *rhs) noexcept
+    { return lhs.d == rhs; }
+    friend bool operator!=(const QUtf8String &lhs, const char *rhs) noexcept
+    { return lhs.d != rhs; }
+    friend bool operator==(const char *lhs, const QUtf8String &rhs) noexcept
+    { return lhs == rhs.d; }
+    friend bool operator!=(const char *lhs, const QUtf8String &rhs) noexcept
+    { return lhs != rhs.d; }
+
+    friend bool operator==(const QUtf8String &lhs, QStringView rhs) noexcept
+    { return lhs.compare(rhs) == 0; }
+    friend bool operator!=(const QUtf8String &lhs, QStringView rhs) noexcept
+    { return lhs.compare(rhs) != 0; }
+    friend bool operator==(QStringView lhs, const QUtf8String &rhs) noexcept
+    { return rhs.compare(lhs) == 0; }
+    friend bool operator!=(QStringView lhs, const QUtf8String &rhs) noexcept
+    { return rhs.compare(lhs) != 0; }
+
+    friend inline const QUtf8String operator+(const QUtf8String &lhs, const QUtf8String &rhs)
+    { return QUtf8String(lhs.d + rhs.d); }
+    friend inline const QUtf8String operator+(const QUtf8String &lhs, const char *rhs)
+    { return QUtf8String(lhs.d + rhs); }
+    friend inline const QUtf8String operator+(const char *lhs, const QUtf8String &rhs)
+    { return QUtf8String(lhs + rhs.d); }
+
+private:
+    QUtf8String multiArg(qsizetype numArgs, const QUtf8String *args) const;
+
+    QByteArray d;
+};
+
+Q_DECLARE_SHARED(QUtf8String)
+
+Q_CORE_EXPORT Q_DECL_PURE_FUNCTION uint qHash(const QUtf8String &key, uint seed = 0) noexcept;
+
+#if !defined(QT_NO_DATASTREAM)
+Q_CORE_EXPORT QDataStream &operator<<(QDataStream &, const QUtf8String &);
+Q_CORE_EXPORT QDataStream &operator>>(QDataStream &, QUtf8String &);
+#endif
+
+#ifndef QT_NO_DEBUG_STREAM
+Q_CORE_EXPORT QDebug operator<<(QDebug, const QUtf8String &);
+#endif
+
+namespace QtPrivate {
+inline QUtf8StringArg qStringLikeToArg(const QUtf8String &s) noexcept
+{ return QUtf8StringArg{s.constData(), s.size()}; }
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QUTF8STRING_H
@@ -1,6 +1,7 @@
 # Qt text / string / character / unicode / byte array module
 
 HEADERS +=  \
+        text/qahocorasick_p.h \
         text/qbytearray.h \
         text/qbytearray_p.h \
         text/qbytearraylist.h \
@@ -14,6 +15,7 @@ HEADERS +=  \
         text/qlocale_p.h \
         text/qlocale_tools_p.h \
         text/qlocale_data_p.h \
+        text/qmultistringmatcher.h \
         text/qregexp.h \
         text/qstring.h \
         text/qstringalgorithms.h \
@@ -26,16 +28,19 @@ HEADERS +=  \
         text/qstringview.h \
         text/qtextboundaryfinder.h \
         text/qunicodetables_p.h \
-        text/qunicodetools_p.h
+        text/qunicodetools_p.h \
+        text/qutf8string.h
 
 
 SOURCES += \
+        text/qahocorasick.cpp \
         text/qbytearray.cpp \
         text/qbytearraylist.cpp \
         text/qbytearraymatcher.cpp \
         text/qcollator.cpp \
         text/qlocale.cpp \
         text/qlocale_tools.cpp \
+        text/qmultistringmatcher.cpp \
         text/qregexp.cpp \
         text/qstring.cpp \
         text/qstringbuilder.cpp \
@@ -43,6 +48,7 @@ SOURCES += \
         text/qstringview.cpp \
         text/qtextboundaryfinder.cpp \
         text/qunicodetools.cpp \
+        text/qutf8string.cpp \
         text/qvsnprintf.cpp
 
 NO_PCH_SOURCES += text/qstring_compat.cpp
@@ -77,8 +83,11 @@ qtConfig(regularexpression) {
     QMAKE_USE_PRIVATE += pcre2
 
     HEADERS += \
-        text/qregularexpression.h
-    SOURCES += text/qregularexpression.cpp
+        text/qregularexpression.h \
+        text/qregularexpressionset.h
+    SOURCES += \
+        text/qregularexpression.cpp \
+        text/qregularexpressionset.cpp
 }
 
 INCLUDEPATH += ../3rdparty/harfbuzz/src
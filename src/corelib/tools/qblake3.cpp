@@ -0,0 +1,811 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qblake3_p.h"
+
+#include <private/qsimd_p.h>
+#include <qalgorithms.h>
+#include <qendian.h>
+#if QT_CONFIG(thread)
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    This follows the structure of the BLAKE3 reference C implementation
+    (https://github.com/BLAKE3-team/BLAKE3): whole chunks are compressed
+    several at a time by hashMany(), which uses SSE2 or AVX2 to process 4 or 8
+    inputs in parallel, and large subtrees are split between the calling
+    thread and the global thread pool.
+*/
+
+enum Blake3Flags : quint8 {
+    ChunkStart = 1 << 0,
+    ChunkEnd = 1 << 1,
+    Parent = 1 << 2,
+    Root = 1 << 3
+};
+
+enum {
+    MaxSimdDegree = 8,
+    // below this many bytes per half, a subtree is not worth a thread
+    ParallelThreshold = 128 * 1024
+};
+
+static const quint32 blake3IV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const quint8 messageSchedule[7][16] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8 },
+    { 3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1 },
+    { 10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6 },
+    { 12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4 },
+    { 9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7 },
+    { 11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13 },
+};
+
+static inline quint32 rotr32(quint32 w, int c)
+{
+    return (w >> c) | (w << (32 - c));
+}
+
+static inline void loadKeyWords(const uchar *bytes, quint32 *words)
+{
+    for (int i = 0; i < 8; ++i)
+        words[i] = qFromLittleEndian<quint32>(bytes + 4 * i);
+}
+
+static inline void storeCvWords(uchar *bytes, const quint32 *words)
+{
+    for (int i = 0; i < 8; ++i)
+        qToLittleEndian(words[i], bytes + 4 * i);
+}
+
+static inline void g(quint32 *state, int a, int b, int c, int d, quint32 x, quint32 y)
+{
+    state[a] = state[a] + state[b] + x;
+    state[d] = rotr32(state[d] ^ state[a], 16);
+    state[c] = state[c] + state[d];
+    state[b] = rotr32(state[b] ^ state[c], 12);
+    state[a] = state[a] + state[b] + y;
+    state[d] = rotr32(state[d] ^ state[a], 8);
+    state[c] = state[c] + state[d];
+    state[b] = rotr32(state[b] ^ state[c], 7);
+}
+
+static inline void roundFunction(quint32 *state, const quint32 *m, int round)
+{
+    const quint8 *s = messageSchedule[round];
+    g(state, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+    g(state, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+    g(state, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+    g(state, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+    g(state, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+    g(state, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+    g(state, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+    g(state, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+}
+
+static inline void compressPre(quint32 *state, const quint32 *cv, const uchar *block,
+                               quint8 blockLength, quint64 counter, quint8 flags)
+{
+    quint32 m[16];
+    for (int i = 0; i < 16; ++i)
+        m[i] = qFromLittleEndian<quint32>(block + 4 * i);
+
+    for (int i = 0; i < 8; ++i)
+        state[i] = cv[i];
+    for (int i = 0; i < 4; ++i)
+        state[8 + i] = blake3IV[i];
+    state[12] = quint32(counter);
+    state[13] = quint32(counter >> 32);
+    state[14] = blockLength;
+    state[15] = flags;
+
+    for (int round = 0; round < 7; ++round)
+        roundFunction(state, m, round);
+}
+
+static void compressInPlace(quint32 *cv, const uchar *block, quint8 blockLength,
+                            quint64 counter, quint8 flags)
+{
+    quint32 state[16];
+    compressPre(state, cv, block, blockLength, counter, flags);
+    for (int i = 0; i < 8; ++i)
+        cv[i] = state[i] ^ state[i + 8];
+}
+
+static void compressXof(const quint32 *cv, const uchar *block, quint8 blockLength,
+                        quint64 counter, quint8 flags, uchar *out)
+{
+    quint32 state[16];
+    compressPre(state, cv, block, blockLength, counter, flags);
+    for (int i = 0; i < 8; ++i) {
+        qToLittleEndian(state[i] ^ state[i + 8], out + 4 * i);
+        qToLittleEndian(state[i + 8] ^ cv[i], out + 32 + 4 * i);
+    }
+}
+
+static void hashOne(const uchar *input, size_t blocks, const quint32 *key, quint64 counter,
+                    quint8 flags, quint8 flagsStart, quint8 flagsEnd, uchar *out)
+{
+    quint32 cv[8];
+    memcpy(cv, key, sizeof(cv));
+    quint8 blockFlags = flags | flagsStart;
+    for ( ; blocks; --blocks, input += Blake3BlockLength) {
+        if (blocks == 1)
+            blockFlags |= flagsEnd;
+        compressInPlace(cv, input, Blake3BlockLength, counter, blockFlags);
+        blockFlags = flags;
+    }
+    storeCvWords(out, cv);
+}
+
+#ifdef __SSE2__
+static inline __m128i rotr128(__m128i x, int c)
+{
+    return _mm_or_si128(_mm_srli_epi32(x, c), _mm_slli_epi32(x, 32 - c));
+}
+
+static inline void g4(__m128i *v, int a, int b, int c, int d, __m128i x, __m128i y)
+{
+    v[a] = _mm_add_epi32(_mm_add_epi32(v[a], v[b]), x);
+    v[d] = rotr128(_mm_xor_si128(v[d], v[a]), 16);
+    v[c] = _mm_add_epi32(v[c], v[d]);
+    v[b] = rotr128(_mm_xor_si128(v[b], v[c]), 12);
+    v[a] = _mm_add_epi32(_mm_add_epi32(v[a], v[b]), y);
+    v[d] = rotr128(_mm_xor_si128(v[d], v[a]), 8);
+    v[c] = _mm_add_epi32(v[c], v[d]);
+    v[b] = rotr128(_mm_xor_si128(v[b], v[c]), 7);
+}
+
+static inline void transpose4(__m128i *v)
+{
+    const __m128i ab01 = _mm_unpacklo_epi32(v[0], v[1]);
+    const __m128i ab23 = _mm_unpackhi_epi32(v[0], v[1]);
+    const __m128i cd01 = _mm_unpacklo_epi32(v[2], v[3]);
+    const __m128i cd23 = _mm_unpackhi_epi32(v[2], v[3]);
+    v[0] = _mm_unpacklo_epi64(ab01, cd01);
+    v[1] = _mm_unpackhi_epi64(ab01, cd01);
+    v[2] = _mm_unpacklo_epi64(ab23, cd23);
+    v[3] = _mm_unpackhi_epi64(ab23, cd23);
+}
+
+// hashes four inputs of the same length, each lane of a vector is one input
+static void hash4Sse2(const uchar *const *inputs, size_t blocks, const quint32 *key,
+                      quint64 counter, bool incrementCounter, quint8 flags,
+                      quint8 flagsStart, quint8 flagsEnd, uchar *out)
+{
+    __m128i h[8];
+    for (int i = 0; i < 8; ++i)
+        h[i] = _mm_set1_epi32(int(key[i]));
+
+    const quint64 step = incrementCounter ? 1 : 0;
+    const __m128i counterLow = _mm_set_epi32(int(quint32(counter + 3 * step)), int(quint32(counter + 2 * step)),
+                                             int(quint32(counter + step)), int(quint32(counter)));
+    const __m128i counterHigh = _mm_set_epi32(int(quint32((counter + 3 * step) >> 32)),
+                                              int(quint32((counter + 2 * step) >> 32)),
+                                              int(quint32((counter + step) >> 32)),
+                                              int(quint32(counter >> 32)));
+
+    quint8 blockFlags = flags | flagsStart;
+    for (size_t block = 0; block < blocks; ++block) {
+        if (block + 1 == blocks)
+            blockFlags |= flagsEnd;
+
+        __m128i m[16];
+        for (int part = 0; part < 4; ++part) {
+            for (int input = 0; input < 4; ++input) {
+                m[4 * part + input] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                        inputs[input] + block * Blake3BlockLength + 16 * part));
+            }
+            transpose4(m + 4 * part);
+        }
+
+        __m128i v[16] = {
+            h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+            _mm_set1_epi32(int(blake3IV[0])), _mm_set1_epi32(int(blake3IV[1])),
+            _mm_set1_epi32(int(blake3IV[2])), _mm_set1_epi32(int(blake3IV[3])),
+            counterLow, counterHigh,
+            _mm_set1_epi32(Blake3BlockLength), _mm_set1_epi32(blockFlags)
+        };
+        for (int round = 0; round < 7; ++round) {
+            const quint8 *s = messageSchedule[round];
+            g4(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+            g4(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+            g4(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+            g4(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+            g4(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+            g4(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+            g4(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+            g4(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+        }
+        for (int i = 0; i < 8; ++i)
+            h[i] = _mm_xor_si128(v[i], v[i + 8]);
+        blockFlags = flags;
+    }
+
+    transpose4(h);
+    transpose4(h + 4);
+    for (int input = 0; input < 4; ++input) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + input * Blake3OutLength), h[input]);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + input * Blake3OutLength + 16), h[input + 4]);
+    }
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+QT_FUNCTION_TARGET(AVX2)
+static inline __m256i rotr256(__m256i x, int c)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, c), _mm256_slli_epi32(x, 32 - c));
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static inline void g8(__m256i *v, int a, int b, int c, int d, __m256i x, __m256i y)
+{
+    const __m256i rot16 = _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+                                          13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+    const __m256i rot8 = _mm256_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1,
+                                         12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1);
+    v[a] = _mm256_add_epi32(_mm256_add_epi32(v[a], v[b]), x);
+    v[d] = _mm256_shuffle_epi8(_mm256_xor_si256(v[d], v[a]), rot16);
+    v[c] = _mm256_add_epi32(v[c], v[d]);
+    v[b] = rotr256(_mm256_xor_si256(v[b], v[c]), 12);
+    v[a] = _mm256_add_epi32(_mm256_add_epi32(v[a], v[b]), y);
+    v[d] = _mm256_shuffle_epi8(_mm256_xor_si256(v[d], v[a]), rot8);
+    v[c] = _mm256_add_epi32(v[c], v[d]);
+    v[b] = rotr256(_mm256_xor_si256(v[b], v[c]), 7);
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static inline void transpose8(__m256i *v)
+{
+    const __m256i ab0145 = _mm256_unpacklo_epi32(v[0], v[1]);
+    const __m256i ab2367 = _mm256_unpackhi_epi32(v[0], v[1]);
+    const __m256i cd0145 = _mm256_unpacklo_epi32(v[2], v[3]);
+    const __m256i cd2367 = _mm256_unpackhi_epi32(v[2], v[3]);
+    const __m256i ef0145 = _mm256_unpacklo_epi32(v[4], v[5]);
+    const __m256i ef2367 = _mm256_unpackhi_epi32(v[4], v[5]);
+    const __m256i gh0145 = _mm256_unpacklo_epi32(v[6], v[7]);
+    const __m256i gh2367 = _mm256_unpackhi_epi32(v[6], v[7]);
+
+    const __m256i abcd04 = _mm256_unpacklo_epi64(ab0145, cd0145);
+    const __m256i abcd15 = _mm256_unpackhi_epi64(ab0145, cd0145);
+    const __m256i abcd26 = _mm256_unpacklo_epi64(ab2367, cd2367);
+    const __m256i abcd37 = _mm256_unpackhi_epi64(ab2367, cd2367);
+    const __m256i efgh04 = _mm256_unpacklo_epi64(ef0145, gh0145);
+    const __m256i efgh15 = _mm256_unpackhi_epi64(ef0145, gh0145);
+    const __m256i efgh26 = _mm256_unpacklo_epi64(ef2367, gh2367);
+    const __m256i efgh37 = _mm256_unpackhi_epi64(ef2367, gh2367);
+
+    v[0] = _mm256_permute2x128_si256(abcd04, efgh04, 0x20);
+    v[1] = _mm256_permute2x128_si256(abcd15, efgh15, 0x20);
+    v[2] = _mm256_permute2x128_si256(abcd26, efgh26, 0x20);
+    v[3] = _mm256_permute2x128_si256(abcd37, efgh37, 0x20);
+    v[4] = _mm256_permute2x128_si256(abcd04, efgh04, 0x31);
+    v[5] = _mm256_permute2x128_si256(abcd15, efgh15, 0x31);
+    v[6] = _mm256_permute2x128_si256(abcd26, efgh26, 0x31);
+    v[7] = _mm256_permute2x128_si256(abcd37, efgh37, 0x31);
+}
+
+// same as hash4Sse2(), for eight inputs
+QT_FUNCTION_TARGET(AVX2)
+static void hash8Avx2(const uchar *const *inputs, size_t blocks, const quint32 *key,
+                      quint64 counter, bool incrementCounter, quint8 flags,
+                      quint8 flagsStart, quint8 flagsEnd, uchar *out)
+{
+    __m256i h[8];
+    for (int i = 0; i < 8; ++i)
+        h[i] = _mm256_set1_epi32(int(key[i]));
+
+    alignas(32) quint32 low[8];
+    alignas(32) quint32 high[8];
+    for (int i = 0; i < 8; ++i) {
+        const quint64 c = counter + (incrementCounter ? i : 0);
+        low[i] = quint32(c);
+        high[i] = quint32(c >> 32);
+    }
+    const __m256i counterLow = _mm256_load_si256(reinterpret_cast<const __m256i *>(low));
+    const __m256i counterHigh = _mm256_load_si256(reinterpret_cast<const __m256i *>(high));
+
+    quint8 blockFlags = flags | flagsStart;
+    for (size_t block = 0; block < blocks; ++block) {
+        if (block + 1 == blocks)
+            blockFlags |= flagsEnd;
+
+        __m256i m[16];
+        for (int part = 0; part < 2; ++part) {
+            for (int input = 0; input < 8; ++input) {
+                m[8 * part + input] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(
+                        inputs[input] + block * Blake3BlockLength + 32 * part));
+            }
+            transpose8(m + 8 * part);
+        }
+
+        __m256i v[16] = {
+            h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+            _mm256_set1_epi32(int(blake3IV[0])), _mm256_set1_epi32(int(blake3IV[1])),
+            _mm256_set1_epi32(int(blake3IV[2])), _mm256_set1_epi32(int(blake3IV[3])),
+            counterLow, counterHigh,
+            _mm256_set1_epi32(Blake3BlockLength), _mm256_set1_epi32(blockFlags)
+        };
+        for (int round = 0; round < 7; ++round) {
+            const quint8 *s = messageSchedule[round];
+            g8(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+            g8(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+            g8(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+            g8(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+            g8(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+            g8(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+            g8(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+            g8(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+        }
+        for (int i = 0; i < 8; ++i)
+            h[i] = _mm256_xor_si256(v[i], v[i + 8]);
+        blockFlags = flags;
+    }
+
+    transpose8(h);
+    for (int input = 0; input < 8; ++input)
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + input * Blake3OutLength), h[input]);
+}
+#endif
+
+static size_t simdDegree()
+{
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        return 8;
+#endif
+#ifdef __SSE2__
+    return 4;
+#else
+    return 1;
+#endif
+}
+
+static void hashMany(const uchar *const *inputs, size_t count, size_t blocks, const quint32 *key,
+                     quint64 counter, bool incrementCounter, quint8 flags,
+                     quint8 flagsStart, quint8 flagsEnd, uchar *out)
+{
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2)) {
+        for ( ; count >= 8; count -= 8, inputs += 8, out += 8 * Blake3OutLength) {
+            hash8Avx2(inputs, blocks, key, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+            if (incrementCounter)
+                counter += 8;
+        }
+    }
+#endif
+#ifdef __SSE2__
+    for ( ; count >= 4; count -= 4, inputs += 4, out += 4 * Blake3OutLength) {
+        hash4Sse2(inputs, blocks, key, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+        if (incrementCounter)
+            counter += 4;
+    }
+#endif
+    for ( ; count; --count, ++inputs, out += Blake3OutLength) {
+        hashOne(*inputs, blocks, key, counter, flags, flagsStart, flagsEnd, out);
+        if (incrementCounter)
+            ++counter;
+    }
+}
+
+namespace {
+struct Output
+{
+    quint32 cv[8];
+    uchar block[Blake3BlockLength];
+    quint64 counter;
+    quint8 blockLength;
+    quint8 flags;
+
+    void chainingValue(uchar *out) const
+    {
+        quint32 words[8];
+        memcpy(words, cv, sizeof(words));
+        compressInPlace(words, block, blockLength, counter, flags);
+        storeCvWords(out, words);
+    }
+
+    void rootBytes(uchar *out, size_t length) const
+    {
+        quint64 outputCounter = 0;
+        uchar wide[2 * Blake3OutLength];
+        while (length) {
+            compressXof(cv, block, blockLength, outputCounter++, flags | Root, wide);
+            const size_t n = qMin(length, sizeof(wide));
+            memcpy(out, wide, n);
+            out += n;
+            length -= n;
+        }
+    }
+};
+} // unnamed namespace
+
+static void chunkStateInit(Blake3ChunkState *chunk, const quint32 *key, quint8 flags)
+{
+    memcpy(chunk->cv, key, sizeof(chunk->cv));
+    chunk->chunkCounter = 0;
+    memset(chunk->buffer, 0, sizeof(chunk->buffer));
+    chunk->bufferLength = 0;
+    chunk->blocksCompressed = 0;
+    chunk->flags = flags;
+}
+
+static void chunkStateReset(Blake3ChunkState *chunk, const quint32 *key, quint64 chunkCounter)
+{
+    chunkStateInit(chunk, key, chunk->flags);
+    chunk->chunkCounter = chunkCounter;
+}
+
+static inline size_t chunkStateLength(const Blake3ChunkState *chunk)
+{
+    return Blake3BlockLength * size_t(chunk->blocksCompressed) + chunk->bufferLength;
+}
+
+static inline quint8 chunkStateStartFlag(const Blake3ChunkState *chunk)
+{
+    return chunk->blocksCompressed == 0 ? ChunkStart : 0;
+}
+
+static void chunkStateUpdate(Blake3ChunkState *chunk, const uchar *input, size_t length)
+{
+    if (chunk->bufferLength) {
+        const size_t take = qMin<size_t>(Blake3BlockLength - chunk->bufferLength, length);
+        memcpy(chunk->buffer + chunk->bufferLength, input, take);
+        chunk->bufferLength += quint8(take);
+        input += take;
+        length -= take;
+        if (length) {
+            compressInPlace(chunk->cv, chunk->buffer, Blake3BlockLength, chunk->chunkCounter,
+                            chunk->flags | chunkStateStartFlag(chunk));
+            ++chunk->blocksCompressed;
+            chunk->bufferLength = 0;
+            memset(chunk->buffer, 0, sizeof(chunk->buffer));
+        }
+    }
+
+    // the last block of a chunk must stay buffered, it needs the ChunkEnd flag
+    for ( ; length > Blake3BlockLength; input += Blake3BlockLength, length -= Blake3BlockLength) {
+        compressInPlace(chunk->cv, input, Blake3BlockLength, chunk->chunkCounter,
+                        chunk->flags | chunkStateStartFlag(chunk));
+        ++chunk->blocksCompressed;
+    }
+
+    memcpy(chunk->buffer + chunk->bufferLength, input, length);
+    chunk->bufferLength += quint8(length);
+}
+
+static Output chunkStateOutput(const Blake3ChunkState *chunk)
+{
+    Output output;
+    memcpy(output.cv, chunk->cv, sizeof(output.cv));
+    memcpy(output.block, chunk->buffer, sizeof(output.block));
+    output.blockLength = chunk->bufferLength;
+    output.counter = chunk->chunkCounter;
+    output.flags = chunk->flags | chunkStateStartFlag(chunk) | ChunkEnd;
+    return output;
+}
+
+static Output parentOutput(const uchar *block, const quint32 *key, quint8 flags)
+{
+    Output output;
+    memcpy(output.cv, key, sizeof(output.cv));
+    memcpy(output.block, block, sizeof(output.block));
+    output.blockLength = Blake3BlockLength;
+    output.counter = 0;
+    output.flags = flags | Parent;
+    return output;
+}
+
+static inline size_t roundDownToPowerOf2(quint64 x)
+{
+    return size_t(1) << (63 - qCountLeadingZeroBits(x | 1));
+}
+
+// the number of bytes in the left subtree: the largest power of two number of
+// chunks that leaves at least one byte for the right subtree
+static size_t leftLength(size_t contentLength)
+{
+    const size_t fullChunks = (contentLength - 1) / Blake3ChunkLength;
+    return roundDownToPowerOf2(fullChunks) * Blake3ChunkLength;
+}
+
+static size_t compressChunksParallel(const uchar *input, size_t length, const quint32 *key,
+                                     quint64 chunkCounter, quint8 flags, uchar *out)
+{
+    const uchar *chunks[MaxSimdDegree];
+    size_t count = 0;
+    for ( ; length - count * Blake3ChunkLength >= Blake3ChunkLength; ++count)
+        chunks[count] = input + count * Blake3ChunkLength;
+    hashMany(chunks, count, Blake3ChunkLength / Blake3BlockLength, key, chunkCounter, true,
+             flags, ChunkStart, ChunkEnd, out);
+
+    const size_t consumed = count * Blake3ChunkLength;
+    if (length > consumed) {
+        Blake3ChunkState chunk;
+        chunkStateInit(&chunk, key, flags);
+        chunk.chunkCounter = chunkCounter + count;
+        chunkStateUpdate(&chunk, input + consumed, length - consumed);
+        chunkStateOutput(&chunk).chainingValue(out + count * Blake3OutLength);
+        return count + 1;
+    }
+    return count;
+}
+
+static size_t compressParentsParallel(const uchar *childCvs, size_t count, const quint32 *key,
+                                      quint8 flags, uchar *out)
+{
+    const uchar *parents[MaxSimdDegree];
+    size_t parentCount = 0;
+    for ( ; count - 2 * parentCount >= 2; ++parentCount)
+        parents[parentCount] = childCvs + 2 * parentCount * Blake3OutLength;
+    hashMany(parents, parentCount, 1, key, 0, false, flags | Parent, 0, 0, out);
+
+    // an odd child is passed through to the next level
+    if (count > 2 * parentCount) {
+        memcpy(out + parentCount * Blake3OutLength, childCvs + 2 * parentCount * Blake3OutLength,
+               Blake3OutLength);
+        return parentCount + 1;
+    }
+    return parentCount;
+}
+
+static size_t compressSubtreeWide(const uchar *input, size_t length, const quint32 *key,
+                                  quint64 chunkCounter, quint8 flags, uchar *out, size_t degree);
+
+#if QT_CONFIG(thread)
+namespace {
+class SubtreeRunnable : public QRunnable
+{
+public:
+    SubtreeRunnable(const uchar *input, size_t length, const quint32 *key, quint64 chunkCounter,
+                    quint8 flags, uchar *out, size_t degree)
+        : input(input), length(length), key(key), chunkCounter(chunkCounter),
+          flags(flags), out(out), degree(degree)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override
+    {
+        result = compressSubtreeWide(input, length, key, chunkCounter, flags, out, degree);
+        done.release();
+    }
+
+    const uchar *input;
+    size_t length;
+    const quint32 *key;
+    quint64 chunkCounter;
+    quint8 flags;
+    uchar *out;
+    size_t degree;
+    size_t result = 0;
+    QSemaphore done;
+};
+} // unnamed namespace
+#endif
+
+// Compresses as many chunks as possible in parallel, returning the number of
+// chaining values written to out, which is at most max(degree, 2).
+static size_t compressSubtreeWide(const uchar *input, size_t length, const quint32 *key,
+                                  quint64 chunkCounter, quint8 flags, uchar *out, size_t degree)
+{
+    if (length <= degree * Blake3ChunkLength)
+        return compressChunksParallel(input, length, key, chunkCounter, flags, out);
+
+    const size_t leftInputLength = leftLength(length);
+    const uchar *rightInput = input + leftInputLength;
+    const size_t rightInputLength = length - leftInputLength;
+    const quint64 rightChunkCounter = chunkCounter + leftInputLength / Blake3ChunkLength;
+
+    uchar cvs[2 * MaxSimdDegree * Blake3OutLength];
+    // with a degree of 1, make sure there are two outputs to combine
+    const size_t outputs = (leftInputLength > Blake3ChunkLength && degree == 1) ? 2 : degree;
+    uchar *rightCvs = cvs + outputs * Blake3OutLength;
+
+    size_t leftCount;
+    size_t rightCount;
+#if QT_CONFIG(thread)
+    if (rightInputLength >= ParallelThreshold) {
+        SubtreeRunnable right(rightInput, rightInputLength, key, rightChunkCounter, flags,
+                              rightCvs, degree);
+        if (QThreadPool::globalInstance()->tryStart(&right)) {
+            leftCount = compressSubtreeWide(input, leftInputLength, key, chunkCounter, flags, cvs, degree);
+            right.done.acquire();
+            rightCount = right.result;
+        } else {
+            leftCount = compressSubtreeWide(input, leftInputLength, key, chunkCounter, flags, cvs, degree);
+            rightCount = compressSubtreeWide(rightInput, rightInputLength, key, rightChunkCounter,
+                                             flags, rightCvs, degree);
+        }
+    } else
+#endif
+    {
+        leftCount = compressSubtreeWide(input, leftInputLength, key, chunkCounter, flags, cvs, degree);
+        rightCount = compressSubtreeWide(rightInput, rightInputLength, key, rightChunkCounter,
+                                         flags, rightCvs, degree);
+    }
+
+    // only possible with a degree of 1: the two outputs are the final parent
+    if (leftCount == 1) {
+        memcpy(out, cvs, 2 * Blake3OutLength);
+        return 2;
+    }
+    return compressParentsParallel(cvs, leftCount + rightCount, key, flags, out);
+}
+
+// Hashes a subtree of at least two chunks down to the two chaining values of
+// its root, which is left to the caller so it can be merged lazily.
+static void compressSubtreeToParentNode(const uchar *input, size_t length, const quint32 *key,
+                                        quint64 chunkCounter, quint8 flags, uchar *out)
+{
+    uchar cvs[MaxSimdDegree * Blake3OutLength > 2 * Blake3OutLength
+              ? MaxSimdDegree * Blake3OutLength : 2 * Blake3OutLength];
+    size_t count = compressSubtreeWide(input, length, key, chunkCounter, flags, cvs, simdDegree());
+    while (count > 2) {
+        uchar parents[sizeof(cvs) / 2];
+        count = compressParentsParallel(cvs, count, key, flags, parents);
+        memcpy(cvs, parents, count * Blake3OutLength);
+    }
+    memcpy(out, cvs, 2 * Blake3OutLength);
+}
+
+static void mergeCvStack(Blake3State *state, quint64 totalLength)
+{
+    const size_t postMergeLength = size_t(qPopulationCount(totalLength));
+    while (state->cvStackLength > postMergeLength) {
+        uchar *parent = state->cvStack + (state->cvStackLength - 2) * Blake3OutLength;
+        parentOutput(parent, state->key, state->chunk.flags).chainingValue(parent);
+        --state->cvStackLength;
+    }
+}
+
+static void pushCv(Blake3State *state, const uchar *cv, quint64 chunkCounter)
+{
+    mergeCvStack(state, chunkCounter);
+    memcpy(state->cvStack + state->cvStackLength * Blake3OutLength, cv, Blake3OutLength);
+    ++state->cvStackLength;
+}
+
+void qt_blake3_init(Blake3State *state)
+{
+    memcpy(state->key, blake3IV, sizeof(state->key));
+    chunkStateInit(&state->chunk, state->key, 0);
+    state->cvStackLength = 0;
+}
+
+void qt_blake3_update(Blake3State *state, const uchar *input, size_t length)
+{
+    if (!length)
+        return;
+
+    // finish the chunk that was started by a previous call
+    if (chunkStateLength(&state->chunk)) {
+        const size_t take = qMin(Blake3ChunkLength - chunkStateLength(&state->chunk), length);
+        chunkStateUpdate(&state->chunk, input, take);
+        input += take;
+        length -= take;
+        if (!length)
+            return;
+
+        uchar cv[Blake3OutLength];
+        chunkStateOutput(&state->chunk).chainingValue(cv);
+        pushCv(state, cv, state->chunk.chunkCounter);
+        chunkStateReset(&state->chunk, state->key, state->chunk.chunkCounter + 1);
+    }
+
+    // Hash whole subtrees while more than one chunk remains. A subtree must be
+    // a power of two chunks in size and aligned to its size within the input.
+    while (length > Blake3ChunkLength) {
+        size_t subtreeLength = roundDownToPowerOf2(length);
+        const quint64 countSoFar = state->chunk.chunkCounter * Blake3ChunkLength;
+        while (((subtreeLength - 1) & countSoFar) != 0)
+            subtreeLength /= 2;
+        const quint64 subtreeChunks = subtreeLength / Blake3ChunkLength;
+
+        if (subtreeLength <= Blake3ChunkLength) {
+            Blake3ChunkState chunk;
+            chunkStateInit(&chunk, state->key, state->chunk.flags);
+            chunk.chunkCounter = state->chunk.chunkCounter;
+            chunkStateUpdate(&chunk, input, subtreeLength);
+            uchar cv[Blake3OutLength];
+            chunkStateOutput(&chunk).chainingValue(cv);
+            pushCv(state, cv, chunk.chunkCounter);
+        } else {
+            uchar cvPair[2 * Blake3OutLength];
+            compressSubtreeToParentNode(input, subtreeLength, state->key, state->chunk.chunkCounter,
+                                        state->chunk.flags, cvPair);
+            pushCv(state, cvPair, state->chunk.chunkCounter);
+            pushCv(state, cvPair + Blake3OutLength, state->chunk.chunkCounter + subtreeChunks / 2);
+        }
+        state->chunk.chunkCounter += subtreeChunks;
+        input += subtreeLength;
+        length -= subtreeLength;
+    }
+
+    if (length) {
+        chunkStateUpdate(&state->chunk, input, length);
+        mergeCvStack(state, state->chunk.chunkCounter);
+    }
+}
+
+void qt_blake3_finalize(const Blake3State *state, uchar *out, size_t length)
+{
+    if (!length)
+        return;
+
+    if (state->cvStackLength == 0) {
+        chunkStateOutput(&state->chunk).rootBytes(out, length);
+        return;
+    }
+
+    Output output;
+    size_t remaining;
+    if (chunkStateLength(&state->chunk)) {
+        remaining = state->cvStackLength;
+        output = chunkStateOutput(&state->chunk);
+    } else {
+        // the stack has at least two entries here, the last two form the root
+        remaining = state->cvStackLength - 2;
+        output = parentOutput(state->cvStack + remaining * Blake3OutLength, state->key,
+                              state->chunk.flags);
+    }
+    while (remaining) {
+        --remaining;
+        uchar parent[Blake3BlockLength];
+        memcpy(parent, state->cvStack + remaining * Blake3OutLength, Blake3OutLength);
+        output.chainingValue(parent + Blake3OutLength);
+        output = parentOutput(parent, state->key, state->chunk.flags);
+    }
+    output.rootBytes(out, length);
+}
+
+QT_END_NAMESPACE
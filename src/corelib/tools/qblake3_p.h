@@ -0,0 +1,95 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QBLAKE3_P_H
+#define QBLAKE3_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    BLAKE3 in its plain hashing mode. The state is trivially copyable, so that
+    QCryptographicHash can keep it in its union and copy it to finalize.
+*/
+enum {
+    Blake3BlockLength = 64,
+    Blake3ChunkLength = 1024,
+    Blake3OutLength = 32,
+    Blake3MaxDepth = 54
+};
+
+struct Blake3ChunkState
+{
+    quint32 cv[8];
+    quint64 chunkCounter;
+    uchar buffer[Blake3BlockLength];
+    quint8 bufferLength;
+    quint8 blocksCompressed;
+    quint8 flags;
+};
+
+struct Blake3State
+{
+    quint32 key[8];
+    Blake3ChunkState chunk;
+    quint8 cvStackLength;
+    // the stack is one entry larger than the tree depth to allow for lazy merging
+    uchar cvStack[(Blake3MaxDepth + 1) * Blake3OutLength];
+};
+
+void qt_blake3_init(Blake3State *state);
+void qt_blake3_update(Blake3State *state, const uchar *data, size_t length);
+void qt_blake3_finalize(const Blake3State *state, uchar *out, size_t length);
+
+QT_END_NAMESPACE
+
+#endif // QBLAKE3_P_H
@@ -40,6 +40,21 @@
 
 #include <qcryptographichash.h>
 #include <qiodevice.h>
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+#include <private/qsimd_p.h>
+#include <qvarlengtharray.h>
+#if QT_CONFIG(thread)
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
+#include "qblake3_p.h"
+#include "qxxh3_p.h"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#endif
 
 #include "../../3rdparty/sha1/sha1.cpp"
 
@@ -168,6 +183,780 @@ static inline int SHA384_512AddLength(SHA512Context *context, unsigned int lengt
 
 QT_BEGIN_NAMESPACE
 
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+/*
+    Hardware implementations of the SHA-1 and SHA-256 block functions. The
+    portable code in 3rdparty is still used for the partial blocks and the
+    padding, so these only need to process whole 64-byte blocks.
+*/
+#if QT_COMPILER_SUPPORTS_HERE(SHA) && QT_COMPILER_SUPPORTS_HERE(SSE4_1)
+#  define QT_CRYPTOGRAPHICHASH_SHA_EXTENSIONS
+static inline bool hasShaExtensions()
+{
+    return qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1);
+}
+#elif defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+#  define QT_CRYPTOGRAPHICHASH_SHA_EXTENSIONS
+static inline bool hasShaExtensions()
+{
+    return true;
+}
+#endif
+
+/*
+    Without the SHA extensions, batches of SHA-256 hashes are computed eight
+    messages at a time in the lanes of AVX2 registers.
+*/
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+#  define QT_CRYPTOGRAPHICHASH_MULTI_BUFFER
+#endif
+
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_EXTENSIONS
+static const quint32 sha1RoundConstants[4] = {
+    0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6
+};
+#endif
+
+#if defined(QT_CRYPTOGRAPHICHASH_SHA_EXTENSIONS) || defined(QT_CRYPTOGRAPHICHASH_MULTI_BUFFER)
+alignas(16) static const quint32 sha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+#endif
+
+#if defined(QT_CRYPTOGRAPHICHASH_SHA_EXTENSIONS) && defined(Q_PROCESSOR_X86)
+QT_FUNCTION_TARGET(SHA) QT_FUNCTION_TARGET(SSE4_1)
+static void sha1Blocks(Sha1State *state, const uchar *data, size_t blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd = _mm_set_epi32(state->h0, state->h1, state->h2, state->h3);
+    __m128i e0 = _mm_set_epi32(state->h4, 0, 0, 0);
+    __m128i e1, msg0, msg1, msg2, msg3;
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i abcdSaved = abcd;
+        const __m128i eSaved = e0;
+
+        // rounds 0-3
+        msg0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0)), byteSwap);
+        e0 = _mm_add_epi32(e0, msg0);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        // rounds 4-7
+        msg1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16)), byteSwap);
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        // rounds 8-11
+        msg2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 32)), byteSwap);
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+        // rounds 12-15
+        msg3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 48)), byteSwap);
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+        // rounds 16-19
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+        // rounds 20-23
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+        // rounds 24-27
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+        // rounds 28-31
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+        // rounds 32-35
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+        // rounds 36-39
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+        // rounds 40-43
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+        // rounds 44-47
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+        // rounds 48-51
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+        // rounds 52-55
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+        // rounds 56-59
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+        // rounds 60-63
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+        // rounds 64-67
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+        // rounds 68-71
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+        msg3 = _mm_xor_si128(msg3, msg1);
+        // rounds 72-75
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+        // rounds 76-79
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+        e0 = _mm_sha1nexte_epu32(e0, eSaved);
+        abcd = _mm_add_epi32(abcd, abcdSaved);
+    }
+
+    state->h0 = _mm_extract_epi32(abcd, 3);
+    state->h1 = _mm_extract_epi32(abcd, 2);
+    state->h2 = _mm_extract_epi32(abcd, 1);
+    state->h3 = _mm_extract_epi32(abcd, 0);
+    state->h4 = _mm_extract_epi32(e0, 3);
+}
+
+QT_FUNCTION_TARGET(SHA) QT_FUNCTION_TARGET(SSE4_1)
+static inline void sha256RoundsShaNi(__m128i &state0, __m128i &state1, __m128i msg, const quint32 *k)
+{
+    msg = _mm_add_epi32(msg, _mm_load_si128(reinterpret_cast<const __m128i *>(k)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+}
+
+QT_FUNCTION_TARGET(SHA) QT_FUNCTION_TARGET(SSE4_1)
+static void sha256Blocks(quint32 *hash, const uchar *data, size_t blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // the instructions want the state as ABEF and CDGH
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hash)), 0xb1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hash + 4)), 0x1b);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+    __m128i msg0, msg1, msg2, msg3;
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i abefSaved = state0;
+        const __m128i cdghSaved = state1;
+
+        // rounds 0-3
+        msg0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0)), byteSwap);
+        sha256RoundsShaNi(state0, state1, msg0, sha256RoundConstants + 0);
+        // rounds 4-7
+        msg1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16)), byteSwap);
+        sha256RoundsShaNi(state0, state1, msg1, sha256RoundConstants + 4);
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+        // rounds 8-11
+        msg2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 32)), byteSwap);
+        sha256RoundsShaNi(state0, state1, msg2, sha256RoundConstants + 8);
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+        // rounds 12-15
+        msg3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 48)), byteSwap);
+        sha256RoundsShaNi(state0, state1, msg3, sha256RoundConstants + 12);
+        msg0 = _mm_sha256msg2_epu32(_mm_add_epi32(msg0, _mm_alignr_epi8(msg3, msg2, 4)), msg3);
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+        // rounds 16-19
+        sha256RoundsShaNi(state0, state1, msg0, sha256RoundConstants + 16);
+        msg1 = _mm_sha256msg2_epu32(_mm_add_epi32(msg1, _mm_alignr_epi8(msg0, msg3, 4)), msg0);
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+        // rounds 20-23
+        sha256RoundsShaNi(state0, state1, msg1, sha256RoundConstants + 20);
+        msg2 = _mm_sha256msg2_epu32(_mm_add_epi32(msg2, _mm_alignr_epi8(msg1, msg0, 4)), msg1);
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+        // rounds 24-27
+        sha256RoundsShaNi(state0, state1, msg2, sha256RoundConstants + 24);
+        msg3 = _mm_sha256msg2_epu32(_mm_add_epi32(msg3, _mm_alignr_epi8(msg2, msg1, 4)), msg2);
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+        // rounds 28-31
+        sha256RoundsShaNi(state0, state1, msg3, sha256RoundConstants + 28);
+        msg0 = _mm_sha256msg2_epu32(_mm_add_epi32(msg0, _mm_alignr_epi8(msg3, msg2, 4)), msg3);
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+        // rounds 32-35
+        sha256RoundsShaNi(state0, state1, msg0, sha256RoundConstants + 32);
+        msg1 = _mm_sha256msg2_epu32(_mm_add_epi32(msg1, _mm_alignr_epi8(msg0, msg3, 4)), msg0);
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+        // rounds 36-39
+        sha256RoundsShaNi(state0, state1, msg1, sha256RoundConstants + 36);
+        msg2 = _mm_sha256msg2_epu32(_mm_add_epi32(msg2, _mm_alignr_epi8(msg1, msg0, 4)), msg1);
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+        // rounds 40-43
+        sha256RoundsShaNi(state0, state1, msg2, sha256RoundConstants + 40);
+        msg3 = _mm_sha256msg2_epu32(_mm_add_epi32(msg3, _mm_alignr_epi8(msg2, msg1, 4)), msg2);
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+        // rounds 44-47
+        sha256RoundsShaNi(state0, state1, msg3, sha256RoundConstants + 44);
+        msg0 = _mm_sha256msg2_epu32(_mm_add_epi32(msg0, _mm_alignr_epi8(msg3, msg2, 4)), msg3);
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+        // rounds 48-51
+        sha256RoundsShaNi(state0, state1, msg0, sha256RoundConstants + 48);
+        msg1 = _mm_sha256msg2_epu32(_mm_add_epi32(msg1, _mm_alignr_epi8(msg0, msg3, 4)), msg0);
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+        // rounds 52-55
+        sha256RoundsShaNi(state0, state1, msg1, sha256RoundConstants + 52);
+        msg2 = _mm_sha256msg2_epu32(_mm_add_epi32(msg2, _mm_alignr_epi8(msg1, msg0, 4)), msg1);
+        // rounds 56-59
+        sha256RoundsShaNi(state0, state1, msg2, sha256RoundConstants + 56);
+        msg3 = _mm_sha256msg2_epu32(_mm_add_epi32(msg3, _mm_alignr_epi8(msg2, msg1, 4)), msg2);
+        // rounds 60-63
+        sha256RoundsShaNi(state0, state1, msg3, sha256RoundConstants + 60);
+
+        state0 = _mm_add_epi32(state0, abefSaved);
+        state1 = _mm_add_epi32(state1, cdghSaved);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(hash), _mm_blend_epi16(tmp, state1, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(hash + 4), _mm_alignr_epi8(state1, tmp, 8));
+}
+#elif defined(QT_CRYPTOGRAPHICHASH_SHA_EXTENSIONS)
+static inline uint32x4_t sha1LoadBigEndian(const uchar *data)
+{
+    return vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data)));
+}
+
+static void sha1Blocks(Sha1State *state, const uchar *data, size_t blocks)
+{
+    const quint32 h[4] = { state->h0, state->h1, state->h2, state->h3 };
+    uint32x4_t abcd = vld1q_u32(h);
+    quint32 e0 = state->h4;
+    quint32 e1;
+
+    for ( ; blocks; --blocks, data += 64) {
+        const uint32x4_t abcdSaved = abcd;
+        const quint32 eSaved = e0;
+        uint32x4_t msg0 = sha1LoadBigEndian(data);
+        uint32x4_t msg1 = sha1LoadBigEndian(data + 16);
+        uint32x4_t msg2 = sha1LoadBigEndian(data + 32);
+        uint32x4_t msg3 = sha1LoadBigEndian(data + 48);
+
+        // rounds 0-3
+        e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1cq_u32(abcd, e0, vaddq_u32(msg0, vdupq_n_u32(sha1RoundConstants[0])));
+        msg0 = vsha1su1q_u32(vsha1su0q_u32(msg0, msg1, msg2), msg3);
+        // rounds 4-7
+        e0 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1cq_u32(abcd, e1, vaddq_u32(msg1, vdupq_n_u32(sha1RoundConstants[0])));
+        msg1 = vsha1su1q_u32(vsha1su0q_u32(msg1, msg2, msg3), msg0);
+        // rounds 8-11
+        e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1cq_u32(abcd, e0, vaddq_u32(msg2, vdupq_n_u32(sha1RoundConstants[0])));
+        msg2 = vsha1su1q_u32(vsha1su0q_u32(msg2, msg3, msg0), msg1);
+        // rounds 12-15
+        e0 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1cq_u32(abcd, e1, vaddq_u32(msg3, vdupq_n_u32(sha1RoundConstants[0])));
+        msg3 = vsha1su1q_u32(vsha1su0q_u32(msg3, msg0, msg1), msg2);
+        // rounds 16-19
+        e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1cq_u32(abcd, e0, vaddq_u32(msg0, vdupq_n_u32(sha1RoundConstants[0])));
+        msg0 = vsha1su1q_u32(vsha1su0q_u32(msg0, msg1, msg2), msg3);
+        // rounds 20-23
+        e0 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1pq_u32(abcd, e1, vaddq_u32(msg1, vdupq_n_u32(sha1RoundConstants[1])));
+        msg1 = vsha1su1q_u32(vsha1su0q_u32(msg1, msg2, msg3), msg0);
+        // rounds 24-27
+        e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1pq_u32(abcd, e0, vaddq_u32(msg2, vdupq_n_u32(sha1RoundConstants[1])));
+        msg2 = vsha1su1q_u32(vsha1su0q_u32(msg2, msg3, msg0), msg1);
+        // rounds 28-31
+        e0 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1pq_u32(abcd, e1, vaddq_u32(msg3, vdupq_n_u32(sha1RoundConstants[1])));
+        msg3 = vsha1su1q_u32(vsha1su0q_u32(msg3, msg0, msg1), msg2);
+        // rounds 32-35
+        e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1pq_u32(abcd, e0, vaddq_u32(msg0, vdupq_n_u32(sha1RoundConstants[1])));
+        msg0 = vsha1su1q_u32(vsha1su0q_u32(msg0, msg1, msg2), msg3);
+        // rounds 36-39
+        e0 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1pq_u32(abcd, e1, vaddq_u32(msg1, vdupq_n_u32(sha1RoundConstants[1])));
+        msg1 = vsha1su1q_u32(vsha1su0q_u32(msg1, msg2, msg3), msg0);
+        // rounds 40-43
+        e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1mq_u32(abcd, e0, vaddq_u32(msg2, vdupq_n_u32(sha1RoundConstants[2])));
+        msg2 = vsha1su1q_u32(vsha1su0q_u32(msg2, msg3, msg0), msg1);
+        // rounds 44-47
+        e0 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1mq_u32(abcd, e1, vaddq_u32(msg3, vdupq_n_u32(sha1RoundConstants[2])));
+        msg3 = vsha1su1q_u32(vsha1su0q_u32(msg3, msg0, msg1), msg2);
+        // rounds 48-51
+        e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1mq_u32(abcd, e0, vaddq_u32(msg0, vdupq_n_u32(sha1RoundConstants[2])));
+        msg0 = vsha1su1q_u32(vsha1su0q_u32(msg0, msg1, msg2), msg3);
+        // rounds 52-55
+        e0 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1mq_u32(abcd, e1, vaddq_u32(msg1, vdupq_n_u32(sha1RoundConstants[2])));
+        msg1 = vsha1su1q_u32(vsha1su0q_u32(msg1, msg2, msg3), msg0);
+        // rounds 56-59
+        e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1mq_u32(abcd, e0, vaddq_u32(msg2, vdupq_n_u32(sha1RoundConstants[2])));
+        msg2 = vsha1su1q_u32(vsha1su0q_u32(msg2, msg3, msg0), msg1);
+        // rounds 60-63
+        e0 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1pq_u32(abcd, e1, vaddq_u32(msg3, vdupq_n_u32(sha1RoundConstants[3])));
+        msg3 = vsha1su1q_u32(vsha1su0q_u32(msg3, msg0, msg1), msg2);
+        // rounds 64-67
+        e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1pq_u32(abcd, e0, vaddq_u32(msg0, vdupq_n_u32(sha1RoundConstants[3])));
+        // rounds 68-71
+        e0 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1pq_u32(abcd, e1, vaddq_u32(msg1, vdupq_n_u32(sha1RoundConstants[3])));
+        // rounds 72-75
+        e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1pq_u32(abcd, e0, vaddq_u32(msg2, vdupq_n_u32(sha1RoundConstants[3])));
+        // rounds 76-79
+        e0 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        abcd = vsha1pq_u32(abcd, e1, vaddq_u32(msg3, vdupq_n_u32(sha1RoundConstants[3])));
+
+        abcd = vaddq_u32(abcd, abcdSaved);
+        e0 += eSaved;
+    }
+
+    state->h0 = vgetq_lane_u32(abcd, 0);
+    state->h1 = vgetq_lane_u32(abcd, 1);
+    state->h2 = vgetq_lane_u32(abcd, 2);
+    state->h3 = vgetq_lane_u32(abcd, 3);
+    state->h4 = e0;
+}
+
+static void sha256Blocks(quint32 *hash, const uchar *data, size_t blocks)
+{
+    uint32x4_t state0 = vld1q_u32(hash);
+    uint32x4_t state1 = vld1q_u32(hash + 4);
+
+    for ( ; blocks; --blocks, data += 64) {
+        const uint32x4_t abcdSaved = state0;
+        const uint32x4_t efghSaved = state1;
+        uint32x4_t msg0 = sha1LoadBigEndian(data);
+        uint32x4_t msg1 = sha1LoadBigEndian(data + 16);
+        uint32x4_t msg2 = sha1LoadBigEndian(data + 32);
+        uint32x4_t msg3 = sha1LoadBigEndian(data + 48);
+        uint32x4_t wk, previous;
+
+        // rounds 0-3
+        wk = vaddq_u32(msg0, vld1q_u32(sha256RoundConstants + 0));
+        msg0 = vsha256su1q_u32(vsha256su0q_u32(msg0, msg1), msg2, msg3);
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 4-7
+        wk = vaddq_u32(msg1, vld1q_u32(sha256RoundConstants + 4));
+        msg1 = vsha256su1q_u32(vsha256su0q_u32(msg1, msg2), msg3, msg0);
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 8-11
+        wk = vaddq_u32(msg2, vld1q_u32(sha256RoundConstants + 8));
+        msg2 = vsha256su1q_u32(vsha256su0q_u32(msg2, msg3), msg0, msg1);
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 12-15
+        wk = vaddq_u32(msg3, vld1q_u32(sha256RoundConstants + 12));
+        msg3 = vsha256su1q_u32(vsha256su0q_u32(msg3, msg0), msg1, msg2);
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 16-19
+        wk = vaddq_u32(msg0, vld1q_u32(sha256RoundConstants + 16));
+        msg0 = vsha256su1q_u32(vsha256su0q_u32(msg0, msg1), msg2, msg3);
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 20-23
+        wk = vaddq_u32(msg1, vld1q_u32(sha256RoundConstants + 20));
+        msg1 = vsha256su1q_u32(vsha256su0q_u32(msg1, msg2), msg3, msg0);
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 24-27
+        wk = vaddq_u32(msg2, vld1q_u32(sha256RoundConstants + 24));
+        msg2 = vsha256su1q_u32(vsha256su0q_u32(msg2, msg3), msg0, msg1);
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 28-31
+        wk = vaddq_u32(msg3, vld1q_u32(sha256RoundConstants + 28));
+        msg3 = vsha256su1q_u32(vsha256su0q_u32(msg3, msg0), msg1, msg2);
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 32-35
+        wk = vaddq_u32(msg0, vld1q_u32(sha256RoundConstants + 32));
+        msg0 = vsha256su1q_u32(vsha256su0q_u32(msg0, msg1), msg2, msg3);
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 36-39
+        wk = vaddq_u32(msg1, vld1q_u32(sha256RoundConstants + 36));
+        msg1 = vsha256su1q_u32(vsha256su0q_u32(msg1, msg2), msg3, msg0);
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 40-43
+        wk = vaddq_u32(msg2, vld1q_u32(sha256RoundConstants + 40));
+        msg2 = vsha256su1q_u32(vsha256su0q_u32(msg2, msg3), msg0, msg1);
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 44-47
+        wk = vaddq_u32(msg3, vld1q_u32(sha256RoundConstants + 44));
+        msg3 = vsha256su1q_u32(vsha256su0q_u32(msg3, msg0), msg1, msg2);
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 48-51
+        wk = vaddq_u32(msg0, vld1q_u32(sha256RoundConstants + 48));
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 52-55
+        wk = vaddq_u32(msg1, vld1q_u32(sha256RoundConstants + 52));
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 56-59
+        wk = vaddq_u32(msg2, vld1q_u32(sha256RoundConstants + 56));
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+        // rounds 60-63
+        wk = vaddq_u32(msg3, vld1q_u32(sha256RoundConstants + 60));
+        previous = state0;
+        state0 = vsha256hq_u32(state0, state1, wk);
+        state1 = vsha256h2q_u32(state1, previous, wk);
+
+        state0 = vaddq_u32(state0, abcdSaved);
+        state1 = vaddq_u32(state1, efghSaved);
+    }
+
+    vst1q_u32(hash, state0);
+    vst1q_u32(hash + 4, state1);
+}
+#endif
+
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_EXTENSIONS
+static void sha1UpdateAccelerated(Sha1State *state, const uchar *data, size_t len)
+{
+    // complete the buffered block with the portable code, which processes it
+    const size_t buffered = state->messageSize & 63;
+    if (buffered) {
+        const size_t fill = qMin<size_t>(64 - buffered, len);
+        sha1Update(state, data, fill);
+        data += fill;
+        len -= fill;
+    }
+
+    const size_t blocks = len / 64;
+    if (blocks) {
+        sha1Blocks(state, data, blocks);
+        state->messageSize += blocks * 64;
+        data += blocks * 64;
+        len -= blocks * 64;
+    }
+
+    if (len)
+        sha1Update(state, data, len);
+}
+
+static void sha256UpdateAccelerated(SHA256Context *context, const uchar *data, size_t len)
+{
+    if (context->Message_Block_Index) {
+        const size_t fill = qMin<size_t>(SHA256_Message_Block_Size - context->Message_Block_Index, len);
+        SHA256Input(context, data, uint(fill));
+        data += fill;
+        len -= fill;
+    }
+
+    const size_t blocks = len / SHA256_Message_Block_Size;
+    if (blocks && !context->Computed && !context->Corrupted) {
+        sha256Blocks(context->Intermediate_Hash, data, blocks);
+
+        // the length is kept in bits, split in two 32-bit halves
+        const quint64 bits = (quint64(context->Length_High) << 32 | context->Length_Low)
+                + quint64(blocks) * SHA256_Message_Block_Size * 8;
+        context->Length_High = quint32(bits >> 32);
+        context->Length_Low = quint32(bits);
+        data += blocks * SHA256_Message_Block_Size;
+        len -= blocks * SHA256_Message_Block_Size;
+    }
+
+    if (len)
+        SHA256Input(context, data, uint(len));
+}
+#endif
+
+#ifdef QT_CRYPTOGRAPHICHASH_MULTI_BUFFER
+QT_FUNCTION_TARGET(AVX2)
+static inline __m256i sha256Rotr(__m256i x, int c)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, c), _mm256_slli_epi32(x, 32 - c));
+}
+
+// Processes one block for each of eight messages. The state is transposed,
+// state[i][lane] is word i of the message in that lane.
+QT_FUNCTION_TARGET(AVX2)
+static void sha256Blocks8(quint32 (*state)[8], const uchar *const *blocks)
+{
+    const __m256i byteSwap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                             12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i w[16];
+    for (int half = 0; half < 2; ++half) {
+        __m256i *v = w + 8 * half;
+        for (int lane = 0; lane < 8; ++lane)
+            v[lane] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[lane] + 32 * half));
+
+        // transpose, so that v[i] holds word i of each lane
+        const __m256i ab0145 = _mm256_unpacklo_epi32(v[0], v[1]);
+        const __m256i ab2367 = _mm256_unpackhi_epi32(v[0], v[1]);
+        const __m256i cd0145 = _mm256_unpacklo_epi32(v[2], v[3]);
+        const __m256i cd2367 = _mm256_unpackhi_epi32(v[2], v[3]);
+        const __m256i ef0145 = _mm256_unpacklo_epi32(v[4], v[5]);
+        const __m256i ef2367 = _mm256_unpackhi_epi32(v[4], v[5]);
+        const __m256i gh0145 = _mm256_unpacklo_epi32(v[6], v[7]);
+        const __m256i gh2367 = _mm256_unpackhi_epi32(v[6], v[7]);
+        const __m256i abcd04 = _mm256_unpacklo_epi64(ab0145, cd0145);
+        const __m256i abcd15 = _mm256_unpackhi_epi64(ab0145, cd0145);
+        const __m256i abcd26 = _mm256_unpacklo_epi64(ab2367, cd2367);
+        const __m256i abcd37 = _mm256_unpackhi_epi64(ab2367, cd2367);
+        const __m256i efgh04 = _mm256_unpacklo_epi64(ef0145, gh0145);
+        const __m256i efgh15 = _mm256_unpackhi_epi64(ef0145, gh0145);
+        const __m256i efgh26 = _mm256_unpacklo_epi64(ef2367, gh2367);
+        const __m256i efgh37 = _mm256_unpackhi_epi64(ef2367, gh2367);
+        v[0] = _mm256_permute2x128_si256(abcd04, efgh04, 0x20);
+        v[1] = _mm256_permute2x128_si256(abcd15, efgh15, 0x20);
+        v[2] = _mm256_permute2x128_si256(abcd26, efgh26, 0x20);
+        v[3] = _mm256_permute2x128_si256(abcd37, efgh37, 0x20);
+        v[4] = _mm256_permute2x128_si256(abcd04, efgh04, 0x31);
+        v[5] = _mm256_permute2x128_si256(abcd15, efgh15, 0x31);
+        v[6] = _mm256_permute2x128_si256(abcd26, efgh26, 0x31);
+        v[7] = _mm256_permute2x128_si256(abcd37, efgh37, 0x31);
+        for (int i = 0; i < 8; ++i)
+            v[i] = _mm256_shuffle_epi8(v[i], byteSwap);
+    }
+
+    __m256i h[8];
+    for (int i = 0; i < 8; ++i)
+        h[i] = _mm256_load_si256(reinterpret_cast<const __m256i *>(state[i]));
+    __m256i a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+
+    for (int t = 0; t < 64; ++t) {
+        if (t >= 16) {
+            const __m256i w15 = w[(t - 15) & 15];
+            const __m256i w2 = w[(t - 2) & 15];
+            const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(sha256Rotr(w15, 7), sha256Rotr(w15, 18)),
+                                                _mm256_srli_epi32(w15, 3));
+            const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(sha256Rotr(w2, 17), sha256Rotr(w2, 19)),
+                                                _mm256_srli_epi32(w2, 10));
+            w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0),
+                                         _mm256_add_epi32(w[(t - 7) & 15], s1));
+        }
+        const __m256i bigSigma1 = _mm256_xor_si256(_mm256_xor_si256(sha256Rotr(e, 6), sha256Rotr(e, 11)),
+                                                   sha256Rotr(e, 25));
+        const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(hh, bigSigma1),
+                                            _mm256_add_epi32(_mm256_add_epi32(ch, w[t & 15]),
+                                                             _mm256_set1_epi32(int(sha256RoundConstants[t]))));
+        const __m256i bigSigma0 = _mm256_xor_si256(_mm256_xor_si256(sha256Rotr(a, 2), sha256Rotr(a, 13)),
+                                                   sha256Rotr(a, 22));
+        const __m256i maj = _mm256_or_si256(_mm256_and_si256(_mm256_or_si256(a, b), c), _mm256_and_si256(a, b));
+        hh = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, _mm256_add_epi32(bigSigma0, maj));
+    }
+
+    const __m256i result[8] = { a, b, c, d, e, f, g, hh };
+    for (int i = 0; i < 8; ++i)
+        _mm256_store_si256(reinterpret_cast<__m256i *>(state[i]), _mm256_add_epi32(h[i], result[i]));
+}
+
+static void sha256MultiBuffer(const QByteArray *data, QByteArray *results, int begin, int end,
+                              bool sha224)
+{
+    struct Lane {
+        int index;
+        const uchar *data;
+        qsizetype fullBlocks;
+        qsizetype totalBlocks;
+        qsizetype block;
+        uchar tail[2 * SHA256_Message_Block_Size];
+
+        const uchar *currentBlock() const
+        {
+            if (block < fullBlocks)
+                return data + block * SHA256_Message_Block_Size;
+            return tail + (block - fullBlocks) * SHA256_Message_Block_Size;
+        }
+    };
+
+    // longest first, so that the lanes run out of work at about the same time
+    QVarLengthArray<int, 256> order(end - begin);
+    std::iota(order.begin(), order.end(), begin);
+    std::stable_sort(order.begin(), order.end(), [data](int lhs, int rhs) {
+        return data[lhs].size() > data[rhs].size();
+    });
+
+    const quint32 *initialHash = sha224 ? SHA224_H0 : SHA256_H0;
+    const int hashSize = sha224 ? SHA224HashSize : SHA256HashSize;
+    alignas(32) quint32 state[8][8];
+    alignas(32) static const uchar idleBlock[SHA256_Message_Block_Size] = {};
+    Lane lanes[8];
+    int next = 0;
+    int active = 0;
+
+    auto finishLane = [&](int lane) {
+        QByteArray &digest = results[lanes[lane].index];
+        digest.resize(hashSize);
+        for (int i = 0; i < hashSize / 4; ++i)
+            qToBigEndian(state[i][lane], digest.data() + 4 * i);
+    };
+    auto startLane = [&](int lane) {
+        if (next == order.size()) {
+            lanes[lane].index = -1;
+            return false;
+        }
+        Lane &l = lanes[lane];
+        l.index = order[next++];
+        const QByteArray &message = data[l.index];
+        l.data = reinterpret_cast<const uchar *>(message.constData());
+        l.fullBlocks = message.size() / SHA256_Message_Block_Size;
+        l.block = 0;
+
+        // build the padding: 0x80, zeroes, and the length in bits
+        const qsizetype rest = message.size() % SHA256_Message_Block_Size;
+        const qsizetype tailBlocks = rest < SHA256_Message_Block_Size - 8 ? 1 : 2;
+        memset(l.tail, 0, sizeof(l.tail));
+        memcpy(l.tail, l.data + l.fullBlocks * SHA256_Message_Block_Size, size_t(rest));
+        l.tail[rest] = 0x80;
+        qToBigEndian(quint64(message.size()) * 8,
+                     l.tail + tailBlocks * SHA256_Message_Block_Size - 8);
+        l.totalBlocks = l.fullBlocks + tailBlocks;
+
+        for (int i = 0; i < 8; ++i)
+            state[i][lane] = initialHash[i];
+        return true;
+    };
+
+    for (int lane = 0; lane < 8; ++lane) {
+        if (startLane(lane))
+            ++active;
+    }
+
+    while (active) {
+        // with most lanes idle, the portable code is faster
+        if (active <= 2 && next == order.size())
+            break;
+
+        const uchar *blocks[8];
+        for (int lane = 0; lane < 8; ++lane)
+            blocks[lane] = lanes[lane].index < 0 ? idleBlock : lanes[lane].currentBlock();
+        sha256Blocks8(state, blocks);
+
+        for (int lane = 0; lane < 8; ++lane) {
+            Lane &l = lanes[lane];
+            if (l.index < 0 || ++l.block < l.totalBlocks)
+                continue;
+            finishLane(lane);
+            if (!startLane(lane))
+                --active;
+        }
+    }
+
+    for (int lane = 0; lane < 8; ++lane) {
+        Lane &l = lanes[lane];
+        if (l.index < 0)
+            continue;
+        SHA256Context context;
+        for (int i = 0; i < 8; ++i)
+            context.Intermediate_Hash[i] = state[i][lane];
+        for ( ; l.block < l.totalBlocks; ++l.block) {
+            memcpy(context.Message_Block, l.currentBlock(), SHA256_Message_Block_Size);
+            SHA224_256ProcessMessageBlock(&context);
+        }
+        for (int i = 0; i < 8; ++i)
+            state[i][lane] = context.Intermediate_Hash[i];
+        finishLane(lane);
+    }
+}
+#endif // QT_CRYPTOGRAPHICHASH_MULTI_BUFFER
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+
 class QCryptographicHashPrivate
 {
 public:
@@ -182,6 +971,8 @@ public:
         SHA384Context sha384Context;
         SHA512Context sha512Context;
         SHA3Context sha3Context;
+        Blake3State blake3Context;
+        Xxh3State xxh3Context;
 #endif
     };
 #ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -277,6 +1068,10 @@ void QCryptographicHashPrivate::sha3Finish(int bitCount, Sha3Variant sha3Variant
   \value Keccak_256 Generate a Keccak-256 hash sum. Introduced in Qt 5.9.2
   \value Keccak_384 Generate a Keccak-384 hash sum. Introduced in Qt 5.9.2
   \value Keccak_512 Generate a Keccak-512 hash sum. Introduced in Qt 5.9.2
+  \value Blake3_256 Generate a 256-bit BLAKE3 hash sum. Introduced in Qt 6.0
+  \value Xxh3_64 Generate a 64-bit XXH3 hash sum. This is not a cryptographic
+         hash and must not be used where collisions could be forced; it is meant
+         for checksums and content-addressed caches. Introduced in Qt 6.0
   \omitvalue RealSha3_224
   \omitvalue RealSha3_256
   \omitvalue RealSha3_384
@@ -350,6 +1145,12 @@ void QCryptographicHash::reset()
     case Keccak_512:
         sha3Init(&d->sha3Context, 512);
         break;
+    case Blake3_256:
+        qt_blake3_init(&d->blake3Context);
+        break;
+    case Xxh3_64:
+        qt_xxh3_init(&d->xxh3Context);
+        break;
 #endif
     }
     d->result.clear();
@@ -363,6 +1164,12 @@ void QCryptographicHash::addData(const char *data, int length)
 {
     switch (d->method) {
     case Sha1:
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_EXTENSIONS
+        if (hasShaExtensions()) {
+            sha1UpdateAccelerated(&d->sha1Context, reinterpret_cast<const uchar *>(data), length);
+            break;
+        }
+#endif
         sha1Update(&d->sha1Context, (const unsigned char *)data, length);
         break;
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -378,9 +1185,21 @@ void QCryptographicHash::addData(const char *data, int length)
         MD5Update(&d->md5Context, (const unsigned char *)data, length);
         break;
     case Sha224:
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_EXTENSIONS
+        if (hasShaExtensions()) {
+            sha256UpdateAccelerated(&d->sha224Context, reinterpret_cast<const uchar *>(data), length);
+            break;
+        }
+#endif
         SHA224Input(&d->sha224Context, reinterpret_cast<const unsigned char *>(data), length);
         break;
     case Sha256:
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_EXTENSIONS
+        if (hasShaExtensions()) {
+            sha256UpdateAccelerated(&d->sha256Context, reinterpret_cast<const uchar *>(data), length);
+            break;
+        }
+#endif
         SHA256Input(&d->sha256Context, reinterpret_cast<const unsigned char *>(data), length);
         break;
     case Sha384:
@@ -405,6 +1224,12 @@ void QCryptographicHash::addData(const char *data, int length)
     case Keccak_512:
         sha3Update(&d->sha3Context, reinterpret_cast<const BitSequence *>(data), quint64(length) * 8);
         break;
+    case Blake3_256:
+        qt_blake3_update(&d->blake3Context, reinterpret_cast<const uchar *>(data), size_t(length));
+        break;
+    case Xxh3_64:
+        qt_xxh3_update(&d->xxh3Context, reinterpret_cast<const uchar *>(data), size_t(length));
+        break;
 #endif
     }
     d->result.clear();
@@ -533,6 +1358,17 @@ QByteArray QCryptographicHash::result() const
         d->sha3Finish(512, QCryptographicHashPrivate::Sha3Variant::Keccak);
         break;
     }
+    case Blake3_256: {
+        d->result.resize(Blake3OutLength);
+        qt_blake3_finalize(&d->blake3Context, reinterpret_cast<uchar *>(d->result.data()),
+                           Blake3OutLength);
+        break;
+    }
+    case Xxh3_64: {
+        d->result.resize(sizeof(quint64));
+        qToBigEndian(qt_xxh3_digest(&d->xxh3Context), d->result.data());
+        break;
+    }
 #endif
     }
     return d->result;
@@ -548,6 +1384,118 @@ QByteArray QCryptographicHash::hash(const QByteArray &data, Algorithm method)
     return hash.result();
 }
 
+static void hashRange(QCryptographicHash::Algorithm method, const QByteArray *data,
+                      QByteArray *results, int begin, int end)
+{
+#ifdef QT_CRYPTOGRAPHICHASH_MULTI_BUFFER
+    bool multiBuffer = (method == QCryptographicHash::Sha224 || method == QCryptographicHash::Sha256)
+            && end - begin > 2 && qCpuHasFeature(AVX2);
+#  ifdef QT_CRYPTOGRAPHICHASH_SHA_EXTENSIONS
+    // one message at a time with the SHA extensions is faster
+    multiBuffer = multiBuffer && !hasShaExtensions();
+#  endif
+    if (multiBuffer) {
+        sha256MultiBuffer(data, results, begin, end, method == QCryptographicHash::Sha224);
+        return;
+    }
+#endif
+
+    QCryptographicHash hash(method);
+    for (int i = begin; i < end; ++i) {
+        hash.reset();
+        hash.addData(data[i]);
+        results[i] = hash.result();
+    }
+}
+
+#if !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1) && QT_CONFIG(thread)
+namespace {
+class HashRangeRunnable : public QRunnable
+{
+public:
+    HashRangeRunnable() { setAutoDelete(false); }
+
+    void run() override
+    {
+        hashRange(method, data, results, begin, end);
+        done->release();
+    }
+
+    QCryptographicHash::Algorithm method;
+    const QByteArray *data;
+    QByteArray *results;
+    int begin;
+    int end;
+    QSemaphore *done;
+};
+} // unnamed namespace
+#endif
+
+/*!
+  Returns the hashes of each of the buffers in \a data using \a method, in
+  the same order.
+
+  This is faster than calling hash() for each buffer. Large batches are
+  split between the threads of the global QThreadPool, and for some
+  algorithms several buffers are hashed at the same time using SIMD
+  instructions.
+
+  \since 6.0
+  \sa hash()
+*/
+QVector<QByteArray> QCryptographicHash::hashMany(const QVector<QByteArray> &data, Algorithm method)
+{
+    QVector<QByteArray> results(data.size());
+    if (data.isEmpty())
+        return results;
+
+#if !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1) && QT_CONFIG(thread)
+    // below this many bytes, a thread is not worth starting
+    const qint64 minimumBytesPerThread = 256 * 1024;
+    qint64 total = 0;
+    for (const QByteArray &buffer : data)
+        total += buffer.size();
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int rangeCount = int(std::min({ qint64(pool->maxThreadCount()),
+                                          total / minimumBytesPerThread,
+                                          qint64(data.size()) }));
+    if (rangeCount > 1) {
+        // split into ranges of about the same number of bytes; the first one
+        // is hashed by this thread
+        QSemaphore done;
+        std::unique_ptr<HashRangeRunnable[]> ranges(new HashRangeRunnable[rangeCount]);
+        qint64 bytes = 0;
+        int begin = 0;
+        for (int i = 0; i < rangeCount; ++i) {
+            const qint64 limit = total * (i + 1) / rangeCount;
+            int end = begin;
+            while (end < data.size() && (i == rangeCount - 1 || bytes < limit))
+                bytes += data.at(end++).size();
+            HashRangeRunnable &range = ranges[i];
+            range.method = method;
+            range.data = data.constData();
+            range.results = results.data();
+            range.begin = begin;
+            range.end = end;
+            range.done = &done;
+            begin = end;
+        }
+
+        for (int i = 1; i < rangeCount; ++i) {
+            if (!pool->tryStart(&ranges[i]))
+                ranges[i].run();
+        }
+        ranges[0].run();
+        done.acquire(rangeCount);
+        return results;
+    }
+#endif
+
+    hashRange(method, data.constData(), results.data(), 0, data.size());
+    return results;
+}
+
 /*!
   Returns the size of the output of the selected hash \a method in bytes.
 
@@ -583,6 +1531,10 @@ int QCryptographicHash::hashLength(QCryptographicHash::Algorithm method)
     case QCryptographicHash::RealSha3_512:
     case QCryptographicHash::Keccak_512:
         return 512 / 8;
+    case QCryptographicHash::Blake3_256:
+        return 256 / 8;
+    case QCryptographicHash::Xxh3_64:
+        return 64 / 8;
 #endif
     }
     return 0;
@@ -43,6 +43,7 @@
 
 #include <QtCore/qbytearray.h>
 #include <QtCore/qobjectdefs.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -74,6 +75,8 @@ public:
         RealSha3_256,
         RealSha3_384,
         RealSha3_512,
+        Blake3_256 = 15,
+        Xxh3_64,
 #  ifndef QT_SHA3_KECCAK_COMPAT
         Sha3_224 = RealSha3_224,
         Sha3_256 = RealSha3_256,
@@ -101,6 +104,7 @@ public:
     QByteArray result() const;
 
     static QByteArray hash(const QByteArray &data, Algorithm method);
+    static QVector<QByteArray> hashMany(const QVector<QByteArray> &data, Algorithm method);
     static int hashLength(Algorithm method);
 private:
     Q_DISABLE_COPY(QCryptographicHash)
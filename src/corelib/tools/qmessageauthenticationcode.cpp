@@ -111,6 +111,10 @@ static int qt_hash_block_size(QCryptographicHash::Algorithm method)
     case QCryptographicHash::RealSha3_512:
     case QCryptographicHash::Keccak_512:
         return 72;
+    case QCryptographicHash::Blake3_256:
+        return 64;
+    case QCryptographicHash::Xxh3_64:
+        return 64;
     }
     return 0;
 }
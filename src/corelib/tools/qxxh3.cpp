@@ -0,0 +1,401 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qxxh3_p.h"
+
+#include <private/qsimd_p.h>
+#include <qendian.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    This is XXH3-64 as specified by the xxHash reference implementation
+    (https://github.com/Cyan4973/xxHash), restricted to the default secret and
+    a zero seed, which is all QCryptographicHash needs. The long input path
+    has an SSE2 implementation of the accumulate and scramble steps.
+*/
+
+static const quint32 Prime32_1 = 0x9e3779b1U;
+static const quint32 Prime32_2 = 0x85ebca77U;
+static const quint32 Prime32_3 = 0xc2b2ae3dU;
+static const quint64 Prime64_1 = Q_UINT64_C(0x9e3779b185ebca87);
+static const quint64 Prime64_2 = Q_UINT64_C(0xc2b2ae3d27d4eb4f);
+static const quint64 Prime64_3 = Q_UINT64_C(0x165667b19e3779f9);
+static const quint64 Prime64_4 = Q_UINT64_C(0x85ebca77c2b2ae63);
+static const quint64 Prime64_5 = Q_UINT64_C(0x27d4eb2f165667c5);
+static const quint64 PrimeMx1 = Q_UINT64_C(0x165667919e3779f9);
+static const quint64 PrimeMx2 = Q_UINT64_C(0x9fb21c651e98df25);
+
+enum {
+    SecretSize = 192,
+    SecretSizeMin = 136,
+    SecretConsumeRate = 8,
+    SecretLimit = SecretSize - Xxh3StripeLength,
+    StripesPerBlock = SecretLimit / SecretConsumeRate,
+    SecretLastAccStart = 7,
+    SecretMergeAccsStart = 11,
+    MidSizeMax = 240,
+    MidSizeStartOffset = 3,
+    MidSizeLastOffset = 17
+};
+
+alignas(64) static const uchar defaultSecret[SecretSize] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+static inline quint32 readLE32(const uchar *p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+
+static inline quint64 readLE64(const uchar *p)
+{
+    return qFromLittleEndian<quint64>(p);
+}
+
+static inline quint64 rotl64(quint64 x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline quint64 mul128Fold64(quint64 lhs, quint64 rhs)
+{
+#ifdef __SIZEOF_INT128__
+    const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+    return quint64(product) ^ quint64(product >> 64);
+#else
+    const quint64 loLo = (lhs & 0xffffffff) * (rhs & 0xffffffff);
+    const quint64 hiLo = (lhs >> 32) * (rhs & 0xffffffff);
+    const quint64 loHi = (lhs & 0xffffffff) * (rhs >> 32);
+    const quint64 hiHi = (lhs >> 32) * (rhs >> 32);
+    const quint64 cross = (loLo >> 32) + (hiLo & 0xffffffff) + loHi;
+    const quint64 upper = (hiLo >> 32) + (cross >> 32) + hiHi;
+    const quint64 lower = (cross << 32) | (loLo & 0xffffffff);
+    return lower ^ upper;
+#endif
+}
+
+static inline quint64 xxh64Avalanche(quint64 h)
+{
+    h ^= h >> 33;
+    h *= Prime64_2;
+    h ^= h >> 29;
+    h *= Prime64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+static inline quint64 avalanche(quint64 h)
+{
+    h ^= h >> 37;
+    h *= PrimeMx1;
+    h ^= h >> 32;
+    return h;
+}
+
+static inline quint64 rrmxmx(quint64 h, quint64 length)
+{
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= PrimeMx2;
+    h ^= (h >> 35) + length;
+    h *= PrimeMx2;
+    return h ^ (h >> 28);
+}
+
+static inline quint64 mix16B(const uchar *input, const uchar *secret)
+{
+    return mul128Fold64(readLE64(input) ^ readLE64(secret),
+                        readLE64(input + 8) ^ readLE64(secret + 8));
+}
+
+static quint64 hashShort(const uchar *input, size_t length)
+{
+    const uchar *secret = defaultSecret;
+    if (length > 8) {
+        const quint64 bitflip1 = readLE64(secret + 24) ^ readLE64(secret + 32);
+        const quint64 bitflip2 = readLE64(secret + 40) ^ readLE64(secret + 48);
+        const quint64 lo = readLE64(input) ^ bitflip1;
+        const quint64 hi = readLE64(input + length - 8) ^ bitflip2;
+        return avalanche(length + qbswap(lo) + hi + mul128Fold64(lo, hi));
+    }
+    if (length >= 4) {
+        const quint64 bitflip = readLE64(secret + 8) ^ readLE64(secret + 16);
+        const quint64 input64 = readLE32(input + length - 4) + (quint64(readLE32(input)) << 32);
+        return rrmxmx(input64 ^ bitflip, length);
+    }
+    if (length) {
+        const quint32 combined = (quint32(input[0]) << 16) | (quint32(input[length >> 1]) << 24)
+                | quint32(input[length - 1]) | (quint32(length) << 8);
+        return xxh64Avalanche(combined ^ (readLE32(secret) ^ readLE32(secret + 4)));
+    }
+    return xxh64Avalanche(readLE64(secret + 56) ^ readLE64(secret + 64));
+}
+
+static quint64 hashMedium(const uchar *input, size_t length)
+{
+    const uchar *secret = defaultSecret;
+    quint64 acc = length * Prime64_1;
+    if (length <= 128) {
+        if (length > 32) {
+            if (length > 64) {
+                if (length > 96) {
+                    acc += mix16B(input + 48, secret + 96);
+                    acc += mix16B(input + length - 64, secret + 112);
+                }
+                acc += mix16B(input + 32, secret + 64);
+                acc += mix16B(input + length - 48, secret + 80);
+            }
+            acc += mix16B(input + 16, secret + 32);
+            acc += mix16B(input + length - 32, secret + 48);
+        }
+        acc += mix16B(input, secret);
+        acc += mix16B(input + length - 16, secret + 16);
+        return avalanche(acc);
+    }
+
+    for (int i = 0; i < 8; ++i)
+        acc += mix16B(input + 16 * i, secret + 16 * i);
+    acc = avalanche(acc);
+    quint64 accEnd = mix16B(input + length - 16, secret + SecretSizeMin - MidSizeLastOffset);
+    const int rounds = int(length / 16);
+    for (int i = 8; i < rounds; ++i)
+        accEnd += mix16B(input + 16 * i, secret + 16 * (i - 8) + MidSizeStartOffset);
+    return avalanche(acc + accEnd);
+}
+
+#ifdef __SSE2__
+static inline void accumulate512(quint64 *acc, const uchar *input, const uchar *secret)
+{
+    __m128i *xacc = reinterpret_cast<__m128i *>(acc);
+    for (int i = 0; i < Xxh3StripeLength / 16; ++i) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input) + i);
+        const __m128i key = _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret) + i);
+        const __m128i dataKey = _mm_xor_si128(data, key);
+        const __m128i product = _mm_mul_epu32(dataKey, _mm_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1)));
+        const __m128i sum = _mm_add_epi64(xacc[i], _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2)));
+        xacc[i] = _mm_add_epi64(product, sum);
+    }
+}
+
+static inline void scramble(quint64 *acc, const uchar *secret)
+{
+    __m128i *xacc = reinterpret_cast<__m128i *>(acc);
+    const __m128i prime = _mm_set1_epi32(int(Prime32_1));
+    for (int i = 0; i < Xxh3StripeLength / 16; ++i) {
+        const __m128i key = _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret) + i);
+        __m128i a = _mm_xor_si128(xacc[i], _mm_srli_epi64(xacc[i], 47));
+        a = _mm_xor_si128(a, key);
+        const __m128i productLo = _mm_mul_epu32(a, prime);
+        const __m128i productHi = _mm_mul_epu32(_mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        xacc[i] = _mm_add_epi64(productLo, _mm_slli_epi64(productHi, 32));
+    }
+}
+#else
+static inline void accumulate512(quint64 *acc, const uchar *input, const uchar *secret)
+{
+    for (int i = 0; i < 8; ++i) {
+        const quint64 data = readLE64(input + 8 * i);
+        const quint64 dataKey = data ^ readLE64(secret + 8 * i);
+        acc[i ^ 1] += data;
+        acc[i] += (dataKey & 0xffffffff) * (dataKey >> 32);
+    }
+}
+
+static inline void scramble(quint64 *acc, const uchar *secret)
+{
+    for (int i = 0; i < 8; ++i) {
+        quint64 a = acc[i];
+        a ^= a >> 47;
+        a ^= readLE64(secret + 8 * i);
+        acc[i] = a * Prime32_1;
+    }
+}
+#endif
+
+static inline void accumulate(quint64 *acc, const uchar *input, const uchar *secret, size_t stripes)
+{
+    for (size_t n = 0; n < stripes; ++n)
+        accumulate512(acc, input + n * Xxh3StripeLength, secret + n * SecretConsumeRate);
+}
+
+static const uchar *consumeStripes(quint64 *acc, quint32 *stripesSoFar,
+                                   const uchar *input, size_t stripes)
+{
+    const uchar *secret = defaultSecret + *stripesSoFar * SecretConsumeRate;
+    if (stripes >= StripesPerBlock - *stripesSoFar) {
+        size_t stripesThisBlock = StripesPerBlock - *stripesSoFar;
+        do {
+            accumulate(acc, input, secret, stripesThisBlock);
+            scramble(acc, defaultSecret + SecretLimit);
+            input += stripesThisBlock * Xxh3StripeLength;
+            stripes -= stripesThisBlock;
+            stripesThisBlock = StripesPerBlock;
+            secret = defaultSecret;
+        } while (stripes >= StripesPerBlock);
+        *stripesSoFar = 0;
+    }
+    if (stripes) {
+        accumulate(acc, input, secret, stripes);
+        input += stripes * Xxh3StripeLength;
+        *stripesSoFar += quint32(stripes);
+    }
+    return input;
+}
+
+static quint64 mergeAccumulators(const quint64 *acc, quint64 start)
+{
+    const uchar *secret = defaultSecret + SecretMergeAccsStart;
+    quint64 result = start;
+    for (int i = 0; i < 4; ++i) {
+        result += mul128Fold64(acc[2 * i] ^ readLE64(secret + 16 * i),
+                               acc[2 * i + 1] ^ readLE64(secret + 16 * i + 8));
+    }
+    return avalanche(result);
+}
+
+void qt_xxh3_init(Xxh3State *state)
+{
+    static const quint64 initialAcc[8] = {
+        Prime32_3, Prime64_1, Prime64_2, Prime64_3, Prime64_4, Prime32_2, Prime64_5, Prime32_1
+    };
+    memcpy(state->acc, initialAcc, sizeof(initialAcc));
+    state->totalLength = 0;
+    state->bufferedSize = 0;
+    state->stripesSoFar = 0;
+}
+
+void qt_xxh3_update(Xxh3State *state, const uchar *data, size_t length)
+{
+    state->totalLength += length;
+    if (length <= Xxh3BufferSize - state->bufferedSize) {
+        if (length)
+            memcpy(state->buffer + state->bufferedSize, data, length);
+        state->bufferedSize += quint32(length);
+        return;
+    }
+
+    const uchar *end = data + length;
+    if (state->bufferedSize) {
+        const size_t fill = Xxh3BufferSize - state->bufferedSize;
+        memcpy(state->buffer + state->bufferedSize, data, fill);
+        data += fill;
+        consumeStripes(state->acc, &state->stripesSoFar, state->buffer,
+                       Xxh3BufferSize / Xxh3StripeLength);
+        state->bufferedSize = 0;
+    }
+
+    // always keep at least one byte back, the last stripe is processed
+    // differently by qt_xxh3_digest()
+    if (end - data > Xxh3BufferSize) {
+        const size_t stripes = size_t(end - 1 - data) / Xxh3StripeLength;
+        data = consumeStripes(state->acc, &state->stripesSoFar, data, stripes);
+        // the digest may need the previous stripe to complete the last one
+        memcpy(state->buffer + Xxh3BufferSize - Xxh3StripeLength, data - Xxh3StripeLength,
+               Xxh3StripeLength);
+    }
+
+    memcpy(state->buffer, data, size_t(end - data));
+    state->bufferedSize = quint32(end - data);
+}
+
+quint64 qt_xxh3_digest(const Xxh3State *state)
+{
+    if (state->totalLength <= MidSizeMax)
+        return qt_xxh3_64(state->buffer, size_t(state->totalLength));
+
+    alignas(16) quint64 acc[8];
+    memcpy(acc, state->acc, sizeof(acc));
+
+    uchar lastStripe[Xxh3StripeLength];
+    const uchar *lastStripePointer;
+    if (state->bufferedSize >= Xxh3StripeLength) {
+        quint32 stripesSoFar = state->stripesSoFar;
+        consumeStripes(acc, &stripesSoFar, state->buffer, (state->bufferedSize - 1) / Xxh3StripeLength);
+        lastStripePointer = state->buffer + state->bufferedSize - Xxh3StripeLength;
+    } else {
+        const size_t catchUp = Xxh3StripeLength - state->bufferedSize;
+        memcpy(lastStripe, state->buffer + Xxh3BufferSize - catchUp, catchUp);
+        memcpy(lastStripe + catchUp, state->buffer, state->bufferedSize);
+        lastStripePointer = lastStripe;
+    }
+    accumulate512(acc, lastStripePointer, defaultSecret + SecretLimit - SecretLastAccStart);
+    return mergeAccumulators(acc, state->totalLength * Prime64_1);
+}
+
+quint64 qt_xxh3_64(const uchar *data, size_t length) noexcept
+{
+    if (length <= 16)
+        return hashShort(data, length);
+    if (length <= MidSizeMax)
+        return hashMedium(data, length);
+
+    alignas(16) quint64 acc[8];
+    Xxh3State state;
+    qt_xxh3_init(&state);
+    memcpy(acc, state.acc, sizeof(acc));
+
+    const size_t blockLength = Xxh3StripeLength * StripesPerBlock;
+    const size_t blocks = (length - 1) / blockLength;
+    for (size_t n = 0; n < blocks; ++n) {
+        accumulate(acc, data + n * blockLength, defaultSecret, StripesPerBlock);
+        scramble(acc, defaultSecret + SecretLimit);
+    }
+
+    const size_t stripes = ((length - 1) - blockLength * blocks) / Xxh3StripeLength;
+    accumulate(acc, data + blocks * blockLength, defaultSecret, stripes);
+    accumulate512(acc, data + length - Xxh3StripeLength,
+                  defaultSecret + SecretLimit - SecretLastAccStart);
+    return mergeAccumulators(acc, length * Prime64_1);
+}
+
+QT_END_NAMESPACE
@@ -8,6 +8,7 @@ HEADERS +=  \
         tools/qarraydataops.h \
         tools/qarraydatapointer.h \
         tools/qbitarray.h \
+        tools/qblake3_p.h \
         tools/qcache.h \
         tools/qcontainerfwd.h \
         tools/qcontainertools_impl.h \
@@ -45,12 +46,14 @@ HEADERS +=  \
         tools/qtools_p.h \
         tools/qvarlengtharray.h \
         tools/qvector.h \
-        tools/qversionnumber.h
+        tools/qversionnumber.h \
+        tools/qxxh3_p.h
 
 
 SOURCES += \
         tools/qarraydata.cpp \
         tools/qbitarray.cpp \
+        tools/qblake3.cpp \
         tools/qcryptographichash.cpp \
         tools/qfreelist.cpp \
         tools/qhash.cpp \
@@ -69,7 +72,8 @@ SOURCES += \
         tools/qsharedpointer.cpp \
         tools/qsimd.cpp \
         tools/qsize.cpp \
-        tools/qversionnumber.cpp
+        tools/qversionnumber.cpp \
+        tools/qxxh3.cpp
 
 msvc: NO_PCH_SOURCES += tools/qvector_msvc.cpp
 false: SOURCES += $$NO_PCH_SOURCES # Hack for QtCreator
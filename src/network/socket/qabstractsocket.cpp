@@ -473,6 +473,7 @@
 #include <qpointer.h>
 #include <qtimer.h>
 #include <qelapsedtimer.h>
+#include <qfile.h>
 #include <qscopedvaluerollback.h>
 #include <qvarlengtharray.h>
 
@@ -599,6 +600,7 @@ void QAbstractSocketPrivate::resetSocketLayer()
 #endif
 
     hasPendingData = false;
+    pendingFiles.clear();
     if (socketEngine) {
         socketEngine->close();
         socketEngine->disconnect();
@@ -829,7 +831,7 @@ void QAbstractSocketPrivate::connectionNotification()
 bool QAbstractSocketPrivate::writeToSocket()
 {
     Q_Q(QAbstractSocket);
-    if (!socketEngine || !socketEngine->isValid() || (writeBuffer.isEmpty()
+    if (!socketEngine || !socketEngine->isValid() || (!hasPendingWrites()
         && socketEngine->bytesToWrite() == 0)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocketPrivate::writeToSocket() nothing to do: valid ? %s, writeBuffer.isEmpty() ? %s",
@@ -847,8 +849,14 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
+    if (!pendingFiles.isEmpty() && pendingFiles.constFirst().bufferedBefore == 0)
+        return writeFileToSocket();
+
     qint64 nextSize = writeBuffer.nextDataBlockSize();
     const char *ptr = writeBuffer.readPointer();
+    // don't send data written after the next file ahead of it
+    if (!pendingFiles.isEmpty())
+        nextSize = qMin(nextSize, pendingFiles.constFirst().bufferedBefore);
 
     // Attempt to write it all in one chunk.
     qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
@@ -871,12 +879,80 @@ bool QAbstractSocketPrivate::writeToSocket()
     if (written > 0) {
         // Remove what we wrote so far.
         writeBuffer.free(written);
+        if (!pendingFiles.isEmpty())
+            pendingFiles.first().bufferedBefore -= written;
 
         // Emit notifications.
         emitBytesWritten(written);
     }
 
-    if (writeBuffer.isEmpty() && socketEngine && !socketEngine->bytesToWrite())
+    if (!hasPendingWrites() && socketEngine && !socketEngine->bytesToWrite())
+        socketEngine->setWriteNotificationEnabled(false);
+    if (state == QAbstractSocket::ClosingState)
+        q->disconnectFromHost();
+
+    return written > 0;
+}
+
+/*! \internal
+
+    Writes the next part of the first file queued by sendFile() to the
+    socket, with sendfile(2) where the socket engine supports it and by
+    reading the file otherwise.
+
+    Emits bytesWritten().
+*/
+bool QAbstractSocketPrivate::writeFileToSocket()
+{
+    Q_Q(QAbstractSocket);
+    PendingFile &pending = pendingFiles.first();
+
+    qint64 written = -1;
+    if (pending.file && pending.file->isOpen()) {
+        if (pending.useSendFile) {
+            written = socketEngine->sendFile(pending.file->handle(), pending.offset,
+                                             pending.remaining);
+            if (written < 0
+                && socketEngine->error() == QAbstractSocket::UnsupportedSocketOperationError) {
+                pending.useSendFile = false;
+            }
+        }
+        if (!pending.useSendFile) {
+            if (pending.chunk.isEmpty() && pending.file->seek(pending.offset))
+                pending.chunk = pending.file->read(qMin(pending.remaining, qint64(writeBufferChunkSize)));
+            if (pending.chunk.isEmpty()) {
+                setErrorAndEmit(QAbstractSocket::UnknownSocketError,
+                                QAbstractSocket::tr("Error reading the file to send"));
+                q->abort();
+                return false;
+            }
+            written = socketEngine->write(pending.chunk.constData(), pending.chunk.size());
+            if (written > 0)
+                pending.chunk.remove(0, written);
+        }
+    } else {
+        setErrorAndEmit(QAbstractSocket::UnknownSocketError,
+                        QAbstractSocket::tr("The file to send was closed"));
+        q->abort();
+        return false;
+    }
+
+    if (written < 0) {
+        setErrorAndEmit(socketEngine->error(), socketEngine->errorString());
+        q->abort();
+        return false;
+    }
+
+    if (written > 0) {
+        pending.offset += written;
+        pending.remaining -= written;
+        if (pending.remaining == 0)
+            pendingFiles.removeFirst();
+
+        emitBytesWritten(written);
+    }
+
+    if (!hasPendingWrites() && socketEngine && !socketEngine->bytesToWrite())
         socketEngine->setWriteNotificationEnabled(false);
     if (state == QAbstractSocket::ClosingState)
         q->disconnectFromHost();
@@ -894,7 +970,7 @@ bool QAbstractSocketPrivate::flush()
 {
     bool dataWasWritten = false;
 
-    while (!allWriteBuffersEmpty() && writeToSocket())
+    while (hasPendingWrites() && writeToSocket())
         dataWasWritten = true;
 
     return dataWasWritten;
@@ -1791,7 +1867,10 @@ void QAbstractSocket::connectToHost(const QHostAddress &address, quint16 port,
 */
 qint64 QAbstractSocket::bytesToWrite() const
 {
-    const qint64 pendingBytes = QIODevice::bytesToWrite();
+    Q_D(const QAbstractSocket);
+    qint64 pendingBytes = QIODevice::bytesToWrite();
+    for (const QAbstractSocketPrivate::PendingFile &pending : d->pendingFiles)
+        pendingBytes += pending.remaining;
 #if defined(QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocket::bytesToWrite() == %lld", pendingBytes);
 #endif
@@ -2254,7 +2333,7 @@ bool QAbstractSocket::waitForReadyRead(int msecs)
 
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty(),
+        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, d->hasPendingWrites(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2306,7 +2385,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         return false;
     }
 
-    if (d->writeBuffer.isEmpty())
+    if (!d->hasPendingWrites())
         return false;
 
     QElapsedTimer stopWatch;
@@ -2323,7 +2402,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite,
                                   !d->readBufferMaxSize || d->buffer.size() < d->readBufferMaxSize,
-                                  !d->writeBuffer.isEmpty(),
+                                  d->hasPendingWrites(),
                                   qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForBytesWritten(%i) failed (%i, %s)",
@@ -2402,7 +2481,7 @@ bool QAbstractSocket::waitForDisconnected(int msecs)
         bool readyToRead = false;
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, state() == ConnectedState,
-                                               !d->writeBuffer.isEmpty(),
+                                               d->hasPendingWrites(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2495,6 +2574,80 @@ bool QAbstractSocket::flush()
     return d_func()->flush();
 }
 
+/*!
+    \since 6.0
+
+    Queues \a size bytes of \a file, starting at \a offset, for sending
+    after the data already written to the socket. If \a size is -1, the
+    rest of the file is sent. Returns \c true if the data was queued;
+    otherwise returns \c false.
+
+    The file must be open for reading and must not be sequential. It is
+    read when the socket can take more data, so it must stay open until
+    the data has been sent; its position is undefined afterwards. On Linux,
+    TCP sockets without a proxy send the file with sendfile(2), which does
+    not copy the data through the application. Otherwise, the file is read
+    in chunks.
+
+    Data written with write() after this call is sent after the file.
+    bytesWritten() reports the progress, and bytesToWrite() includes the
+    part of the file that has not been sent yet.
+
+    Sockets that process the data before sending it, like QSslSocket, read
+    the file and write() it immediately.
+
+    \sa write(), bytesWritten()
+*/
+bool QAbstractSocket::sendFile(QFile *file, qint64 offset, qint64 size)
+{
+    Q_D(QAbstractSocket);
+    if (!file || !file->isReadable() || file->isSequential()) {
+        qWarning("QAbstractSocket::sendFile: the file must be open for reading and not sequential");
+        return false;
+    }
+    if (offset < 0 || size < -1) {
+        qWarning("QAbstractSocket::sendFile: invalid range");
+        return false;
+    }
+    if (d->state != ConnectedState || d->socketType != TcpSocket || !isWritable()) {
+        d->setError(UnknownSocketError, tr("Socket is not connected"));
+        return false;
+    }
+
+    const qint64 available = qMax(file->size() - offset, Q_INT64_C(0));
+    if (size < 0 || size > available)
+        size = available;
+    if (size == 0)
+        return true;
+
+    if (!d->socketEngine) {
+        // the data needs to go through writeData()
+        if (!file->seek(offset)) {
+            d->setError(UnknownSocketError, tr("Error reading the file to send"));
+            return false;
+        }
+        while (size > 0) {
+            const QByteArray block = file->read(qMin(size, qint64(d->writeBufferChunkSize)));
+            if (block.isEmpty()) {
+                d->setError(UnknownSocketError, tr("Error reading the file to send"));
+                return false;
+            }
+            if (write(block) != block.size())
+                return false;
+            size -= block.size();
+        }
+        return true;
+    }
+
+    // the part of the write buffer not yet claimed by earlier files goes first
+    qint64 bufferedBefore = d->writeBuffer.size();
+    for (const QAbstractSocketPrivate::PendingFile &pending : qAsConst(d->pendingFiles))
+        bufferedBefore -= pending.bufferedBefore;
+    d->pendingFiles.append({ file, offset, size, bufferedBefore, QByteArray(), file->handle() != -1 });
+    d->socketEngine->setWriteNotificationEnabled(true);
+    return true;
+}
+
 /*! \reimp
 */
 qint64 QAbstractSocket::readData(char *data, qint64 maxSize)
@@ -2548,7 +2701,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     }
 
     if (!d->isBuffered && d->socketType == TcpSocket
-        && d->socketEngine && d->writeBuffer.isEmpty()) {
+        && d->socketEngine && !d->hasPendingWrites()) {
         // This code is for the new Unbuffered QTcpSocket use case
         qint64 written = size ? d->socketEngine->write(data, size) : Q_INT64_C(0);
         if (written < 0) {
@@ -2778,7 +2931,7 @@ void QAbstractSocket::disconnectFromHost()
         }
 
         // Wait for pending data to be written.
-        if (d->socketEngine && d->socketEngine->isValid() && (!d->allWriteBuffersEmpty()
+        if (d->socketEngine && d->socketEngine->isValid() && (d->hasPendingWrites()
             || d->socketEngine->bytesToWrite() > 0)) {
             d->socketEngine->setWriteNotificationEnabled(true);
 
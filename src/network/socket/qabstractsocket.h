@@ -56,6 +56,7 @@ class QNetworkProxy;
 #endif
 class QAbstractSocketPrivate;
 class QAuthenticator;
+class QFile;
 
 class Q_NETWORK_EXPORT QAbstractSocket : public QIODevice
 {
@@ -188,6 +189,8 @@ public:
     bool atEnd() const override; // ### Qt6: remove me
     bool flush();
 
+    bool sendFile(QFile *file, qint64 offset = 0, qint64 size = -1);
+
     // for synchronous access
     virtual bool waitForConnected(int msecs = 30000);
     bool waitForReadyRead(int msecs = 30000) override;
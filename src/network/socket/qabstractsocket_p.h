@@ -59,10 +59,12 @@
 #include "private/qiodevice_p.h"
 #include "private/qabstractsocketengine_p.h"
 #include "qnetworkproxy.h"
+#include "qpointer.h"
 
 QT_BEGIN_NAMESPACE
 
 class QHostInfo;
+class QFile;
 
 class QAbstractSocketPrivate : public QIODevicePrivate, public QAbstractSocketEngineReceiver
 {
@@ -140,12 +142,26 @@ public:
     void fetchConnectionParameters();
     bool readFromSocket();
     virtual bool writeToSocket();
+    bool writeFileToSocket();
+    bool hasPendingWrites() const { return !writeBuffer.isEmpty() || !pendingFiles.isEmpty(); }
     void emitReadyRead(int channel = 0);
     void emitBytesWritten(qint64 bytes, int channel = 0);
 
     void setError(QAbstractSocket::SocketError errorCode, const QString &errorString);
     void setErrorAndEmit(QAbstractSocket::SocketError errorCode, const QString &errorString);
 
+    // Files queued by sendFile(). bufferedBefore counts the bytes of
+    // writeBuffer that were written before the file and go out first.
+    struct PendingFile {
+        QPointer<QFile> file;
+        qint64 offset;
+        qint64 remaining;
+        qint64 bufferedBefore;
+        QByteArray chunk;       // read from the file when sendfile(2) can't be used
+        bool useSendFile;
+    };
+    QList<PendingFile> pendingFiles;
+
     qint64 readBufferMaxSize;
     bool isBuffered;
     bool hasPendingData;
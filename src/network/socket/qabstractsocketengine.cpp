@@ -132,6 +132,24 @@ QAbstractSocketEngine *QAbstractSocketEngine::createSocketEngine(qintptr socketD
     return new QNativeSocketEngine(parent);
 }
 
+/*!
+    Writes up to \a len bytes from the file open as \a fileDescriptor,
+    starting at \a offset, to the socket without copying them through user
+    space. Returns the number of bytes written, 0 if the socket cannot take
+    more data right now, or -1 on error. Engines that cannot do this fail
+    with QAbstractSocket::UnsupportedSocketOperationError, and so do engines
+    for which the file is not suitable; the caller then falls back to write().
+*/
+qint64 QAbstractSocketEngine::sendFile(int fileDescriptor, qint64 offset, qint64 len)
+{
+    Q_UNUSED(fileDescriptor);
+    Q_UNUSED(offset);
+    Q_UNUSED(len);
+    setError(QAbstractSocket::UnsupportedSocketOperationError,
+             QAbstractSocketEngine::tr("Unsupported socket operation"));
+    return -1;
+}
+
 QAbstractSocket::SocketError QAbstractSocketEngine::error() const
 {
     return d_func()->socketError;
@@ -919,6 +919,24 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
 }
 
 
+#ifdef Q_OS_LINUX
+/*!
+    Writes up to \a size bytes of the file open as \a fileDescriptor,
+    starting at \a offset, to the socket with sendfile(2). Returns the
+    number of bytes written, 0 if the socket would block, or -1 on error.
+    Files that sendfile(2) cannot read fail with
+    QAbstractSocket::UnsupportedSocketOperationError.
+*/
+qint64 QNativeSocketEngine::sendFile(int fileDescriptor, qint64 offset, qint64 size)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::sendFile(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::sendFile(), QAbstractSocket::ConnectedState, -1);
+    Q_CHECK_TYPE(QNativeSocketEngine::sendFile(), QAbstractSocket::TcpSocket, -1);
+    return d->nativeSendFile(fileDescriptor, offset, size);
+}
+#endif
+
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
     return 0;
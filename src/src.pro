@@ -59,6 +59,10 @@ src_tools_androidtestrunner.subdir = tools/androidtestrunner
 src_tools_androidtestrunner.target = sub-androidtestrunner
 src_tools_androidtestrunner.depends = src_corelib
 
+src_tools_qlogdecode.subdir = tools/qlogdecode
+src_tools_qlogdecode.target = sub-qlogdecode
+src_tools_qlogdecode.depends = src_corelib
+
 src_tools_qvkgen.subdir = tools/qvkgen
 src_tools_qvkgen.target = sub-qvkgen
 force_bootstrap: src_tools_qvkgen.depends = src_tools_bootstrap
@@ -163,7 +167,8 @@ qtConfig(regularexpression):pcre2 {
     src_corelib.depends += src_3rdparty_pcre2
 }
 TOOLS = src_tools_moc src_tools_rcc src_tools_tracegen src_tools_qlalr
-SUBDIRS += src_corelib src_tools_qlalr
+SUBDIRS += src_corelib src_tools_qlalr src_tools_qlogdecode
+TOOLS += src_tools_qlogdecode
 win32:SUBDIRS += src_winmain
 qtConfig(network) {
     SUBDIRS += src_network
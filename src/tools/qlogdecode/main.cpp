@@ -0,0 +1,81 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/qcommandlineparser.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qfile.h>
+#include <QtCore/private/qlogging_p.h>
+
+#include <stdio.h>
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationVersion(QLatin1String(QT_VERSION_STR));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral(
+        "Prints a log written with QT_LOGGING_BINARY set, formatting each message "
+        "as the default message handler would have. QT_MESSAGE_PATTERN, if set, "
+        "takes precedence over --pattern."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption patternOption(QStringList() << QStringLiteral("p") << QStringLiteral("pattern"),
+                                     QStringLiteral("Format the messages with <pattern>."),
+                                     QStringLiteral("pattern"));
+    parser.addOption(patternOption);
+    parser.addPositionalArgument(QStringLiteral("file"), QStringLiteral("The binary log to decode."));
+    parser.process(app);
+
+    const QStringList files = parser.positionalArguments();
+    if (files.size() != 1)
+        parser.showHelp(1);
+
+    QFile file(files.first());
+    if (!file.open(QIODevice::ReadOnly)) {
+        fprintf(stderr, "qlogdecode: cannot open %s: %s\n",
+                qPrintable(file.fileName()), qPrintable(file.errorString()));
+        return 1;
+    }
+
+    QBinaryLogReader reader(file.readAll());
+    if (!reader.isValid()) {
+        fprintf(stderr, "qlogdecode: %s is not a binary log\n", qPrintable(file.fileName()));
+        return 1;
+    }
+
+    if (parser.isSet(patternOption))
+        qSetMessagePattern(parser.value(patternOption));
+
+    while (reader.readNext()) {
+        const QString line = reader.formattedMessage();
+        if (!line.isNull())
+            printf("%s\n", line.toLocal8Bit().constData());
+    }
+    return 0;
+}
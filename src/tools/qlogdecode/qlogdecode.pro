@@ -0,0 +1,10 @@
+QT = core-private
+CONFIG += console
+
+SOURCES += main.cpp
+
+DEFINES += QT_NO_CAST_FROM_ASCII QT_NO_CAST_TO_ASCII
+DEFINES += QT_NO_FOREACH
+
+QMAKE_TARGET_DESCRIPTION = "Qt Binary Log Decoder"
+load(qt_app)
@@ -3961,7 +3961,8 @@ void QDomElementPrivate::setAttribute(const QString& aname, const QString& newVa
     }
 }
 
-void QDomElementPrivate::setAttributeNS(const QString& nsURI, const QString& qName, const QString& newValue)
+// Returns the attribute node that was created or updated
+QDomNodePrivate *QDomElementPrivate::setAttributeNS(const QString& nsURI, const QString& qName, const QString& newValue)
 {
     QString prefix, localName;
     qt_split_namespace(prefix, localName, qName, true);
@@ -3978,6 +3979,7 @@ void QDomElementPrivate::setAttributeNS(const QString& nsURI, const QString& qNa
         n->setNodeValue(newValue);
         n->prefix = prefix;
     }
+    return n;
 }
 
 void QDomElementPrivate::removeAttribute(const QString& aname)
@@ -345,7 +345,8 @@ public:
     QString attributeNS(const QString &nsURI, const QString &localName,
                         const QString &defValue) const;
     void setAttribute(const QString &name, const QString &value);
-    void setAttributeNS(const QString &nsURI, const QString &qName, const QString &newValue);
+    QDomNodePrivate *setAttributeNS(const QString &nsURI, const QString &qName,
+                                    const QString &newValue);
     void removeAttribute(const QString &name);
     QDomAttrPrivate *attributeNode(const QString &name);
     QDomAttrPrivate *attributeNodeNS(const QString &nsURI, const QString &localName);
@@ -94,6 +94,7 @@ bool QDomHandler::startElement(const QString &nsURI, const QString &, const QStr
     if (!n)
         return false;
 
+    shareNames(n);
     n->setLocation(locator->lineNumber(), locator->columnNumber());
 
     node->appendChild(n);
@@ -102,15 +103,50 @@ bool QDomHandler::startElement(const QString &nsURI, const QString &, const QStr
     // attributes
     for (int i = 0; i < atts.length(); i++) {
         if (nsProcessing) {
-            ((QDomElementPrivate *)node)->setAttributeNS(atts.uri(i), atts.qName(i), atts.value(i));
+            QDomElementPrivate *e = static_cast<QDomElementPrivate *>(node);
+            // the attribute splits the qualified name into new strings
+            shareNames(e->setAttributeNS(sharedString(atts.uri(i)), atts.qName(i),
+                                         sharedValue(atts.value(i))));
         } else {
-            ((QDomElementPrivate *)node)->setAttribute(atts.qName(i), atts.value(i));
+            ((QDomElementPrivate *)node)->setAttribute(sharedString(atts.qName(i)),
+                                                       sharedValue(atts.value(i)));
         }
     }
 
     return true;
 }
 
+/*
+    Element and attribute names and namespace URIs repeat all over a typical
+    document, and so do short values such as the indentation between
+    elements. Nodes created while parsing share one copy of each instead of
+    holding separate allocations.
+*/
+QString QDomHandler::sharedString(const QString &s)
+{
+    if (s.isEmpty())
+        return s;
+
+    auto it = stringPool.constFind(s);
+    if (it == stringPool.constEnd())
+        it = stringPool.insert(s);
+    return *it;
+}
+
+QString QDomHandler::sharedValue(const QString &s)
+{
+    // longer text is unlikely to repeat, don't grow the pool with it
+    enum { MaxSharedValueLength = 32 };
+    return s.size() > MaxSharedValueLength ? s : sharedString(s);
+}
+
+void QDomHandler::shareNames(QDomNodePrivate *n)
+{
+    n->name = sharedString(n->name);
+    n->prefix = sharedString(n->prefix);
+    n->namespaceURI = sharedString(n->namespaceURI);
+}
+
 bool QDomHandler::endElement(const QString &, const QString &, const QString &)
 {
     if (!node || node == doc)
@@ -139,6 +175,8 @@ bool QDomHandler::characters(const QString &ch)
         n.reset(doc->createEntityReference(entityName));
     } else {
         n.reset(doc->createTextNode(ch));
+        // checking the characters may have copied them, so share the result
+        n->value = sharedValue(n->value);
     }
     n->setLocation(locator->lineNumber(), locator->columnNumber());
     node->appendChild(n.data());
@@ -40,6 +40,7 @@
 #define QDOMHELPERS_P_H
 
 #include <qglobal.h>
+#include <qset.h>
 #include <qxml.h>
 
 QT_BEGIN_NAMESPACE
@@ -107,6 +108,10 @@ public:
     int errorColumn;
 
 private:
+    QString sharedString(const QString &s);
+    QString sharedValue(const QString &s);
+    void shareNames(QDomNodePrivate *n);
+
     QDomDocumentPrivate *doc;
     QDomNodePrivate *node;
     QString entityName;
@@ -114,6 +119,7 @@ private:
     bool nsProcessing;
     QXmlLocator *locator;
     QXmlSimpleReader *reader;
+    QSet<QString> stringPool;
 };
 
 QT_END_NAMESPACE
@@ -28,6 +28,9 @@
 
 #include <QCoreApplication>
 #include <QLoggingCategory>
+#include <QThread>
+
+#include <thread>
 
 #ifdef Q_CC_GNU
 #define NEVER_INLINE __attribute__((__noinline__))
@@ -40,6 +43,19 @@ struct T {
     ~T() { qDebug("static destructor"); }
 } t;
 
+struct LogOnThreadExit {
+    ~LogOnThreadExit() { qWarning("thread_local destructor"); }
+};
+
+static void logFromThread()
+{
+    // constructed before the first message, so destroyed after everything
+    // the logging code keeps per thread
+    static thread_local LogOnThreadExit logOnExit;
+    Q_UNUSED(logOnExit);
+    qWarning("from thread");
+}
+
 class MyClass : public QObject
 {
     Q_OBJECT
@@ -75,10 +91,28 @@ int main(int argc, char **argv)
     QLoggingCategory cat("category");
     qCWarning(cat) << "qDebug with category";
 
+    if (app.arguments().contains(QLatin1String("thread")))
+        std::thread(logFromThread).join();
+
+    if (app.arguments().contains(QLatin1String("fatal")))
+        qFatal("qFatal");
+
     qSetMessagePattern(QString());
 
     qDebug("qDebug2");
 
+    if (app.arguments().contains(QLatin1String("format"))) {
+        qDebug("format: %d %s %5.2f %*d %x %c %% %lld %s %-4u| %p %.3s %.*f", -42, "utf8 \xc3\xa4",
+               3.14159, 6, 7, 255u, 'z', -1234567890123LL, static_cast<const char *>(nullptr),
+               12u, reinterpret_cast<void *>(0x1234), "truncated", 2, 2.5);
+    }
+
+    if (app.arguments().contains(QLatin1String("abort"))) {
+        qDebug("before abort");
+        QThread::msleep(500);
+        abort();
+    }
+
     MyClass cl;
     QMetaObject::invokeMethod(&cl, "mySlot1");
 
@@ -14,7 +14,7 @@ debug_and_release {
     !android:!winrt: TEST_HELPER_INSTALLS = ../helper
 }
 
-QT = core testlib
+QT = core-private testlib
 SOURCES = ../tst_qlogging.cpp
 
 DEFINES += QT_MESSAGELOGCONTEXT
@@ -32,6 +32,8 @@
 #if QT_CONFIG(process)
 # include <QtCore/QProcess>
 #endif
+#include <QtCore/QTemporaryDir>
+#include <QtCore/private/qlogging_p.h>
 #include <QtTest/QTest>
 
 class tst_qmessagehandler : public QObject
@@ -61,6 +63,9 @@ private slots:
     void qMessagePattern_data();
     void qMessagePattern();
     void setMessagePattern();
+    void asyncOutput_data();
+    void asyncOutput();
+    void binaryLog();
 
     void formatLogMessage_data();
     void formatLogMessage();
@@ -715,16 +720,16 @@ void tst_qmessagehandler::qMessagePattern_data()
 
     // %{file} is tricky because of shadow builds
     QTest::newRow("basic") << "%{type} %{appname} %{line} %{function} %{message}" << true << (QList<QByteArray>()
-            << "debug  39 T::T static constructor"
+            << "debug  42 T::T static constructor"
             //  we can't be sure whether the QT_MESSAGE_PATTERN is already destructed
             << "static destructor"
-            << "debug tst_qlogging 60 MyClass::myFunction from_a_function 34"
-            << "debug tst_qlogging 70 main qDebug"
-            << "info tst_qlogging 71 main qInfo"
-            << "warning tst_qlogging 72 main qWarning"
-            << "critical tst_qlogging 73 main qCritical"
-            << "warning tst_qlogging 76 main qDebug with category"
-            << "debug tst_qlogging 80 main qDebug2");
+            << "debug tst_qlogging 76 MyClass::myFunction from_a_function 34"
+            << "debug tst_qlogging 86 main qDebug"
+            << "info tst_qlogging 87 main qInfo"
+            << "warning tst_qlogging 88 main qWarning"
+            << "critical tst_qlogging 89 main qCritical"
+            << "warning tst_qlogging 92 main qDebug with category"
+            << "debug tst_qlogging 102 main qDebug2");
 
 
     QTest::newRow("invalid") << "PREFIX: %{unknown} %{message}" << false << (QList<QByteArray>()
@@ -906,6 +911,160 @@ void tst_qmessagehandler::setMessagePattern()
 #endif // QT_CONFIG(process)
 }
 
+void tst_qmessagehandler::asyncOutput_data()
+{
+    QTest::addColumn<QString>("policy");
+    QTest::addColumn<QString>("mode");
+
+    QTest::newRow("block") << "block" << QString();
+    QTest::newRow("drop") << "drop" << QString();
+    QTest::newRow("block-fatal") << "block" << "fatal";
+    QTest::newRow("block-thread") << "block" << "thread";
+}
+
+void tst_qmessagehandler::asyncOutput()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#else
+#ifdef Q_OS_ANDROID
+    QSKIP("This test crashes on Android");
+#endif
+    QFETCH(QString, policy);
+    QFETCH(QString, mode);
+    const bool fatal = mode == QLatin1String("fatal");
+
+    QProcess process;
+    const QString appExe(QLatin1String("helper"));
+
+    QStringList environment;
+    environment.reserve(m_baseEnvironment.size() + 1);
+    std::copy_if(m_baseEnvironment.cbegin(), m_baseEnvironment.cend(),
+                 std::back_inserter(environment),
+                 [](const QString &str) { return !str.startsWith(QLatin1String("QT_MESSAGE_PATTERN")); });
+    environment.append(QLatin1String("QT_LOGGING_ASYNC=") + policy);
+    process.setEnvironment(environment);
+
+    process.start(appExe, mode.isEmpty() ? QStringList() : QStringList(mode));
+    QVERIFY2(process.waitForStarted(), qPrintable(
+        QString::fromLatin1("Could not start %1: %2").arg(appExe, process.errorString())));
+    process.waitForFinished();
+    QCOMPARE(process.exitStatus(), fatal ? QProcess::CrashExit : QProcess::NormalExit);
+
+    // everything queued before exit, or before qFatal aborts, is written
+    QByteArray output = process.readAllStandardError();
+    QByteArray expected = "static constructor\n"
+            "[debug] qDebug\n"
+            "[info] qInfo\n"
+            "[warning] qWarning\n"
+            "[critical] qCritical\n"
+            "[warning] qDebug with category\n";
+    // a thread_local destructor that logs after the thread's queue is gone
+    if (mode == QLatin1String("thread"))
+        expected += "[warning] from thread\n[warning] thread_local destructor\n";
+    if (fatal)
+        expected += "[fatal] qFatal\n";
+#ifdef Q_OS_WIN
+    output.replace("\r\n", "\n");
+#endif
+    QCOMPARE(QString::fromLatin1(output), QString::fromLatin1(expected));
+#endif // QT_CONFIG(process)
+}
+
+void tst_qmessagehandler::binaryLog()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#else
+#ifdef Q_OS_ANDROID
+    QSKIP("This test crashes on Android");
+#endif
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    const QString logFile = dir.filePath(QLatin1String("log.bin"));
+
+    QProcess process;
+    const QString appExe(QLatin1String("helper"));
+
+    QStringList environment = m_baseEnvironment;
+    environment.append(QLatin1String("QT_LOGGING_BINARY=") + logFile);
+    process.setEnvironment(environment);
+
+    process.start(appExe, QStringList() << QLatin1String("format"));
+    QVERIFY2(process.waitForStarted(), qPrintable(
+        QString::fromLatin1("Could not start %1: %2").arg(appExe, process.errorString())));
+    const qint64 pid = process.processId();
+    process.waitForFinished();
+    QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+
+    // the messages went to the file, not to stderr
+    QVERIFY(!process.readAllStandardError().contains("qDebug"));
+
+    QFile file(logFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QBinaryLogReader reader(file.readAll());
+    QVERIFY(reader.isValid());
+
+    // the pattern is applied when decoding
+    qSetMessagePattern(QLatin1String("[%{type}] %{if-category}%{category}: %{endif}%{message}"));
+    QStringList messages;
+    while (reader.readNext()) {
+        messages << reader.formattedMessage();
+        QCOMPARE(reader.origin().pid, pid);
+        QVERIFY(reader.origin().threadId != 0);
+        if (reader.message() == QLatin1String("qInfo")) {
+            QVERIFY(QByteArray(reader.context().file).endsWith("main.cpp"));
+            QVERIFY(reader.context().line > 0);
+            QVERIFY(QByteArray(reader.context().function).contains("main"));
+        }
+    }
+    qSetMessagePattern(QString());
+
+    const QStringList expected = {
+        QLatin1String("[debug] static constructor"),
+        QLatin1String("[debug] qDebug"),
+        QLatin1String("[info] qInfo"),
+        QLatin1String("[warning] qWarning"),
+        QLatin1String("[critical] qCritical"),
+        QLatin1String("[warning] category: qDebug with category"),
+        QLatin1String("[debug] qDebug2"),
+        // printf-style messages are formatted when decoding, as they would have been
+        QLatin1String("[debug] ") + QString::asprintf(
+                "format: %d %s %5.2f %*d %x %c %% %lld %s %-4u| %p %.3s %.*f", -42, "utf8 \xc3\xa4",
+                3.14159, 6, 7, 255u, 'z', -1234567890123LL, static_cast<const char *>(nullptr),
+                12u, reinterpret_cast<void *>(0x1234), "truncated", 2, 2.5),
+        QLatin1String("[debug] from_a_function 34"),
+        QLatin1String("[debug] static destructor")
+    };
+    QCOMPARE(messages, expected);
+
+    // a record cut short by a killed process ends the log without error
+    file.seek(0);
+    QByteArray truncated = file.readAll();
+    truncated.chop(3);
+    QBinaryLogReader truncatedReader(truncated);
+    int count = 0;
+    while (truncatedReader.readNext())
+        ++count;
+    QCOMPARE(count, expected.size() - 1);
+
+    // messages reach the file even if the process doesn't exit normally
+    file.close();
+    QFile::remove(logFile);
+    process.start(appExe, QStringList() << QLatin1String("abort"));
+    QVERIFY(process.waitForFinished());
+    QCOMPARE(process.exitStatus(), QProcess::CrashExit);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QBinaryLogReader abortedReader(file.readAll());
+    file.close();
+    QStringList abortedMessages;
+    while (abortedReader.readNext())
+        abortedMessages << abortedReader.message();
+    QVERIFY2(abortedMessages.contains(QLatin1String("before abort")),
+             qPrintable(abortedMessages.join(QLatin1Char('\n'))));
+#endif // QT_CONFIG(process)
+}
+
 Q_DECLARE_METATYPE(QtMsgType)
 
 void tst_qmessagehandler::formatLogMessage_data()
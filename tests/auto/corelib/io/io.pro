@@ -2,6 +2,7 @@ TEMPLATE=subdirs
 SUBDIRS=\
     qabstractfileengine \
     qbuffer \
+    qcompressingdevice \
     qdataurl \
     qdebug \
     qdir \
@@ -21,6 +22,7 @@ SUBDIRS=\
     qnodebug \
     qprocess \
     qprocess-noapplication \
+    qprocesspool \
     qprocessenvironment \
     qresourceengine \
     qsettings \
@@ -63,7 +65,8 @@ win32:!qtConfig(private_tests): SUBDIRS -= \
 
 !qtConfig(process): SUBDIRS -= \
     qprocess \
-    qprocess-noapplication
+    qprocess-noapplication \
+    qprocesspool
 
 !qtConfig(settings): SUBDIRS -= \
     qsettings
@@ -73,5 +76,6 @@ winrt: SUBDIRS -= \
 
 android: SUBDIRS -= \
     qprocess \
+    qprocesspool \
     qdir \
     qresourceengine
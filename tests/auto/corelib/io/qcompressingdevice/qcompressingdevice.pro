@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qcompressingdevice
+QT = core testlib
+SOURCES = tst_qcompressingdevice.cpp
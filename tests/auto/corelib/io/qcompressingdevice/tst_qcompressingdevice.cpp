@@ -0,0 +1,546 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/QBuffer>
+#include <QtCore/QCompressingDevice>
+#include <QtCore/QCompression>
+
+Q_DECLARE_METATYPE(QCompression::Algorithm)
+
+// A sequential device whose data arrives piecemeal, like a socket's
+class TrickleDevice : public QIODevice
+{
+public:
+    bool isSequential() const override { return true; }
+    void append(const QByteArray &data)
+    {
+        pending += data;
+        emit readyRead();
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override
+    {
+        const qint64 n = qMin<qint64>(maxlen, pending.size());
+        memcpy(data, pending.constData(), size_t(n));
+        pending.remove(0, int(n));
+        return n;
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    QByteArray pending;
+};
+
+class tst_QCompressingDevice : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip_data();
+    void roundTrip();
+    void levels_data();
+    void levels();
+    void dictionary_data();
+    void dictionary();
+    void zlibDictionaryRequired();
+    void corruptData_data();
+    void corruptData();
+    void unavailableAlgorithm();
+    void deviceRoundTrip_data();
+    void deviceRoundTrip();
+    void deviceReadLine_data();
+    void deviceReadLine();
+    void deviceFlush_data();
+    void deviceFlush();
+    void deviceTruncated_data();
+    void deviceTruncated();
+    void deviceTrailingData_data();
+    void deviceTrailingData();
+    void deviceSequentialSource_data();
+    void deviceSequentialSource();
+    void deviceOpenModes();
+
+private:
+    void addAlgorithmColumn();
+};
+
+static QByteArray textData(int size)
+{
+    static const char words[] = "the quick brown fox jumps over the lazy dog 0123456789\n";
+    QByteArray data;
+    data.reserve(size);
+    for (int i = 0; data.size() < size; ++i) {
+        data.append(words + (i * 7) % (sizeof(words) - 1));
+        data.append(QByteArray::number(i));
+    }
+    data.truncate(size);
+    return data;
+}
+
+static QByteArray noiseData(int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    quint32 x = 2463534242u;
+    for (char &c : data) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        c = char(x);
+    }
+    return data;
+}
+
+static const char *algorithmName(QCompression::Algorithm algorithm)
+{
+    switch (algorithm) {
+    case QCompression::Zlib:
+        return "zlib";
+    case QCompression::Zstd:
+        return "zstd";
+    case QCompression::Lz4:
+        return "lz4";
+    }
+    return "unknown";
+}
+
+static const QCompression::Algorithm allAlgorithms[] = {
+    QCompression::Zlib, QCompression::Zstd, QCompression::Lz4
+};
+
+#define SKIP_IF_UNAVAILABLE(algorithm) \
+    if (!QCompression::isAvailable(algorithm)) \
+        QSKIP("This algorithm is not available in this build")
+
+void tst_QCompressingDevice::addAlgorithmColumn()
+{
+    QTest::addColumn<QCompression::Algorithm>("algorithm");
+    QTest::addColumn<QByteArray>("data");
+}
+
+void tst_QCompressingDevice::roundTrip_data()
+{
+    addAlgorithmColumn();
+    for (QCompression::Algorithm algorithm : allAlgorithms) {
+        const char *name = algorithmName(algorithm);
+        QTest::addRow("%s-empty", name) << algorithm << QByteArray();
+        QTest::addRow("%s-one", name) << algorithm << QByteArray("x");
+        QTest::addRow("%s-text", name) << algorithm << textData(10000);
+        QTest::addRow("%s-noise", name) << algorithm << noiseData(100000);
+        QTest::addRow("%s-large", name) << algorithm << textData(3 * 1024 * 1024 + 17);
+    }
+}
+
+void tst_QCompressingDevice::roundTrip()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    QFETCH(QByteArray, data);
+    SKIP_IF_UNAVAILABLE(algorithm);
+
+    bool ok = false;
+    const QByteArray compressed = QCompression::compress(data, algorithm, -1, QByteArray(), &ok);
+    QVERIFY(ok);
+    QVERIFY(!compressed.isEmpty());
+    if (data.size() >= 10000 && !QByteArray(QTest::currentDataTag()).endsWith("noise"))
+        QVERIFY(compressed.size() < data.size() / 2);
+    // an empty result is only an error if ok says so
+    ok = false;
+    QCOMPARE(QCompression::decompress(compressed, algorithm, QByteArray(), &ok), data);
+    QVERIFY(ok);
+}
+
+void tst_QCompressingDevice::levels_data()
+{
+    QTest::addColumn<QCompression::Algorithm>("algorithm");
+    QTest::addColumn<int>("level");
+    for (QCompression::Algorithm algorithm : allAlgorithms) {
+        for (int level : {-1, 0, 1, 5, 9, 12, 22, 100})
+            QTest::addRow("%s-%d", algorithmName(algorithm), level) << algorithm << level;
+    }
+}
+
+void tst_QCompressingDevice::levels()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    QFETCH(int, level);
+    SKIP_IF_UNAVAILABLE(algorithm);
+
+    // out-of-range levels are clamped or replaced by the default
+    const QByteArray data = textData(200000);
+    const QByteArray compressed = QCompression::compress(data, algorithm, level);
+    QVERIFY(!compressed.isEmpty());
+    QCOMPARE(QCompression::decompress(compressed, algorithm), data);
+}
+
+void tst_QCompressingDevice::dictionary_data()
+{
+    QTest::addColumn<QCompression::Algorithm>("algorithm");
+    for (QCompression::Algorithm algorithm : allAlgorithms)
+        QTest::newRow(algorithmName(algorithm)) << algorithm;
+}
+
+void tst_QCompressingDevice::dictionary()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    SKIP_IF_UNAVAILABLE(algorithm);
+
+    const QByteArray dictionary = "{\"id\": 0, \"name\": \"\", \"email\": \"@example.com\", "
+                                  "\"roles\": [\"reader\", \"writer\"], \"active\": true}";
+    const QByteArray message = "{\"id\": 4711, \"name\": \"Jane\", \"email\": \"jane@example.com\", "
+                               "\"roles\": [\"reader\"], \"active\": false}";
+
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    QCompressingDevice compressor(&buffer, algorithm);
+    compressor.setDictionary(dictionary);
+    QCOMPARE(compressor.dictionary(), dictionary);
+    if (!compressor.open(QIODevice::WriteOnly)) {
+        // older LZ4 libraries have no stable dictionary API
+        QSKIP(qPrintable(compressor.errorString()));
+    }
+    QCOMPARE(compressor.write(message), qint64(message.size()));
+    compressor.close();
+
+    buffer.seek(0);
+    QDecompressingDevice decompressor(&buffer, algorithm);
+    decompressor.setDictionary(dictionary);
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+    QCOMPARE(decompressor.readAll(), message);
+    QVERIFY(decompressor.atEnd());
+
+    const QByteArray plain = QCompression::compress(message, algorithm);
+    const QByteArray primed = QCompression::compress(message, algorithm, -1, dictionary);
+    QVERIFY(primed.size() < plain.size());
+    QCOMPARE(QCompression::decompress(primed, algorithm, dictionary), message);
+}
+
+void tst_QCompressingDevice::zlibDictionaryRequired()
+{
+    const QByteArray dictionary = textData(1000);
+    const QByteArray compressed = QCompression::compress(textData(5000), QCompression::Zlib, -1,
+                                                         dictionary);
+    QTest::ignoreMessage(QtWarningMsg, "QCompression::decompress: "
+                                       "A dictionary is required to decompress the data");
+    bool ok = true;
+    QVERIFY(QCompression::decompress(compressed, QCompression::Zlib, QByteArray(), &ok).isEmpty());
+    QVERIFY(!ok);
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("^QCompression::decompress: "));
+    ok = true;
+    QVERIFY(QCompression::decompress(compressed, QCompression::Zlib, textData(999), &ok).isEmpty());
+    QVERIFY(!ok);
+}
+
+void tst_QCompressingDevice::corruptData_data()
+{
+    QTest::addColumn<QCompression::Algorithm>("algorithm");
+    QTest::addColumn<QByteArray>("data");
+    for (QCompression::Algorithm algorithm : allAlgorithms) {
+        if (!QCompression::isAvailable(algorithm))
+            continue;
+        const char *name = algorithmName(algorithm);
+        const QByteArray compressed = QCompression::compress(textData(50000), algorithm);
+        QTest::addRow("%s-empty", name) << algorithm << QByteArray();
+        QTest::addRow("%s-garbage", name) << algorithm << noiseData(1000);
+        QTest::addRow("%s-truncated", name) << algorithm << compressed.left(compressed.size() - 5);
+        QByteArray flipped = compressed;
+        flipped[flipped.size() / 2] = char(flipped.at(flipped.size() / 2) ^ 0x55);
+        QTest::addRow("%s-flipped", name) << algorithm << flipped;
+    }
+}
+
+void tst_QCompressingDevice::corruptData()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    QFETCH(QByteArray, data);
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("^QCompression::decompress: "));
+    bool ok = true;
+    QVERIFY(QCompression::decompress(data, algorithm, QByteArray(), &ok).isEmpty());
+    QVERIFY(!ok);
+}
+
+void tst_QCompressingDevice::unavailableAlgorithm()
+{
+    for (QCompression::Algorithm algorithm : allAlgorithms) {
+        if (QCompression::isAvailable(algorithm))
+            continue;
+        QTest::ignoreMessage(QtWarningMsg, "QCompression::compress: "
+                                           "The compression algorithm is not available");
+        bool ok = true;
+        QVERIFY(QCompression::compress("data", algorithm, -1, QByteArray(), &ok).isEmpty());
+        QVERIFY(!ok);
+
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QCompressingDevice compressor(&buffer, algorithm);
+        QVERIFY(!compressor.open(QIODevice::WriteOnly));
+        QCOMPARE(compressor.errorString(), QString("The compression algorithm is not available"));
+    }
+    QVERIFY(QCompression::isAvailable(QCompression::Zlib));
+}
+
+void tst_QCompressingDevice::deviceRoundTrip_data()
+{
+    addAlgorithmColumn();
+    QTest::addColumn<int>("chunkSize");
+    for (QCompression::Algorithm algorithm : allAlgorithms) {
+        const char *name = algorithmName(algorithm);
+        QTest::addRow("%s-empty", name) << algorithm << QByteArray() << 1;
+        QTest::addRow("%s-text-1", name) << algorithm << textData(5000) << 1;
+        QTest::addRow("%s-text-1000", name) << algorithm << textData(300000) << 1000;
+        QTest::addRow("%s-noise-65537", name) << algorithm << noiseData(300000) << 65537;
+        QTest::addRow("%s-large-1M", name) << algorithm << textData(5 * 1024 * 1024) << 1024 * 1024;
+    }
+}
+
+void tst_QCompressingDevice::deviceRoundTrip()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    QFETCH(QByteArray, data);
+    QFETCH(int, chunkSize);
+    SKIP_IF_UNAVAILABLE(algorithm);
+
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    {
+        QCompressingDevice compressor(&buffer, algorithm);
+        QCOMPARE(compressor.device(), &buffer);
+        QCOMPARE(compressor.algorithm(), algorithm);
+        QVERIFY(compressor.open(QIODevice::WriteOnly));
+        QVERIFY(compressor.isSequential());
+        for (int i = 0; i < data.size(); i += chunkSize) {
+            const int n = qMin(chunkSize, data.size() - i);
+            QCOMPARE(compressor.write(data.constData() + i, n), qint64(n));
+        }
+        // the destructor ends the stream
+    }
+    QVERIFY(!buffer.data().isEmpty());
+    QCOMPARE(QCompression::decompress(buffer.data(), algorithm), data);
+
+    buffer.seek(0);
+    QDecompressingDevice decompressor(&buffer, algorithm);
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+    QByteArray result;
+    QByteArray chunk(chunkSize, Qt::Uninitialized);
+    while (!decompressor.atEnd()) {
+        const qint64 n = decompressor.read(chunk.data(), chunk.size());
+        QVERIFY2(n >= 0, qPrintable(decompressor.errorString()));
+        result.append(chunk.constData(), int(n));
+    }
+    QCOMPARE(result.size(), data.size());
+    QCOMPARE(result, data);
+    QCOMPARE(decompressor.read(chunk.data(), chunk.size()), qint64(0));
+    QCOMPARE(buffer.pos(), buffer.size());
+}
+
+void tst_QCompressingDevice::deviceReadLine_data()
+{
+    dictionary_data();
+}
+
+void tst_QCompressingDevice::deviceReadLine()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    SKIP_IF_UNAVAILABLE(algorithm);
+
+    const QByteArray data = textData(100000);
+    QByteArray compressed = QCompression::compress(data, algorithm);
+    QBuffer buffer(&compressed);
+    buffer.open(QIODevice::ReadOnly);
+
+    QDecompressingDevice decompressor(&buffer, algorithm);
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+    QByteArray result;
+    int lines = 0;
+    while (!decompressor.atEnd()) {
+        const QByteArray line = decompressor.readLine();
+        QVERIFY(line.endsWith('\n') || decompressor.atEnd());
+        result += line;
+        ++lines;
+    }
+    QCOMPARE(result, data);
+    QCOMPARE(lines, data.count('\n') + (data.endsWith('\n') ? 0 : 1));
+}
+
+void tst_QCompressingDevice::deviceFlush_data()
+{
+    dictionary_data();
+}
+
+void tst_QCompressingDevice::deviceFlush()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    SKIP_IF_UNAVAILABLE(algorithm);
+
+    const QByteArray first = textData(3000);
+    const QByteArray second = noiseData(3000);
+
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    QCompressingDevice compressor(&buffer, algorithm);
+    QVERIFY(compressor.open(QIODevice::WriteOnly));
+    QCOMPARE(compressor.write(first), qint64(first.size()));
+    QVERIFY(compressor.flush());
+
+    // everything written so far can be decoded, even though the stream has not ended
+    TrickleDevice source;
+    source.open(QIODevice::ReadOnly);
+    source.append(buffer.data());
+    QDecompressingDevice decompressor(&source, algorithm);
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+    QCOMPARE(decompressor.read(first.size() + 1), first);
+    QVERIFY(!decompressor.atEnd());
+
+    const qint64 flushedSize = buffer.size();
+    QCOMPARE(compressor.write(second), qint64(second.size()));
+    compressor.close();
+    QVERIFY(!compressor.isOpen());
+    QVERIFY(!compressor.flush());
+    source.append(buffer.data().mid(int(flushedSize)));
+    QCOMPARE(decompressor.readAll(), second);
+    QVERIFY(decompressor.atEnd());
+}
+
+void tst_QCompressingDevice::deviceTruncated_data()
+{
+    dictionary_data();
+}
+
+void tst_QCompressingDevice::deviceTruncated()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    SKIP_IF_UNAVAILABLE(algorithm);
+
+    const QByteArray data = textData(200000);
+    QByteArray compressed = QCompression::compress(data, algorithm);
+    compressed.chop(compressed.size() / 2);
+    QBuffer buffer(&compressed);
+    buffer.open(QIODevice::ReadOnly);
+
+    QDecompressingDevice decompressor(&buffer, algorithm);
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+    const QByteArray result = decompressor.readAll();
+    QVERIFY(result.size() < data.size());
+    QVERIFY(data.startsWith(result));
+    QVERIFY(decompressor.atEnd());
+    QCOMPARE(decompressor.errorString(), QString("Unexpected end of compressed data"));
+    QCOMPARE(decompressor.read(1), QByteArray());
+}
+
+void tst_QCompressingDevice::deviceTrailingData_data()
+{
+    dictionary_data();
+}
+
+void tst_QCompressingDevice::deviceTrailingData()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    SKIP_IF_UNAVAILABLE(algorithm);
+
+    const QByteArray data = textData(50000);
+    QByteArray file = QCompression::compress(data, algorithm) + "TRAILER";
+    QBuffer buffer(&file);
+    buffer.open(QIODevice::ReadOnly);
+
+    QDecompressingDevice decompressor(&buffer, algorithm);
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+    QCOMPARE(decompressor.readAll(), data);
+    QVERIFY(decompressor.atEnd());
+    decompressor.close();
+    QCOMPARE(buffer.readAll(), QByteArray("TRAILER"));
+}
+
+void tst_QCompressingDevice::deviceSequentialSource_data()
+{
+    dictionary_data();
+}
+
+void tst_QCompressingDevice::deviceSequentialSource()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    SKIP_IF_UNAVAILABLE(algorithm);
+
+    const QByteArray data = textData(100000);
+    const QByteArray compressed = QCompression::compress(data, algorithm);
+    TrickleDevice source;
+    source.open(QIODevice::ReadOnly);
+
+    QDecompressingDevice decompressor(&source, algorithm);
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+    QSignalSpy readyReadSpy(&decompressor, &QIODevice::readyRead);
+    QByteArray result;
+    const int pieceSize = compressed.size() / 3 + 1;
+    for (int i = 0; i < compressed.size(); i += pieceSize) {
+        QVERIFY(!decompressor.atEnd());
+        source.append(compressed.mid(i, pieceSize));
+        result += decompressor.readAll();
+    }
+    QCOMPARE(readyReadSpy.count(), 3);
+    QVERIFY(decompressor.atEnd());
+    QCOMPARE(result, data);
+}
+
+void tst_QCompressingDevice::deviceOpenModes()
+{
+    QBuffer buffer;
+    QCompressingDevice compressor(&buffer);
+    QDecompressingDevice decompressor(&buffer);
+
+    QTest::ignoreMessage(QtWarningMsg, "QCompressingDevice::open: "
+                                       "The underlying device is not open for writing");
+    QVERIFY(!compressor.open(QIODevice::WriteOnly));
+    QTest::ignoreMessage(QtWarningMsg, "QDecompressingDevice::open: "
+                                       "The underlying device is not open for reading");
+    QVERIFY(!decompressor.open(QIODevice::ReadOnly));
+
+    buffer.open(QIODevice::ReadWrite);
+    QTest::ignoreMessage(QtWarningMsg, "QCompressingDevice::open: Only WriteOnly is supported");
+    QVERIFY(!compressor.open(QIODevice::ReadWrite));
+    QTest::ignoreMessage(QtWarningMsg, "QDecompressingDevice::open: Only ReadOnly is supported");
+    QVERIFY(!decompressor.open(QIODevice::WriteOnly));
+
+    QVERIFY(compressor.open(QIODevice::WriteOnly));
+    QTest::ignoreMessage(QtWarningMsg, "QCompressingDevice::open: Device already open");
+    QVERIFY(!compressor.open(QIODevice::WriteOnly));
+    QTest::ignoreMessage(QtWarningMsg, "QIODevice::read (QCompressingDevice): WriteOnly device");
+    QCOMPARE(compressor.read(1), QByteArray());
+    compressor.close();
+
+    buffer.seek(0);
+    QVERIFY(decompressor.open(QIODevice::ReadOnly));
+    QTest::ignoreMessage(QtWarningMsg, "QIODevice::write (QDecompressingDevice): ReadOnly device");
+    QCOMPARE(decompressor.write("x"), qint64(-1));
+    QCOMPARE(decompressor.readAll(), QByteArray());
+    QVERIFY(decompressor.atEnd());
+}
+
+QTEST_MAIN(tst_QCompressingDevice)
+#include "tst_qcompressingdevice.moc"
@@ -92,6 +92,10 @@ private slots:
     void cleanupTestCase();
     void iterateRelativeDirectory_data();
     void iterateRelativeDirectory();
+#if QT_CONFIG(thread)
+    void forEachEntry_data() { iterateRelativeDirectory_data(); }
+    void forEachEntry();
+#endif
     void iterateResource_data();
     void iterateResource();
     void stopLinkLoop();
@@ -391,6 +395,36 @@ void tst_QDirIterator::iterateRelativeDirectory()
     QCOMPARE(list, sortedEntries);
 }
 
+#if QT_CONFIG(thread)
+void tst_QDirIterator::forEachEntry()
+{
+    QFETCH(QString, dirName);
+    QFETCH(QDirIterator::IteratorFlags, flags);
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QStringList, nameFilters);
+    QFETCH(QStringList, entries);
+
+    QMutex mutex;
+    QStringList list;
+    QDirIterator::forEachEntry(dirName, nameFilters, filters, flags,
+                               [&](const QFileInfo &info) {
+        const QString canonicalFilePath = info.canonicalFilePath();
+        QMutexLocker locker(&mutex);
+        list << canonicalFilePath;
+    });
+
+    // The order of items returned by a parallel walk is not guaranteed.
+    list.sort();
+
+    QStringList sortedEntries;
+    for (const QString &item : qAsConst(entries))
+        sortedEntries.append(QFileInfo(item).canonicalFilePath());
+    sortedEntries.sort();
+
+    QCOMPARE(list, sortedEntries);
+}
+#endif
+
 void tst_QDirIterator::iterateResource_data()
 {
     QTest::addColumn<QString>("dirName"); // relative from current path or abs
@@ -36,6 +36,10 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QTemporaryDir>
+#if QT_CONFIG(future)
+# include <QFutureWatcher>
+# include <QSignalSpy>
+#endif
 
 #include <private/qabstractfileengine_p.h>
 #include <private/qfsfileengine_p.h>
@@ -189,6 +193,7 @@ private slots:
     void copyRemovesTemporaryFile() const;
     void copyShouldntOverwrite();
     void copyFallback();
+    void copyLargeFile();
 #ifndef Q_OS_WINRT
     void link();
     void linkToDir();
@@ -279,6 +284,10 @@ private slots:
 
     void reuseQFile();
 
+#if QT_CONFIG(future)
+    void readWriteAsync();
+#endif
+
 private:
 #ifdef BUILTIN_TESTDATA
     QSharedPointer<QTemporaryDir> m_dataDir;
@@ -1487,6 +1496,40 @@ void tst_QFile::copyFallback()
             QFile::ReadOwner | QFile::WriteOwner);
 }
 
+void tst_QFile::copyLargeFile()
+{
+    // QTemporaryDir is current dir, no need to remove these files
+    QByteArray data(3 * 64 * 1024 + 123, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i % 253);
+    {
+        QFile source("large-copy-source");
+        QVERIFY2(source.open(QIODevice::WriteOnly), msgOpenFailed(source).constData());
+        QCOMPARE(source.write(data), qint64(data.size()));
+    }
+
+    QVERIFY(QFile::copy("large-copy-source", "large-copy-destination"));
+    QFile destination("large-copy-destination");
+    QVERIFY2(destination.open(QIODevice::ReadOnly), msgOpenFailed(destination).constData());
+    QCOMPARE(destination.readAll(), data);
+    destination.close();
+
+    // the same through the buffered fallback
+    QFile resource(":/copy-fallback.qrc");
+    QVERIFY(resource.copy("resource-copy-destination"));
+    QFile resourceCopy("resource-copy-destination");
+    QVERIFY2(resourceCopy.open(QIODevice::ReadOnly), msgOpenFailed(resourceCopy).constData());
+    QVERIFY2(resource.open(QIODevice::ReadOnly), msgOpenFailed(resource).constData());
+    QCOMPARE(resourceCopy.readAll(), resource.readAll());
+
+#ifdef Q_OS_LINUX
+    // Files in /proc report a size of zero, but do have contents; in-kernel
+    // copies must not produce an empty file for them.
+    QVERIFY(QFile::copy("/proc/self/status", "proc-copy-destination"));
+    QVERIFY(QFileInfo("proc-copy-destination").size() > 0);
+#endif
+}
+
 #ifdef Q_OS_WIN
 #include <objbase.h>
 #include <shlobj.h>
@@ -3672,5 +3715,72 @@ void tst_QFile::reuseQFile()
     }
 }
 
+#if QT_CONFIG(future)
+void tst_QFile::readWriteAsync()
+{
+    // QTemporaryDir is current dir, no need to remove this file
+    QFile file("asyncfile");
+    QByteArray data(64 * 1024, 'a');
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i % 251);
+
+    QFuture<qint64> written = file.writeAsync(0, data);
+    written.waitForFinished();
+    QCOMPARE(written.result(), qint64(data.size()));
+    QVERIFY(!file.isOpen());
+
+    // overwrite part of it; the rest of the file must be kept
+    written = QFile::writeAsync(file.fileName(), 100, QByteArray(10, 'x'));
+    written.waitForFinished();
+    QCOMPARE(written.result(), qint64(10));
+    data.replace(100, 10, QByteArray(10, 'x'));
+    QCOMPARE(file.size(), qint64(data.size()));
+
+    QFuture<QByteArray> read = file.readAsync(0, data.size());
+    read.waitForFinished();
+    QCOMPARE(read.result(), data);
+
+    // asking for more than there is only returns what there is
+    read = file.readAsync(data.size() - 10, std::numeric_limits<int>::max());
+    read.waitForFinished();
+    QCOMPARE(read.result(), data.right(10));
+
+    // reads do not touch the position of an open QFile
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QVERIFY(file.seek(1000));
+    read = file.readAsync(90, 30);
+    read.waitForFinished();
+    QCOMPARE(read.result(), data.mid(90, 30));
+    QCOMPARE(file.pos(), qint64(1000));
+    file.close();
+
+    // reading past the end succeeds with no data; errors give a null array
+    read = file.readAsync(data.size() + 10, 10);
+    read.waitForFinished();
+    QVERIFY(!read.result().isNull());
+    QVERIFY(read.result().isEmpty());
+    read = QFile::readAsync("nonexistent-file", 0, 10);
+    read.waitForFinished();
+    QVERIFY(read.result().isNull());
+    read = QFile::readAsync(QDir::currentPath(), 0, 10);
+    read.waitForFinished();
+    QVERIFY(read.result().isNull());
+
+#ifdef Q_OS_LINUX
+    // files reporting a size of zero are read until their end
+    read = QFile::readAsync("/proc/self/status", 0, 1024 * 1024);
+    read.waitForFinished();
+    QVERIFY(read.result().startsWith("Name:"));
+#endif
+
+    // completion is delivered through the event loop
+    QFutureWatcher<QByteArray> watcher;
+    QSignalSpy spy(&watcher, &QFutureWatcher<QByteArray>::finished);
+    watcher.setFuture(file.readAsync(0, 10));
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(watcher.result(), data.left(10));
+}
+#endif
+
 QTEST_MAIN(tst_QFile)
 #include "tst_qfile.moc"
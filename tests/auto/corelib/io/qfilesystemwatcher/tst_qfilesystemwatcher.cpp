@@ -80,6 +80,11 @@ private slots:
 
     void watchUnicodeCharacters();
 
+    void watchDirectoryTree();
+    void addedDirectoryInTree();
+    void directoryTreeEventsLost();
+    void coalesceChanges();
+
 private:
     QString m_tempDirPattern;
 };
@@ -813,5 +818,197 @@ void tst_QFileSystemWatcher::watchUnicodeCharacters()
     QTRY_COMPARE(changedSpy.count(), 1);
 }
 
+void tst_QFileSystemWatcher::watchDirectoryTree()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+
+    const QString root = temporaryDirectory.path();
+    QDir rootDir(root);
+    QVERIFY(rootDir.mkpath("a/b"));
+
+    QFileSystemWatcher watcher;
+    QVERIFY(watcher.addDirectoryTree(root));
+    QVERIFY(!watcher.addDirectoryTree(root));
+    QCOMPARE(watcher.directoryTrees(), QStringList(root));
+    QVERIFY(watcher.directories().isEmpty());
+
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::directoryChanged);
+    QVERIFY(changedSpy.isValid());
+    const auto changed = [&changedSpy](const QString &path) {
+        for (const QList<QVariant> &arguments : qAsConst(changedSpy)) {
+            if (arguments.at(0).toString() == path)
+                return true;
+        }
+        return false;
+    };
+
+    // a directory deep in the tree
+    QFile file(root + "/a/b/file.txt");
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+    QTRY_VERIFY(changed(root + "/a/b"));
+
+    // a directory created after the tree was added
+    QVERIFY(rootDir.mkpath("a/new"));
+    QTRY_VERIFY(changed(root + "/a"));
+    changedSpy.clear();
+    QFile newFile(root + "/a/new/file.txt");
+    QVERIFY(newFile.open(QIODevice::WriteOnly));
+    newFile.close();
+    QTRY_VERIFY(changed(root + "/a/new"));
+
+#ifdef Q_OS_LINUX
+    // writing to a file is reported for the file, not its directory
+    QSignalSpy fileSpy(&watcher, &QFileSystemWatcher::fileChanged);
+    QVERIFY(fileSpy.isValid());
+    changedSpy.clear();
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Append));
+    QCOMPARE(file.write("data"), qint64(4));
+    file.close();
+    const auto fileChanged = [&fileSpy](const QString &path) {
+        for (const QList<QVariant> &arguments : qAsConst(fileSpy)) {
+            if (arguments.at(0).toString() == path)
+                return true;
+        }
+        return false;
+    };
+    QTRY_VERIFY(fileChanged(root + "/a/b/file.txt"));
+    QVERIFY(!changed(root + "/a/b"));
+#endif
+
+    // nothing is reported after the tree was removed
+    QVERIFY(watcher.removeDirectoryTree(root));
+    QVERIFY(!watcher.removeDirectoryTree(root));
+    QVERIFY(watcher.directoryTrees().isEmpty());
+    changedSpy.clear();
+    QVERIFY(QFile::remove(root + "/a/b/file.txt"));
+    QTest::qWait(500);
+    QCOMPARE(changedSpy.count(), 0);
+}
+
+void tst_QFileSystemWatcher::addedDirectoryInTree()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+
+    const QString root = temporaryDirectory.path();
+    const QString added = root + "/a";
+    QVERIFY(QDir(root).mkdir("a"));
+
+    QFileSystemWatcher watcher;
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::directoryChanged);
+    QVERIFY(changedSpy.isValid());
+
+    // removing the tree keeps the directory that was added on its own
+    QVERIFY(watcher.addPath(added));
+    QVERIFY(watcher.addDirectoryTree(root));
+    QCOMPARE(watcher.directories(), QStringList(added));
+    QVERIFY(watcher.removeDirectoryTree(root));
+    QCOMPARE(watcher.directories(), QStringList(added));
+    QVERIFY(QDir(added).mkdir("first"));
+    QTRY_COMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.first().at(0).toString(), added);
+
+    // removing the directory keeps the tree watching it
+    QVERIFY(watcher.addDirectoryTree(root));
+    QVERIFY(watcher.removePath(added));
+    QVERIFY(watcher.directories().isEmpty());
+    QVERIFY(watcher.addPath(added));
+    QVERIFY(watcher.removePath(added));
+    changedSpy.clear();
+    QVERIFY(QDir(added).mkdir("second"));
+    QTRY_VERIFY(!changedSpy.isEmpty());
+    QCOMPARE(changedSpy.first().at(0).toString(), added);
+}
+
+void tst_QFileSystemWatcher::directoryTreeEventsLost()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+
+    const QString root = temporaryDirectory.path();
+    QFileSystemWatcher watcher;
+    QVERIFY(watcher.addDirectoryTree(root));
+
+    QObject *engine = nullptr;
+    for (QObject *child : watcher.children()) {
+        if (child->metaObject()->indexOfSignal("eventsLost()") >= 0)
+            engine = child;
+    }
+    if (!engine)
+        QSKIP("No native file system watcher engine");
+
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::directoryChanged);
+    QVERIFY(changedSpy.isValid());
+    const auto changed = [&changedSpy](const QString &path) {
+        for (const QList<QVariant> &arguments : qAsConst(changedSpy)) {
+            if (arguments.at(0).toString() == path)
+                return true;
+        }
+        return false;
+    };
+
+    // pretend the notifications for the new directories were dropped,
+    // as when the queue of the engine overflows
+    QVERIFY(QDir(root).mkpath("x/y"));
+    QVERIFY(QMetaObject::invokeMethod(engine, "eventsLost"));
+    QVERIFY(changed(root));
+
+    // the rescan watches the directories that were missed
+    changedSpy.clear();
+    QFile file(root + "/x/y/file.txt");
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+    QTRY_VERIFY(changed(root + "/x/y"));
+}
+
+void tst_QFileSystemWatcher::coalesceChanges()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+
+    const QString root = temporaryDirectory.path();
+    QVERIFY(QDir(root).mkdir("a"));
+
+    QFileSystemWatcher watcher;
+    QCOMPARE(watcher.coalescingInterval(), 0);
+    watcher.setCoalescingInterval(1000);
+    QCOMPARE(watcher.coalescingInterval(), 1000);
+    QVERIFY(watcher.addDirectoryTree(root));
+
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::directoryChanged);
+    QVERIFY(changedSpy.isValid());
+    QSignalSpy batchSpy(&watcher, &QFileSystemWatcher::pathsChanged);
+    QVERIFY(batchSpy.isValid());
+
+    for (int i = 0; i < 20; ++i) {
+        QFile file(root + QString::fromLatin1("/file%1.txt").arg(i));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QFile nestedFile(root + QString::fromLatin1("/a/file%1.txt").arg(i));
+        QVERIFY(nestedFile.open(QIODevice::WriteOnly));
+    }
+
+    QTRY_COMPARE(batchSpy.count(), 1);
+    QCOMPARE(changedSpy.count(), 0);
+    const QStringList files = batchSpy.at(0).at(0).toStringList();
+    const QStringList directories = batchSpy.at(0).at(1).toStringList();
+#ifdef Q_OS_LINUX
+    // the files were written to when they were closed
+    QCOMPARE(files.size(), 40);
+    QVERIFY(files.contains(root + "/file0.txt"));
+    QVERIFY(files.contains(root + "/a/file19.txt"));
+#else
+    QVERIFY(files.isEmpty());
+#endif
+    QCOMPARE(directories, QStringList({root, root + "/a"}));
+
+    // switching coalescing off reports changes individually again
+    watcher.setCoalescingInterval(0);
+    QVERIFY(QFile::remove(root + "/a/file0.txt"));
+    QTRY_VERIFY(changedSpy.count() > 0);
+    QCOMPARE(batchSpy.count(), 1);
+}
+
 QTEST_MAIN(tst_QFileSystemWatcher)
 #include "tst_qfilesystemwatcher.moc"
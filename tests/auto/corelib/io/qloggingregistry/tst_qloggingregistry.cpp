@@ -170,6 +170,50 @@ private slots:
         QCOMPARE(state, result);
     }
 
+    void QLoggingRuleMatcher_match()
+    {
+        // the matcher must agree with trying every rule in turn
+        const char *patterns[] = {
+            "qt.core.io", "qt.core.io.debug", "qt.*", "qt.*.warning", "qt.core.*=false",
+            "*.io", "*.io.critical", "*io*", "*.core.*", "*", "*.info", "qt", "q*",
+            "*o", "qt.gui.*", "*.io=false", "qt.core.io=false", "*core*.debug"
+        };
+        QVector<QLoggingRule> rules;
+        for (const char *pattern : patterns) {
+            QString p = QString::fromLatin1(pattern);
+            const bool enabled = !p.endsWith("=false");
+            p.remove("=false");
+            rules.append(QLoggingRule(QStringRef(&p), enabled));
+        }
+
+        const QStringList names = {
+            "qt", "qt.core", "qt.core.io", "qt.core.io.io", "qt.gui.io", "qt.gui",
+            "io", "o", "", "q", "default", "Digia.Berlin", "core.io", "qt.core.iox"
+        };
+
+        for (int count = 0; count <= rules.size(); ++count) {
+            const QVector<QLoggingRule> ruleSet = rules.mid(rules.size() - count);
+            QLoggingRuleMatcher matcher;
+            matcher.addRules(ruleSet.mid(0, count / 2));
+            matcher.addRules(ruleSet.mid(count / 2));
+            for (const QString &name : names) {
+                const QLoggingRuleMatcher::Verdict verdict = matcher.match(name);
+                for (QtMsgType type : { QtDebugMsg, QtInfoMsg, QtWarningMsg, QtCriticalMsg }) {
+                    int expected = 0;
+                    for (const QLoggingRule &rule : ruleSet) {
+                        if (const int pass = rule.pass(name, type))
+                            expected = pass;
+                    }
+                    const int actual = !verdict.isDecided(type) ? 0
+                                     : verdict.isEnabled(type) ? 1 : -1;
+                    QVERIFY2(actual == expected,
+                             qPrintable(QString("%1 rules, category '%2', type %3")
+                                        .arg(count).arg(name).arg(int(type))));
+                }
+            }
+        }
+    }
+
     void QLoggingSettingsParser_iniStyle()
     {
         //
@@ -306,6 +350,126 @@ private slots:
     }
 
 
+    void QLoggingRegistry_reloadConfigurationFile()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString confPath = dir.filePath("qtlogging.ini");
+        const auto writeConf = [&](const char *content) {
+            QFile file(confPath);
+            QVERIFY(file.open(QFile::WriteOnly | QFile::Text | QFile::Truncate));
+            file.write(content);
+        };
+
+        writeConf("[Rules]\n"
+                  "Nokia.*=false\n"
+                  "Digia.Berlin=false\n");
+        qputenv("QT_LOGGING_CONF", QFile::encodeName(confPath));
+        qunsetenv("QT_LOGGING_RULES");
+        QLoggingRegistry *registry = QLoggingRegistry::instance();
+        registry->ruleSets[QLoggingRegistry::ApiRules].clear();
+        registry->initializeRules();
+
+        QLoggingCategory berlin("Digia.Berlin");
+        QLoggingCategory oslo("Digia.Oslo");
+        QLoggingCategory espoo("Nokia.Espoo");
+        QLoggingCategory otherEspoo("Nokia.Espoo");
+        QVERIFY(!berlin.isWarningEnabled());
+        QVERIFY(oslo.isWarningEnabled());
+        QVERIFY(!espoo.isWarningEnabled());
+        QVERIFY(!otherEspoo.isWarningEnabled());
+
+        // the rules that changed decide which categories are looked at again
+        writeConf("[Rules]\n"
+                  "Nokia.*=false\n"
+                  "Digia.Oslo=false\n");
+        registry->reloadConfigurationFile();
+        QVERIFY(berlin.isWarningEnabled());
+        QVERIFY(!oslo.isWarningEnabled());
+        QVERIFY(!espoo.isWarningEnabled());
+
+        writeConf("[Rules]\n"
+                  "Digia.Oslo=false\n"
+                  "*.Espoo.warning=true\n");
+        registry->reloadConfigurationFile();
+        QVERIFY(berlin.isWarningEnabled());
+        QVERIFY(!oslo.isWarningEnabled());
+        QVERIFY(espoo.isWarningEnabled());
+        QVERIFY(otherEspoo.isWarningEnabled());
+        QVERIFY(otherEspoo.isCriticalEnabled());
+
+        // rules set through the API still override the file
+        QLoggingCategory::setFilterRules("Digia.*=false");
+        QVERIFY(!berlin.isWarningEnabled());
+        writeConf("[Rules]\n");
+        registry->reloadConfigurationFile();
+        QVERIFY(!berlin.isWarningEnabled());
+        QVERIFY(espoo.isCriticalEnabled());
+
+        QLoggingCategory::setFilterRules(QString());
+        qunsetenv("QT_LOGGING_CONF");
+        registry->reloadConfigurationFile();
+        QVERIFY(berlin.isWarningEnabled());
+    }
+
+    void QLoggingRegistry_watchConfigurationFile()
+    {
+#if !QT_CONFIG(filesystemwatcher)
+        QSKIP("This test requires QFileSystemWatcher");
+#else
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString confPath = dir.filePath("qtlogging.ini");
+        const auto writeFile = [](const QString &path, const char *content) {
+            QFile file(path);
+            QVERIFY(file.open(QFile::WriteOnly | QFile::Text | QFile::Truncate));
+            file.write(content);
+        };
+
+        writeFile(confPath, "[Rules]\n"
+                            "Digia.Berlin=false\n");
+        qputenv("QT_LOGGING_CONF", QFile::encodeName(confPath));
+        qunsetenv("QT_LOGGING_RULES");
+        QLoggingRegistry *registry = QLoggingRegistry::instance();
+        registry->ruleSets[QLoggingRegistry::ApiRules].clear();
+        registry->initializeRules();
+        registry->watchConfigurationFile();
+        const auto watchers = qApp->findChildren<QFileSystemWatcher *>();
+        const auto cleanup = qScopeGuard([&] {
+            qDeleteAll(watchers);
+            qunsetenv("QT_LOGGING_CONF");
+            registry->reloadConfigurationFile();
+        });
+        QCOMPARE(watchers.size(), 1);
+
+        QLoggingCategory berlin("Digia.Berlin");
+        QVERIFY(!berlin.isWarningEnabled());
+
+        // rules that differ from the file, so that a reload would show
+        QLoggingSettingsParser parser;
+        parser.setContent("Digia.Berlin=true");
+        registry->ruleSets[QLoggingRegistry::EnvironmentRules] = parser.rules();
+        registry->updateRules();
+        QVERIFY(berlin.isWarningEnabled());
+
+        // other files in the directory don't reload the rules
+        QSignalSpy directorySpy(watchers.first(), &QFileSystemWatcher::directoryChanged);
+        writeFile(dir.filePath("other.txt"), "other");
+        QTRY_VERIFY(!directorySpy.isEmpty());
+        QCoreApplication::processEvents();
+        QVERIFY(berlin.isWarningEnabled());
+
+        // replacing the file does
+        const QString newPath = dir.filePath("qtlogging.ini.new");
+        writeFile(newPath, "[Rules]\n"
+                           "Digia.Berlin=false\n"
+                           "Digia.Oslo=false\n");
+        QVERIFY(QFile::remove(confPath));
+        QVERIFY(QFile::rename(newPath, confPath));
+        QTRY_VERIFY(!berlin.isWarningEnabled());
+#endif // QT_CONFIG(filesystemwatcher)
+    }
+
     void QLoggingRegistry_checkErrors()
     {
         QLoggingSettingsParser parser;
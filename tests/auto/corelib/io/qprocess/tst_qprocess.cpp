@@ -42,6 +42,10 @@
 #include <QtNetwork/QHostInfo>
 #include <stdlib.h>
 
+#ifdef Q_OS_UNIX
+#  include <unistd.h>
+#endif
+
 typedef void (QProcess::*QProcessFinishedSignal1)(int);
 typedef void (QProcess::*QProcessFinishedSignal2)(int, QProcess::ExitStatus);
 typedef void (QProcess::*QProcessErrorSignal)(QProcess::ProcessError);
@@ -125,6 +129,9 @@ private slots:
     void nativeArguments();
     void createProcessArgumentsModifier();
 #endif // Q_OS_WIN
+#if defined(Q_OS_UNIX)
+    void setChildProcessModifier();
+#endif
     void exitCodeTest();
     void systemEnvironment();
     void lockupsInStartDetached();
@@ -1470,6 +1477,46 @@ void tst_QProcess::createProcessArgumentsModifier()
 }
 #endif // Q_OS_WIN
 
+#ifdef Q_OS_UNIX
+static constexpr char messageFromChildProcess[] = "Message from the child process";
+
+void tst_QProcess::setChildProcessModifier()
+{
+    int pipes[2] = { -1 , -1 };
+    QVERIFY(::pipe(pipes) == 0);
+
+    QProcess process;
+    process.setChildProcessModifier([pipes]() {
+        ::write(pipes[1], messageFromChildProcess, sizeof(messageFromChildProcess) - 1);
+        ::close(pipes[1]);
+    });
+    process.start("testProcessNormal/testProcessNormal");
+    QVERIFY2(process.waitForStarted(5000), qPrintable(process.errorString()));
+    QVERIFY(process.waitForFinished(5000));
+    QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(process.exitCode(), 0);
+
+    char buf[sizeof messageFromChildProcess] = {};
+    ::close(pipes[1]);
+    QCOMPARE(::read(pipes[0], buf, sizeof(buf)), ssize_t(sizeof(messageFromChildProcess) - 1));
+    QCOMPARE(buf, messageFromChildProcess);
+    ::close(pipes[0]);
+
+    // without a modifier, the child is started differently; check that it
+    // still reports its exit status and failures to start correctly
+    process.setChildProcessModifier(std::function<void(void)>());
+    process.start("testExitCodes/testExitCodes", QStringList() << "42");
+    QVERIFY2(process.waitForStarted(5000), qPrintable(process.errorString()));
+    QVERIFY(process.waitForFinished(5000));
+    QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(process.exitCode(), 42);
+
+    process.start("this-program-does-not-exist");
+    QVERIFY(!process.waitForStarted(5000));
+    QCOMPARE(process.error(), QProcess::FailedToStart);
+}
+#endif
+
 void tst_QProcess::exitCodeTest()
 {
     for (int i = 0; i < 255; ++i) {
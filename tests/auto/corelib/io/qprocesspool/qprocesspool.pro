@@ -0,0 +1,5 @@
+TEMPLATE = subdirs
+
+SUBDIRS = testPoolHelper
+test.depends += $$SUBDIRS
+SUBDIRS += test
@@ -0,0 +1,8 @@
+CONFIG += testcase
+CONFIG -= debug_and_release_target
+QT = core testlib
+SOURCES = ../tst_qprocesspool.cpp
+
+TARGET = ../tst_qprocesspool
+
+TEST_HELPER_INSTALLS += ../testPoolHelper/testPoolHelper
@@ -0,0 +1,74 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <unistd.h>
+#endif
+
+// Usage:
+//   testPoolHelper echo <exit code>   copies stdin to stdout, writes "stderr" to stderr
+//   testPoolHelper crash
+//   testPoolHelper hang
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+        return -1;
+
+    if (strcmp(argv[1], "echo") == 0) {
+        char buffer[1024];
+        size_t num;
+        while ((num = fread(buffer, 1, sizeof(buffer), stdin)) > 0)
+            fwrite(buffer, num, 1, stdout);
+        fflush(stdout);
+        fputs("stderr", stderr);
+        return argc >= 3 ? atoi(argv[2]) : 0;
+    }
+
+    if (strcmp(argv[1], "crash") == 0) {
+        fflush(stdout);
+        abort();
+    }
+
+    if (strcmp(argv[1], "hang") == 0) {
+        for (int i = 0; i < 60; ++i) {
+#if defined(_WIN32)
+            Sleep(1000);
+#else
+            sleep(1);
+#endif
+        }
+        return 0;
+    }
+
+    return -1;
+}
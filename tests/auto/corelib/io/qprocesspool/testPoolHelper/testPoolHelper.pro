@@ -0,0 +1,5 @@
+SOURCES += main.cpp
+CONFIG -= qt
+CONFIG += cmdline
+
+DESTDIR = ./
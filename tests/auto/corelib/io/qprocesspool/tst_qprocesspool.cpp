@@ -0,0 +1,212 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/QProcessPool>
+
+class tst_QProcessPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void getSetCheck();
+    void runMany();
+    void eventLoop();
+    void mergedChannels();
+    void outputBufferSize();
+    void failToStart();
+    void crash();
+    void kill();
+
+private:
+    QString helper;
+};
+
+void tst_QProcessPool::initTestCase()
+{
+    // chdir to our testdata path and execute the helper relative to that.
+    const QString testdata_dir = QFileInfo(QFINDTESTDATA("testPoolHelper")).absolutePath();
+    QVERIFY2(QDir::setCurrent(testdata_dir), qPrintable("Could not chdir to " + testdata_dir));
+    helper = QStringLiteral("testPoolHelper/testPoolHelper");
+}
+
+void tst_QProcessPool::getSetCheck()
+{
+    QProcessPool pool;
+    QVERIFY(pool.maximumConcurrency() >= 1);
+    pool.setMaximumConcurrency(3);
+    QCOMPARE(pool.maximumConcurrency(), 3);
+    pool.setMaximumConcurrency(0);
+    QCOMPARE(pool.maximumConcurrency(), 1);
+
+    QCOMPARE(pool.processChannelMode(), QProcess::SeparateChannels);
+    pool.setProcessChannelMode(QProcess::MergedChannels);
+    QCOMPARE(pool.processChannelMode(), QProcess::MergedChannels);
+
+    QCOMPARE(pool.outputBufferSize(), qint64(0));
+    pool.setOutputBufferSize(4096);
+    QCOMPARE(pool.outputBufferSize(), qint64(4096));
+
+    QCOMPARE(pool.count(), 0);
+    QCOMPARE(pool.finishedCount(), 0);
+    QVERIFY(pool.isFinished());
+    QVERIFY(pool.waitForFinished(0));
+}
+
+void tst_QProcessPool::runMany()
+{
+    QProcessPool pool;
+    pool.setMaximumConcurrency(4);
+    QSignalSpy processFinishedSpy(&pool, &QProcessPool::processFinished);
+    QSignalSpy progressSpy(&pool, &QProcessPool::progress);
+    QSignalSpy finishedSpy(&pool, &QProcessPool::finished);
+
+    const int count = 40;
+    for (int i = 0; i < count; ++i) {
+        const QByteArray input = QByteArray::number(i).repeated(i * 100);
+        QCOMPARE(pool.addProcess(helper, { "echo", QString::number(i) }, input), i);
+    }
+    QCOMPARE(pool.count(), count);
+
+    QVERIFY(pool.waitForFinished(60000));
+    QVERIFY(pool.isFinished());
+    QCOMPARE(pool.finishedCount(), count);
+    QCOMPARE(processFinishedSpy.count(), count);
+    QCOMPARE(progressSpy.count(), count);
+    QCOMPARE(progressSpy.last().at(0).toInt(), count);
+    QCOMPARE(progressSpy.last().at(1).toInt(), count);
+    QCOMPARE(finishedSpy.count(), 1);
+
+    QList<int> indexes;
+    for (const QList<QVariant> &arguments : qAsConst(processFinishedSpy))
+        indexes << arguments.at(0).toInt();
+    std::sort(indexes.begin(), indexes.end());
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(indexes.at(i), i);
+        QVERIFY(pool.isProcessFinished(i));
+        QCOMPARE(pool.error(i), QProcess::UnknownError);
+        QCOMPARE(pool.exitStatus(i), QProcess::NormalExit);
+        QCOMPARE(pool.exitCode(i), i);
+        QCOMPARE(pool.standardOutput(i), QByteArray::number(i).repeated(i * 100));
+        QCOMPARE(pool.standardError(i), QByteArray("stderr"));
+    }
+}
+
+void tst_QProcessPool::eventLoop()
+{
+    QProcessPool pool;
+    QSignalSpy finishedSpy(&pool, &QProcessPool::finished);
+    pool.addProcess(helper, { "echo", "1" }, "hello");
+    pool.addProcess(helper, { "echo", "2" });
+
+    QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.count(), 1, 30000);
+    QCOMPARE(pool.exitCode(0), 1);
+    QCOMPARE(pool.standardOutput(0), QByteArray("hello"));
+    QCOMPARE(pool.exitCode(1), 2);
+    QVERIFY(pool.standardOutput(1).isEmpty());
+
+    // the pool can be reused once it is finished
+    pool.addProcess(helper, { "echo", "3" });
+    QVERIFY(!pool.isFinished());
+    QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.count(), 2, 30000);
+    QCOMPARE(pool.exitCode(2), 3);
+}
+
+void tst_QProcessPool::mergedChannels()
+{
+    QProcessPool pool;
+    pool.setProcessChannelMode(QProcess::MergedChannels);
+    pool.addProcess(helper, { "echo", "0" }, "stdout");
+    QVERIFY(pool.waitForFinished());
+    QCOMPARE(pool.standardOutput(0), QByteArray("stdoutstderr"));
+    QVERIFY(pool.standardError(0).isEmpty());
+}
+
+void tst_QProcessPool::outputBufferSize()
+{
+    const QByteArray input(1024 * 1024, 'a');
+    QProcessPool pool;
+    pool.setOutputBufferSize(input.size());
+    pool.addProcess(helper, { "echo", "0" }, input);
+    pool.setOutputBufferSize(16);
+    pool.addProcess(helper, { "echo", "0" }, input);
+    QVERIFY(pool.waitForFinished());
+    QCOMPARE(pool.standardOutput(0), input);
+    QCOMPARE(pool.standardOutput(1), input);
+}
+
+void tst_QProcessPool::failToStart()
+{
+    QProcessPool pool;
+    QSignalSpy finishedSpy(&pool, &QProcessPool::finished);
+    pool.addProcess("/this/program/does/not/exist");
+    pool.addProcess(helper, { "echo", "0" });
+    QVERIFY(pool.waitForFinished());
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(pool.error(0), QProcess::FailedToStart);
+    QVERIFY(!pool.errorString(0).isEmpty());
+    QCOMPARE(pool.error(1), QProcess::UnknownError);
+}
+
+void tst_QProcessPool::crash()
+{
+    QProcessPool pool;
+    pool.addProcess(helper, { "crash" });
+    QVERIFY(pool.waitForFinished());
+    QCOMPARE(pool.exitStatus(0), QProcess::CrashExit);
+    QCOMPARE(pool.error(0), QProcess::Crashed);
+}
+
+void tst_QProcessPool::kill()
+{
+    QProcessPool pool;
+    pool.setMaximumConcurrency(2);
+    QSignalSpy processFinishedSpy(&pool, &QProcessPool::processFinished);
+    for (int i = 0; i < 5; ++i)
+        pool.addProcess(helper, { "hang" });
+
+    QVERIFY(!pool.waitForFinished(200));
+    pool.kill();
+    QVERIFY(pool.waitForFinished());
+    QCOMPARE(processFinishedSpy.count(), 5);
+
+    int crashed = 0;
+    int cancelled = 0;
+    for (int i = 0; i < pool.count(); ++i) {
+        if (pool.error(i) == QProcess::Crashed)
+            ++crashed;
+        else if (pool.error(i) == QProcess::FailedToStart)
+            ++cancelled;
+    }
+    QCOMPARE(crashed, 2);
+    QCOMPARE(cancelled, 3);
+}
+
+QTEST_MAIN(tst_QProcessPool)
+#include "tst_qprocesspool.moc"
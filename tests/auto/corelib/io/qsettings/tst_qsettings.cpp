@@ -193,6 +193,7 @@ private slots:
     void embeddedZeroByte_data();
     void embeddedZeroByte();
     void spaceAfterComment();
+    void indexedFormat();
 
     void testXdg();
 private:
@@ -290,6 +291,7 @@ static void populateWithFormats()
     QTest::newRow("ini") << QSettings::IniFormat;
     QTest::newRow("custom1") << QSettings::CustomFormat1;
     QTest::newRow("custom2") << QSettings::CustomFormat2;
+    QTest::newRow("indexed") << QSettings::IndexedFormat;
 }
 
 tst_QSettings::tst_QSettings()
@@ -1248,7 +1250,7 @@ void tst_QSettings::testMetaTypes_data()
         QTest::newRow(QString("%1:%2").arg(formatName).arg(typeName).toLatin1().constData()) \
             << QSettings::Format(formats[i]) << int(QMetaType::MetaTypeName); \
     }
-    int formats[] = { QSettings::NativeFormat, QSettings::IniFormat };
+    int formats[] = { QSettings::NativeFormat, QSettings::IniFormat, QSettings::IndexedFormat };
     for (int i = 0; i < int(sizeof(formats) / sizeof(int)); ++i) {
         FOR_EACH_CORE_METATYPE(ADD_METATYPE_TEST_ROW)
     }
@@ -3628,6 +3630,143 @@ void tst_QSettings::recursionBug()
     }
 }
 
+static QByteArray indexedRecord(const QString &key, const QVariant *value)
+{
+    QByteArray serialized;
+    if (value) {
+        QDataStream out(&serialized, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_15);
+        out << *value;
+    }
+    const QByteArray utf8 = key.toUtf8();
+    uchar header[9];
+    header[0] = value ? 1 : 2;
+    qToLittleEndian<quint32>(utf8.size(), header + 1);
+    qToLittleEndian<quint32>(serialized.size(), header + 5);
+    return QByteArray(reinterpret_cast<const char *>(header), sizeof(header)) + utf8 + serialized;
+}
+
+static qint64 indexedLogStart(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return -1;
+    const QByteArray header = file.read(32);
+    if (header.size() != 32 || !header.startsWith("QtSetIdx"))
+        return -1;
+    return qFromLittleEndian<quint64>(header.constData() + 24);
+}
+
+void tst_QSettings::indexedFormat()
+{
+    const QString fileName = settingsPath("indexed.qsi");
+
+    QSettings settings(fileName, QSettings::IndexedFormat);
+    settings.setValue("int", 42);
+    settings.setValue("list", QStringList() << "a" << "b");
+    settings.setValue("group/one", QByteArray("one"));
+    settings.setValue("group/two", QDateTime(QDate(2020, 1, 2), QTime(3, 4, 5)));
+    settings.setValue("group/sub/three", 3.5);
+    settings.sync();
+    QCOMPARE(settings.status(), QSettings::NoError);
+
+    // The first write lays out the table, with an empty log
+    const qint64 tableSize = QFileInfo(fileName).size();
+    QCOMPARE(indexedLogStart(fileName), tableSize);
+
+    QCOMPARE(settings.value("int"), QVariant(42));
+    QCOMPARE(settings.value("list"), QVariant(QStringList() << "a" << "b"));
+    QCOMPARE(settings.value("group/one"), QVariant(QByteArray("one")));
+    QCOMPARE(settings.value("group/two").toDateTime(),
+             QDateTime(QDate(2020, 1, 2), QTime(3, 4, 5)));
+    QCOMPARE(settings.childKeys(), QStringList() << "int" << "list");
+    QCOMPARE(settings.childGroups(), QStringList() << "group");
+    settings.beginGroup("group");
+    QCOMPARE(settings.allKeys(), QStringList() << "one" << "sub/three" << "two");
+    settings.endGroup();
+
+    // Small changes are appended to the log
+    settings.setValue("int", 43);
+    settings.remove("group/one");
+    settings.sync();
+    QCOMPARE(indexedLogStart(fileName), tableSize);
+    QVERIFY(QFileInfo(fileName).size() > tableSize);
+    QCOMPARE(settings.value("int"), QVariant(43));
+    QVERIFY(!settings.contains("group/one"));
+    QCOMPARE(settings.value("group/sub/three"), QVariant(3.5));
+
+    // Records appended by another process are picked up, a torn record at
+    // the end is ignored until it's complete
+    const QVariant otherValue(QStringLiteral("other"));
+    QByteArray torn = indexedRecord("other/torn", &otherValue);
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::Append));
+        file.write(indexedRecord("other/key", &otherValue));
+        file.write(indexedRecord("group/two", nullptr));
+        file.write(torn.left(torn.size() / 2));
+    }
+    settings.sync();
+    QCOMPARE(settings.status(), QSettings::NoError);
+    QCOMPARE(settings.value("other/key"), otherValue);
+    QVERIFY(!settings.contains("group/two"));
+    QVERIFY(!settings.contains("other/torn"));
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::Append));
+        file.write(torn.mid(torn.size() / 2));
+    }
+    settings.sync();
+    QCOMPARE(settings.value("other/torn"), otherValue);
+
+    // A writer drops a torn record left behind by a crashed one
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::Append));
+        file.write(torn.left(5));
+    }
+    settings.setValue("after", true);
+    settings.sync();
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::Append));
+        file.write(indexedRecord("last", &otherValue));
+    }
+    settings.sync();
+    QCOMPARE(settings.value("after"), QVariant(true));
+    QCOMPARE(settings.value("last"), otherValue);
+
+    // Once the log grows large the file is rewritten as a table
+    const QByteArray big(1024, 'x');
+    for (int i = 0; i < 100; ++i) {
+        settings.setValue(QString("big/%1").arg(i), big);
+        settings.sync();
+    }
+    const qint64 size = QFileInfo(fileName).size();
+    QVERIFY(indexedLogStart(fileName) > tableSize);
+    QVERIFY(size - indexedLogStart(fileName) < 64 * 1024);
+    QCOMPARE(settings.value("big/0"), QVariant(big));
+    QCOMPARE(settings.value("big/99"), QVariant(big));
+    QCOMPARE(settings.value("other/key"), otherValue);
+    QVERIFY(!settings.contains("group/one"));
+
+    settings.clear();
+    settings.sync();
+    QVERIFY(settings.allKeys().isEmpty());
+
+    // Anything that isn't an indexed file is reported as a format error
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("[General]\nkey=value\n");
+    }
+    QSettings other(settingsPath("indexed2.qsi"), QSettings::IndexedFormat);
+    QCOMPARE(other.status(), QSettings::NoError);
+    QSettings broken(fileName, QSettings::IndexedFormat);
+    broken.sync();
+    QCOMPARE(broken.status(), QSettings::FormatError);
+}
+
 #if defined(Q_OS_WIN) && !defined(Q_OS_WINRT)
 
 static DWORD readKeyType(HKEY handle, QStringView rSubKey)
@@ -87,6 +87,9 @@ private Q_SLOTS:
     void encodingRecodeInvalidUtf8();
     void recodeByteArray_data();
     void recodeByteArray();
+    void findNonPlainCharacter_data();
+    void findNonPlainCharacter();
+    void findNonPlainCharacterAllAscii();
 };
 #include "tst_qurlinternal.moc"
 
@@ -1098,4 +1101,56 @@ void tst_QUrlInternal::recodeByteArray()
     QCOMPARE(output, expected);
 }
 
+void tst_QUrlInternal::findNonPlainCharacter_data()
+{
+    QTest::addColumn<QString>("input");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("empty") << QString() << 0;
+    QTest::newRow("plain-short") << "/a/b" << 4;
+    QTest::newRow("plain-long") << "/path/to/some/file.html?query=value&other=1#frag:ment@x" << 55;
+    QTest::newRow("delimiters") << "!$&'()*+,;=:@/?#[]-._~" << 22;
+    QTest::newRow("non-ascii") << QString::fromUtf8("/p\xc3\xa9r\xc3\xa9/\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e/file") << 14;
+    QTest::newRow("percent-first") << "%20/path/to/file" << 0;
+    QTest::newRow("percent-8") << "/abcdefg%20" << 8;
+    QTest::newRow("percent-end") << "/abcdefghijklmnopqrstuvwxyz%" << 27;
+    QTest::newRow("space") << "/some/path with spaces" << 10;
+    QTest::newRow("tab") << "/some/path\twith/tab" << 10;
+    QTest::newRow("nul") << QString::fromLatin1("/some/path/with\0nul", 19) << 15;
+    QTest::newRow("del") << "/some/path/with/del\x7f" << 19;
+    QTest::newRow("brace") << "/some/path/with/{brace}" << 16;
+    QTest::newRow("backslash") << "/some/path/with/\\slash" << 16;
+}
+
+void tst_QUrlInternal::findNonPlainCharacter()
+{
+    QFETCH(QString, input);
+    QFETCH(int, expected);
+
+    const QChar *begin = input.constData();
+    QCOMPARE(int(qt_urlFindNonPlainCharacter(begin, begin + input.size()) - begin), expected);
+}
+
+void tst_QUrlInternal::findNonPlainCharacterAllAscii()
+{
+    // A plain character must not need recoding, whatever its position relative
+    // to the vectorised part of the scan
+    const QString filler = QStringLiteral("abcdefghijklmnopqrstuvwxyz012345");
+    for (ushort c = 0; c < 0x80; ++c) {
+        QString single(1, QChar(c));
+        QString output;
+        const bool plain = qt_urlFindNonPlainCharacter(single.constBegin(), single.constEnd()) == single.constEnd();
+        if (plain)
+            QCOMPARE(qt_urlRecode(output, single.constBegin(), single.constEnd(), {}), 0);
+
+        for (int pos = 0; pos < filler.size(); ++pos) {
+            QString input = filler;
+            input[pos] = QChar(c);
+            const QChar *begin = input.constData();
+            const QChar *end = begin + input.size();
+            QCOMPARE(int(qt_urlFindNonPlainCharacter(begin, end) - begin), plain ? input.size() : pos);
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QUrlInternal)
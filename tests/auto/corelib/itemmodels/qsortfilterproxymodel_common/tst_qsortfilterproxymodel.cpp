@@ -2660,6 +2660,79 @@ void tst_QSortFilterProxyModel::sortStable()
     QCOMPARE(lastItemData, filterModel->index(2,0, firstRoot).data());
 }
 
+void tst_QSortFilterProxyModel::sortLocaleAware_data()
+{
+    QTest::addColumn<Qt::SortOrder>("order");
+    QTest::addColumn<bool>("overrideLessThan");
+
+    QTest::newRow("ascending") << Qt::AscendingOrder << false;
+    QTest::newRow("descending") << Qt::DescendingOrder << false;
+    QTest::newRow("ascending, lessThan() overridden") << Qt::AscendingOrder << true;
+    QTest::newRow("descending, lessThan() overridden") << Qt::DescendingOrder << true;
+}
+
+void tst_QSortFilterProxyModel::sortLocaleAware()
+{
+    QFETCH(Qt::SortOrder, order);
+    QFETCH(bool, overrideLessThan);
+
+    // Compares by length first, using the default implementation on ties
+    class LengthFirstProxy : public QSortFilterProxyModel
+    {
+    public:
+        bool lessThan(const QModelIndex &left, const QModelIndex &right) const override
+        {
+            const int l = left.data().toString().size();
+            const int r = right.data().toString().size();
+            return l != r ? l < r : QSortFilterProxyModel::lessThan(left, right);
+        }
+    };
+
+    QStringList strings;
+    const QStringList words = {
+        QString(), QStringLiteral("apple"), QStringLiteral("Apple"), QStringLiteral("\u00e4pfel"),
+        QStringLiteral("Zebra"), QStringLiteral("zebra"), QStringLiteral("10"), QStringLiteral("9"),
+        QStringLiteral("\u00e9t\u00e9"), QStringLiteral("ete"), QStringLiteral("b")
+    };
+    for (int i = 0; i < 20; ++i) {
+        for (const QString &word : words)
+            strings.append(word + QString::number(i % 3));
+    }
+    strings.append(QString());
+
+    const auto expectedLessThan = [=](const QString &lhs, const QString &rhs) {
+        if (overrideLessThan && lhs.size() != rhs.size())
+            return order == Qt::AscendingOrder ? lhs.size() < rhs.size()
+                                               : rhs.size() < lhs.size();
+        return order == Qt::AscendingOrder ? lhs.localeAwareCompare(rhs) < 0
+                                           : rhs.localeAwareCompare(lhs) < 0;
+    };
+    QStringList expected = strings;
+    std::stable_sort(expected.begin(), expected.end(), expectedLessThan);
+
+    QStringListModel model(strings);
+    QScopedPointer<QSortFilterProxyModel> proxy(overrideLessThan ? new LengthFirstProxy
+                                                                 : new QSortFilterProxyModel);
+    proxy->setSortLocaleAware(true);
+    proxy->setSourceModel(&model);
+    proxy->sort(0, order);
+
+    QStringList sorted;
+    for (int row = 0; row < proxy->rowCount(); ++row)
+        sorted.append(proxy->index(row, 0).data().toString());
+    QCOMPARE(sorted, expected);
+
+    // Changes to the data are picked up by the next sort
+    model.setData(model.index(0, 0), QStringLiteral("\u00c4rger"));
+    expected.replace(expected.indexOf(strings.first()), QStringLiteral("\u00c4rger"));
+    std::stable_sort(expected.begin(), expected.end(), expectedLessThan);
+    proxy->invalidate();
+    sorted.clear();
+    for (int row = 0; row < proxy->rowCount(); ++row)
+        sorted.append(proxy->index(row, 0).data().toString());
+    QCOMPARE(sorted, expected);
+}
+
 void tst_QSortFilterProxyModel::hiddenColumns()
 {
     class MyStandardItemModel : public QStandardItemModel
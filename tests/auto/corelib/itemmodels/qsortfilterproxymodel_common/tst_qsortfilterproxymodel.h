@@ -109,6 +109,8 @@ private slots:
     void sortColumnTracking2();
 
     void sortStable();
+    void sortLocaleAware_data();
+    void sortLocaleAware();
 
     void hiddenColumns();
     void insertRowsSort();
@@ -863,6 +863,45 @@ void tst_QMimeDatabase::fromThreads()
     QVERIFY(tp.waitForDone(60000));
 }
 
+void tst_QMimeDatabase::mimeTypesForFiles()
+{
+    const QByteArray contents[] = {
+        QByteArray("%PDF-1.4"),
+        QByteArray("<?php echo 1; ?>"),
+        QByteArray("\x89PNG\r\n\x1a\n"),
+        QByteArray("diff\tfoo bar"),
+        QByteArray("plain text"),
+        QByteArray("\001abc?}"),
+        QByteArray()
+    };
+
+    QStringList fileNames;
+    for (int i = 0; i < 100; ++i) {
+        const int n = i % int(sizeof(contents) / sizeof(contents[0]));
+        QFile file(m_temporaryDir.filePath(QString::fromLatin1("batch%1").arg(i)));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(contents[n]);
+        fileNames.append(file.fileName());
+    }
+    fileNames.append(QFINDTESTDATA("test.qml"));
+    fileNames.append(QFINDTESTDATA("magic-and-hierarchy.foo"));
+    fileNames.append(m_temporaryDir.path() + QLatin1Char('/'));
+    fileNames.append(m_temporaryDir.filePath(QString::fromLatin1("doesnotexist.txt")));
+
+    QMimeDatabase db;
+    const QList<QMimeDatabase::MatchMode> modes = {
+        QMimeDatabase::MatchDefault, QMimeDatabase::MatchExtension, QMimeDatabase::MatchContent
+    };
+    for (QMimeDatabase::MatchMode mode : modes) {
+        const QList<QMimeType> mimes = db.mimeTypesForFiles(fileNames, mode);
+        QCOMPARE(mimes.size(), fileNames.size());
+        for (int i = 0; i < fileNames.size(); ++i)
+            QCOMPARE(mimes.at(i).name(), db.mimeTypeForFile(fileNames.at(i), mode).name());
+    }
+    QCOMPARE(db.mimeTypesForFiles(fileNames).at(0).name(), QString::fromLatin1("application/pdf"));
+    QVERIFY(db.mimeTypesForFiles(QStringList()).isEmpty());
+}
+
 #if QT_CONFIG(process)
 
 enum {
@@ -68,6 +68,7 @@ private slots:
     void knownSuffix();
     void symlinkToFifo();
     void fromThreads();
+    void mimeTypesForFiles();
 
     // shared-mime-info test suite
 
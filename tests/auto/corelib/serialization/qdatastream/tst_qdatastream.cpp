@@ -184,6 +184,10 @@ private slots:
 
     void streamToAndFromQByteArray();
 
+    void stream_primitiveQVector_data();
+    void stream_primitiveQVector();
+    void status_primitiveQVector();
+
     void streamRealDataTypes();
 
     void enumTest();
@@ -3173,6 +3177,102 @@ void tst_QDataStream::streamToAndFromQByteArray()
     QCOMPARE(y, x);
 }
 
+void tst_QDataStream::stream_primitiveQVector_data()
+{
+    QTest::addColumn<int>("byteOrder");
+    QTest::addColumn<int>("version");
+
+    QTest::newRow("big-endian") << int(QDataStream::BigEndian) << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("little-endian") << int(QDataStream::LittleEndian) << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("big-endian-qt2") << int(QDataStream::BigEndian) << int(QDataStream::Qt_2_0);
+    QTest::newRow("little-endian-qt2") << int(QDataStream::LittleEndian) << int(QDataStream::Qt_2_0);
+}
+
+template <typename T>
+static void comparePrimitiveQVector(QDataStream::ByteOrder byteOrder, int version)
+{
+    // large enough to span several of the bulk-transfer chunks
+    QVector<T> vector;
+    for (int i = 0; i < 10000; ++i)
+        vector.append(T(i * 0x01020304050607LL - 42));
+
+    // the bulk path must produce the same bytes as element-wise streaming
+    QByteArray expected;
+    {
+        QDataStream stream(&expected, QIODevice::WriteOnly);
+        stream.setByteOrder(byteOrder);
+        stream.setVersion(version);
+        stream << quint32(vector.size());
+        for (T t : qAsConst(vector))
+            stream << t;
+    }
+
+    QByteArray actual;
+    {
+        QDataStream stream(&actual, QIODevice::WriteOnly);
+        stream.setByteOrder(byteOrder);
+        stream.setVersion(version);
+        stream << vector;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+    QCOMPARE(actual, expected);
+
+    QDataStream stream(actual);
+    stream.setByteOrder(byteOrder);
+    stream.setVersion(version);
+    QVector<T> result;
+    stream >> result;
+    QCOMPARE(stream.status(), QDataStream::Ok);
+    QVERIFY(stream.atEnd());
+    QCOMPARE(result, vector);
+}
+
+void tst_QDataStream::stream_primitiveQVector()
+{
+    QFETCH(int, byteOrder);
+    QFETCH(int, version);
+    const auto order = QDataStream::ByteOrder(byteOrder);
+
+    comparePrimitiveQVector<qint8>(order, version);
+    comparePrimitiveQVector<quint8>(order, version);
+    comparePrimitiveQVector<qint16>(order, version);
+    comparePrimitiveQVector<quint16>(order, version);
+    comparePrimitiveQVector<qint32>(order, version);
+    comparePrimitiveQVector<quint32>(order, version);
+    comparePrimitiveQVector<qint64>(order, version);
+    comparePrimitiveQVector<quint64>(order, version);
+}
+
+void tst_QDataStream::status_primitiveQVector()
+{
+    // past end
+    for (int i = 4; i < 12; ++i) {
+        QDataStream stream(QByteArray("\x00\x00\x00\x02\x00\x00\x00\x01\x00\x00\x00\x02", i));
+        QVector<qint32> vector;
+        stream >> vector;
+        QCOMPARE(stream.status(), QDataStream::ReadPastEnd);
+        QVERIFY(vector.isEmpty());
+    }
+
+    // a corrupt size must not be trusted for the allocation
+    {
+        QDataStream stream(QByteArray("\xff\xff\xff\xff\x00\x00\x00\x01", 8));
+        QVector<quint64> vector;
+        stream >> vector;
+        QCOMPARE(stream.status(), QDataStream::ReadPastEnd);
+        QVERIFY(vector.isEmpty());
+    }
+
+    // ok
+    {
+        QDataStream stream(QByteArray("\x00\x00\x00\x02\x00\x00\x00\x01\x00\x00\x00\x02", 12));
+        QVector<qint32> vector;
+        stream >> vector;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+        QCOMPARE(vector, QVector<qint32>({ 1, 2 }));
+    }
+}
+
 void tst_QDataStream::streamRealDataTypes()
 {
     // Generate QPicture from pixmap.
@@ -579,6 +579,7 @@ private slots:
     void readBack() const;
     void roundTrip() const;
     void roundTrip_data() const;
+    void longTextRuns() const;
 
 private:
     static QByteArray readFile(const QString &filename);
@@ -1773,5 +1774,55 @@ void tst_QXmlStream::roundTrip() const
     QCOMPARE(out, in);
 }
 
+void tst_QXmlStream::longTextRuns() const
+{
+    // Long runs of plain characters are copied in bulk; make sure the
+    // result is the same as scanning character by character, including
+    // across the reader's internal buffer boundaries.
+    const QString line = QStringLiteral("Some text with \"quotes\", 'apostrophes', ]brackets] "
+                                        "and non-ASCII characters: \u00e4\u00f6\u00fc \u65e5\u672c");
+    QString text;
+    for (int i = 0; i < 1000; ++i)
+        text += line + QLatin1Char('\n');
+    const QString spaces(20000, QLatin1Char(' '));
+    const QString value = line + line;
+
+    const QString document = QLatin1String("<root><a>") + text + QLatin1String("</a><b>") + spaces
+            + QLatin1String("</b><c attr=\"") + QString(value).replace(QLatin1Char('"'), QLatin1String("&quot;"))
+            + QLatin1String("\"/><d>x]]&gt;</d></root>");
+
+    QXmlStreamReader reader(document.toUtf8());
+    QVERIFY(reader.readNextStartElement());
+    QVERIFY(reader.readNextStartElement());
+    QCOMPARE(reader.name(), QLatin1String("a"));
+    QCOMPARE(reader.readNext(), QXmlStreamReader::Characters);
+    QCOMPARE(reader.text(), text);
+    QVERIFY(!reader.isWhitespace());
+    QCOMPARE(reader.lineNumber(), qint64(1001));
+    QCOMPARE(reader.readNext(), QXmlStreamReader::EndElement);
+
+    QVERIFY(reader.readNextStartElement());
+    QCOMPARE(reader.name(), QLatin1String("b"));
+    QCOMPARE(reader.readNext(), QXmlStreamReader::Characters);
+    QCOMPARE(reader.text(), spaces);
+    QVERIFY(reader.isWhitespace());
+    QCOMPARE(reader.readNext(), QXmlStreamReader::EndElement);
+
+    QVERIFY(reader.readNextStartElement());
+    QCOMPARE(reader.name(), QLatin1String("c"));
+    QCOMPARE(reader.attributes().value(QLatin1String("attr")), value);
+    QCOMPARE(reader.readNext(), QXmlStreamReader::EndElement);
+
+    QVERIFY(reader.readNextStartElement());
+    QCOMPARE(reader.readElementText(), QLatin1String("x]]>"));
+    QVERIFY(!reader.hasError());
+
+    // "]]>" is still rejected in content after a long run of text
+    QXmlStreamReader invalid(QLatin1String("<a>") + text + QLatin1String("]]></a>"));
+    while (!invalid.atEnd())
+        invalid.readNext();
+    QCOMPARE(invalid.error(), QXmlStreamReader::NotWellFormedError);
+}
+
 #include "tst_qxmlstream.moc"
 // vim: et:ts=4:sw=4:sts=4
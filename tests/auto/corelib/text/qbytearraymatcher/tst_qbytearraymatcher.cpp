@@ -43,6 +43,7 @@ class tst_QByteArrayMatcher : public QObject
 private slots:
     void interface();
     void indexIn();
+    void bruteForce();
     void staticByteArrayMatcher();
 };
 
@@ -137,6 +138,40 @@ void tst_QByteArrayMatcher::indexIn()
     QCOMPARE(matcher.indexIn(haystack, 34), -1);
 }
 
+// Compares the result of indexIn() with a naive search, for many needle
+// lengths and starting positions
+void tst_QByteArrayMatcher::bruteForce()
+{
+    QRandomGenerator rng(42);
+    auto randomBytes = [&](int length) {
+        QByteArray result(length, Qt::Uninitialized);
+        for (char &c : result)
+            c = "ab\0\xff"[rng.bounded(4)];
+        return result;
+    };
+
+    for (int round = 0; round < 500; ++round) {
+        const QByteArray haystack = randomBytes(rng.bounded(1, 300));
+        const int start = rng.bounded(haystack.size());
+        const QByteArray needle = haystack.mid(start, rng.bounded(1, 40));
+        const QByteArray other = randomBytes(needle.size());
+        for (const QByteArray &n : { needle, other }) {
+            const QByteArrayMatcher matcher(n);
+            for (int from = 0; from <= haystack.size(); from += 7) {
+                int expected = -1;
+                for (int i = from; i + n.size() <= haystack.size(); ++i) {
+                    if (memcmp(haystack.constData() + i, n.constData(), n.size()) == 0) {
+                        expected = i;
+                        break;
+                    }
+                }
+                QCOMPARE(matcher.indexIn(haystack, from), expected);
+                QCOMPARE(haystack.indexOf(n, from), expected);
+            }
+        }
+    }
+}
+
 void tst_QByteArrayMatcher::staticByteArrayMatcher()
 {
     {
@@ -44,6 +44,9 @@ private Q_SLOTS:
     void compare_data();
     void compare();
 
+    void sortKeys_data();
+    void sortKeys();
+
     void state();
 };
 
@@ -204,6 +207,53 @@ void tst_QCollator::compare()
 #endif
 }
 
+void tst_QCollator::sortKeys_data()
+{
+    QTest::addColumn<QLocale>("locale");
+    QTest::addColumn<Qt::CaseSensitivity>("caseSensitivity");
+
+    QTest::newRow("C") << QLocale::c() << Qt::CaseSensitive;
+    QTest::newRow("C:case-insensitive") << QLocale::c() << Qt::CaseInsensitive;
+    QTest::newRow("default") << QLocale() << Qt::CaseSensitive;
+}
+
+void tst_QCollator::sortKeys()
+{
+    QFETCH(QLocale, locale);
+    QFETCH(Qt::CaseSensitivity, caseSensitivity);
+
+#if defined(Q_OS_DARWIN) && !QT_CONFIG(icu)
+    if (locale == QLocale::c())
+        QSKIP("Sort keys are not supported for the C locale on Darwin");
+#endif
+
+    QCollator collator(locale);
+    collator.setCaseSensitivity(caseSensitivity);
+    auto asSign = [](int compared) {
+        return compared < 0 ? -1 : compared > 0 ? 1 : 0;
+    };
+
+    const QStringList strings = {
+        QString(), QStringLiteral("a"), QStringLiteral("A"), QStringLiteral("ab"),
+        QStringLiteral("aB"), QStringLiteral("b"), QStringLiteral("Z"), QStringLiteral("z"),
+        QStringLiteral("0"), QStringLiteral("10"), QStringLiteral("9"), QStringLiteral("a b"),
+        QStringLiteral("ab "), QStringLiteral("\u00e4b"), QStringLiteral("\u00c4b"),
+        QStringLiteral("\u00df"), QStringLiteral("\u0430\u0431"), QStringLiteral("\u65e5\u672c")
+    };
+    const QVector<QCollatorSortKey> keys = collator.sortKeys(strings);
+    QCOMPARE(keys.size(), strings.size());
+
+    for (int i = 0; i < strings.size(); ++i) {
+        QCOMPARE(keys.at(i).compare(collator.sortKey(strings.at(i))), 0);
+        for (int j = 0; j < strings.size(); ++j) {
+            const int expected = asSign(collator.compare(strings.at(i), strings.at(j)));
+            QCOMPARE(asSign(keys.at(i).compare(keys.at(j))), expected);
+            QCOMPARE(keys.at(i) < keys.at(j), expected < 0);
+            QCOMPARE(asSign(qstrcmp(keys.at(i).toByteArray(), keys.at(j).toByteArray())),
+                     expected);
+        }
+    }
+}
 
 void tst_QCollator::state()
 {
@@ -59,6 +59,7 @@
 #endif
 
 Q_DECLARE_METATYPE(QLocale::FormatType)
+Q_DECLARE_METATYPE(QLocale::NumberOptions)
 
 class tst_QLocale : public QObject
 {
@@ -88,6 +89,8 @@ private slots:
     void stringToFloat();
     void doubleToString_data();
     void doubleToString();
+    void appendNumbers_data();
+    void appendNumbers();
     void strtod_data();
     void strtod();
     void long_long_conversion_data();
@@ -1152,6 +1155,73 @@ void tst_QLocale::doubleToString()
     QCOMPARE(locale.toString(num, mode, precision), num_str);
 }
 
+void tst_QLocale::appendNumbers_data()
+{
+    QTest::addColumn<QLocale>("locale");
+    QTest::addColumn<QLocale::NumberOptions>("options");
+
+    const QLocale::NumberOptions omitGroup = QLocale::OmitGroupSeparator;
+    const QLocale::NumberOptions exact = QLocale::OmitLeadingZeroInExponent
+            | QLocale::IncludeTrailingZeroesAfterDot;
+    const QLocale locales[] = {
+        QLocale::c(),
+        QLocale(QLocale::German, QLocale::Germany),
+        QLocale(QLocale::French, QLocale::France),
+        QLocale(QLocale::Arabic, QLocale::Egypt),
+        QLocale(QLocale::Hindi, QLocale::India)
+    };
+    for (const QLocale &locale : locales) {
+        const QByteArray name = locale.name().toLatin1();
+        QTest::newRow(name + " default") << locale << QLocale::NumberOptions();
+        QTest::newRow(name + " omit-group") << locale << omitGroup;
+        QTest::newRow(name + " exact") << locale << exact;
+    }
+}
+
+void tst_QLocale::appendNumbers()
+{
+    QFETCH(QLocale, locale);
+    QFETCH(QLocale::NumberOptions, options);
+    locale.setNumberOptions(options);
+
+    const qlonglong integers[] = {
+        0, 1, -1, 12, 999, -1000, 123456, -1234567, 1000000000,
+        std::numeric_limits<qlonglong>::max(), std::numeric_limits<qlonglong>::min()
+    };
+    const int integerCount = int(sizeof(integers) / sizeof(integers[0]));
+    QStringList expected;
+    for (qlonglong l : integers)
+        expected.append(locale.toString(l));
+
+    QString result = QStringLiteral("prefix");
+    QCOMPARE(locale.appendNumbers(result, integers, integerCount, u", "),
+             QLatin1String("prefix") + expected.join(QLatin1String(", ")));
+    result.clear();
+    QCOMPARE(locale.appendNumbers(result, integers, 0, u","), QString());
+
+    double negativeZero = 0.0;
+    negativeZero = -negativeZero;
+    const double doubles[] = {
+        0, negativeZero, 1, -1, 0.1, -0.25, 1.5e-7, 123.456, -9876543.21, 1e21,
+        1.0 / 3, 2e-300, -1.7976931348623157e308, 4.9406564584124654e-324,
+        qInf(), -qInf(), qQNaN()
+    };
+    const int doubleCount = int(sizeof(doubles) / sizeof(doubles[0]));
+    const char forms[] = { 'f', 'e', 'g', 'E', 'G' };
+    const int precisions[] = { QLocale::FloatingPointShortest, 0, 1, 6, 17 };
+    for (char form : forms) {
+        for (int precision : precisions) {
+            expected.clear();
+            for (double d : doubles)
+                expected.append(locale.toString(d, form, precision));
+
+            result.clear();
+            locale.appendNumbers(result, doubles, doubleCount, u";", form, precision);
+            QCOMPARE(result, expected.join(QLatin1Char(';')));
+        }
+    }
+}
+
 void tst_QLocale::strtod_data()
 {
     QTest::addColumn<QString>("num_str");
@@ -0,0 +1,321 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/QMultiStringMatcher>
+
+typedef QMultiStringMatcher::Match Match;
+
+QT_BEGIN_NAMESPACE
+static bool operator==(const Match &lhs, const Match &rhs)
+{
+    return lhs.position == rhs.position && lhs.length == rhs.length
+            && lhs.needleIndex == rhs.needleIndex;
+}
+
+namespace QTest {
+template <> char *toString(const Match &match)
+{
+    return qstrdup(QByteArray("Match(" + QByteArray::number(match.position) + ", "
+                              + QByteArray::number(match.length) + ", "
+                              + QByteArray::number(match.needleIndex) + ")").constData());
+}
+}
+QT_END_NAMESPACE
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultConstructed();
+    void settersAndGetters();
+    void implicitSharing();
+    void simple();
+    void overlapping();
+    void caseInsensitive();
+    void wholeWords();
+    void utf8();
+    void indexIn();
+    void bruteForce_data();
+    void bruteForce();
+};
+
+void tst_QMultiStringMatcher::defaultConstructed()
+{
+    const QMultiStringMatcher matcher;
+    QVERIFY(matcher.needles().isEmpty());
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+    QCOMPARE(matcher.matchOptions(), QMultiStringMatcher::NoMatchOption);
+    QVERIFY(matcher.matches(u"anything").isEmpty());
+    QCOMPARE(matcher.indexIn(u"anything"), -1);
+    QCOMPARE(matcher.indexIn(QByteArray("anything")), -1);
+}
+
+void tst_QMultiStringMatcher::settersAndGetters()
+{
+    QMultiStringMatcher matcher;
+    matcher.setNeedles({ "foo", "bar" });
+    QCOMPARE(matcher.needles(), QStringList({ "foo", "bar" }));
+    QCOMPARE(matcher.indexIn(u"xxBAR"), -1);
+
+    matcher.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+    int needleIndex = -2;
+    QCOMPARE(matcher.indexIn(u"xxBAR", 0, &needleIndex), 2);
+    QCOMPARE(needleIndex, 1);
+
+    matcher.setMatchOptions(QMultiStringMatcher::WholeWordsOption);
+    QCOMPARE(matcher.matchOptions(), QMultiStringMatcher::WholeWordsOption);
+    QCOMPARE(matcher.indexIn(u"xxBAR", 0, &needleIndex), -1);
+    QCOMPARE(needleIndex, -1);
+    QCOMPARE(matcher.indexIn(u"xx BAR"), 3);
+}
+
+void tst_QMultiStringMatcher::implicitSharing()
+{
+    QMultiStringMatcher matcher({ "foo" });
+    QMultiStringMatcher copy = matcher;
+    copy.setNeedles({ "bar" });
+    QCOMPARE(matcher.indexIn(u"foobar"), 0);
+    QCOMPARE(copy.indexIn(u"foobar"), 3);
+
+    copy.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+
+    QMultiStringMatcher moved = std::move(copy);
+    QCOMPARE(moved.needles(), QStringList{ "bar" });
+    moved.swap(matcher);
+    QCOMPARE(matcher.needles(), QStringList{ "bar" });
+    QCOMPARE(moved.needles(), QStringList{ "foo" });
+}
+
+void tst_QMultiStringMatcher::simple()
+{
+    const QMultiStringMatcher matcher({ "he", "she", "his", "hers", "" });
+    const QVector<Match> expected = {
+        { 1, 3, 1 },    // she
+        { 2, 2, 0 },    // he
+        { 2, 4, 3 },    // hers
+        { 8, 3, 2 },    // his
+    };
+    QCOMPARE(matcher.matches(u"ushers, his"), expected);
+    QCOMPARE(matcher.indexIn(u"ushers, his"), 1);
+    QCOMPARE(matcher.indexIn(u"ushers, his", 2), 2);
+    QCOMPARE(matcher.indexIn(u"ushers, his", 3), 8);
+    QCOMPARE(matcher.indexIn(u"ushers, his", 9), -1);
+    QCOMPARE(matcher.indexIn(u"ushers, his", -5), 1);
+}
+
+void tst_QMultiStringMatcher::overlapping()
+{
+    // duplicate needles and needles that are suffixes of others
+    const QMultiStringMatcher matcher({ "aa", "a", "aa" });
+    const QVector<Match> expected = {
+        { 0, 2, 0 }, { 0, 1, 1 }, { 0, 2, 2 },
+        { 1, 2, 0 }, { 1, 1, 1 }, { 1, 2, 2 },
+        { 2, 1, 1 },
+    };
+    QCOMPARE(matcher.matches(u"aaa"), expected);
+
+    int needleIndex;
+    QCOMPARE(matcher.indexIn(u"baaa", 0, &needleIndex), 1);
+    QCOMPARE(needleIndex, 0);
+}
+
+void tst_QMultiStringMatcher::caseInsensitive()
+{
+    const QMultiStringMatcher matcher({ "straße", "ΣΊΣΥΦΟΣ", QString::fromUtf8("\xf0\x90\x90\x80") },
+                                      Qt::CaseInsensitive);
+    // U+10428 DESERET SMALL LETTER LONG I is the lowercase of U+10400
+    const QString haystack = QStringLiteral("STRAßE σίσυφος \U00010428 Kelvin");
+    const QVector<Match> expected = { { 0, 6, 0 }, { 7, 7, 1 }, { 15, 2, 2 } };
+    QCOMPARE(matcher.matches(haystack), expected);
+
+    // U+212A KELVIN SIGN folds to k
+    const QMultiStringMatcher kelvin({ "kelvin" }, Qt::CaseInsensitive);
+    QCOMPARE(kelvin.indexIn(haystack), 18);
+}
+
+void tst_QMultiStringMatcher::wholeWords()
+{
+    const QMultiStringMatcher matcher({ "for", "if", "int", "++" }, Qt::CaseSensitive,
+                                      QMultiStringMatcher::WholeWordsOption);
+    const QString code = QStringLiteral("for (int i = 0; if_ok(fork); i++) if(ïnt) intégral int_ int");
+    const QVector<Match> expected = {
+        { 0, 3, 0 },    // for
+        { 5, 3, 2 },    // int
+        { 34, 2, 1 },   // if
+        { 56, 3, 2 },   // int
+    };
+    QCOMPARE(matcher.matches(code), expected);
+
+    // the characters around the match count, even outside the searched range
+    QCOMPARE(matcher.indexIn(code, 1), 5);
+    QCOMPARE(matcher.indexIn(QStringView(code).mid(1)), 4);
+
+    // combining marks are part of words
+    const QMultiStringMatcher cafe({ "cafe" }, Qt::CaseSensitive, QMultiStringMatcher::WholeWordsOption);
+    QCOMPARE(cafe.indexIn(u"café"), -1);
+    QCOMPARE(cafe.indexIn(u"cafe!"), 0);
+
+    // and so are letters outside the BMP
+    QCOMPARE(cafe.indexIn(QStringLiteral("\U00010428cafe")), -1);
+    QCOMPARE(cafe.indexIn(QStringLiteral("\U0001F600cafe")), 2);
+}
+
+void tst_QMultiStringMatcher::utf8()
+{
+    const QMultiStringMatcher matcher({ "ß", "€uro", "\U0001F600", "x" }, Qt::CaseInsensitive);
+    const QByteArray haystack = QStringLiteral("ẞ €URO \U0001F600 X").toUtf8();
+    const QVector<Match> expected = { { 0, 3, 0 }, { 4, 6, 1 }, { 11, 4, 2 }, { 16, 1, 3 } };
+    QCOMPARE(matcher.matches(haystack), expected);
+    QCOMPARE(matcher.indexIn(haystack, 1), 4);
+
+    // invalid sequences don't match anything, but don't prevent other matches
+    const QByteArray invalid = "\xff\xc3x\xe2\x82";
+    QCOMPARE(matcher.matches(invalid), QVector<Match>({ { 2, 1, 3 } }));
+
+    const QMultiStringMatcher words({ "uro" }, Qt::CaseSensitive, QMultiStringMatcher::WholeWordsOption);
+    QCOMPARE(words.indexIn(QByteArray("éuro")), -1);
+    QCOMPARE(words.indexIn(QByteArray("€uro")), 3);
+}
+
+void tst_QMultiStringMatcher::indexIn()
+{
+    // a later, shorter needle ending first must not win over an earlier, longer one
+    const QMultiStringMatcher matcher({ "b", "abcdef", "cd" });
+    int needleIndex;
+    QCOMPARE(matcher.indexIn(u"xabcdefb", 0, &needleIndex), 1);
+    QCOMPARE(needleIndex, 1);
+    QCOMPARE(matcher.indexIn(QByteArray("xabcdefb"), 0, &needleIndex), 1);
+    QCOMPARE(needleIndex, 1);
+    QCOMPARE(matcher.indexIn(u"xabcdeg", 0, &needleIndex), 2);
+    QCOMPARE(needleIndex, 0);
+}
+
+void tst_QMultiStringMatcher::bruteForce_data()
+{
+    QTest::addColumn<QString>("alphabet");
+    QTest::addColumn<int>("cs");
+    QTest::addColumn<bool>("wholeWords");
+
+    for (int cs : { int(Qt::CaseSensitive), int(Qt::CaseInsensitive) }) {
+        for (bool wholeWords : { false, true }) {
+            const char *csName = cs == Qt::CaseSensitive ? "cs" : "ci";
+            const char *wwName = wholeWords ? "-words" : "";
+            QTest::addRow("ascii-%s%s", csName, wwName) << QStringLiteral("abAB ") << cs << wholeWords;
+            QTest::addRow("latin1-%s%s", csName, wwName) << QStringLiteral("aé É-ß") << cs << wholeWords;
+            QTest::addRow("surrogates-%s%s", csName, wwName)
+                    << QStringLiteral("a \U00010428\U00010400\U0001F600") << cs << wholeWords;
+        }
+    }
+}
+
+static bool isWordCharacter(uint ucs4)
+{
+    return ucs4 == '_' || QChar::isLetterOrNumber(ucs4) || QChar::isMark(ucs4);
+}
+
+// Compares the matches with a naive search for random needles and haystacks,
+// both for the UTF-16 and the UTF-8 form of the haystack
+void tst_QMultiStringMatcher::bruteForce()
+{
+    QFETCH(QString, alphabet);
+    QFETCH(int, cs);
+    QFETCH(bool, wholeWords);
+    const auto sensitivity = Qt::CaseSensitivity(cs);
+
+    QVector<uint> codePoints;
+    for (uint ucs4 : alphabet.toUcs4())
+        codePoints.append(ucs4);
+
+    QRandomGenerator rng(42);
+    auto randomString = [&](int length) {
+        QVector<uint> result;
+        while (result.size() < length)
+            result.append(codePoints.at(rng.bounded(codePoints.size())));
+        return QString::fromUcs4(result.constData(), result.size());
+    };
+
+    for (int round = 0; round < 50; ++round) {
+        const QString haystack = randomString(rng.bounded(1, 60));
+        QStringList needles;
+        for (int i = 0; i < 8; ++i) {
+            // pieces of the haystack, not cutting surrogate pairs, and random strings
+            qsizetype start = rng.bounded(haystack.size());
+            qsizetype end = qMin(start + rng.bounded(1, 5), qsizetype(haystack.size()));
+            if (haystack.at(start).isLowSurrogate())
+                --start;
+            if (haystack.at(end - 1).isHighSurrogate())
+                ++end;
+            needles.append(i % 2 ? haystack.mid(start, end - start) : randomString(rng.bounded(1, 4)));
+        }
+
+        const QMultiStringMatcher matcher(needles, sensitivity,
+                                          wholeWords ? QMultiStringMatcher::WholeWordsOption
+                                                     : QMultiStringMatcher::NoMatchOption);
+        const QVector<uint> ucs4 = haystack.toUcs4();
+        QVector<Match> expected;
+        for (qsizetype pos = 0; pos < haystack.size(); ++pos) {
+            for (int i = 0; i < needles.size(); ++i) {
+                const QString &needle = needles.at(i);
+                if (QStringView(haystack).mid(pos, needle.size()).compare(needle, sensitivity) != 0
+                    || pos + needle.size() > haystack.size()) {
+                    continue;
+                }
+                if (wholeWords) {
+                    const qsizetype before = QStringView(haystack).left(pos).toUcs4().size();
+                    const qsizetype after = QStringView(haystack).left(pos + needle.size()).toUcs4().size();
+                    if ((before > 0 && isWordCharacter(ucs4.at(before - 1)))
+                        || (after < ucs4.size() && isWordCharacter(ucs4.at(after)))) {
+                        continue;
+                    }
+                }
+                expected.append({ pos, needle.size(), i });
+            }
+        }
+        QCOMPARE(matcher.matches(haystack), expected);
+        int needleIndex;
+        QCOMPARE(matcher.indexIn(haystack, 0, &needleIndex), expected.isEmpty() ? -1 : expected.first().position);
+        QCOMPARE(needleIndex, expected.isEmpty() ? -1 : expected.first().needleIndex);
+
+        QVector<Match> expectedUtf8;
+        for (const Match &match : qAsConst(expected)) {
+            const qsizetype position = QStringView(haystack).left(match.position).toUtf8().size();
+            const qsizetype length = QStringView(haystack).mid(match.position, match.length).toUtf8().size();
+            expectedUtf8.append({ position, length, match.needleIndex });
+        }
+        QCOMPARE(matcher.matches(haystack.toUtf8()), expectedUtf8);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+
+#include "tst_qmultistringmatcher.moc"
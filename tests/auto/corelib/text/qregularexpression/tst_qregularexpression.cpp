@@ -78,6 +78,7 @@ private slots:
     void QStringAndQStringRefEquivalence();
     void threadSafety_data();
     void threadSafety();
+    void sharedCompiledPatterns();
 
     void wildcard_data();
     void wildcard();
@@ -2157,6 +2158,39 @@ void tst_QRegularExpression::threadSafety()
     }
 }
 
+void tst_QRegularExpression::sharedCompiledPatterns()
+{
+    // objects with the same pattern share the compiled pattern; make sure
+    // that the options are taken into account and that errors are reported
+    // the same way for every object
+    const QString pattern = QStringLiteral("^abc$");
+    const QRegularExpression plain(pattern);
+    const QRegularExpression insensitive(pattern, QRegularExpression::CaseInsensitiveOption);
+    const QRegularExpression multiline(pattern, QRegularExpression::MultilineOption);
+    for (int i = 0; i < 2; ++i) {
+        QVERIFY(plain.match("abc").hasMatch());
+        QVERIFY(!plain.match("ABC").hasMatch());
+        QVERIFY(insensitive.match("ABC").hasMatch());
+        QVERIFY(!insensitive.match("x\nABC").hasMatch());
+        QVERIFY(multiline.match("x\nabc").hasMatch());
+        QVERIFY(!multiline.match("x\nABC").hasMatch());
+    }
+
+    const QRegularExpression invalid1(QStringLiteral("a(b"));
+    const QRegularExpression invalid2(QStringLiteral("a(b"));
+    QVERIFY(!invalid1.isValid());
+    QVERIFY(!invalid2.isValid());
+    QCOMPARE(invalid2.errorString(), invalid1.errorString());
+    QCOMPARE(invalid2.patternErrorOffset(), invalid1.patternErrorOffset());
+
+    const QRegularExpression captures1(QStringLiteral("(?<year>\\d+)-(\\d+)"));
+    const QRegularExpression captures2(captures1.pattern());
+    QCOMPARE(captures1.captureCount(), 2);
+    QCOMPARE(captures2.captureCount(), 2);
+    QCOMPARE(captures2.namedCaptureGroups(), captures1.namedCaptureGroups());
+    QCOMPARE(captures2.match("2020-12").captured("year"), QStringLiteral("2020"));
+}
+
 void tst_QRegularExpression::wildcard_data()
 {
     QTest::addColumn<QString>("pattern");
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qregularexpressionset
+QT = core testlib
+SOURCES = tst_qregularexpressionset.cpp
@@ -0,0 +1,275 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/QRegularExpressionSet>
+
+class tst_QRegularExpressionSet : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultConstructed();
+    void addAndAccess();
+    void implicitSharing();
+    void matchingIndexes_data();
+    void matchingIndexes();
+    void firstMatchingIndex();
+    void invalidExpressions();
+    void modifyAfterMatching();
+    void manyExpressions();
+};
+
+static QVector<int> bruteForce(const QVector<QRegularExpression> &expressions, const QString &subject)
+{
+    QVector<int> result;
+    for (int i = 0; i < expressions.size(); ++i) {
+        if (expressions.at(i).match(subject).hasMatch())
+            result.append(i);
+    }
+    return result;
+}
+
+void tst_QRegularExpressionSet::defaultConstructed()
+{
+    QRegularExpressionSet set;
+    QVERIFY(set.isEmpty());
+    QCOMPARE(set.size(), 0);
+    QVERIFY(set.isValid());
+    QVERIFY(set.matchingIndexes("anything").isEmpty());
+    QCOMPARE(set.firstMatchingIndex("anything"), -1);
+    QVERIFY(!set.hasMatch(QString()));
+}
+
+void tst_QRegularExpressionSet::addAndAccess()
+{
+    QRegularExpressionSet set;
+    QCOMPARE(set.add(QRegularExpression("abc")), 0);
+    QCOMPARE(set.add(QRegularExpression("def", QRegularExpression::CaseInsensitiveOption)), 1);
+    QCOMPARE(set.size(), 2);
+    QCOMPARE(set.at(0), QRegularExpression("abc"));
+    QCOMPARE(set.at(1), QRegularExpression("def", QRegularExpression::CaseInsensitiveOption));
+    QCOMPARE(set.expressions().size(), 2);
+
+    const QRegularExpressionSet fromVector(set.expressions());
+    QCOMPARE(fromVector.expressions(), set.expressions());
+
+    set.clear();
+    QVERIFY(set.isEmpty());
+    QCOMPARE(fromVector.size(), 2);
+}
+
+void tst_QRegularExpressionSet::implicitSharing()
+{
+    QRegularExpressionSet set;
+    set.add(QRegularExpression("foo"));
+    QVERIFY(set.hasMatch("a foo"));
+
+    QRegularExpressionSet copy = set;
+    copy.add(QRegularExpression("bar"));
+    QCOMPARE(set.size(), 1);
+    QCOMPARE(copy.size(), 2);
+    QVERIFY(!set.hasMatch("bar"));
+    QVERIFY(copy.hasMatch("bar"));
+
+    QRegularExpressionSet moved = std::move(copy);
+    QCOMPARE(moved.size(), 2);
+    moved.swap(set);
+    QCOMPARE(set.size(), 2);
+    QCOMPARE(moved.size(), 1);
+}
+
+void tst_QRegularExpressionSet::matchingIndexes_data()
+{
+    QTest::addColumn<QString>("subject");
+
+    QTest::newRow("empty") << QString();
+    QTest::newRow("plain") << QStringLiteral("the quick brown fox jumps over the lazy dog");
+    QTest::newRow("log") << QStringLiteral("2020-01-01 ERROR [net] connection refused (errno 111)");
+    QTest::newRow("case") << QStringLiteral("CONNECTION Refused; Ошибка СЕТИ");
+    QTest::newRow("braces") << QStringLiteral("a{b} x{2,} y{,3} z{ {}");
+    QTest::newRow("optional") << QStringLiteral("colour color colr");
+    QTest::newRow("quoted") << QStringLiteral("a.b*c a+b (x) [y] |z|");
+    QTest::newRow("surrogates") << QString::fromUtf8("emoji \xF0\x9F\x98\x80 here and \xF0\x9F\x98\x80\xF0\x9F\x98\x81");
+    QTest::newRow("escapes") << QStringLiteral("tab\there x41 A caret^dollar$ back\\slash");
+    QTest::newRow("multiline") << QStringLiteral("first line\nsecond LINE\r\nthird");
+    QTest::newRow("repeated") << QStringLiteral("aaaaabbbbbabababab");
+}
+
+void tst_QRegularExpressionSet::matchingIndexes()
+{
+    QFETCH(QString, subject);
+
+    // patterns chosen to exercise the required-literal extraction
+    static const struct {
+        const char *pattern;
+        QRegularExpression::PatternOptions options;
+    } patterns[] = {
+        { "fox", {} },
+        { "FOX", {} },
+        { "FOX", QRegularExpression::CaseInsensitiveOption },
+        { "(?i)connection refused", {} },
+        { "(?i)ошибка", {} },
+        { "error|refused", {} },
+        { "^\\d{4}-\\d\\d-\\d\\d ERROR", {} },
+        { "colou?r", {} },
+        { "colou*r", {} },
+        { "colou+r", {} },
+        { "colou{0,1}r", {} },
+        { "colou{,1}r", {} },
+        { "colou{1}r", {} },
+        { "x{2,}", {} },
+        { "x\\{2,\\}", {} },
+        { "y{,3}", {} },
+        { "z{ ", {} },
+        { "a\\.b\\*c", {} },
+        { "\\Qa+b (x)\\E", {} },
+        { "\\(x\\) \\[y\\]", {} },
+        { "\\|z\\|", {} },
+        { "[abc]+ b", {} },
+        { "[]y] ", {} },
+        { "[^\\]]+\\]", {} },
+        { "[[:alpha:]]+ here", {} },
+        { "(quick|slow) brown", {} },
+        { "(?:quick|slow)? brown fox", {} },
+        { "(?#comment)lazy", {} },
+        { "(?s)first.line", {} },
+        { "(?m)^second", {} },
+        { "(?-i)the", {} },
+        { "(*CR)third", {} },
+        { "(?i:LINE)", {} },
+        { "tab\\there", {} },
+        { "\\x41", {} },
+        { "\\x{41} caret", {} },
+        { "\\p{Lu}RROR", {} },
+        { "back\\\\slash", {} },
+        { "caret\\^dollar\\$", {} },
+        { "\\bdog\\b", {} },
+        { "(?<word>ab)\\k<word>", {} },
+        { "(a)\\1", {} },
+        { "\\cIhere", {} },
+        { "a+?b", {} },
+        { "a*+b", {} },
+        { "\xF0\x9F\x98\x80?here", {} },
+        { "\xF0\x9F\x98\x80\xF0\x9F\x98\x81", {} },
+        { "\\x{1F600}", {} },
+        { "jumps # comment", QRegularExpression::ExtendedPatternSyntaxOption },
+        { "LINE$", QRegularExpression::MultilineOption },
+        { "", {} },
+        { ".", {} },
+    };
+
+    QVector<QRegularExpression> expressions;
+    for (const auto &p : patterns) {
+        const QRegularExpression re(QString::fromUtf8(p.pattern), p.options);
+        QVERIFY2(re.isValid(), qPrintable(re.pattern() + QLatin1String(": ") + re.errorString()));
+        expressions.append(re);
+    }
+
+    const QRegularExpressionSet set(expressions);
+    const QVector<int> expected = bruteForce(expressions, subject);
+    QCOMPARE(set.matchingIndexes(subject), expected);
+    QCOMPARE(set.firstMatchingIndex(subject), expected.isEmpty() ? -1 : expected.first());
+    QCOMPARE(set.hasMatch(subject), !expected.isEmpty());
+}
+
+void tst_QRegularExpressionSet::firstMatchingIndex()
+{
+    QRegularExpressionSet set;
+    set.add(QRegularExpression("world"));
+    set.add(QRegularExpression("hello"));
+    set.add(QRegularExpression("hel+o"));
+    QCOMPARE(set.firstMatchingIndex("hello"), 1);
+    QCOMPARE(set.firstMatchingIndex("helllo"), 2);
+    QCOMPARE(set.firstMatchingIndex("hello world"), 0);
+    QCOMPARE(set.firstMatchingIndex("goodbye"), -1);
+}
+
+void tst_QRegularExpressionSet::invalidExpressions()
+{
+    QRegularExpressionSet set;
+    set.add(QRegularExpression("valid"));
+    set.add(QRegularExpression("invalid("));
+    QVERIFY(!set.isValid());
+    QCOMPARE(set.matchingIndexes("valid invalid("), QVector<int>{ 0 });
+}
+
+void tst_QRegularExpressionSet::modifyAfterMatching()
+{
+    QRegularExpressionSet set;
+    set.add(QRegularExpression("alpha"));
+    QVERIFY(!set.hasMatch("beta"));
+    set.add(QRegularExpression("beta"));
+    QCOMPARE(set.matchingIndexes("alpha beta"), QVector<int>({ 0, 1 }));
+
+    const QRegularExpressionSet copy = set;
+    set.clear();
+    set.add(QRegularExpression("gamma"));
+    QCOMPARE(set.matchingIndexes("alpha beta gamma"), QVector<int>{ 0 });
+    QCOMPARE(copy.matchingIndexes("alpha beta gamma"), QVector<int>({ 0, 1 }));
+}
+
+void tst_QRegularExpressionSet::manyExpressions()
+{
+    QVector<QRegularExpression> expressions;
+    for (int i = 0; i < 2000; ++i) {
+        const QString n = QString::number(i);
+        switch (i % 4) {
+        case 0:
+            expressions.append(QRegularExpression(QLatin1String("id=") + n + QLatin1String("\\b")));
+            break;
+        case 1:
+            expressions.append(QRegularExpression(QLatin1String("USER") + n + QLatin1String("$"),
+                                                  QRegularExpression::CaseInsensitiveOption));
+            break;
+        case 2:
+            expressions.append(QRegularExpression(QLatin1String("code ") + n + QLatin1String(" \\w+")));
+            break;
+        case 3:
+            expressions.append(QRegularExpression(QLatin1String("(a|b)") + n));
+            break;
+        }
+    }
+    const QRegularExpressionSet set(expressions);
+    set.optimize();
+
+    const QString subjects[] = {
+        QStringLiteral("request id=40 from user1"),
+        QStringLiteral("request id=400 from user1"),
+        QStringLiteral("code 42 failed code 1998 ok"),
+        QStringLiteral("b1999 a3"),
+        QStringLiteral("nothing to see"),
+    };
+    for (const QString &subject : subjects)
+        QCOMPARE(set.matchingIndexes(subject), bruteForce(expressions, subject));
+}
+
+QTEST_APPLESS_MAIN(tst_QRegularExpressionSet)
+
+#include "tst_qregularexpressionset.moc"
@@ -596,6 +596,7 @@ private slots:
     void assignQChar();
     void isRightToLeft_data();
     void isRightToLeft();
+    void isLatin1();
     void unicodeStrings();
 };
 
@@ -7025,6 +7026,23 @@ void tst_QString::isRightToLeft()
     QCOMPARE(unicode.isRightToLeft(), rtl);
 }
 
+void tst_QString::isLatin1()
+{
+    // cover the vectorized code paths as well as the tails
+    for (int size = 0; size < 80; ++size) {
+        QString latin1;
+        for (int i = 0; i < size; ++i)
+            latin1 += QChar(0x20 + i * 3 % 0xe0);
+        QVERIFY2(QtPrivate::isLatin1(latin1), QByteArray::number(size));
+
+        for (int i = 0; i < size; ++i) {
+            QString s = latin1;
+            s[i] = QChar(0x100 + i);
+            QVERIFY2(!QtPrivate::isLatin1(s), QByteArray::number(size) + ' ' + QByteArray::number(i));
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "tst_qstring.moc"
@@ -41,6 +41,8 @@ private slots:
     void setCaseSensitivity_data();
     void setCaseSensitivity();
     void assignOperator();
+    void bruteForce_data();
+    void bruteForce();
 };
 
 void tst_QStringMatcher::qstringmatcher()
@@ -148,6 +150,71 @@ void tst_QStringMatcher::assignOperator()
     QCOMPARE(m2.indexIn(hayStack), 3);
 }
 
+void tst_QStringMatcher::bruteForce_data()
+{
+    QTest::addColumn<QString>("alphabet");
+    QTest::addColumn<int>("cs");
+
+    for (int cs : { int(Qt::CaseSensitive), int(Qt::CaseInsensitive) }) {
+        const char *csName = cs == Qt::CaseSensitive ? "cs" : "ci";
+        QTest::addRow("ascii-%s", csName) << QStringLiteral("abAB") << cs;
+        QTest::addRow("k-and-s-%s", csName) << QStringLiteral("kKsS\u212a\u017fx") << cs;
+        QTest::addRow("latin1-%s", csName) << QStringLiteral("\u00e5\u00c5\u212b\u00df\u1e9e\u00ff\u0178\u00b5\u03bc\u039c")
+                                           << cs;
+        QTest::addRow("non-latin1-%s", csName) << QStringLiteral("\u0434\u0414\u03c3\u03a3\u03c2") << cs;
+        QTest::addRow("surrogates-%s", csName)
+                << QStringLiteral("a\U00010428\U00010400") << cs;    // DESERET SMALL/CAPITAL LONG I
+    }
+}
+
+// Compares the result of indexIn() with a naive search for all needles up to
+// a certain length over a few small alphabets, at all starting positions
+void tst_QStringMatcher::bruteForce()
+{
+    QFETCH(QString, alphabet);
+    QFETCH(int, cs);
+    const auto sensitivity = Qt::CaseSensitivity(cs);
+
+    QRandomGenerator rng(42);
+    auto randomString = [&](int length) {
+        QString result;
+        while (result.size() < length) {
+            const int i = rng.bounded(alphabet.size());
+            if (alphabet.at(i).isSurrogate()) {
+                // keep the pairs together (the alphabet only contains pairs)
+                const int high = alphabet.at(i).isHighSurrogate() ? i : i - 1;
+                result += alphabet.mid(high, 2);
+            } else {
+                result += alphabet.at(i);
+            }
+        }
+        return result;
+    };
+
+    for (int round = 0; round < 200; ++round) {
+        const QString haystack = randomString(rng.bounded(1, 80));
+        int start = rng.bounded(haystack.size());
+        if (haystack.at(start).isLowSurrogate())
+            --start;    // the matchers look at the preceding high surrogate, compare() doesn't
+        const QString needle = haystack.mid(start, rng.bounded(1, 12));
+        const QString other = randomString(needle.size());
+        for (const QString &n : { needle, other }) {
+            QStringMatcher matcher(n, sensitivity);
+            for (int from = 0; from <= haystack.size(); ++from) {
+                int expected = -1;
+                for (int i = from; i + n.size() <= haystack.size(); ++i) {
+                    if (QStringView(haystack).mid(i, n.size()).compare(n, sensitivity) == 0) {
+                        expected = i;
+                        break;
+                    }
+                }
+                QCOMPARE(matcher.indexIn(haystack, from), expected);
+                QCOMPARE(haystack.indexOf(n, from, sensitivity), expected);
+            }
+        }
+    }
+}
+
 QTEST_MAIN(tst_QStringMatcher)
 #include "tst_qstringmatcher.moc"
 
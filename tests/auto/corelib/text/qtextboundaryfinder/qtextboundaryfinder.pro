@@ -1,6 +1,6 @@
 CONFIG += testcase
 TARGET = tst_qtextboundaryfinder
-QT = core testlib
+QT = core-private testlib
 SOURCES = tst_qtextboundaryfinder.cpp
 
 TESTDATA += data
@@ -29,6 +29,8 @@
 #include <QtTest/QtTest>
 
 #include <qtextboundaryfinder.h>
+#include <private/qunicodetables_p.h>
+#include <private/qunicodetools_p.h>
 #include <qtextcodec.h>
 #include <qfile.h>
 #include <qdebug.h>
@@ -65,6 +67,9 @@ private slots:
     void isAtSoftHyphen_data();
     void isAtSoftHyphen();
     void thaiLineBreak();
+    void updateCharAttributes_data();
+    void updateCharAttributes();
+    void latin1GraphemeBreaks();
 };
 
 
@@ -628,6 +633,27 @@ void tst_QTextBoundaryFinder::lineBoundaries_manual_data()
         QTest::newRow("x(AL)x(BA)+(AL)x(BA)+(AL)x(AL)+") << testString << expectedBreakPositions
                                                          << expectedMandatoryBreakPositions;
     }
+
+    // a number sequence (LB25) doesn't extend past a mandatory break
+    {
+        QString testString(QString::fromUtf8("1\n23 a"));
+        QList<int> expectedBreakPositions, expectedMandatoryBreakPositions;
+        expectedBreakPositions << 0 << 2 << 5 << 6;
+        expectedMandatoryBreakPositions << 0 << 2 << 6;
+
+        QTest::newRow("x(NU)x(LF)!(NU)x(NU)x(SP)+(AL)!") << testString << expectedBreakPositions
+                                                          << expectedMandatoryBreakPositions;
+    }
+    {
+        QChar s[] = { 0x0024, 0x000A, 0x4E00, 0x0031, 0x0032 };
+        QString testString(s, sizeof(s)/sizeof(s[0]));
+        QList<int> expectedBreakPositions, expectedMandatoryBreakPositions;
+        expectedBreakPositions << 0 << 2 << 3 << 5;
+        expectedMandatoryBreakPositions << 0 << 2 << 5;
+
+        QTest::newRow("x(PR)x(LF)!(ID)+(NU)x(NU)!") << testString << expectedBreakPositions
+                                                    << expectedMandatoryBreakPositions;
+    }
 }
 
 void tst_QTextBoundaryFinder::lineBoundaries_manual()
@@ -850,6 +876,114 @@ void tst_QTextBoundaryFinder::thaiLineBreak()
 #endif
 }
 
+static QVector<QUnicodeTools::ScriptItem> scriptItems(const QString &text)
+{
+    QVector<uchar> scripts(text.size());
+    QUnicodeTools::initScripts(reinterpret_cast<const ushort *>(text.constData()), text.size(),
+                               scripts.data());
+    QVector<QUnicodeTools::ScriptItem> items;
+    for (int i = 0; i < text.size(); ++i) {
+        if (i == 0 || scripts.at(i) != scripts.at(i - 1))
+            items.append({ i, scripts.at(i) });
+    }
+    return items;
+}
+
+static QByteArray charAttributes(const QString &text, const QCharAttributes *attributes)
+{
+    return QByteArray(reinterpret_cast<const char *>(attributes),
+                      (text.size() + 1) * int(sizeof(QCharAttributes)));
+}
+
+void tst_QTextBoundaryFinder::updateCharAttributes_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<int>("position");
+    QTest::addColumn<int>("charsRemoved");
+    QTest::addColumn<QString>("added");
+
+    const QString text = QString::fromUtf8("First line, 12.5%.\nSecond \"line\". Third?\r\nLast one\u2029end");
+    QTest::newRow("insert-in-paragraph") << text << 8 << 0 << QStringLiteral("x");
+    QTest::newRow("insert-at-start") << text << 0 << 0 << QStringLiteral("Zero. ");
+    QTest::newRow("insert-at-end") << text << text.size() << 0 << QStringLiteral(" 42");
+    QTest::newRow("insert-after-separator") << text << 19 << 0 << QStringLiteral("A ");
+    QTest::newRow("insert-before-separator") << text << 18 << 0 << QStringLiteral(" 7");
+    QTest::newRow("insert-separator") << text << 25 << 0 << QStringLiteral("\n");
+    QTest::newRow("remove-separator") << text << 18 << 1 << QString();
+    QTest::newRow("join-number") << text << 18 << 1 << QStringLiteral("3");
+    QTest::newRow("replace-across-paragraphs") << text << 10 << 30 << QStringLiteral(", ok");
+    QTest::newRow("split-crlf") << text << 42 << 0 << QStringLiteral("x");
+    QTest::newRow("remove-lf-of-crlf") << text << 42 << 1 << QString();
+    QTest::newRow("insert-lf-after-cr") << QStringLiteral("One\rTwo") << 4 << 0 << QStringLiteral("\n");
+    QTest::newRow("insert-surrogates") << text << 26 << 0 << QString::fromUtf8("\U0001F600\U0001F1E6\U0001F1E6");
+    QTest::newRow("insert-combining") << text << 1 << 0 << QString::fromUtf8("\u0301");
+    QTest::newRow("insert-non-latin") << text << 20 << 0 << QString::fromUtf8("\u0393\u03b5\u03b9\u03ac ");
+    QTest::newRow("remove-all") << text << 0 << text.size() << QString();
+    QTest::newRow("replace-all") << text << 0 << text.size() << QStringLiteral("New text.");
+    QTest::newRow("from-empty") << QString() << 0 << 0 << QStringLiteral("New text.\nAnd more.");
+}
+
+void tst_QTextBoundaryFinder::updateCharAttributes()
+{
+    QFETCH(QString, text);
+    QFETCH(int, position);
+    QFETCH(int, charsRemoved);
+    QFETCH(QString, added);
+
+    const QUnicodeTools::CharAttributeOptions options(QUnicodeTools::GraphemeBreaks
+                                                      | QUnicodeTools::WordBreaks
+                                                      | QUnicodeTools::SentenceBreaks
+                                                      | QUnicodeTools::LineBreaks
+                                                      | QUnicodeTools::WhiteSpaces);
+
+    QVector<QUnicodeTools::ScriptItem> items = scriptItems(text);
+    QVector<QCharAttributes> attributes(qMax(text.size(), text.size() - charsRemoved + added.size()) + 1);
+    QUnicodeTools::initCharAttributes(reinterpret_cast<const ushort *>(text.constData()), text.size(),
+                                      items.constData(), items.size(), attributes.data(), options);
+
+    text.replace(position, charsRemoved, added);
+    items = scriptItems(text);
+    QUnicodeTools::updateCharAttributes(reinterpret_cast<const ushort *>(text.constData()), text.size(),
+                                        position, charsRemoved, added.size(),
+                                        items.constData(), items.size(), attributes.data(), options);
+
+    QVector<QCharAttributes> expected(text.size() + 1);
+    QUnicodeTools::initCharAttributes(reinterpret_cast<const ushort *>(text.constData()), text.size(),
+                                      items.constData(), items.size(), expected.data(), options);
+    if (!text.isEmpty())
+        QCOMPARE(charAttributes(text, attributes.constData()), charAttributes(text, expected.constData()));
+}
+
+void tst_QTextBoundaryFinder::latin1GraphemeBreaks()
+{
+    // the Latin-1 fast path in QUnicodeTools relies on this
+    for (uint ucs4 = 0; ucs4 <= 0xff; ++ucs4) {
+        switch (QUnicodeTables::graphemeBreakClass(ucs4)) {
+        case QUnicodeTables::GraphemeBreak_Any:
+        case QUnicodeTables::GraphemeBreak_CR:
+        case QUnicodeTables::GraphemeBreak_LF:
+        case QUnicodeTables::GraphemeBreak_Control:
+            break;
+        default:
+            QFAIL(qPrintable(QString::number(ucs4, 16)));
+        }
+    }
+
+    // compare against the result for the same text outside of Latin-1
+    QString text;
+    for (ushort ch = 0; ch <= 0xff; ++ch) {
+        text += QChar(ch);
+        text += QLatin1String("\r\n\n\r");
+    }
+    QString nonLatin1 = text + QChar(0x0100);
+    QVector<QCharAttributes> latin1Attributes(text.size() + 1);
+    QVector<QCharAttributes> attributes(nonLatin1.size() + 1);
+    QUnicodeTools::initCharAttributes(reinterpret_cast<const ushort *>(text.constData()), text.size(),
+                                      nullptr, 0, latin1Attributes.data(), QUnicodeTools::GraphemeBreaks);
+    QUnicodeTools::initCharAttributes(reinterpret_cast<const ushort *>(nonLatin1.constData()), nonLatin1.size(),
+                                      nullptr, 0, attributes.data(), QUnicodeTools::GraphemeBreaks);
+    QCOMPARE(charAttributes(text, latin1Attributes.constData()), charAttributes(text, attributes.constData()));
+}
 
 QTEST_MAIN(tst_QTextBoundaryFinder)
 #include "tst_qtextboundaryfinder.moc"
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qutf8string
+QT = core testlib
+SOURCES = tst_qutf8string.cpp
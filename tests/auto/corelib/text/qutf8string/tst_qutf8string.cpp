@@ -0,0 +1,562 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/QBuffer>
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonValue>
+#include <QtCore/QTextCodec>
+#include <QtCore/QTextStream>
+#include <QtCore/QUrl>
+#include <QtCore/QUtf8String>
+
+QT_BEGIN_NAMESPACE
+namespace QTest {
+template <> char *toString(const QUtf8String &str)
+{
+    return toPrettyUnicode(str.toString());
+}
+}
+QT_END_NAMESPACE
+
+typedef QList<QByteArray> ByteArrayList;
+
+static QList<QUtf8String> toUtf8StringList(const ByteArrayList &list)
+{
+    QList<QUtf8String> result;
+    for (const QByteArray &ba : list)
+        result.append(QUtf8String(ba));
+    return result;
+}
+
+class tst_QUtf8String : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void construction();
+    void implicitSharing();
+    void isValidUtf8_data();
+    void isValidUtf8();
+    void compare_data();
+    void compare();
+    void search();
+    void trimmed_data();
+    void trimmed();
+    void split_data();
+    void split();
+    void splitSupplementary();
+    void arg();
+    void multiArg();
+    void numbers();
+    void qstringArg();
+    void hashAndStreams();
+    void jsonValue();
+    void jsonDocument();
+    void textStream_data();
+    void textStream();
+    void textStreamMixedOutput();
+    void textStreamRead();
+    void url();
+};
+
+void tst_QUtf8String::construction()
+{
+    QUtf8String null;
+    QVERIFY(null.isNull());
+    QVERIFY(null.isEmpty());
+    QCOMPARE(null.size(), 0);
+
+    QUtf8String empty("");
+    QVERIFY(!empty.isNull());
+    QVERIFY(empty.isEmpty());
+
+    const QUtf8String s("grüße");
+    QCOMPARE(s.size(), 7);      // bytes, not characters
+    QCOMPARE(s.toString(), QString::fromUtf8("grüße"));
+    QCOMPARE(QUtf8String("grüße", 3), QUtf8String("gr\xc3"));
+
+    QCOMPARE(QUtf8String(QStringView(u"grüße")), s);
+    QVERIFY(QUtf8String(QStringView()).isNull());
+    QVERIFY(QUtf8String(QString()).isNull());
+    QVERIFY(!QUtf8String(QString("")).isNull());
+
+    QCOMPARE(QUtf8String(QLatin1String("abc")), QUtf8String("abc"));
+    QCOMPARE(QUtf8String(QLatin1String("gr\xfc\xdf" "e")), s);
+    QVERIFY(QUtf8String(QLatin1String()).isNull());
+
+    static const char raw[] = "raw data";
+    const QUtf8String fromRaw = QUtf8String::fromRawData(raw, 3);
+    QCOMPARE(fromRaw.constData(), raw);
+    QCOMPARE(fromRaw, QUtf8String("raw"));
+}
+
+void tst_QUtf8String::implicitSharing()
+{
+    const QByteArray ba("shared data");
+    const QUtf8String s(ba);
+    QCOMPARE(s.constData(), ba.constData());
+    QCOMPARE(s.toByteArray().constData(), ba.constData());
+
+    QUtf8String copy = s;
+    QCOMPARE(copy.constData(), s.constData());
+    copy.append('!');
+    QVERIFY(copy.constData() != s.constData());
+    QCOMPARE(s, QUtf8String("shared data"));
+    QCOMPARE(copy, QUtf8String("shared data!"));
+
+    // nothing to trim: the same data is returned
+    QCOMPARE(s.trimmed().constData(), s.constData());
+}
+
+void tst_QUtf8String::isValidUtf8_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<bool>("valid");
+
+    QTest::newRow("null") << QByteArray() << true;
+    QTest::newRow("ascii") << QByteArray("hello") << true;
+    QTest::newRow("2-byte") << QByteArray("\xc3\xa9") << true;
+    QTest::newRow("3-byte") << QByteArray("\xe2\x82\xac") << true;
+    QTest::newRow("4-byte") << QByteArray("\xf0\x9f\x98\x80") << true;
+    QTest::newRow("truncated") << QByteArray("\xe2\x82") << false;
+    QTest::newRow("overlong") << QByteArray("\xc0\xaf") << false;
+    QTest::newRow("surrogate") << QByteArray("\xed\xa0\x80") << false;
+    QTest::newRow("latin1") << QByteArray("caf\xe9") << false;
+}
+
+void tst_QUtf8String::isValidUtf8()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(bool, valid);
+    QCOMPARE(QUtf8String(data).isValidUtf8(), valid);
+}
+
+void tst_QUtf8String::compare_data()
+{
+    QTest::addColumn<QByteArray>("lhs");
+    QTest::addColumn<QByteArray>("rhs");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("equal") << QByteArray("abc") << QByteArray("abc") << 0;
+    QTest::newRow("less") << QByteArray("abc") << QByteArray("abd") << -1;
+    QTest::newRow("prefix") << QByteArray("ab") << QByteArray("abc") << -1;
+    QTest::newRow("greater") << QByteArray("\xc3\xa9") << QByteArray("z") << 1;
+    // code point order: U+FFFD before U+1F600, although its UTF-16 code unit is larger
+    QTest::newRow("supplementary") << QByteArray("\xef\xbf\xbd") << QByteArray("\xf0\x9f\x98\x80") << -1;
+}
+
+void tst_QUtf8String::compare()
+{
+    QFETCH(QByteArray, lhs);
+    QFETCH(QByteArray, rhs);
+    QFETCH(int, expected);
+
+    const QUtf8String l(lhs);
+    const QUtf8String r(rhs);
+    QCOMPARE(qBound(-1, l.compare(r), 1), expected);
+    QCOMPARE(qBound(-1, l.compare(QString::fromUtf8(rhs)), 1), expected);
+    QCOMPARE(l == r, expected == 0);
+    QCOMPARE(l != r, expected != 0);
+    QCOMPARE(l < r, expected < 0);
+    QCOMPARE(l <= r, expected <= 0);
+    QCOMPARE(l > r, expected > 0);
+    QCOMPARE(l >= r, expected >= 0);
+    QCOMPARE(l == QString::fromUtf8(rhs), expected == 0);
+    QCOMPARE(QString::fromUtf8(rhs) != l, expected != 0);
+    QCOMPARE(l == rhs.constData(), expected == 0);
+    QCOMPARE(lhs.constData() != r, expected != 0);
+}
+
+void tst_QUtf8String::search()
+{
+    const QUtf8String s("€uro, €uro and dollar");
+    QCOMPARE(s.indexOf(QUtf8String("€")), 0);
+    QCOMPARE(s.indexOf(QUtf8String("€"), 1), 8);
+    QCOMPARE(s.lastIndexOf(QUtf8String("€")), 8);
+    QCOMPARE(s.indexOf(','), 6);
+    QCOMPARE(s.lastIndexOf('o'), 20);
+    QCOMPARE(s.indexOf("yen"), -1);
+    QVERIFY(s.contains("dollar"));
+    QVERIFY(!s.contains('$'));
+    QVERIFY(s.startsWith("€"));
+    QVERIFY(s.endsWith('r'));
+    QCOMPARE(s.left(6), QUtf8String("€uro"));
+    QCOMPARE(s.mid(8, 6), QUtf8String("€uro"));
+    QCOMPARE(s.right(6), QUtf8String("dollar"));
+    QCOMPARE(s.chopped(11), QUtf8String("€uro, €uro"));
+
+    QUtf8String r = s;
+    r.replace("€", "$");
+    QCOMPARE(r, QUtf8String("$uro, $uro and dollar"));
+    QCOMPARE(QUtf8String("a") + "ö" + QUtf8String("b"), QUtf8String("aöb"));
+}
+
+void tst_QUtf8String::trimmed_data()
+{
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::newRow("null") << QByteArray() << QByteArray();
+    QTest::newRow("nothing") << QByteArray("ä b") << QByteArray("ä b");
+    QTest::newRow("ascii") << QByteArray(" \t\nä b\r\n ") << QByteArray("ä b");
+    QTest::newRow("all-spaces") << QByteArray(" \xc2\xa0 ") << QByteArray("");
+    QTest::newRow("nbsp") << QByteArray("\xc2\xa0x\xc2\xa0") << QByteArray("x");
+    QTest::newRow("ideographic") << QByteArray("\xe3\x80\x80\xe6\x97\xa5\xe3\x80\x80") << QByteArray("\xe6\x97\xa5");
+    QTest::newRow("non-space-multibyte") << QByteArray("\xc2\xa9 \xc2\xa9") << QByteArray("\xc2\xa9 \xc2\xa9");
+    QTest::newRow("invalid-tail") << QByteArray(" x\xa0") << QByteArray("x\xa0");
+}
+
+void tst_QUtf8String::trimmed()
+{
+    QFETCH(QByteArray, input);
+    QFETCH(QByteArray, expected);
+
+    const QUtf8String result = QUtf8String(input).trimmed();
+    QCOMPARE(result.toByteArray(), expected);
+    QCOMPARE(result.isNull(), expected.isNull());
+    if (QUtf8String(input).isValidUtf8())
+        QCOMPARE(result.toString(), QString::fromUtf8(input).trimmed());
+}
+
+void tst_QUtf8String::split_data()
+{
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<QByteArray>("sep");
+    QTest::addColumn<bool>("skipEmpty");
+
+    QTest::newRow("simple") << QByteArray("a,b,,c") << QByteArray(",") << false;
+    QTest::newRow("simple-skip") << QByteArray("a,b,,c") << QByteArray(",") << true;
+    QTest::newRow("multibyte-sep") << QByteArray("ä→ö→→ü") << QByteArray("→") << false;
+    QTest::newRow("multibyte-sep-skip") << QByteArray("→ä→ö→→ü→") << QByteArray("→") << true;
+    QTest::newRow("no-match") << QByteArray("äöü") << QByteArray(";") << false;
+    QTest::newRow("empty-input") << QByteArray("") << QByteArray(";") << false;
+    QTest::newRow("empty-sep") << QByteArray("aä€") << QByteArray("") << false;
+    QTest::newRow("empty-sep-skip") << QByteArray("aä€") << QByteArray("") << true;
+}
+
+void tst_QUtf8String::split()
+{
+    QFETCH(QByteArray, input);
+    QFETCH(QByteArray, sep);
+    QFETCH(bool, skipEmpty);
+
+    const Qt::SplitBehavior behavior = skipEmpty ? Qt::SkipEmptyParts : Qt::KeepEmptyParts;
+    const QList<QUtf8String> result = QUtf8String(input).split(QUtf8String(sep), behavior);
+
+    // the same as splitting the UTF-16 string
+    const QStringList expected = QString::fromUtf8(input).split(QString::fromUtf8(sep), behavior);
+    QStringList actual;
+    for (const QUtf8String &s : result)
+        actual.append(s.toString());
+    QCOMPARE(actual, expected);
+
+    if (sep.size() == 1)
+        QCOMPARE(QUtf8String(input).split(sep.at(0), behavior), result);
+}
+
+void tst_QUtf8String::splitSupplementary()
+{
+    // unlike QString, an empty separator never splits a character in two
+    const QList<QUtf8String> expected = toUtf8StringList({ "", "a", "😀", "b", "" });
+    QCOMPARE(QUtf8String("a😀b").split(QUtf8String("")), expected);
+}
+
+void tst_QUtf8String::arg()
+{
+    QCOMPARE(QUtf8String("%1 grüßt %2").arg("Jörg"), QUtf8String("Jörg grüßt %2"));
+    QCOMPARE(QUtf8String("%2 %1 %2").arg(QUtf8String("ü")), QUtf8String("%2 ü %2"));
+    QCOMPARE(QUtf8String("[%1]").arg("äb", 4), QUtf8String("[  äb]"));
+    QCOMPARE(QUtf8String("[%1]").arg("äb", -4, QChar(0x2022)), QUtf8String("[äb••]"));
+    QCOMPARE(QUtf8String("%1 und %L1").arg("€"), QUtf8String("€ und €"));
+    QCOMPARE(QUtf8String("%1%").arg("%2"), QUtf8String("%2%"));
+    QCOMPARE(QUtf8String("%1 %2").arg("x").arg("y"), QUtf8String("x y"));
+
+    QCOMPARE(QUtf8String("ä%1ö").arg(42), QUtf8String("ä42ö"));
+    QCOMPARE(QUtf8String("%1").arg(-7, 4, 10, QLatin1Char('0')), QUtf8String("-007"));
+    QCOMPARE(QUtf8String("%1").arg(255, 0, 16), QUtf8String("ff"));
+    QCOMPARE(QUtf8String("%1").arg(Q_UINT64_C(18446744073709551615)), QUtf8String("18446744073709551615"));
+    QCOMPARE(QUtf8String("%1|%L1").arg(1234567), QUtf8String("1234567|")
+             + QUtf8String(QLocale().toString(1234567)));
+    QCOMPARE(QUtf8String("π ≈ %1").arg(3.14159, 0, 'f', 2), QUtf8String("π ≈ 3.14"));
+    QCOMPARE(QUtf8String("%1").arg(1.5, 6, 'g', -1, QLatin1Char('*')), QUtf8String("***1.5"));
+
+    // the same results as QString
+    const char *patterns[] = { "%1", "a%1b%1c", "%L1 %1", "%0 %1 %10", "%%1%", "%1%2" };
+    for (const char *pattern : patterns) {
+        const QString p = QString::fromUtf8(pattern);
+        QCOMPARE(QUtf8String(pattern).arg("§").toString(), p.arg(QString::fromUtf8("§")));
+        QCOMPARE(QUtf8String(pattern).arg(-12, 5).toString(), p.arg(-12, 5));
+        QCOMPARE(QUtf8String(pattern).arg(0.25, 0, 'e').toString(), p.arg(0.25, 0, 'e'));
+    }
+
+    QTest::ignoreMessage(QtWarningMsg, "QUtf8String::arg: Argument missing: nothing here, x");
+    QCOMPARE(QUtf8String("nothing here").arg("x"), QUtf8String("nothing here"));
+}
+
+void tst_QUtf8String::multiArg()
+{
+    QCOMPARE(QUtf8String("%1 → %2").arg("ä", "ö"), QUtf8String("ä → ö"));
+    QCOMPARE(QUtf8String("%2 → %1").arg(QUtf8String("ä"), "ö"), QUtf8String("ö → ä"));
+    QCOMPARE(QUtf8String("%3%1%3%2").arg("a", "b", "c"), QUtf8String("cacb"));
+    QCOMPARE(QUtf8String("%10 %5").arg("x", "y"), QUtf8String("y x"));
+    // replacements are not searched for placeholders
+    QCOMPARE(QUtf8String("%1 %2").arg("%2", "%1"), QUtf8String("%2 %1"));
+    // surplus placeholders are left alone
+    QCOMPARE(QUtf8String("%1 %2 %3").arg("a", "b"), QUtf8String("a b %3"));
+
+    QTest::ignoreMessage(QtWarningMsg, "QUtf8String::arg: 1 argument(s) missing in %1");
+    QCOMPARE(QUtf8String("%1").arg("a", "b"), QUtf8String("a"));
+}
+
+void tst_QUtf8String::numbers()
+{
+    bool ok = false;
+    QCOMPARE(QUtf8String("42").toInt(&ok), 42);
+    QVERIFY(ok);
+    QCOMPARE(QUtf8String(" -17 ").toLongLong(&ok), Q_INT64_C(-17));
+    QVERIFY(ok);
+    QCOMPARE(QUtf8String("ff").toUInt(&ok, 16), 255u);
+    QVERIFY(ok);
+    QCOMPARE(QUtf8String("2.5").toDouble(&ok), 2.5);
+    QVERIFY(ok);
+    QUtf8String("٤٢").toInt(&ok);
+    QVERIFY(!ok);
+
+    QCOMPARE(QUtf8String::number(-42), QUtf8String("-42"));
+    QCOMPARE(QUtf8String::number(255u, 16), QUtf8String("ff"));
+    QCOMPARE(QUtf8String::number(Q_INT64_C(-9223372036854775807)), QUtf8String("-9223372036854775807"));
+    QCOMPARE(QUtf8String::number(0.5), QUtf8String("0.5"));
+    QCOMPARE(QUtf8String::number(1.0 / 3, 'f', 3), QUtf8String("0.333"));
+}
+
+void tst_QUtf8String::qstringArg()
+{
+    const QUtf8String name("Jörg");
+    const QUtf8String place("Zürich 😀");
+    QCOMPARE(QString("%1 in %2").arg(name, place), QString::fromUtf8("Jörg in Zürich 😀"));
+    QCOMPARE(QString("%2 %1").arg(name, QString("und")), QString::fromUtf8("und Jörg"));
+    QCOMPARE(QStringView(u"<%1>").arg(place), QString::fromUtf8("<Zürich 😀>"));
+    QCOMPARE(QLatin1String("%1%1").arg(name), QString::fromUtf8("JörgJörg"));
+    QCOMPARE(QLatin1String("%1-%2").arg(QUtf8String(), QUtf8String("")), QString("-"));
+    // invalid UTF-8 becomes U+FFFD, like in QString::fromUtf8()
+    QCOMPARE(QLatin1String("%1").arg(QUtf8String("a\xff")), QString::fromUtf8("a\xff"));
+}
+
+void tst_QUtf8String::hashAndStreams()
+{
+    const QUtf8String s("größe");
+    QCOMPARE(qHash(s), qHash(QByteArray("größe")));
+    QCOMPARE(qHash(s, 42), qHash(QUtf8String("größe"), 42));
+
+    QByteArray buffer;
+    {
+        QDataStream out(&buffer, QIODevice::WriteOnly);
+        out << s << QUtf8String() << QUtf8String("");
+    }
+    QByteArray compatible;
+    {
+        QDataStream out(&compatible, QIODevice::WriteOnly);
+        out << QByteArray("größe") << QByteArray() << QByteArray("");
+    }
+    QCOMPARE(buffer, compatible);
+
+    QDataStream in(buffer);
+    QUtf8String a, b, c;
+    in >> a >> b >> c;
+    QCOMPARE(a, s);
+    QVERIFY(b.isNull());
+    QVERIFY(!c.isNull());
+    QVERIFY(c.isEmpty());
+
+    QTest::ignoreMessage(QtDebugMsg, "\"size\"");
+    qDebug() << QUtf8String("size");
+}
+
+void tst_QUtf8String::jsonValue()
+{
+    const QUtf8String s("naïve 😀");
+    const QJsonValue v(s);
+    QVERIFY(v.isString());
+    QCOMPARE(v.toUtf8String(), s);
+    QCOMPARE(v.toString(), s.toString());
+    QCOMPARE(v, QJsonValue(s.toString()));
+    QCOMPARE(QJsonValue(QUtf8String("ascii")), QJsonValue(QLatin1String("ascii")));
+    QCOMPARE(QJsonValue("naïve 😀").toUtf8String(), s);
+
+    QCOMPARE(QJsonValue(s.toString()).toUtf8String(), s);
+    QVERIFY(QJsonValue(42).toUtf8String().isNull());
+    QVERIFY(QJsonValue(QUtf8String()).isString());
+    QCOMPARE(QJsonValue(QUtf8String()).toString(), QString(""));
+
+    // invalid UTF-8 is replaced, as QString::fromUtf8() does
+    const QJsonValue invalid(QUtf8String("a\xff" "b"));
+    QCOMPARE(invalid.toString(), QString::fromUtf8("a\xff" "b"));
+    QVERIFY(invalid.toUtf8String().isValidUtf8());
+
+    QJsonObject object;
+    object.insert(QStringLiteral("key"), QJsonValue(s));
+    QCOMPARE(object.value(QStringLiteral("key")).toUtf8String(), s);
+    QJsonArray array;
+    array.append(QJsonValue(s));
+    QCOMPARE(array.at(0).toUtf8String(), s);
+}
+
+void tst_QUtf8String::jsonDocument()
+{
+    const QByteArray json = "{\"name\":\"Jörg \\\"J\\\" 😀\",\"path\":\"C:\\\\tmp\\n\\t\\u0001\"}";
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QCOMPARE(doc.object().value(QLatin1String("name")).toUtf8String(), QUtf8String("Jörg \"J\" 😀"));
+    QCOMPARE(doc.object().value(QLatin1String("path")).toUtf8String(), QUtf8String("C:\\tmp\n\t\x01"));
+    QCOMPARE(doc.toJson(QJsonDocument::Compact), json);
+
+    // values stored as UTF-8, UTF-16 and US-ASCII are written the same way
+    const QUtf8String text("ü\"\\\b\f\n\r\t\x1f 😀");
+    QJsonObject object;
+    object.insert(QString::fromUtf8("ü8"), QJsonValue(text));
+    object.insert(QString::fromUtf8("ü16"), QJsonValue(text.toString()));
+    object.insert(QStringLiteral("ascii"), QJsonValue(QUtf8String("plain")));
+    const QByteArray expected = "{\"ascii\":\"plain\","
+                                "\"ü16\":\"ü\\\"\\\\\\b\\f\\n\\r\\t\\u001f 😀\","
+                                "\"ü8\":\"ü\\\"\\\\\\b\\f\\n\\r\\t\\u001f 😀\"}";
+    QCOMPARE(QJsonDocument(object).toJson(QJsonDocument::Compact), expected);
+
+    const QJsonDocument reparsed = QJsonDocument::fromJson(expected);
+    QCOMPARE(reparsed.object().value(QString::fromUtf8("ü8")).toUtf8String(), text);
+    QCOMPARE(reparsed.object(), object);
+
+    QJsonArray array;
+    array.append(QJsonValue(text));
+    QCOMPARE(QJsonDocument(array).toJson(QJsonDocument::Indented),
+             QByteArray("[\n    \"ü\\\"\\\\\\b\\f\\n\\r\\t\\u001f 😀\"\n]\n"));
+}
+
+void tst_QUtf8String::textStream_data()
+{
+    QTest::addColumn<QByteArray>("codec");
+    QTest::addColumn<bool>("bom");
+    QTest::addColumn<int>("fieldWidth");
+
+    QTest::newRow("utf-8") << QByteArray("UTF-8") << false << 0;
+    QTest::newRow("utf-8-bom") << QByteArray("UTF-8") << true << 0;
+    QTest::newRow("utf-8-padded") << QByteArray("UTF-8") << false << 12;
+    QTest::newRow("utf-16") << QByteArray("UTF-16LE") << false << 0;
+    QTest::newRow("latin-1") << QByteArray("ISO-8859-1") << false << 0;
+}
+
+// Whatever the stream does internally, the output must be the same as for
+// the QString with the same contents.
+void tst_QUtf8String::textStream()
+{
+    QFETCH(QByteArray, codec);
+    QFETCH(bool, bom);
+    QFETCH(int, fieldWidth);
+
+    const QUtf8String strings[] = { QUtf8String("grüße "), QUtf8String(""), QUtf8String("😀\n"),
+                                    QUtf8String("a\xff" "b"), QUtf8String(QByteArray(20000, 'x')) };
+
+    const auto write = [&](bool utf8) {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QTextStream stream(&buffer);
+        stream.setCodec(codec.constData());
+        stream.setGenerateByteOrderMark(bom);
+        stream.setFieldWidth(fieldWidth);
+        for (const QUtf8String &s : strings) {
+            if (utf8)
+                stream << s;
+            else
+                stream << s.toString();
+            stream << 42;
+        }
+        stream.flush();
+        return buffer.data();
+    };
+
+    const QByteArray expected = write(false);
+    QCOMPARE(write(true), expected);
+
+    QString string;
+    QTextStream stringStream(&string);
+    stringStream << strings[0] << strings[2];
+    QCOMPARE(string, QString::fromUtf8("grüße 😀\n"));
+}
+
+void tst_QUtf8String::textStreamMixedOutput()
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    {
+        QTextStream stream(&buffer);
+        stream.setCodec("UTF-8");
+        stream << QString::fromUtf8("ä") << QUtf8String("ö") << 'x' << QUtf8String("ü");
+        // a high surrogate waits in the codec for its pair; unpaired ones
+        // become '?', as when writing QStrings
+        stream << QString(QChar(0xd83d)) << QUtf8String("!");
+        stream << QString(QChar(0xde00)) << QUtf8String("é");
+        QCOMPARE(buffer.data(), QByteArray());  // buffered until flushed or destroyed
+        stream.flush();
+        QCOMPARE(buffer.data(), QByteArray("äöxü?!?é"));
+        stream << QUtf8String("end");
+    }
+    QCOMPARE(buffer.data(), QByteArray("äöxü?!?éend"));
+}
+
+void tst_QUtf8String::textStreamRead()
+{
+    QByteArray data("größe  😀 ");
+    QTextStream stream(&data);
+    stream.setCodec("UTF-8");
+    QUtf8String a, b, c;
+    stream >> a >> b >> c;
+    QCOMPARE(a, QUtf8String("größe"));
+    QCOMPARE(b, QUtf8String("😀"));
+    QVERIFY(c.isEmpty());
+}
+
+void tst_QUtf8String::url()
+{
+    const QUrl url = QUrl::fromUtf8String("https://例え.jp/pfad/größe?q=ä#frag");
+    QVERIFY(url.isValid());
+    QCOMPARE(url.host(), QString::fromUtf8("例え.jp"));
+    QCOMPARE(url.path(), QString::fromUtf8("/pfad/größe"));
+    QCOMPARE(url.toUtf8String(), QUtf8String(url.toString()));
+    QCOMPARE(url.toUtf8String(QUrl::FullyEncoded), QUtf8String(url.toEncoded()));
+    QCOMPARE(QUrl::fromUtf8String(url.toUtf8String()), url);
+    QVERIFY(QUrl::fromUtf8String(QUtf8String()).isEmpty());
+}
+
+QTEST_APPLESS_MAIN(tst_QUtf8String)
+
+#include "tst_qutf8string.moc"
@@ -9,8 +9,10 @@ SUBDIRS = \
     qcollator \
     qlatin1string \
     qlocale \
+    qmultistringmatcher \
     qregexp \
     qregularexpression \
+    qregularexpressionset \
     qstring \
     qstring_no_cast_from_bytearray \
     qstringapisymmetry \
@@ -20,4 +22,5 @@ SUBDIRS = \
     qstringmatcher \
     qstringref \
     qstringview \
-    qtextboundaryfinder
+    qtextboundaryfinder \
+    qutf8string
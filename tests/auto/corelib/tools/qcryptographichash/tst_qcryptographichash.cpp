@@ -44,6 +44,10 @@ private slots:
     void sha1();
     void sha3_data();
     void sha3();
+    void longInputs_data();
+    void longInputs();
+    void hashMany_data();
+    void hashMany();
     void files_data();
     void files();
     void hashLength();
@@ -153,6 +157,17 @@ void tst_QCryptographicHash::intermediary_result_data()
             << QByteArray("abc") << QByteArray("abc")
             << QByteArray::fromHex("B751850B1A57168A5693CD924B6B096E08F621827444F70D884F5D0240D2712E10E116E9192AF3C91A7EC57647E3934057340B4CF408D5A56592F8274EEC53F0")
             << QByteArray::fromHex("BB582DA40D15399ACF62AFCBBD6CFC9EE1DD5129B1EF9935DD3B21668F1A73D7841018BE3B13F281C3A8E9DA7EDB60F57B9F9F1C04033DF4CE3654B7B2ADB310");
+
+    QTest::newRow("blake3_abc_abc")
+            << int(QCryptographicHash::Blake3_256)
+            << QByteArray("abc") << QByteArray("abc")
+            << QByteArray::fromHex("6437B3AC38465133FFB63B75273A8DB548C558465D79DB03FD359C6CD5BD9D85")
+            << QByteArray::fromHex("8A120B9472CC2C9873EC4283FF85376799F0864119C167440AEB7EC7A631FBCA");
+    QTest::newRow("xxh3_abc_abc")
+            << int(QCryptographicHash::Xxh3_64)
+            << QByteArray("abc") << QByteArray("abc")
+            << QByteArray::fromHex("78AF5F94892F3950")
+            << QByteArray::fromHex("E788EC89C0489ACB");
 }
 
 void tst_QCryptographicHash::intermediary_result()
@@ -264,6 +279,224 @@ void tst_QCryptographicHash::sha3()
     QCOMPARE(result, expectedResult);
 }
 
+static QByteArray patternData(int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        data[i] = char(i % 251);
+    return data;
+}
+
+void tst_QCryptographicHash::longInputs_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<QByteArray>("expectedResult");
+
+    // the lengths exercise block boundaries, and for BLAKE3 the chunk tree
+#define ROW(Tag, Algorithm, Size, Result) \
+    QTest::newRow(Tag) << Algorithm << Size << QByteArray::fromHex(Result)
+
+    ROW("sha1_55", QCryptographicHash::Sha1, 55,
+        "8ae2d46729cfe68ff927af5eec9c7d1b66d65ac2");
+    ROW("sha1_64", QCryptographicHash::Sha1, 64,
+        "c6138d514ffa2135bfce0ed0b8fac65669917ec7");
+    ROW("sha1_65", QCryptographicHash::Sha1, 65,
+        "69bd728ad6e13cd76ff19751fde427b00e395746");
+    ROW("sha1_128", QCryptographicHash::Sha1, 128,
+        "e6434bc401f98603d7eda504790c98c67385d535");
+    ROW("sha1_129", QCryptographicHash::Sha1, 129,
+        "3352e41cc30b40ae80108970492b21014049e625");
+    ROW("sha1_1000", QCryptographicHash::Sha1, 1000,
+        "c9c960a0b925474fab83942cc27d504fc24ac37b");
+    ROW("sha1_65539", QCryptographicHash::Sha1, 65539,
+        "1ffeb515f7b2e0b60fbbc28ab24961d6589ec3da");
+    ROW("sha224_55", QCryptographicHash::Sha224, 55,
+        "8991dfba74284e04dc7581c7c3e4068ff6cb7a63733361429834bb56");
+    ROW("sha224_64", QCryptographicHash::Sha224, 64,
+        "c37b88a3522dbf7ac30d1c68ea397ac11d4773571aed01ddab73531e");
+    ROW("sha224_65", QCryptographicHash::Sha224, 65,
+        "114b5fd665736a96585c5d5837d35250aed73c725252cbf7f8b121f6");
+    ROW("sha224_128", QCryptographicHash::Sha224, 128,
+        "67d88da33fd632d8742424791dface672ff59d597fe38b3f2a998386");
+    ROW("sha224_129", QCryptographicHash::Sha224, 129,
+        "a80cb91e08a62f062bd17db00d0e1979d041edeb52b497b205266b9c");
+    ROW("sha224_1000", QCryptographicHash::Sha224, 1000,
+        "c182669a7f6629dc7fd8a9198f15af15adbbaeffa1842e854f681357");
+    ROW("sha224_65539", QCryptographicHash::Sha224, 65539,
+        "cecbd59d7c69142c9df02e9f1248c2730a6320a8da3e628dbb8263a7");
+    ROW("sha256_55", QCryptographicHash::Sha256, 55,
+        "463eb28e72f82e0a96c0a4cc53690c571281131f672aa229e0d45ae59b598b59");
+    ROW("sha256_64", QCryptographicHash::Sha256, 64,
+        "fdeab9acf3710362bd2658cdc9a29e8f9c757fcf9811603a8c447cd1d9151108");
+    ROW("sha256_65", QCryptographicHash::Sha256, 65,
+        "4bfd2c8b6f1eec7a2afeb48b934ee4b2694182027e6d0fc075074f2fabb31781");
+    ROW("sha256_128", QCryptographicHash::Sha256, 128,
+        "471fb943aa23c511f6f72f8d1652d9c880cfa392ad80503120547703e56a2be5");
+    ROW("sha256_129", QCryptographicHash::Sha256, 129,
+        "5099c6a56203f9687f7d33f4bfdf576d31dc91f6b695ecea38b2770c87631135");
+    ROW("sha256_1000", QCryptographicHash::Sha256, 1000,
+        "4e4c294b331f7a2099a379bec34b9f9fc03dc46ab465d998f4d683da53487e6d");
+    ROW("sha256_65539", QCryptographicHash::Sha256, 65539,
+        "6859d9b53d73fd394a476c8cbf60367e041a0188a670fa853913becda71267fc");
+    ROW("blake3_0", QCryptographicHash::Blake3_256, 0,
+        "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262");
+    ROW("blake3_1", QCryptographicHash::Blake3_256, 1,
+        "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213");
+    ROW("blake3_63", QCryptographicHash::Blake3_256, 63,
+        "e9bc37a594daad83be9470df7f7b3798297c3d834ce80ba85d6e207627b7db7b");
+    ROW("blake3_64", QCryptographicHash::Blake3_256, 64,
+        "4eed7141ea4a5cd4b788606bd23f46e212af9cacebacdc7d1f4c6dc7f2511b98");
+    ROW("blake3_65", QCryptographicHash::Blake3_256, 65,
+        "de1e5fa0be70df6d2be8fffd0e99ceaa8eb6e8c93a63f2d8d1c30ecb6b263dee");
+    ROW("blake3_1023", QCryptographicHash::Blake3_256, 1023,
+        "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11");
+    ROW("blake3_1024", QCryptographicHash::Blake3_256, 1024,
+        "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7");
+    ROW("blake3_1025", QCryptographicHash::Blake3_256, 1025,
+        "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444");
+    ROW("blake3_2048", QCryptographicHash::Blake3_256, 2048,
+        "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a");
+    ROW("blake3_2049", QCryptographicHash::Blake3_256, 2049,
+        "5f4d72f40d7a5f82b15ca2b2e44b1de3c2ef86c426c95c1af0b6879522563030");
+    ROW("blake3_3072", QCryptographicHash::Blake3_256, 3072,
+        "b98cb0ff3623be03326b373de6b9095218513e64f1ee2edd2525c7ad1e5cffd2");
+    ROW("blake3_3073", QCryptographicHash::Blake3_256, 3073,
+        "7124b49501012f81cc7f11ca069ec9226cecb8a2c850cfe644e327d22d3e1cd3");
+    ROW("blake3_4096", QCryptographicHash::Blake3_256, 4096,
+        "015094013f57a5277b59d8475c0501042c0b642e531b0a1c8f58d2163229e969");
+    ROW("blake3_4097", QCryptographicHash::Blake3_256, 4097,
+        "9b4052b38f1c5fc8b1f9ff7ac7b27cd242487b3d890d15c96a1c25b8aa0fb995");
+    ROW("blake3_5120", QCryptographicHash::Blake3_256, 5120,
+        "9cadc15fed8b5d854562b26a9536d9707cadeda9b143978f319ab34230535833");
+    ROW("blake3_8192", QCryptographicHash::Blake3_256, 8192,
+        "aae792484c8efe4f19e2ca7d371d8c467ffb10748d8a5a1ae579948f718a2a63");
+    ROW("blake3_8193", QCryptographicHash::Blake3_256, 8193,
+        "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b");
+    ROW("blake3_16384", QCryptographicHash::Blake3_256, 16384,
+        "f875d6646de28985646f34ee13be9a576fd515f76b5b0a26bb324735041ddde4");
+    ROW("blake3_31744", QCryptographicHash::Blake3_256, 31744,
+        "62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47");
+    ROW("blake3_102400", QCryptographicHash::Blake3_256, 102400,
+        "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085");
+    ROW("blake3_1048577", QCryptographicHash::Blake3_256, 1048577,
+        "2f053cd7472cf0cd2f9adaf45c1180255b91b9a865404a63671a0ee5f792ed33");
+    ROW("xxh3_0", QCryptographicHash::Xxh3_64, 0,
+        "2d06800538d394c2");
+    ROW("xxh3_1", QCryptographicHash::Xxh3_64, 1,
+        "c44bdff4074eecdb");
+    ROW("xxh3_3", QCryptographicHash::Xxh3_64, 3,
+        "5f4299fc161c9cbb");
+    ROW("xxh3_4", QCryptographicHash::Xxh3_64, 4,
+        "60dab036a58211f2");
+    ROW("xxh3_8", QCryptographicHash::Xxh3_64, 8,
+        "3a1c2d7c85af88f8");
+    ROW("xxh3_9", QCryptographicHash::Xxh3_64, 9,
+        "e9612598145bb9dc");
+    ROW("xxh3_16", QCryptographicHash::Xxh3_64, 16,
+        "8355e3a6f61770db");
+    ROW("xxh3_17", QCryptographicHash::Xxh3_64, 17,
+        "9ef341a99de37328");
+    ROW("xxh3_128", QCryptographicHash::Xxh3_64, 128,
+        "85c6174c7ff4c46b");
+    ROW("xxh3_129", QCryptographicHash::Xxh3_64, 129,
+        "ec7642b431ba3e5a");
+    ROW("xxh3_240", QCryptographicHash::Xxh3_64, 240,
+        "375a384d957fe865");
+    ROW("xxh3_241", QCryptographicHash::Xxh3_64, 241,
+        "02e8cd95421c6d02");
+    ROW("xxh3_255", QCryptographicHash::Xxh3_64, 255,
+        "074191baf9c49567");
+    ROW("xxh3_256", QCryptographicHash::Xxh3_64, 256,
+        "44f5d90dacde463a");
+    ROW("xxh3_257", QCryptographicHash::Xxh3_64, 257,
+        "88fc3f7934a6c9be");
+    ROW("xxh3_1024", QCryptographicHash::Xxh3_64, 1024,
+        "e5d78bafa45b2aa5");
+    ROW("xxh3_1025", QCryptographicHash::Xxh3_64, 1025,
+        "e95c42288f28186e");
+    ROW("xxh3_2048", QCryptographicHash::Xxh3_64, 2048,
+        "25339063db861586");
+    ROW("xxh3_4096", QCryptographicHash::Xxh3_64, 4096,
+        "7135ffa504f1bc71");
+    ROW("xxh3_102400", QCryptographicHash::Xxh3_64, 102400,
+        "1428e17f1cac2837");
+    ROW("xxh3_1048577", QCryptographicHash::Xxh3_64, 1048577,
+        "47a84c196fd973df");
+
+#undef ROW
+}
+
+void tst_QCryptographicHash::longInputs()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    QFETCH(int, size);
+    QFETCH(QByteArray, expectedResult);
+
+    const QByteArray data = patternData(size);
+    QCOMPARE(QCryptographicHash::hash(data, algorithm), expectedResult);
+
+    // feeding the data in pieces must not make a difference
+    for (int step : {1, 7, 64, 1000, 65536 + 5}) {
+        if (step > size || (step == 1 && size > 65536))
+            continue;
+        QCryptographicHash hash(algorithm);
+        for (int i = 0; i < size; i += step)
+            hash.addData(data.constData() + i, qMin(step, size - i));
+        QCOMPARE(hash.result(), expectedResult);
+    }
+}
+
+void tst_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QVector<QByteArray>>("data");
+
+    // lengths around the padding boundaries of the 64-byte block algorithms
+    static const int sizes[] = { 0, 1, 55, 56, 63, 64, 65, 119, 120, 127, 128, 1000, 4096, 65536 + 17 };
+    QVector<QByteArray> small;
+    for (int round = 0; round < 3; ++round) {
+        for (int size : sizes)
+            small.append(patternData(size + round).mid(round));
+    }
+
+    // enough data to be split between threads
+    QVector<QByteArray> large;
+    for (int i = 0; i < 100; ++i)
+        large.append(patternData(16 * 1024 + 997 * i));
+
+    const QCryptographicHash::Algorithm algorithms[] = {
+        QCryptographicHash::Md5, QCryptographicHash::Sha1, QCryptographicHash::Sha224,
+        QCryptographicHash::Sha256, QCryptographicHash::Sha512, QCryptographicHash::Sha3_256,
+        QCryptographicHash::Blake3_256, QCryptographicHash::Xxh3_64
+    };
+    const auto metaEnum = QMetaEnum::fromType<QCryptographicHash::Algorithm>();
+    for (auto algorithm : algorithms) {
+        const QByteArray name = metaEnum.valueToKey(algorithm);
+        QTest::newRow((name + "-empty").constData()) << algorithm << QVector<QByteArray>();
+        QTest::newRow((name + "-one").constData()) << algorithm << QVector<QByteArray>{ "abc" };
+        QTest::newRow((name + "-small").constData()) << algorithm << small;
+        QTest::newRow((name + "-large").constData()) << algorithm << large;
+    }
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    QFETCH(QVector<QByteArray>, data);
+
+    // make sure the batch can be split even on single core machines
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(qMax(maxThreadCount, 4));
+    const QVector<QByteArray> results = QCryptographicHash::hashMany(data, algorithm);
+    pool->setMaxThreadCount(maxThreadCount);
+
+    QCOMPARE(results.size(), data.size());
+    for (int i = 0; i < data.size(); ++i)
+        QCOMPARE(results.at(i), QCryptographicHash::hash(data.at(i), algorithm));
+}
+
 void tst_QCryptographicHash::files_data() {
     QTest::addColumn<QString>("filename");
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
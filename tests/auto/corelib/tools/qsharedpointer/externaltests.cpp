@@ -86,26 +86,6 @@ namespace QTest {
         }
     }
 
-    class QExternalProcess: public QProcess
-    {
-    protected:
-#ifdef Q_OS_UNIX
-        void setupChildProcess()
-        {
-            // run in user code
-            QProcess::setupChildProcess();
-
-            if (processChannelMode() == ForwardedChannels) {
-                // reopen /dev/tty into stdin
-                int fd = ::open("/dev/tty", O_RDONLY);
-                if (fd == -1)
-                    return;
-                ::dup2(fd, 0);
-                ::close(fd);
-            }
-        }
-#endif
-    };
 #endif // QT_CONFIG(process)
 
     class QExternalTestPrivate
@@ -630,7 +610,7 @@ namespace QTest {
         if (temporaryDirPath.isEmpty())
             qWarning() << "Temporary directory is expected to be non-empty";
 
-        QExternalProcess make;
+        QProcess make;
         make.setWorkingDirectory(temporaryDirPath);
 
         QStringList environment = QProcess::systemEnvironment();
@@ -654,6 +634,18 @@ namespace QTest {
         }
 
         make.setProcessChannelMode(channelMode);
+#ifdef Q_OS_UNIX
+        if (channelMode == QProcess::ForwardedChannels) {
+            make.setChildProcessModifier([]() {
+                // reopen /dev/tty into stdin
+                int fd = ::open("/dev/tty", O_RDONLY);
+                if (fd == -1)
+                    return;
+                ::dup2(fd, 0);
+                ::close(fd);
+            });
+        }
+#endif
 
         static const char makes[] =
             "jom.exe\0" //preferred for visual c++ or mingw
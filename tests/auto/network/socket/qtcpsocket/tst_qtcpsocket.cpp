@@ -201,6 +201,7 @@ private slots:
     void socketDiscardDataInWriteMode();
     void writeOnReadBufferOverflow();
     void readNotificationsAfterBind();
+    void sendFile();
 
 protected slots:
     void nonBlockingIMAP_hostFound();
@@ -3198,4 +3199,64 @@ void tst_QTcpSocket::readNotificationsAfterBind()
 }
 
 QTEST_MAIN(tst_QTcpSocket)
+void tst_QTcpSocket::sendFile()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QByteArray contents;
+    for (int i = 0; contents.size() < 1024 * 1024; ++i)
+        contents += QByteArray::number(i) + ' ';
+    QCOMPARE(file.write(contents), qint64(contents.size()));
+    QVERIFY(file.flush());
+
+    // a resource file has no handle for sendfile(2) to read
+    QFile resource(QStringLiteral(":/tst_qtcpsocket.cpp"));
+    QVERIFY(resource.open(QIODevice::ReadOnly));
+    const QByteArray resourceContents = resource.readAll();
+
+    QTcpServer tcpServer;
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+    QTcpSocket *socket = newSocket();
+    socket->connectToHost(tcpServer.serverAddress(), tcpServer.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY2(tcpServer.waitForNewConnection(5000), "Network timeout");
+    QTcpSocket *newConnection = tcpServer.nextPendingConnection();
+    QVERIFY(newConnection != nullptr);
+
+    QByteArray received;
+    connect(newConnection, &QIODevice::readyRead, [&] { received += newConnection->readAll(); });
+    qint64 written = 0;
+    connect(socket, &QIODevice::bytesWritten, [&](qint64 bytes) { written += bytes; });
+
+    // files and writes are sent in the order they were queued
+    const QByteArray expected = "head" + contents.mid(100, 300000) + "middle" + contents
+            + resourceContents + "tail";
+    QCOMPARE(socket->write("head"), qint64(4));
+    QVERIFY(socket->sendFile(&file, 100, 300000));
+    QCOMPARE(socket->write("middle"), qint64(6));
+    QVERIFY(socket->sendFile(&file));
+    QVERIFY(socket->sendFile(&resource));
+    QVERIFY(socket->sendFile(&file, contents.size())); // nothing left to send
+    QCOMPARE(socket->write("tail"), qint64(4));
+    QVERIFY(socket->bytesToWrite() <= expected.size());
+
+    QTRY_COMPARE_WITH_TIMEOUT(received.size(), expected.size(), 10000);
+    QCOMPARE(received, expected);
+    QCOMPARE(written, qint64(expected.size()));
+    QCOMPARE(socket->bytesToWrite(), qint64(0));
+
+    // a file that is not open for reading is refused
+    QFile closed(file.fileName());
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QAbstractSocket::sendFile: the file must be open for reading and not sequential");
+    QVERIFY(!socket->sendFile(&closed));
+
+    delete newConnection;
+    delete socket;
+}
+
 #include "tst_qtcpsocket.moc"
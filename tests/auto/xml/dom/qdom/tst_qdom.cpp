@@ -115,6 +115,7 @@ private slots:
     void DTDNotationDecl();
     void DTDEntityDecl();
     void QTBUG49113_dontCrashWithNegativeIndex() const;
+    void repeatedNamesAndValues() const;
 
     void cleanupTestCase() const;
 
@@ -1983,5 +1984,64 @@ void tst_QDom::QTBUG49113_dontCrashWithNegativeIndex() const
     QVERIFY(node.isNull());
 }
 
+void tst_QDom::repeatedNamesAndValues() const
+{
+    // Names and short values are shared between nodes while parsing;
+    // changing one node must not affect the others.
+    const QString xml = QStringLiteral("<ns:root xmlns:ns=\"urn:test\">"
+                                       "<ns:item ns:flag=\"yes\" plain=\"yes\">one</ns:item>"
+                                       "<ns:item ns:flag=\"yes\" plain=\"yes\">one</ns:item>"
+                                       "</ns:root>");
+    for (bool namespaceProcessing : { false, true }) {
+        QDomDocument doc;
+        QVERIFY(doc.setContent(xml, namespaceProcessing));
+
+        QDomElement first = doc.documentElement().firstChildElement();
+        QDomElement second = first.nextSiblingElement();
+        QCOMPARE(first.tagName(), second.tagName());
+        QCOMPARE(first.text(), QLatin1String("one"));
+        QCOMPARE(second.text(), QLatin1String("one"));
+
+        // equal names and short values use the same data
+        const QString plain = QStringLiteral("plain");
+        QVERIFY(first.attribute(plain).isSharedWith(second.attribute(plain)));
+        QVERIFY(first.attributeNode(plain).name().isSharedWith(second.attributeNode(plain).name()));
+        QVERIFY(first.firstChild().nodeValue().isSharedWith(second.firstChild().nodeValue()));
+        if (namespaceProcessing) {
+            const QString uri = QStringLiteral("urn:test");
+            const QString flag = QStringLiteral("flag");
+            QVERIFY(first.localName().isSharedWith(second.localName()));
+            QVERIFY(first.prefix().isSharedWith(second.prefix()));
+            QVERIFY(first.namespaceURI().isSharedWith(second.namespaceURI()));
+            const QDomAttr firstFlag = first.attributeNodeNS(uri, flag);
+            const QDomAttr secondFlag = second.attributeNodeNS(uri, flag);
+            QVERIFY(firstFlag.localName().isSharedWith(secondFlag.localName()));
+            QVERIFY(firstFlag.prefix().isSharedWith(secondFlag.prefix()));
+            QVERIFY(firstFlag.namespaceURI().isSharedWith(secondFlag.namespaceURI()));
+            // element and attribute names from the same pool
+            QVERIFY(firstFlag.prefix().isSharedWith(first.prefix()));
+        } else {
+            QVERIFY(first.tagName().isSharedWith(second.tagName()));
+        }
+
+        first.setTagName(QLatin1String("other"));
+        first.setAttribute(QLatin1String("plain"), QLatin1String("no"));
+        first.firstChild().toText().appendData(QLatin1String(" and two"));
+
+        QCOMPARE(first.tagName(), QLatin1String("other"));
+        QCOMPARE(second.tagName(), namespaceProcessing ? QLatin1String("item") : QLatin1String("ns:item"));
+        QCOMPARE(first.attribute(QLatin1String("plain")), QLatin1String("no"));
+        QCOMPARE(second.attribute(QLatin1String("plain")), QLatin1String("yes"));
+        QCOMPARE(first.text(), QLatin1String("one and two"));
+        QCOMPARE(second.text(), QLatin1String("one"));
+        if (namespaceProcessing) {
+            QCOMPARE(second.namespaceURI(), QLatin1String("urn:test"));
+            QCOMPARE(second.prefix(), QLatin1String("ns"));
+            QCOMPARE(second.attributeNS(QLatin1String("urn:test"), QLatin1String("flag")),
+                     QLatin1String("yes"));
+        }
+    }
+}
+
 QTEST_MAIN(tst_QDom)
 #include "tst_qdom.moc"
@@ -1,7 +1,9 @@
 TEMPLATE = subdirs
 SUBDIRS = \
+        global \
         io \
         json \
+        serialization \
         mimetypes \
         kernel \
         text \
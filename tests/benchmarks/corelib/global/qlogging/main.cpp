@@ -0,0 +1,107 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QThread>
+#include <QtTest/QtTest>
+
+#include <vector>
+
+// Measures how long it takes to log a fixed number of messages from several
+// threads through the default message handler. Run with stderr redirected,
+// and compare the results with and without QT_LOGGING_ASYNC set, e.g.:
+//   ./tst_bench_qlogging 2> /dev/null
+//   QT_LOGGING_ASYNC=block ./tst_bench_qlogging 2> /dev/null
+class tst_QLogging : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void throughput_data();
+    void throughput();
+
+private:
+    QtMessageHandler testlibHandler = nullptr;
+};
+
+class LoggingThread : public QThread
+{
+public:
+    explicit LoggingThread(int count) : count(count) {}
+
+protected:
+    void run() override
+    {
+        for (int i = 0; i < count; ++i)
+            qDebug("message %d from a thread that logs a lot", i);
+    }
+
+private:
+    int count;
+};
+
+void tst_QLogging::initTestCase()
+{
+    // bypass the message handler of QtTest, which would swallow the output
+    testlibHandler = qInstallMessageHandler(nullptr);
+}
+
+void tst_QLogging::cleanupTestCase()
+{
+    qInstallMessageHandler(testlibHandler);
+}
+
+void tst_QLogging::throughput_data()
+{
+    QTest::addColumn<int>("threadCount");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("32 threads") << 32;
+}
+
+void tst_QLogging::throughput()
+{
+    QFETCH(int, threadCount);
+    const int totalMessages = 64 * 1024;
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<LoggingThread>> threads;
+        for (int i = 0; i < threadCount; ++i)
+            threads.emplace_back(new LoggingThread(totalMessages / threadCount));
+        for (const auto &thread : threads)
+            thread->start();
+        for (const auto &thread : threads)
+            thread->wait();
+    }
+}
+
+QTEST_MAIN(tst_QLogging)
+
+#include "main.moc"
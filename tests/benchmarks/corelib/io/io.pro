@@ -1,10 +1,12 @@
 TEMPLATE = subdirs
 SUBDIRS = \
+        qcompressingdevice \
         qdir \
         qdiriterator \
         qfile \
         qfileinfo \
         qiodevice \
+        qloggingcategory \
         qtemporaryfile \
         qtextstream
 
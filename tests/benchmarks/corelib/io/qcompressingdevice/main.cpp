@@ -0,0 +1,151 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/QBuffer>
+#include <QtCore/QCompressingDevice>
+#include <QtCore/QCompression>
+
+Q_DECLARE_METATYPE(QCompression::Algorithm)
+
+class tst_QCompressingDevice : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void compress_data();
+    void compress();
+    void decompress_data();
+    void decompress();
+    void streamDecompress_data();
+    void streamDecompress();
+};
+
+// Log-like text: compressible, but not trivially so
+static QByteArray testData(int size)
+{
+    QByteArray data;
+    data.reserve(size);
+    for (int i = 0; data.size() < size; ++i) {
+        data += "2020-05-0" + QByteArray::number(i % 9 + 1) + " request id=" + QByteArray::number(i * 7919)
+                + " path=/api/v1/items/" + QByteArray::number(i % 1013) + " status="
+                + QByteArray::number(i % 17 ? 200 : 404) + "\n";
+    }
+    data.truncate(size);
+    return data;
+}
+
+static void addRows()
+{
+    QTest::addColumn<QCompression::Algorithm>("algorithm");
+    QTest::addColumn<int>("level");
+    const struct {
+        QCompression::Algorithm algorithm;
+        const char *name;
+    } algorithms[] = {
+        { QCompression::Zlib, "zlib" },
+        { QCompression::Zstd, "zstd" },
+        { QCompression::Lz4, "lz4" }
+    };
+    for (const auto &entry : algorithms) {
+        if (!QCompression::isAvailable(entry.algorithm))
+            continue;
+        QTest::addRow("%s-default", entry.name) << entry.algorithm << -1;
+        QTest::addRow("%s-1", entry.name) << entry.algorithm << 1;
+        QTest::addRow("%s-9", entry.name) << entry.algorithm << 9;
+    }
+}
+
+void tst_QCompressingDevice::compress_data()
+{
+    addRows();
+}
+
+void tst_QCompressingDevice::compress()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    QFETCH(int, level);
+    const QByteArray data = testData(4 * 1024 * 1024);
+
+    QByteArray compressed;
+    QBENCHMARK {
+        compressed = QCompression::compress(data, algorithm, level);
+    }
+    QVERIFY(!compressed.isEmpty());
+    qDebug("ratio %.2f", double(data.size()) / compressed.size());
+}
+
+void tst_QCompressingDevice::decompress_data()
+{
+    addRows();
+}
+
+void tst_QCompressingDevice::decompress()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    QFETCH(int, level);
+    const QByteArray data = testData(4 * 1024 * 1024);
+    const QByteArray compressed = QCompression::compress(data, algorithm, level);
+
+    QByteArray result;
+    QBENCHMARK {
+        result = QCompression::decompress(compressed, algorithm);
+    }
+    QCOMPARE(result.size(), data.size());
+}
+
+void tst_QCompressingDevice::streamDecompress_data()
+{
+    addRows();
+}
+
+void tst_QCompressingDevice::streamDecompress()
+{
+    QFETCH(QCompression::Algorithm, algorithm);
+    QFETCH(int, level);
+    const QByteArray data = testData(4 * 1024 * 1024);
+    QByteArray compressed = QCompression::compress(data, algorithm, level);
+
+    qint64 total = 0;
+    QBENCHMARK {
+        QBuffer buffer(&compressed);
+        buffer.open(QIODevice::ReadOnly);
+        QDecompressingDevice decompressor(&buffer, algorithm);
+        decompressor.open(QIODevice::ReadOnly);
+        char chunk[4096];
+        total = 0;
+        while (!decompressor.atEnd())
+            total += decompressor.read(chunk, sizeof(chunk));
+    }
+    QCOMPARE(total, qint64(data.size()));
+}
+
+QTEST_MAIN(tst_QCompressingDevice)
+
+#include "main.moc"
@@ -25,6 +25,7 @@
 ** $QT_END_LICENSE$
 **
 ****************************************************************************/
+#include <QAtomicInt>
 #include <QDebug>
 #include <QDirIterator>
 #include <QString>
@@ -62,6 +63,8 @@ private slots:
     void posix_data() { data(); }
     void diriterator();
     void diriterator_data() { data(); }
+    void diriterator_parallel();
+    void diriterator_parallel_data() { data(); }
     void fsiterator();
     void fsiterator_data() { data(); }
     void stdRecursiveDirectoryIterator();
@@ -214,6 +217,24 @@ void tst_qdiriterator::diriterator()
     qDebug() << count;
 }
 
+void tst_qdiriterator::diriterator_parallel()
+{
+    QFETCH(QByteArray, dirpath);
+
+    int count = 0;
+
+    QBENCHMARK {
+        QAtomicInt c = 0;
+
+        QDirIterator::forEachEntry(dirpath, QStringList(), QDir::Files,
+                                   QDirIterator::Subdirectories,
+                                   [&c](const QFileInfo &) { c.ref(); });
+
+        count = c.loadRelaxed();
+    }
+    qDebug() << count;
+}
+
 void tst_qdiriterator::fsiterator()
 {
     QFETCH(QByteArray, dirpath);
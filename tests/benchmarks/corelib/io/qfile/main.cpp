@@ -30,6 +30,9 @@
 #include <QTemporaryFile>
 #include <QString>
 #include <QDirIterator>
+#if QT_CONFIG(future)
+#include <QFuture>
+#endif
 
 #include <private/qfsfileengine_p.h>
 
@@ -107,6 +110,11 @@ private slots:
     void readBigFile_posix();
     void readBigFile_Win32();
 
+#if QT_CONFIG(future)
+    void readBigFile_async_data();
+    void readBigFile_async();
+#endif
+
 private:
     void readBigFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b);
     void readBigFile();
@@ -330,6 +338,37 @@ void tst_qfile::readBigFile()
     delete[] buffer;
 }
 
+#if QT_CONFIG(future)
+void tst_qfile::readBigFile_async_data()
+{
+    QTest::addColumn<int>("blockSize");
+
+    QTest::newRow("async 4k") << 4096;
+    QTest::newRow("async 64k") << 64 * 1024;
+    QTest::newRow("async 1M") << 1024 * 1024;
+}
+
+void tst_qfile::readBigFile_async()
+{
+    QFETCH(int, blockSize);
+
+    createFile();
+    fillFile();
+    const qint64 size = QFile(filename).size();
+
+    QBENCHMARK {
+        QVector<QFuture<QByteArray>> reads;
+        reads.reserve(int(size / blockSize) + 1);
+        for (qint64 offset = 0; offset < size; offset += blockSize)
+            reads.append(QFile::readAsync(filename, offset, blockSize));
+        for (QFuture<QByteArray> &read : reads)
+            read.waitForFinished();
+    }
+
+    removeFile();
+}
+#endif
+
 void tst_qfile::seek_data()
 {
     QTest::addColumn<tst_qfile::BenchmarkType>("testType");
@@ -0,0 +1,126 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QLoggingCategory>
+#include <QtTest/QtTest>
+
+#include <memory>
+#include <vector>
+
+class tst_QLoggingCategory : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void registerCategories_data();
+    void registerCategories();
+    void setFilterRules_data();
+    void setFilterRules();
+
+private:
+    static QByteArrayList categoryNames(int count);
+    static QString filterRules(int count);
+};
+
+QByteArrayList tst_QLoggingCategory::categoryNames(int count)
+{
+    QByteArrayList names;
+    for (int i = 0; i < count; ++i)
+        names << "app.module" + QByteArray::number(i / 10) + ".sub" + QByteArray::number(i % 10);
+    return names;
+}
+
+QString tst_QLoggingCategory::filterRules(int count)
+{
+    QString rules;
+    for (int i = 0; i < count; ++i) {
+        switch (i % 3) {
+        case 0:
+            rules += QString::fromLatin1("app.module%1.*=false\n").arg(i);
+            break;
+        case 1:
+            rules += QString::fromLatin1("*.sub%1.debug=true\n").arg(i % 10);
+            break;
+        case 2:
+            rules += QString::fromLatin1("app.module%1.sub%2=true\n").arg(i).arg(i % 10);
+            break;
+        }
+    }
+    return rules;
+}
+
+void tst_QLoggingCategory::registerCategories_data()
+{
+    QTest::addColumn<int>("ruleCount");
+    QTest::newRow("no rules") << 0;
+    QTest::newRow("10 rules") << 10;
+    QTest::newRow("100 rules") << 100;
+}
+
+void tst_QLoggingCategory::registerCategories()
+{
+    QFETCH(int, ruleCount);
+
+    const QByteArrayList names = categoryNames(1000);
+    QLoggingCategory::setFilterRules(filterRules(ruleCount));
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QLoggingCategory>> categories;
+        categories.reserve(names.size());
+        for (const QByteArray &name : names)
+            categories.emplace_back(new QLoggingCategory(name.constData()));
+    }
+
+    QLoggingCategory::setFilterRules(QString());
+}
+
+void tst_QLoggingCategory::setFilterRules_data()
+{
+    registerCategories_data();
+}
+
+void tst_QLoggingCategory::setFilterRules()
+{
+    QFETCH(int, ruleCount);
+
+    const QByteArrayList names = categoryNames(1000);
+    std::vector<std::unique_ptr<QLoggingCategory>> categories;
+    for (const QByteArray &name : names)
+        categories.emplace_back(new QLoggingCategory(name.constData()));
+    const QString rules = filterRules(ruleCount);
+
+    QBENCHMARK {
+        QLoggingCategory::setFilterRules(rules);
+    }
+
+    QLoggingCategory::setFilterRules(QString());
+}
+
+QTEST_MAIN(tst_QLoggingCategory)
+
+#include "main.moc"
@@ -28,6 +28,7 @@
 
 #include <QtTest/QtTest>
 #include <QtCore/QProcess>
+#include <QtCore/QProcessPool>
 
 class tst_QProcess : public QObject
 {
@@ -36,6 +37,10 @@ class tst_QProcess : public QObject
 private slots:
 
     void echoTest_performance();
+    void startLatency_data();
+    void startLatency();
+    void batch_data();
+    void batch();
 };
 
 void tst_QProcess::echoTest_performance()
@@ -83,5 +88,97 @@ void tst_QProcess::echoTest_performance()
     QVERIFY(process.waitForFinished());
 }
 
+void tst_QProcess::startLatency_data()
+{
+    QTest::addColumn<int>("heapSize");
+    QTest::addColumn<bool>("useModifier");
+
+    QTest::newRow("small-heap") << 0 << false;
+    QTest::newRow("large-heap") << 512 * 1024 * 1024 << false;
+#ifdef Q_OS_UNIX
+    // a child process modifier forces a full fork(), which has to copy the
+    // page tables of the parent
+    QTest::newRow("small-heap-modifier") << 0 << true;
+    QTest::newRow("large-heap-modifier") << 512 * 1024 * 1024 << true;
+#endif
+}
+
+void tst_QProcess::startLatency()
+{
+    QFETCH(int, heapSize);
+    QFETCH(bool, useModifier);
+
+    // touch every page so the child would have to duplicate the mappings
+    QByteArray heap(heapSize, 'x');
+
+    QBENCHMARK {
+        QProcess process;
+#ifdef Q_OS_UNIX
+        if (useModifier)
+            process.setChildProcessModifier([]() {});
+#else
+        Q_UNUSED(useModifier);
+#endif
+        process.start("testProcessLoopback/testProcessLoopback");
+        QVERIFY(process.waitForStarted());
+        process.closeWriteChannel();
+        QVERIFY(process.waitForFinished());
+    }
+    QCOMPARE(heap.size(), heapSize);
+}
+
+void tst_QProcess::batch_data()
+{
+    QTest::addColumn<bool>("usePool");
+
+    QTest::newRow("QProcess") << false;
+    QTest::newRow("QProcessPool") << true;
+}
+
+void tst_QProcess::batch()
+{
+    QFETCH(bool, usePool);
+
+    const int count = 500;
+    const int concurrency = 100;
+    const QString program = QStringLiteral("testProcessLoopback/testProcessLoopback");
+    const QByteArray input(4096, 'a');
+
+    QBENCHMARK {
+        if (usePool) {
+            QProcessPool pool;
+            pool.setMaximumConcurrency(concurrency);
+            for (int i = 0; i < count; ++i)
+                pool.addProcess(program, {}, input);
+            QVERIFY(pool.waitForFinished());
+            QCOMPARE(pool.standardOutput(count - 1), input);
+        } else {
+            // the same batch with one QProcess and its notifiers per child
+            int started = 0;
+            int finished = 0;
+            QEventLoop loop;
+            std::function<void()> startNext = [&]() {
+                QProcess *process = new QProcess(&loop);
+                ++started;
+                connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                        [&, process]() {
+                    process->readAllStandardOutput();
+                    process->deleteLater();
+                    if (++finished == count)
+                        loop.quit();
+                    else if (started < count)
+                        startNext();
+                });
+                process->start(program);
+                process->write(input);
+                process->closeWriteChannel();
+            };
+            for (int i = 0; i < concurrency; ++i)
+                startNext();
+            loop.exec();
+        }
+    }
+}
+
 QTEST_MAIN(tst_QProcess)
 #include "tst_bench_qprocess.moc"
@@ -27,6 +27,7 @@
 ****************************************************************************/
 
 #include <QtTest/QtTest>
+#include <QTemporaryDir>
 
 class tst_QMimeDatabase: public QObject
 {
@@ -34,10 +35,49 @@ class tst_QMimeDatabase: public QObject
     Q_OBJECT
 
 private slots:
+    void initTestCase();
     void inheritsPerformance();
     void benchMimeTypeForName();
+    void mimeTypeForData_data();
+    void mimeTypeForData();
+    void mimeTypesForFiles_data();
+    void mimeTypesForFiles();
+
+private:
+    QTemporaryDir m_dir;
+    QStringList m_files;
+};
+
+// Set QT_NO_MIME_CACHE=1 to benchmark the XML provider instead of mime.cache
+static const struct {
+    const char *name;
+    const char *data;
+    int size;
+} samples[] = {
+    { "png", "\x89PNG\r\n\x1a\n\0\0\0\rIHDR", 16 },
+    { "pdf", "%PDF-1.4\n%\xe2\xe3\xcf\xd3\n", 15 },
+    { "zip", "PK\x03\x04\x14\0\0\0\x08\0", 10 },
+    { "gzip", "\x1f\x8b\x08\0\0\0\0\0\0\x03", 10 },
+    { "elf", "\x7f" "ELF\x02\x01\x01\0\0\0\0\0\0\0\0\0\x03\0>\0", 20 },
+    { "xml", "<?xml version=\"1.0\"?>\n<root/>\n", 30 },
+    { "text", "Lorem ipsum dolor sit amet, consectetur adipiscing elit.\n", 57 },
+    { "binary", "\x01\x02\x03\x04\xfe\xfd\xfc\xfb\0\0\x10\x20", 12 },
 };
 
+void tst_QMimeDatabase::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    // Files without an extension, so that their contents have to be looked at
+    for (int i = 0; i < 256; ++i) {
+        const auto &sample = samples[i % (sizeof(samples) / sizeof(samples[0]))];
+        QFile file(m_dir.filePath(QString::number(i)));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(sample.data, sample.size);
+        file.write(QByteArray(4096, '\n'));
+        m_files.append(file.fileName());
+    }
+}
+
 void tst_QMimeDatabase::inheritsPerformance()
 {
     // Check performance of inherits().
@@ -81,5 +121,50 @@ void tst_QMimeDatabase::benchMimeTypeForName()
     }
 }
 
+void tst_QMimeDatabase::mimeTypeForData_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    for (const auto &sample : samples) {
+        QTest::newRow(sample.name) << QByteArray(sample.data, sample.size)
+                                      + QByteArray(4096, '\n');
+    }
+}
+
+void tst_QMimeDatabase::mimeTypeForData()
+{
+    QFETCH(QByteArray, data);
+
+    QMimeDatabase db;
+    QBENCHMARK {
+        const auto mime = db.mimeTypeForData(data);
+        QVERIFY(mime.isValid());
+    }
+}
+
+void tst_QMimeDatabase::mimeTypesForFiles_data()
+{
+    QTest::addColumn<bool>("batch");
+
+    QTest::newRow("mimeTypeForFile") << false;
+    QTest::newRow("mimeTypesForFiles") << true;
+}
+
+void tst_QMimeDatabase::mimeTypesForFiles()
+{
+    QFETCH(bool, batch);
+
+    QMimeDatabase db;
+    QBENCHMARK {
+        if (batch) {
+            const QList<QMimeType> mimes = db.mimeTypesForFiles(m_files);
+            QCOMPARE(mimes.size(), m_files.size());
+        } else {
+            for (const QString &file : qAsConst(m_files))
+                QVERIFY(db.mimeTypeForFile(file).isValid());
+        }
+    }
+}
+
 QTEST_MAIN(tst_QMimeDatabase)
 #include "main.moc"
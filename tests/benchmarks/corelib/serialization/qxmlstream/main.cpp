@@ -0,0 +1,129 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QElapsedTimer>
+#include <QXmlStreamReader>
+#include <qtest.h>
+
+class tst_QXmlStreamReader : public QObject
+{
+    Q_OBJECT
+private slots:
+    void read_data();
+    void read();
+    void throughput_data() { read_data(); }
+    void throughput();
+};
+
+// Builds a document of roughly \a size bytes out of repetitions of \a record
+static QByteArray makeDocument(const QByteArray &record, int size)
+{
+    QByteArray document = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<export>\n";
+    document.reserve(size + record.size() + 16);
+    while (document.size() < size)
+        document += record;
+    document += "</export>\n";
+    return document;
+}
+
+// Reads the whole document, touching all text and attribute values
+static bool parse(const QByteArray &document)
+{
+    QXmlStreamReader reader(document);
+    qint64 textSize = 0;
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QXmlStreamReader::Characters:
+            textSize += reader.text().size();
+            break;
+        case QXmlStreamReader::StartElement:
+            for (const QXmlStreamAttribute &attribute : reader.attributes())
+                textSize += attribute.value().size();
+            break;
+        default:
+            break;
+        }
+    }
+    return !reader.hasError() && textSize > 0;
+}
+
+// Each document is a little over 8 MiB of UTF-8, so a time per iteration t
+// reported by read() corresponds to about 8.4 MB / t.
+void tst_QXmlStreamReader::read_data()
+{
+    QTest::addColumn<QByteArray>("document");
+
+    const int size = 8 * 1024 * 1024;
+    QTest::newRow("text") << makeDocument(
+        "  <item id=\"1\">Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+        "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis "
+        "nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat.</item>\n",
+        size);
+    QTest::newRow("attributes") << makeDocument(
+        "  <row name=\"some reasonably long name\" path=\"/usr/share/doc/package/README.txt\" "
+        "description=\"an attribute value with a few words in it\" size=\"123456\"/>\n",
+        size);
+    QTest::newRow("markup") << makeDocument(
+        "  <a><b x=\"1\"><c/><d>e</d></b><f y=\"2\"/></a>\n", size);
+    QTest::newRow("entities") << makeDocument(
+        "  <item>Fish &amp; chips &lt;with&gt; &quot;mushy&quot; peas &#x263A; and more text</item>\n",
+        size);
+    QTest::newRow("non-ascii") << makeDocument(
+        "  <item lang=\"de\">Größenänderung über Straßenzüge, \xe2\x80\x9e" "Anführungszeichen"
+        "\xe2\x80\x9c und \xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e Text</item>\n",
+        size);
+}
+
+void tst_QXmlStreamReader::read()
+{
+    QFETCH(QByteArray, document);
+
+    QBENCHMARK {
+        QVERIFY(parse(document));
+    }
+}
+
+// The same as read(), but reports the parse speed in bytes per second
+void tst_QXmlStreamReader::throughput()
+{
+    QFETCH(QByteArray, document);
+
+    const int iterations = 5;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i)
+        QVERIFY(parse(document));
+    const qint64 nsecs = qMax<qint64>(timer.nsecsElapsed(), 1);
+
+    QTest::setBenchmarkResult(qreal(document.size()) * iterations * 1e9 / nsecs,
+                              QTest::BytesPerSecond);
+}
+
+QTEST_MAIN(tst_QXmlStreamReader)
+
+#include "main.moc"
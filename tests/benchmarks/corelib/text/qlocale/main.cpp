@@ -37,6 +37,12 @@ private Q_SLOTS:
     void toUpper_QLocale_1();
     void toUpper_QLocale_2();
     void toUpper_QString();
+    void number_toString_data();
+    void number_toString();
+    void number_appendNumbers_data();
+    void number_appendNumbers();
+    void number_toDouble_data();
+    void number_toDouble();
 };
 
 static QString data()
@@ -65,6 +71,80 @@ void tst_QLocale::toUpper_QString()
     QBENCHMARK { LOOP(s.toUpper()) }
 }
 
+static QVector<double> doubles()
+{
+    QVector<double> values;
+    values.reserve(5000);
+    double d = 0.5;
+    for (int i = 0; i < 5000; ++i) {
+        values.append(i % 2 ? d : -d * 1e-3);
+        d = d * 1.37 + i;
+        if (d > 1e12)
+            d = 0.25 + i;
+    }
+    return values;
+}
+
+static void numberLocales()
+{
+    QTest::addColumn<QLocale>("locale");
+
+    QTest::newRow("C") << QLocale::c();
+    QTest::newRow("de_DE") << QLocale(QLocale::German, QLocale::Germany);
+    QTest::newRow("ar_EG") << QLocale(QLocale::Arabic, QLocale::Egypt);
+}
+
+void tst_QLocale::number_toString_data()
+{
+    numberLocales();
+}
+
+void tst_QLocale::number_toString()
+{
+    QFETCH(QLocale, locale);
+    const QVector<double> values = doubles();
+
+    QBENCHMARK {
+        for (double d : values)
+            locale.toString(d, 'g', QLocale::FloatingPointShortest);
+    }
+}
+
+void tst_QLocale::number_appendNumbers_data()
+{
+    numberLocales();
+}
+
+void tst_QLocale::number_appendNumbers()
+{
+    QFETCH(QLocale, locale);
+    const QVector<double> values = doubles();
+
+    QBENCHMARK {
+        QString csv;
+        locale.appendNumbers(csv, values.constData(), values.size(), u";", 'g',
+                             QLocale::FloatingPointShortest);
+    }
+}
+
+void tst_QLocale::number_toDouble_data()
+{
+    numberLocales();
+}
+
+void tst_QLocale::number_toDouble()
+{
+    QFETCH(QLocale, locale);
+    QStringList strings;
+    for (double d : doubles())
+        strings.append(locale.toString(d, 'f', 6));
+
+    QBENCHMARK {
+        for (const QString &s : qAsConst(strings))
+            locale.toDouble(s);
+    }
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "main.moc"
@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/QMultiStringMatcher>
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void keywords_data();
+    void keywords();
+};
+
+// Pseudo-source code lines, and identifiers to look for in them
+static QStringList lines()
+{
+    QStringList result;
+    for (int i = 0; i < 1000; ++i) {
+        result.append(QLatin1String("    if (value") + QString::number(i % 97)
+                      + QLatin1String(" > limit) return compute_") + QString::number(i * 31 % 1009)
+                      + QLatin1String("(value, \"some text\"); // comment ") + QString::number(i));
+    }
+    return result;
+}
+
+static QStringList identifiers(int count)
+{
+    QStringList result;
+    for (int i = 0; i < count; ++i)
+        result.append(QLatin1String("compute_") + QString::number(i * 7));
+    return result;
+}
+
+void tst_QMultiStringMatcher::keywords_data()
+{
+    QTest::addColumn<bool>("useMatcher");
+    QTest::addColumn<int>("count");
+
+    for (int count : { 10, 100, 1000 }) {
+        QTest::addRow("indexOf-%d", count) << false << count;
+        QTest::addRow("matcher-%d", count) << true << count;
+    }
+}
+
+void tst_QMultiStringMatcher::keywords()
+{
+    QFETCH(bool, useMatcher);
+    QFETCH(int, count);
+
+    const QStringList haystacks = lines();
+    const QStringList needles = identifiers(count);
+    const QMultiStringMatcher matcher(needles, Qt::CaseSensitive, QMultiStringMatcher::WholeWordsOption);
+
+    int found = 0;
+    if (useMatcher) {
+        QBENCHMARK {
+            for (const QString &line : haystacks)
+                found += matcher.matches(line).size();
+        }
+    } else {
+        // what a syntax highlighter would typically do instead
+        QBENCHMARK {
+            for (const QString &line : haystacks) {
+                for (const QString &needle : needles) {
+                    for (int i = line.indexOf(needle); i >= 0; i = line.indexOf(needle, i + 1)) {
+                        const int end = i + needle.size();
+                        if ((i == 0 || !line.at(i - 1).isLetterOrNumber())
+                            && (end == line.size() || !line.at(end).isLetterOrNumber())) {
+                            ++found;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+
+#include "main.moc"
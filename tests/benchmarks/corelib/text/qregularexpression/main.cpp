@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QRegularExpressionSet>
+
+class tst_QRegularExpression : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void constructAndMatch();
+    void matchMany_data();
+    void matchMany();
+};
+
+// Typical log-scanning rules: mostly a literal plus some variable parts
+static QVector<QRegularExpression> rules(int count)
+{
+    QVector<QRegularExpression> result;
+    result.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QString n = QString::number(i);
+        switch (i % 4) {
+        case 0:
+            result.append(QRegularExpression(QLatin1String("error code ") + n + QLatin1String("\\b")));
+            break;
+        case 1:
+            result.append(QRegularExpression(QLatin1String("user=svc") + n + QLatin1String(" .*denied"),
+                                             QRegularExpression::CaseInsensitiveOption));
+            break;
+        case 2:
+            result.append(QRegularExpression(QLatin1String("^\\d+-\\d+-\\d+ .*/api/v") + n + QLatin1String("/")));
+            break;
+        case 3:
+            result.append(QRegularExpression(QLatin1String("host-") + n + QLatin1String("\\.example\\.(com|org)")));
+            break;
+        }
+    }
+    return result;
+}
+
+static QStringList logLines()
+{
+    QStringList lines;
+    for (int i = 0; i < 200; ++i) {
+        lines.append(QLatin1String("2020-05-0") + QString::number(i % 9 + 1)
+                     + QLatin1String(" request id=") + QString::number(i * 7919)
+                     + QLatin1String(" path=/api/v2/items/") + QString::number(i % 1013)
+                     + QLatin1String(" host-") + QString::number(i * 31 % 6000)
+                     + QLatin1String(".example.com status=") + QString::number(i % 17 ? 200 : 404));
+    }
+    return lines;
+}
+
+// Code that creates QRegularExpression objects on the fly, such as a
+// validator per widget, only compiles the pattern once
+void tst_QRegularExpression::constructAndMatch()
+{
+    const QString pattern = QStringLiteral("^(\\w+)@([\\w.-]+)\\.(\\w{2,})$");
+    const QString subject = QStringLiteral("someone@example.com");
+    QBENCHMARK {
+        QRegularExpression re(pattern);
+        if (!re.match(subject).hasMatch())
+            QFAIL("no match");
+    }
+}
+
+void tst_QRegularExpression::matchMany_data()
+{
+    QTest::addColumn<bool>("useSet");
+    QTest::addColumn<int>("count");
+
+    for (int count : { 100, 5000 }) {
+        QTest::addRow("loop-%d", count) << false << count;
+        QTest::addRow("set-%d", count) << true << count;
+    }
+}
+
+void tst_QRegularExpression::matchMany()
+{
+    QFETCH(bool, useSet);
+    QFETCH(int, count);
+
+    const QVector<QRegularExpression> expressions = rules(count);
+    const QStringList lines = logLines();
+    const QRegularExpressionSet set(expressions);
+    set.optimize();
+
+    int matches = 0;
+    if (useSet) {
+        QBENCHMARK {
+            for (const QString &line : lines)
+                matches += set.matchingIndexes(line).size();
+        }
+    } else {
+        QBENCHMARK {
+            for (const QString &line : lines) {
+                for (const QRegularExpression &re : expressions)
+                    matches += re.match(line).hasMatch();
+            }
+        }
+    }
+    QVERIFY(matches > 0);
+}
+
+QTEST_APPLESS_MAIN(tst_QRegularExpression)
+
+#include "main.moc"
@@ -0,0 +1,8 @@
+TEMPLATE = app
+TARGET = tst_bench_qregularexpression
+
+QT = core testlib
+
+CONFIG += release
+
+SOURCES += main.cpp
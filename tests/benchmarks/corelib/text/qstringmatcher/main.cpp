@@ -0,0 +1,146 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/QByteArrayMatcher>
+#include <QtCore/QStringMatcher>
+
+class tst_QStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void indexOf_data();
+    void indexOf();
+    void indexOfCaseInsensitive_data() { indexOf_data(); }
+    void indexOfCaseInsensitive();
+    void matcher_data() { indexOf_data(); }
+    void matcher();
+    void byteArrayIndexOf_data() { indexOf_data(); }
+    void byteArrayIndexOf();
+    void byteArrayMatcher_data() { indexOf_data(); }
+    void byteArrayMatcher();
+};
+
+// English-like text, so that the first and last characters of the needle
+// occur frequently, as they do in practice
+static QByteArray haystackData()
+{
+    static const char words[] =
+        "the of and to in is you that it he was for on are as with his they at be this "
+        "have from or one had by word but not what all were we when your can said there "
+        "use an each which she do how their if will up other about out many then them ";
+    QByteArray result;
+    while (result.size() < 64 * 1024)
+        result += words;
+    return result;
+}
+
+// The needle is a piece of the text followed by a character that breaks the
+// match, and is put at the very end of the haystack
+static QByteArray needleData(int length)
+{
+    QByteArray needle = haystackData().mid(37, length - 1);
+    needle += '#';
+    return needle;
+}
+
+void tst_QStringMatcher::indexOf_data()
+{
+    QTest::addColumn<int>("needleLength");
+
+    for (int length : { 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 64, 128, 256 })
+        QTest::addRow("%d", length) << length;
+}
+
+void tst_QStringMatcher::indexOf()
+{
+    QFETCH(int, needleLength);
+    const QString needle = QString::fromLatin1(needleData(needleLength));
+    const QString haystack = QString::fromLatin1(haystackData()) + needle;
+
+    QBENCHMARK {
+        if (haystack.indexOf(needle) != haystack.size() - needle.size())
+            QFAIL("wrong index");
+    }
+}
+
+void tst_QStringMatcher::indexOfCaseInsensitive()
+{
+    QFETCH(int, needleLength);
+    const QString needle = QString::fromLatin1(needleData(needleLength)).toUpper();
+    const QString haystack = QString::fromLatin1(haystackData()) + needle.toLower();
+
+    QBENCHMARK {
+        if (haystack.indexOf(needle, 0, Qt::CaseInsensitive) != haystack.size() - needle.size())
+            QFAIL("wrong index");
+    }
+}
+
+void tst_QStringMatcher::matcher()
+{
+    QFETCH(int, needleLength);
+    const QString needle = QString::fromLatin1(needleData(needleLength));
+    const QString haystack = QString::fromLatin1(haystackData()) + needle;
+    const QStringMatcher matcher(needle);
+
+    QBENCHMARK {
+        if (matcher.indexIn(haystack) != haystack.size() - needle.size())
+            QFAIL("wrong index");
+    }
+}
+
+void tst_QStringMatcher::byteArrayIndexOf()
+{
+    QFETCH(int, needleLength);
+    const QByteArray needle = needleData(needleLength);
+    const QByteArray haystack = haystackData() + needle;
+
+    QBENCHMARK {
+        if (haystack.indexOf(needle) != haystack.size() - needle.size())
+            QFAIL("wrong index");
+    }
+}
+
+void tst_QStringMatcher::byteArrayMatcher()
+{
+    QFETCH(int, needleLength);
+    const QByteArray needle = needleData(needleLength);
+    const QByteArray haystack = haystackData() + needle;
+    const QByteArrayMatcher matcher(needle);
+
+    QBENCHMARK {
+        if (matcher.indexIn(haystack) != haystack.size() - needle.size())
+            QFAIL("wrong index");
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QStringMatcher)
+
+#include "main.moc"
@@ -0,0 +1,8 @@
+TEMPLATE = app
+TARGET = tst_bench_qstringmatcher
+
+QT = core testlib
+
+CONFIG += release
+
+SOURCES += main.cpp
@@ -0,0 +1,174 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/QTextBoundaryFinder>
+#include <QtCore/private/qunicodetools_p.h>
+
+class tst_QTextBoundaryFinder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void charAttributes_data();
+    void charAttributes();
+    void updateCharAttributes_data();
+    void updateCharAttributes();
+    void boundaryFinder_data();
+    void boundaryFinder();
+};
+
+static QString paragraph(const QString &kind, int lines)
+{
+    QString result;
+    for (int i = 0; i < lines; ++i) {
+        if (kind == QLatin1String("ascii")) {
+            result += QLatin1String("The quick brown fox jumps over the lazy dog, ")
+                    + QString::number(i) + QLatin1String(" times. It's 12.5% faster!");
+        } else if (kind == QLatin1String("latin1")) {
+            result += QString::fromUtf8("Schöne Grüße aus Málaga, señor Åström: ")
+                    + QString::number(i) + QString::fromUtf8(" × « déjà vu ».");
+        } else {
+            result += QString::fromUtf8("Γειά σου κόσμε — Привет, мир! ")
+                    + QString::number(i) + QString::fromUtf8(" 😀 テキストの境界。");
+        }
+        result += QLatin1Char('\n');
+    }
+    return result;
+}
+
+void tst_QTextBoundaryFinder::charAttributes_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<int>("options");
+
+    const struct {
+        const char *name;
+        int options;
+    } optionSets[] = {
+        { "grapheme", QUnicodeTools::GraphemeBreaks },
+        { "word", QUnicodeTools::WordBreaks },
+        { "sentence", QUnicodeTools::SentenceBreaks },
+        { "line", QUnicodeTools::LineBreaks },
+        { "whitespace", QUnicodeTools::WhiteSpaces },
+        { "layout", QUnicodeTools::DefaultOptionsCompat | QUnicodeTools::HangulLineBreakTailoring },
+    };
+    for (const char *kind : { "ascii", "latin1", "mixed" }) {
+        const QString text = paragraph(QLatin1String(kind), 200);
+        for (const auto &set : optionSets)
+            QTest::addRow("%s-%s", kind, set.name) << text << set.options;
+    }
+}
+
+void tst_QTextBoundaryFinder::charAttributes()
+{
+    QFETCH(QString, text);
+    QFETCH(int, options);
+
+    const ushort *string = reinterpret_cast<const ushort *>(text.constData());
+    QVector<QCharAttributes> attributes(text.size() + 1);
+    const QUnicodeTools::ScriptItem item = { 0, QChar::Script_Common };
+
+    QBENCHMARK {
+        QUnicodeTools::initCharAttributes(string, text.size(), &item, 1, attributes.data(),
+                                          QUnicodeTools::CharAttributeOptions(options));
+    }
+}
+
+void tst_QTextBoundaryFinder::updateCharAttributes_data()
+{
+    QTest::addColumn<bool>("incremental");
+
+    QTest::newRow("full") << false;
+    QTest::newRow("incremental") << true;
+}
+
+// Types a sentence into the middle of a large plain-text document,
+// refreshing the attributes after every keystroke
+void tst_QTextBoundaryFinder::updateCharAttributes()
+{
+    QFETCH(bool, incremental);
+
+    const QString document = paragraph(QLatin1String("ascii"), 2000);
+    const QString typed = QStringLiteral("Hello, world. ");
+    const QUnicodeTools::ScriptItem item = { 0, QChar::Script_Common };
+    const QUnicodeTools::CharAttributeOptions options(QUnicodeTools::DefaultOptionsCompat
+                                                      | QUnicodeTools::WordBreaks);
+
+    QBENCHMARK {
+        QString text = document;
+        QVector<QCharAttributes> attributes(text.size() + typed.size() + 1);
+        QUnicodeTools::initCharAttributes(reinterpret_cast<const ushort *>(text.constData()),
+                                          text.size(), &item, 1, attributes.data(), options);
+        int position = text.size() / 2;
+        for (QChar ch : typed) {
+            text.insert(position, ch);
+            const ushort *string = reinterpret_cast<const ushort *>(text.constData());
+            if (incremental) {
+                QUnicodeTools::updateCharAttributes(string, text.size(), position, 0, 1,
+                                                    &item, 1, attributes.data(), options);
+            } else {
+                QUnicodeTools::initCharAttributes(string, text.size(), &item, 1,
+                                                  attributes.data(), options);
+            }
+            ++position;
+        }
+    }
+}
+
+void tst_QTextBoundaryFinder::boundaryFinder_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<int>("type");
+
+    for (const char *kind : { "ascii", "latin1", "mixed" }) {
+        const QString text = paragraph(QLatin1String(kind), 200);
+        QTest::addRow("%s-grapheme", kind) << text << int(QTextBoundaryFinder::Grapheme);
+        QTest::addRow("%s-word", kind) << text << int(QTextBoundaryFinder::Word);
+        QTest::addRow("%s-line", kind) << text << int(QTextBoundaryFinder::Line);
+    }
+}
+
+void tst_QTextBoundaryFinder::boundaryFinder()
+{
+    QFETCH(QString, text);
+    QFETCH(int, type);
+
+    int boundaries = 0;
+    QBENCHMARK {
+        QTextBoundaryFinder finder(QTextBoundaryFinder::BoundaryType(type), text);
+        while (finder.toNextBoundary() >= 0)
+            ++boundaries;
+    }
+    QVERIFY(boundaries > 0);
+}
+
+QTEST_APPLESS_MAIN(tst_QTextBoundaryFinder)
+
+#include "main.moc"
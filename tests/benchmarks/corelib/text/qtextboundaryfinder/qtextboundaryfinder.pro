@@ -0,0 +1,6 @@
+TARGET = tst_bench_qtextboundaryfinder
+QT = core-private testlib
+
+CONFIG += release
+
+SOURCES += main.cpp
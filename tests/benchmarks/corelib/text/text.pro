@@ -3,7 +3,11 @@ SUBDIRS = \
         qbytearray \
         qchar \
         qlocale \
+        qmultistringmatcher \
+        qregularexpression \
         qstringbuilder \
-        qstringlist
+        qstringmatcher \
+        qstringlist \
+        qtextboundaryfinder
 
 *g++*: SUBDIRS += qstring
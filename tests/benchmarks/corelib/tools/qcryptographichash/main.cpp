@@ -50,9 +50,15 @@ private Q_SLOTS:
     void addData();
     void addDataChunked_data() { hash_data(); }
     void addDataChunked();
+    void throughput_data();
+    void throughput();
+    void hashMany_data();
+    void hashMany();
+    void hashManyLoop_data() { hashMany_data(); }
+    void hashManyLoop();
 };
 
-const int MaxCryptoAlgorithm = QCryptographicHash::Sha3_512;
+const int MaxCryptoAlgorithm = QCryptographicHash::Xxh3_64;
 const int MaxBlockSize = 65536;
 
 const char *algoname(int i)
@@ -88,6 +94,10 @@ const char *algoname(int i)
         return "keccak_384-";
     case QCryptographicHash::Keccak_512:
         return "keccak_512-";
+    case QCryptographicHash::Blake3_256:
+        return "blake3_256-";
+    case QCryptographicHash::Xxh3_64:
+        return "xxh3_64-";
     }
     Q_UNREACHABLE();
     return 0;
@@ -167,6 +177,86 @@ void tst_bench_QCryptographicHash::addDataChunked()
     }
 }
 
+void tst_bench_QCryptographicHash::throughput_data()
+{
+    QTest::addColumn<int>("algorithm");
+    QTest::addColumn<QByteArray>("data");
+
+    // large buffers, to see the effect of the SIMD and multithreaded code paths
+    static const int datasizes[] = { 1024, 65536, 1024 * 1024, 16 * 1024 * 1024 };
+    QByteArray largeBlock;
+    largeBlock.reserve(datasizes[3]);
+    while (largeBlock.size() < datasizes[3])
+        largeBlock += blockOfData;
+
+    for (int size : datasizes) {
+        for (int algo = QCryptographicHash::Md4; algo <= MaxCryptoAlgorithm; ++algo)
+            QTest::newRow(algoname(algo) + QByteArray::number(size)) << algo << largeBlock.left(size);
+    }
+}
+
+void tst_bench_QCryptographicHash::throughput()
+{
+    QFETCH(int, algorithm);
+    QFETCH(QByteArray, data);
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QCryptographicHash hash(algo);
+    QBENCHMARK {
+        hash.reset();
+        hash.addData(data);
+        hash.result();
+    }
+}
+
+void tst_bench_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<int>("algorithm");
+    QTest::addColumn<QVector<QByteArray>>("data");
+
+    // batches of 8 MiB, as a deduplicating store would hash them
+    static const int chunkSizes[] = { 4096, 65536 };
+    static const QCryptographicHash::Algorithm algorithms[] = {
+        QCryptographicHash::Md5, QCryptographicHash::Sha1, QCryptographicHash::Sha256,
+        QCryptographicHash::Sha512, QCryptographicHash::Blake3_256, QCryptographicHash::Xxh3_64
+    };
+    for (int chunkSize : chunkSizes) {
+        QVector<QByteArray> chunks;
+        for (int i = 0; i < 8 * 1024 * 1024 / chunkSize; ++i) {
+            QByteArray chunk = blockOfData.left(chunkSize);
+            chunk[0] = char(i);
+            chunks.append(chunk);
+        }
+        for (int algo : algorithms)
+            QTest::newRow(algoname(algo) + QByteArray::number(chunkSize)) << algo << chunks;
+    }
+}
+
+void tst_bench_QCryptographicHash::hashMany()
+{
+    QFETCH(int, algorithm);
+    QFETCH(QVector<QByteArray>, data);
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QBENCHMARK {
+        QCryptographicHash::hashMany(data, algo);
+    }
+}
+
+void tst_bench_QCryptographicHash::hashManyLoop()
+{
+    QFETCH(int, algorithm);
+    QFETCH(QVector<QByteArray>, data);
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QBENCHMARK {
+        QVector<QByteArray> results;
+        results.reserve(data.size());
+        for (const QByteArray &chunk : data)
+            results.append(QCryptographicHash::hash(chunk, algo));
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_bench_QCryptographicHash)
 
 #include "main.moc"
@@ -0,0 +1,105 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QDomDocument>
+#include <qtest.h>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#  include <malloc.h>
+#  define HAVE_MALLINFO2
+#endif
+
+class tst_QDomDocument : public QObject
+{
+    Q_OBJECT
+private slots:
+    void setContent_data();
+    void setContent();
+    void memoryUsage_data() { setContent_data(); }
+    void memoryUsage();
+};
+
+void tst_QDomDocument::setContent_data()
+{
+    QTest::addColumn<QByteArray>("document");
+    QTest::addColumn<bool>("namespaceProcessing");
+
+    // a record-oriented export, as typically loaded into a DOM
+    const QByteArray record =
+        "  <ns:record ns:id=\"42\" type=\"entry\" enabled=\"true\">\n"
+        "    <ns:name>Some name</ns:name>\n"
+        "    <ns:value unit=\"ms\">1234</ns:value>\n"
+        "    <ns:description>A longer description of the record, long enough not to repeat "
+        "exactly across records.</ns:description>\n"
+        "  </ns:record>\n";
+    QByteArray document = "<?xml version=\"1.0\"?>\n<ns:export xmlns:ns=\"urn:example:export\">\n";
+    while (document.size() < 4 * 1024 * 1024)
+        document += record;
+    document += "</ns:export>\n";
+
+    QTest::newRow("records") << document << false;
+    QTest::newRow("records-namespaces") << document << true;
+}
+
+void tst_QDomDocument::setContent()
+{
+    QFETCH(QByteArray, document);
+    QFETCH(bool, namespaceProcessing);
+
+    QBENCHMARK {
+        QDomDocument doc;
+        QVERIFY(doc.setContent(document, namespaceProcessing));
+    }
+}
+
+// Reports the heap memory held by the parsed document. Run this against an
+// older build to compare.
+void tst_QDomDocument::memoryUsage()
+{
+#ifndef HAVE_MALLINFO2
+    QSKIP("This benchmark needs mallinfo2()");
+#else
+    QFETCH(QByteArray, document);
+    QFETCH(bool, namespaceProcessing);
+
+    const auto heapInUse = []() {
+        const struct mallinfo2 info = mallinfo2();
+        return qint64(info.uordblks + info.hblkhd);
+    };
+
+    const qint64 before = heapInUse();
+    QDomDocument doc;
+    QVERIFY(doc.setContent(document, namespaceProcessing));
+    QTest::setBenchmarkResult(heapInUse() - before, QTest::BytesAllocated);
+#endif
+}
+
+QTEST_MAIN(tst_QDomDocument)
+
+#include "main.moc"
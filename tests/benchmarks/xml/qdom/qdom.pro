@@ -0,0 +1,6 @@
+TEMPLATE = app
+TARGET = tst_bench_qdom
+
+QT = core xml testlib
+
+SOURCES += main.cpp